@@ -0,0 +1,95 @@
+/**
+ * wwd-media - Dirty Rectangle Accumulator
+ *
+ * Collects the framebuffer regions written since the last present so the
+ * renderer only converts and uploads what may have changed. Overlapping
+ * rectangles are merged as they arrive, which keeps the list disjoint;
+ * once the list is full a new rectangle is merged into whichever entry
+ * grows the least.
+ */
+
+#ifndef WWD_DIRTY_RECTS_H
+#define WWD_DIRTY_RECTS_H
+
+#include "wwd/types.h"
+
+// Rectangles kept before merging starts trading area for count
+constexpr int WWD_DIRTY_MAX_RECTS = 32;
+
+struct WwdDirtyRects {
+    WwdRect rects[WWD_DIRTY_MAX_RECTS];
+    int count;
+    int lastHit;            // Entry that absorbed the previous add
+};
+
+/**
+ * Empty the list
+ */
+void Wwd_DirtyRects_Reset(WwdDirtyRects* dirty);
+
+/**
+ * Add a region; clipped to the framebuffer, empty regions are ignored
+ */
+void Wwd_DirtyRects_Add(WwdDirtyRects* dirty, int x, int y,
+                        int width, int height);
+
+/**
+ * Mark the whole framebuffer dirty
+ */
+void Wwd_DirtyRects_AddAll(WwdDirtyRects* dirty);
+
+/**
+ * Total pixel area covered by the list
+ */
+int Wwd_DirtyRects_Area(const WwdDirtyRects* dirty);
+
+//===========================================================================
+// Frame Tracking
+//
+// Menus and the game clear the whole screen every frame and redraw on
+// top. Against the last present, a clear only changes what was drawn
+// over the previous clear (if the colour is the same) and what had its
+// alpha lowered since the last alpha reset, so those lists are kept
+// alongside the dirty list rather than marking the whole screen.
+//===========================================================================
+
+struct WwdFrameDirty {
+    WwdDirtyRects dirty;    // May differ from the last present
+    WwdDirtyRects drawn;    // Pixels drawn since the last clear
+    WwdDirtyRects dimmed;   // Alpha written since the last alpha reset
+    int clearColor;         // Colour of the last clear, -1 if unknown
+};
+
+/**
+ * Forget what's on screen: everything is dirty until the next clear
+ */
+void Wwd_FrameDirty_Reset(WwdFrameDirty* frame);
+
+/**
+ * Pixels written in a region
+ */
+void Wwd_FrameDirty_Draw(WwdFrameDirty* frame, int x, int y,
+                         int width, int height);
+
+/**
+ * Alpha written in a region
+ */
+void Wwd_FrameDirty_SetAlpha(WwdFrameDirty* frame, int x, int y,
+                             int width, int height);
+
+/**
+ * Whole screen set to one colour with alpha back to opaque
+ */
+void Wwd_FrameDirty_Clear(WwdFrameDirty* frame, uint8_t colorIndex);
+
+/**
+ * Whole alpha buffer back to opaque
+ */
+void Wwd_FrameDirty_ClearAlpha(WwdFrameDirty* frame);
+
+/**
+ * The dirty regions have been converted and uploaded
+ */
+void Wwd_FrameDirty_Presented(WwdFrameDirty* frame);
+
+#endif // WWD_DIRTY_RECTS_H
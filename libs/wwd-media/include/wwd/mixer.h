@@ -0,0 +1,192 @@
+/**
+ * wwd-media - Realtime Sound Mixer
+ *
+ * Platform-neutral mixing core behind Wwd_Audio_*. The output thread owns
+ * all channel state; the game thread never touches it directly but posts
+ * play/stop/volume/pan commands into a bounded single-producer,
+ * single-consumer ring. Each render drains the ring before mixing, so the
+ * output thread never takes a lock or waits on the game thread.
+ *
+ * Results flow back the same way: after applying commands the output
+ * thread publishes which handle occupies each channel, which is all
+ * IsPlaying and GetPlayingCount need.
+ *
+ * Commands must be posted from one thread at a time (the game thread).
+ * Output is stereo float, non-interleaved, at WWD_MIXER_SAMPLE_RATE.
+ */
+
+#ifndef WWD_MIXER_H
+#define WWD_MIXER_H
+
+#include "wwd/audio.h"
+#include <atomic>
+#include <thread>
+
+//===========================================================================
+// Constants
+//===========================================================================
+
+constexpr int WWD_MIXER_SAMPLE_RATE = 44100;
+
+// Commands that can be queued between two renders (power of two)
+constexpr uint32_t WWD_MIXER_QUEUE_SIZE = 256;
+
+// Largest buffer a single render call mixes; longer requests are split
+constexpr uint32_t WWD_MIXER_MAX_FRAMES = 4096;
+
+//===========================================================================
+// Mixer State
+//===========================================================================
+
+enum class WwdMixerCommandType : uint8_t {
+    PLAY,
+    STOP,
+    STOP_ALL,
+    SET_VOLUME,
+    SET_PAN,
+    SET_MUSIC,
+    SET_VIDEO
+};
+
+struct WwdMixerCommand {
+    WwdMixerCommandType type;
+    WwdSoundHandle handle;
+    const WwdAudioSample* sample;
+    uint8_t volume;
+    int8_t pan;
+    bool loop;
+    WwdMusicStreamCallback stream;      // SET_MUSIC / SET_VIDEO
+    void* userdata;
+    int sampleRate;                     // SET_VIDEO
+};
+
+// Owned by the output thread
+struct WwdMixerChannel {
+    const WwdAudioSample* sample;       // Not owned
+    uint32_t position;                  // Source frames, 8.8 fixed point
+    uint8_t volume;
+    int8_t pan;
+    bool loop;
+    bool playing;
+    WwdSoundHandle handle;
+};
+
+struct WwdMixer {
+    // Command ring: head written by the game thread, tail by the output
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+    WwdMixerCommand queue[WWD_MIXER_QUEUE_SIZE];
+
+    // Output thread only
+    WwdMixerChannel channels[WWD_AUDIO_MAX_CHANNELS];
+    WwdMusicStreamCallback music;
+    void* musicUserdata;
+    WwdMusicStreamCallback video;
+    void* videoUserdata;
+    int videoSampleRate;
+    int16_t videoLastSample;            // Held and faded on underrun
+    int videoUnderrunFade;
+    WwdSoundHandle lastPlayApplied;
+    int16_t streamBuffer[WWD_MIXER_MAX_FRAMES];
+
+    // Published by the output thread after each render
+    std::atomic<WwdSoundHandle> channelHandles[WWD_AUDIO_MAX_CHANNELS];
+    std::atomic<WwdSoundHandle> appliedHandle;  // Newest PLAY applied
+    std::atomic<int> playingCount;
+
+    // Plain settings, read once per render
+    std::atomic<uint8_t> masterVolume;
+    std::atomic<uint8_t> soundVolume;
+    std::atomic<float> musicVolume;
+    std::atomic<float> videoVolume;
+    std::atomic<bool> paused;
+
+    // Game thread only
+    WwdSoundHandle nextHandle;
+};
+
+/**
+ * Reset to silence with default volumes. Not thread safe; call before
+ * the output starts pulling.
+ */
+void Wwd_Mixer_Init(WwdMixer* mixer);
+
+//===========================================================================
+// Game Thread
+//===========================================================================
+
+/**
+ * Queue a sound. The handle is valid immediately; if every channel is
+ * busy when the command is applied the sound is dropped and the handle
+ * simply reports not playing.
+ * @return Handle, or 0 if the sample is invalid or the queue is full
+ */
+WwdSoundHandle Wwd_Mixer_Play(WwdMixer* mixer, const WwdAudioSample* sample,
+                              uint8_t volume, int8_t pan, bool loop);
+
+void Wwd_Mixer_Stop(WwdMixer* mixer, WwdSoundHandle handle);
+void Wwd_Mixer_StopAll(WwdMixer* mixer);
+void Wwd_Mixer_SetVolume(WwdMixer* mixer, WwdSoundHandle handle, uint8_t volume);
+void Wwd_Mixer_SetPan(WwdMixer* mixer, WwdSoundHandle handle, int8_t pan);
+
+/**
+ * Replace the music or video stream source. A null callback disables it.
+ */
+void Wwd_Mixer_SetMusic(WwdMixer* mixer, WwdMusicStreamCallback callback,
+                        void* userdata);
+void Wwd_Mixer_SetVideo(WwdMixer* mixer, WwdMusicStreamCallback callback,
+                        void* userdata, int sampleRate);
+
+/**
+ * True while the sound is queued or playing
+ */
+bool Wwd_Mixer_IsPlaying(const WwdMixer* mixer, WwdSoundHandle handle);
+
+/**
+ * Channels busy as of the last render
+ */
+int Wwd_Mixer_GetPlayingCount(const WwdMixer* mixer);
+
+/**
+ * Wait until the output thread has applied every queued command, so the
+ * caller may free samples or stream state it no longer references. The
+ * game thread waits here; the output thread never does.
+ * @return false if the output didn't catch up within timeoutMs
+ */
+bool Wwd_Mixer_Sync(const WwdMixer* mixer, int timeoutMs);
+
+//===========================================================================
+// Output Thread
+//===========================================================================
+
+/**
+ * Apply queued commands, then mix every channel and stream into the
+ * buffers (overwritten, clamped to [-1, 1]). Takes no locks and makes
+ * no allocations.
+ */
+void Wwd_Mixer_Render(WwdMixer* mixer, float* left, float* right,
+                      uint32_t frames);
+
+//===========================================================================
+// Null Output
+//===========================================================================
+
+/**
+ * Output backend that discards what it renders. Pulls buffers on its own
+ * thread at the device cadence (or flat out), for tests and benchmarks on
+ * systems without CoreAudio.
+ */
+struct WwdNullOutput {
+    WwdMixer* mixer;
+    uint32_t framesPerBuffer;
+    bool realtime;                      // Sleep one buffer's duration per pull
+    std::atomic<bool> running;
+    std::atomic<uint64_t> buffersRendered;
+    std::thread thread;
+};
+
+bool Wwd_NullOutput_Start(WwdNullOutput* output, WwdMixer* mixer,
+                          uint32_t framesPerBuffer, bool realtime);
+void Wwd_NullOutput_Stop(WwdNullOutput* output);
+
+#endif // WWD_MIXER_H
@@ -0,0 +1,86 @@
+/**
+ * wwd-media - Palette Conversion Kernel
+ *
+ * Platform-neutral 8-bit indexed to RGBA conversion used by the renderer's
+ * present step. A lookup table holds every palette entry pre-multiplied
+ * by every alpha (dim) level, so converting a pixel is a single table
+ * load with no per-pixel branching or multiplies. The table is rebuilt
+ * only when the palette contents change.
+ *
+ * Output format is RGBA8 little-endian (0xAABBGGRR), alpha forced opaque;
+ * the alpha buffer dims the colour toward black: c' = (c * alpha) >> 8,
+ * with alpha 255 leaving the colour unchanged.
+ */
+
+#ifndef WWD_PALETTE_LUT_H
+#define WWD_PALETTE_LUT_H
+
+#include "wwd/types.h"
+
+//===========================================================================
+// Constants
+//===========================================================================
+
+// One table row per alpha value, so every dim level converts exactly
+constexpr int WWD_PALETTE_DIM_LEVELS = 256;
+
+// Pixels handled per iteration by the SIMD paths
+constexpr int WWD_PALETTE_BLOCK = 16;
+
+//===========================================================================
+// Lookup Table
+//===========================================================================
+
+struct WwdPaletteLut {
+    uint32_t rgba[WWD_PALETTE_DIM_LEVELS][256];  // [alpha][palette index]
+    WwdPalette source;                           // Palette the table was built from
+    bool valid;
+};
+
+/**
+ * Rebuild the table if the palette differs from the one it was built from.
+ * @return true if the table was rebuilt
+ */
+bool Wwd_PaletteLut_Update(WwdPaletteLut* lut, const WwdPalette* palette);
+
+/**
+ * Convert indexed pixels to RGBA, dimming each by its alpha byte.
+ * Uses SSE2 or NEON when available; any count is accepted.
+ *
+ * @param lut     Table built by Wwd_PaletteLut_Update
+ * @param pixels  Palette indices
+ * @param alpha   Per-pixel dim level (255 = full colour, 0 = black)
+ * @param out     Destination RGBA pixels
+ * @param count   Number of pixels
+ */
+void Wwd_PaletteLut_Convert(const WwdPaletteLut* lut, const uint8_t* pixels,
+                            const uint8_t* alpha, uint32_t* out, size_t count);
+
+/**
+ * Portable one-pixel-at-a-time version of Wwd_PaletteLut_Convert.
+ * Always available; produces identical output.
+ */
+void Wwd_PaletteLut_ConvertScalar(const WwdPaletteLut* lut,
+                                  const uint8_t* pixels, const uint8_t* alpha,
+                                  uint32_t* out, size_t count);
+
+/**
+ * Convert the rows of a framebuffer rectangle whose pixels or alpha differ
+ * from the copy kept of the last converted frame, and refresh that copy.
+ * All buffers are full framebuffers sharing the same stride.
+ *
+ * @param rect        Region to examine (already clipped)
+ * @param stride      Pixels per framebuffer row
+ * @param prevPixels  Pixels as last converted (updated)
+ * @param prevAlpha   Alpha as last converted (updated)
+ * @param force       Convert every row regardless (e.g. palette changed)
+ * @return Span of the rect that was converted; height 0 if none changed
+ */
+WwdRect Wwd_PaletteLut_ConvertChanged(const WwdPaletteLut* lut,
+                                      const WwdRect* rect, int stride,
+                                      const uint8_t* pixels,
+                                      const uint8_t* alpha,
+                                      uint8_t* prevPixels, uint8_t* prevAlpha,
+                                      uint32_t* out, bool force);
+
+#endif // WWD_PALETTE_LUT_H
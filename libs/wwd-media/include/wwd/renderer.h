@@ -30,10 +30,17 @@ void Wwd_Renderer_Shutdown(void);
 
 /**
  * Get pointer to the 8-bit framebuffer
- * Pixels are palette indices (0-255).
+ * Pixels are palette indices (0-255). Writes through the pointer aren't
+ * seen by the present; report them with Wwd_Renderer_MarkDirty().
  */
 uint8_t* Wwd_Renderer_GetFramebuffer(void);
 
+/**
+ * Report a region written through the raw framebuffer or alpha pointer
+ * so the next present converts and uploads it
+ */
+void Wwd_Renderer_MarkDirty(int x, int y, int width, int height);
+
 /**
  * Get framebuffer width
  */
@@ -165,7 +172,8 @@ void Wwd_Renderer_ClearAlpha(void);
 
 /**
  * Get pointer to the alpha buffer.
- * Same dimensions as framebuffer.
+ * Same dimensions as framebuffer. Report writes with
+ * Wwd_Renderer_MarkDirty().
  */
 uint8_t* Wwd_Renderer_GetAlphaBuffer(void);
 
@@ -224,6 +232,26 @@ void Wwd_Renderer_BlitSpriteRemapped(const uint8_t* pixels, int width,
                                     int offsetX, int offsetY,
                                     WwdBool trans, const uint8_t* remap);
 
+/**
+ * Blit a span-encoded sprite (see wwd/span_sprite.h). Colour 0 was dropped
+ * when the sprite was encoded, so it is always transparent.
+ * @param spans      Encoded sprite
+ * @param width      Sprite width
+ * @param height     Sprite height
+ * @param destX      Destination X
+ * @param destY      Destination Y
+ * @param remap      256-byte remap table (NULL = no remapping)
+ */
+void Wwd_Renderer_BlitSpans(const uint8_t* spans, int width, int height,
+                           int destX, int destY, const uint8_t* remap);
+
+/**
+ * Blit a span-encoded sprite (convenience wrapper with hotspot)
+ */
+void Wwd_Renderer_BlitSpriteSpans(const uint8_t* spans, int width, int height,
+                                 int destX, int destY, int offsetX, int offsetY,
+                                 const uint8_t* remap);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,73 @@
+/**
+ * wwd-media - Span-Encoded Sprites
+ *
+ * Platform-neutral run-length form of a transparent 8-bit sprite, built
+ * once after decoding so blits never test pixels for colour 0. Each row is
+ * a list of opaque runs: the blitter clips the row once and copies (or
+ * remaps) whole runs instead of checking every pixel.
+ *
+ * Encoded layout, starting on a 4-byte boundary:
+ *
+ *   uint32_t rowStart[height]    Byte offset of each row from the start
+ *   row data ...                 Per row: { skip, run, pixels[run] } ...
+ *                                followed by a { 0, 0 } terminator
+ *
+ * skip counts transparent pixels since the end of the previous run. Skips
+ * and runs longer than 255 are split into several entries ({ 255, 0 } for
+ * a skip, { 0, n } to continue a run), so { 0, 0 } only ever ends a row.
+ */
+
+#ifndef WWD_SPAN_SPRITE_H
+#define WWD_SPAN_SPRITE_H
+
+#include "wwd/types.h"
+#include <cstddef>
+
+// Alignment of an encoded sprite (for the row offset table)
+constexpr size_t WWD_SPAN_ALIGN = 4;
+
+/**
+ * Bytes needed to encode a sprite, including the row offset table
+ * @param pixels  Width * height palette indices, 0 = transparent
+ */
+size_t Wwd_SpanSprite_EncodedSize(const uint8_t* pixels, int width, int height);
+
+/**
+ * Encode a sprite into a buffer of Wwd_SpanSprite_EncodedSize() bytes,
+ * aligned to WWD_SPAN_ALIGN.
+ * @return Bytes written
+ */
+size_t Wwd_SpanSprite_Encode(const uint8_t* pixels, int width, int height,
+                             uint8_t* out);
+
+/**
+ * Total bytes of an encoded sprite (what Wwd_SpanSprite_Encode returned)
+ */
+size_t Wwd_SpanSprite_Size(const uint8_t* spans, int height);
+
+/**
+ * Copy an encoded sprite with every opaque pixel passed through a remap
+ * table, giving a sprite that draws pre-remapped with a plain blit.
+ * @param out  Wwd_SpanSprite_Size() bytes, aligned to WWD_SPAN_ALIGN
+ */
+void Wwd_SpanSprite_Remap(const uint8_t* spans, int height,
+                          const uint8_t* remap, uint8_t* out);
+
+/**
+ * Draw an encoded sprite into an 8-bit buffer.
+ *
+ * @param spans   Encoded sprite
+ * @param width   Sprite width
+ * @param height  Sprite height
+ * @param dest    Destination pixels
+ * @param stride  Pixels per destination row
+ * @param clip    Destination region that may be written (within dest)
+ * @param destX   Where the sprite's top-left lands
+ * @param destY
+ * @param remap   256-byte remap table, or NULL to copy pixels unchanged
+ */
+void Wwd_SpanSprite_Blit(const uint8_t* spans, int width, int height,
+                         uint8_t* dest, int stride, const WwdRect* clip,
+                         int destX, int destY, const uint8_t* remap);
+
+#endif // WWD_SPAN_SPRITE_H
@@ -24,6 +24,14 @@ struct WwdPalette {
     uint8_t colors[256][3];  // RGB values
 };
 
+// Rectangle in framebuffer pixels
+struct WwdRect {
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
 // Audio sample format
 struct WwdAudioSample {
     uint8_t* data;          // Raw PCM data (signed 16-bit or unsigned 8-bit)
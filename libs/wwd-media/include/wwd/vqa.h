@@ -68,6 +68,10 @@ constexpr uint32_t VQA_ID_SND2 = 0x534E4432;  // 'SND2' - audio ADPCM
 // Maximum codebook entries
 constexpr int VQA_MAX_CODEBOOK_ENTRIES = 0x10000;  // 64K entries max
 
+// FINF entries hold the frame's file offset in 16-bit words; the top
+// two bits are flags
+constexpr uint32_t VQA_FINF_OFFSET_MASK = 0x3FFFFFFF;
+
 // IFF chunk header
 #pragma pack(push, 1)
 struct IFFChunk {
@@ -168,9 +172,13 @@ public:
     // Advance to next frame (returns false if at end)
     bool NextFrame();
 
-    // Seek to specific frame
+    // Seek to specific frame. Restarts from the nearest keyframe at or
+    // before it and replays only codebook/palette updates up to it.
     bool SeekFrame(int frame);
 
+    // True if the frame carries a full codebook (a seek restart point)
+    bool IsKeyFrame(int frame) const;
+
     // Get playback state
     WwdVqaState GetState() const { return state_; }
 
@@ -242,8 +250,17 @@ private:
     // Parsed header
     WwdVqaHeader header_;
 
-    // Frame index table
-    uint32_t* frameOffsets_;
+    // Frame index, built at load from FINF or a single chunk scan
+    struct FrameEntry {
+        uint32_t start;         // First chunk of the frame (audio precedes VQFR)
+        uint32_t chunk;         // The VQFR/VQFK chunk itself
+        uint8_t flags;          // FRAME_* bits
+    };
+    static constexpr uint8_t FRAME_FULL_CODEBOOK = 0x01;
+    static constexpr uint8_t FRAME_PALETTE = 0x02;
+
+    FrameEntry* frameIndex_;
+    int frameIndexCount_;
 
     // Playback state
     WwdVqaState state_;
@@ -292,10 +309,20 @@ private:
 
     // Parse file structure
     bool ParseHeader();
-    bool ParseFrameIndex();
+    bool ParseFrameIndex(const uint8_t* finf, uint32_t finfSize);
+    bool ScanFrameIndex();
+    bool ClassifyFrame(FrameEntry* entry) const;
+
+    // Parts of a frame to decode
+    static constexpr uint32_t DECODE_CODEBOOK = 0x01;
+    static constexpr uint32_t DECODE_PALETTE  = 0x02;
+    static constexpr uint32_t DECODE_VIDEO    = 0x04;
+    static constexpr uint32_t DECODE_AUDIO    = 0x08;
+    static constexpr uint32_t DECODE_ALL      = 0x0F;
 
     // Decode a frame
     bool DecodeFrame(int frameNum);
+    bool DecodeFrameParts(int frameNum, uint32_t parts);
 
     // Decode frame components
     bool DecodeCodebook(const uint8_t* data, uint32_t size,
@@ -1,68 +1,43 @@
 /**
  * wwd-media - Audio Implementation
  *
- * Uses AVFoundation/AudioToolbox for sound playback.
- * Supports mixing multiple simultaneous sounds via AudioUnit.
+ * Uses AVFoundation/AudioToolbox for sound playback. The AudioUnit render
+ * callback pulls from the portable mixer in mixer.cpp, which the game
+ * thread drives through its lock-free command queue.
  */
 
 #import <AudioToolbox/AudioToolbox.h>
 #import <AVFoundation/AVFoundation.h>
 #include "wwd/audio.h"
+#include "wwd/mixer.h"
 #include <cstring>
 #include <cmath>
-#include <mutex>
 
 // Output audio format
-static const Float64 kOutputSampleRate = 44100.0;
+static const Float64 kOutputSampleRate = WWD_MIXER_SAMPLE_RATE;
 static const UInt32 kOutputChannels = 2;
 
-// Sound channel state
-typedef struct {
-    const WwdAudioSample* sample;  // Source sample (not owned)
-    uint32_t position;            // Current playback position in bytes
-    uint8_t volume;               // Channel volume (0-255)
-    int8_t pan;                   // Pan (-128 to 127)
-    WwdBool loop;                  // Loop flag
-    WwdBool playing;               // Is this channel active?
-    WwdSoundHandle handle;         // Unique handle for this instance
-} AudioChannel;
+// How long the game thread waits for the render thread to let go of a
+// stream callback or sample before assuming it has stopped
+static const int kSyncTimeoutMs = 200;
 
 // Global state
 static AudioComponentInstance g_audioUnit = nullptr;
-static AudioChannel g_channels[WWD_AUDIO_MAX_CHANNELS];
-static uint8_t g_masterVolume = 255;
-static uint8_t g_soundVolume = 255;  // Separate volume for sound effects
-static WwdBool g_paused = WWD_FALSE;
 static WwdBool g_initialized = WWD_FALSE;
-static WwdSoundHandle g_nextHandle = 1;
-static std::mutex g_audioMutex;
-
-// Music streaming state
-static WwdMusicStreamCallback g_musicCallback = nullptr;
-static void* g_musicUserdata = nullptr;
-static float g_musicVolume = 1.0f;
-static int16_t g_musicBuffer[4096];  // Temp buffer for music samples
-
-// Video audio streaming state
-static WwdVideoAudioCallback g_videoCallback = nullptr;
-static void* g_videoUserdata = nullptr;
-static float g_videoVolume = 1.0f;
-static int g_videoSampleRate = 22050;
-static int16_t g_videoBuffer[8192];  // Temp buffer for video audio samples
-static int16_t g_videoLastSample = 0;  // Last sample for smooth underrun handling
-static int g_videoUnderrunFade = 0;    // Fade counter for underrun smoothing
-
-// Convert 8-bit unsigned to float
-static inline Float32 Sample8ToFloat(uint8_t sample) {
-    return ((Float32)sample - 128.0f) / 128.0f;
-}
 
-// Convert 16-bit signed to float
-static inline Float32 Sample16ToFloat(int16_t sample) {
-    return (Float32)sample / 32768.0f;
+// Mixer state is shared with the render thread only through the mixer's
+// command queue, never under a lock
+static WwdMixer* Mixer(void) {
+    static WwdMixer mixer;
+    static bool ready = false;
+    if (!ready) {
+        Wwd_Mixer_Init(&mixer);
+        ready = true;
+    }
+    return &mixer;
 }
 
-// Audio render callback - mixes all active channels
+// Audio render callback - applies queued commands and mixes all channels
 static OSStatus AudioRenderCallback(
     void* inRefCon,
     AudioUnitRenderActionFlags* ioActionFlags,
@@ -71,7 +46,6 @@ static OSStatus AudioRenderCallback(
     UInt32 inNumberFrames,
     AudioBufferList* ioData)
 {
-    (void)inRefCon;
     (void)ioActionFlags;
     (void)inTimeStamp;
     (void)inBusNumber;
@@ -79,205 +53,7 @@ static OSStatus AudioRenderCallback(
     Float32* leftBuffer = (Float32*)ioData->mBuffers[0].mData;
     Float32* rightBuffer = (Float32*)ioData->mBuffers[1].mData;
 
-    // Clear buffers
-    memset(leftBuffer, 0, inNumberFrames * sizeof(Float32));
-    memset(rightBuffer, 0, inNumberFrames * sizeof(Float32));
-
-    if (g_paused) {
-        return noErr;
-    }
-
-    std::lock_guard<std::mutex> lock(g_audioMutex);
-
-    Float32 masterVol = (Float32)g_masterVolume / 255.0f;
-    Float32 soundVol = (Float32)g_soundVolume / 255.0f;
-
-    for (int ch = 0; ch < WWD_AUDIO_MAX_CHANNELS; ch++) {
-        AudioChannel* channel = &g_channels[ch];
-        if (!channel->playing || !channel->sample) {
-            continue;
-        }
-
-        const WwdAudioSample* sample = channel->sample;
-        Float32 chVol = (Float32)channel->volume / 255.0f;
-        Float32 channelVol = chVol * masterVol * soundVol;
-
-        // Calculate left/right volumes from pan
-        // pan: -128 = full left, 0 = center, 127 = full right
-        Float32 panNorm = (Float32)(channel->pan + 128) / 255.0f; // 0.0 to 1.0
-        Float32 leftVol = channelVol * (1.0f - panNorm * 0.5f);
-        Float32 rightVol = channelVol * (0.5f + panNorm * 0.5f);
-
-        // Calculate sample rate conversion ratio
-        Float64 sampleRatio = (Float64)sample->sampleRate / kOutputSampleRate;
-        uint32_t bytesPerSample = sample->bitsPerSample / 8;
-        uint32_t bytesPerSourceFrame = bytesPerSample * sample->channels;
-
-        // Use fractional position for accurate resampling
-        // position is stored in samples * 256 (8.8 fixed point)
-        Float64 srcSamplePos = (Float64)channel->position / 256.0;
-
-        for (UInt32 frame = 0; frame < inNumberFrames; frame++) {
-            // Calculate current source sample index
-            uint32_t srcSampleIdx = (uint32_t)srcSamplePos;
-            uint32_t srcBytePos = srcSampleIdx * bytesPerSourceFrame;
-
-            // Check for end of sample
-            if (srcBytePos >= sample->dataSize) {
-                if (channel->loop) {
-                    uint32_t maxIdx = sample->dataSize / bytesPerSourceFrame;
-                    srcSampleIdx = srcSampleIdx % maxIdx;
-                    srcBytePos = srcSampleIdx * bytesPerSourceFrame;
-                } else {
-                    channel->playing = WWD_FALSE;
-                    break;
-                }
-            }
-
-            // Read sample value
-            Float32 sampleValue = 0.0f;
-            if (sample->bitsPerSample == 8) {
-                sampleValue = Sample8ToFloat(sample->data[srcBytePos]);
-            } else if (sample->bitsPerSample == 16) {
-                int16_t* ptr = (int16_t*)(sample->data + srcBytePos);
-                sampleValue = Sample16ToFloat(*ptr);
-            }
-
-            // If stereo, handle both channels
-            if (sample->channels == 2) {
-                Float32 rightSample;
-                if (sample->bitsPerSample == 8) {
-                    rightSample = Sample8ToFloat(sample->data[srcBytePos + 1]);
-                } else {
-                    int16_t* ptr = (int16_t*)(sample->data + srcBytePos + 2);
-                    rightSample = Sample16ToFloat(*ptr);
-                }
-                // Mix left sample to left, right sample to right
-                leftBuffer[frame] += sampleValue * leftVol;
-                rightBuffer[frame] += rightSample * rightVol;
-            } else {
-                // Mono - send to both channels
-                leftBuffer[frame] += sampleValue * leftVol;
-                rightBuffer[frame] += sampleValue * rightVol;
-            }
-
-            // Advance source position
-            srcSamplePos += sampleRatio;
-        }
-
-        // Update position (in 8.8 fixed point)
-        if (channel->playing) {
-            channel->position = (uint32_t)(srcSamplePos * 256.0);
-            uint32_t totalSamples = sample->dataSize / bytesPerSourceFrame;
-            if (channel->position / 256 >= totalSamples) {
-                if (channel->loop) {
-                    uint32_t maxPos = totalSamples * 256;
-                    channel->position = channel->position % maxPos;
-                } else {
-                    channel->playing = WWD_FALSE;
-                }
-            }
-        }
-    }
-
-    // Mix in music (streaming audio)
-    // Music files are typically 22050 Hz mono, output is 44100 Hz stereo
-    // We need to upsample 2x with linear interpolation
-    if (g_musicCallback) {
-        // Request half as many samples (22050 Hz source -> 44100 Hz output)
-        int samplesToGet = (int)(inNumberFrames / 2) + 1;
-        if (samplesToGet > 2048) samplesToGet = 2048;
-
-        int samplesGot = g_musicCallback(g_musicBuffer, samplesToGet,
-                                         g_musicUserdata);
-
-        if (samplesGot > 0) {
-            float musicVol = g_musicVolume * masterVol;
-
-            // Upsample 2x with linear interpolation
-            for (UInt32 i = 0; i < inNumberFrames; i++) {
-                // Calculate source position (output 44100 maps to input 22050)
-                float srcPos = (float)i * 0.5f;
-                int srcIdx = (int)srcPos;
-                float frac = srcPos - (float)srcIdx;
-
-                // Get two adjacent samples for interpolation
-                int16_t s0 = (srcIdx < samplesGot) ? g_musicBuffer[srcIdx] : 0;
-                bool hasNext = (srcIdx + 1 < samplesGot);
-                int16_t s1 = hasNext ? g_musicBuffer[srcIdx + 1] : s0;
-
-                // Linear interpolation between samples
-                float interp = (1.0f - frac) * (float)s0 + frac * (float)s1;
-                Float32 sample = interp / 32768.0f * musicVol;
-
-                // Music is mono - send to both channels
-                leftBuffer[i] += sample;
-                rightBuffer[i] += sample;
-            }
-        }
-    }
-
-    // Mix in video audio (streaming from VQA)
-    // Video audio is typically 22050 Hz mono, output is 44100 Hz stereo
-    if (g_videoCallback) {
-        // Calculate resampling ratio
-        float resampleRatio = (float)g_videoSampleRate / kOutputSampleRate;
-        int samplesToGet = (int)(inNumberFrames * resampleRatio) + 1;
-        if (samplesToGet > 4096) samplesToGet = 4096;
-
-        int samplesGot = g_videoCallback(g_videoBuffer, samplesToGet,
-                                         g_videoUserdata);
-
-        float videoVol = g_videoVolume * masterVol;
-
-        // Resample with linear interpolation
-        // Use persistent lastSample and fade to avoid clicks during underruns
-        for (UInt32 i = 0; i < inNumberFrames; i++) {
-            float srcPos = (float)i * resampleRatio;
-            int srcIdx = (int)srcPos;
-            float frac = srcPos - (float)srcIdx;
-
-            // Use last sample when we run out of data (underrun)
-            bool hasCur = srcIdx < samplesGot;
-            bool hasNxt = srcIdx + 1 < samplesGot;
-            int16_t s0, s1;
-
-            if (hasCur) {
-                s0 = g_videoBuffer[srcIdx];
-                g_videoLastSample = s0;
-                g_videoUnderrunFade = 0;  // Reset fade when we have data
-            } else {
-                // During underrun, fade out the last sample over ~10ms
-                // to avoid clicks (441 samples at 44100 Hz = 10ms)
-                if (g_videoUnderrunFade < 441) {
-                    float fadeRatio = 1.0f - (float)g_videoUnderrunFade / 441.0f;
-                    s0 = (int16_t)(g_videoLastSample * fadeRatio);
-                    g_videoUnderrunFade++;
-                } else {
-                    s0 = 0;  // Fully faded out
-                }
-            }
-            s1 = hasNxt ? g_videoBuffer[srcIdx + 1] : s0;
-
-            float f0 = (float)s0;
-            float f1 = (float)s1;
-            float interpolated = (1.0f - frac) * f0 + frac * f1;
-            Float32 sample = interpolated / 32768.0f * videoVol;
-
-            // Video audio is mono - send to both channels
-            leftBuffer[i] += sample;
-            rightBuffer[i] += sample;
-        }
-    }
-
-    // Clamp output to prevent clipping
-    for (UInt32 frame = 0; frame < inNumberFrames; frame++) {
-        if (leftBuffer[frame] > 1.0f) leftBuffer[frame] = 1.0f;
-        if (leftBuffer[frame] < -1.0f) leftBuffer[frame] = -1.0f;
-        if (rightBuffer[frame] > 1.0f) rightBuffer[frame] = 1.0f;
-        if (rightBuffer[frame] < -1.0f) rightBuffer[frame] = -1.0f;
-    }
-
+    Wwd_Mixer_Render((WwdMixer*)inRefCon, leftBuffer, rightBuffer, inNumberFrames);
     return noErr;
 }
 
@@ -286,8 +62,7 @@ WwdBool Wwd_Audio_Init(void) {
         return WWD_TRUE;
     }
 
-    // Initialize channels
-    memset(g_channels, 0, sizeof(g_channels));
+    WwdMixer* mixer = Mixer();
 
     // Describe the output audio unit
     AudioComponentDescription desc = {
@@ -340,7 +115,7 @@ WwdBool Wwd_Audio_Init(void) {
     // Set render callback
     AURenderCallbackStruct callback = {
         .inputProc = AudioRenderCallback,
-        .inputProcRefCon = nullptr
+        .inputProcRefCon = mixer
     };
 
     status = AudioUnitSetProperty(g_audioUnit,
@@ -385,6 +160,10 @@ void Wwd_Audio_Shutdown(void) {
         return;
     }
 
+    // Let the render thread drop every sample before the unit stops
+    Wwd_Mixer_StopAll(Mixer());
+    Wwd_Mixer_Sync(Mixer(), kSyncTimeoutMs);
+
     if (g_audioUnit) {
         AudioOutputUnitStop(g_audioUnit);
         AudioUnitUninitialize(g_audioUnit);
@@ -405,126 +184,59 @@ WwdSoundHandle Wwd_Audio_Play(const WwdAudioSample* sample, uint8_t volume,
     if (!g_initialized || !sample || !sample->data) {
         return 0;
     }
-
-    std::lock_guard<std::mutex> lock(g_audioMutex);
-
-    // Find free channel
-    for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
-        if (!g_channels[i].playing) {
-            g_channels[i].sample = sample;
-            g_channels[i].position = 0;
-            g_channels[i].volume = volume;
-            g_channels[i].pan = pan;
-            g_channels[i].loop = loop;
-            g_channels[i].playing = WWD_TRUE;
-            g_channels[i].handle = g_nextHandle++;
-
-            if (g_nextHandle == 0) g_nextHandle = 1; // Skip 0
-
-            return g_channels[i].handle;
-        }
-    }
-
-    // No free channels
-    return 0;
+    return Wwd_Mixer_Play(Mixer(), sample, volume, pan, loop != WWD_FALSE);
 }
 
 void Wwd_Audio_Stop(WwdSoundHandle handle) {
-    if (!handle) return;
-
-    std::lock_guard<std::mutex> lock(g_audioMutex);
-
-    for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
-        if (g_channels[i].handle == handle) {
-            g_channels[i].playing = WWD_FALSE;
-            g_channels[i].handle = 0;
-            return;
-        }
-    }
+    Wwd_Mixer_Stop(Mixer(), handle);
 }
 
 void Wwd_Audio_StopAll(void) {
-    std::lock_guard<std::mutex> lock(g_audioMutex);
-
-    for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
-        g_channels[i].playing = WWD_FALSE;
-        g_channels[i].handle = 0;
+    // Callers free samples after this, so wait until none are referenced
+    Wwd_Mixer_StopAll(Mixer());
+    if (g_initialized) {
+        Wwd_Mixer_Sync(Mixer(), kSyncTimeoutMs);
     }
 }
 
 WwdBool Wwd_Audio_IsPlaying(WwdSoundHandle handle) {
-    if (!handle) return WWD_FALSE;
-
-    std::lock_guard<std::mutex> lock(g_audioMutex);
-
-    for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
-        if (g_channels[i].handle == handle && g_channels[i].playing) {
-            return WWD_TRUE;
-        }
-    }
-    return WWD_FALSE;
+    return Wwd_Mixer_IsPlaying(Mixer(), handle) ? WWD_TRUE : WWD_FALSE;
 }
 
 void Wwd_Audio_SetVolume(WwdSoundHandle handle, uint8_t volume) {
-    if (!handle) return;
-
-    std::lock_guard<std::mutex> lock(g_audioMutex);
-
-    for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
-        if (g_channels[i].handle == handle) {
-            g_channels[i].volume = volume;
-            return;
-        }
-    }
+    Wwd_Mixer_SetVolume(Mixer(), handle, volume);
 }
 
 void Wwd_Audio_SetPan(WwdSoundHandle handle, int8_t pan) {
-    if (!handle) return;
-
-    std::lock_guard<std::mutex> lock(g_audioMutex);
-
-    for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
-        if (g_channels[i].handle == handle) {
-            g_channels[i].pan = pan;
-            return;
-        }
-    }
+    Wwd_Mixer_SetPan(Mixer(), handle, pan);
 }
 
 void Wwd_Audio_SetMasterVolume(uint8_t volume) {
-    g_masterVolume = volume;
+    Mixer()->masterVolume.store(volume, std::memory_order_relaxed);
 }
 
 uint8_t Wwd_Audio_GetMasterVolume(void) {
-    return g_masterVolume;
+    return Mixer()->masterVolume.load(std::memory_order_relaxed);
 }
 
 void Wwd_Audio_SetSoundVolume(uint8_t volume) {
-    g_soundVolume = volume;
+    Mixer()->soundVolume.store(volume, std::memory_order_relaxed);
 }
 
 uint8_t Wwd_Audio_GetSoundVolume(void) {
-    return g_soundVolume;
+    return Mixer()->soundVolume.load(std::memory_order_relaxed);
 }
 
 void Wwd_Audio_Pause(WwdBool pause) {
-    g_paused = pause;
+    Mixer()->paused.store(pause != WWD_FALSE, std::memory_order_relaxed);
 }
 
 WwdBool Wwd_Audio_IsPaused(void) {
-    return g_paused;
+    return Mixer()->paused.load(std::memory_order_relaxed) ? WWD_TRUE : WWD_FALSE;
 }
 
 int Wwd_Audio_GetPlayingCount(void) {
-    std::lock_guard<std::mutex> lock(g_audioMutex);
-
-    int count = 0;
-    for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
-        if (g_channels[i].playing) {
-            count++;
-        }
-    }
-    return count;
+    return Wwd_Mixer_GetPlayingCount(Mixer());
 }
 
 // Generate a simple sine wave test tone
@@ -575,19 +287,21 @@ void Wwd_Audio_FreeTestTone(WwdAudioSample* sample) {
 //===========================================================================
 
 void Wwd_Audio_SetMusicCallback(WwdMusicStreamCallback callback, void* userdata) {
-    std::lock_guard<std::mutex> lock(g_audioMutex);
-    g_musicCallback = callback;
-    g_musicUserdata = userdata;
+    // On return the previous callback is no longer being called
+    Wwd_Mixer_SetMusic(Mixer(), callback, userdata);
+    if (g_initialized) {
+        Wwd_Mixer_Sync(Mixer(), kSyncTimeoutMs);
+    }
 }
 
 void Wwd_Audio_SetMusicVolume(float volume) {
     if (volume < 0.0f) volume = 0.0f;
     if (volume > 1.0f) volume = 1.0f;
-    g_musicVolume = volume;
+    Mixer()->musicVolume.store(volume, std::memory_order_relaxed);
 }
 
 float Wwd_Audio_GetMusicVolume(void) {
-    return g_musicVolume;
+    return Mixer()->musicVolume.load(std::memory_order_relaxed);
 }
 
 //===========================================================================
@@ -596,20 +310,19 @@ float Wwd_Audio_GetMusicVolume(void) {
 
 void Wwd_Audio_SetVideoCallback(WwdVideoAudioCallback callback, void* userdata,
                                int sampleRate) {
-    std::lock_guard<std::mutex> lock(g_audioMutex);
-    g_videoCallback = callback;
-    g_videoUserdata = userdata;
-    g_videoSampleRate = (sampleRate > 0) ? sampleRate : 22050;
-    g_videoLastSample = 0;       // Reset for new video
-    g_videoUnderrunFade = 0;     // Reset fade state
+    // On return the previous callback is no longer being called
+    Wwd_Mixer_SetVideo(Mixer(), callback, userdata, sampleRate);
+    if (g_initialized) {
+        Wwd_Mixer_Sync(Mixer(), kSyncTimeoutMs);
+    }
 }
 
 void Wwd_Audio_SetVideoVolume(float volume) {
     if (volume < 0.0f) volume = 0.0f;
     if (volume > 1.0f) volume = 1.0f;
-    g_videoVolume = volume;
+    Mixer()->videoVolume.store(volume, std::memory_order_relaxed);
 }
 
 float Wwd_Audio_GetVideoVolume(void) {
-    return g_videoVolume;
+    return Mixer()->videoVolume.load(std::memory_order_relaxed);
 }
@@ -0,0 +1,171 @@
+/**
+ * wwd-media - Dirty Rectangle Accumulator Implementation
+ */
+
+#include "wwd/dirty_rects.h"
+
+#define FBW WWD_FRAMEBUFFER_WIDTH
+#define FBH WWD_FRAMEBUFFER_HEIGHT
+
+//===========================================================================
+// Rectangle Helpers
+//===========================================================================
+
+static inline bool Overlaps(const WwdRect& a, const WwdRect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+static inline bool Contains(const WwdRect& outer, const WwdRect& inner) {
+    return inner.x >= outer.x && inner.y >= outer.y &&
+           inner.x + inner.width <= outer.x + outer.width &&
+           inner.y + inner.height <= outer.y + outer.height;
+}
+
+static inline WwdRect Union(const WwdRect& a, const WwdRect& b) {
+    int x1 = (a.x < b.x) ? a.x : b.x;
+    int y1 = (a.y < b.y) ? a.y : b.y;
+    int x2 = (a.x + a.width > b.x + b.width) ? a.x + a.width : b.x + b.width;
+    int y2 = (a.y + a.height > b.y + b.height) ? a.y + a.height : b.y + b.height;
+    return {x1, y1, x2 - x1, y2 - y1};
+}
+
+static inline int Area(const WwdRect& r) {
+    return r.width * r.height;
+}
+
+static void RemoveAt(WwdDirtyRects* dirty, int index) {
+    dirty->rects[index] = dirty->rects[--dirty->count];
+}
+
+//===========================================================================
+// Accumulator
+//===========================================================================
+
+void Wwd_DirtyRects_Reset(WwdDirtyRects* dirty) {
+    dirty->count = 0;
+    dirty->lastHit = 0;
+}
+
+void Wwd_DirtyRects_Add(WwdDirtyRects* dirty, int x, int y,
+                        int width, int height) {
+    // Clip to framebuffer bounds
+    if (x < 0) { width += x; x = 0; }
+    if (y < 0) { height += y; y = 0; }
+    if (x + width > FBW) width = FBW - x;
+    if (y + height > FBH) height = FBH - y;
+    if (width <= 0 || height <= 0) return;
+
+    WwdRect rect = {x, y, width, height};
+
+    // Consecutive draws usually land in the same region (often the whole
+    // screen after a clear), so try the last entry that took one first
+    if (dirty->lastHit < dirty->count &&
+        Contains(dirty->rects[dirty->lastHit], rect)) {
+        return;
+    }
+
+    for (;;) {
+        // Absorb every entry the new rectangle touches; the grown union
+        // may reach further entries, so rescan until nothing overlaps
+        bool merged = false;
+        for (int i = 0; i < dirty->count; i++) {
+            const WwdRect& existing = dirty->rects[i];
+            if (Contains(existing, rect)) {
+                dirty->lastHit = i;
+                return;
+            }
+            if (Overlaps(existing, rect)) {
+                rect = Union(existing, rect);
+                RemoveAt(dirty, i);
+                merged = true;
+                break;
+            }
+        }
+        if (merged) continue;
+
+        if (dirty->count < WWD_DIRTY_MAX_RECTS) break;
+
+        // Full: fold into the entry whose bounding box grows the least
+        int best = 0;
+        int bestGrowth = 0;
+        for (int i = 0; i < dirty->count; i++) {
+            const WwdRect& existing = dirty->rects[i];
+            int growth = Area(Union(existing, rect)) - Area(existing);
+            if (i == 0 || growth < bestGrowth) {
+                best = i;
+                bestGrowth = growth;
+            }
+        }
+        rect = Union(dirty->rects[best], rect);
+        RemoveAt(dirty, best);
+    }
+
+    dirty->lastHit = dirty->count;
+    dirty->rects[dirty->count++] = rect;
+}
+
+void Wwd_DirtyRects_AddAll(WwdDirtyRects* dirty) {
+    dirty->rects[0] = {0, 0, FBW, FBH};
+    dirty->count = 1;
+    dirty->lastHit = 0;
+}
+
+int Wwd_DirtyRects_Area(const WwdDirtyRects* dirty) {
+    int area = 0;
+    for (int i = 0; i < dirty->count; i++) {
+        area += Area(dirty->rects[i]);
+    }
+    return area;
+}
+
+//===========================================================================
+// Frame Tracking
+//===========================================================================
+
+static void AddRects(WwdDirtyRects* dirty, const WwdDirtyRects* from) {
+    for (int i = 0; i < from->count; i++) {
+        const WwdRect& r = from->rects[i];
+        Wwd_DirtyRects_Add(dirty, r.x, r.y, r.width, r.height);
+    }
+}
+
+void Wwd_FrameDirty_Reset(WwdFrameDirty* frame) {
+    Wwd_DirtyRects_AddAll(&frame->dirty);
+    Wwd_DirtyRects_Reset(&frame->drawn);
+    Wwd_DirtyRects_AddAll(&frame->dimmed);
+    frame->clearColor = -1;
+}
+
+void Wwd_FrameDirty_Draw(WwdFrameDirty* frame, int x, int y,
+                         int width, int height) {
+    Wwd_DirtyRects_Add(&frame->dirty, x, y, width, height);
+    Wwd_DirtyRects_Add(&frame->drawn, x, y, width, height);
+}
+
+void Wwd_FrameDirty_SetAlpha(WwdFrameDirty* frame, int x, int y,
+                             int width, int height) {
+    Wwd_DirtyRects_Add(&frame->dirty, x, y, width, height);
+    Wwd_DirtyRects_Add(&frame->dimmed, x, y, width, height);
+}
+
+void Wwd_FrameDirty_Clear(WwdFrameDirty* frame, uint8_t colorIndex) {
+    if (frame->clearColor == colorIndex) {
+        // Everything else already holds this colour
+        AddRects(&frame->dirty, &frame->drawn);
+    } else {
+        Wwd_DirtyRects_AddAll(&frame->dirty);
+    }
+    Wwd_FrameDirty_ClearAlpha(frame);
+    Wwd_DirtyRects_Reset(&frame->drawn);
+    frame->clearColor = colorIndex;
+}
+
+void Wwd_FrameDirty_ClearAlpha(WwdFrameDirty* frame) {
+    AddRects(&frame->dirty, &frame->dimmed);
+    Wwd_DirtyRects_Reset(&frame->dimmed);
+}
+
+void Wwd_FrameDirty_Presented(WwdFrameDirty* frame) {
+    Wwd_DirtyRects_Reset(&frame->dirty);
+}
@@ -0,0 +1,506 @@
+/**
+ * wwd-media - Realtime Sound Mixer Implementation
+ */
+
+#include "wwd/mixer.h"
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+constexpr uint32_t QUEUE_MASK = WWD_MIXER_QUEUE_SIZE - 1;
+static_assert((WWD_MIXER_QUEUE_SIZE & QUEUE_MASK) == 0,
+              "queue size must be a power of two");
+
+// How long a poster waits for room before dropping a command. Only hit if
+// the output thread has stalled outright.
+constexpr int QUEUE_FULL_WAIT_MS = 50;
+
+// Music is 22050 Hz mono, upsampled 2x
+constexpr int MUSIC_MAX_SAMPLES = 2048;
+
+// Underrun fade for video audio (~10ms at 44100 Hz)
+constexpr int VIDEO_UNDERRUN_FADE = 441;
+
+void Wwd_Mixer_Init(WwdMixer* mixer) {
+    mixer->head.store(0, std::memory_order_relaxed);
+    mixer->tail.store(0, std::memory_order_relaxed);
+
+    memset(mixer->channels, 0, sizeof(mixer->channels));
+    mixer->music = nullptr;
+    mixer->musicUserdata = nullptr;
+    mixer->video = nullptr;
+    mixer->videoUserdata = nullptr;
+    mixer->videoSampleRate = 22050;
+    mixer->videoLastSample = 0;
+    mixer->videoUnderrunFade = 0;
+    mixer->lastPlayApplied = 0;
+
+    for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
+        mixer->channelHandles[i].store(0, std::memory_order_relaxed);
+    }
+    mixer->appliedHandle.store(0, std::memory_order_relaxed);
+    mixer->playingCount.store(0, std::memory_order_relaxed);
+
+    mixer->masterVolume.store(255, std::memory_order_relaxed);
+    mixer->soundVolume.store(255, std::memory_order_relaxed);
+    mixer->musicVolume.store(1.0f, std::memory_order_relaxed);
+    mixer->videoVolume.store(1.0f, std::memory_order_relaxed);
+    mixer->paused.store(false, std::memory_order_relaxed);
+
+    mixer->nextHandle = 1;
+}
+
+//===========================================================================
+// Command Queue (game thread side)
+//===========================================================================
+
+static bool Post(WwdMixer* mixer, const WwdMixerCommand& cmd) {
+    uint32_t head = mixer->head.load(std::memory_order_relaxed);
+
+    if (head - mixer->tail.load(std::memory_order_acquire) >= WWD_MIXER_QUEUE_SIZE) {
+        // Full: the output normally drains it within one buffer
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(QUEUE_FULL_WAIT_MS);
+        while (head - mixer->tail.load(std::memory_order_acquire) >= WWD_MIXER_QUEUE_SIZE) {
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+            std::this_thread::yield();
+        }
+    }
+
+    mixer->queue[head & QUEUE_MASK] = cmd;
+    mixer->head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+static WwdMixerCommand MakeCommand(WwdMixerCommandType type,
+                                   WwdSoundHandle handle) {
+    WwdMixerCommand cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type = type;
+    cmd.handle = handle;
+    return cmd;
+}
+
+WwdSoundHandle Wwd_Mixer_Play(WwdMixer* mixer, const WwdAudioSample* sample,
+                              uint8_t volume, int8_t pan, bool loop) {
+    if (!sample || !sample->data || sample->dataSize == 0 ||
+        sample->channels == 0 ||
+        (sample->bitsPerSample != 8 && sample->bitsPerSample != 16)) {
+        return 0;
+    }
+
+    WwdMixerCommand cmd = MakeCommand(WwdMixerCommandType::PLAY,
+                                      mixer->nextHandle);
+    cmd.sample = sample;
+    cmd.volume = volume;
+    cmd.pan = pan;
+    cmd.loop = loop;
+    if (!Post(mixer, cmd)) return 0;
+
+    WwdSoundHandle handle = mixer->nextHandle++;
+    if (mixer->nextHandle == 0) mixer->nextHandle = 1;  // Skip 0
+    return handle;
+}
+
+void Wwd_Mixer_Stop(WwdMixer* mixer, WwdSoundHandle handle) {
+    if (!handle) return;
+    Post(mixer, MakeCommand(WwdMixerCommandType::STOP, handle));
+}
+
+void Wwd_Mixer_StopAll(WwdMixer* mixer) {
+    Post(mixer, MakeCommand(WwdMixerCommandType::STOP_ALL, 0));
+}
+
+void Wwd_Mixer_SetVolume(WwdMixer* mixer, WwdSoundHandle handle, uint8_t volume) {
+    if (!handle) return;
+    WwdMixerCommand cmd = MakeCommand(WwdMixerCommandType::SET_VOLUME, handle);
+    cmd.volume = volume;
+    Post(mixer, cmd);
+}
+
+void Wwd_Mixer_SetPan(WwdMixer* mixer, WwdSoundHandle handle, int8_t pan) {
+    if (!handle) return;
+    WwdMixerCommand cmd = MakeCommand(WwdMixerCommandType::SET_PAN, handle);
+    cmd.pan = pan;
+    Post(mixer, cmd);
+}
+
+void Wwd_Mixer_SetMusic(WwdMixer* mixer, WwdMusicStreamCallback callback,
+                        void* userdata) {
+    WwdMixerCommand cmd = MakeCommand(WwdMixerCommandType::SET_MUSIC, 0);
+    cmd.stream = callback;
+    cmd.userdata = userdata;
+    Post(mixer, cmd);
+}
+
+void Wwd_Mixer_SetVideo(WwdMixer* mixer, WwdMusicStreamCallback callback,
+                        void* userdata, int sampleRate) {
+    WwdMixerCommand cmd = MakeCommand(WwdMixerCommandType::SET_VIDEO, 0);
+    cmd.stream = callback;
+    cmd.userdata = userdata;
+    cmd.sampleRate = sampleRate > 0 ? sampleRate : 22050;
+    Post(mixer, cmd);
+}
+
+bool Wwd_Mixer_IsPlaying(const WwdMixer* mixer, WwdSoundHandle handle) {
+    if (!handle) return false;
+
+    // Handles count up, so anything newer than the last applied PLAY is
+    // still waiting in the queue
+    WwdSoundHandle applied = mixer->appliedHandle.load(std::memory_order_acquire);
+    if ((int32_t)(handle - applied) > 0) return true;
+
+    for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
+        if (mixer->channelHandles[i].load(std::memory_order_relaxed) == handle) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int Wwd_Mixer_GetPlayingCount(const WwdMixer* mixer) {
+    return mixer->playingCount.load(std::memory_order_relaxed);
+}
+
+bool Wwd_Mixer_Sync(const WwdMixer* mixer, int timeoutMs) {
+    uint32_t target = mixer->head.load(std::memory_order_relaxed);
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(timeoutMs);
+
+    while ((int32_t)(target - mixer->tail.load(std::memory_order_acquire)) > 0) {
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+//===========================================================================
+// Command Application (output thread side)
+//===========================================================================
+
+static WwdMixerChannel* FindChannel(WwdMixer* mixer, WwdSoundHandle handle) {
+    for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
+        WwdMixerChannel* ch = &mixer->channels[i];
+        if (ch->playing && ch->handle == handle) return ch;
+    }
+    return nullptr;
+}
+
+static void ApplyCommands(WwdMixer* mixer) {
+    uint32_t tail = mixer->tail.load(std::memory_order_relaxed);
+    uint32_t head = mixer->head.load(std::memory_order_acquire);
+
+    for (; tail != head; tail++) {
+        const WwdMixerCommand& cmd = mixer->queue[tail & QUEUE_MASK];
+
+        switch (cmd.type) {
+            case WwdMixerCommandType::PLAY: {
+                for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
+                    WwdMixerChannel* ch = &mixer->channels[i];
+                    if (ch->playing) continue;
+                    ch->sample = cmd.sample;
+                    ch->position = 0;
+                    ch->volume = cmd.volume;
+                    ch->pan = cmd.pan;
+                    ch->loop = cmd.loop;
+                    ch->playing = true;
+                    ch->handle = cmd.handle;
+                    break;
+                }
+                // No free channel: the sound is dropped
+                mixer->lastPlayApplied = cmd.handle;
+                break;
+            }
+            case WwdMixerCommandType::STOP:
+                if (WwdMixerChannel* ch = FindChannel(mixer, cmd.handle)) {
+                    ch->playing = false;
+                    ch->handle = 0;
+                }
+                break;
+            case WwdMixerCommandType::STOP_ALL:
+                for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
+                    mixer->channels[i].playing = false;
+                    mixer->channels[i].handle = 0;
+                }
+                break;
+            case WwdMixerCommandType::SET_VOLUME:
+                if (WwdMixerChannel* ch = FindChannel(mixer, cmd.handle)) {
+                    ch->volume = cmd.volume;
+                }
+                break;
+            case WwdMixerCommandType::SET_PAN:
+                if (WwdMixerChannel* ch = FindChannel(mixer, cmd.handle)) {
+                    ch->pan = cmd.pan;
+                }
+                break;
+            case WwdMixerCommandType::SET_MUSIC:
+                mixer->music = cmd.stream;
+                mixer->musicUserdata = cmd.userdata;
+                break;
+            case WwdMixerCommandType::SET_VIDEO:
+                mixer->video = cmd.stream;
+                mixer->videoUserdata = cmd.userdata;
+                mixer->videoSampleRate = cmd.sampleRate;
+                mixer->videoLastSample = 0;     // Reset for new video
+                mixer->videoUnderrunFade = 0;
+                break;
+        }
+    }
+
+    mixer->tail.store(tail, std::memory_order_release);
+}
+
+// Let the game thread see which sounds are live. Handles are stored
+// before appliedHandle is released, so a reader that sees a PLAY as
+// applied also sees where it landed.
+static void PublishChannels(WwdMixer* mixer) {
+    int playing = 0;
+    for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
+        const WwdMixerChannel& ch = mixer->channels[i];
+        mixer->channelHandles[i].store(ch.playing ? ch.handle : 0,
+                                       std::memory_order_relaxed);
+        if (ch.playing) playing++;
+    }
+    mixer->playingCount.store(playing, std::memory_order_relaxed);
+    mixer->appliedHandle.store(mixer->lastPlayApplied, std::memory_order_release);
+}
+
+//===========================================================================
+// Mixing
+//===========================================================================
+
+// Convert 8-bit unsigned to float
+static inline float Sample8ToFloat(uint8_t sample) {
+    return ((float)sample - 128.0f) / 128.0f;
+}
+
+// Convert 16-bit signed to float
+static inline float Sample16ToFloat(const uint8_t* p) {
+    int16_t sample;
+    memcpy(&sample, p, sizeof(sample));
+    return (float)sample / 32768.0f;
+}
+
+static void MixChannel(WwdMixerChannel* channel, float gain,
+                       float* left, float* right, uint32_t frames) {
+    const WwdAudioSample* sample = channel->sample;
+    float chVol = (float)channel->volume / 255.0f;
+    float channelVol = chVol * gain;
+
+    // pan: -128 = full left, 0 = center, 127 = full right
+    float panNorm = (float)(channel->pan + 128) / 255.0f;  // 0.0 to 1.0
+    float leftVol = channelVol * (1.0f - panNorm * 0.5f);
+    float rightVol = channelVol * (0.5f + panNorm * 0.5f);
+
+    double sampleRatio = (double)sample->sampleRate / WWD_MIXER_SAMPLE_RATE;
+    uint32_t bytesPerSample = sample->bitsPerSample / 8;
+    uint32_t bytesPerSourceFrame = bytesPerSample * sample->channels;
+    uint32_t totalSamples = sample->dataSize / bytesPerSourceFrame;
+    if (totalSamples == 0) {
+        channel->playing = false;
+        return;
+    }
+
+    // position is stored in samples * 256 (8.8 fixed point)
+    double srcSamplePos = (double)channel->position / 256.0;
+
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        uint32_t srcSampleIdx = (uint32_t)srcSamplePos;
+
+        if (srcSampleIdx >= totalSamples) {
+            if (channel->loop) {
+                srcSampleIdx = srcSampleIdx % totalSamples;
+            } else {
+                channel->playing = false;
+                break;
+            }
+        }
+        const uint8_t* src = sample->data + srcSampleIdx * bytesPerSourceFrame;
+
+        float sampleValue = bytesPerSample == 1 ? Sample8ToFloat(src[0])
+                                                : Sample16ToFloat(src);
+        if (sample->channels == 2) {
+            // Left sample to left, right sample to right
+            float rightSample = bytesPerSample == 1
+                ? Sample8ToFloat(src[1]) : Sample16ToFloat(src + 2);
+            left[frame] += sampleValue * leftVol;
+            right[frame] += rightSample * rightVol;
+        } else {
+            // Mono - send to both channels
+            left[frame] += sampleValue * leftVol;
+            right[frame] += sampleValue * rightVol;
+        }
+
+        srcSamplePos += sampleRatio;
+    }
+
+    if (channel->playing) {
+        channel->position = (uint32_t)(srcSamplePos * 256.0);
+        if (channel->position / 256 >= totalSamples) {
+            if (channel->loop) {
+                channel->position %= totalSamples * 256;
+            } else {
+                channel->playing = false;
+            }
+        }
+    }
+    if (!channel->playing) channel->handle = 0;
+}
+
+static void MixMusic(WwdMixer* mixer, float gain, float* left, float* right,
+                     uint32_t frames) {
+    // Request half as many samples (22050 Hz source -> 44100 Hz output)
+    int samplesToGet = (int)(frames / 2) + 1;
+    if (samplesToGet > MUSIC_MAX_SAMPLES) samplesToGet = MUSIC_MAX_SAMPLES;
+
+    int16_t* buffer = mixer->streamBuffer;
+    int samplesGot = mixer->music(buffer, samplesToGet, mixer->musicUserdata);
+    if (samplesGot <= 0) return;
+
+    // Upsample 2x with linear interpolation
+    for (uint32_t i = 0; i < frames; i++) {
+        float srcPos = (float)i * 0.5f;
+        int srcIdx = (int)srcPos;
+        float frac = srcPos - (float)srcIdx;
+
+        int16_t s0 = (srcIdx < samplesGot) ? buffer[srcIdx] : 0;
+        int16_t s1 = (srcIdx + 1 < samplesGot) ? buffer[srcIdx + 1] : s0;
+
+        float interp = (1.0f - frac) * (float)s0 + frac * (float)s1;
+        float sample = interp / 32768.0f * gain;
+
+        // Music is mono - send to both channels
+        left[i] += sample;
+        right[i] += sample;
+    }
+}
+
+static void MixVideo(WwdMixer* mixer, float gain, float* left, float* right,
+                     uint32_t frames) {
+    float resampleRatio = (float)mixer->videoSampleRate / WWD_MIXER_SAMPLE_RATE;
+    int samplesToGet = (int)(frames * resampleRatio) + 1;
+    if (samplesToGet > (int)WWD_MIXER_MAX_FRAMES) samplesToGet = WWD_MIXER_MAX_FRAMES;
+
+    int16_t* buffer = mixer->streamBuffer;
+    int samplesGot = mixer->video(buffer, samplesToGet, mixer->videoUserdata);
+
+    // Hold and fade the last sample through underruns to avoid clicks
+    for (uint32_t i = 0; i < frames; i++) {
+        float srcPos = (float)i * resampleRatio;
+        int srcIdx = (int)srcPos;
+        float frac = srcPos - (float)srcIdx;
+
+        int16_t s0;
+        if (srcIdx < samplesGot) {
+            s0 = buffer[srcIdx];
+            mixer->videoLastSample = s0;
+            mixer->videoUnderrunFade = 0;
+        } else if (mixer->videoUnderrunFade < VIDEO_UNDERRUN_FADE) {
+            float fadeRatio = 1.0f - (float)mixer->videoUnderrunFade / VIDEO_UNDERRUN_FADE;
+            s0 = (int16_t)(mixer->videoLastSample * fadeRatio);
+            mixer->videoUnderrunFade++;
+        } else {
+            s0 = 0;
+        }
+        int16_t s1 = (srcIdx + 1 < samplesGot) ? buffer[srcIdx + 1] : s0;
+
+        float interpolated = (1.0f - frac) * (float)s0 + frac * (float)s1;
+        float sample = interpolated / 32768.0f * gain;
+
+        // Video audio is mono - send to both channels
+        left[i] += sample;
+        right[i] += sample;
+    }
+}
+
+static void RenderBlock(WwdMixer* mixer, float* left, float* right,
+                        uint32_t frames) {
+    memset(left, 0, frames * sizeof(float));
+    memset(right, 0, frames * sizeof(float));
+
+    if (mixer->paused.load(std::memory_order_relaxed)) return;
+
+    float masterVol = (float)mixer->masterVolume.load(std::memory_order_relaxed) / 255.0f;
+    float soundVol = (float)mixer->soundVolume.load(std::memory_order_relaxed) / 255.0f;
+
+    for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
+        WwdMixerChannel* ch = &mixer->channels[i];
+        if (ch->playing && ch->sample) {
+            MixChannel(ch, masterVol * soundVol, left, right, frames);
+        }
+    }
+
+    if (mixer->music) {
+        MixMusic(mixer, mixer->musicVolume.load(std::memory_order_relaxed) * masterVol,
+                 left, right, frames);
+    }
+    if (mixer->video) {
+        MixVideo(mixer, mixer->videoVolume.load(std::memory_order_relaxed) * masterVol,
+                 left, right, frames);
+    }
+
+    // Clamp output to prevent clipping
+    for (uint32_t i = 0; i < frames; i++) {
+        if (left[i] > 1.0f) left[i] = 1.0f;
+        if (left[i] < -1.0f) left[i] = -1.0f;
+        if (right[i] > 1.0f) right[i] = 1.0f;
+        if (right[i] < -1.0f) right[i] = -1.0f;
+    }
+}
+
+void Wwd_Mixer_Render(WwdMixer* mixer, float* left, float* right,
+                      uint32_t frames) {
+    // Commands apply at buffer boundaries; channel state is ours from here
+    ApplyCommands(mixer);
+
+    while (frames > 0) {
+        uint32_t block = frames < WWD_MIXER_MAX_FRAMES ? frames : WWD_MIXER_MAX_FRAMES;
+        RenderBlock(mixer, left, right, block);
+        left += block;
+        right += block;
+        frames -= block;
+    }
+
+    PublishChannels(mixer);
+}
+
+//===========================================================================
+// Null Output
+//===========================================================================
+
+static void NullOutputThread(WwdNullOutput* output) {
+    std::vector<float> left(output->framesPerBuffer);
+    std::vector<float> right(output->framesPerBuffer);
+    auto period = std::chrono::microseconds(
+        (int64_t)output->framesPerBuffer * 1000000 / WWD_MIXER_SAMPLE_RATE);
+    auto next = std::chrono::steady_clock::now();
+
+    while (output->running.load(std::memory_order_acquire)) {
+        Wwd_Mixer_Render(output->mixer, left.data(), right.data(),
+                         output->framesPerBuffer);
+        output->buffersRendered.fetch_add(1, std::memory_order_relaxed);
+
+        if (output->realtime) {
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+    }
+}
+
+bool Wwd_NullOutput_Start(WwdNullOutput* output, WwdMixer* mixer,
+                          uint32_t framesPerBuffer, bool realtime) {
+    if (!output || !mixer || framesPerBuffer == 0) return false;
+
+    output->mixer = mixer;
+    output->framesPerBuffer = framesPerBuffer;
+    output->realtime = realtime;
+    output->buffersRendered.store(0, std::memory_order_relaxed);
+    output->running.store(true, std::memory_order_release);
+    output->thread = std::thread(NullOutputThread, output);
+    return true;
+}
+
+void Wwd_NullOutput_Stop(WwdNullOutput* output) {
+    if (!output->running.exchange(false)) return;
+    if (output->thread.joinable()) output->thread.join();
+}
@@ -0,0 +1,151 @@
+/**
+ * wwd-media - Palette Conversion Kernel Implementation
+ */
+
+#include "wwd/palette_lut.h"
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define WWD_PALETTE_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define WWD_PALETTE_SSE2 1
+#endif
+
+//===========================================================================
+// Table Construction
+//===========================================================================
+
+bool Wwd_PaletteLut_Update(WwdPaletteLut* lut, const WwdPalette* palette) {
+    if (!lut || !palette) return false;
+    if (lut->valid && memcmp(&lut->source, palette, sizeof(WwdPalette)) == 0) {
+        return false;
+    }
+
+    for (int a = 0; a < WWD_PALETTE_DIM_LEVELS; a++) {
+        uint32_t* row = lut->rgba[a];
+        for (int i = 0; i < 256; i++) {
+            uint32_t r = palette->colors[i][0];
+            uint32_t g = palette->colors[i][1];
+            uint32_t b = palette->colors[i][2];
+
+            // Blend toward black; alpha 255 is full colour
+            if (a < 255) {
+                r = (r * a) >> 8;
+                g = (g * a) >> 8;
+                b = (b * a) >> 8;
+            }
+            row[i] = 0xFF000000u | (b << 16) | (g << 8) | r;
+        }
+    }
+
+    memcpy(&lut->source, palette, sizeof(WwdPalette));
+    lut->valid = true;
+    return true;
+}
+
+//===========================================================================
+// Conversion
+//===========================================================================
+
+void Wwd_PaletteLut_ConvertScalar(const WwdPaletteLut* lut,
+                                  const uint8_t* pixels, const uint8_t* alpha,
+                                  uint32_t* out, size_t count) {
+    const uint32_t* table = &lut->rgba[0][0];
+    for (size_t i = 0; i < count; i++) {
+        out[i] = table[((size_t)alpha[i] << 8) | pixels[i]];
+    }
+}
+
+// Convert one block whose pixels all share a dim level
+static inline void ConvertUniformBlock(const uint32_t* row,
+                                       const uint8_t* pixels, uint32_t* out) {
+    for (int k = 0; k < WWD_PALETTE_BLOCK; k++) {
+        out[k] = row[pixels[k]];
+    }
+}
+
+#if WWD_PALETTE_NEON || WWD_PALETTE_SSE2
+
+// True if all 16 alpha bytes equal the first one
+static inline bool AlphaBlockUniform(const uint8_t* alpha) {
+#if WWD_PALETTE_NEON
+    uint8x16_t a = vld1q_u8(alpha);
+    uint8x16_t same = vceqq_u8(a, vdupq_n_u8(alpha[0]));
+    uint64x2_t lanes = vreinterpretq_u64_u8(same);
+    return (vgetq_lane_u64(lanes, 0) & vgetq_lane_u64(lanes, 1)) == ~0ull;
+#else
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alpha));
+    __m128i same = _mm_cmpeq_epi8(a, _mm_set1_epi8((char)alpha[0]));
+    return _mm_movemask_epi8(same) == 0xFFFF;
+#endif
+}
+
+void Wwd_PaletteLut_Convert(const WwdPaletteLut* lut, const uint8_t* pixels,
+                            const uint8_t* alpha, uint32_t* out, size_t count) {
+    size_t blocks = count / WWD_PALETTE_BLOCK;
+
+    // Fog is applied per cell, so most blocks have a single dim level
+    // and can index one table row without touching the alpha bytes again
+    for (size_t b = 0; b < blocks; b++) {
+        if (AlphaBlockUniform(alpha)) {
+            ConvertUniformBlock(lut->rgba[alpha[0]], pixels, out);
+        } else {
+            Wwd_PaletteLut_ConvertScalar(lut, pixels, alpha, out,
+                                         WWD_PALETTE_BLOCK);
+        }
+        pixels += WWD_PALETTE_BLOCK;
+        alpha += WWD_PALETTE_BLOCK;
+        out += WWD_PALETTE_BLOCK;
+    }
+
+    Wwd_PaletteLut_ConvertScalar(lut, pixels, alpha, out,
+                                 count - blocks * WWD_PALETTE_BLOCK);
+}
+
+#else
+
+void Wwd_PaletteLut_Convert(const WwdPaletteLut* lut, const uint8_t* pixels,
+                            const uint8_t* alpha, uint32_t* out, size_t count) {
+    Wwd_PaletteLut_ConvertScalar(lut, pixels, alpha, out, count);
+}
+
+#endif
+
+//===========================================================================
+// Change-Limited Conversion
+//===========================================================================
+
+WwdRect Wwd_PaletteLut_ConvertChanged(const WwdPaletteLut* lut,
+                                      const WwdRect* rect, int stride,
+                                      const uint8_t* pixels,
+                                      const uint8_t* alpha,
+                                      uint8_t* prevPixels, uint8_t* prevAlpha,
+                                      uint32_t* out, bool force) {
+    int firstRow = -1;
+    int lastRow = -1;
+
+    for (int y = rect->y; y < rect->y + rect->height; y++) {
+        size_t offset = (size_t)y * stride + rect->x;
+        size_t width = (size_t)rect->width;
+
+        // Redrawn but identical rows (static screens) cost only a compare
+        if (!force &&
+            memcmp(pixels + offset, prevPixels + offset, width) == 0 &&
+            memcmp(alpha + offset, prevAlpha + offset, width) == 0) {
+            continue;
+        }
+
+        Wwd_PaletteLut_Convert(lut, pixels + offset, alpha + offset,
+                               out + offset, width);
+        memcpy(prevPixels + offset, pixels + offset, width);
+        memcpy(prevAlpha + offset, alpha + offset, width);
+
+        if (firstRow < 0) firstRow = y;
+        lastRow = y;
+    }
+
+    if (firstRow < 0) return {rect->x, rect->y, rect->width, 0};
+    return {rect->x, firstRow, rect->width, lastRow - firstRow + 1};
+}
@@ -9,6 +9,9 @@
 #import <simd/simd.h>
 
 #include "wwd/renderer.h"
+#include "wwd/palette_lut.h"
+#include "wwd/dirty_rects.h"
+#include "wwd/span_sprite.h"
 #include <cstring>
 #include <cstdlib>
 
@@ -68,6 +71,14 @@ static struct {
     uint8_t* alphaBuffer;       // 8-bit alpha buffer (255=opaque, 0=black)
     uint32_t* rgbaBuffer;       // RGBA conversion buffer
     WwdPalette palette;          // Current palette
+    WwdPaletteLut paletteLut;    // Palette x dim level RGBA table
+
+    // Dirty tracking: regions written since the last present, and the
+    // indexed/alpha contents as they were when last converted
+    WwdFrameDirty frame;
+    uint8_t* presentedPixels;
+    uint8_t* presentedAlpha;
+    bool presentedValid;         // False forces a full conversion
 
     bool initialized;
 } g_renderer = {};
@@ -139,9 +150,12 @@ WwdBool Wwd_Renderer_Init(void* metalView) {
     g_renderer.framebuffer = (uint8_t*)calloc(pixelCount, sizeof(uint8_t));
     g_renderer.alphaBuffer = (uint8_t*)malloc(pixelCount);
     g_renderer.rgbaBuffer = (uint32_t*)calloc(pixelCount, sizeof(uint32_t));
+    g_renderer.presentedPixels = (uint8_t*)calloc(pixelCount, sizeof(uint8_t));
+    g_renderer.presentedAlpha = (uint8_t*)calloc(pixelCount, sizeof(uint8_t));
 
     bool alloc = g_renderer.framebuffer && g_renderer.alphaBuffer &&
-                 g_renderer.rgbaBuffer;
+                 g_renderer.rgbaBuffer && g_renderer.presentedPixels &&
+                 g_renderer.presentedAlpha;
     if (!alloc) {
         NSLog(@"Wwd_Renderer_Init: Failed to allocate framebuffer");
         Wwd_Renderer_Shutdown();
@@ -158,6 +172,10 @@ WwdBool Wwd_Renderer_Init(void* metalView) {
         g_renderer.palette.colors[i][2] = i;
     }
 
+    // First present converts and uploads everything
+    Wwd_FrameDirty_Reset(&g_renderer.frame);
+    g_renderer.presentedValid = false;
+
     // Enable continuous rendering
     view.paused = NO;
     view.enableSetNeedsDisplay = NO;
@@ -181,6 +199,14 @@ void Wwd_Renderer_Shutdown(void) {
         free(g_renderer.rgbaBuffer);
         g_renderer.rgbaBuffer = nullptr;
     }
+    if (g_renderer.presentedPixels) {
+        free(g_renderer.presentedPixels);
+        g_renderer.presentedPixels = nullptr;
+    }
+    if (g_renderer.presentedAlpha) {
+        free(g_renderer.presentedAlpha);
+        g_renderer.presentedAlpha = nullptr;
+    }
 
     g_renderer.pipelineState = nil;
     g_renderer.framebufferTexture = nil;
@@ -191,6 +217,17 @@ void Wwd_Renderer_Shutdown(void) {
     g_renderer.initialized = false;
 }
 
+// Record a region written by a drawing call
+static inline void MarkDirty(int x, int y, int width, int height) {
+    Wwd_FrameDirty_Draw(&g_renderer.frame, x, y, width, height);
+}
+
+void Wwd_Renderer_MarkDirty(int x, int y, int width, int height) {
+    // Raw writes may have touched either buffer
+    Wwd_FrameDirty_Draw(&g_renderer.frame, x, y, width, height);
+    Wwd_FrameDirty_SetAlpha(&g_renderer.frame, x, y, width, height);
+}
+
 uint8_t* Wwd_Renderer_GetFramebuffer(void) {
     return g_renderer.framebuffer;
 }
@@ -214,34 +251,37 @@ void Wwd_Renderer_Present(void) {
         return;
     }
 
-    // Convert indexed framebuffer to RGBA, applying alpha for fog of war
-    size_t pixelCount = FBW * FBH;
-    for (size_t i = 0; i < pixelCount; i++) {
-        uint8_t idx = g_renderer.framebuffer[i];
-        uint8_t alpha = g_renderer.alphaBuffer[i];
-
-        uint8_t r = g_renderer.palette.colors[idx][0];
-        uint8_t g = g_renderer.palette.colors[idx][1];
-        uint8_t b = g_renderer.palette.colors[idx][2];
-
-        // Apply alpha: blend toward black (0,0,0) based on alpha
-        // alpha=255 means full color, alpha=0 means black
-        if (alpha < 255) {
-            r = (r * alpha) >> 8;
-            g = (g * alpha) >> 8;
-            b = (b * alpha) >> 8;
-        }
-
-        // RGBA8 format: 0xAABBGGRR (little-endian)
-        g_renderer.rgbaBuffer[i] = 0xFF000000 | (b << 16) | (g << 8) | r;
+    // Convert indexed framebuffer to RGBA, applying alpha for fog of war.
+    // Only dirty regions are examined, and within them only rows that
+    // differ from what was last uploaded are converted and sent.
+    bool force = !g_renderer.presentedValid;
+    if (Wwd_PaletteLut_Update(&g_renderer.paletteLut, &g_renderer.palette)) {
+        force = true;
+    }
+    WwdDirtyRects* dirty = &g_renderer.frame.dirty;
+    if (force) {
+        Wwd_DirtyRects_AddAll(dirty);
     }
 
-    // Upload to texture
-    MTLRegion region = MTLRegionMake2D(0, 0, FBW, FBH);
-    [g_renderer.framebufferTexture replaceRegion:region
-                                     mipmapLevel:0
-                                       withBytes:g_renderer.rgbaBuffer
-                                     bytesPerRow:FBW * sizeof(uint32_t)];
+    for (int i = 0; i < dirty->count; i++) {
+        WwdRect changed = Wwd_PaletteLut_ConvertChanged(
+            &g_renderer.paletteLut, &dirty->rects[i], FBW,
+            g_renderer.framebuffer, g_renderer.alphaBuffer,
+            g_renderer.presentedPixels, g_renderer.presentedAlpha,
+            g_renderer.rgbaBuffer, force);
+        if (changed.height == 0) continue;
+
+        // Upload just the changed span
+        MTLRegion region = MTLRegionMake2D(changed.x, changed.y,
+                                           changed.width, changed.height);
+        const uint32_t* src = g_renderer.rgbaBuffer + changed.y * FBW + changed.x;
+        [g_renderer.framebufferTexture replaceRegion:region
+                                         mipmapLevel:0
+                                           withBytes:src
+                                         bytesPerRow:FBW * sizeof(uint32_t)];
+    }
+    Wwd_FrameDirty_Presented(&g_renderer.frame);
+    g_renderer.presentedValid = true;
 
     // Get drawable
     id<CAMetalDrawable> drawable = g_renderer.view.currentDrawable;
@@ -269,6 +309,7 @@ void Wwd_Renderer_Present(void) {
 }
 
 void Wwd_Renderer_Clear(uint8_t colorIndex) {
+    Wwd_FrameDirty_Clear(&g_renderer.frame, colorIndex);
     if (g_renderer.framebuffer) {
         memset(g_renderer.framebuffer, colorIndex, FBW * FBH);
     }
@@ -289,6 +330,7 @@ void Wwd_Renderer_FillRect(int x, int y, int width, int height,
     if (y + height > FBH) { height = FBH - y; }
 
     if (width <= 0 || height <= 0) return;
+    MarkDirty(x, y, width, height);
 
     for (int row = 0; row < height; row++) {
         uint8_t* dest = g_renderer.framebuffer + (y + row) * FBW + x;
@@ -299,6 +341,7 @@ void Wwd_Renderer_FillRect(int x, int y, int width, int height,
 void Wwd_Renderer_PutPixel(int x, int y, uint8_t colorIndex) {
     if (!g_renderer.framebuffer) return;
     if (x < 0 || x >= FBW || y < 0 || y >= FBH) return;
+    MarkDirty(x, y, 1, 1);
 
     g_renderer.framebuffer[y * FBW + x] = colorIndex;
 }
@@ -348,6 +391,7 @@ void Wwd_Renderer_HLine(int x1, int x2, int y, uint8_t colorIndex) {
     if (x2 >= g_clipX + g_clipWidth) x2 = g_clipX + g_clipWidth - 1;
 
     if (x1 > x2) return;
+    MarkDirty(x1, y, x2 - x1 + 1, 1);
 
     uint8_t* dest = g_renderer.framebuffer + y * FBW + x1;
     memset(dest, colorIndex, x2 - x1 + 1);
@@ -363,6 +407,7 @@ void Wwd_Renderer_VLine(int x, int y1, int y2, uint8_t colorIndex) {
     if (y2 >= g_clipY + g_clipHeight) y2 = g_clipY + g_clipHeight - 1;
 
     if (y1 > y2) return;
+    MarkDirty(x, y1, 1, y2 - y1 + 1);
 
     uint8_t* dest = g_renderer.framebuffer + y1 * FBW + x;
     for (int y = y1; y <= y2; y++) {
@@ -374,6 +419,9 @@ void Wwd_Renderer_VLine(int x, int y1, int y2, uint8_t colorIndex) {
 void Wwd_Renderer_DrawLine(int x1, int y1, int x2, int y2, uint8_t colorIndex) {
     if (!g_renderer.framebuffer) return;
 
+    MarkDirty((x1 < x2) ? x1 : x2, (y1 < y2) ? y1 : y2,
+              abs(x2 - x1) + 1, abs(y2 - y1) + 1);
+
     // Bresenham's line algorithm
     int dx = abs(x2 - x1);
     int dy = abs(y2 - y1);
@@ -411,6 +459,8 @@ void Wwd_Renderer_DrawRect(int x, int y, int width, int height,
 void Wwd_Renderer_DrawCircle(int cx, int cy, int radius, uint8_t colorIndex) {
     if (!g_renderer.framebuffer || radius <= 0) return;
 
+    MarkDirty(cx - radius, cy - radius, 2 * radius + 1, 2 * radius + 1);
+
     // Midpoint circle algorithm
     int x = radius;
     int y = 0;
@@ -465,6 +515,7 @@ void Wwd_Renderer_FillCircle(int cx, int cy, int radius, uint8_t colorIndex) {
 void Wwd_Renderer_Blit(const uint8_t* srcData, int srcWidth, int srcHeight,
                       int destX, int destY, WwdBool trans) {
     if (!g_renderer.framebuffer || !srcData) return;
+    MarkDirty(destX, destY, srcWidth, srcHeight);
 
     for (int sy = 0; sy < srcHeight; sy++) {
         int dy = destY + sy;
@@ -486,6 +537,7 @@ void Wwd_Renderer_BlitRegion(const uint8_t* srcData, int srcWidth, int srcHeight
                             int srcX, int srcY, int regionWidth, int regionHeight,
                             int destX, int destY, WwdBool trans) {
     if (!g_renderer.framebuffer || !srcData) return;
+    MarkDirty(destX, destY, regionWidth, regionHeight);
 
     for (int ry = 0; ry < regionHeight; ry++) {
         int sy = srcY + ry;
@@ -514,6 +566,7 @@ void Wwd_Renderer_ScaleBlit(const uint8_t* srcData, int srcWidth, int srcHeight,
                            WwdBool trans) {
     if (!g_renderer.framebuffer || !srcData) return;
     if (destWidth <= 0 || destHeight <= 0) return;
+    MarkDirty(destX, destY, destWidth, destHeight);
 
     // Fixed-point scaling
     int xRatio = (srcWidth << 16) / destWidth;
@@ -544,6 +597,7 @@ void Wwd_Renderer_ScaleBlit(const uint8_t* srcData, int srcWidth, int srcHeight,
 void Wwd_Renderer_Remap(int x, int y, int width, int height,
                        const uint8_t* remap) {
     if (!g_renderer.framebuffer || !remap) return;
+    MarkDirty(x, y, width, height);
 
     // Clip
     int x1 = (x < g_clipX) ? g_clipX : x;
@@ -564,6 +618,7 @@ void Wwd_Renderer_Remap(int x, int y, int width, int height,
 
 void Wwd_Renderer_DimRect(int x, int y, int width, int height, int amount) {
     if (!g_renderer.framebuffer || amount <= 0) return;
+    MarkDirty(x, y, width, height);
 
     // Clip
     int x1 = (x < g_clipX) ? g_clipX : x;
@@ -602,6 +657,7 @@ void Wwd_Renderer_SetAlpha(int x, int y, int width, int height, uint8_t alpha) {
     if (y2 > FBH) y2 = FBH;
 
     if (x1 >= x2 || y1 >= y2) return;
+    Wwd_FrameDirty_SetAlpha(&g_renderer.frame, x1, y1, x2 - x1, y2 - y1);
 
     int rowWidth = x2 - x1;
     for (int py = y1; py < y2; py++) {
@@ -611,6 +667,7 @@ void Wwd_Renderer_SetAlpha(int x, int y, int width, int height, uint8_t alpha) {
 }
 
 void Wwd_Renderer_ClearAlpha(void) {
+    Wwd_FrameDirty_ClearAlpha(&g_renderer.frame);
     if (g_renderer.alphaBuffer) {
         memset(g_renderer.alphaBuffer, 255, FBW * FBH);
     }
@@ -680,6 +737,7 @@ int Wwd_Renderer_DrawText(const char* text, int x, int y,
     if (!g_renderer.framebuffer || !text) return 0;
 
     int startX = x;
+    MarkDirty(x, y, 8 * (int)strlen(text), 8);
 
     while (*text) {
         unsigned char c = (unsigned char)*text;
@@ -730,6 +788,7 @@ void Wwd_Renderer_BlitRemapped(const uint8_t* srcData, int srcWidth,
         Wwd_Renderer_Blit(srcData, srcWidth, srcHeight, destX, destY, trans);
         return;
     }
+    MarkDirty(destX, destY, srcWidth, srcHeight);
 
     for (int sy = 0; sy < srcHeight; sy++) {
         int dy = destY + sy;
@@ -756,3 +815,21 @@ void Wwd_Renderer_BlitSpriteRemapped(const uint8_t* pixels, int width,
     int dy = destY - offsetY;
     Wwd_Renderer_BlitRemapped(pixels, width, height, dx, dy, trans, remap);
 }
+
+void Wwd_Renderer_BlitSpans(const uint8_t* spans, int width, int height,
+                           int destX, int destY, const uint8_t* remap) {
+    if (!g_renderer.framebuffer || !spans) return;
+    MarkDirty(destX, destY, width, height);
+
+    WwdRect clip = { g_clipX, g_clipY, g_clipWidth, g_clipHeight };
+    Wwd_SpanSprite_Blit(spans, width, height, g_renderer.framebuffer, FBW,
+                        &clip, destX, destY, remap);
+}
+
+void Wwd_Renderer_BlitSpriteSpans(const uint8_t* spans, int width, int height,
+                                 int destX, int destY, int offsetX, int offsetY,
+                                 const uint8_t* remap) {
+    int dx = destX - offsetX;
+    int dy = destY - offsetY;
+    Wwd_Renderer_BlitSpans(spans, width, height, dx, dy, remap);
+}
@@ -0,0 +1,174 @@
+/**
+ * wwd-media - Span-Encoded Sprites Implementation
+ */
+
+#include "wwd/span_sprite.h"
+#include <cstring>
+
+//===========================================================================
+// Encoding
+//===========================================================================
+
+// Encode one row, or with out == NULL just measure it. Trailing
+// transparency needs no entry: the terminator ends the row.
+static size_t EncodeRow(const uint8_t* row, int width, uint8_t* out) {
+    size_t n = 0;
+    int x = 0;
+
+    while (x < width) {
+        int skip = 0;
+        while (x < width && row[x] == 0) { skip++; x++; }
+        if (x == width) break;
+
+        int run = 0;
+        while (x + run < width && row[x + run] != 0) run++;
+        const uint8_t* src = row + x;
+        x += run;
+
+        while (skip > 255) {
+            if (out) { out[n] = 255; out[n + 1] = 0; }
+            n += 2;
+            skip -= 255;
+        }
+        while (run > 0) {
+            int chunk = (run > 255) ? 255 : run;
+            if (out) {
+                out[n] = (uint8_t)skip;
+                out[n + 1] = (uint8_t)chunk;
+                memcpy(out + n + 2, src, (size_t)chunk);
+            }
+            n += 2 + (size_t)chunk;
+            src += chunk;
+            run -= chunk;
+            skip = 0;
+        }
+    }
+
+    if (out) { out[n] = 0; out[n + 1] = 0; }
+    return n + 2;
+}
+
+size_t Wwd_SpanSprite_EncodedSize(const uint8_t* pixels, int width, int height) {
+    if (!pixels || width <= 0 || height <= 0) return 0;
+    size_t size = (size_t)height * sizeof(uint32_t);
+    for (int y = 0; y < height; y++) {
+        size += EncodeRow(pixels + (size_t)y * width, width, nullptr);
+    }
+    return size;
+}
+
+size_t Wwd_SpanSprite_Encode(const uint8_t* pixels, int width, int height,
+                             uint8_t* out) {
+    if (!pixels || !out || width <= 0 || height <= 0) return 0;
+
+    uint32_t* rowStart = reinterpret_cast<uint32_t*>(out);
+    size_t pos = (size_t)height * sizeof(uint32_t);
+    for (int y = 0; y < height; y++) {
+        rowStart[y] = (uint32_t)pos;
+        pos += EncodeRow(pixels + (size_t)y * width, width, out + pos);
+    }
+    return pos;
+}
+
+// Bytes from a row's start to just past its terminator
+static size_t RowSize(const uint8_t* row) {
+    const uint8_t* s = row;
+    while ((s[0] | s[1]) != 0) s += 2 + s[1];
+    return (size_t)(s + 2 - row);
+}
+
+size_t Wwd_SpanSprite_Size(const uint8_t* spans, int height) {
+    if (!spans || height <= 0) return 0;
+    // Rows are stored in order, so the last one ends the sprite
+    const uint32_t* rowStart = reinterpret_cast<const uint32_t*>(spans);
+    return rowStart[height - 1] + RowSize(spans + rowStart[height - 1]);
+}
+
+void Wwd_SpanSprite_Remap(const uint8_t* spans, int height,
+                          const uint8_t* remap, uint8_t* out) {
+    size_t size = Wwd_SpanSprite_Size(spans, height);
+    if (size == 0 || !remap || !out) return;
+    memcpy(out, spans, size);
+
+    const uint32_t* rowStart = reinterpret_cast<const uint32_t*>(out);
+    for (int y = 0; y < height; y++) {
+        uint8_t* s = out + rowStart[y];
+        while ((s[0] | s[1]) != 0) {
+            int run = s[1];
+            for (int i = 0; i < run; i++) s[2 + i] = remap[s[2 + i]];
+            s += 2 + run;
+        }
+    }
+}
+
+//===========================================================================
+// Drawing
+//===========================================================================
+
+// Unit runs are mostly a dozen or so pixels, too short to pay for a
+// memcpy call; long ones (buildings, wide frames) still use it
+static const int MEMCPY_MIN_RUN = 32;
+
+static inline void CopyRun(uint8_t* dest, const uint8_t* src, int count,
+                           const uint8_t* remap) {
+    if (remap) {
+        for (int i = 0; i < count; i++) dest[i] = remap[src[i]];
+    } else if (count >= MEMCPY_MIN_RUN) {
+        memcpy(dest, src, (size_t)count);
+    } else {
+        for (int i = 0; i < count; i++) dest[i] = src[i];
+    }
+}
+
+void Wwd_SpanSprite_Blit(const uint8_t* spans, int width, int height,
+                         uint8_t* dest, int stride, const WwdRect* clip,
+                         int destX, int destY, const uint8_t* remap) {
+    if (!spans || !dest || !clip || width <= 0 || height <= 0) return;
+
+    // Clip vertically once for the whole sprite
+    int clipRight = clip->x + clip->width;
+    int clipBottom = clip->y + clip->height;
+    int firstRow = (destY < clip->y) ? clip->y - destY : 0;
+    int lastRow = (destY + height > clipBottom) ? clipBottom - destY : height;
+    if (firstRow >= lastRow) return;
+    if (destX >= clipRight || destX + width <= clip->x) return;
+
+    const uint32_t* rowStart = reinterpret_cast<const uint32_t*>(spans);
+    bool clipped = destX < clip->x || destX + width > clipRight;
+
+    for (int y = firstRow; y < lastRow; y++) {
+        const uint8_t* s = spans + rowStart[y];
+        uint8_t* row = dest + (size_t)(destY + y) * stride;
+        int x = destX;
+
+        if (!clipped) {
+            for (;;) {
+                int skip = s[0];
+                int run = s[1];
+                if ((skip | run) == 0) break;
+                x += skip;
+                CopyRun(row + x, s + 2, run, remap);
+                x += run;
+                s += 2 + run;
+            }
+            continue;
+        }
+
+        // Sprite straddles a side edge: trim each run to the clip span
+        for (;;) {
+            int skip = s[0];
+            int run = s[1];
+            if ((skip | run) == 0) break;
+            x += skip;
+            if (x >= clipRight) break;
+
+            int left = (x < clip->x) ? clip->x : x;
+            int right = (x + run > clipRight) ? clipRight : x + run;
+            if (left < right) {
+                CopyRun(row + left, s + 2 + (left - x), right - left, remap);
+            }
+            x += run;
+            s += 2 + run;
+        }
+    }
+}
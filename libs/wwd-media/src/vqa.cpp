@@ -165,7 +165,8 @@ WwdVqaPlayer::WwdVqaPlayer()
     : data_(nullptr)
     , dataSize_(0)
     , ownsData_(false)
-    , frameOffsets_(nullptr)
+    , frameIndex_(nullptr)
+    , frameIndexCount_(0)
     , state_(WwdVqaState::STOPPED)
     , currentFrame_(-1)
     , timeAccumulator_(0)
@@ -268,8 +269,9 @@ void WwdVqaPlayer::Unload() {
     dataSize_ = 0;
     ownsData_ = false;
 
-    delete[] frameOffsets_;
-    frameOffsets_ = nullptr;
+    delete[] frameIndex_;
+    frameIndex_ = nullptr;
+    frameIndexCount_ = 0;
 
     delete[] frameBuffer_;
     frameBuffer_ = nullptr;
@@ -347,8 +349,10 @@ bool WwdVqaPlayer::ParseHeader() {
     ptr += 4;
     printf("VQA: ParseHeader - FORM/WVQA OK\n");
 
-    // Find VQHD chunk
+    // Find VQHD and FINF chunks
     bool foundHeader = false;
+    const uint8_t* finf = nullptr;
+    uint32_t finfSize = 0;
     while (ptr + 8 <= end) {
         const IFFChunk* chunk = (const IFFChunk*)ptr;
         uint32_t chunkId = SwapBE32(chunk->id);
@@ -362,10 +366,9 @@ bool WwdVqaPlayer::ParseHeader() {
             memcpy(&header_, ptr, sizeof(WwdVqaHeader));
             foundHeader = true;
         } else if (chunkId == VQA_ID_FINF) {
-            // Parse frame index
-            if (!ParseFrameIndex()) {
-                return false;
-            }
+            // Parsed once the header (and so the frame count) is known
+            finf = ptr;
+            finfSize = chunkSize;
         }
 
         // Move to next chunk (pad to even boundary)
@@ -373,7 +376,7 @@ bool WwdVqaPlayer::ParseHeader() {
         if (chunkSize & 1) ptr++;
 
         // Stop after we have what we need
-        if (foundHeader && frameOffsets_) break;
+        if (foundHeader && finf) break;
     }
 
     if (!foundHeader) {
@@ -387,6 +390,11 @@ bool WwdVqaPlayer::ParseHeader() {
         return false;
     }
 
+    // Index every frame up front so decoding never rescans the file
+    if (!ParseFrameIndex(finf, finfSize) && !ScanFrameIndex()) {
+        return false;
+    }
+
     // Allocate frame buffer
     frameBufferSize_ = header_.width * header_.height;
     frameBuffer_ = new uint8_t[frameBufferSize_];
@@ -437,18 +445,127 @@ bool WwdVqaPlayer::ParseHeader() {
     return true;
 }
 
-bool WwdVqaPlayer::ParseFrameIndex() {
-    // FINF contains 32-bit offsets for each frame
-    // Already positioned at FINF data
+bool WwdVqaPlayer::ParseFrameIndex(const uint8_t* finf, uint32_t finfSize) {
+    // FINF holds one little-endian dword per frame: the offset (in words)
+    // of the frame's first chunk, with flags in the top two bits
+    if (!finf || finfSize < (uint32_t)header_.frames * 4) {
+        return false;
+    }
+
+    FrameEntry* index = new FrameEntry[header_.frames];
+
+    for (int i = 0; i < header_.frames; i++) {
+        const uint8_t* p = finf + i * 4;
+        uint32_t value = (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+                         ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+        index[i].start = (value & VQA_FINF_OFFSET_MASK) << 1;
+
+        // Some encoders leave FINF stale or zeroed; any offset that doesn't
+        // land on a frame's first chunk sends us back to scanning
+        bool valid = index[i].start + 8 <= dataSize_ &&
+                     (i == 0 || index[i].start > index[i - 1].chunk);
+        if (valid) {
+            uint32_t firstId = SwapBE32(((const IFFChunk*)(data_ + index[i].start))->id);
+            valid = (firstId == VQA_ID_VQFR || firstId == VQA_ID_VQFK ||
+                     firstId == VQA_ID_SND0 || firstId == VQA_ID_SND1 ||
+                     firstId == VQA_ID_SND2) &&
+                    ClassifyFrame(&index[i]);
+        }
+        if (!valid) {
+            delete[] index;
+            return false;
+        }
+    }
+
+    frameIndex_ = index;
+    frameIndexCount_ = header_.frames;
+    return true;
+}
 
-    if (header_.frames == 0) {
+bool WwdVqaPlayer::ScanFrameIndex() {
+    FrameEntry* index = new FrameEntry[header_.frames];
+    int count = 0;
+
+    // Audio chunks ahead of a VQFR/VQFK belong to that frame, so each
+    // frame starts right after the previous frame chunk
+    const uint8_t* ptr = data_ + 12;  // Skip FORM header + WVQA
+    const uint8_t* end = data_ + dataSize_;
+    uint32_t start = 12;
+
+    while (ptr + 8 <= end && count < header_.frames) {
+        const IFFChunk* chunk = (const IFFChunk*)ptr;
+        uint32_t chunkId = SwapBE32(chunk->id);
+        uint32_t chunkSize = SwapBE32(chunk->size);
+
+        if (ptr + 8 + chunkSize > end) break;
+
+        ptr += 8 + chunkSize;
+        if (chunkSize & 1) ptr++;
+
+        if (chunkId == VQA_ID_VQFR || chunkId == VQA_ID_VQFK) {
+            index[count].start = start;
+            ClassifyFrame(&index[count]);
+            count++;
+            start = (uint32_t)(ptr - data_);
+        }
+    }
+
+    if (count == 0) {
+        delete[] index;
         return false;
     }
 
-    frameOffsets_ = new uint32_t[header_.frames];
+    // A truncated file plays the frames it has
+    frameIndex_ = index;
+    frameIndexCount_ = count;
+    return true;
+}
+
+bool WwdVqaPlayer::ClassifyFrame(FrameEntry* entry) const {
+    if (entry->start >= dataSize_) return false;
+
+    const uint8_t* ptr = data_ + entry->start;
+    const uint8_t* end = data_ + dataSize_;
+    entry->flags = 0;
+
+    // Skip the frame's leading audio chunks (and, for frame 0 when
+    // scanning, the header chunks) to reach its VQFR/VQFK
+    while (ptr + 8 <= end) {
+        const IFFChunk* chunk = (const IFFChunk*)ptr;
+        uint32_t chunkId = SwapBE32(chunk->id);
+        uint32_t chunkSize = SwapBE32(chunk->size);
+
+        if (ptr + 8 + chunkSize > end) return false;
 
-    // Note: FINF offsets stored differently in different VQA versions
-    // For now, we'll scan for VQFR/VQFK chunks instead
+        if (chunkId == VQA_ID_VQFR || chunkId == VQA_ID_VQFK) {
+            entry->chunk = (uint32_t)(ptr - data_);
+            break;
+        }
+
+        ptr += 8 + chunkSize;
+        if (chunkSize & 1) ptr++;
+    }
+    if (ptr + 8 > end) return false;
+
+    // Only sub-chunk headers are read, never their payloads
+    uint32_t frameSize = SwapBE32(((const IFFChunk*)ptr)->size);
+    const uint8_t* sub = ptr + 8;
+    const uint8_t* frameEnd = sub + frameSize;
+
+    while (sub + 8 <= frameEnd) {
+        const IFFChunk* chunk = (const IFFChunk*)sub;
+        uint32_t subId = SwapBE32(chunk->id);
+        uint32_t subSize = SwapBE32(chunk->size);
+
+        if (subId == VQA_ID_CBF0 || subId == VQA_ID_CBFZ) {
+            entry->flags |= FRAME_FULL_CODEBOOK;
+        } else if (subId == VQA_ID_CPL0 || subId == VQA_ID_CPLZ) {
+            entry->flags |= FRAME_PALETTE;
+        }
+
+        sub += 8 + subSize;
+        if (subSize & 1) sub++;
+    }
 
     return true;
 }
@@ -594,24 +711,83 @@ bool WwdVqaPlayer::NextFrame() {
 }
 
 bool WwdVqaPlayer::SeekFrame(int frame) {
-    if (!IsLoaded() || frame < 0 || frame >= header_.frames) {
+    if (!IsLoaded() || frame < 0 || frame >= frameIndexCount_) {
         return false;
     }
+    if (frame == currentFrame_) {
+        return true;
+    }
 
-    // For seeking backwards, we need to decode from last keyframe
-    // For now, simple forward seek
-    if (frame <= currentFrame_) {
-        currentFrame_ = -1;
+    // Nearest keyframe at or before the target
+    int key = frame;
+    while (key > 0 && !(frameIndex_[key].flags & FRAME_FULL_CODEBOOK)) {
+        key--;
+    }
+
+    int replayFrom;
+    bool restarted = false;
+    if (currentFrame_ >= key && currentFrame_ < frame) {
+        // Short forward seek: the current codebook is already valid
+        replayFrom = currentFrame_ + 1;
+    } else {
+        // Decoder state as it was just before the keyframe. Without a full
+        // codebook there (a stream that only builds from CBPs), start from
+        // the state Load() leaves.
+        cbpOffset_ = 0;
+        cbpCount_ = 0;
+        if (!(frameIndex_[key].flags & FRAME_FULL_CODEBOOK)) {
+            memset(codebook_, 0, codebookSize_);
+            codebookEntries_ = 0;
+        }
         memset(frameBuffer_, 0, frameBufferSize_);
+
+        // The palette may have been set long before the keyframe
+        int pal = key - 1;
+        while (pal >= 0 && !(frameIndex_[pal].flags & FRAME_PALETTE)) {
+            pal--;
+        }
+        if (pal >= 0) {
+            DecodeFrameParts(pal, DECODE_PALETTE);
+        } else {
+            memset(palette_, 0, sizeof(palette_));
+        }
+
+        replayFrom = key;
+        restarted = true;
+    }
+
+    // Only codebook and palette updates carry forward between frames;
+    // pointers and audio of the skipped frames are never decoded
+    bool paletteReplayed = false;
+    for (int f = replayFrom; f < frame; f++) {
+        if (!DecodeFrameParts(f, DECODE_CODEBOOK | DECODE_PALETTE)) {
+            state_ = WwdVqaState::ERROR;
+            return false;
+        }
+        if (frameIndex_[f].flags & FRAME_PALETTE) paletteReplayed = true;
     }
 
-    while (currentFrame_ < frame) {
-        if (!NextFrame()) return false;
+    if (!DecodeFrame(frame)) {
+        state_ = WwdVqaState::ERROR;
+        return false;
     }
 
+    // The displayed palette may differ from before the seek
+    if (restarted || paletteReplayed) {
+        paletteChanged_ = true;
+    }
+
+    currentFrame_ = frame;
     return true;
 }
 
+bool WwdVqaPlayer::IsKeyFrame(int frame) const {
+    if (frame < 0 || frame >= frameIndexCount_) {
+        return false;
+    }
+    return (frameIndex_[frame].flags & FRAME_FULL_CODEBOOK) != 0;
+}
+
 bool WwdVqaPlayer::Update(int elapsedMs) {
     if (state_ != WwdVqaState::PLAYING) {
         return false;
@@ -637,7 +813,7 @@ bool WwdVqaPlayer::Update(int elapsedMs) {
 //===========================================================================
 
 bool WwdVqaPlayer::DecodeFrame(int frameNum) {
-    if (!data_ || frameNum < 0 || frameNum >= header_.frames) {
+    if (!data_ || frameNum < 0 || frameNum >= frameIndexCount_) {
         return false;
     }
 
@@ -647,109 +823,95 @@ bool WwdVqaPlayer::DecodeFrame(int frameNum) {
     // Note: ADPCM state persists across frames as video audio is
     // one continuous ADPCM stream (matches OpenRA behavior).
 
+    return DecodeFrameParts(frameNum, DECODE_ALL);
+}
+
+bool WwdVqaPlayer::DecodeFrameParts(int frameNum, uint32_t parts) {
+    const FrameEntry& entry = frameIndex_[frameNum];
+
     // Apply accumulated partial codebook at START of frame
     // (CBP chunks from prior frames applied before this frame)
-    ApplyAccumulatedCodebook();
-
-    // Scan through file to find frame
-    const uint8_t* ptr = data_ + 12;  // Skip FORM header + WVQA
-    const uint8_t* end = data_ + dataSize_;
+    if (parts & DECODE_CODEBOOK) {
+        ApplyAccumulatedCodebook();
+    }
 
-    int currentFrameIndex = -1;
+    // Audio chunks ahead of the frame chunk belong to this frame
+    if (parts & DECODE_AUDIO) {
+        const uint8_t* ptr = data_ + entry.start;
+        const uint8_t* audioEnd = data_ + entry.chunk;
 
-    while (ptr + 8 <= end) {
-        const IFFChunk* chunk = (const IFFChunk*)ptr;
-        uint32_t chunkId = SwapBE32(chunk->id);
-        uint32_t chunkSize = SwapBE32(chunk->size);
-        ptr += 8;
+        while (ptr + 8 <= audioEnd) {
+            const IFFChunk* chunk = (const IFFChunk*)ptr;
+            uint32_t chunkId = SwapBE32(chunk->id);
+            uint32_t chunkSize = SwapBE32(chunk->size);
+            ptr += 8;
 
-        if (ptr + chunkSize > end) break;
+            if (ptr + chunkSize > audioEnd) break;
 
-        // Handle audio chunks at top level (they come BEFORE their VQFR/VQFK)
-        // Audio at currentFrameIndex=-1 belongs to frame 0
-        // Audio at currentFrameIndex=0 belongs to frame 1, etc.
-        // So: audio belongs to frame (currentFrameIndex + 1)
-        // We need to decode ALL audio chunks for the target frame
-        bool isAudio = (chunkId == VQA_ID_SND0 ||
-                        chunkId == VQA_ID_SND1 ||
-                        chunkId == VQA_ID_SND2);
-        if (isAudio) {
-            if (currentFrameIndex + 1 == frameNum) {
-                // Audio for target frame - decode and accumulate
+            if (chunkId == VQA_ID_SND0 || chunkId == VQA_ID_SND1 ||
+                chunkId == VQA_ID_SND2) {
                 DecodeAudio(ptr, chunkSize, chunkId);
             }
-        }
-
-        // Is this a frame chunk?
-        if (chunkId == VQA_ID_VQFR || chunkId == VQA_ID_VQFK) {
-            currentFrameIndex++;
-
-            // If we just passed our target frame, we're done
-            if (currentFrameIndex > frameNum) {
-                return true;
-            }
 
-            if (currentFrameIndex == frameNum) {
-                // Decode this frame's sub-chunks
-                const uint8_t* framePtr = ptr;
-                const uint8_t* frameEnd = ptr + chunkSize;
-
-                while (framePtr + 8 <= frameEnd) {
-                    const IFFChunk* subChunk = (const IFFChunk*)framePtr;
-                    uint32_t subId = SwapBE32(subChunk->id);
-                    uint32_t subSize = SwapBE32(subChunk->size);
-                    framePtr += 8;
-
-                    if (framePtr + subSize > frameEnd) break;
-
-                    // Decode sub-chunk based on type
-                    switch (subId) {
-                        case VQA_ID_CBF0:
-                            DecodeCodebook(framePtr, subSize, false, false);
-                            break;
-                        case VQA_ID_CBFZ:
-                            DecodeCodebook(framePtr, subSize, true, false);
-                            break;
-                        case VQA_ID_CBP0:
-                            DecodeCodebook(framePtr, subSize, false, true);
-                            break;
-                        case VQA_ID_CBPZ:
-                            DecodeCodebook(framePtr, subSize, true, true);
-                            break;
-                        case VQA_ID_VPT0:
-                        case VQA_ID_VPTZ:
-                        case VQA_ID_VPTR:
-                        case VQA_ID_VPRZ:
-                            DecodePointers(framePtr, subSize, subId);
-                            break;
-                        case VQA_ID_CPL0:
-                            DecodePalette(framePtr, subSize, false);
-                            break;
-                        case VQA_ID_CPLZ:
-                            DecodePalette(framePtr, subSize, true);
-                            break;
-                        case VQA_ID_SND0:
-                        case VQA_ID_SND1:
-                        case VQA_ID_SND2:
-                            DecodeAudio(framePtr, subSize, subId);
-                            break;
-                    }
+            ptr += chunkSize;
+            if (chunkSize & 1) ptr++;
+        }
+    }
 
-                    // Move to next sub-chunk (pad to even)
-                    framePtr += subSize;
-                    if (subSize & 1) framePtr++;
+    // Decode this frame's sub-chunks
+    const uint8_t* framePtr = data_ + entry.chunk + 8;
+    const uint8_t* frameEnd = framePtr +
+        SwapBE32(((const IFFChunk*)(data_ + entry.chunk))->size);
+
+    while (framePtr + 8 <= frameEnd) {
+        const IFFChunk* subChunk = (const IFFChunk*)framePtr;
+        uint32_t subId = SwapBE32(subChunk->id);
+        uint32_t subSize = SwapBE32(subChunk->size);
+        framePtr += 8;
+
+        if (framePtr + subSize > frameEnd) break;
+
+        // Decode sub-chunk based on type
+        switch (subId) {
+            case VQA_ID_CBF0:
+            case VQA_ID_CBFZ:
+            case VQA_ID_CBP0:
+            case VQA_ID_CBPZ:
+                if (parts & DECODE_CODEBOOK) {
+                    DecodeCodebook(framePtr, subSize,
+                                   subId == VQA_ID_CBFZ || subId == VQA_ID_CBPZ,
+                                   subId == VQA_ID_CBP0 || subId == VQA_ID_CBPZ);
                 }
-
-                return true;
-            }
+                break;
+            case VQA_ID_VPT0:
+            case VQA_ID_VPTZ:
+            case VQA_ID_VPTR:
+            case VQA_ID_VPRZ:
+                if (parts & DECODE_VIDEO) {
+                    DecodePointers(framePtr, subSize, subId);
+                }
+                break;
+            case VQA_ID_CPL0:
+            case VQA_ID_CPLZ:
+                if (parts & DECODE_PALETTE) {
+                    DecodePalette(framePtr, subSize, subId == VQA_ID_CPLZ);
+                }
+                break;
+            case VQA_ID_SND0:
+            case VQA_ID_SND1:
+            case VQA_ID_SND2:
+                if (parts & DECODE_AUDIO) {
+                    DecodeAudio(framePtr, subSize, subId);
+                }
+                break;
         }
 
-        // Move to next chunk (pad to even)
-        ptr += chunkSize;
-        if (chunkSize & 1) ptr++;
+        // Move to next sub-chunk (pad to even)
+        framePtr += subSize;
+        if (subSize & 1) framePtr++;
     }
 
-    return false;
+    return true;
 }
 
 bool WwdVqaPlayer::DecodeCodebook(const uint8_t* data, uint32_t size,
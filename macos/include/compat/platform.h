@@ -108,13 +108,17 @@ typedef LONG LPARAM;
 #define E_INVALIDARG  ((HRESULT)0x80070057L)
 #define E_OUTOFMEMORY ((HRESULT)0x8007000EL)
 
-// Min/Max macros
+// Min/Max macros. Define NOMINMAX to leave them out, as with <windows.h>:
+// libstdc++ headers included after this one can't take function-like
+// min/max macros, so builds off libc++ (ra_headless on Linux) need it.
+#ifndef NOMINMAX
 #ifndef min
 #define min(a, b) (((a) < (b)) ? (a) : (b))
 #endif
 #ifndef max
 #define max(a, b) (((a) > (b)) ? (a) : (b))
 #endif
+#endif
 
 // Byte order macros (assuming little-endian ARM64)
 #define LOWORD(l) ((WORD)((DWORD_PTR)(l) & 0xffff))
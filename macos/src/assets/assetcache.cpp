@@ -0,0 +1,424 @@
+/**
+ * Red Alert macOS Port - Asset Cache Implementation
+ *
+ * Entries are only touched by the game thread. A hinted asset becomes a
+ * job: workers take jobs from a locked queue, run the loader, and push
+ * the result onto a lock-free completed stack that the game thread drains
+ * to publish. A job is decoded by whoever takes it off the queue, so an
+ * asset is never decoded twice: a miss on a queued asset takes the job
+ * back and decodes it on the game thread, and a miss on one a worker has
+ * started waits for it.
+ */
+
+#include "assetcache.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+enum AssetState : uint8_t {
+    STATE_ABSENT = 0,           // Registered, not loaded (or evicted)
+    STATE_LOADING,              // Queued for, or being decoded by, a worker
+    STATE_RESIDENT,
+    STATE_MISSING,              // Loader found nothing
+};
+
+// One decode, handed from the game thread to a worker and back
+struct AssetJob {
+    AssetHandle handle;
+    void* (*load)(const char* name);
+    uint32_t (*size)(const void* data);
+    std::string name;
+    void* data;
+    uint32_t bytes;
+    uint64_t micros;
+    AssetJob* next;             // Completed stack link
+};
+
+struct AssetEntry {
+    uint8_t kind;
+    AssetState state;
+    int refs;
+    uint32_t bytes;
+    uint32_t lastUse;
+    void* data;
+    AssetJob* job;              // While STATE_LOADING
+    std::string name;
+};
+
+static std::vector<AssetEntry> g_entries;
+static std::unordered_map<std::string, AssetHandle> g_byName[ASSET_KIND_COUNT];
+static AssetLoader g_loaders[ASSET_KIND_COUNT];
+static uint32_t g_useClock = 0;
+static int g_pending = 0;       // Entries in STATE_LOADING
+static AssetCacheStats g_stats = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ASSETCACHE_DEFAULT_BUDGET };
+
+// Worker pool
+static std::vector<std::thread> g_workers;
+static std::mutex g_queueMutex;
+static std::condition_variable g_queueReady;
+static std::deque<AssetJob*> g_queue;
+static bool g_stopping = false;
+static std::atomic<AssetJob*> g_completed{ nullptr };
+static std::mutex g_doneMutex;
+static std::condition_variable g_doneReady;
+
+static AssetEntry* EntryFor(AssetHandle handle) {
+    if (handle < 0 || handle >= (int)g_entries.size()) return nullptr;
+    return &g_entries[handle];
+}
+
+static void Unload(AssetEntry* entry) {
+    if (g_loaders[entry->kind].unload) g_loaders[entry->kind].unload(entry->data);
+    g_stats.bytes -= entry->bytes;
+    g_stats.resident--;
+    entry->state = STATE_ABSENT;
+    entry->data = nullptr;
+    entry->bytes = 0;
+}
+
+// Unload least recently used unreferenced assets until bytes <= budget.
+// 'keep' is never chosen, so a fresh load survives its own eviction pass.
+static void EvictToBudget(uint32_t budget, const AssetEntry* keep) {
+    while (g_stats.bytes > budget) {
+        AssetEntry* oldest = nullptr;
+        for (AssetEntry& entry : g_entries) {
+            if (entry.state != STATE_RESIDENT || entry.refs > 0 || &entry == keep) continue;
+            if (!oldest || entry.lastUse < oldest->lastUse) oldest = &entry;
+        }
+        if (!oldest) return;                // Everything left is in use
+        Unload(oldest);
+        g_stats.evictions++;
+    }
+}
+
+// Runs on whichever thread took the job
+static void RunJob(AssetJob* job) {
+    auto start = std::chrono::steady_clock::now();
+    job->data = job->load(job->name.c_str());
+    job->bytes = (job->data && job->size) ? job->size(job->data) : 0;
+    auto end = std::chrono::steady_clock::now();
+    job->micros = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+// Make an entry resident (or missing) with a loader's result
+static void Publish(AssetEntry* entry, void* data, uint32_t bytes) {
+    if (!data) {
+        entry->state = STATE_MISSING;
+        g_stats.failures++;
+        return;
+    }
+
+    entry->state = STATE_RESIDENT;
+    entry->data = data;
+    entry->bytes = bytes;
+    g_stats.loads++;
+    g_stats.resident++;
+    g_stats.bytes += bytes;
+    if (g_stats.bytes > g_stats.peakBytes) g_stats.peakBytes = g_stats.bytes;
+    EvictToBudget(g_stats.budget, entry);
+}
+
+static void FinishJob(AssetJob* job, bool background) {
+    AssetEntry* entry = &g_entries[job->handle];
+    if (background && job->data) g_stats.backgroundLoads++;
+    entry->job = nullptr;
+    g_pending--;
+    g_stats.loadMicros += job->micros;
+    entry->lastUse = ++g_useClock;
+    Publish(entry, job->data, job->bytes);
+    delete job;
+}
+
+// Publish everything the workers have finished
+static void DrainCompleted(void) {
+    AssetJob* job = g_completed.exchange(nullptr, std::memory_order_acquire);
+
+    // The stack is newest first; publish in completion order
+    AssetJob* ordered = nullptr;
+    while (job) {
+        AssetJob* next = job->next;
+        job->next = ordered;
+        ordered = job;
+        job = next;
+    }
+    while (ordered) {
+        AssetJob* next = ordered->next;
+        FinishJob(ordered, true);
+        ordered = next;
+    }
+}
+
+// Block until at least one worker result is waiting, then publish
+static void WaitForCompleted(void) {
+    {
+        std::unique_lock<std::mutex> lock(g_doneMutex);
+        g_doneReady.wait(lock, [] { return g_completed.load(std::memory_order_acquire) != nullptr; });
+    }
+    DrainCompleted();
+}
+
+static void WorkerMain(void) {
+    for (;;) {
+        AssetJob* job;
+        {
+            std::unique_lock<std::mutex> lock(g_queueMutex);
+            g_queueReady.wait(lock, [] { return g_stopping || !g_queue.empty(); });
+            if (g_stopping) return;
+            job = g_queue.front();
+            g_queue.pop_front();
+        }
+
+        RunJob(job);
+
+        // Lock-free handoff back to the game thread
+        AssetJob* head = g_completed.load(std::memory_order_relaxed);
+        do {
+            job->next = head;
+        } while (!g_completed.compare_exchange_weak(head, job, std::memory_order_release,
+                                                    std::memory_order_relaxed));
+        {
+            std::lock_guard<std::mutex> lock(g_doneMutex);
+        }
+        g_doneReady.notify_all();
+    }
+}
+
+// Take a job back if no worker has started it
+static bool TakeQueuedJob(AssetJob* job) {
+    std::lock_guard<std::mutex> lock(g_queueMutex);
+    auto found = std::find(g_queue.begin(), g_queue.end(), job);
+    if (found == g_queue.end()) return false;
+    g_queue.erase(found);
+    return true;
+}
+
+// Bring a loading entry to a settled state from the game thread
+static void Collect(AssetEntry* entry) {
+    AssetJob* job = entry->job;
+    if (TakeQueuedJob(job)) {
+        RunJob(job);
+        FinishJob(job, false);
+        return;
+    }
+    // Hold a reference so other results published meanwhile can't evict it
+    g_stats.stalls++;
+    entry->refs++;
+    while (entry->state == STATE_LOADING) {
+        WaitForCompleted();
+    }
+    entry->refs--;
+}
+
+static void Load(AssetEntry* entry) {
+    const AssetLoader& loader = g_loaders[entry->kind];
+    if (!loader.load) {
+        entry->state = STATE_MISSING;
+        g_stats.failures++;
+        return;
+    }
+
+    AssetJob job = {};
+    job.load = loader.load;
+    job.size = loader.size;
+    job.name = entry->name;
+    RunJob(&job);
+    g_stats.loadMicros += job.micros;
+    Publish(entry, job.data, job.bytes);
+}
+
+// Queue a background decode for an absent entry
+static void Queue(AssetHandle handle, AssetEntry* entry) {
+    const AssetLoader& loader = g_loaders[entry->kind];
+    if (!loader.load) return;
+
+    AssetJob* job = new AssetJob();
+    job->handle = handle;
+    job->load = loader.load;
+    job->size = loader.size;
+    job->name = entry->name;
+    entry->state = STATE_LOADING;
+    entry->job = job;
+    g_pending++;
+    g_stats.hints++;
+    {
+        std::lock_guard<std::mutex> lock(g_queueMutex);
+        g_queue.push_back(job);
+    }
+    g_queueReady.notify_one();
+}
+
+// Load on a miss and mark as just used
+static AssetEntry* Resolve(AssetHandle handle) {
+    AssetEntry* entry = EntryFor(handle);
+    if (!entry) return nullptr;
+
+    g_stats.lookups++;
+    if (entry->state == STATE_RESIDENT) {
+        g_stats.hits++;
+    } else {
+        if (entry->state == STATE_LOADING) Collect(entry);
+        if (entry->state == STATE_ABSENT) Load(entry);
+    }
+    entry->lastUse = ++g_useClock;
+    return entry;
+}
+
+void AssetCache_SetLoader(AssetKind kind, const AssetLoader* loader) {
+    if (kind < 0 || kind >= ASSET_KIND_COUNT) return;
+    AssetCache_Settle();
+    if (loader) {
+        g_loaders[kind] = *loader;
+    } else {
+        memset(&g_loaders[kind], 0, sizeof(g_loaders[kind]));
+    }
+    for (AssetEntry& entry : g_entries) {
+        if (entry.kind == kind && entry.state == STATE_MISSING) entry.state = STATE_ABSENT;
+    }
+}
+
+AssetHandle AssetCache_Find(AssetKind kind, const char* name) {
+    if (kind < 0 || kind >= ASSET_KIND_COUNT || !name || !name[0]) return ASSET_NONE;
+
+    auto found = g_byName[kind].find(name);
+    if (found != g_byName[kind].end()) return found->second;
+
+    AssetHandle handle = (AssetHandle)g_entries.size();
+    AssetEntry entry = {};
+    entry.kind = (uint8_t)kind;
+    entry.state = STATE_ABSENT;
+    entry.name = name;
+    g_entries.push_back(entry);
+    g_byName[kind][name] = handle;
+    return handle;
+}
+
+void* AssetCache_Get(AssetHandle handle) {
+    AssetEntry* entry = Resolve(handle);
+    return (entry && entry->state == STATE_RESIDENT) ? entry->data : nullptr;
+}
+
+void AssetCache_Hint(AssetHandle handle) {
+    AssetEntry* entry = EntryFor(handle);
+    if (!entry || entry->state != STATE_ABSENT || g_workers.empty()) return;
+    Queue(handle, entry);
+}
+
+void AssetCache_Retain(AssetHandle handle) {
+    // Count the reference first so the load can't evict it straight back
+    AssetEntry* entry = EntryFor(handle);
+    if (!entry) return;
+    entry->refs++;
+    if (!g_workers.empty()) {
+        AssetCache_Hint(handle);
+        entry->lastUse = ++g_useClock;
+    } else {
+        Resolve(handle);
+    }
+}
+
+void AssetCache_Release(AssetHandle handle) {
+    AssetEntry* entry = EntryFor(handle);
+    if (!entry || entry->refs <= 0) return;
+    entry->refs--;
+    if (entry->refs == 0) EvictToBudget(g_stats.budget, nullptr);
+}
+
+void AssetCache_SetBudget(uint32_t bytes) {
+    g_stats.budget = bytes;
+    EvictToBudget(bytes, nullptr);
+}
+
+void AssetCache_Flush(AssetKind kind) {
+    AssetCache_Settle();
+    for (AssetEntry& entry : g_entries) {
+        if (entry.kind != kind || entry.refs > 0) continue;
+        if (entry.state == STATE_RESIDENT) Unload(&entry);
+    }
+}
+
+BOOL AssetCache_StartWorkers(int count) {
+    if (!g_workers.empty() || count <= 0) return FALSE;
+    g_stopping = false;
+    for (int i = 0; i < count; i++) {
+        g_workers.emplace_back(WorkerMain);
+    }
+    return TRUE;
+}
+
+void AssetCache_StopWorkers(void) {
+    if (g_workers.empty()) return;
+    AssetCache_Settle();
+    {
+        std::lock_guard<std::mutex> lock(g_queueMutex);
+        g_stopping = true;
+    }
+    g_queueReady.notify_all();
+    for (std::thread& worker : g_workers) {
+        worker.join();
+    }
+    g_workers.clear();
+}
+
+void AssetCache_Update(void) {
+    if (g_completed.load(std::memory_order_relaxed)) DrainCompleted();
+}
+
+void AssetCache_Settle(void) {
+    if (g_pending == 0) return;
+
+    // Queued decodes go back to absent; they load on their next use
+    std::deque<AssetJob*> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(g_queueMutex);
+        cancelled.swap(g_queue);
+    }
+    for (AssetJob* job : cancelled) {
+        AssetEntry* entry = &g_entries[job->handle];
+        entry->state = STATE_ABSENT;
+        entry->job = nullptr;
+        g_pending--;
+        delete job;
+    }
+
+    DrainCompleted();
+    while (g_pending > 0) {
+        WaitForCompleted();
+    }
+}
+
+void AssetCache_Shutdown(void) {
+    AssetCache_StopWorkers();
+    for (AssetEntry& entry : g_entries) {
+        if (entry.state == STATE_RESIDENT) Unload(&entry);
+    }
+    g_entries.clear();
+    for (int k = 0; k < ASSET_KIND_COUNT; k++) {
+        g_byName[k].clear();
+        memset(&g_loaders[k], 0, sizeof(g_loaders[k]));
+    }
+}
+
+const AssetCacheStats* AssetCache_GetStats(void) {
+    return &g_stats;
+}
+
+void AssetCache_ResetStats(void) {
+    g_stats.lookups = 0;
+    g_stats.hits = 0;
+    g_stats.loads = 0;
+    g_stats.backgroundLoads = 0;
+    g_stats.failures = 0;
+    g_stats.evictions = 0;
+    g_stats.hints = 0;
+    g_stats.stalls = 0;
+    g_stats.loadMicros = 0;
+    g_stats.peakBytes = g_stats.bytes;
+}
@@ -0,0 +1,139 @@
+/**
+ * Red Alert macOS Port - Asset Cache
+ *
+ * One cache for decoded game assets (unit and building SHPs, theater
+ * templates). Names are registered up front for a cheap handle; the
+ * asset is only loaded the first time a handle is resolved. Resident
+ * assets are counted against a byte budget and, once over it, the least
+ * recently used unreferenced ones are unloaded. Retaining a handle loads
+ * it and keeps it resident (a scenario retains what its INI places).
+ *
+ * With workers running, retains and hints ("will need soon") decode on a
+ * background thread instead, and finished assets are published by
+ * AssetCache_Update() once a frame. A Get that arrives first decodes it
+ * on the calling thread, or waits if a worker already has, so each asset
+ * is decoded once. The cache itself is game-thread only; just loaders
+ * run on workers, so they must be safe to call from any thread.
+ *
+ * Pointers returned by AssetCache_Get stay valid until the next cache
+ * call that may load, or for as long as the handle is retained.
+ */
+
+#ifndef ASSETS_ASSETCACHE_H
+#define ASSETS_ASSETCACHE_H
+
+#include "compat/windows.h"
+#include <cstdint>
+
+#define ASSETCACHE_DEFAULT_BUDGET   (32 * 1024 * 1024)   // Bytes
+#define ASSETCACHE_DEFAULT_WORKERS  2
+#define ASSET_NONE                  (-1)
+
+typedef int AssetHandle;
+
+typedef enum {
+    ASSET_SHP = 0,              // ShpFileHandle
+    ASSET_TMP,                  // TmpFileHandle
+    ASSET_KIND_COUNT
+} AssetKind;
+
+// How one kind of asset is loaded; installed by the system that owns it
+typedef struct {
+    void* (*load)(const char* name);        // NULL if missing or corrupt
+    void (*unload)(void* data);
+    uint32_t (*size)(const void* data);     // Resident bytes
+} AssetLoader;
+
+// Counters since the last AssetCache_ResetStats(), plus current usage
+typedef struct {
+    uint32_t lookups;           // AssetCache_Get/Retain calls
+    uint32_t hits;              // ...that found the asset resident
+    uint32_t loads;             // Assets decoded
+    uint32_t backgroundLoads;   // ...of which on a worker
+    uint32_t failures;          // Loads that found nothing (not retried)
+    uint32_t evictions;         // Assets unloaded to stay in budget
+    uint32_t hints;             // Background decodes queued
+    uint32_t stalls;            // Gets that waited for a worker's decode
+    uint64_t loadMicros;        // Time spent in loaders, on any thread
+    uint32_t resident;          // Assets held now
+    uint32_t bytes;             // Bytes held now
+    uint32_t peakBytes;         // Most bytes held at once
+    uint32_t budget;            // Byte budget
+} AssetCacheStats;
+
+/**
+ * Install the loader for a kind of asset. Assets of that kind that
+ * earlier loaders couldn't find become eligible to load again.
+ */
+void AssetCache_SetLoader(AssetKind kind, const AssetLoader* loader);
+
+/**
+ * Handle for a named asset, registering it on first sight. Loads nothing.
+ * @return Handle, or ASSET_NONE for an empty name
+ */
+AssetHandle AssetCache_Find(AssetKind kind, const char* name);
+
+/**
+ * Resolve a handle, loading the asset if it isn't resident
+ * @return The asset, or NULL if it couldn't be loaded
+ */
+void* AssetCache_Get(AssetHandle handle);
+
+/**
+ * Queue an asset to decode in the background, if workers are running and
+ * it isn't resident or already queued
+ */
+void AssetCache_Hint(AssetHandle handle);
+
+/**
+ * Load an asset if needed (in the background when workers are running)
+ * and keep it resident until released.
+ * References count: each retain needs its own release.
+ */
+void AssetCache_Retain(AssetHandle handle);
+void AssetCache_Release(AssetHandle handle);
+
+/**
+ * Set the byte budget, unloading down to it straight away
+ */
+void AssetCache_SetBudget(uint32_t bytes);
+
+/**
+ * Unload every unreferenced asset of a kind
+ */
+void AssetCache_Flush(AssetKind kind);
+
+/**
+ * Start background decode workers
+ * @return FALSE if already running or count <= 0
+ */
+BOOL AssetCache_StartWorkers(int count);
+
+/**
+ * Stop the workers; queued decodes are dropped and load on next use
+ */
+void AssetCache_StopWorkers(void);
+
+/**
+ * Publish assets the workers have finished (call once per frame)
+ */
+void AssetCache_Update(void);
+
+/**
+ * Drop queued decodes and wait for those in flight, so no loader is
+ * running when it returns (before closing archives or switching theater)
+ */
+void AssetCache_Settle(void);
+
+/**
+ * Stop the workers, unload everything and forget every name and loader
+ */
+void AssetCache_Shutdown(void);
+
+/**
+ * Statistics
+ */
+const AssetCacheStats* AssetCache_GetStats(void);
+void AssetCache_ResetStats(void);
+
+#endif // ASSETS_ASSETCACHE_H
@@ -0,0 +1,145 @@
+/**
+ * Red Alert macOS Port - Merged Asset Index Implementation
+ */
+
+#include "assetindex.h"
+#include <algorithm>
+#include <dirent.h>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <sys/stat.h>
+#include <unordered_map>
+#include <vector>
+
+// One file in one archive
+struct IndexHit {
+    uint32_t crc;
+    uint16_t archive;           // Mount order
+    int entry;
+};
+
+// Span of g_hits sharing a CRC
+struct IndexRun {
+    uint32_t start;
+    uint32_t count;
+};
+
+static std::vector<MixFileHandle> g_archives;
+static std::vector<IndexHit> g_hits;        // Sorted by CRC, then mount order
+static std::unordered_map<uint32_t, IndexRun> g_runs;
+static std::unordered_map<std::string, std::string> g_loose;   // Upper-case name -> path
+
+// Filenames are hashed once; lookups may come from asset workers
+static std::unordered_map<std::string, uint32_t> g_crcs;
+static std::shared_mutex g_crcMutex;
+
+static void RebuildRuns(void) {
+    std::stable_sort(g_hits.begin(), g_hits.end(),
+                     [](const IndexHit& a, const IndexHit& b) { return a.crc < b.crc; });
+    g_runs.clear();
+    g_runs.reserve(g_hits.size());
+    for (uint32_t i = 0; i < g_hits.size();) {
+        uint32_t start = i;
+        while (i < g_hits.size() && g_hits[i].crc == g_hits[start].crc) i++;
+        g_runs[g_hits[start].crc] = IndexRun{ start, i - start };
+    }
+}
+
+// Loose files are matched case-insensitively, as fopen on macOS's
+// default filesystem would
+static std::string LooseKey(const char* name) {
+    std::string key(name);
+    for (char& c : key) {
+        if (c >= 'a' && c <= 'z') c -= 32;
+    }
+    return key;
+}
+
+void AssetIndex_Reset(void) {
+    g_archives.clear();
+    g_hits.clear();
+    g_runs.clear();
+    g_loose.clear();
+    std::unique_lock<std::shared_mutex> lock(g_crcMutex);
+    g_crcs.clear();
+}
+
+void AssetIndex_AddArchive(MixFileHandle mix) {
+    if (!mix) return;
+    if (std::find(g_archives.begin(), g_archives.end(), mix) != g_archives.end()) return;
+
+    uint16_t archive = (uint16_t)g_archives.size();
+    g_archives.push_back(mix);
+
+    int count = Mix_GetFileCount(mix);
+    g_hits.reserve(g_hits.size() + count);
+    for (int i = 0; i < count; i++) {
+        uint32_t crc = 0;
+        if (Mix_GetEntryByIndex(mix, i, &crc, nullptr)) {
+            g_hits.push_back(IndexHit{ crc, archive, i });
+        }
+    }
+    RebuildRuns();
+}
+
+int AssetIndex_AddLooseDirectory(const char* dir) {
+    if (!dir) return 0;
+    DIR* handle = opendir(dir);
+    if (!handle) return 0;
+
+    int found = 0;
+    struct dirent* entry;
+    while ((entry = readdir(handle)) != nullptr) {
+        if (entry->d_name[0] == '.') continue;
+        std::string path = std::string(dir) + entry->d_name;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) continue;
+        g_loose.emplace(LooseKey(entry->d_name), path);
+        found++;
+    }
+    closedir(handle);
+    return found;
+}
+
+uint32_t AssetIndex_GetCRC(const char* name) {
+    std::string key(name);
+    {
+        std::shared_lock<std::shared_mutex> lock(g_crcMutex);
+        auto found = g_crcs.find(key);
+        if (found != g_crcs.end()) return found->second;
+    }
+    uint32_t crc = Mix_CalculateCRC(name);
+    std::unique_lock<std::shared_mutex> lock(g_crcMutex);
+    g_crcs.emplace(std::move(key), crc);
+    return crc;
+}
+
+BOOL AssetIndex_Locate(const char* name, const MixFileHandle* order, int count,
+                       int from, AssetLocation* out) {
+    if (!name || !order) return FALSE;
+
+    auto run = g_runs.find(AssetIndex_GetCRC(name));
+    if (run == g_runs.end()) return FALSE;
+
+    const IndexHit* hits = &g_hits[run->second.start];
+    for (int pos = from > 0 ? from : 0; pos < count; pos++) {
+        if (!order[pos]) continue;
+        for (uint32_t h = 0; h < run->second.count; h++) {
+            if (g_archives[hits[h].archive] != order[pos]) continue;
+            if (out) {
+                out->mix = order[pos];
+                out->entry = hits[h].entry;
+                out->position = pos;
+            }
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+const char* AssetIndex_FindLoose(const char* name) {
+    if (!name) return nullptr;
+    auto found = g_loose.find(LooseKey(name));
+    return found != g_loose.end() ? found->second.c_str() : nullptr;
+}
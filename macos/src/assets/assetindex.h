@@ -0,0 +1,70 @@
+/**
+ * Red Alert macOS Port - Merged Asset Index
+ *
+ * One index over every mounted MIX archive, built when the archives are
+ * opened: a file's CRC maps straight to the archives holding it and its
+ * entry in each. Loaders still choose between archives with their own
+ * search order, but finding a file is one hash probe instead of a lookup
+ * per archive. Filename CRCs are memoized, and loose override
+ * directories are scanned once at mount instead of probed per load.
+ *
+ * Built and reset from the game thread; lookups are safe from asset
+ * workers.
+ */
+
+#ifndef ASSETS_ASSETINDEX_H
+#define ASSETS_ASSETINDEX_H
+
+#include "compat/windows.h"
+#include "mixfile.h"
+#include <cstdint>
+
+// Where a file was found
+typedef struct {
+    MixFileHandle mix;          // Archive holding it
+    int entry;                  // Entry index within the archive
+    int position;               // Position of the archive in the search order
+} AssetLocation;
+
+/**
+ * Forget every archive, loose file and memoized name
+ */
+void AssetIndex_Reset(void);
+
+/**
+ * Add every entry of an open archive to the index
+ */
+void AssetIndex_AddArchive(MixFileHandle mix);
+
+/**
+ * Scan a directory of loose override files. Directories added first take
+ * precedence for files of the same name.
+ * @param dir  Directory path, with trailing slash
+ * @return Files found
+ */
+int AssetIndex_AddLooseDirectory(const char* dir);
+
+/**
+ * CRC of a filename, computed once per distinct name
+ */
+uint32_t AssetIndex_GetCRC(const char* name);
+
+/**
+ * Find the first archive in a search order that holds a file
+ * @param order  Archives in precedence order; NULL entries are skipped
+ * @param count  Number of entries in order
+ * @param from   Position in order to start at (0, or one past an earlier
+ *               result to keep searching)
+ * @param out    [out] Where it was found
+ * @return TRUE if found
+ */
+BOOL AssetIndex_Locate(const char* name, const MixFileHandle* order, int count,
+                       int from, AssetLocation* out);
+
+/**
+ * Path of a loose override file, or NULL if none was found at mount.
+ * Names match regardless of case.
+ */
+const char* AssetIndex_FindLoose(const char* name);
+
+#endif // ASSETS_ASSETINDEX_H
@@ -3,6 +3,8 @@
  */
 
 #include "assetloader.h"
+#include "assetcache.h"
+#include "assetindex.h"
 #include "mixfile.h"
 #include "shpfile.h"
 #include "audfile.h"
@@ -22,15 +24,6 @@ static MixFileHandle g_snowMix = nullptr;      // SNOW.MIX
 static MixFileHandle g_temperatMix = nullptr;  // TEMPERAT.MIX
 static MixFileHandle g_generalMix = nullptr;   // GENERAL.MIX (scenarios)
 
-// Memory-backed nested MIX data (kept alive for duration)
-static void* g_conquerData = nullptr;
-static void* g_hiresData = nullptr;
-static void* g_soundsData = nullptr;
-static void* g_localData = nullptr;
-static void* g_snowData = nullptr;
-static void* g_temperatData = nullptr;
-static void* g_generalData = nullptr;
-
 // Current palette (expanded to 8-bit)
 static uint8_t g_palette[768] = {0};
 static bool g_paletteLoaded = false;
@@ -40,11 +33,9 @@ static TheaterType g_currentTheater = THEATER_SNOW;
 
 // Movies archive (opened on demand)
 static MixFileHandle g_moviesMix = nullptr;
-static void* g_moviesData = nullptr;
 
 // Music archive (SCORES.MIX - opened on demand)
 static MixFileHandle g_scoresMix = nullptr;
-static void* g_scoresData = nullptr;
 
 // Archive search paths for MAIN_ALLIED.MIX
 #define ASSET_ROOT "/Users/jasson/workspace/CnC_Red_Alert/assets"
@@ -126,27 +117,27 @@ static const char* g_generalPaths[] = {
     nullptr
 };
 
-static MixFileHandle OpenNestedMix(MixFileHandle parent, const char* name,
-                                   void** outData) {
-    if (!parent) return nullptr;
-
-    uint32_t size = 0;
-    void* data = Mix_AllocReadFile(parent, name, &size);
-    if (!data) return nullptr;
+// Search paths for loose SHP files (OpenRA bits folder)
+static const char* g_shpSearchPaths[] = {
+    "../assets/bits/",
+    "../../assets/bits/",
+    "/Users/jasson/workspace/CnC_Red_Alert/assets/bits/",
+    nullptr
+};
 
-    MixFileHandle mix = Mix_OpenMemory(data, size, TRUE);
-    if (!mix) {
-        free(data);
-        return nullptr;
-    }
+// Read a file from the first archive in 'order' that holds it
+#define ORDER_COUNT(order) ((int)(sizeof(order) / sizeof(order[0])))
 
-    *outData = data;
-    return mix;
+static void* ReadFromArchives(const char* name, const MixFileHandle* order,
+                              int count, uint32_t* outSize) {
+    AssetLocation where;
+    if (!AssetIndex_Locate(name, order, count, 0, &where)) return nullptr;
+    return Mix_AllocReadEntry(where.mix, where.entry, outSize);
 }
 
 // Helper to open standalone or nested MIX
 static MixFileHandle OpenMixFile(const char** paths, const char* name,
-                                  MixFileHandle parent, void** outData) {
+                                  MixFileHandle parent) {
     // First try standalone files (from quick install package - preferred)
     for (int i = 0; paths && paths[i]; i++) {
         MixFileHandle mix = Mix_Open(paths[i]);
@@ -158,7 +149,7 @@ static MixFileHandle OpenMixFile(const char** paths, const char* name,
 
     // Fall back to nested in parent archive
     if (parent && name) {
-        MixFileHandle mix = OpenNestedMix(parent, name, outData);
+        MixFileHandle mix = Mix_OpenNested(parent, name);
         if (mix) {
             printf("AssetLoader: Opened %s from parent\n", name);
             return mix;
@@ -188,18 +179,26 @@ BOOL Assets_Init(void) {
     }
 
     // Open content MIX files - prefer standalone from quick install
-    g_conquerMix = OpenMixFile(g_conquerPaths, "CONQUER.MIX",
-                               g_mainMix, &g_conquerData);
-    g_hiresMix = OpenMixFile(g_hiresPaths, "HIRES.MIX",
-                             g_redalertMix, &g_hiresData);
-    g_soundsMix = OpenMixFile(g_soundsPaths, "SOUNDS.MIX",
-                              g_mainMix, &g_soundsData);
-    g_localMix = OpenMixFile(g_localPaths, "LOCAL.MIX",
-                             g_redalertMix, &g_localData);
-    g_snowMix = OpenMixFile(g_snowPaths, nullptr, nullptr, nullptr);
-    g_temperatMix = OpenMixFile(g_temperatPaths, nullptr, nullptr, nullptr);
-    g_generalMix = OpenMixFile(g_generalPaths, "GENERAL.MIX",
-                               g_mainMix, &g_generalData);
+    g_conquerMix = OpenMixFile(g_conquerPaths, "CONQUER.MIX", g_mainMix);
+    g_hiresMix = OpenMixFile(g_hiresPaths, "HIRES.MIX", g_redalertMix);
+    g_soundsMix = OpenMixFile(g_soundsPaths, "SOUNDS.MIX", g_mainMix);
+    g_localMix = OpenMixFile(g_localPaths, "LOCAL.MIX", g_redalertMix);
+    g_snowMix = OpenMixFile(g_snowPaths, nullptr, nullptr);
+    g_temperatMix = OpenMixFile(g_temperatPaths, nullptr, nullptr);
+    g_generalMix = OpenMixFile(g_generalPaths, "GENERAL.MIX", g_mainMix);
+
+    // One merged index over everything mounted, and the loose files
+    AssetIndex_Reset();
+    MixFileHandle mounted[] = {
+        g_conquerMix, g_localMix, g_hiresMix, g_soundsMix, g_snowMix,
+        g_temperatMix, g_generalMix, g_mainMix, g_redalertMix
+    };
+    for (MixFileHandle mix : mounted) {
+        AssetIndex_AddArchive(mix);
+    }
+    for (int i = 0; g_shpSearchPaths[i]; i++) {
+        AssetIndex_AddLooseDirectory(g_shpSearchPaths[i]);
+    }
 
     // Check if we have required archives
     if (!g_conquerMix && !g_hiresMix) {
@@ -240,50 +239,29 @@ void Assets_Shutdown(void) {
     if (g_localMix) { Mix_Close(g_localMix); g_localMix = nullptr; }
     if (g_mainMix) { Mix_Close(g_mainMix); g_mainMix = nullptr; }
     if (g_redalertMix) { Mix_Close(g_redalertMix); g_redalertMix = nullptr; }
-
-    // Memory freed by Mix_Close (ownsData = TRUE)
-    g_conquerData = nullptr;
-    g_hiresData = nullptr;
-    g_soundsData = nullptr;
-    g_localData = nullptr;
-    g_snowData = nullptr;
-    g_temperatData = nullptr;
-    g_generalData = nullptr;
+    AssetIndex_Reset();
 
     g_paletteLoaded = false;
 }
 
-// Search paths for loose SHP files (OpenRA bits folder)
-static const char* g_shpSearchPaths[] = {
-    "../assets/bits/",
-    "../../assets/bits/",
-    "/Users/jasson/workspace/CnC_Red_Alert/assets/bits/",
-    nullptr
-};
-
-// Helper to load SHP from loose file
+// Helper to load SHP from a loose file found by the mount-time scan
 static ShpFileHandle LoadSHPFromFile(const char* name) {
-    char path[512];
-    for (int i = 0; g_shpSearchPaths[i]; i++) {
-        snprintf(path, sizeof(path), "%s%s", g_shpSearchPaths[i], name);
-        FILE* f = fopen(path, "rb");
-        if (f) {
-            fseek(f, 0, SEEK_END);
-            long size = ftell(f);
-            fseek(f, 0, SEEK_SET);
-            void* data = malloc(size);
-            if (data && fread(data, 1, size, f) == (size_t)size) {
-                fclose(f);
-                ShpFileHandle shp = Shp_Load(data, size);
-                free(data);
-                if (shp) return shp;
-            } else {
-                fclose(f);
-                if (data) free(data);
-            }
-        }
-    }
-    return nullptr;
+    const char* path = AssetIndex_FindLoose(name);
+    if (!path) return nullptr;
+
+    FILE* f = fopen(path, "rb");
+    if (!f) return nullptr;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    void* data = malloc(size);
+    ShpFileHandle shp = nullptr;
+    if (data && fread(data, 1, size, f) == (size_t)size) {
+        shp = Shp_Load(data, size);
+    }
+    fclose(f);
+    if (data) free(data);
+    return shp;
 }
 
 ShpFileHandle Assets_LoadSHP(const char* name) {
@@ -291,35 +269,19 @@ ShpFileHandle Assets_LoadSHP(const char* name) {
 
     // Try MIX archives: CONQUER.MIX, LOCAL.MIX (icons), HIRES.MIX, top-level
     MixFileHandle searchOrder[] = {
-        g_conquerMix, g_localMix, g_hiresMix, g_mainMix, g_redalertMix, nullptr
+        g_conquerMix, g_localMix, g_hiresMix, g_mainMix, g_redalertMix
     };
 
-    for (int i = 0; searchOrder[i]; i++) {
-        if (Mix_FileExists(searchOrder[i], name)) {
-            uint32_t size = 0;
-            void* data = Mix_AllocReadFile(searchOrder[i], name, &size);
-            if (data) {
-                ShpFileHandle shp = Shp_Load(data, size);
-                free(data);
-                return shp;
-            }
-        }
+    uint32_t size = 0;
+    void* data = ReadFromArchives(name, searchOrder, ORDER_COUNT(searchOrder), &size);
+    if (data) {
+        ShpFileHandle shp = Shp_Load(data, size);
+        free(data);
+        return shp;
     }
 
-    // Fallback: try loose SHP files (OpenRA bits folder)
-    ShpFileHandle shp = LoadSHPFromFile(name);
-    if (shp) return shp;
-
-    // Try lowercase version
-    char lower[256];
-    int len = 0;
-    while (name[len] && len < 255) {
-        char c = name[len];
-        lower[len] = (c >= 'A' && c <= 'Z') ? c + 32 : c;
-        len++;
-    }
-    lower[len] = '\0';
-    return LoadSHPFromFile(lower);
+    // Fallback: try loose SHP files (OpenRA bits folder), any case
+    return LoadSHPFromFile(name);
 }
 
 AudData* Assets_LoadAUD(const char* name) {
@@ -327,43 +289,38 @@ AudData* Assets_LoadAUD(const char* name) {
 
     // Search in SOUNDS.MIX first, then top-level archives
     MixFileHandle searchOrder[] = {
-        g_soundsMix, g_mainMix, g_redalertMix, nullptr
+        g_soundsMix, g_mainMix, g_redalertMix
     };
 
-    for (int i = 0; searchOrder[i]; i++) {
-        if (Mix_FileExists(searchOrder[i], name)) {
-            uint32_t size = 0;
-            void* data = Mix_AllocReadFile(searchOrder[i], name, &size);
-            if (data) {
-                AudData* aud = Aud_Load(data, size);
-                free(data);
-                return aud;
-            }
-        }
-    }
-
-    return nullptr;
+    uint32_t size = 0;
+    void* data = ReadFromArchives(name, searchOrder, ORDER_COUNT(searchOrder), &size);
+    if (!data) return nullptr;
+    AudData* aud = Aud_Load(data, size);
+    free(data);
+    return aud;
 }
 
 BOOL Assets_LoadPalette(const char* name, uint8_t* palette) {
     if (!name || !palette) return FALSE;
 
-    // Search in LOCAL.MIX first (contains palettes), then top-level
+    // Search in LOCAL.MIX first (contains palettes), then top-level;
+    // a copy of the wrong size falls through to the next archive
     MixFileHandle searchOrder[] = {
-        g_localMix, g_mainMix, g_redalertMix, nullptr
+        g_localMix, g_mainMix, g_redalertMix
     };
 
-    for (int i = 0; searchOrder[i]; i++) {
-        if (Mix_FileExists(searchOrder[i], name)) {
-            uint32_t size = 0;
-            void* data = Mix_AllocReadFile(searchOrder[i], name, &size);
-            if (data && size == 768) {
-                memcpy(palette, data, 768);
-                free(data);
-                return TRUE;
-            }
-            if (data) free(data);
+    AssetLocation where;
+    int from = 0;
+    while (AssetIndex_Locate(name, searchOrder, ORDER_COUNT(searchOrder), from, &where)) {
+        uint32_t size = 0;
+        void* data = Mix_AllocReadEntry(where.mix, where.entry, &size);
+        if (data && size == 768) {
+            memcpy(palette, data, 768);
+            free(data);
+            return TRUE;
         }
+        if (data) free(data);
+        from = where.position + 1;
     }
 
     return FALSE;
@@ -412,16 +369,10 @@ void* Assets_LoadRaw(const char* name, uint32_t* outSize) {
     // Search all archives (tileset archives first for terrain files)
     MixFileHandle searchOrder[] = {
         g_snowMix, g_temperatMix, g_localMix, g_conquerMix,
-        g_hiresMix, g_soundsMix, g_mainMix, g_redalertMix, nullptr
+        g_hiresMix, g_soundsMix, g_mainMix, g_redalertMix
     };
 
-    for (int i = 0; searchOrder[i]; i++) {
-        if (Mix_FileExists(searchOrder[i], name)) {
-            return Mix_AllocReadFile(searchOrder[i], name, outSize);
-        }
-    }
-
-    return nullptr;
+    return ReadFromArchives(name, searchOrder, ORDER_COUNT(searchOrder), outSize);
 }
 
 void* Assets_LoadScenario(const char* name, uint32_t* outSize) {
@@ -437,22 +388,19 @@ void* Assets_LoadScenario(const char* name, uint32_t* outSize) {
         snprintf(filename, sizeof(filename), "%s.INI", name);
     }
 
-    // Search in GENERAL.MIX first (contains scenarios)
-    if (g_generalMix && Mix_FileExists(g_generalMix, filename)) {
-        printf("Scenario: Loading %s from GENERAL.MIX\n", filename);
-        return Mix_AllocReadFile(g_generalMix, filename, outSize);
-    }
-
-    // Fallback: search in other archives
+    // Search in GENERAL.MIX first (contains scenarios), then other archives
     MixFileHandle searchOrder[] = {
-        g_localMix, g_mainMix, g_redalertMix, nullptr
+        g_generalMix, g_localMix, g_mainMix, g_redalertMix
     };
 
-    for (int i = 0; searchOrder[i]; i++) {
-        if (Mix_FileExists(searchOrder[i], filename)) {
-            printf("Scenario: Loading %s from archive %d\n", filename, i);
-            return Mix_AllocReadFile(searchOrder[i], filename, outSize);
+    AssetLocation where;
+    if (AssetIndex_Locate(filename, searchOrder, ORDER_COUNT(searchOrder), 0, &where)) {
+        if (where.mix == g_generalMix) {
+            printf("Scenario: Loading %s from GENERAL.MIX\n", filename);
+        } else {
+            printf("Scenario: Loading %s from archive %d\n", filename, where.position - 1);
         }
+        return Mix_AllocReadEntry(where.mix, where.entry, outSize);
     }
 
     printf("Scenario: %s not found in any archive\n", filename);
@@ -494,27 +442,20 @@ static void EnsureMoviesOpen(void) {
     };
     for (int i = 0; moviesNames[i]; i++) {
         if (Mix_FileExists(mainCd, moviesNames[i])) {
-            uint32_t size = 0;
-            void* data = Mix_AllocReadFile(mainCd, moviesNames[i], &size);
-            if (data) {
-                g_moviesMix = Mix_OpenMemory(data, size, TRUE);
-                if (g_moviesMix) {
-                    g_moviesData = data;
-                    printf("Movies: Opened %s (%u MB, %d files)\n",
-                           moviesNames[i], size / (1024*1024),
-                           Mix_GetFileCount(g_moviesMix));
-                    break;
-                } else {
-                    free(data);
-                }
+            uint32_t size = Mix_GetFileSize(mainCd, moviesNames[i]);
+            g_moviesMix = Mix_OpenNested(mainCd, moviesNames[i]);
+            if (g_moviesMix) {
+                printf("Movies: Opened %s (%u MB, %d files)\n",
+                       moviesNames[i], size / (1024*1024),
+                       Mix_GetFileCount(g_moviesMix));
+                break;
             }
         }
     }
 
-    // Close temp CD handle if we opened it separately
+    // Nested archives keep their own reference to the data
     if (mainCd && mainCd != g_mainMix) {
-        // Note: Don't close - movies data points into it
-        // This is a memory leak but acceptable for the movies archive
+        Mix_Close(mainCd);
     }
 }
 
@@ -570,23 +511,17 @@ static void EnsureScoresOpen(void) {
 
     // Try to extract SCORES.MIX from parent
     if (Mix_FileExists(mainCd, "SCORES.MIX")) {
-        uint32_t size = 0;
-        void* data = Mix_AllocReadFile(mainCd, "SCORES.MIX", &size);
-        if (data) {
-            g_scoresMix = Mix_OpenMemory(data, size, TRUE);
-            if (g_scoresMix) {
-                g_scoresData = data;
-                printf("Music: Opened SCORES.MIX (%u KB, %d files)\n",
-                       size / 1024, Mix_GetFileCount(g_scoresMix));
-            } else {
-                free(data);
-            }
+        uint32_t size = Mix_GetFileSize(mainCd, "SCORES.MIX");
+        g_scoresMix = Mix_OpenNested(mainCd, "SCORES.MIX");
+        if (g_scoresMix) {
+            printf("Music: Opened SCORES.MIX (%u KB, %d files)\n",
+                   size / 1024, Mix_GetFileCount(g_scoresMix));
         }
     }
 
-    // Close temp CD handle if we opened it separately
+    // Nested archives keep their own reference to the data
     if (mainCd && mainCd != g_mainMix) {
-        // Don't close - may need the data
+        Mix_Close(mainCd);
     }
 }
 
@@ -634,6 +569,9 @@ static MixFileHandle TheaterMix(TheaterType theater) {
 }
 
 BOOL Assets_SetTheater(TheaterType theater) {
+    // Template loads read the current theater; let any in flight finish
+    AssetCache_Settle();
+
     // Load theater palette
     uint8_t pal[768];
     const char* palName = TheaterPaletteName(theater);
@@ -674,15 +612,8 @@ void* Assets_LoadTemplate(const char* name, uint32_t* outSize) {
         g_temperatMix,
         g_localMix,
         g_mainMix,
-        g_redalertMix,
-        nullptr
+        g_redalertMix
     };
 
-    for (int i = 0; searchOrder[i]; i++) {
-        if (Mix_FileExists(searchOrder[i], name)) {
-            return Mix_AllocReadFile(searchOrder[i], name, outSize);
-        }
-    }
-
-    return nullptr;
+    return ReadFromArchives(name, searchOrder, ORDER_COUNT(searchOrder), outSize);
 }
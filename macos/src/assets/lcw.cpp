@@ -1,13 +1,17 @@
 /**
  * Red Alert macOS Port - LCW Compression Implementation
  *
- * Uses libwestwood for LCW decompression.
+ * Uses libwestwood for LCW decompression. Builds that don't link
+ * libwestwood (ra_headless) define LCW_NO_LIBWESTWOOD and get the
+ * self-contained decoder below instead.
  * Provides Base64 decode utility.
  */
 
 #include "lcw.h"
-#include <westwood/lcw.h>
 #include <cstring>
+#ifndef LCW_NO_LIBWESTWOOD
+#include <westwood/lcw.h>
+#endif
 
 // Base64 decode table
 static const int8_t b64_table[256] = {
@@ -76,6 +80,8 @@ int Base64_Decode(const char* src, int srcLen, uint8_t* dst, int dstSize) {
     return dstIdx;
 }
 
+#ifndef LCW_NO_LIBWESTWOOD
+
 int LCW_Decompress(const uint8_t* src, uint8_t* dst, int srcSize, int dstSize) {
     if (!src || !dst || srcSize <= 0 || dstSize <= 0) return -1;
 
@@ -89,3 +95,76 @@ int LCW_Decompress(const uint8_t* src, uint8_t* dst, int srcSize, int dstSize) {
 
     return static_cast<int>(*result);
 }
+
+#else
+
+int LCW_Decompress(const uint8_t* src, uint8_t* dst, int srcSize, int dstSize) {
+    if (!src || !dst || srcSize <= 0 || dstSize <= 0) return -1;
+
+    const uint8_t* in = src;
+    const uint8_t* inEnd = src + srcSize;
+    int out = 0;
+
+    // Copies from earlier output go a byte at a time: sources may overlap
+    // the bytes being written, which is how runs repeat
+    auto copyBack = [&](int from, int count) {
+        if (count == 0) return true;
+        if (from < 0 || from >= out || count > dstSize - out) return false;
+        for (int i = 0; i < count; i++) {
+            dst[out + i] = dst[from + i];
+        }
+        out += count;
+        return true;
+    };
+    auto readWord = [&](int* value) {
+        if (inEnd - in < 2) return false;
+        *value = in[0] | (in[1] << 8);
+        in += 2;
+        return true;
+    };
+
+    while (in < inEnd) {
+        uint8_t cmd = *in++;
+
+        if (cmd == 0x80) {
+            return out;     // End of data
+        }
+
+        if ((cmd & 0x80) == 0) {
+            // 0cccpppp pppppppp: copy c+3 bytes from p bytes back
+            if (in >= inEnd) return -1;
+            int count = ((cmd & 0x70) >> 4) + 3;
+            int back = ((cmd & 0x0F) << 8) | *in++;
+            if (!copyBack(out - back, count)) return -1;
+        } else if ((cmd & 0x40) == 0) {
+            // 10cccccc: copy c literal bytes
+            int count = cmd & 0x3F;
+            if (inEnd - in < count || count > dstSize - out) return -1;
+            memcpy(dst + out, in, count);
+            in += count;
+            out += count;
+        } else if (cmd == 0xFE) {
+            // 0xFE count value: fill
+            int count;
+            if (!readWord(&count) || in >= inEnd || count > dstSize - out) return -1;
+            memset(dst + out, *in++, count);
+            out += count;
+        } else if (cmd == 0xFF) {
+            // 0xFF count pos: long copy from an absolute output position
+            int count, pos;
+            if (!readWord(&count) || !readWord(&pos)) return -1;
+            if (!copyBack(pos, count)) return -1;
+        } else {
+            // 11cccccc pos: copy c+3 bytes from an absolute output position
+            int count = (cmd & 0x3F) + 3;
+            int pos;
+            if (!readWord(&pos)) return -1;
+            if (!copyBack(pos, count)) return -1;
+        }
+    }
+
+    // Ran out of input without an end marker: truncated
+    return -1;
+}
+
+#endif // LCW_NO_LIBWESTWOOD
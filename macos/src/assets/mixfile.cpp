@@ -1,29 +1,45 @@
 /**
  * Red Alert macOS Port - MIX File Reader Implementation
  *
- * Wrapper around libwestwood's MixReader.
+ * Archives are memory-mapped and indexed by MixView where possible, so
+ * lookups return spans into the mapping and nested archives are views
+ * into their parent. libwestwood's MixReader is kept as a fallback for
+ * anything MixView can't parse.
  * Provides C-style API for compatibility with existing game code.
  */
 
 #include "mixfile.h"
+#include "mixview.h"
 #include <westwood/mix.h>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <vector>
 
-// Internal MIX file structure wrapping libwestwood
+// Internal MIX file structure: a zero-copy view, or a libwestwood reader
 struct MixFile {
+    std::unique_ptr<MixView> view;
     std::unique_ptr<wwd::MixReader> reader;
     std::vector<uint8_t> ownedData;  // For memory-loaded MIX files
 };
 
+// Views are read-only and safe from asset workers; reads through a
+// libwestwood reader may seek its stream, so they take turns
+static std::mutex g_readerMutex;
+
 uint32_t Mix_CalculateCRC(const char* name) {
     // libwestwood uses mix_hash_td for Red Alert
     return wwd::mix_hash_td(name);
 }
 
 MixFileHandle Mix_Open(const char* filename) {
+    if (auto view = MixView::OpenFile(filename)) {
+        auto* mix = new MixFile();
+        mix->view = std::move(view);
+        return mix;
+    }
+
     auto result = wwd::MixReader::open(filename);
     if (!result) {
         return nullptr;
@@ -35,6 +51,12 @@ MixFileHandle Mix_Open(const char* filename) {
 }
 
 MixFileHandle Mix_OpenMemory(const void* data, uint32_t size, BOOL ownsData) {
+    if (auto view = MixView::OpenMemory(data, size, ownsData != FALSE)) {
+        auto* mix = new MixFile();
+        mix->view = std::move(view);
+        return mix;
+    }
+
     std::span<const uint8_t> span(static_cast<const uint8_t*>(data), size);
     auto result = wwd::MixReader::open(span);
     if (!result) {
@@ -55,11 +77,31 @@ MixFileHandle Mix_OpenMemory(const void* data, uint32_t size, BOOL ownsData) {
     return mix;
 }
 
+MixFileHandle Mix_OpenNested(MixFileHandle parent, const char* name) {
+    if (!parent) return nullptr;
+
+    // Share the parent's bytes when it has them
+    if (parent->view) {
+        auto view = parent->view->OpenNested(Mix_CalculateCRC(name));
+        if (view) {
+            auto* mix = new MixFile();
+            mix->view = std::move(view);
+            return mix;
+        }
+    }
+
+    uint32_t size = 0;
+    void* data = Mix_AllocReadFile(parent, name, &size);
+    if (!data) return nullptr;
+    return Mix_OpenMemory(data, size, TRUE);
+}
+
 void Mix_Close(MixFileHandle mix) {
     delete mix;
 }
 
 int Mix_GetFileCount(MixFileHandle mix) {
+    if (mix && mix->view) return static_cast<int>(mix->view->Entries().size());
     if (!mix || !mix->reader) return 0;
     return static_cast<int>(mix->reader->entries().size());
 }
@@ -69,11 +111,16 @@ BOOL Mix_FileExists(MixFileHandle mix, const char* name) {
 }
 
 BOOL Mix_FileExistsByCRC(MixFileHandle mix, uint32_t crc) {
+    if (mix && mix->view) return mix->view->FindEntry(crc) != nullptr;
     if (!mix || !mix->reader) return FALSE;
     return mix->reader->find(crc) != nullptr;
 }
 
 uint32_t Mix_GetFileSize(MixFileHandle mix, const char* name) {
+    if (mix && mix->view) {
+        const auto* entry = mix->view->FindEntry(Mix_CalculateCRC(name));
+        return entry ? entry->size : 0;
+    }
     if (!mix || !mix->reader) return 0;
     const auto* entry = mix->reader->find(Mix_CalculateCRC(name));
     return entry ? entry->size : 0;
@@ -81,6 +128,13 @@ uint32_t Mix_GetFileSize(MixFileHandle mix, const char* name) {
 
 uint32_t Mix_ReadFileByCRC(MixFileHandle mix, uint32_t crc,
                            void* buffer, uint32_t bufSize) {
+    if (mix && mix->view && buffer) {
+        std::span<const uint8_t> data = mix->view->Find(crc);
+        uint32_t copySize = (data.size() < bufSize) ?
+                            static_cast<uint32_t>(data.size()) : bufSize;
+        if (copySize) memcpy(buffer, data.data(), copySize);
+        return copySize;
+    }
     if (!mix || !mix->reader || !buffer) return 0;
 
     const auto* entry = mix->reader->find(crc);
@@ -101,24 +155,18 @@ uint32_t Mix_ReadFile(MixFileHandle mix, const char* name,
 
 void* Mix_AllocReadFile(MixFileHandle mix, const char* name,
                         uint32_t* outSize) {
-    if (!mix || !mix->reader) return nullptr;
-
-    const auto* entry = mix->reader->find(Mix_CalculateCRC(name));
-    if (!entry) return nullptr;
-
-    auto result = mix->reader->read(*entry);
-    if (!result) return nullptr;
-
-    void* buffer = malloc(result->size());
-    if (!buffer) return nullptr;
-
-    memcpy(buffer, result->data(), result->size());
-    if (outSize) *outSize = static_cast<uint32_t>(result->size());
-    return buffer;
+    return Mix_AllocReadFileByCRC(mix, Mix_CalculateCRC(name), outSize);
 }
 
 BOOL Mix_GetEntryByIndex(MixFileHandle mix, int index,
                          uint32_t* outCRC, uint32_t* outSize) {
+    if (mix && mix->view) {
+        const auto& entries = mix->view->Entries();
+        if (index < 0 || index >= static_cast<int>(entries.size())) return FALSE;
+        if (outCRC) *outCRC = entries[index].crc;
+        if (outSize) *outSize = entries[index].size;
+        return TRUE;
+    }
     if (!mix || !mix->reader) return FALSE;
 
     const auto& entries = mix->reader->entries();
@@ -131,11 +179,23 @@ BOOL Mix_GetEntryByIndex(MixFileHandle mix, int index,
 
 void* Mix_AllocReadFileByCRC(MixFileHandle mix, uint32_t crc,
                              uint32_t* outSize) {
+    if (mix && mix->view) {
+        // Single copy straight out of the mapping
+        const auto* entry = mix->view->FindEntry(crc);
+        if (!entry) return nullptr;
+        std::span<const uint8_t> data = mix->view->Find(crc);
+        void* buffer = malloc(data.empty() ? 1 : data.size());
+        if (!buffer) return nullptr;
+        if (!data.empty()) memcpy(buffer, data.data(), data.size());
+        if (outSize) *outSize = static_cast<uint32_t>(data.size());
+        return buffer;
+    }
     if (!mix || !mix->reader) return nullptr;
 
     const auto* entry = mix->reader->find(crc);
     if (!entry) return nullptr;
 
+    std::lock_guard<std::mutex> lock(g_readerMutex);
     auto result = mix->reader->read(*entry);
     if (!result) return nullptr;
 
@@ -146,3 +206,38 @@ void* Mix_AllocReadFileByCRC(MixFileHandle mix, uint32_t crc,
     if (outSize) *outSize = static_cast<uint32_t>(result->size());
     return buffer;
 }
+
+// Copy a span into a malloc()ed buffer
+static void* AllocCopy(std::span<const uint8_t> data, uint32_t* outSize) {
+    void* buffer = malloc(data.empty() ? 1 : data.size());
+    if (!buffer) return nullptr;
+    if (!data.empty()) memcpy(buffer, data.data(), data.size());
+    if (outSize) *outSize = static_cast<uint32_t>(data.size());
+    return buffer;
+}
+
+void* Mix_AllocReadEntry(MixFileHandle mix, int index, uint32_t* outSize) {
+    if (mix && mix->view) {
+        const auto& entries = mix->view->Entries();
+        if (index < 0 || index >= static_cast<int>(entries.size())) return nullptr;
+        return AllocCopy(mix->view->Data(entries[index]), outSize);
+    }
+    if (!mix || !mix->reader) return nullptr;
+
+    const auto& entries = mix->reader->entries();
+    if (index < 0 || index >= static_cast<int>(entries.size())) return nullptr;
+
+    std::lock_guard<std::mutex> lock(g_readerMutex);
+    auto result = mix->reader->read(entries[index]);
+    if (!result) return nullptr;
+    return AllocCopy(std::span<const uint8_t>(result->data(), result->size()), outSize);
+}
+
+std::span<const uint8_t> Mix_GetFileSpanByCRC(MixFileHandle mix, uint32_t crc) {
+    if (!mix || !mix->view) return {};
+    return mix->view->Find(crc);
+}
+
+std::span<const uint8_t> Mix_GetFileSpan(MixFileHandle mix, const char* name) {
+    return Mix_GetFileSpanByCRC(mix, Mix_CalculateCRC(name));
+}
@@ -8,6 +8,9 @@
 #ifndef ASSETS_MIXFILE_H
 #define ASSETS_MIXFILE_H
 
+#ifdef __cplusplus
+#include <span>
+#endif
 #include "compat/windows.h"
 #include <cstdint>
 
@@ -34,6 +37,16 @@ MixFileHandle Mix_Open(const char* filename);
  */
 MixFileHandle Mix_OpenMemory(const void* data, uint32_t size, BOOL ownsData);
 
+/**
+ * Open a MIX archive stored inside another one
+ * When the parent is memory-mapped the nested archive is a view into the
+ * parent's mapping (no copy); otherwise it is extracted into memory.
+ * The parent may be closed first; the mapping lives until both are closed.
+ * @param name  Filename of the nested archive (e.g. "CONQUER.MIX")
+ * @return Handle to the nested archive, or NULL on failure
+ */
+MixFileHandle Mix_OpenNested(MixFileHandle parent, const char* name);
+
 /**
  * Close a MIX archive
  */
@@ -113,8 +126,26 @@ BOOL Mix_GetEntryByIndex(MixFileHandle mix, int index,
 void* Mix_AllocReadFileByCRC(MixFileHandle mix, uint32_t crc,
                              uint32_t* outSize);
 
+/**
+ * Allocate and read the entry at an index, with no lookup
+ * Caller must free the returned pointer with free()
+ * @param index   Entry index (as for Mix_GetEntryByIndex)
+ * @param outSize [out] Size of the returned data
+ * @return Pointer to allocated data, or NULL on failure
+ */
+void* Mix_AllocReadEntry(MixFileHandle mix, int index, uint32_t* outSize);
+
 #ifdef __cplusplus
 }
+
+/**
+ * Get a file's contents without copying
+ * The span points into the archive's mapping and stays valid until the
+ * archive (and any archive it is nested in) is closed.
+ * @return Empty span if not found or the archive isn't memory-backed
+ */
+std::span<const uint8_t> Mix_GetFileSpan(MixFileHandle mix, const char* name);
+std::span<const uint8_t> Mix_GetFileSpanByCRC(MixFileHandle mix, uint32_t crc);
 #endif
 
 #endif // ASSETS_MIXFILE_H
@@ -0,0 +1,263 @@
+/**
+ * Red Alert macOS Port - Zero-Copy MIX Archive Views Implementation
+ *
+ * Header layouts (all values little-endian):
+ *   C&C:        uint16 count, uint32 bodySize, entries[count], body
+ *   Red Alert:  uint16 0, uint16 flags, then as C&C
+ *   Encrypted:  uint16 0, uint16 flags, 80-byte RSA key block, then the
+ *               C&C header Blowfish-encrypted and padded to 8 bytes
+ * Each entry is { uint32 crc, uint32 offset, uint32 size }, with offsets
+ * relative to the start of the body.
+ */
+
+#include "mixview.h"
+#include "crypto/blowfish.h"
+#include "crypto/mixkey.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Red Alert header flags (high half of the first dword)
+constexpr uint32_t MIX_FLAG_CHECKSUM  = 0x00010000;
+constexpr uint32_t MIX_FLAG_ENCRYPTED = 0x00020000;
+
+constexpr size_t MIX_HEADER_SIZE = 6;       // count + bodySize
+constexpr size_t MIX_ENTRY_SIZE = 12;
+
+//===========================================================================
+// Backing Storage
+//===========================================================================
+
+struct MixStorage {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    bool mapped = false;    // munmap on release
+    bool owned = false;     // free on release
+
+    ~MixStorage() {
+        if (mapped) {
+            munmap(const_cast<uint8_t*>(data), size);
+        } else if (owned) {
+            free(const_cast<uint8_t*>(data));
+        }
+    }
+};
+
+static inline uint16_t ReadLE16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t ReadLE32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+//===========================================================================
+// Opening
+//===========================================================================
+
+MixView::~MixView() = default;
+
+std::unique_ptr<MixView> MixView::OpenFile(const char* path) {
+    if (!path) return nullptr;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // Mapping stays valid after the descriptor is closed
+    if (data == MAP_FAILED) return nullptr;
+
+    auto storage = std::make_shared<MixStorage>();
+    storage->data = static_cast<const uint8_t*>(data);
+    storage->size = size;
+    storage->mapped = true;
+
+    std::unique_ptr<MixView> view(new MixView());
+    view->storage_ = std::move(storage);
+    view->base_ = view->storage_->data;
+    view->size_ = size;
+    if (!view->Parse()) return nullptr;
+    return view;
+}
+
+std::unique_ptr<MixView> MixView::OpenMemory(const void* data, size_t size,
+                                             bool ownsData) {
+    if (!data || size == 0) return nullptr;
+
+    std::unique_ptr<MixView> view(new MixView());
+    view->base_ = static_cast<const uint8_t*>(data);
+    view->size_ = size;
+    if (!view->Parse()) return nullptr;
+
+    // Take ownership only once we know it's a MIX
+    auto storage = std::make_shared<MixStorage>();
+    storage->data = view->base_;
+    storage->size = size;
+    storage->owned = ownsData;
+    view->storage_ = std::move(storage);
+    return view;
+}
+
+std::unique_ptr<MixView> MixView::OpenNested(uint32_t crc) const {
+    std::span<const uint8_t> bytes = Find(crc);
+    if (bytes.empty()) return nullptr;
+
+    std::unique_ptr<MixView> view(new MixView());
+    view->storage_ = storage_;
+    view->base_ = bytes.data();
+    view->size_ = bytes.size();
+    if (!view->Parse()) return nullptr;
+    return view;
+}
+
+bool MixView::IsMapped() const {
+    return storage_ && storage_->mapped;
+}
+
+//===========================================================================
+// Header Parsing
+//===========================================================================
+
+// Fill entries from a plain (decrypted) header and check they fit
+static bool ReadIndex(const uint8_t* header, uint16_t count, uint32_t bodySize,
+                      size_t bodyAvailable, std::vector<MixView::Entry>* out) {
+    if (count == 0 || bodySize > bodyAvailable) return false;
+
+    out->resize(count);
+    for (uint16_t i = 0; i < count; i++) {
+        const uint8_t* e = header + i * MIX_ENTRY_SIZE;
+        MixView::Entry& entry = (*out)[i];
+        entry.crc = ReadLE32(e);
+        entry.offset = ReadLE32(e + 4);
+        entry.size = ReadLE32(e + 8);
+        if ((uint64_t)entry.offset + entry.size > bodySize) return false;
+    }
+    return true;
+}
+
+bool MixView::Parse() {
+    if (size_ < MIX_HEADER_SIZE) return false;
+
+    size_t headerStart = 0;
+    if (ReadLE16(base_) == 0) {
+        // Red Alert format: flags dword precedes the header
+        if (size_ < 4 + MIX_HEADER_SIZE) return false;
+        uint32_t flags = ReadLE32(base_);
+        if (flags & ~(MIX_FLAG_CHECKSUM | MIX_FLAG_ENCRYPTED)) return false;
+        if (flags & MIX_FLAG_ENCRYPTED) {
+            encrypted_ = true;
+            if (!ParseEncryptedHeader()) return false;
+            sorted_ = entries_;
+            std::sort(sorted_.begin(), sorted_.end(),
+                      [](const Entry& a, const Entry& b) { return a.crc < b.crc; });
+            return true;
+        }
+        headerStart = 4;
+    }
+
+    uint16_t count = ReadLE16(base_ + headerStart);
+    uint32_t bodySize = ReadLE32(base_ + headerStart + 2);
+    size_t bodyStart = headerStart + MIX_HEADER_SIZE + (size_t)count * MIX_ENTRY_SIZE;
+    if (bodyStart > size_) return false;
+
+    if (!ReadIndex(base_ + headerStart + MIX_HEADER_SIZE, count, bodySize,
+                   size_ - bodyStart, &entries_)) {
+        return false;
+    }
+    body_ = base_ + bodyStart;
+    bodySize_ = bodySize;
+
+    sorted_ = entries_;
+    std::sort(sorted_.begin(), sorted_.end(),
+              [](const Entry& a, const Entry& b) { return a.crc < b.crc; });
+    return true;
+}
+
+// Blowfish over 8-byte blocks; Westwood's headers store each half of the
+// block as a little-endian word, so try that order first
+static void DecryptBlocks(Blowfish& fish, uint8_t* data, size_t len,
+                          bool littleEndianWords) {
+    for (size_t i = 0; i + Blowfish::BLOCK_SIZE <= len; i += Blowfish::BLOCK_SIZE) {
+        uint8_t* block = data + i;
+        if (littleEndianWords) {
+            std::swap(block[0], block[3]); std::swap(block[1], block[2]);
+            std::swap(block[4], block[7]); std::swap(block[5], block[6]);
+        }
+        fish.DecryptBlock(block);
+        if (littleEndianWords) {
+            std::swap(block[0], block[3]); std::swap(block[1], block[2]);
+            std::swap(block[4], block[7]); std::swap(block[5], block[6]);
+        }
+    }
+}
+
+bool MixView::ParseEncryptedHeader() {
+    const size_t keyStart = 4;
+    const size_t headerStart = keyStart + MIXKEY_ENCRYPTED_SIZE;
+    if (size_ < headerStart + Blowfish::BLOCK_SIZE) return false;
+
+    uint8_t key[MIXKEY_DECRYPTED_SIZE];
+    if (!MixKey_DecryptKey(base_ + keyStart, key)) return false;
+
+    Blowfish fish;
+    fish.SetKey(key, sizeof(key));
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        bool littleEndianWords = (attempt == 0);
+
+        // First block holds the count and body size
+        uint8_t first[Blowfish::BLOCK_SIZE];
+        memcpy(first, base_ + headerStart, sizeof(first));
+        DecryptBlocks(fish, first, sizeof(first), littleEndianWords);
+        uint16_t count = ReadLE16(first);
+        uint32_t bodySize = ReadLE32(first + 2);
+
+        size_t plainSize = MIX_HEADER_SIZE + (size_t)count * MIX_ENTRY_SIZE;
+        size_t cipherSize = (plainSize + 7) & ~(size_t)7;
+        size_t bodyStart = headerStart + cipherSize;
+        if (count == 0 || bodyStart > size_) continue;
+
+        std::vector<uint8_t> header(base_ + headerStart, base_ + bodyStart);
+        DecryptBlocks(fish, header.data(), header.size(), littleEndianWords);
+
+        // A wrong byte order yields garbage that fails the bounds checks
+        if (!ReadIndex(header.data() + MIX_HEADER_SIZE, count, bodySize,
+                       size_ - bodyStart, &entries_)) {
+            entries_.clear();
+            continue;
+        }
+        body_ = base_ + bodyStart;
+        bodySize_ = bodySize;
+        return true;
+    }
+    return false;
+}
+
+//===========================================================================
+// Lookups
+//===========================================================================
+
+const MixView::Entry* MixView::FindEntry(uint32_t crc) const {
+    auto it = std::lower_bound(sorted_.begin(), sorted_.end(), crc,
+                               [](const Entry& e, uint32_t c) { return e.crc < c; });
+    if (it == sorted_.end() || it->crc != crc) return nullptr;
+    return &*it;
+}
+
+std::span<const uint8_t> MixView::Find(uint32_t crc) const {
+    const Entry* entry = FindEntry(crc);
+    if (!entry) return {};
+    return Data(*entry);
+}
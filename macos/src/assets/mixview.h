@@ -0,0 +1,92 @@
+/**
+ * Red Alert macOS Port - Zero-Copy MIX Archive Views
+ *
+ * Reads MIX archives straight out of a memory mapping. Only the header
+ * index is parsed (and decrypted, for Red Alert's encrypted headers);
+ * file contents are returned as spans into the mapping. A MIX stored
+ * inside another MIX becomes an (offset, length) view that shares the
+ * parent's mapping, so nested archives cost no heap at all.
+ *
+ * Lookups are by CRC; the filename hash lives in mixfile.cpp.
+ */
+
+#ifndef ASSETS_MIXVIEW_H
+#define ASSETS_MIXVIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Backing bytes shared by an archive and every view nested inside it
+struct MixStorage;
+
+class MixView {
+public:
+    struct Entry {
+        uint32_t crc;
+        uint32_t offset;    // Relative to the body
+        uint32_t size;
+    };
+
+    ~MixView();
+
+    /**
+     * Map a MIX file read-only
+     * @return nullptr if the file can't be mapped or isn't a MIX
+     */
+    static std::unique_ptr<MixView> OpenFile(const char* path);
+
+    /**
+     * Parse a MIX already in memory
+     * @param ownsData  If true, the data is free()d with the last view
+     * @return nullptr if not a MIX (data is not freed in that case)
+     */
+    static std::unique_ptr<MixView> OpenMemory(const void* data, size_t size,
+                                               bool ownsData);
+
+    /**
+     * Open a MIX stored inside this one as a view into the same bytes
+     * @return nullptr if the entry is missing or isn't a MIX
+     */
+    std::unique_ptr<MixView> OpenNested(uint32_t crc) const;
+
+    // Entry with this CRC, or nullptr
+    const Entry* FindEntry(uint32_t crc) const;
+
+    // Contents of the entry with this CRC; empty if missing
+    std::span<const uint8_t> Find(uint32_t crc) const;
+
+    // Contents of an entry
+    std::span<const uint8_t> Data(const Entry& entry) const {
+        return {body_ + entry.offset, entry.size};
+    }
+
+    // Entries in header order
+    const std::vector<Entry>& Entries() const { return entries_; }
+
+    // Whole archive, header included
+    std::span<const uint8_t> Bytes() const { return {base_, size_}; }
+
+    bool IsEncrypted() const { return encrypted_; }
+
+    // True if the bytes come from a file mapping (directly or via a parent)
+    bool IsMapped() const;
+
+private:
+    MixView() = default;
+    bool Parse();
+    bool ParseEncryptedHeader();
+
+    std::shared_ptr<MixStorage> storage_;
+    const uint8_t* base_ = nullptr;
+    size_t size_ = 0;
+    const uint8_t* body_ = nullptr;
+    size_t bodySize_ = 0;
+    bool encrypted_ = false;
+    std::vector<Entry> entries_;        // Header order
+    std::vector<Entry> sorted_;         // By CRC, for lookups
+};
+
+#endif // ASSETS_MIXVIEW_H
@@ -7,6 +7,7 @@
 
 #include "shpfile.h"
 #include <westwood/shp.h>
+#include <wwd/span_sprite.h>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
@@ -17,9 +18,44 @@
 struct ShpFile {
     std::unique_ptr<wwd::ShpReader> reader;
     std::vector<std::vector<uint8_t>> decodedFrames;
+    std::vector<uint8_t> spanArena;     // Every frame's span encoding
     std::vector<ShpFrame> frames;
 };
 
+static size_t AlignSpan(size_t offset) {
+    return (offset + WWD_SPAN_ALIGN - 1) & ~(WWD_SPAN_ALIGN - 1);
+}
+
+// Span-encode every decoded frame into one arena, so transparent blits
+// copy whole runs instead of testing each pixel for colour 0
+static void Shp_EncodeSpans(ShpFile* shp) {
+    // Frames that failed to decode (or came back short) stay unencoded
+    auto source = [shp](size_t i) -> const uint8_t* {
+        const ShpFrame& frame = shp->frames[i];
+        size_t needed = (size_t)frame.width * frame.height;
+        return shp->decodedFrames[i].size() >= needed ? frame.pixels : nullptr;
+    };
+
+    std::vector<size_t> offsets(shp->frames.size());
+    size_t total = 0;
+    for (size_t i = 0; i < shp->frames.size(); i++) {
+        const ShpFrame& frame = shp->frames[i];
+        total = AlignSpan(total);
+        offsets[i] = total;
+        total += Wwd_SpanSprite_EncodedSize(source(i), frame.width, frame.height);
+    }
+
+    // std::vector storage comes from operator new, aligned well past 4
+    shp->spanArena.resize(total);
+    for (size_t i = 0; i < shp->frames.size(); i++) {
+        ShpFrame& frame = shp->frames[i];
+        uint8_t* out = shp->spanArena.data() + offsets[i];
+        frame.spans = Wwd_SpanSprite_Encode(source(i), frame.width, frame.height, out)
+                          ? out
+                          : nullptr;
+    }
+}
+
 static ShpFileHandle Shp_LoadInternal(std::unique_ptr<wwd::ShpReader> reader) {
     if (!reader) return nullptr;
 
@@ -46,7 +82,9 @@ static ShpFileHandle Shp_LoadInternal(std::unique_ptr<wwd::ShpReader> reader) {
         shp->frames[i].pixels = shp->decodedFrames[i].empty()
                                     ? nullptr
                                     : shp->decodedFrames[i].data();
+        shp->frames[i].spans = nullptr;
     }
+    Shp_EncodeSpans(shp);
 
     return shp;
 }
@@ -79,6 +117,15 @@ int Shp_GetFrameCount(ShpFileHandle shp) {
     return static_cast<int>(shp->frames.size());
 }
 
+uint32_t Shp_GetDataSize(ShpFileHandle shp) {
+    if (!shp) return 0;
+    size_t bytes = shp->spanArena.size() + shp->frames.size() * sizeof(ShpFrame);
+    for (const auto& frame : shp->decodedFrames) {
+        bytes += frame.size();
+    }
+    return static_cast<uint32_t>(bytes);
+}
+
 const ShpFrame* Shp_GetFrame(ShpFileHandle shp, int index) {
     if (!shp) return nullptr;
     if (index < 0 || index >= static_cast<int>(shp->frames.size())) {
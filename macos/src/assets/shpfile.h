@@ -25,6 +25,7 @@ typedef struct {
     uint16_t height;
     int16_t offsetX;        // Hotspot offset X
     int16_t offsetY;        // Hotspot offset Y
+    const uint8_t* spans;   // Opaque runs (wwd/span_sprite.h), NULL if undecoded
 } ShpFrame;
 
 /**
@@ -52,6 +53,11 @@ void Shp_Free(ShpFileHandle shp);
  */
 int Shp_GetFrameCount(ShpFileHandle shp);
 
+/**
+ * Bytes held by the decoded frames and their span encoding
+ */
+uint32_t Shp_GetDataSize(ShpFileHandle shp);
+
 /**
  * Get a specific frame from the SHP
  * @param index  Frame index (0-based)
@@ -77,6 +77,15 @@ int Tmp_GetTileCount(TmpFileHandle tmp) {
     return static_cast<int>(tmp->tiles.size());
 }
 
+uint32_t Tmp_GetDataSize(TmpFileHandle tmp) {
+    if (!tmp) return 0;
+    size_t bytes = tmp->tiles.size() * sizeof(TmpTile);
+    for (const auto& tile : tmp->decodedTiles) {
+        bytes += tile.size();
+    }
+    return static_cast<uint32_t>(bytes);
+}
+
 const TmpTile* Tmp_GetTile(TmpFileHandle tmp, int index) {
     if (!tmp || index < 0 || index >= static_cast<int>(tmp->tiles.size())) {
         return nullptr;
@@ -53,6 +53,9 @@ int Tmp_GetTileCount(TmpFileHandle tmp);
 // Get tile by index (returns nullptr for empty tiles)
 const TmpTile* Tmp_GetTile(TmpFileHandle tmp, int index);
 
+// Bytes held by the decoded tiles
+uint32_t Tmp_GetDataSize(TmpFileHandle tmp);
+
 // Get tile dimensions
 uint16_t Tmp_GetTileWidth(TmpFileHandle tmp);
 uint16_t Tmp_GetTileHeight(TmpFileHandle tmp);
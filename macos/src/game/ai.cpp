@@ -4,7 +4,10 @@
 
 #include "ai.h"
 #include "units.h"
+#include "sprites.h"
 #include "map.h"
+#include "threat.h"
+#include "random.h"
 #include <cstdlib>
 #include <cmath>
 
@@ -264,6 +267,9 @@ static void AI_TryBuildStructure(void) {
     BuildingType toBuild = AI_BUILD_ORDER[g_aiBuildOrderIndex];
     int cost = AI_BUILDING_COSTS[toBuild];
 
+    // Decode its sprite while the AI saves up and finds a spot
+    Sprites_HintBuilding(toBuild);
+
     // Check if we can afford it
     if (g_aiCredits < cost) {
         return;
@@ -297,7 +303,7 @@ static void AI_TryBuildStructure(void) {
             for (int bx = 0; bx < width; bx++) {
                 MapCell* cell = Map_GetCell(placeX + bx, placeY + by);
                 if (cell) {
-                    cell->terrain = TERRAIN_BUILDING;
+                    Map_SetTerrain(placeX + bx, placeY + by, TERRAIN_BUILDING);
                     cell->buildingId = (int16_t)id;
                 }
             }
@@ -333,7 +339,7 @@ static void AI_TryProduceUnit(void) {
 
     if (totalWeight == 0) return;
 
-    int roll = rand() % totalWeight;
+    int roll = Random_Sim(totalWeight);
     int cumulative = 0;
     UnitType toBuild = UNIT_NONE;
 
@@ -529,24 +535,25 @@ void AI_Update(void) {
             } else {
                 // Normal aggro range check with threat assessment
                 int aggroRange = unit->attackRange * 3;
-                int aggroRangeSq = aggroRange * aggroRange;
-
-                for (int j = 0; j < MAX_UNITS; j++) {
+                int nearIds[MAX_UNITS];
+                int nearCount = Units_QueryRadius(unit->worldX, unit->worldY,
+                                                  aggroRange,
+                                                  UNITS_TEAM_BIT(TEAM_PLAYER),
+                                                  nearIds, MAX_UNITS);
+
+                for (int n = 0; n < nearCount; n++) {
+                    int j = nearIds[n];
                     Unit* target = Units_Get(j);
-                    if (!target || !target->active) continue;
-                    if (target->team != TEAM_PLAYER) continue;
-
-                    int dx = target->worldX - unit->worldX;
-                    int dy = target->worldY - unit->worldY;
-                    int distSq = dx * dx + dy * dy;
-
-                    if (distSq < aggroRangeSq) {
-                        // Use threat assessment to pick best target
-                        int score = AI_CalcThreatScore(target, unit);
-                        if (score > bestScore) {
-                            bestScore = score;
-                            bestTarget = j;
-                        }
+                    if (!target) continue;
+
+                    // Use threat assessment to pick best target
+                    // (ties go to the lowest id, as with a full scan)
+                    int score = AI_CalcThreatScore(target, unit);
+                    if (score > bestScore ||
+                        (score == bestScore && bestTarget >= 0 &&
+                         j < bestTarget)) {
+                        bestScore = score;
+                        bestTarget = j;
                     }
                 }
             }
@@ -579,6 +586,12 @@ static int GetUnitThreatPriority(UnitType type) {
     }
 }
 
+// Hostile threat reading (see threat.h) per point of target score, and the
+// most it can take off (less than the lowest type priority, so every target
+// still scores above zero)
+static const int THREAT_SCORE_DIVISOR = 32;
+static const int MAX_COVER_PENALTY = 60;
+
 int AI_CalcThreatScore(Unit* target, Unit* attacker) {
     if (!target || !target->active) return 0;
     if (!attacker || !attacker->active) return 0;
@@ -614,6 +627,13 @@ int AI_CalcThreatScore(Unit* target, Unit* attacker) {
         score += 100;
     }
 
+    // Targets sitting under heavy fire cost more to reach; stragglers are
+    // easy pickings. One threat map read rather than counting defenders.
+    int cellX, cellY;
+    Map_WorldToCell(target->worldX, target->worldY, &cellX, &cellY);
+    int cover = Threat_Against(attacker->team, cellX, cellY) / THREAT_SCORE_DIVISOR;
+    score -= (cover < MAX_COVER_PENALTY) ? cover : MAX_COVER_PENALTY;
+
     return score;
 }
 
@@ -643,24 +663,27 @@ int AI_FindHuntTarget(int unitId) {
     int bestScore = 0;
 
     // Hunt mode searches entire map, not just aggro range
-    for (int j = 0; j < MAX_UNITS; j++) {
+    Team enemyTeam;
+    if (unit->team == TEAM_ENEMY) {
+        enemyTeam = TEAM_PLAYER;
+    } else if (unit->team == TEAM_PLAYER) {
+        enemyTeam = TEAM_ENEMY;
+    } else {
+        return -1;
+    }
+
+    int enemyIds[MAX_UNITS];
+    int enemyCount = Units_GetTeamUnits(enemyTeam, enemyIds, MAX_UNITS);
+    for (int n = 0; n < enemyCount; n++) {
+        int j = enemyIds[n];
         Unit* target = Units_Get(j);
-        if (!target || !target->active) continue;
-
-        // Check if enemy
-        bool isEnemy = false;
-        if (unit->team == TEAM_ENEMY && target->team == TEAM_PLAYER) {
-            isEnemy = true;
-        } else if (unit->team == TEAM_PLAYER && target->team == TEAM_ENEMY) {
-            isEnemy = true;
-        }
-
-        if (!isEnemy) continue;
+        if (!target) continue;
 
-        // Calculate threat score
+        // Calculate threat score (ties go to the lowest id)
         int score = AI_CalcThreatScore(target, unit);
 
-        if (score > bestScore) {
+        if (score > bestScore ||
+            (score == bestScore && bestTarget >= 0 && j < bestTarget)) {
             bestScore = score;
             bestTarget = j;
         }
@@ -807,6 +807,8 @@ bool BuildingClass::Limbo() {
         CELL cell = baseCell + *occupyList;
         if (Map.IsValidCell(cell)) {
             Map[cell].OccupyUp(this);
+            Map[cell].flag_.occupy.building = 0;
+            Map.ZoneCell(cell);
         }
         occupyList++;
     }
@@ -829,8 +831,8 @@ bool BuildingClass::Unlimbo(int32_t coord, DirType facing) {
         CELL cell = baseCell + *occupyList;
         if (Map.IsValidCell(cell)) {
             Map[cell].OccupyDown(this);
-            // Mark cell as having building
-            // Would set cell flags
+            Map[cell].flag_.occupy.building = 1;
+            Map.ZoneCell(cell);
         }
         occupyList++;
     }
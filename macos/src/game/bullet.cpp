@@ -7,6 +7,7 @@
 #include "bullet.h"
 #include "combat.h"
 #include "mapclass.h"
+#include "random.h"
 #include <cmath>
 #include <cstdlib>
 
@@ -241,8 +242,8 @@ int BulletClass::DistanceToTarget() const {
 int32_t BulletClass::ApplyScatter(int32_t target) const {
     // Add random scatter to target
     int scatter = 64;  // ~1/4 cell scatter
-    int offsetX = (rand() % (scatter * 2 + 1)) - scatter;
-    int offsetY = (rand() % (scatter * 2 + 1)) - scatter;
+    int offsetX = Random_Sim(scatter * 2 + 1) - scatter;
+    int offsetY = Random_Sim(scatter * 2 + 1) - scatter;
 
     return XY_Coord(Coord_X(target) + offsetX, Coord_Y(target) + offsetY);
 }
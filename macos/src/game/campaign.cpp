@@ -56,6 +56,8 @@ struct CampaignUnit {
     int16_t transportId;
     int16_t loadTarget;
     char triggerName[24];
+    uint8_t pathPartial;
+    uint8_t repathDelay;
 };
 
 struct CampaignBuilding {
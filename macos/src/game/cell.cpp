@@ -215,6 +215,30 @@ bool CellClass::IsBridge() const {
     return false;
 }
 
+bool CellClass::IsZonePassable(MZoneType check) const {
+    if (flag_.occupy.building) return false;
+
+    switch (check) {
+        case MZoneType::NORMAL:
+            return IsPassable(SpeedType::TRACK);
+
+        case MZoneType::CRUSHER:
+            // Concrete walls stop crushers; fences and sandbags don't
+            if (IsWall()) return overlay_ != OverlayType::BRICK_WALL;
+            return IsPassable(SpeedType::TRACK);
+
+        case MZoneType::DESTROYER:
+            // Walls can be shot through, so only terrain blocks
+            return IsPassable(SpeedType::FOOT);
+
+        case MZoneType::WATER:
+            return IsPassable(SpeedType::FLOAT);
+
+        default:
+            return false;
+    }
+}
+
 //===========================================================================
 // Resource Queries (Ore/Gems)
 //===========================================================================
@@ -145,6 +145,10 @@ public:
                        bool ignoreVehicles = false) const;
     bool IsBridge() const;
 
+    // Passability as seen by movement zone labelling (buildings block
+    // every zone; crushers pass fences, destroyers pass any wall)
+    bool IsZonePassable(MZoneType check) const;
+
     //-----------------------------------------------------------------------
     // Resource Queries (Ore/Gems)
     //-----------------------------------------------------------------------
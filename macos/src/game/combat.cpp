@@ -212,6 +212,7 @@ void Explosion_Damage(int32_t coord, int damage, TechnoClass* source,
 
             if (distance < GetWarheadSpread(warhead)) {
                 cellRef.ReduceWall(damage);
+                Map.ZoneCell(cell);
             }
         }
 
@@ -13,6 +13,10 @@
 #include <algorithm>
 #include <cstring>
 
+// Forward declaration (sprites.h brings in units.h, whose enums clash
+// with types.h)
+extern "C" void Sprites_Hint(const char* iniName);
+
 //===========================================================================
 // Global Factory Array
 //===========================================================================
@@ -306,6 +310,40 @@ TechnoClass* FactoryClass::Complete() {
 // Queue Management
 //===========================================================================
 
+// Start decoding the sprite of something that was just queued, so it is
+// ready by the time it rolls out
+static void HintSprite(RTTIType type, int id) {
+    const char* iniName = nullptr;
+    switch (type) {
+        case RTTIType::INFANTRY:
+            if (id < static_cast<int>(InfantryType::COUNT)) {
+                auto inf = GetInfantryTypeConst(static_cast<InfantryType>(id));
+                if (inf) iniName = inf->iniName;
+            }
+            break;
+        case RTTIType::UNIT:
+            if (id < static_cast<int>(UnitType::COUNT)) {
+                auto unit = GetUnitTypeConst(static_cast<UnitType>(id));
+                if (unit) iniName = unit->iniName;
+            }
+            break;
+        case RTTIType::BUILDING:
+            if (id < static_cast<int>(BuildingType::COUNT)) {
+                auto bld = GetBuildingTypeConst(static_cast<BuildingType>(id));
+                if (bld) iniName = bld->iniName;
+            }
+            break;
+        case RTTIType::AIRCRAFT:
+            if (id < static_cast<int>(AircraftType::COUNT)) {
+                iniName = AircraftTypes[id].iniName;
+            }
+            break;
+        default:
+            break;
+    }
+    if (iniName) Sprites_Hint(iniName);
+}
+
 bool FactoryClass::Queue_Add(RTTIType type, int id) {
     // Check if queue is full
     if (queueCount_ >= QUEUE_MAX) return false;
@@ -313,6 +351,8 @@ bool FactoryClass::Queue_Add(RTTIType type, int id) {
     // Validate type
     if (type == RTTIType::NONE || id < 0) return false;
 
+    HintSprite(type, id);
+
     // If nothing is currently being produced, start this item
     if (productionType_ == RTTIType::NONE || !isActive_) {
         if (Set(type, id, house_)) {
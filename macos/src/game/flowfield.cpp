@@ -0,0 +1,218 @@
+/**
+ * Red Alert macOS Port - Flow Field Implementation
+ *
+ * Cells are addressed as y * map width + x, the form the unit system
+ * stores; a map size change bumps the terrain revision and so flushes
+ * every field built for the old layout.
+ */
+
+#include "flowfield.h"
+#include <cstring>
+
+static const int DIR_DX[8] = { 0,  1, 1, 1, 0, -1, -1, -1 };
+static const int DIR_DY[8] = { -1, -1, 0, 1, 1,  1,  0, -1 };
+static const int DIR_COST[8] = { 10, 14, 10, 14, 10, 14, 10, 14 };
+
+static const int GRID_CELLS = MAP_MAX_WIDTH * MAP_MAX_HEIGHT;
+static const uint32_t NO_COST = 0xFFFFFFFF;
+
+struct FlowField {
+    bool valid;
+    uint8_t layer;
+    int16_t goalX;
+    int16_t goalY;
+    int16_t width;
+    int16_t height;
+    uint32_t lastUse;
+    uint8_t dir[GRID_CELLS];
+};
+
+static FlowField g_fields[FLOWFIELD_CACHE_SIZE];
+static uint32_t g_useClock = 0;
+static uint32_t g_revision = 0;
+static bool g_revisionKnown = false;
+static FlowFieldStats g_stats;
+
+// Integration scratch, shared by every build. Cells can be queued once
+// per improving neighbour, so the heap never holds more than 8 per cell.
+static uint32_t g_cost[GRID_CELLS];
+static uint64_t g_heap[GRID_CELLS * 8];
+static int g_heapSize = 0;
+
+static void Heap_Push(uint64_t key) {
+    int i = g_heapSize++;
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (g_heap[p] <= key) break;
+        g_heap[i] = g_heap[p];
+        i = p;
+    }
+    g_heap[i] = key;
+}
+
+static uint64_t Heap_Pop(void) {
+    uint64_t top = g_heap[0];
+    uint64_t last = g_heap[--g_heapSize];
+    int n = g_heapSize;
+    if (n > 0) {
+        int i = 0;
+        for (;;) {
+            int c = 2 * i + 1;
+            if (c >= n) break;
+            if (c + 1 < n && g_heap[c + 1] < g_heap[c]) c++;
+            if (last <= g_heap[c]) break;
+            g_heap[i] = g_heap[c];
+            i = c;
+        }
+        g_heap[i] = last;
+    }
+    return top;
+}
+
+static BOOL LayerPassable(int layer, int cellX, int cellY) {
+    if (layer == FLOWFIELD_NAVAL) return Map_IsWaterPassable(cellX, cellY);
+    return Map_IsPassable(cellX, cellY);
+}
+
+// Flush the cache if terrain changed since the fields were built
+static void SyncRevision(void) {
+    uint32_t revision = Map_GetTerrainRevision();
+    if (g_revisionKnown && revision == g_revision) return;
+    if (g_revisionKnown) g_stats.invalidations++;
+    FlowField_Invalidate();
+    g_revision = revision;
+    g_revisionKnown = true;
+}
+
+static FlowField* Lookup(FlowFieldLayer layer, int goalX, int goalY) {
+    SyncRevision();
+    g_stats.lookups++;
+    for (int i = 0; i < FLOWFIELD_CACHE_SIZE; i++) {
+        FlowField* field = &g_fields[i];
+        if (field->valid && field->layer == layer &&
+            field->goalX == goalX && field->goalY == goalY) {
+            field->lastUse = ++g_useClock;
+            g_stats.hits++;
+            return field;
+        }
+    }
+    return nullptr;
+}
+
+// Dijkstra outward from the goal. A cell's direction points at the
+// neighbour that settled it; only passable cells pass the wave on, but
+// blocked cells next to it still get a way out.
+static void Integrate(FlowField* field) {
+    int w = field->width;
+    int h = field->height;
+    int cells = w * h;
+    int goal = field->goalY * w + field->goalX;
+
+    memset(field->dir, FLOWFIELD_DIR_NONE, (size_t)cells);
+    memset(g_cost, 0xFF, (size_t)cells * sizeof(g_cost[0]));
+
+    g_heapSize = 0;
+    g_cost[goal] = 0;
+    field->dir[goal] = FLOWFIELD_DIR_GOAL;
+    Heap_Push((uint64_t)goal);
+
+    while (g_heapSize > 0) {
+        uint64_t key = Heap_Pop();
+        int idx = (int)(key & 0xFFFF);
+        uint32_t cost = (uint32_t)(key >> 16);
+        if (cost != g_cost[idx]) continue;      // Stale duplicate
+
+        int cx = idx % w;
+        int cy = idx / w;
+        if (idx != goal && !LayerPassable(field->layer, cx, cy)) continue;
+
+        for (int d = 0; d < 8; d++) {
+            int nx = cx + DIR_DX[d];
+            int ny = cy + DIR_DY[d];
+            if (nx < 0 || nx >= w || ny < 0 || ny >= h) continue;
+
+            int nidx = ny * w + nx;
+            uint32_t newCost = cost + DIR_COST[d];
+            if (newCost >= g_cost[nidx]) continue;
+
+            g_cost[nidx] = newCost;
+            field->dir[nidx] = (uint8_t)((d + 4) & 7);  // Step back toward idx
+            Heap_Push(((uint64_t)newCost << 16) | (uint64_t)nidx);
+        }
+    }
+}
+
+const FlowField* FlowField_Find(FlowFieldLayer layer, int goalX, int goalY) {
+    return Lookup(layer, goalX, goalY);
+}
+
+const FlowField* FlowField_Get(FlowFieldLayer layer, int goalX, int goalY) {
+    FlowField* field = Lookup(layer, goalX, goalY);
+    if (field) return field;
+
+    int w = Map_GetWidth();
+    int h = Map_GetHeight();
+    if (goalX < 0 || goalX >= w || goalY < 0 || goalY >= h) return nullptr;
+    if (!LayerPassable(layer, goalX, goalY)) return nullptr;
+
+    // Reuse a free slot, otherwise the least recently used one
+    field = &g_fields[0];
+    for (int i = 0; i < FLOWFIELD_CACHE_SIZE; i++) {
+        FlowField* slot = &g_fields[i];
+        if (!slot->valid) { field = slot; break; }
+        if (slot->lastUse < field->lastUse) field = slot;
+    }
+    if (field->valid) g_stats.evictions++;
+
+    field->valid = true;
+    field->layer = (uint8_t)layer;
+    field->goalX = (int16_t)goalX;
+    field->goalY = (int16_t)goalY;
+    field->width = (int16_t)w;
+    field->height = (int16_t)h;
+    field->lastUse = ++g_useClock;
+    Integrate(field);
+    g_stats.builds++;
+    return field;
+}
+
+int FlowField_Direction(const FlowField* field, int cellX, int cellY) {
+    if (cellX < 0 || cellX >= field->width || cellY < 0 || cellY >= field->height) {
+        return FLOWFIELD_DIR_NONE;
+    }
+    return field->dir[cellY * field->width + cellX];
+}
+
+int FlowField_Walk(const FlowField* field, int startX, int startY,
+                   int16_t* outCells, int maxCells, BOOL* partial) {
+    int dir = FlowField_Direction(field, startX, startY);
+    if (dir == FLOWFIELD_DIR_NONE) return -1;
+
+    int w = field->width;
+    int x = startX;
+    int y = startY;
+    int count = 0;
+    while (dir != FLOWFIELD_DIR_GOAL && count < maxCells) {
+        x += DIR_DX[dir];
+        y += DIR_DY[dir];
+        outCells[count++] = (int16_t)(y * w + x);
+        dir = field->dir[y * w + x];
+    }
+    g_stats.cellsWalked += count;
+    if (partial) *partial = (dir != FLOWFIELD_DIR_GOAL) ? TRUE : FALSE;
+    return count;
+}
+
+void FlowField_Invalidate(void) {
+    for (int i = 0; i < FLOWFIELD_CACHE_SIZE; i++) {
+        g_fields[i].valid = false;
+    }
+}
+
+const FlowFieldStats* FlowField_GetStats(void) {
+    return &g_stats;
+}
+
+void FlowField_ResetStats(void) {
+    memset(&g_stats, 0, sizeof(g_stats));
+}
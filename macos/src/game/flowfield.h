@@ -0,0 +1,82 @@
+/**
+ * Red Alert macOS Port - Flow Fields
+ *
+ * Shared routes for group moves. A field is built once per goal cell:
+ * a Dijkstra integration pass outward from the goal over map.cpp
+ * passability, recorded as the direction each cell steps toward the goal.
+ * Every unit heading for that goal then follows the directions, one table
+ * lookup per cell, instead of running its own search.
+ *
+ * Fields are cached by (layer, goal cell) with least-recently-used
+ * eviction and dropped whenever Map_GetTerrainRevision() moves on.
+ */
+
+#ifndef GAME_FLOWFIELD_H
+#define GAME_FLOWFIELD_H
+
+#include "map.h"
+
+#define FLOWFIELD_CACHE_SIZE    8
+
+// Direction values: 0-7 step N/NE/E/SE/S/SW/W/NW toward the goal
+#define FLOWFIELD_DIR_GOAL      8       // The goal cell itself
+#define FLOWFIELD_DIR_NONE      0xFF    // Goal not reachable from here
+
+// Passability layers, matching PathGraphLayer
+typedef enum {
+    FLOWFIELD_GROUND = 0,       // Map_IsPassable
+    FLOWFIELD_NAVAL,            // Map_IsWaterPassable
+    FLOWFIELD_LAYER_COUNT
+} FlowFieldLayer;
+
+typedef struct FlowField FlowField;
+
+// Counters since the last FlowField_ResetStats()
+typedef struct {
+    uint32_t lookups;           // FlowField_Find/FlowField_Get calls
+    uint32_t hits;              // Lookups served from the cache
+    uint32_t builds;            // Fields integrated from scratch
+    uint32_t evictions;         // Fields dropped to make room
+    uint32_t invalidations;     // Cache flushes after terrain changes
+    uint32_t cellsWalked;       // Cells emitted by FlowField_Walk
+} FlowFieldStats;
+
+/**
+ * Cached field for a goal, or NULL (never builds)
+ */
+const FlowField* FlowField_Find(FlowFieldLayer layer, int goalX, int goalY);
+
+/**
+ * Cached field for a goal, building it if needed.
+ * Moves are 8-way with the unit pathfinder's costs (10 straight, 14
+ * diagonal). Returns NULL if the goal is off the map or impassable.
+ */
+const FlowField* FlowField_Get(FlowFieldLayer layer, int goalX, int goalY);
+
+/**
+ * Direction from a cell toward the field's goal (FLOWFIELD_DIR_*)
+ */
+int FlowField_Direction(const FlowField* field, int cellX, int cellY);
+
+/**
+ * Follow the field from a start cell.
+ * @param outCells  Receives cell indices (y * map width + x), start excluded
+ * @param maxCells  Buffer size; longer routes stop early
+ * @param partial   Set to TRUE if the cells stop short of the goal
+ * @return Number of cells written, or -1 if the goal isn't reachable
+ */
+int FlowField_Walk(const FlowField* field, int startX, int startY,
+                   int16_t* outCells, int maxCells, BOOL* partial);
+
+/**
+ * Drop every cached field
+ */
+void FlowField_Invalidate(void);
+
+/**
+ * Statistics
+ */
+const FlowFieldStats* FlowField_GetStats(void);
+void FlowField_ResetStats(void);
+
+#endif // GAME_FLOWFIELD_H
@@ -10,6 +10,7 @@
 #include "unit_types.h"
 #include "infantry_types.h"
 #include "building_types.h"
+#include "random.h"
 #include <cstring>
 #include <cstdlib>
 #include <cstdio>
@@ -630,7 +631,7 @@ int HouseClass::AI_Unit() {
 
     // Randomly pick from equally-needed units
     if (bestCount > 0) {
-        buildUnit_ = static_cast<int8_t>(bestList[rand() % bestCount]);
+        buildUnit_ = static_cast<int8_t>(bestList[Random_Sim(bestCount)]);
         fprintf(stderr, "AI_Unit: House %s queued unit type %d\n",
                 Name(), buildUnit_);
     }
@@ -692,7 +693,7 @@ int HouseClass::AI_Infantry() {
 
     // Randomly pick from equally-needed infantry
     if (bestCount > 0) {
-        buildInfantry_ = static_cast<int8_t>(bestList[rand() % bestCount]);
+        buildInfantry_ = static_cast<int8_t>(bestList[Random_Sim(bestCount)]);
         fprintf(stderr, "AI_Infantry: House %s queued infantry type %d\n",
                 Name(), buildInfantry_);
     }
@@ -7,6 +7,7 @@
 #include "infantry.h"
 #include "mapclass.h"
 #include "cell.h"
+#include "random.h"
 #include <cmath>
 #include <cstring>
 
@@ -75,7 +76,7 @@ void InfantryClass::Init(InfantryType type, HousesType house) {
     SetDoType(DoType::STAND_READY);
 
     // Random idle timer
-    idleTimer_ = 300 + (rand() % 300);  // 5-10 seconds at 60fps
+    idleTimer_ = 300 + Random_Sim(300);  // 5-10 seconds at 60fps
 }
 
 //===========================================================================
@@ -413,7 +414,7 @@ void InfantryClass::AnimateFrame() {
                     // Return to standing
                     doing_ = DoType::STAND_READY;
                     frame_ = 0;
-                    idleTimer_ = 300 + (rand() % 300);
+                    idleTimer_ = 300 + Random_Sim(300);
                     break;
 
                 case DoType::WALK:
@@ -463,12 +464,12 @@ int InfantryClass::MissionGuard() {
         idleTimer_--;
     } else if (doing_ == DoType::STAND_READY || doing_ == DoType::STAND_GUARD) {
         // Play random idle animation
-        if (rand() % 2 == 0) {
+        if (Random_Sim(2) == 0) {
             SetDoType(DoType::IDLE1);
         } else {
             SetDoType(DoType::IDLE2);
         }
-        idleTimer_ = 600 + (rand() % 600);  // 10-20 seconds
+        idleTimer_ = 600 + Random_Sim(600);  // 10-20 seconds
     }
 
     return 60;  // 1 second delay
@@ -4,10 +4,12 @@
 
 #include "map.h"
 #include "terrain.h"
+#include "random.h"
 #include "graphics/metal/renderer.h"
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
+#include <vector>
 
 // Map state
 static MapCell g_cells[MAP_MAX_HEIGHT][MAP_MAX_WIDTH];
@@ -15,6 +17,57 @@ static int g_mapWidth = 0;
 static int g_mapHeight = 0;
 static bool g_fogEnabled = true;  // Fog of war enabled by default
 
+static void ResetFogState(void);
+
+// Passability edits since the consumer last cleared the list. A new map,
+// or more edits than fit, marks everything as changed instead.
+#define MAP_TERRAIN_CHANGES_MAX 1024
+static uint16_t g_terrainChanged[MAP_TERRAIN_CHANGES_MAX];
+static int g_terrainChangedCount = 0;
+static bool g_terrainChangedAll = true;
+
+// Bumped on every passability change. Map_SetTerrain() keeps the zone
+// labels in step; they are only recomputed from scratch when they fall
+// behind it (a new map, or cells written directly)
+static uint32_t g_terrainRevision = 1;
+
+static void ResetTerrainChanges(void) {
+    g_terrainChangedCount = 0;
+    g_terrainChangedAll = true;
+    g_terrainRevision++;
+}
+
+// Cells whose simulated state (terrain, ore, fog bits, occupants) changed
+// since the consumer last cleared the list. A new map marks everything.
+static uint16_t g_stateChanged[MAP_MAX_WIDTH * MAP_MAX_HEIGHT];
+static int g_stateChangedCount = 0;
+static bool g_stateChangedAll = true;
+static uint8_t g_stateQueued[MAP_MAX_HEIGHT][MAP_MAX_WIDTH];
+
+static void ResetStateChanges(void) {
+    memset(g_stateQueued, 0, sizeof(g_stateQueued));
+    g_stateChangedCount = 0;
+    g_stateChangedAll = true;
+}
+
+static void TouchCell(int x, int y) {
+    if (g_stateChangedAll || g_stateQueued[y][x]) return;
+    g_stateQueued[y][x] = 1;
+    g_stateChanged[g_stateChangedCount++] = (uint16_t)(y * MAP_MAX_WIDTH + x);
+}
+
+// Connected regions for ground (0) and naval (1) movement. Cells hold raw
+// labels; regions joined since the last full relabel alias one label to
+// another through g_zoneParent, as in MapClass.
+#define MAP_ZONE_LABELS 65536
+static uint16_t g_zones[2][MAP_MAX_HEIGHT][MAP_MAX_WIDTH];
+static uint16_t g_zoneParent[2][MAP_ZONE_LABELS];
+static int g_zoneNext[2];
+static uint32_t g_zoneRevision = 0;
+
+static void RelabelZones(void);
+static void ZoneCell(int cellX, int cellY);
+
 // Mission terrain data (for rendering with Terrain_RenderByID)
 static const uint8_t* g_missionTerrainType = nullptr;  // Template IDs
 static const uint8_t* g_missionTerrainIcon = nullptr;  // Tile indices
@@ -77,6 +130,9 @@ void Map_Init(void) {
     memset(g_cells, 0, sizeof(g_cells));
     g_mapWidth = 0;
     g_mapHeight = 0;
+    ResetFogState();
+    ResetTerrainChanges();
+    ResetStateChanges();
 }
 
 void Map_Shutdown(void) {
@@ -91,6 +147,9 @@ void Map_Create(int width, int height) {
 
     g_mapWidth = width;
     g_mapHeight = height;
+    ResetFogState();
+    ResetTerrainChanges();
+    ResetStateChanges();
 
     // Initialize all cells to clear terrain
     for (int y = 0; y < height; y++) {
@@ -101,6 +160,8 @@ void Map_Create(int width, int height) {
             g_cells[y][x].oreAmount = 0;
             g_cells[y][x].unitId = -1;
             g_cells[y][x].buildingId = -1;
+            g_cells[y][x].occupantCount = 0;
+            g_cells[y][x].occupantStored = 0;
         }
     }
 
@@ -111,6 +172,9 @@ void Map_Create(int width, int height) {
     g_viewport.height = GAME_VIEW_HEIGHT;
 }
 
+// Demo terrain generator (own stream so generation doesn't shift the game's)
+static RandomState g_genRandom;
+
 // Helper: Create a forest cluster
 static void AddForestCluster(int cx, int cy, int radius) {
     for (int dy = -radius; dy <= radius; dy++) {
@@ -123,7 +187,7 @@ static void AddForestCluster(int cx, int cy, int radius) {
             int r2 = radius * radius;
             if (dist2 <= r2 && g_cells[y][x].terrain == TERRAIN_CLEAR) {
                 // Higher chance near center
-                if (rand() % (radius * radius + 1) > dist2 / 2) {
+                if (Random_RangeState(&g_genRandom, radius * radius + 1) > dist2 / 2) {
                     Map_SetTerrain(x, y, TERRAIN_TREE);
                 }
             }
@@ -170,12 +234,12 @@ static void AddOreField(int cx, int cy, int radius) {
             int dist2 = dx * dx + dy * dy;
             int r2 = radius * radius;
             if (dist2 <= r2 && g_cells[y][x].terrain == TERRAIN_CLEAR) {
-                if (rand() % 3 != 0) {  // 67% density
+                if (Random_RangeState(&g_genRandom, 3) != 0) {  // 67% density
                     Map_SetTerrain(x, y, TERRAIN_ORE);
                     // Ore amount: more in center, less at edges
                     int rr1 = r2 + 1;
                     int amount = ORE_MAX_AMOUNT - (dist2 * 100 / rr1);
-                    if (amount < 50) amount = 50 + rand() % 50;
+                    if (amount < 50) amount = 50 + Random_RangeState(&g_genRandom, 50);
                     g_cells[y][x].oreAmount = (uint8_t)amount;
                 }
             }
@@ -187,8 +251,8 @@ void Map_GenerateDemo(void) {
     // Create a 64x64 demo map - Eastern European winter terrain
     Map_Create(64, 64);
 
-    // Seed for reproducible terrain
-    srand(12345);
+    // Fixed seed for reproducible terrain; kept off the simulation stream
+    Random_SeedState(&g_genRandom, 12345);
 
     // === WATER FEATURES ===
     // Large frozen lake in southeast quadrant
@@ -376,6 +440,8 @@ void Map_LoadFromMission(const uint8_t* terrainType, const uint8_t* terrainIcon,
                 g_cells[y][x].oreAmount = 0;
                 g_cells[y][x].unitId = -1;
                 g_cells[y][x].buildingId = -1;
+                g_cells[y][x].occupantCount = 0;
+                g_cells[y][x].occupantStored = 0;
 
                 // Process overlay data for ore/gems
                 if (overlayType) {
@@ -434,13 +500,318 @@ MapCell* Map_GetCell(int cellX, int cellY) {
     return &g_cells[cellY][cellX];
 }
 
+MapCell* Map_GetRow(int cellY) {
+    if (cellY < 0 || cellY >= g_mapHeight || g_mapWidth <= 0) {
+        return nullptr;
+    }
+    return g_cells[cellY];
+}
+
 void Map_SetTerrain(int cellX, int cellY, TerrainType terrain) {
     MapCell* cell = Map_GetCell(cellX, cellY);
-    if (cell) {
-        cell->terrain = (uint8_t)terrain;
+    if (!cell) return;
+
+    BOOL wasPassable = Map_IsPassable(cellX, cellY);
+    BOOL wasWater = Map_IsWaterPassable(cellX, cellY);
+    cell->terrain = (uint8_t)terrain;
+    TouchCell(cellX, cellY);
+    if (Map_IsPassable(cellX, cellY) == wasPassable &&
+        Map_IsWaterPassable(cellX, cellY) == wasWater) {
+        return;
+    }
+
+    // Patch the zones around this cell if they were current
+    bool zonesCurrent = (g_zoneRevision == g_terrainRevision);
+    g_terrainRevision++;
+    if (zonesCurrent) {
+        ZoneCell(cellX, cellY);
+        g_zoneRevision = g_terrainRevision;
+    }
+
+    if (g_terrainChangedAll) return;
+
+    if (g_terrainChangedCount < MAP_TERRAIN_CHANGES_MAX) {
+        g_terrainChanged[g_terrainChangedCount++] =
+            (uint16_t)(cellY * MAP_MAX_WIDTH + cellX);
+    } else {
+        g_terrainChangedAll = true;
     }
 }
 
+int Map_GetTerrainChanges(const uint16_t** cells) {
+    if (cells) *cells = g_terrainChanged;
+    return g_terrainChangedAll ? -1 : g_terrainChangedCount;
+}
+
+void Map_ClearTerrainChanges(void) {
+    g_terrainChangedCount = 0;
+    g_terrainChangedAll = false;
+}
+
+void Map_TouchCell(int cellX, int cellY) {
+    if (cellX < 0 || cellX >= g_mapWidth || cellY < 0 || cellY >= g_mapHeight) {
+        return;
+    }
+    TouchCell(cellX, cellY);
+}
+
+int Map_GetStateChanges(const uint16_t** cells) {
+    if (cells) *cells = g_stateChanged;
+    return g_stateChangedAll ? -1 : g_stateChangedCount;
+}
+
+void Map_ClearStateChanges(void) {
+    for (int i = 0; i < g_stateChangedCount; i++) {
+        int x = g_stateChanged[i] % MAP_MAX_WIDTH;
+        int y = g_stateChanged[i] / MAP_MAX_WIDTH;
+        g_stateQueued[y][x] = 0;
+    }
+    g_stateChangedCount = 0;
+    g_stateChangedAll = false;
+}
+
+uint32_t Map_GetTerrainRevision(void) {
+    return g_terrainRevision;
+}
+
+static int ZoneRunFind(int* parent, int run) {
+    while (parent[run] != run) {
+        parent[run] = parent[parent[run]];
+        run = parent[run];
+    }
+    return run;
+}
+
+// Label 8-connected regions: number horizontal runs of passable cells,
+// join each run with the runs it touches in the row above, then number
+// the joined sets in scan order
+static void RelabelZones(void) {
+    static int runs[MAP_MAX_HEIGHT][MAP_MAX_WIDTH];
+    static int parent[MAP_MAX_WIDTH * MAP_MAX_HEIGHT];
+    static uint16_t label[MAP_MAX_WIDTH * MAP_MAX_HEIGHT];
+
+    for (int layer = 0; layer < 2; layer++) {
+        int runCount = 0;
+        for (int y = 0; y < g_mapHeight; y++) {
+            int x = 0;
+            while (x < g_mapWidth) {
+                BOOL open = layer ? Map_IsWaterPassable(x, y) : Map_IsPassable(x, y);
+                if (!open) {
+                    runs[y][x++] = -1;
+                    continue;
+                }
+
+                int run = runCount++;
+                parent[run] = run;
+                int start = x;
+                while (x < g_mapWidth &&
+                       (layer ? Map_IsWaterPassable(x, y) : Map_IsPassable(x, y))) {
+                    runs[y][x++] = run;
+                }
+                if (y == 0) continue;
+
+                int from = (start > 0) ? start - 1 : 0;
+                int to = (x < g_mapWidth) ? x : g_mapWidth - 1;
+                for (int ax = from; ax <= to; ax++) {
+                    if (runs[y - 1][ax] < 0) continue;
+                    int a = ZoneRunFind(parent, runs[y - 1][ax]);
+                    int b = ZoneRunFind(parent, run);
+                    if (a < b) parent[b] = a;
+                    else if (b < a) parent[a] = b;
+                }
+            }
+        }
+
+        memset(label, 0, runCount * sizeof(uint16_t));
+        uint16_t next = 1;
+        for (int y = 0; y < g_mapHeight; y++) {
+            for (int x = 0; x < g_mapWidth; x++) {
+                if (runs[y][x] < 0) {
+                    g_zones[layer][y][x] = 0;
+                    continue;
+                }
+                int root = ZoneRunFind(parent, runs[y][x]);
+                if (label[root] == 0) label[root] = next++;
+                g_zones[layer][y][x] = label[root];
+            }
+        }
+
+        for (int i = 0; i < next; i++) {
+            g_zoneParent[layer][i] = (uint16_t)i;
+        }
+        g_zoneNext[layer] = next;
+    }
+    g_zoneRevision = g_terrainRevision;
+}
+
+static bool ZonePassable(int layer, int x, int y) {
+    return layer ? Map_IsWaterPassable(x, y) : Map_IsPassable(x, y);
+}
+
+static int ZoneFind(int layer, int zone) {
+    uint16_t* parent = g_zoneParent[layer];
+    while (parent[zone] != zone) {
+        parent[zone] = parent[parent[zone]];
+        zone = parent[zone];
+    }
+    return zone;
+}
+
+// Fresh label, or 0 once they run out
+static int ZoneAllocate(int layer) {
+    if (g_zoneNext[layer] >= MAP_ZONE_LABELS) return 0;
+    int zone = g_zoneNext[layer]++;
+    g_zoneParent[layer][zone] = (uint16_t)zone;
+    return zone;
+}
+
+// Flood a region with a label, one horizontal span at a time
+static void ZoneSpan(int layer, int cellX, int cellY, int zone) {
+    static std::vector<uint16_t> seeds;
+    uint16_t label = (uint16_t)zone;
+    auto fillable = [layer, label](int x, int y) {
+        return g_zones[layer][y][x] != label && ZonePassable(layer, x, y);
+    };
+
+    seeds.clear();
+    seeds.push_back((uint16_t)(cellY * MAP_MAX_WIDTH + cellX));
+    while (!seeds.empty()) {
+        int y = seeds.back() / MAP_MAX_WIDTH;
+        int left = seeds.back() % MAP_MAX_WIDTH;
+        seeds.pop_back();
+        if (!fillable(left, y)) continue;
+
+        int right = left;
+        while (left > 0 && fillable(left - 1, y)) left--;
+        while (right < g_mapWidth - 1 && fillable(right + 1, y)) right++;
+        for (int x = left; x <= right; x++) {
+            g_zones[layer][y][x] = label;
+        }
+
+        // Seed each span touching it above and below, diagonals included
+        int from = (left > 0) ? left - 1 : 0;
+        int to = (right < g_mapWidth - 1) ? right + 1 : g_mapWidth - 1;
+        for (int ny = y - 1; ny <= y + 1; ny += 2) {
+            if (ny < 0 || ny >= g_mapHeight) continue;
+            bool inSpan = false;
+            for (int x = from; x <= to; x++) {
+                bool open = fillable(x, ny);
+                if (open && !inSpan) {
+                    seeds.push_back((uint16_t)(ny * MAP_MAX_WIDTH + x));
+                }
+                inSpan = open;
+            }
+        }
+    }
+}
+
+// Update the zones after one cell's passability changed (the local
+// update from MapClass::ZoneCell). Opening a cell joins the regions
+// around it; closing one only refills when its open neighbours no longer
+// touch each other around the ring.
+static void ZoneCell(int cellX, int cellY) {
+    static const int RING_DX[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+    static const int RING_DY[8] = { -1, -1, 0, 1, 1, 1, 0, -1 };
+
+    int ringX[8], ringY[8];
+    bool inside[8];
+    for (int d = 0; d < 8; d++) {
+        ringX[d] = cellX + RING_DX[d];
+        ringY[d] = cellY + RING_DY[d];
+        inside[d] = ringX[d] >= 0 && ringX[d] < g_mapWidth &&
+                    ringY[d] >= 0 && ringY[d] < g_mapHeight;
+    }
+
+    for (int layer = 0; layer < 2; layer++) {
+        uint16_t* zone = &g_zones[layer][cellY][cellX];
+        bool passable = ZonePassable(layer, cellX, cellY);
+        if (passable == (*zone != 0)) continue;
+
+        if (passable) {
+            // Opened: join every labelled neighbour's region
+            int joined = 0;
+            for (int d = 0; d < 8; d++) {
+                if (!inside[d]) continue;
+                int raw = g_zones[layer][ringY[d]][ringX[d]];
+                if (raw == 0) continue;
+                int other = ZoneFind(layer, raw);
+                if (joined == 0 || other == joined) {
+                    joined = other;
+                } else {
+                    int lo = (joined < other) ? joined : other;
+                    int hi = (joined < other) ? other : joined;
+                    g_zoneParent[layer][hi] = (uint16_t)lo;
+                    joined = lo;
+                }
+            }
+            if (joined == 0) joined = ZoneAllocate(layer);
+            if (joined == 0) {
+                RelabelZones();
+                return;
+            }
+            *zone = (uint16_t)joined;
+            continue;
+        }
+
+        // Closed: the region can only split if the open neighbours fall
+        // into more than one group around the ring. Ring neighbours touch,
+        // and orthogonal neighbours touch diagonally across a closed corner.
+        int old = ZoneFind(layer, *zone);
+        *zone = 0;
+
+        bool open[8];
+        int group[8];
+        for (int d = 0; d < 8; d++) {
+            open[d] = inside[d] && g_zones[layer][ringY[d]][ringX[d]] != 0;
+            group[d] = d;
+        }
+        auto join = [&group](int a, int b) {
+            while (group[a] != a) a = group[a];
+            while (group[b] != b) b = group[b];
+            if (a < b) group[b] = a;
+            else if (b < a) group[a] = b;
+        };
+        for (int d = 0; d < 8; d++) {
+            if (open[d] && open[(d + 1) & 7]) join(d, (d + 1) & 7);
+            if (!(d & 1) && open[d] && open[(d + 2) & 7]) join(d, (d + 2) & 7);
+        }
+
+        int pieces[8];
+        int pieceCount = 0;
+        for (int d = 0; d < 8; d++) {
+            if (!open[d]) continue;
+            int root = d;
+            while (group[root] != root) root = group[root];
+            if (root == d) pieces[pieceCount++] = d;
+        }
+
+        // Refill every group but the first with a fresh label. A fill that
+        // reaches the first group means the region is still whole.
+        for (int p = 1; p < pieceCount; p++) {
+            int sx = ringX[pieces[p]], sy = ringY[pieces[p]];
+            if (ZoneFind(layer, g_zones[layer][sy][sx]) != old) continue;
+            int fresh = ZoneAllocate(layer);
+            if (fresh == 0) {
+                RelabelZones();
+                return;
+            }
+            ZoneSpan(layer, sx, sy, fresh);
+            int fx = ringX[pieces[0]], fy = ringY[pieces[0]];
+            if (g_zones[layer][fy][fx] == fresh) break;
+        }
+    }
+}
+
+int Map_GetZone(int cellX, int cellY, BOOL naval) {
+    if (cellX < 0 || cellX >= g_mapWidth || cellY < 0 || cellY >= g_mapHeight) {
+        return 0;
+    }
+    if (g_zoneRevision != g_terrainRevision) RelabelZones();
+    int layer = naval ? 1 : 0;
+    int raw = g_zones[layer][cellY][cellX];
+    return raw ? ZoneFind(layer, raw) : 0;
+}
+
 BOOL Map_IsPassable(int cellX, int cellY) {
     MapCell* cell = Map_GetCell(cellX, cellY);
     if (!cell) return FALSE;
@@ -644,30 +1015,245 @@ void Map_Update(void) {
 
 //===========================================================================
 // Fog of War Functions
+//
+// Visibility is reference counted per cell. Each player unit/building is a
+// viewer that adds one reference to every cell in its sight circle, and
+// only touches the cells entering/leaving the circle when it steps to an
+// adjacent cell. A cell is VISIBLE while it has references; REVEALED is
+// sticky. One-shot reveals (RevealAround/RevealArea/RevealAll) are not
+// counted and last until the next Map_UpdateVisibility().
 //===========================================================================
 
-void Map_ClearVisibility(void) {
-    if (!g_fogEnabled) return;
+// Per-cell viewer reference counts
+static uint16_t g_visRefs[MAP_MAX_HEIGHT][MAP_MAX_WIDTH];
+
+// Cells holding a one-shot reveal
+static uint16_t g_visPulse[MAP_MAX_WIDTH * MAP_MAX_HEIGHT];
+static int g_visPulseCount = 0;
+
+// Cells whose fog flags changed since the consumer last cleared the list.
+// Membership is kept here rather than in the cell flags, which are game
+// state (saved and hashed) while this only tracks what was drawn.
+static uint16_t g_fogChanged[MAP_MAX_WIDTH * MAP_MAX_HEIGHT];
+static int g_fogChangedCount = 0;
+static uint8_t g_fogQueued[MAP_MAX_HEIGHT][MAP_MAX_WIDTH];
+
+// Sight circle offsets per radius, plus the cells gained/lost when the
+// center steps one cell in each of the 8 directions
+struct SightOffset {
+    int8_t dx;
+    int8_t dy;
+};
+
+struct SightTable {
+    bool built;
+    int circleCount;
+    SightOffset circle[(2 * MAP_SIGHT_MAX + 1) * (2 * MAP_SIGHT_MAX + 1)];
+    int enterCount[9];
+    int leaveCount[9];
+    SightOffset enter[9][4 * MAP_SIGHT_MAX + 2];   // Relative to new center
+    SightOffset leave[9][4 * MAP_SIGHT_MAX + 2];   // Relative to old center
+};
+
+static SightTable g_sightTables[MAP_SIGHT_MAX + 1];
+
+static bool InSight(int dx, int dy, int range) {
+    return dx * dx + dy * dy <= range * range;
+}
+
+static const SightTable* GetSightTable(int range) {
+    SightTable* table = &g_sightTables[range];
+    if (table->built) return table;
+
+    table->circleCount = 0;
+    for (int dy = -range; dy <= range; dy++) {
+        for (int dx = -range; dx <= range; dx++) {
+            if (!InSight(dx, dy, range)) continue;
+            table->circle[table->circleCount++] = {(int8_t)dx, (int8_t)dy};
+        }
+    }
+
+    // Step direction index = (sy + 1) * 3 + (sx + 1); index 4 is no move
+    for (int dir = 0; dir < 9; dir++) {
+        int sx = dir % 3 - 1;
+        int sy = dir / 3 - 1;
+        table->enterCount[dir] = 0;
+        table->leaveCount[dir] = 0;
+        if (dir == 4) continue;
+
+        for (int i = 0; i < table->circleCount; i++) {
+            int dx = table->circle[i].dx;
+            int dy = table->circle[i].dy;
+            // In the new circle but not the old one
+            if (!InSight(dx + sx, dy + sy, range)) {
+                table->enter[dir][table->enterCount[dir]++] = table->circle[i];
+            }
+            // In the old circle but not the new one
+            if (!InSight(dx - sx, dy - sy, range)) {
+                table->leave[dir][table->leaveCount[dir]++] = table->circle[i];
+            }
+        }
+    }
+
+    table->built = true;
+    return table;
+}
+
+// Record a fog flag change for the renderer/radar
+static void MarkFogChanged(int x, int y) {
+    TouchCell(x, y);
+    if (g_fogQueued[y][x]) return;
+    g_fogQueued[y][x] = 1;
+    g_fogChanged[g_fogChangedCount++] = (uint16_t)(y * MAP_MAX_WIDTH + x);
+}
+
+static void SetFogFlags(int x, int y, uint8_t bits) {
+    MapCell* cell = &g_cells[y][x];
+    if ((cell->flags & bits) == bits) return;
+    cell->flags |= bits;
+    MarkFogChanged(x, y);
+}
+
+static void ClearVisibleFlag(int x, int y) {
+    MapCell* cell = &g_cells[y][x];
+    if (!(cell->flags & CELL_FLAG_VISIBLE)) return;
+    cell->flags &= ~CELL_FLAG_VISIBLE;
+    MarkFogChanged(x, y);
+}
+
+// Cell stays visible while viewed, pulsed, or fog is off
+static bool KeepsVisible(int x, int y) {
+    return !g_fogEnabled || g_visRefs[y][x] > 0 ||
+           (g_cells[y][x].flags & CELL_FLAG_VIS_PULSE);
+}
+
+static void AddVisRef(int x, int y) {
+    if (x < 0 || x >= g_mapWidth || y < 0 || y >= g_mapHeight) return;
+    if (g_visRefs[y][x]++ == 0) {
+        SetFogFlags(x, y, CELL_FLAG_REVEALED | CELL_FLAG_VISIBLE);
+    }
+}
+
+static void ReleaseVisRef(int x, int y) {
+    if (x < 0 || x >= g_mapWidth || y < 0 || y >= g_mapHeight) return;
+    if (g_visRefs[y][x] == 0) return;  // Map was recreated under the viewer
+    if (--g_visRefs[y][x] == 0 && !KeepsVisible(x, y)) {
+        ClearVisibleFlag(x, y);
+    }
+}
+
+// One-shot reveal that expires at the next Map_UpdateVisibility()
+static void PulseCell(int x, int y) {
+    SetFogFlags(x, y, CELL_FLAG_REVEALED | CELL_FLAG_VISIBLE);
+    MapCell* cell = &g_cells[y][x];
+    if (cell->flags & CELL_FLAG_VIS_PULSE) return;
+    cell->flags |= CELL_FLAG_VIS_PULSE;
+    TouchCell(x, y);
+    g_visPulse[g_visPulseCount++] = (uint16_t)(y * MAP_MAX_WIDTH + x);
+}
 
-    // Clear VISIBLE flag on all cells (REVEALED stays set)
+static void RevealWholeMap(void) {
     for (int y = 0; y < g_mapHeight; y++) {
         for (int x = 0; x < g_mapWidth; x++) {
-            g_cells[y][x].flags &= ~CELL_FLAG_VISIBLE;
+            SetFogFlags(x, y, CELL_FLAG_REVEALED | CELL_FLAG_VISIBLE);
         }
     }
 }
 
+static void ResetFogState(void) {
+    memset(g_visRefs, 0, sizeof(g_visRefs));
+    g_visPulseCount = 0;
+    memset(g_fogQueued, 0, sizeof(g_fogQueued));
+    g_fogChangedCount = 0;
+}
+
+static void ApplyViewer(int cellX, int cellY, int sightRange, bool add) {
+    if (sightRange < 0) return;
+    if (sightRange > MAP_SIGHT_MAX) sightRange = MAP_SIGHT_MAX;
+
+    const SightTable* table = GetSightTable(sightRange);
+    for (int i = 0; i < table->circleCount; i++) {
+        int x = cellX + table->circle[i].dx;
+        int y = cellY + table->circle[i].dy;
+        if (add) {
+            AddVisRef(x, y);
+        } else {
+            ReleaseVisRef(x, y);
+        }
+    }
+}
+
+void Map_AddViewer(int cellX, int cellY, int sightRange) {
+    // With fog off, any player sight reveals the whole map
+    if (!g_fogEnabled) RevealWholeMap();
+    ApplyViewer(cellX, cellY, sightRange, true);
+}
+
+void Map_RemoveViewer(int cellX, int cellY, int sightRange) {
+    ApplyViewer(cellX, cellY, sightRange, false);
+}
+
+void Map_MoveViewer(int oldCellX, int oldCellY, int newCellX, int newCellY,
+                    int sightRange) {
+    int sx = newCellX - oldCellX;
+    int sy = newCellY - oldCellY;
+    if (sx == 0 && sy == 0) return;
+
+    // Long jumps (or oversized ranges) fall back to a full re-stamp
+    if (sx < -1 || sx > 1 || sy < -1 || sy > 1 ||
+        sightRange < 0 || sightRange > MAP_SIGHT_MAX) {
+        ApplyViewer(newCellX, newCellY, sightRange, true);
+        ApplyViewer(oldCellX, oldCellY, sightRange, false);
+        return;
+    }
+
+    const SightTable* table = GetSightTable(sightRange);
+    int dir = (sy + 1) * 3 + (sx + 1);
+
+    // Add before release so cells staying in view never drop to zero
+    for (int i = 0; i < table->enterCount[dir]; i++) {
+        AddVisRef(newCellX + table->enter[dir][i].dx,
+                  newCellY + table->enter[dir][i].dy);
+    }
+    for (int i = 0; i < table->leaveCount[dir]; i++) {
+        ReleaseVisRef(oldCellX + table->leave[dir][i].dx,
+                      oldCellY + table->leave[dir][i].dy);
+    }
+}
+
+void Map_UpdateVisibility(void) {
+    // Expire one-shot reveals from the previous tick
+    for (int i = 0; i < g_visPulseCount; i++) {
+        int x = g_visPulse[i] % MAP_MAX_WIDTH;
+        int y = g_visPulse[i] / MAP_MAX_WIDTH;
+        g_cells[y][x].flags &= ~CELL_FLAG_VIS_PULSE;
+        TouchCell(x, y);
+        if (!KeepsVisible(x, y)) ClearVisibleFlag(x, y);
+    }
+    g_visPulseCount = 0;
+}
+
+int Map_GetFogChanges(const uint16_t** cells) {
+    if (cells) *cells = g_fogChanged;
+    return g_fogChangedCount;
+}
+
+void Map_ClearFogChanges(void) {
+    for (int i = 0; i < g_fogChangedCount; i++) {
+        int x = g_fogChanged[i] % MAP_MAX_WIDTH;
+        int y = g_fogChanged[i] / MAP_MAX_WIDTH;
+        g_fogQueued[y][x] = 0;
+    }
+    g_fogChangedCount = 0;
+}
+
 void Map_RevealAround(int cellX, int cellY, int sightRange, int team) {
     // Only player team reveals fog
     if (team != 1) return;  // TEAM_PLAYER = 1
 
     // If fog disabled, just mark everything visible
     if (!g_fogEnabled) {
-        for (int y = 0; y < g_mapHeight; y++) {
-            for (int x = 0; x < g_mapWidth; x++) {
-                g_cells[y][x].flags |= CELL_FLAG_REVEALED | CELL_FLAG_VISIBLE;
-            }
-        }
+        RevealWholeMap();
         return;
     }
 
@@ -686,9 +1272,8 @@ void Map_RevealAround(int cellX, int cellY, int sightRange, int team) {
             // Circle check
             if (dx * dx + dy * dy > rangeSquared) continue;
 
-            // Mark as revealed and visible
-            uint8_t vis = CELL_FLAG_REVEALED | CELL_FLAG_VISIBLE;
-            g_cells[cy][cx].flags |= vis;
+            // Mark as revealed and visible until the next update
+            PulseCell(cx, cy);
         }
     }
 }
@@ -713,10 +1298,14 @@ void Map_SetFogEnabled(BOOL enabled) {
     g_fogEnabled = enabled;
     if (!enabled) {
         // When disabling fog, reveal entire map
-        for (int y = 0; y < g_mapHeight; y++) {
-            for (int x = 0; x < g_mapWidth; x++) {
-                g_cells[y][x].flags |= CELL_FLAG_REVEALED | CELL_FLAG_VISIBLE;
-            }
+        RevealWholeMap();
+        return;
+    }
+
+    // Re-enabling: only viewed/pulsed cells stay visible
+    for (int y = 0; y < g_mapHeight; y++) {
+        for (int x = 0; x < g_mapWidth; x++) {
+            if (!KeepsVisible(x, y)) ClearVisibleFlag(x, y);
         }
     }
 }
@@ -726,10 +1315,10 @@ BOOL Map_IsFogEnabled(void) {
 }
 
 void Map_RevealAll(void) {
-    // Reveal all cells permanently
+    // Reveal all cells (stays revealed; visible until the next update)
     for (int y = 0; y < g_mapHeight; y++) {
         for (int x = 0; x < g_mapWidth; x++) {
-            g_cells[y][x].flags |= (CELL_FLAG_VISIBLE | CELL_FLAG_REVEALED);
+            PulseCell(x, y);
         }
     }
 }
@@ -749,8 +1338,7 @@ void Map_RevealArea(int worldX, int worldY, int radius) {
             bool inBounds = tx >= 0 && tx < g_mapWidth &&
                             ty >= 0 && ty < g_mapHeight;
             if (inBounds) {
-                uint8_t vis = CELL_FLAG_VISIBLE | CELL_FLAG_REVEALED;
-                g_cells[ty][tx].flags |= vis;
+                PulseCell(tx, ty);
             }
         }
     }
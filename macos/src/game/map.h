@@ -37,18 +37,37 @@ typedef enum {
 #define CELL_FLAG_OCCUPIED      0x01    // Unit present
 #define CELL_FLAG_REVEALED      0x02    // Fog of war revealed
 #define CELL_FLAG_VISIBLE       0x04    // Currently visible
+#define CELL_FLAG_VIS_PULSE     0x08    // One-shot reveal until next update
+
+// Largest sight range tracked by the incremental fog tables (cells)
+#define MAP_SIGHT_MAX           16
 
 // Ore constants
 #define ORE_MAX_AMOUNT      255     // Maximum ore per cell
 
+// Cell occupant index (maintained by the unit system)
+// Each entry packs a unit id with its team and an infantry bit so
+// blocking/crush checks don't have to touch the unit table.
+#define MAP_CELL_OCCUPANTS      4       // Inline occupant slots per cell
+#define OCCUPANT_ID_MASK        0x03FF  // Unit id (bits 0-9)
+#define OCCUPANT_TEAM_SHIFT     10      // Team (bits 10-11)
+#define OCCUPANT_TEAM_MASK      0x03
+#define OCCUPANT_INFANTRY       0x1000  // Occupant is infantry (bit 12)
+
+#define OCCUPANT_ID(o)      ((int)((o) & OCCUPANT_ID_MASK))
+#define OCCUPANT_TEAM(o)    ((int)(((o) >> OCCUPANT_TEAM_SHIFT) & OCCUPANT_TEAM_MASK))
+
 // Map cell structure
 typedef struct {
     uint8_t terrain;        // TerrainType
     uint8_t flags;          // Cell flags
     uint8_t height;         // Elevation (0-3)
     uint8_t oreAmount;      // Ore amount (0-255)
-    int16_t unitId;         // Unit occupying cell (-1 if none)
+    int16_t unitId;         // First unit occupying cell (-1 if none)
     int16_t buildingId;     // Building on cell (-1 if none)
+    uint8_t occupantCount;  // Units in cell (may exceed MAP_CELL_OCCUPANTS)
+    uint8_t occupantStored; // Valid entries in occupants[]
+    uint16_t occupants[MAP_CELL_OCCUPANTS]; // Packed id/team/infantry
 } MapCell;
 
 // Viewport for scrolling
@@ -109,10 +128,67 @@ int Map_GetHeight(void);
 MapCell* Map_GetCell(int cellX, int cellY);
 
 /**
- * Set terrain at cell
+ * Get a whole row of cells, contiguous from x = 0 to width - 1
+ * @return Pointer to the row's first cell, or NULL if out of bounds
+ */
+MapCell* Map_GetRow(int cellY);
+
+/**
+ * Set terrain at cell. Changes that make the cell passable or impassable
+ * (for ground or naval units) are queued in the terrain change list.
  */
 void Map_SetTerrain(int cellX, int cellY, TerrainType terrain);
 
+/**
+ * Cells whose passability changed through Map_SetTerrain() since the last
+ * Map_ClearTerrainChanges(), for caches built over passability (the
+ * hierarchical pathfinder). Entries are y * MAP_MAX_WIDTH + x and may
+ * repeat.
+ * @return Number of entries in *cells, or -1 if the map was recreated or
+ *         the list overflowed: treat every cell as changed
+ */
+int Map_GetTerrainChanges(const uint16_t** cells);
+
+/**
+ * Empty the terrain change list once it has been consumed
+ */
+void Map_ClearTerrainChanges(void);
+
+/**
+ * Note that a cell's simulated state was written outside map.cpp
+ * (occupants, building id, ore), for Map_GetStateChanges()
+ */
+void Map_TouchCell(int cellX, int cellY);
+
+/**
+ * Cells whose terrain, ore, fog bits or occupants changed since the last
+ * Map_ClearStateChanges(), for the replay state hash. Entries are
+ * y * MAP_MAX_WIDTH + x, no duplicates.
+ * @return Number of entries in *cells, or -1 if the map was recreated:
+ *         treat every cell as changed
+ */
+int Map_GetStateChanges(const uint16_t** cells);
+
+/**
+ * Empty the state change list once it has been consumed
+ */
+void Map_ClearStateChanges(void);
+
+/**
+ * Counter bumped whenever any cell's ground or naval passability changes
+ * (including a new map), for caches that only need to know "anything"
+ */
+uint32_t Map_GetTerrainRevision(void);
+
+/**
+ * Connected region of a cell for ground or naval movement (8-way, as
+ * units move), 0 if the cell is blocked. Two cells with different
+ * non-zero zones can never reach each other. Map_SetTerrain() updates
+ * the labels around the edited cell; they are only recomputed in full on
+ * the first query after a new map.
+ */
+int Map_GetZone(int cellX, int cellY, BOOL naval);
+
 /**
  * Check if cell is passable for ground units
  */
@@ -179,12 +255,43 @@ void Map_Render(void);
 void Map_Update(void);
 
 /**
- * Fog of War: Clear all visibility flags (call each frame before revealing)
+ * Fog of War: Expire one-shot reveals from the previous tick
+ * (Map_RevealAround/RevealArea/RevealAll). Viewer visibility is kept
+ * up to date incrementally and is not touched.
+ */
+void Map_UpdateVisibility(void);
+
+/**
+ * Fog of War: Register a viewer's sight circle (adds one reference per cell)
+ * @param sightRange Sight range in cells (clamped to MAP_SIGHT_MAX)
+ */
+void Map_AddViewer(int cellX, int cellY, int sightRange);
+
+/**
+ * Fog of War: Release a viewer registered with Map_AddViewer
+ */
+void Map_RemoveViewer(int cellX, int cellY, int sightRange);
+
+/**
+ * Fog of War: Move a viewer; single-cell steps only touch the circle edge
+ */
+void Map_MoveViewer(int oldCellX, int oldCellY, int newCellX, int newCellY,
+                    int sightRange);
+
+/**
+ * Fog of War: Cells whose REVEALED/VISIBLE flags changed since the last
+ * Map_ClearFogChanges(). Entries are y * MAP_MAX_WIDTH + x, no duplicates.
+ * @return Number of entries in *cells
+ */
+int Map_GetFogChanges(const uint16_t** cells);
+
+/**
+ * Fog of War: Empty the change list once it has been consumed
  */
-void Map_ClearVisibility(void);
+void Map_ClearFogChanges(void);
 
 /**
- * Fog of War: Reveal cells around a point
+ * Fog of War: Reveal cells around a point until the next update
  * @param cellX      Center cell X
  * @param cellY      Center cell Y
  * @param sightRange Sight range in cells
@@ -6,6 +6,7 @@
 
 #include "mapclass.h"
 #include "object.h"
+#include "random.h"
 #include <cstring>
 #include <cstdlib>
 #include <algorithm>
@@ -111,6 +112,12 @@ MapClass::MapClass()
     , tiberiumSpreadCount_(0)
     , tiberiumScan_(0)
 {
+    for (int z = 0; z < static_cast<int>(MZoneType::COUNT); z++) {
+        for (int i = 0; i < 256; i++) {
+            zoneParent_[z][i] = static_cast<uint8_t>(i);
+        }
+        zoneNext_[z] = 1;
+    }
 }
 
 MapClass::~MapClass() {
@@ -135,6 +142,7 @@ void MapClass::InitClear() {
     tiberiumSpreadCount_ = 0;
     tiberiumGrowth_.clear();
     tiberiumSpread_.clear();
+    ZoneReset();
 }
 
 void MapClass::AllocCells() {
@@ -211,18 +219,25 @@ bool MapClass::InRadar(CELL cell) const {
 //===========================================================================
 
 CELL MapClass::PickRandomLocation() const {
-    int x = mapCellX_ + (rand() % mapCellWidth_);
-    int y = mapCellY_ + (rand() % mapCellHeight_);
+    int x = mapCellX_ + Random_Sim(mapCellWidth_);
+    int y = mapCellY_ + Random_Sim(mapCellHeight_);
     return XY_Cell(x, y);
 }
 
-CELL MapClass::NearbyLocation(CELL cell, SpeedType speed, int /*zone*/,
-                              MZoneType /*check*/) const {
-    // Find a passable cell near the given cell
+CELL MapClass::NearbyLocation(CELL cell, SpeedType speed, int zone,
+                              MZoneType check) const {
+    // Find a passable cell near the given cell, optionally restricted to
+    // one movement zone so the result is reachable from that zone
     if (!IsValidCell(cell)) return cell;
 
+    auto usable = [&](CELL c) {
+        const CellClass& cellRef = cells_[c];
+        if (!cellRef.IsPassable(speed) || cellRef.flag_.occupy.building) return false;
+        return zone < 0 || CellZone(c, check) == zone;
+    };
+
     // Check the cell itself first
-    if (cells_[cell].IsPassable(speed)) {
+    if (usable(cell)) {
         return cell;
     }
 
@@ -236,7 +251,7 @@ CELL MapClass::NearbyLocation(CELL cell, SpeedType speed, int /*zone*/,
 
         for (int i = start; i < count; i++) {
             CELL newCell = cell + offsets[i];
-            if (IsValidCell(newCell) && cells_[newCell].IsPassable(speed)) {
+            if (IsValidCell(newCell) && usable(newCell)) {
                 return newCell;
             }
         }
@@ -343,67 +358,264 @@ void MapClass::RevealTheMap() {
 // Zone Management
 //===========================================================================
 
-bool MapClass::ZoneReset(int /*method*/) {
-    // Reset all zone values
-    for (int i = 0; i < size_; i++) {
-        for (int z = 0; z < static_cast<int>(MZoneType::COUNT); z++) {
-            cells_[i].zones_[z] = 0;
-        }
+// Ring of neighbours in FacingType order (N, NE, E, ... NW)
+static const int ZONE_DX[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+static const int ZONE_DY[8] = { -1, -1, 0, 1, 1, 1, 0, -1 };
+
+static int RunFind(std::vector<int>& parent, int run) {
+    while (parent[run] != run) {
+        parent[run] = parent[parent[run]];
+        run = parent[run];
     }
-    return true;
+    return run;
 }
 
-bool MapClass::ZoneCell(CELL cell, int zone) {
-    if (!IsValidCell(cell)) return false;
+int MapClass::ZoneFind(int check, int zone) const {
+    while (zoneParent_[check][zone] != zone) {
+        zone = zoneParent_[check][zone];
+    }
+    return zone;
+}
+
+int MapClass::ZoneAllocate(int check) {
+    if (zoneNext_[check] >= ZONE_UNKNOWN) return 0;
+    int zone = zoneNext_[check]++;
+    zoneParent_[check][zone] = static_cast<uint8_t>(zone);
+    return zone;
+}
+
+bool MapClass::ZoneReset(int method) {
+    if (cells_.empty()) return false;
+
+    // Label horizontal runs of passable cells, joining each run with the
+    // runs it touches (diagonals included) in the row above; one pass
+    // then numbers the resulting sets in scan order.
+    std::vector<int> runParent;
+    std::vector<int> runLabel;
+    zoneRuns_.resize(size_);
 
-    // Set zone for all movement zone types
     for (int z = 0; z < static_cast<int>(MZoneType::COUNT); z++) {
-        cells_[cell].zones_[z] = static_cast<uint8_t>(zone);
+        if (!(method & (1 << z))) continue;
+        MZoneType check = static_cast<MZoneType>(z);
+
+        runParent.clear();
+        for (int y = 0; y < ySize_; y++) {
+            int* row = &zoneRuns_[y * xSize_];
+            int x = 0;
+            while (x < xSize_) {
+                if (!cells_[y * xSize_ + x].IsZonePassable(check)) {
+                    row[x++] = -1;
+                    continue;
+                }
+
+                int run = static_cast<int>(runParent.size());
+                runParent.push_back(run);
+                int start = x;
+                while (x < xSize_ && cells_[y * xSize_ + x].IsZonePassable(check)) {
+                    row[x++] = run;
+                }
+                if (y == 0) continue;
+
+                const int* above = row - xSize_;
+                int from = std::max(start - 1, 0);
+                int to = std::min(x, xSize_ - 1);
+                for (int ax = from; ax <= to; ax++) {
+                    if (above[ax] < 0) continue;
+                    int a = RunFind(runParent, above[ax]);
+                    int b = RunFind(runParent, run);
+                    if (a != b) runParent[std::max(a, b)] = std::min(a, b);
+                }
+            }
+        }
+
+        runLabel.assign(runParent.size(), 0);
+        int next = 1;
+        for (int i = 0; i < size_; i++) {
+            int run = zoneRuns_[i];
+            if (run < 0) {
+                cells_[i].zones_[z] = 0;
+                continue;
+            }
+            int root = RunFind(runParent, run);
+            if (runLabel[root] == 0) {
+                runLabel[root] = (next < ZONE_UNKNOWN) ? next++ : ZONE_UNKNOWN;
+            }
+            cells_[i].zones_[z] = static_cast<uint8_t>(runLabel[root]);
+        }
+
+        for (int i = 0; i < 256; i++) {
+            zoneParent_[z][i] = static_cast<uint8_t>(i);
+        }
+        zoneNext_[z] = next;
     }
     return true;
 }
 
-int MapClass::ZoneSpan(CELL cell, int zone, MZoneType check) {
-    if (!IsValidCell(cell)) return 0;
+bool MapClass::ZoneCell(CELL cell) {
+    if (!IsValidCell(cell) || cells_.empty()) return false;
 
-    // Flood fill zone assignment
-    // This is a simplified version - the original uses a more complex algorithm
-    int count = 0;
-    int zoneIdx = static_cast<int>(check);
+    int x = Cell_X(cell);
+    int y = Cell_Y(cell);
+    CELL ring[8];
+    for (int d = 0; d < 8; d++) {
+        int nx = x + ZONE_DX[d];
+        int ny = y + ZONE_DY[d];
+        bool inside = nx >= 0 && nx < xSize_ && ny >= 0 && ny < ySize_;
+        ring[d] = inside ? XY_Cell(nx, ny) : cell;
+    }
 
-    // Simple BFS flood fill
-    std::vector<CELL> queue;
-    queue.push_back(cell);
+    bool changed = false;
+    for (int z = 0; z < static_cast<int>(MZoneType::COUNT); z++) {
+        MZoneType check = static_cast<MZoneType>(z);
+        CellClass& c = cells_[cell];
+        bool passable = c.IsZonePassable(check);
+        if (passable == (c.zones_[z] != 0)) continue;
+        changed = true;
+
+        if (passable) {
+            // Opened: join every labelled neighbour's region
+            int zone = 0;
+            for (int d = 0; d < 8; d++) {
+                if (ring[d] == cell || cells_[ring[d]].zones_[z] == 0) continue;
+                int other = ZoneFind(z, cells_[ring[d]].zones_[z]);
+                if (zone == 0 || other == zone) {
+                    zone = other;
+                } else if (zone == ZONE_UNKNOWN || other == ZONE_UNKNOWN) {
+                    zoneParent_[z][zone] = ZONE_UNKNOWN;
+                    zoneParent_[z][other] = ZONE_UNKNOWN;
+                    zone = ZONE_UNKNOWN;
+                } else {
+                    zoneParent_[z][std::max(zone, other)] = static_cast<uint8_t>(std::min(zone, other));
+                    zone = std::min(zone, other);
+                }
+            }
+            if (zone == 0) zone = ZoneAllocate(z);
+            if (zone == 0) {
+                ZoneReset(1 << z);
+                continue;
+            }
+            c.zones_[z] = static_cast<uint8_t>(zone);
+            continue;
+        }
 
-    while (!queue.empty()) {
-        CELL current = queue.back();
-        queue.pop_back();
+        // Closed: the region can only split if the open neighbours fall
+        // into more than one group around the ring. Ring neighbours touch,
+        // and orthogonal neighbours touch diagonally across a closed corner.
+        int old = ZoneFind(z, c.zones_[z]);
+        c.zones_[z] = 0;
+        if (old == ZONE_UNKNOWN) continue;
+
+        bool open[8];
+        int group[8];
+        for (int d = 0; d < 8; d++) {
+            open[d] = ring[d] != cell && cells_[ring[d]].zones_[z] != 0;
+            group[d] = d;
+        }
+        auto join = [&group](int a, int b) {
+            while (group[a] != a) a = group[a];
+            while (group[b] != b) b = group[b];
+            if (a != b) group[std::max(a, b)] = std::min(a, b);
+        };
+        for (int d = 0; d < 8; d++) {
+            if (open[d] && open[(d + 1) & 7]) join(d, (d + 1) & 7);
+            if (!(d & 1) && open[d] && open[(d + 2) & 7]) join(d, (d + 2) & 7);
+        }
 
-        if (!IsValidCell(current)) continue;
-        if (cells_[current].zones_[zoneIdx] == zone) continue;
+        int pieces[8];
+        int pieceCount = 0;
+        for (int d = 0; d < 8; d++) {
+            if (!open[d]) continue;
+            int root = d;
+            while (group[root] != root) root = group[root];
+            if (root == d) pieces[pieceCount++] = d;
+        }
 
-        // Check passability based on zone type
-        SpeedType speed = SpeedType::TRACK;
-        if (check == MZoneType::WATER) speed = SpeedType::FLOAT;
+        // Refill every group but the first with a fresh label. A fill that
+        // reaches the first group means the region is still whole.
+        for (int p = 1; p < pieceCount; p++) {
+            CELL seed = ring[pieces[p]];
+            if (ZoneFind(z, cells_[seed].zones_[z]) != old) continue;
+            int fresh = ZoneAllocate(z);
+            if (fresh == 0) {
+                ZoneReset(1 << z);
+                break;
+            }
+            ZoneSpan(seed, fresh, check);
+            if (cells_[ring[pieces[0]]].zones_[z] == fresh) break;
+        }
+    }
+    return changed;
+}
 
-        if (!cells_[current].IsPassable(speed)) continue;
+int MapClass::ZoneSpan(CELL cell, int zone, MZoneType check) {
+    if (!IsValidCell(cell) || cells_.empty()) return 0;
 
-        cells_[current].zones_[zoneIdx] = static_cast<uint8_t>(zone);
-        count++;
+    int z = static_cast<int>(check);
+    uint8_t label = static_cast<uint8_t>(zone);
+    auto fillable = [&](int x, int y) {
+        const CellClass& c = cells_[y * xSize_ + x];
+        return c.zones_[z] != label && c.IsZonePassable(check);
+    };
 
-        // Add adjacent cells
-        for (int dir = 0; dir < 8; dir++) {
-            FacingType face = static_cast<FacingType>(dir);
-            CELL adj = cells_[current].AdjacentCell(face);
-            if (adj != current) {
-                queue.push_back(adj);
+    int count = 0;
+    zoneSeeds_.clear();
+    zoneSeeds_.push_back(cell);
+
+    while (!zoneSeeds_.empty()) {
+        CELL seed = zoneSeeds_.back();
+        zoneSeeds_.pop_back();
+
+        int y = Cell_Y(seed);
+        int left = Cell_X(seed);
+        if (!fillable(left, y)) continue;
+
+        // Fill the whole horizontal span through the seed
+        int right = left;
+        while (left > 0 && fillable(left - 1, y)) left--;
+        while (right < xSize_ - 1 && fillable(right + 1, y)) right++;
+        for (int x = left; x <= right; x++) {
+            cells_[y * xSize_ + x].zones_[z] = label;
+        }
+        count += right - left + 1;
+
+        // Seed each span touching it above and below, diagonals included
+        int from = std::max(left - 1, 0);
+        int to = std::min(right + 1, xSize_ - 1);
+        for (int ny = y - 1; ny <= y + 1; ny += 2) {
+            if (ny < 0 || ny >= ySize_) continue;
+            bool inSpan = false;
+            for (int x = from; x <= to; x++) {
+                bool open = fillable(x, ny);
+                if (open && !inSpan) zoneSeeds_.push_back(XY_Cell(x, ny));
+                inSpan = open;
             }
         }
     }
-
     return count;
 }
 
+int MapClass::CellZone(CELL cell, MZoneType check) const {
+    if (!IsValidCell(cell) || cells_.empty()) return 0;
+    int z = static_cast<int>(check);
+    int raw = cells_[cell].zones_[z];
+    return raw ? ZoneFind(z, raw) : 0;
+}
+
+bool MapClass::ZonesConnected(CELL from, CELL to, MZoneType check) const {
+    int a = CellZone(from, check);
+    int b = CellZone(to, check);
+    if (a == 0 || b == 0 || a == ZONE_UNKNOWN || b == ZONE_UNKNOWN) return true;
+    return a == b;
+}
+
+MZoneType MapClass::SpeedZone(SpeedType speed) {
+    switch (speed) {
+        case SpeedType::FOOT:  return MZoneType::DESTROYER;   // Walks over walls
+        case SpeedType::FLOAT: return MZoneType::WATER;
+        default:               return MZoneType::NORMAL;
+    }
+}
+
 //===========================================================================
 // Ore/Tiberium Management
 //===========================================================================
@@ -420,14 +632,14 @@ void MapClass::Logic() {
 
             // Check for ore growth
             if (c.CanOreGrow()) {
-                if ((rand() % 256) < 4) {  // ~1.5% chance per scan
+                if (Random_Sim(256) < 4) {  // ~1.5% chance per scan
                     c.GrowOre();
                 }
             }
 
             // Check for ore spread
             if (c.CanOreSpread()) {
-                if ((rand() % 256) < 2) {  // ~0.8% chance per scan
+                if (Random_Sim(256) < 2) {  // ~0.8% chance per scan
                     // Find adjacent empty cell to spread to
                     for (int dir = 0; dir < 8; dir++) {
                         CELL adj = c.AdjacentCell(static_cast<FacingType>(dir));
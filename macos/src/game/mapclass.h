@@ -93,10 +93,31 @@ public:
     // Zone Management
     //-----------------------------------------------------------------------
 
-    bool ZoneReset(int method);
-    bool ZoneCell(CELL cell, int zone);
+    // Cells are labelled per MZoneType with the 8-connected region they
+    // belong to (0 = blocked). Labels are merged through a small
+    // union-find, so joining two regions never touches their cells.
+    static constexpr int ZONE_METHOD_ALL = (1 << static_cast<int>(MZoneType::COUNT)) - 1;
+    static constexpr int ZONE_UNKNOWN = 255;   // Labels ran out; never rejects
+
+    // Relabel from scratch; method is a mask of (1 << MZoneType) bits
+    bool ZoneReset(int method = ZONE_METHOD_ALL);
+
+    // Update labels after one cell's passability changed (wall built or
+    // destroyed, building placed or removed). Returns true if any changed.
+    bool ZoneCell(CELL cell);
+
+    // Scanline flood fill of the region around cell with the given label
     int ZoneSpan(CELL cell, int zone, MZoneType check);
 
+    // Region label of a cell, 0 if blocked, ZONE_UNKNOWN if untracked
+    int CellZone(CELL cell, MZoneType check) const;
+
+    // False only when both cells are labelled and in different regions
+    bool ZonesConnected(CELL from, CELL to, MZoneType check) const;
+
+    // Zone layer a movement type is bounded by
+    static MZoneType SpeedZone(SpeedType speed);
+
     //-----------------------------------------------------------------------
     // Ore/Tiberium Management
     //-----------------------------------------------------------------------
@@ -156,6 +177,21 @@ private:
     // Current scan position for incremental processing
     CELL tiberiumScan_;
 
+    //-----------------------------------------------------------------------
+    // Movement Zones
+    //-----------------------------------------------------------------------
+
+    int ZoneFind(int check, int zone) const;
+    int ZoneAllocate(int check);
+
+    // Union-find parent per raw label, and the next unused label
+    uint8_t zoneParent_[static_cast<int>(MZoneType::COUNT)][256];
+    int zoneNext_[static_cast<int>(MZoneType::COUNT)];
+
+    // Scratch for ZoneReset (run label per cell) and ZoneSpan (seed stack)
+    std::vector<int> zoneRuns_;
+    std::vector<CELL> zoneSeeds_;
+
     //-----------------------------------------------------------------------
     // Static Radius Data
     //-----------------------------------------------------------------------
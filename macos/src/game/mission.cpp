@@ -8,11 +8,13 @@
 #include "units.h"
 #include "ai.h"
 #include "terrain.h"
+#include "sprites.h"
 #include "../assets/lcw.h"
 #include "../assets/assetloader.h"
 #include <cstring>
 #include <cstdlib>
 #include <cstdio>
+#include <cctype>
 
 // Forward declaration for house production control
 // (Can't include house.h due to type conflicts with units.h/mission.h)
@@ -50,6 +52,11 @@ struct ParsedTrigger {
     bool wasAttacked;   // Object with this trigger was attacked
     bool wasDestroyed;  // Object with this trigger was destroyed
     bool wasEvacuated;  // Civilian was evacuated
+
+    // Cached condition results, valid until one of their inputs changes
+    bool event1Fired;
+    bool event2Fired;
+    int fireCount;
 };
 
 #define MAX_PARSED_TRIGGERS 80
@@ -96,23 +103,231 @@ extern bool VQA_Play(const char* filename);
 extern void AI_SellAllBuildings(int houseIndex);
 
 // ============================================================================
-// Trigger Event Notification Functions
-// Called by objects when trigger-related events occur
+// Trigger Name Index
 // ============================================================================
 
+// Open-addressed, case-insensitive hash of trigger names (index + 1, 0=empty)
+#define TRIGGER_NAME_BUCKETS 256
+static_assert((TRIGGER_NAME_BUCKETS & (TRIGGER_NAME_BUCKETS - 1)) == 0,
+              "TRIGGER_NAME_BUCKETS must be a power of two");
+static_assert(TRIGGER_NAME_BUCKETS >= MAX_PARSED_TRIGGERS * 2,
+              "Trigger name index too small");
+static int16_t g_triggerNameIndex[TRIGGER_NAME_BUCKETS];
+
+static uint32_t HashTriggerName(const char* name) {
+    uint32_t hash = 2166136261u;  // FNV-1a over lowercased characters
+    for (; *name; name++) {
+        hash ^= (uint8_t)tolower((unsigned char)*name);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Rebuild after g_parsedTriggers changes; the first of duplicate names wins
+static void BuildTriggerNameIndex(void) {
+    memset(g_triggerNameIndex, 0, sizeof(g_triggerNameIndex));
+    for (int i = 0; i < g_parsedTriggerCount; i++) {
+        const char* name = g_parsedTriggers[i].name;
+        uint32_t slot = HashTriggerName(name) & (TRIGGER_NAME_BUCKETS - 1);
+        while (g_triggerNameIndex[slot] != 0) {
+            int other = g_triggerNameIndex[slot] - 1;
+            if (strcasecmp(g_parsedTriggers[other].name, name) == 0) break;
+            slot = (slot + 1) & (TRIGGER_NAME_BUCKETS - 1);
+        }
+        if (g_triggerNameIndex[slot] == 0) {
+            g_triggerNameIndex[slot] = (int16_t)(i + 1);
+        }
+    }
+}
+
 /**
  * Find a trigger by name and return its index, or -1 if not found
  */
 static int FindTriggerByName(const char* name) {
     if (!name || name[0] == '\0') return -1;
-    for (int i = 0; i < g_parsedTriggerCount; i++) {
-        if (strcasecmp(g_parsedTriggers[i].name, name) == 0) {
-            return i;
+    uint32_t slot = HashTriggerName(name) & (TRIGGER_NAME_BUCKETS - 1);
+    while (g_triggerNameIndex[slot] != 0) {
+        int idx = g_triggerNameIndex[slot] - 1;
+        if (strcasecmp(g_parsedTriggers[idx].name, name) == 0) {
+            return idx;
         }
+        slot = (slot + 1) & (TRIGGER_NAME_BUCKETS - 1);
     }
     return -1;
 }
 
+// ============================================================================
+// Trigger Wake State
+//
+// Triggers are not re-evaluated every frame. Each condition subscribes to
+// the sources that can change its outcome and keeps its last result until
+// one of them is posted. Mission_ProcessTriggers only visits a trigger
+// while it is dirty, has a condition that has to be polled, or fired the
+// last time it was checked (persistent triggers keep firing).
+// ============================================================================
+
+// Bitset over g_parsedTriggers indices
+#define TRIGGER_SET_WORDS ((MAX_PARSED_TRIGGERS + 63) / 64)
+struct TriggerSet {
+    uint64_t bits[TRIGGER_SET_WORDS];
+};
+
+static inline void TriggerSet_Add(TriggerSet* set, int index) {
+    set->bits[index >> 6] |= 1ull << (index & 63);
+}
+
+static inline void TriggerSet_Remove(TriggerSet* set, int index) {
+    set->bits[index >> 6] &= ~(1ull << (index & 63));
+}
+
+static inline bool TriggerSet_Has(const TriggerSet* set, int index) {
+    return (set->bits[index >> 6] >> (index & 63)) & 1;
+}
+
+static inline void TriggerSet_Merge(TriggerSet* dst, const TriggerSet* src) {
+    for (int w = 0; w < TRIGGER_SET_WORDS; w++) dst->bits[w] |= src->bits[w];
+}
+
+// What can change a trigger condition's outcome
+enum WakeSource {
+    WAKE_UNITS,         // Unit spawned or removed (team unit counts)
+    WAKE_BUILDINGS,     // Building built or destroyed
+    WAKE_CELLS,         // Player unit moved near a watched cell
+    WAKE_CREDITS,       // Player credits changed
+    WAKE_TIMER,         // Mission timer started, stopped or ran out
+    WAKE_GLOBALS,       // Global flag set or cleared
+    WAKE_SOURCE_COUNT,
+    WAKE_SELF = WAKE_SOURCE_COUNT,  // Attacked/destroyed/evacuated flag
+    WAKE_POLL                       // Cheap or self-clearing; every frame
+};
+
+static TriggerSet g_wakeSubscribers[WAKE_SOURCE_COUNT];
+static TriggerSet g_triggersDirty;   // Cached results are stale
+static TriggerSet g_triggersPolled;  // Have a WAKE_POLL condition
+static TriggerSet g_triggersArmed;   // Fired when last checked
+
+// Cell watches for ENTERED/ZONE_ENT: world cell -> triggers watching it.
+// Units outside the watch grid wake every cell watcher.
+#define MAX_CELL_WATCHES 4096
+#define CELL_WATCH_OFFGRID MAP_CELL_TOTAL
+static uint16_t g_cellWatchSlot[MAP_CELL_TOTAL];    // g_cellWatches index + 1
+static TriggerSet g_cellWatches[MAX_CELL_WATCHES];
+static int g_cellWatchCount = 0;
+
+// Watch cell of each live player unit (-1 = not tracked)
+static int16_t g_unitWatchCell[MAX_UNITS];
+
+// Mission the subscriptions were built for (nullptr = rebuild)
+static const MissionData* g_subscribedMission = nullptr;
+static bool g_triggerPolling = false;
+static int g_triggerEvaluations = 0;
+
+static void WakeSubscribers(WakeSource source) {
+    TriggerSet_Merge(&g_triggersDirty, &g_wakeSubscribers[source]);
+}
+
+static void WakeCell(int cell) {
+    if (cell == CELL_WATCH_OFFGRID) {
+        WakeSubscribers(WAKE_CELLS);
+        return;
+    }
+    int slot = g_cellWatchSlot[cell];
+    if (slot != 0) {
+        TriggerSet_Merge(&g_triggersDirty, &g_cellWatches[slot - 1]);
+    }
+}
+
+static int WatchCellOf(int worldX, int worldY) {
+    if (worldX < 0 || worldY < 0) return CELL_WATCH_OFFGRID;
+    int cellX = worldX / CELL_SIZE;
+    int cellY = worldY / CELL_SIZE;
+    if (cellX >= MAP_CELL_W || cellY >= MAP_CELL_H) return CELL_WATCH_OFFGRID;
+    return cellY * MAP_CELL_W + cellX;
+}
+
+// Follow a unit between watch cells, waking watchers of both
+static void TrackUnitCell(int unitId, bool onMap) {
+    if (unitId < 0 || unitId >= MAX_UNITS) return;
+
+    int cell = -1;
+    if (onMap) {
+        const Unit* unit = Units_Get(unitId);
+        if (unit && unit->team == TEAM_PLAYER && unit->state != STATE_DYING) {
+            cell = WatchCellOf(unit->worldX, unit->worldY);
+        }
+    }
+
+    // The old cell is woken even when unchanged: radius checks are exact
+    // to the pixel, so moving within a cell can enter or leave a zone
+    int oldCell = g_unitWatchCell[unitId];
+    if (oldCell >= 0) WakeCell(oldCell);
+    if (cell >= 0 && cell != oldCell) WakeCell(cell);
+    g_unitWatchCell[unitId] = (int16_t)cell;
+}
+
+static void MarkTriggerDirty(int idx) {
+    if (idx >= 0) TriggerSet_Add(&g_triggersDirty, idx);
+}
+
+static void SetGlobalFlag(int flag, bool value) {
+    g_globalFlags[flag] = value;
+    WakeSubscribers(WAKE_GLOBALS);
+}
+
+void Mission_PostEvent(MissionEvent event, int param) {
+    switch (event) {
+        case MISSION_EVENT_UNIT_SPAWNED:
+            WakeSubscribers(WAKE_UNITS);
+            TrackUnitCell(param, true);
+            break;
+        case MISSION_EVENT_UNIT_MOVED:
+            TrackUnitCell(param, true);
+            break;
+        case MISSION_EVENT_UNIT_DIED:
+            WakeSubscribers(WAKE_UNITS);
+            TrackUnitCell(param, false);
+            break;
+        case MISSION_EVENT_BUILDING_BUILT:
+        case MISSION_EVENT_BUILDING_DESTROYED:
+            WakeSubscribers(WAKE_BUILDINGS);
+            break;
+        case MISSION_EVENT_CREDITS_CHANGED:
+            WakeSubscribers(WAKE_CREDITS);
+            break;
+        case MISSION_EVENT_TIMER_EXPIRED:
+            WakeSubscribers(WAKE_TIMER);
+            break;
+        default:
+            break;
+    }
+}
+
+void Mission_SetTriggerPolling(int enabled) {
+    g_triggerPolling = enabled != 0;
+}
+
+void Mission_ResetTriggerCache(void) {
+    for (int i = 0; i < g_parsedTriggerCount; i++) {
+        g_parsedTriggers[i].event1Fired = false;
+        g_parsedTriggers[i].event2Fired = false;
+    }
+    g_subscribedMission = nullptr;
+}
+
+int Mission_GetTriggerEvaluations(void) {
+    return g_triggerEvaluations;
+}
+
+int Mission_GetTriggerFireCount(const char* triggerName) {
+    int idx = FindTriggerByName(triggerName);
+    return idx >= 0 ? g_parsedTriggers[idx].fireCount : 0;
+}
+
+// ============================================================================
+// Trigger Event Notification Functions
+// Called by objects when trigger-related events occur
+// ============================================================================
+
 /**
  * Notify that an object with the given trigger was attacked
  * Called from TechnoClass::TakeDamage when object takes damage
@@ -121,6 +336,7 @@ void Mission_TriggerAttacked(const char* triggerName) {
     int idx = FindTriggerByName(triggerName);
     if (idx >= 0) {
         g_parsedTriggers[idx].wasAttacked = true;
+        MarkTriggerDirty(idx);
     }
 }
 
@@ -132,6 +348,7 @@ void Mission_TriggerDestroyed(const char* triggerName) {
     int idx = FindTriggerByName(triggerName);
     if (idx >= 0) {
         g_parsedTriggers[idx].wasDestroyed = true;
+        MarkTriggerDirty(idx);
     }
 }
 
@@ -143,6 +360,7 @@ void Mission_TriggerEvacuated(const char* triggerName) {
     int idx = FindTriggerByName(triggerName);
     if (idx >= 0) {
         g_parsedTriggers[idx].wasEvacuated = true;
+        MarkTriggerDirty(idx);
     }
 }
 
@@ -161,6 +379,9 @@ int Mission_GetTimerValue(void) {
 void Mission_UpdateTimer(void) {
     if (g_missionTimerActive && g_missionTimerValue > 0) {
         g_missionTimerValue--;
+        if (g_missionTimerValue == 0) {
+            Mission_PostEvent(MISSION_EVENT_TIMER_EXPIRED, 0);
+        }
     }
 }
 
@@ -168,6 +389,7 @@ void Mission_ResetTimer(void) {
     g_missionTimerActive = false;
     g_missionTimerValue = 0;
     g_missionTimerInitial = 0;
+    WakeSubscribers(WAKE_TIMER);
 }
 
 // ============================================================================
@@ -834,6 +1056,10 @@ static void ParseTrigsSection(INIClass* ini) {
             g_parsedTriggerCount++;
         }
     }
+
+    BuildTriggerNameIndex();
+    g_subscribedMission = nullptr;
+    g_triggerEvaluations = 0;
 }
 
 // Parse [Waypoints] section
@@ -1404,6 +1630,46 @@ static void SetupTheater(const MissionData* mission) {
             theater == THEATER_INTERIOR ? "INTERIOR" : "DESERT");
 }
 
+// Helper: Load the sprites and templates the scenario uses up front, so
+// the first frames don't stall decoding them; anything else (e.g. types
+// built later) still loads on first draw
+static void PrefetchMissionAssets(const MissionData* mission) {
+    UnitType units[MAX_MISSION_UNITS + MAX_TEAM_TYPES * MAX_TEAM_MEMBERS];
+    BuildingType buildings[MAX_MISSION_BUILDINGS];
+    int unitCount = 0;
+    int buildingCount = 0;
+
+    for (int i = 0; i < mission->unitCount; i++) {
+        units[unitCount++] = mission->units[i].type;
+    }
+    for (int i = 0; i < mission->teamTypeCount; i++) {
+        const MissionTeamType* team = &mission->teamTypes[i];
+        for (int m = 0; m < team->memberCount; m++) {
+            units[unitCount++] = ParseUnitType(team->members[m].unitType);
+        }
+    }
+    for (int i = 0; i < mission->buildingCount; i++) {
+        buildings[buildingCount++] = mission->buildings[i].type;
+    }
+    Sprites_Prefetch(units, unitCount, buildings, buildingCount);
+
+    // Only the playable area of the template map is drawn
+    if (mission->terrainType && mission->mapWidth > 0 && mission->mapHeight > 0) {
+        static uint8_t visible[MAP_CELL_TOTAL];
+        int count = 0;
+        for (int y = 0; y < mission->mapHeight; y++) {
+            int cellY = mission->mapY + y;
+            if (cellY < 0 || cellY >= MAP_CELL_H) continue;
+            for (int x = 0; x < mission->mapWidth; x++) {
+                int cellX = mission->mapX + x;
+                if (cellX < 0 || cellX >= MAP_CELL_W) continue;
+                visible[count++] = mission->terrainType[cellY * MAP_CELL_W + cellX];
+            }
+        }
+        Terrain_PrefetchTemplates(visible, count);
+    }
+}
+
 // Helper: Load terrain data or generate demo map
 static void LoadMissionMap(const MissionData* mission) {
     if (mission->terrainType && mission->terrainIcon) {
@@ -1556,35 +1822,6 @@ static void LogMissionData(const MissionData* mission) {
                 mission->smudgeCount);
 }
 
-// Initialize fog of war based on player unit/building positions
-// This must be called AFTER units/buildings are spawned, before first render
-static void InitializeFogOfWar(void) {
-    // At this point, all cells have flags=0 from Map_Create()
-    // We only need to reveal around player units/buildings
-
-    // Reveal around player units
-    for (int i = 0; i < MAX_UNITS; i++) {
-        Unit* unit = Units_Get(i);
-        if (!unit || !unit->active) continue;
-        if (unit->team != TEAM_PLAYER) continue;
-
-        int cellX, cellY;
-        Map_WorldToCell(unit->worldX, unit->worldY, &cellX, &cellY);
-        Map_RevealAround(cellX, cellY, unit->sightRange, TEAM_PLAYER);
-    }
-
-    // Reveal around player buildings
-    for (int i = 0; i < MAX_BUILDINGS; i++) {
-        Building* bld = Buildings_Get(i);
-        if (!bld || !bld->active) continue;
-        if (bld->team != TEAM_PLAYER) continue;
-
-        int centerX = bld->cellX + bld->width / 2;
-        int centerY = bld->cellY + bld->height / 2;
-        Map_RevealAround(centerX, centerY, bld->sightRange, TEAM_PLAYER);
-    }
-}
-
 void Mission_Start(const MissionData* mission) {
     if (!mission) return;
 
@@ -1594,15 +1831,18 @@ void Mission_Start(const MissionData* mission) {
     }
 
     SetupTheater(mission);
+    PrefetchMissionAssets(mission);
     Map_Init();
     Units_Init();
     AI_Init();
     LoadMissionMap(mission);
     SpawnMissionBuildings(mission);
-    SpawnMissionUnits(mission);
-    InitializeFogOfWar();  // Initialize fog AFTER units/buildings are spawned
+    SpawnMissionUnits(mission);  // Player units/buildings reveal fog on spawn
     CenterOnPlayerStart(mission);
     LogMissionData(mission);
+
+    // Entities were replaced wholesale; resubscribe on the next process
+    Mission_ResetTriggerCache();
 }
 
 int Mission_CheckVictory(const MissionData* mission, int frameCount) {
@@ -1918,75 +2158,52 @@ static int CountBuildingsByHouse(int houseNum) {
     } else {
         team = TEAM_PLAYER;
     }
-
-    int count = 0;
-    for (int i = 0; i < MAX_BUILDINGS; i++) {
-        Building* bld = Buildings_Get(i);
-        if (bld && bld->team == team) {
-            count++;
-        }
-    }
-    return count;
+    return Buildings_CountByTeam(team);
 }
 
 // Helper: Get player power production
 static int Units_GetPlayerPower(void) {
-    int power = 0;
-    for (int i = 0; i < MAX_BUILDINGS; i++) {
-        Building* bld = Buildings_Get(i);
-        if (bld && bld->team == TEAM_PLAYER) {
-            // Power plants produce power
-            if (bld->type == BUILDING_POWER) {
-                power += 100;  // Basic power plant
-            } else if (bld->type == BUILDING_ADV_POWER) {
-                power += 200;  // Advanced power plant
-            }
-        }
+    // Power plants produce power
+    return Buildings_CountByTeamType(TEAM_PLAYER, BUILDING_POWER) * 100 +
+           Buildings_CountByTeamType(TEAM_PLAYER, BUILDING_ADV_POWER) * 200;
+}
+
+// Helper: Power drained by one building of a type
+static int BuildingPowerDrain(int buildingType) {
+    switch (buildingType) {
+        case BUILDING_POWER:
+        case BUILDING_ADV_POWER:
+            return 0;   // Power plants don't drain
+        case BUILDING_REFINERY:
+            return 40;
+        case BUILDING_FACTORY:
+            return 30;
+        case BUILDING_RADAR:
+            return 40;
+        case BUILDING_HELIPAD:
+            return 20;
+        default:
+            return 10;  // Base drain for other buildings
     }
-    return power;
 }
 
 // Helper: Get player power drain
 static int Units_GetPlayerDrain(void) {
     int drain = 0;
-    for (int i = 0; i < MAX_BUILDINGS; i++) {
-        Building* bld = Buildings_Get(i);
-        if (bld && bld->team == TEAM_PLAYER) {
-            // Each building drains some power
-            switch (bld->type) {
-                case BUILDING_POWER:
-                case BUILDING_ADV_POWER:
-                    drain += 0;  // Power plants don't drain
-                    break;
-                case BUILDING_REFINERY:
-                    drain += 40;
-                    break;
-                case BUILDING_FACTORY:
-                    drain += 30;
-                    break;
-                case BUILDING_RADAR:
-                    drain += 40;
-                    break;
-                case BUILDING_HELIPAD:
-                    drain += 20;
-                    break;
-                default:
-                    drain += 10;  // Base drain for other buildings
-                    break;
-            }
-        }
+    for (int type = 0; type < BUILDING_TYPE_COUNT; type++) {
+        int count = Buildings_CountByTeamType(TEAM_PLAYER, (BuildingType)type);
+        drain += count * BuildingPowerDrain(type);
     }
     return drain;
 }
 
 // Helper: Count buildings of a specific type
 static int Buildings_CountByType(int buildingType) {
+    if (buildingType < 0 || buildingType >= BUILDING_TYPE_COUNT) return 0;
     int count = 0;
-    for (int i = 0; i < MAX_BUILDINGS; i++) {
-        Building* bld = Buildings_Get(i);
-        if (bld && bld->type == buildingType) {
-            count++;
-        }
+    for (int team = 0; team < TEAM_COUNT; team++) {
+        count += Buildings_CountByTeamType((Team)team,
+                                           (BuildingType)buildingType);
     }
     return count;
 }
@@ -2196,7 +2413,7 @@ static void ExecuteTeamMission(const MissionTeamType* team,
         case TMISSION_SET_GLOBAL:
             // Set a global flag
             if (missionData >= 0 && missionData < MAX_GLOBAL_FLAGS) {
-                g_globalFlags[missionData] = true;
+                SetGlobalFlag(missionData, true);
                 fprintf(stderr, "      -> Set global %d\n", missionData);
             }
             // Units default to guard
@@ -2222,11 +2439,16 @@ static bool IsPlayerUnitNearCell(int cellX, int cellY, int radiusCells) {
     int radiusPixels = radiusCells * CELL_SIZE;
     int radiusSq = radiusPixels * radiusPixels;
 
-    for (int i = 0; i < MAX_UNITS; i++) {
-        Unit* unit = Units_Get(i);
-        if (!unit || !unit->active) continue;
-        if (unit->team != TEAM_PLAYER) continue;
-        if (unit->state == STATE_DYING) continue;
+    // The spatial hash query is exclusive of its radius (and 0 means the
+    // whole map), so ask one pixel wider and apply the inclusive test here
+    int nearIds[MAX_UNITS];
+    int nearCount = Units_QueryRadius(centerX, centerY, radiusPixels + 1,
+                                      UNITS_TEAM_BIT(TEAM_PLAYER),
+                                      nearIds, MAX_UNITS);
+
+    for (int n = 0; n < nearCount; n++) {
+        Unit* unit = Units_Get(nearIds[n]);
+        if (!unit) continue;
 
         int dx = unit->worldX - centerX;
         int dy = unit->worldY - centerY;
@@ -2711,6 +2933,7 @@ static int ExecuteTriggerAction(ParsedTrigger* trig, int actionNum,
             g_missionTimerValue = param3 * 90;
             g_missionTimerInitial = g_missionTimerValue;
             g_missionTimerActive = true;
+            WakeSubscribers(WAKE_TIMER);
             fprintf(stderr, "  TRIGGER: Start timer %d (%d frames)\n",
                     param3, g_missionTimerValue);
             break;
@@ -2718,13 +2941,14 @@ static int ExecuteTriggerAction(ParsedTrigger* trig, int actionNum,
         case RA_ACTION_STOP_TIMER:
             fprintf(stderr, "  TRIGGER: Stop mission timer\n");
             g_missionTimerActive = false;
+            WakeSubscribers(WAKE_TIMER);
             break;
 
         case RA_ACTION_SET_GLOBAL:
             // param3 = global flag number
             fprintf(stderr, "  TRIGGER: Set global flag %d\n", param3);
             if (param3 >= 0 && param3 < MAX_GLOBAL_FLAGS) {
-                g_globalFlags[param3] = true;
+                SetGlobalFlag(param3, true);
             }
             break;
 
@@ -2732,7 +2956,7 @@ static int ExecuteTriggerAction(ParsedTrigger* trig, int actionNum,
             // param3 = global flag number
             fprintf(stderr, "  TRIGGER: Clear global flag %d\n", param3);
             if (param3 >= 0 && param3 < MAX_GLOBAL_FLAGS) {
-                g_globalFlags[param3] = false;
+                SetGlobalFlag(param3, false);
             }
             break;
 
@@ -2788,6 +3012,7 @@ static int ExecuteTriggerAction(ParsedTrigger* trig, int actionNum,
             fprintf(stderr, "  TRIGGER: Add time to timer: %d frames\n", param1);
             if (g_missionTimerActive) {
                 g_missionTimerValue += param1;
+                WakeSubscribers(WAKE_TIMER);
             }
             break;
 
@@ -2799,6 +3024,7 @@ static int ExecuteTriggerAction(ParsedTrigger* trig, int actionNum,
             if (g_missionTimerActive) {
                 g_missionTimerValue -= param1;
                 if (g_missionTimerValue < 0) g_missionTimerValue = 0;
+                WakeSubscribers(WAKE_TIMER);
             }
             break;
 
@@ -2808,6 +3034,7 @@ static int ExecuteTriggerAction(ParsedTrigger* trig, int actionNum,
             fprintf(stderr, "  TRIGGER: Set timer to %d frames\n", param1);
             g_missionTimerActive = true;
             g_missionTimerValue = param1;
+            WakeSubscribers(WAKE_TIMER);
             break;
 
         case RA_ACTION_BASE_BUILDING:
@@ -2858,26 +3085,214 @@ static int ExecuteTriggerAction(ParsedTrigger* trig, int actionNum,
     return 0;
 }
 
+// Sources whose events can change the outcome of a trigger event, as a
+// mask of (1 << WakeSource). Events that are stubs never change.
+static int EventWakeSources(int eventNum) {
+    switch (eventNum) {
+        case RA_EVENT_ENTERED:
+        case RA_EVENT_ZONE_ENT:
+            return 1 << WAKE_CELLS;
+        case RA_EVENT_ATTACKED:
+        case RA_EVENT_DESTROYED:
+        case RA_EVENT_CIVEVAC:
+            return 1 << WAKE_SELF;
+        case RA_EVENT_ALL_DESTR:
+            return (1 << WAKE_UNITS) | (1 << WAKE_BUILDINGS);
+        case RA_EVENT_UNITS_DESTR:
+            return 1 << WAKE_UNITS;
+        case RA_EVENT_BLDGS_DESTR:
+        case RA_EVENT_NOBLDGS:
+        case RA_EVENT_LOW_POWER:
+        case RA_EVENT_BUILDING_EXISTS:
+            return 1 << WAKE_BUILDINGS;
+        case RA_EVENT_CREDITS:
+            return 1 << WAKE_CREDITS;
+        case RA_EVENT_TIMER_EXP:
+            return 1 << WAKE_TIMER;
+        case RA_EVENT_GLOBAL_SET:
+        case RA_EVENT_GLOBAL_CLR:
+            return 1 << WAKE_GLOBALS;
+        case RA_EVENT_TIME:
+        case RA_EVENT_ANY:
+        case RA_EVENT_DISCOVERED:   // Clears the flag it reads
+        case RA_EVENT_HOUSE_DISC:
+            return 1 << WAKE_POLL;
+        default:
+            return 0;
+    }
+}
+
+static inline int FloorDiv(int a, int b) {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+// Add a trigger to every watch cell a player unit could stand in while
+// IsPlayerUnitNearCell(cellX, cellY, radiusCells) holds
+static bool WatchCircle(int idx, int cellX, int cellY, int radiusCells) {
+    int centerX = cellX * CELL_SIZE + CELL_SIZE / 2;
+    int centerY = cellY * CELL_SIZE + CELL_SIZE / 2;
+    int radius = radiusCells * CELL_SIZE;
+
+    int x0 = FloorDiv(centerX - radius, CELL_SIZE);
+    int x1 = FloorDiv(centerX + radius, CELL_SIZE);
+    int y0 = FloorDiv(centerY - radius, CELL_SIZE);
+    int y1 = FloorDiv(centerY + radius, CELL_SIZE);
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= MAP_CELL_W) x1 = MAP_CELL_W - 1;
+    if (y1 >= MAP_CELL_H) y1 = MAP_CELL_H - 1;
+
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            int cell = y * MAP_CELL_W + x;
+            if (g_cellWatchSlot[cell] == 0) {
+                if (g_cellWatchCount >= MAX_CELL_WATCHES) return false;
+                memset(&g_cellWatches[g_cellWatchCount], 0, sizeof(TriggerSet));
+                g_cellWatchSlot[cell] = (uint16_t)(++g_cellWatchCount);
+            }
+            TriggerSet_Add(&g_cellWatches[g_cellWatchSlot[cell] - 1], idx);
+        }
+    }
+    return true;
+}
+
+// Register the cells an ENTERED/ZONE_ENT event looks at (mirrors the
+// zone tests in CheckTriggerEvent)
+static bool WatchTriggerCells(int idx, int eventNum, int param1,
+                              const MissionData* mission) {
+    const ParsedTrigger* trig = &g_parsedTriggers[idx];
+    int wp = param1;
+    if (wp >= 0 && wp < MAX_MISSION_WAYPOINTS &&
+        mission->waypoints[wp].cell >= 0) {
+        return WatchCircle(idx, mission->waypoints[wp].cellX,
+                           mission->waypoints[wp].cellY, 2);
+    }
+    if (eventNum != RA_EVENT_ENTERED) return true;
+
+    for (int i = 0; i < mission->cellTriggerCount; i++) {
+        if (strcasecmp(mission->cellTriggerNames[i], trig->name) != 0) continue;
+        int cell = mission->cellTriggerCells[i];
+        if (!WatchCircle(idx, CELL_TO_X(cell), CELL_TO_Y(cell), 0)) {
+            return false;
+        }
+    }
+    for (int i = 0; i < mission->objectTriggerCount; i++) {
+        if (strcasecmp(mission->objectTriggerNames[i], trig->name) != 0) {
+            continue;
+        }
+        int cell = mission->objectTriggerCells[i];
+        if (!WatchCircle(idx, CELL_TO_X(cell), CELL_TO_Y(cell), 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void SubscribeTriggerEvent(int idx, int eventNum, int param1,
+                                  const MissionData* mission) {
+    int sources = EventWakeSources(eventNum);
+    for (int s = 0; s < WAKE_SOURCE_COUNT; s++) {
+        if (sources & (1 << s)) TriggerSet_Add(&g_wakeSubscribers[s], idx);
+    }
+    if (sources & (1 << WAKE_POLL)) {
+        TriggerSet_Add(&g_triggersPolled, idx);
+    }
+    // Too many watched cells: fall back to checking every frame
+    if ((sources & (1 << WAKE_CELLS)) &&
+        !WatchTriggerCells(idx, eventNum, param1, mission)) {
+        TriggerSet_Add(&g_triggersPolled, idx);
+    }
+}
+
+// Build subscriptions for the loaded triggers and mark every one dirty
+static void SubscribeTriggers(const MissionData* mission) {
+    memset(g_wakeSubscribers, 0, sizeof(g_wakeSubscribers));
+    memset(&g_triggersDirty, 0, sizeof(g_triggersDirty));
+    memset(&g_triggersPolled, 0, sizeof(g_triggersPolled));
+    memset(&g_triggersArmed, 0, sizeof(g_triggersArmed));
+    memset(g_cellWatchSlot, 0, sizeof(g_cellWatchSlot));
+    g_cellWatchCount = 0;
+
+    for (int i = 0; i < g_parsedTriggerCount; i++) {
+        ParsedTrigger* trig = &g_parsedTriggers[i];
+        SubscribeTriggerEvent(i, trig->event1, trig->e1p1, mission);
+        if (trig->eventControl != 0) {
+            SubscribeTriggerEvent(i, trig->event2, trig->e2p1, mission);
+        }
+        TriggerSet_Add(&g_triggersDirty, i);
+    }
+
+    // Seed unit positions; later changes arrive through Mission_PostEvent
+    for (int i = 0; i < MAX_UNITS; i++) {
+        g_unitWatchCell[i] = -1;
+        TrackUnitCell(i, true);
+    }
+    g_subscribedMission = mission;
+}
+
+// Next trigger at or after 'from' that has to be looked at, or -1
+static int NextAwakeTrigger(int from) {
+    if (g_triggerPolling) return from < g_parsedTriggerCount ? from : -1;
+
+    int lastWord = (g_parsedTriggerCount - 1) >> 6;
+    for (int w = from >> 6; w <= lastWord; w++) {
+        uint64_t bits = g_triggersDirty.bits[w] | g_triggersPolled.bits[w] |
+                        g_triggersArmed.bits[w];
+        if (w == (from >> 6)) bits &= ~0ull << (from & 63);
+        if (bits) {
+            int idx = (w << 6) + __builtin_ctzll(bits);
+            return idx < g_parsedTriggerCount ? idx : -1;
+        }
+    }
+    return -1;
+}
+
+// Evaluate one trigger event, or reuse its cached result when nothing it
+// depends on has changed
+static bool UpdateTriggerEvent(ParsedTrigger* trig, int eventNum, int param1,
+                               int param2, bool stale, bool cached,
+                               int frameCount, const MissionData* mission) {
+    if (!stale && !(EventWakeSources(eventNum) & (1 << WAKE_POLL))) {
+        return cached;
+    }
+    g_triggerEvaluations++;
+    return CheckTriggerEvent(trig, eventNum, param1, param2, frameCount,
+                             mission);
+}
+
 int Mission_ProcessTriggers(const MissionData* mission, int frameCount) {
     if (!mission) return 0;
 
+    if (mission != g_subscribedMission) {
+        SubscribeTriggers(mission);
+    }
+
     int result = 0;
 
-    for (int i = 0; i < g_parsedTriggerCount; i++) {
+    for (int i = NextAwakeTrigger(0); i >= 0; i = NextAwakeTrigger(i + 1)) {
         ParsedTrigger* trig = &g_parsedTriggers[i];
         if (!trig->active) continue;
 
+        // Anything posted from here on (including by this trigger's own
+        // actions) is seen on the next visit
+        bool stale = g_triggerPolling || TriggerSet_Has(&g_triggersDirty, i);
+        TriggerSet_Remove(&g_triggersDirty, i);
+
         // Check event1
-        bool event1Fired = CheckTriggerEvent(trig, trig->event1,
-                                              trig->e1p1, trig->e1p2,
-                                              frameCount, mission);
+        trig->event1Fired = UpdateTriggerEvent(trig, trig->event1,
+                                               trig->e1p1, trig->e1p2,
+                                               stale, trig->event1Fired,
+                                               frameCount, mission);
+        bool event1Fired = trig->event1Fired;
 
         // Check event2 if using AND/OR control
         bool event2Fired = false;
         if (trig->eventControl != 0) {  // Not "ONLY"
-            event2Fired = CheckTriggerEvent(trig, trig->event2,
-                                             trig->e2p1, trig->e2p2,
-                                             frameCount, mission);
+            trig->event2Fired = UpdateTriggerEvent(trig, trig->event2,
+                                                   trig->e2p1, trig->e2p2,
+                                                   stale, trig->event2Fired,
+                                                   frameCount, mission);
+            event2Fired = trig->event2Fired;
         }
 
         // Determine if trigger should fire
@@ -2897,7 +3312,12 @@ int Mission_ProcessTriggers(const MissionData* mission, int frameCount) {
                 break;
         }
 
-        if (!shouldFire) continue;
+        if (!shouldFire) {
+            TriggerSet_Remove(&g_triggersArmed, i);
+            continue;
+        }
+        TriggerSet_Add(&g_triggersArmed, i);
+        trig->fireCount++;
 
         fprintf(stderr, "  TRIGGER '%s' fired!\n", trig->name);
 
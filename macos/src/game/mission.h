@@ -277,6 +277,53 @@ int Mission_ProcessTriggers(const MissionData* mission, int frameCount);
 int Mission_GetWaypoint(const MissionData* mission, int waypointNum,
                         int* outX, int* outY);
 
+/**
+ * Simulation events the trigger system subscribes to. Each trigger is only
+ * re-evaluated when an event its conditions depend on has been posted.
+ */
+typedef enum {
+    MISSION_EVENT_UNIT_SPAWNED,         // param = unit ID
+    MISSION_EVENT_UNIT_MOVED,           // param = unit ID, after any move
+    MISSION_EVENT_UNIT_DIED,            // param = unit ID, dying or removed
+    MISSION_EVENT_BUILDING_BUILT,       // param = building ID
+    MISSION_EVENT_BUILDING_DESTROYED,   // param = building ID
+    MISSION_EVENT_CREDITS_CHANGED,      // Player credits changed
+    MISSION_EVENT_TIMER_EXPIRED         // Mission timer reached zero
+} MissionEvent;
+
+/**
+ * Post a simulation event to the trigger system
+ * Must be called wherever the corresponding state changes; a missed event
+ * leaves dependent triggers looking at a stale result.
+ * @param event What happened
+ * @param param Unit or building ID, see MissionEvent
+ */
+void Mission_PostEvent(MissionEvent event, int param);
+
+/**
+ * Debug: re-evaluate every trigger condition every frame instead of only
+ * after a relevant event (the behaviour before event subscriptions)
+ */
+void Mission_SetTriggerPolling(int enabled);
+
+/**
+ * Drop trigger subscriptions and cached condition results, so the next
+ * Mission_ProcessTriggers re-evaluates every trigger from scratch. Call
+ * after the world is replaced without posting events (loading a game).
+ */
+void Mission_ResetTriggerCache(void);
+
+/**
+ * Number of trigger conditions evaluated since the triggers were loaded
+ */
+int Mission_GetTriggerEvaluations(void);
+
+/**
+ * Number of times a trigger has fired since it was loaded
+ * @return Fire count, or 0 if there is no such trigger
+ */
+int Mission_GetTriggerFireCount(const char* triggerName);
+
 /**
  * Notify trigger system that an object was attacked
  * Called by TechnoClass::TakeDamage when object takes damage
@@ -104,7 +104,8 @@ public:
     ObjectClass()
         : AbstractClass(), isDown_(false), isToDamage_(false),
           isToDisplay_(false), isInLimbo_(true), isSelected_(false),
-          strength_(0) {}
+          isAnimAttached_(false), isFalling_(false), riser_(0),
+          next_(nullptr), strength_(0) {}
     ObjectClass(RTTIType rtti, int id);
     virtual ~ObjectClass() = default;
 
@@ -498,14 +499,23 @@ public:
     T* Allocate() {
         for (int i = 0; i < MaxCount; i++) {
             if (objects_[i] == nullptr) {
-                objects_[i] = new T();
-                count_++;
-                return objects_[i];
+                return AllocateAt(i);
             }
         }
         return nullptr;  // Pool exhausted
     }
 
+    // Allocate a specific slot (save games restore objects in place)
+    T* AllocateAt(int id) {
+        if (id < 0 || id >= MaxCount || objects_[id] != nullptr) {
+            return nullptr;
+        }
+        objects_[id] = new T();
+        objects_[id]->id_ = static_cast<int16_t>(id);
+        count_++;
+        return objects_[id];
+    }
+
     void Free(T* obj) {
         if (obj == nullptr) return;
         int id = obj->ID();
@@ -523,6 +533,15 @@ public:
         return nullptr;
     }
 
+    // Free every object
+    void Clear() {
+        for (int i = 0; i < MaxCount; i++) {
+            delete objects_[i];
+            objects_[i] = nullptr;
+        }
+        count_ = 0;
+    }
+
     int Count() const { return count_; }
     int Capacity() const { return MaxCount; }
 
@@ -0,0 +1,124 @@
+/**
+ * Red Alert macOS Port - Path Result Cache Implementation
+ */
+
+#include "pathcache.h"
+#include <cstring>
+
+struct CachedRoute {
+    bool valid;
+    uint8_t mover;
+    bool complete;
+    int16_t count;
+    int16_t start;
+    int16_t goal;
+    uint32_t lastUse;
+    int16_t cells[PATHCACHE_MAX_CELLS];
+};
+
+static CachedRoute g_routes[PATHCACHE_ENTRIES];
+static uint32_t g_useClock = 0;
+static uint32_t g_revision = 0;
+static bool g_revisionKnown = false;
+static PathCacheStats g_stats;
+
+// Drop every route if terrain changed since they were planned
+static void SyncRevision(void) {
+    uint32_t revision = Map_GetTerrainRevision();
+    if (g_revisionKnown && revision == g_revision) return;
+    if (g_revisionKnown) g_stats.flushes++;
+    PathCache_Invalidate();
+    g_revision = revision;
+    g_revisionKnown = true;
+}
+
+// Index of the first route cell after startCell, or -1 if it isn't on
+// the route (or nothing of the route is left after it)
+static int RouteOffset(const CachedRoute* route, int startCell) {
+    if (route->start == startCell) return 0;
+    for (int i = 0; i < route->count - 1; i++) {
+        if (route->cells[i] == startCell) return i + 1;
+    }
+    return -1;
+}
+
+int PathCache_Lookup(PathCacheMover mover, int startCell, int goalCell,
+                     int16_t* outCells, int maxCells, BOOL* partial) {
+    SyncRevision();
+    g_stats.lookups++;
+
+    for (int i = 0; i < PATHCACHE_ENTRIES; i++) {
+        CachedRoute* route = &g_routes[i];
+        if (!route->valid || route->mover != mover || route->goal != goalCell) continue;
+
+        int offset = RouteOffset(route, startCell);
+        if (offset < 0) continue;
+
+        int remaining = route->count - offset;
+        int count = (remaining < maxCells) ? remaining : maxCells;
+        memcpy(outCells, &route->cells[offset], (size_t)count * sizeof(int16_t));
+        if (partial) *partial = (count < remaining || !route->complete) ? TRUE : FALSE;
+
+        route->lastUse = ++g_useClock;
+        g_stats.hits++;
+        if (offset > 0) g_stats.suffixHits++;
+        return count;
+    }
+
+    g_stats.misses++;
+    return -1;
+}
+
+void PathCache_Store(PathCacheMover mover, int startCell, int goalCell,
+                     const int16_t* cells, int count, BOOL complete) {
+    if (count <= 0) return;
+    if (count > PATHCACHE_MAX_CELLS) {
+        count = PATHCACHE_MAX_CELLS;
+        complete = FALSE;
+    }
+    SyncRevision();
+
+    // Replace the same request's route, else take a free or the least
+    // recently used slot
+    CachedRoute* slot = nullptr;
+    for (int i = 0; i < PATHCACHE_ENTRIES && !slot; i++) {
+        CachedRoute* route = &g_routes[i];
+        if (route->valid && route->mover == mover &&
+            route->start == startCell && route->goal == goalCell) {
+            slot = route;
+        }
+    }
+    if (!slot) {
+        slot = &g_routes[0];
+        for (int i = 0; i < PATHCACHE_ENTRIES; i++) {
+            CachedRoute* route = &g_routes[i];
+            if (!route->valid) { slot = route; break; }
+            if (route->lastUse < slot->lastUse) slot = route;
+        }
+        if (slot->valid) g_stats.evictions++;
+    }
+
+    slot->valid = true;
+    slot->mover = (uint8_t)mover;
+    slot->complete = complete ? true : false;
+    slot->count = (int16_t)count;
+    slot->start = (int16_t)startCell;
+    slot->goal = (int16_t)goalCell;
+    slot->lastUse = ++g_useClock;
+    memcpy(slot->cells, cells, (size_t)count * sizeof(int16_t));
+    g_stats.stores++;
+}
+
+void PathCache_Invalidate(void) {
+    for (int i = 0; i < PATHCACHE_ENTRIES; i++) {
+        g_routes[i].valid = false;
+    }
+}
+
+const PathCacheStats* PathCache_GetStats(void) {
+    return &g_stats;
+}
+
+void PathCache_ResetStats(void) {
+    memset(&g_stats, 0, sizeof(g_stats));
+}
@@ -0,0 +1,68 @@
+/**
+ * Red Alert macOS Port - Path Result Cache
+ *
+ * Remembers recent unit routes keyed by start cell, goal cell and mover
+ * class, so repeat requests (harvester trips between ore and refinery,
+ * attack waves sent down the same lane) skip the search. A request whose
+ * start lies anywhere along a cached route to the same goal is served
+ * the rest of that route.
+ *
+ * Routes are only valid for the passability they were planned on: the
+ * whole cache is dropped whenever Map_GetTerrainRevision() moves on.
+ */
+
+#ifndef GAME_PATHCACHE_H
+#define GAME_PATHCACHE_H
+
+#include "map.h"
+
+#define PATHCACHE_ENTRIES       64
+#define PATHCACHE_MAX_CELLS     256     // Longer routes keep their first cells
+
+// Mover classes, one per passability rule (aircraft fly straight)
+typedef enum {
+    PATHCACHE_GROUND = 0,       // Map_IsPassable
+    PATHCACHE_NAVAL,            // Map_IsWaterPassable
+    PATHCACHE_MOVER_COUNT
+} PathCacheMover;
+
+// Counters since the last PathCache_ResetStats()
+typedef struct {
+    uint32_t lookups;           // PathCache_Lookup calls
+    uint32_t hits;              // Lookups served a route
+    uint32_t suffixHits;        // ...of which started part-way along one
+    uint32_t misses;            // Lookups that found nothing
+    uint32_t stores;            // Routes added or replaced
+    uint32_t evictions;         // Routes dropped to make room
+    uint32_t flushes;           // Cache drops after terrain changes
+} PathCacheStats;
+
+/**
+ * Look up a route. Cells are indices (y * map width + x), start excluded.
+ * @param outCells  Receives up to maxCells of the route
+ * @param partial   Set to TRUE if the cells stop short of the goal
+ * @return Number of cells written, or -1 on a miss
+ */
+int PathCache_Lookup(PathCacheMover mover, int startCell, int goalCell,
+                     int16_t* outCells, int maxCells, BOOL* partial);
+
+/**
+ * Remember a route from startCell (excluded) toward goalCell.
+ * @param count     Cells in the route, at most PATHCACHE_MAX_CELLS
+ * @param complete  TRUE if the last cell is the goal
+ */
+void PathCache_Store(PathCacheMover mover, int startCell, int goalCell,
+                     const int16_t* cells, int count, BOOL complete);
+
+/**
+ * Drop every cached route
+ */
+void PathCache_Invalidate(void);
+
+/**
+ * Statistics
+ */
+const PathCacheStats* PathCache_GetStats(void);
+void PathCache_ResetStats(void);
+
+#endif // GAME_PATHCACHE_H
@@ -8,7 +8,6 @@
 #include "pathfind.h"
 #include "mapclass.h"
 #include "cell.h"
-#include <queue>
 #include <algorithm>
 #include <cmath>
 
@@ -99,19 +98,105 @@ PathType Find_Path(CELL start, CELL target, SpeedType speed,
 //===========================================================================
 
 PathFinder::PathFinder()
-    : currentSpeed_(SpeedType::TRACK)
+    : searchGen_(0)
+    , currentSpeed_(SpeedType::TRACK)
     , currentThreat_(-1)
 {
     // Pre-allocate arrays for performance
-    gScore_.resize(MAP_CELL_TOTAL, MAX_PATH_COST);
-    cameFrom_.resize(MAP_CELL_TOTAL, -1);
-    dirFrom_.resize(MAP_CELL_TOTAL, FacingType::NORTH);
-    closed_.resize(MAP_CELL_TOTAL, false);
+    scratch_.resize(MAP_CELL_TOTAL, CellScratch{0, MAX_PATH_COST});
+    cameFrom_.resize(MAP_CELL_TOTAL, FacingType::NORTH);
+    open_.reserve(1024);
+    reverse_.reserve(MAX_PATH_LENGTH);
 }
 
 PathFinder::~PathFinder() {
 }
 
+void PathFinder::BeginSearch() {
+    searchGen_++;
+    if (searchGen_ == 0) {
+        // Stamp wrapped - stale stamps could now alias, so pay the full
+        // reset once every 4 billion searches
+        for (CellScratch& sc : scratch_) {
+            sc.visitGen = 0;
+        }
+        searchGen_ = 1;
+    }
+    open_.clear();  // Keeps capacity
+}
+
+// Min-heap on f over open_, so capacity is kept between searches. The
+// standard heap algorithms beat a hand-rolled sift here: pop walks the
+// hole straight to a leaf, which mispredicts far less on the long,
+// tie-heavy open lists a cross-map search builds.
+inline void PathFinder::OpenPush(const Node& node) {
+    open_.push_back(node);
+    std::push_heap(open_.begin(), open_.end(),
+                   [](const Node& a, const Node& b) { return a.f > b.f; });
+}
+
+inline PathFinder::Node PathFinder::OpenPop() {
+    std::pop_heap(open_.begin(), open_.end(),
+                  [](const Node& a, const Node& b) { return a.f > b.f; });
+    Node top = open_.back();
+    open_.pop_back();
+    return top;
+}
+
+inline int PathFinder::Heuristic(CELL from, CELL to) const {
+    // Chebyshev distance (allows diagonal movement)
+    int dx = std::abs(Cell_X(to) - Cell_X(from));
+    int dy = std::abs(Cell_Y(to) - Cell_Y(from));
+
+    // Diagonal distance: max(dx, dy) * 10 + (min) * 4
+    // This favors paths that use diagonals appropriately
+    int minD = std::min(dx, dy);
+    int maxD = std::max(dx, dy);
+    return maxD * 10 + minD * 4;
+}
+
+inline int PathFinder::MoveCost(CELL from, CELL to,
+                         FacingType dir, SpeedType speed) const {
+    (void)from;  // Unused in basic implementation
+
+    if (!Map.IsValidCell(to)) return MAX_PATH_COST;
+
+    const CellClass& cell = Map[to];
+
+    // Check basic passability (buildings block, matching the zones)
+    if (!cell.IsPassable(speed)) return MAX_PATH_COST;
+    if (cell.flag_.occupy.building) return MAX_PATH_COST;
+
+    // Base movement cost
+    int cost = MOVE_COST[static_cast<int>(dir)];
+
+    // Terrain modifiers
+    LandType land = cell.GetLandType();
+    switch (land) {
+        case LandType::ROAD:
+            cost = cost * 8 / 10;  // 20% faster on roads
+            break;
+        case LandType::ROUGH:
+            cost = cost * 12 / 10;  // 20% slower on rough terrain
+            break;
+        case LandType::BEACH:
+            if (speed != SpeedType::FLOAT) {
+                cost = cost * 15 / 10;  // 50% slower on beach for land units
+            }
+            break;
+        default:
+            break;
+    }
+
+    // Threat avoidance (would check enemy presence)
+    // For now, just avoid occupied cells
+    if (cell.CellOccupier() != nullptr) {
+        cost += 50;  // Penalty for occupied cells
+    }
+
+    return cost;
+}
+
 PathType PathFinder::FindPath(CELL start, CELL target, SpeedType speed,
                               int maxCost, int threat) {
     PathType result;
@@ -130,10 +215,16 @@ PathType PathFinder::FindPath(CELL start, CELL target, SpeedType speed,
         return result;
     }
 
+    // Movement zone the search is confined to (aircraft ignore zones)
+    MZoneType check = MapClass::SpeedZone(speed);
+    int startZone = (speed == SpeedType::WINGED) ? -1 : Map.CellZone(start, check);
+    if (startZone == 0 || startZone == MapClass::ZONE_UNKNOWN) startZone = -1;
+
     // Check if target is reachable at all
-    if (!Map[target].IsPassable(speed)) {
-        // Try to find nearest passable cell to target
-        CELL nearTarget = Map.NearbyLocation(target, speed);
+    const CellClass& targetCell = Map[target];
+    if (!targetCell.IsPassable(speed) || targetCell.flag_.occupy.building) {
+        // Try to find nearest passable cell to target in the start's zone
+        CELL nearTarget = Map.NearbyLocation(target, speed, startZone, check);
         if (nearTarget == target || !Map[nearTarget].IsPassable(speed)) {
             return result;  // No valid target
         }
@@ -141,91 +232,110 @@ PathType PathFinder::FindPath(CELL start, CELL target, SpeedType speed,
         result.target = target;
     }
 
+    // Separate zones can't be joined at any cost; skip the search
+    if (speed != SpeedType::WINGED && !Map.ZonesConnected(start, target, check)) {
+        return result;
+    }
+
     currentSpeed_ = speed;
     currentThreat_ = threat;
 
-    // Reset state
-    std::fill(gScore_.begin(), gScore_.end(), MAX_PATH_COST);
-    std::fill(cameFrom_.begin(), cameFrom_.end(), static_cast<CELL>(-1));
-    std::fill(closed_.begin(), closed_.end(), false);
+    int cost = Search(start, target, speed, maxCost);
+    if (cost < 0) {
+        return result;  // No path found
+    }
+    result.cost = cost;
+    ReconstructPath(result, start, target);
+    return result;
+}
+
+// The A* loop itself, kept apart from FindPath's target/zone setup so
+// the compiler lays it out (and inlines MoveCost and the heap) on its
+// own terms; folding the two together cost a third of the speed on
+// cross-map searches. Returns the path cost, or -1 if none was found.
+int PathFinder::Search(CELL start, CELL target, SpeedType speed, int maxCost) {
+    // Reset state (O(1) - invalidates every stamp from the last search)
+    BeginSearch();
 
-    // Priority queue (min-heap by f-score)
-    auto cmp = [](const Node& a, const Node& b) { return a.f > b.f; };
-    std::priority_queue<Node, std::vector<Node>, decltype(cmp)> openSet(cmp);
+    // Local copies keep the hot loop free of reloads through 'this'
+    const uint32_t gen = searchGen_;
+    CellScratch* scratch = scratch_.data();
+    FacingType* cameFrom = cameFrom_.data();
 
     // Initialize start node
     Node startNode;
     startNode.cell = start;
     startNode.g = 0;
-    startNode.h = Heuristic(start, target);
-    startNode.f = startNode.g + startNode.h;
-    startNode.parent = -1;
-    startNode.dir = FacingType::NORTH;
+    startNode.f = startNode.g + Heuristic(start, target);
 
-    gScore_[start] = 0;
-    openSet.push(startNode);
+    scratch[start].visitGen = gen;
+    scratch[start].g = 0;
+    OpenPush(startNode);
 
     int iterations = 0;
     const int maxIterations = MAP_CELL_TOTAL;
 
-    while (!openSet.empty() && iterations < maxIterations) {
+    while (!open_.empty() && iterations < maxIterations) {
         iterations++;
 
-        Node current = openSet.top();
-        openSet.pop();
+        Node current = OpenPop();
 
-        // Skip if already processed
-        if (closed_[current.cell]) continue;
-        closed_[current.cell] = true;
+        // Skip entries that were improved on after being pushed, or
+        // whose cell was already expanded (g is CLOSED then)
+        CellScratch& cur = scratch[current.cell];
+        if (cur.g != current.g) continue;
+        cur.g = CLOSED;
 
         // Check if we reached the target
         if (current.cell == target) {
-            result.cost = current.g;
-            ReconstructPath(result, start, target);
-            return result;
+            return current.g;
         }
 
         // Exceeded cost limit?
         if (current.g > maxCost) continue;
 
         // Explore neighbors
+        const int curX = Cell_X(current.cell);
         for (int d = 0; d < 8; d++) {
-            FacingType dir = static_cast<FacingType>(d);
-            CELL neighbor = Adjacent_Cell(current.cell, dir);
-
-            // Skip if same cell (edge wrap) or already closed
-            if (neighbor == current.cell) continue;
-            if (closed_[neighbor]) continue;
+            // Same bounds as Adjacent_Cell, without the call
+            int nx = curX + DIR_OFFSET_X[d];
+            if (nx < 0 || nx >= MAP_CELL_W) continue;
+            int next = current.cell + CELL_OFFSET[d];
+            if (next < 0 || next >= MAP_CELL_TOTAL) continue;
+            CELL neighbor = static_cast<CELL>(next);
+
+            // Skip if already closed
+            CellScratch& sc = scratch[neighbor];
+            bool visited = (sc.visitGen == gen);
+            if (visited && sc.g == CLOSED) continue;
 
             // Calculate move cost
+            FacingType dir = static_cast<FacingType>(d);
             int moveCost = MoveCost(current.cell, neighbor, dir, speed);
             if (moveCost >= MAX_PATH_COST) continue;
 
             int tentativeG = current.g + moveCost;
 
             // Skip if we found a worse path
-            if (tentativeG >= gScore_[neighbor]) continue;
+            if (visited && tentativeG >= sc.g) continue;
 
             // Record this path
-            gScore_[neighbor] = tentativeG;
-            cameFrom_[neighbor] = current.cell;
-            dirFrom_[neighbor] = dir;
+            sc.visitGen = gen;
+            sc.g = tentativeG;
+            cameFrom[neighbor] = dir;
 
             // Add to open set
             Node neighborNode;
             neighborNode.cell = neighbor;
             neighborNode.g = tentativeG;
-            neighborNode.h = Heuristic(neighbor, target);
-            neighborNode.f = neighborNode.g + neighborNode.h;
-            neighborNode.parent = current.cell;
-            neighborNode.dir = dir;
+            neighborNode.f = tentativeG + Heuristic(neighbor, target);
 
-            openSet.push(neighborNode);
+            OpenPush(neighborNode);
         }
     }
 
     // No path found
-    return result;
+    return -1;
 }
 
 PathType PathFinder::FindPath(int32_t startCoord, int32_t targetCoord,
@@ -234,75 +344,19 @@ PathType PathFinder::FindPath(int32_t startCoord, int32_t targetCoord,
                     speed, maxCost, threat);
 }
 
-int PathFinder::Heuristic(CELL from, CELL to) const {
-    // Chebyshev distance (allows diagonal movement)
-    int dx = std::abs(Cell_X(to) - Cell_X(from));
-    int dy = std::abs(Cell_Y(to) - Cell_Y(from));
-
-    // Diagonal distance: max(dx, dy) * 10 + (min) * 4
-    // This favors paths that use diagonals appropriately
-    int minD = std::min(dx, dy);
-    int maxD = std::max(dx, dy);
-    return maxD * 10 + minD * 4;
-}
-
-int PathFinder::MoveCost(CELL from, CELL to,
-                         FacingType dir, SpeedType speed) const {
-    (void)from;  // Unused in basic implementation
-
-    if (!Map.IsValidCell(to)) return MAX_PATH_COST;
-
-    const CellClass& cell = Map[to];
-
-    // Check basic passability
-    if (!cell.IsPassable(speed)) return MAX_PATH_COST;
-
-    // Base movement cost
-    int cost = MOVE_COST[static_cast<int>(dir)];
-
-    // Terrain modifiers
-    LandType land = cell.GetLandType();
-    switch (land) {
-        case LandType::ROAD:
-            cost = cost * 8 / 10;  // 20% faster on roads
-            break;
-        case LandType::ROUGH:
-            cost = cost * 12 / 10;  // 20% slower on rough terrain
-            break;
-        case LandType::BEACH:
-            if (speed != SpeedType::FLOAT) {
-                cost = cost * 15 / 10;  // 50% slower on beach for land units
-            }
-            break;
-        default:
-            break;
-    }
-
-    // Threat avoidance (would check enemy presence)
-    // For now, just avoid occupied cells
-    if (cell.CellOccupier() != nullptr) {
-        cost += 50;  // Penalty for occupied cells
-    }
-
-    return cost;
-}
-
 void PathFinder::ReconstructPath(PathType& path, CELL start, CELL target) {
     // Build path by following parent pointers backward
-    std::vector<FacingType> reversePath;
+    reverse_.clear();
     CELL current = target;
 
-    while (current != start && cameFrom_[current] >= 0) {
-        reversePath.push_back(dirFrom_[current]);
-        current = cameFrom_[current];
+    while (current != start && IsVisited(current)) {
+        FacingType dir = cameFrom_[current];
+        reverse_.push_back(dir);
+        current -= CELL_OFFSET[static_cast<int>(dir)];
     }
 
     // Reverse to get start-to-end order
-    path.commands.clear();
-    path.commands.reserve(reversePath.size());
-    for (auto it = reversePath.rbegin(); it != reversePath.rend(); ++it) {
-        path.commands.push_back(*it);
-    }
+    path.commands.assign(reverse_.rbegin(), reverse_.rend());
     path.length = static_cast<int>(path.commands.size());
 }
 
@@ -49,6 +49,8 @@ struct PathType {
 //===========================================================================
 // PathFinder - A* pathfinding implementation
 //===========================================================================
+// Flat A* over MapClass. The sector graph in pathgraph.h covers the
+// realtime map.cpp grid only, so long searches here don't use it.
 class PathFinder {
 public:
     PathFinder();
@@ -104,13 +106,18 @@ private:
     struct Node {
         CELL cell;
         int g;          // Cost from start
-        int h;          // Heuristic (estimated cost to target)
-        int f;          // Total = g + h
-        CELL parent;
-        FacingType dir; // Direction taken to reach this node
+        int f;          // Total = g + heuristic
+    };
 
-        bool operator>(const Node& other) const { return f > other.f; }
+    // Per-cell search scratch, split so the part every neighbour test
+    // touches stays small. Entries are only meaningful when their stamp
+    // matches the current search generation, so starting a new search
+    // is one counter bump instead of refilling 16K cells.
+    struct CellScratch {
+        uint32_t visitGen;  // g valid for this search
+        int g;              // g-score, CLOSED once expanded
     };
+    static constexpr int CLOSED = -1;
 
     //-----------------------------------------------------------------------
     // Internal Methods
@@ -118,16 +125,25 @@ private:
 
     int Heuristic(CELL from, CELL to) const;
     int MoveCost(CELL from, CELL to, FacingType dir, SpeedType speed) const;
+    int Search(CELL start, CELL target, SpeedType speed, int maxCost);
     void ReconstructPath(PathType& path, CELL start, CELL target);
 
+    void BeginSearch();
+    bool IsVisited(CELL cell) const { return scratch_[cell].visitGen == searchGen_; }
+
+    // Open list - binary min-heap on f, storage reused between searches
+    void OpenPush(const Node& node);
+    Node OpenPop();
+
     //-----------------------------------------------------------------------
     // State
     //-----------------------------------------------------------------------
 
-    std::vector<int> gScore_;      // g-score for each cell
-    std::vector<CELL> cameFrom_;   // Parent cell for reconstruction
-    std::vector<FacingType> dirFrom_; // Direction taken to reach cell
-    std::vector<bool> closed_;     // Closed set
+    std::vector<CellScratch> scratch_;  // Per-cell search state (hot)
+    std::vector<FacingType> cameFrom_;  // Direction taken to reach cell (cold)
+    uint32_t searchGen_;                // Current search generation
+    std::vector<Node> open_;            // Open list heap storage
+    std::vector<FacingType> reverse_;   // Path reconstruction scratch
 
     SpeedType currentSpeed_;
     int currentThreat_;
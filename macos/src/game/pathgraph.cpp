@@ -0,0 +1,636 @@
+/**
+ * Red Alert macOS Port - Hierarchical Path Graph Implementation
+ *
+ * Cells are addressed internally as y * MAP_MAX_WIDTH + x ("grid index")
+ * so indices survive map size changes; results are converted to the
+ * y * width + x form the unit system stores.
+ */
+
+#include "pathgraph.h"
+#include <cstdlib>
+#include <cstring>
+
+// Entrance runs this long or longer get a node at each end
+static const int LONG_RUN = 6;
+
+static const int DIR_DX[8] = { 0,  1, 1, 1, 0, -1, -1, -1 };
+static const int DIR_DY[8] = { -1, -1, 0, 1, 1,  1,  0, -1 };
+static const int DIR_COST[8] = { 10, 14, 10, 14, 10, 14, 10, 14 };
+
+static const uint16_t NO_COST = 0xFFFF;
+static const uint8_t NO_NODE = 0xFF;
+static const int GRID_CELLS = MAP_MAX_WIDTH * MAP_MAX_HEIGHT;
+static const int SECTOR_CELLS = PATHGRAPH_SECTOR_SIZE * PATHGRAPH_SECTOR_SIZE;
+
+// One crossing between neighbouring sectors: cell a on the west/north
+// side, cell b on the east/south side
+struct Entrance {
+    uint16_t a;
+    uint16_t b;
+};
+
+struct SectorNodes {
+    int count;
+    uint16_t cell[PATHGRAPH_MAX_NODES];
+    uint8_t partnerCount[PATHGRAPH_MAX_NODES];
+    uint16_t partner[PATHGRAPH_MAX_NODES][2];   // Corner cells cross two borders
+    uint16_t cost[PATHGRAPH_MAX_NODES][PATHGRAPH_MAX_NODES];
+};
+
+struct LayerGraph {
+    bool built;
+    uint64_t dirty;             // One bit per sector
+    int eastCount[PATHGRAPH_SECTORS_Y][PATHGRAPH_SECTORS_X];
+    int southCount[PATHGRAPH_SECTORS_Y][PATHGRAPH_SECTORS_X];
+    Entrance east[PATHGRAPH_SECTORS_Y][PATHGRAPH_SECTORS_X][PATHGRAPH_MAX_ENTRANCES];
+    Entrance south[PATHGRAPH_SECTORS_Y][PATHGRAPH_SECTORS_X][PATHGRAPH_MAX_ENTRANCES];
+    SectorNodes sectors[PATHGRAPH_SECTORS_Y][PATHGRAPH_SECTORS_X];
+    uint8_t nodeIndex[GRID_CELLS];  // Slot in the cell's sector, or NO_NODE
+};
+
+static LayerGraph g_layers[PATHGRAPH_LAYER_COUNT];
+static int g_width = 0;
+static int g_height = 0;
+static int g_sectorsX = 0;
+static int g_sectorsY = 0;
+static PathGraphStats g_stats;
+
+static inline int GridX(int cell) { return cell % MAP_MAX_WIDTH; }
+static inline int GridY(int cell) { return cell / MAP_MAX_WIDTH; }
+static inline int GridIndex(int x, int y) { return y * MAP_MAX_WIDTH + x; }
+
+static inline bool Passable(PathGraphLayer layer, int x, int y) {
+    return (layer == PATHGRAPH_NAVAL) ? Map_IsWaterPassable(x, y)
+                                      : Map_IsPassable(x, y);
+}
+
+// Octile distance * 10, matching the unit pathfinder
+static int Heuristic(int x1, int y1, int x2, int y2) {
+    int dx = abs(x2 - x1);
+    int dy = abs(y2 - y1);
+    return (dx > dy) ? dx * 10 + dy * 4 : dy * 10 + dx * 4;
+}
+
+//===========================================================================
+// In-Sector Search
+//
+// Dijkstra over one sector's cells, used to cost entrance pairs, to
+// connect the start and target to the graph, and to refine legs.
+//===========================================================================
+
+struct SectorSearch {
+    int x0, y0, w, h;               // Sector rectangle (clipped to the map)
+    uint16_t dist[SECTOR_CELLS];    // NO_COST if unreached
+    uint8_t parent[SECTOR_CELLS];
+    uint32_t heap[SECTOR_CELLS * 8 + 1];
+    int heapSize;
+};
+
+static SectorSearch g_sectorSearch;
+
+static void SectorRect(int sx, int sy, SectorSearch* s) {
+    s->x0 = sx * PATHGRAPH_SECTOR_SIZE;
+    s->y0 = sy * PATHGRAPH_SECTOR_SIZE;
+    s->w = g_width - s->x0;
+    s->h = g_height - s->y0;
+    if (s->w > PATHGRAPH_SECTOR_SIZE) s->w = PATHGRAPH_SECTOR_SIZE;
+    if (s->h > PATHGRAPH_SECTOR_SIZE) s->h = PATHGRAPH_SECTOR_SIZE;
+}
+
+static inline int LocalIndex(const SectorSearch* s, int cell) {
+    return (GridY(cell) - s->y0) * PATHGRAPH_SECTOR_SIZE + (GridX(cell) - s->x0);
+}
+
+static void SectorHeapPush(SectorSearch* s, uint32_t key) {
+    int i = s->heapSize++;
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (s->heap[p] <= key) break;
+        s->heap[i] = s->heap[p];
+        i = p;
+    }
+    s->heap[i] = key;
+}
+
+static uint32_t SectorHeapPop(SectorSearch* s) {
+    uint32_t top = s->heap[0];
+    uint32_t last = s->heap[--s->heapSize];
+    int n = s->heapSize;
+    if (n > 0) {
+        int i = 0;
+        for (;;) {
+            int c = 2 * i + 1;
+            if (c >= n) break;
+            if (c + 1 < n && s->heap[c + 1] < s->heap[c]) c++;
+            if (last <= s->heap[c]) break;
+            s->heap[i] = s->heap[c];
+            i = c;
+        }
+        s->heap[i] = last;
+    }
+    return top;
+}
+
+// Costs from source to every cell of the sector it lies in, stopping
+// early once target (if >= 0) is settled. Keys pack (cost, local index)
+// so equal costs always settle in the same order.
+static void SectorDijkstra(PathGraphLayer layer, int source, int target,
+                           SectorSearch* s) {
+    SectorRect(GridX(source) / PATHGRAPH_SECTOR_SIZE,
+               GridY(source) / PATHGRAPH_SECTOR_SIZE, s);
+    memset(s->dist, 0xFF, sizeof(s->dist));
+    s->heapSize = 0;
+
+    int src = LocalIndex(s, source);
+    int dst = (target >= 0) ? LocalIndex(s, target) : -1;
+    s->dist[src] = 0;
+    SectorHeapPush(s, (uint32_t)src);
+
+    while (s->heapSize > 0) {
+        uint32_t key = SectorHeapPop(s);
+        int idx = (int)(key & 0xFF);
+        int cost = (int)(key >> 8);
+        if (cost != s->dist[idx]) continue;     // Stale entry
+        g_stats.cellsExpanded++;
+        if (idx == dst) break;
+
+        int lx = idx % PATHGRAPH_SECTOR_SIZE;
+        int ly = idx / PATHGRAPH_SECTOR_SIZE;
+        for (int dir = 0; dir < 8; dir++) {
+            int nx = lx + DIR_DX[dir];
+            int ny = ly + DIR_DY[dir];
+            if (nx < 0 || nx >= s->w || ny < 0 || ny >= s->h) continue;
+            if (!Passable(layer, s->x0 + nx, s->y0 + ny)) continue;
+
+            int nidx = ny * PATHGRAPH_SECTOR_SIZE + nx;
+            int newCost = cost + DIR_COST[dir];
+            if (newCost >= s->dist[nidx]) continue;
+            s->dist[nidx] = (uint16_t)newCost;
+            s->parent[nidx] = (uint8_t)idx;
+            SectorHeapPush(s, ((uint32_t)newCost << 8) | (uint32_t)nidx);
+        }
+    }
+}
+
+//===========================================================================
+// Graph Construction
+//===========================================================================
+
+static void AddEntrance(Entrance* list, int* count, int a, int b) {
+    if (*count >= PATHGRAPH_MAX_ENTRANCES) return;
+    list[*count].a = (uint16_t)a;
+    list[*count].b = (uint16_t)b;
+    (*count)++;
+}
+
+// Turn runs of cells passable on both sides of a border into entrances.
+// step walks along the border; across is the offset to the other side.
+static void BuildBorder(PathGraphLayer layer, int startX, int startY,
+                        int stepX, int stepY, int acrossX, int acrossY,
+                        int length, Entrance* list, int* count) {
+    *count = 0;
+    int runStart = -1;
+    for (int i = 0; i <= length; i++) {
+        int x = startX + stepX * i;
+        int y = startY + stepY * i;
+        bool open = i < length && Passable(layer, x, y) &&
+                    Passable(layer, x + acrossX, y + acrossY);
+        if (open) {
+            if (runStart < 0) runStart = i;
+            continue;
+        }
+        if (runStart < 0) continue;
+
+        int runEnd = i - 1;
+        int picks[2] = { (runStart + runEnd) / 2, -1 };
+        if (runEnd - runStart + 1 >= LONG_RUN) {
+            picks[0] = runStart;
+            picks[1] = runEnd;
+        }
+        for (int p = 0; p < 2 && picks[p] >= 0; p++) {
+            int ax = startX + stepX * picks[p];
+            int ay = startY + stepY * picks[p];
+            AddEntrance(list, count, GridIndex(ax, ay),
+                        GridIndex(ax + acrossX, ay + acrossY));
+        }
+        runStart = -1;
+    }
+}
+
+static void BuildEastBorder(PathGraphLayer layer, LayerGraph* g, int sx, int sy) {
+    g->eastCount[sy][sx] = 0;
+    int x = (sx + 1) * PATHGRAPH_SECTOR_SIZE - 1;
+    if (sx >= g_sectorsX - 1 || x + 1 >= g_width) return;
+
+    int y = sy * PATHGRAPH_SECTOR_SIZE;
+    int length = g_height - y;
+    if (length > PATHGRAPH_SECTOR_SIZE) length = PATHGRAPH_SECTOR_SIZE;
+    BuildBorder(layer, x, y, 0, 1, 1, 0, length, g->east[sy][sx], &g->eastCount[sy][sx]);
+}
+
+static void BuildSouthBorder(PathGraphLayer layer, LayerGraph* g, int sx, int sy) {
+    g->southCount[sy][sx] = 0;
+    int y = (sy + 1) * PATHGRAPH_SECTOR_SIZE - 1;
+    if (sy >= g_sectorsY - 1 || y + 1 >= g_height) return;
+
+    int x = sx * PATHGRAPH_SECTOR_SIZE;
+    int length = g_width - x;
+    if (length > PATHGRAPH_SECTOR_SIZE) length = PATHGRAPH_SECTOR_SIZE;
+    BuildBorder(layer, x, y, 1, 0, 0, 1, length, g->south[sy][sx], &g->southCount[sy][sx]);
+}
+
+static void AddNode(SectorNodes* nodes, int cell, int partner) {
+    int i = 0;
+    while (i < nodes->count && nodes->cell[i] != cell) i++;
+    if (i == nodes->count) {
+        if (nodes->count >= PATHGRAPH_MAX_NODES) return;
+        nodes->cell[i] = (uint16_t)cell;
+        nodes->partnerCount[i] = 0;
+        nodes->count++;
+    }
+    if (nodes->partnerCount[i] < 2) {
+        nodes->partner[i][nodes->partnerCount[i]++] = (uint16_t)partner;
+    }
+}
+
+// Collect the sector's entrance cells from its four borders and cost
+// every pair with an in-sector search
+static void BuildSector(PathGraphLayer layer, LayerGraph* g, int sx, int sy) {
+    SectorNodes* nodes = &g->sectors[sy][sx];
+    for (int i = 0; i < nodes->count; i++) {
+        g->nodeIndex[nodes->cell[i]] = NO_NODE;
+    }
+    nodes->count = 0;
+
+    for (int e = 0; e < g->eastCount[sy][sx]; e++) {
+        AddNode(nodes, g->east[sy][sx][e].a, g->east[sy][sx][e].b);
+    }
+    if (sx > 0) {
+        for (int e = 0; e < g->eastCount[sy][sx - 1]; e++) {
+            AddNode(nodes, g->east[sy][sx - 1][e].b, g->east[sy][sx - 1][e].a);
+        }
+    }
+    for (int e = 0; e < g->southCount[sy][sx]; e++) {
+        AddNode(nodes, g->south[sy][sx][e].a, g->south[sy][sx][e].b);
+    }
+    if (sy > 0) {
+        for (int e = 0; e < g->southCount[sy - 1][sx]; e++) {
+            AddNode(nodes, g->south[sy - 1][sx][e].b, g->south[sy - 1][sx][e].a);
+        }
+    }
+
+    SectorSearch* s = &g_sectorSearch;
+    for (int i = 0; i < nodes->count; i++) {
+        g->nodeIndex[nodes->cell[i]] = (uint8_t)i;
+        SectorDijkstra(layer, nodes->cell[i], -1, s);
+        for (int j = 0; j < nodes->count; j++) {
+            nodes->cost[i][j] = s->dist[LocalIndex(s, nodes->cell[j])];
+        }
+    }
+    g_stats.sectorsRebuilt++;
+}
+
+static void BuildLayer(PathGraphLayer layer) {
+    LayerGraph* g = &g_layers[layer];
+    memset(g->nodeIndex, NO_NODE, sizeof(g->nodeIndex));
+    for (int sy = 0; sy < g_sectorsY; sy++) {
+        for (int sx = 0; sx < g_sectorsX; sx++) {
+            g->sectors[sy][sx].count = 0;
+            BuildEastBorder(layer, g, sx, sy);
+            BuildSouthBorder(layer, g, sx, sy);
+        }
+    }
+    for (int sy = 0; sy < g_sectorsY; sy++) {
+        for (int sx = 0; sx < g_sectorsX; sx++) {
+            BuildSector(layer, g, sx, sy);
+        }
+    }
+    g->built = true;
+    g->dirty = 0;
+    g_stats.fullRebuilds++;
+}
+
+static inline uint64_t SectorBit(int sx, int sy) {
+    return 1ULL << (sy * PATHGRAPH_SECTORS_X + sx);
+}
+
+// Rebuild the borders around each dirty sector, then every sector that
+// owns one of those borders
+static void RepairLayer(PathGraphLayer layer) {
+    LayerGraph* g = &g_layers[layer];
+    uint64_t affected = 0;
+    for (int sy = 0; sy < g_sectorsY; sy++) {
+        for (int sx = 0; sx < g_sectorsX; sx++) {
+            if (!(g->dirty & SectorBit(sx, sy))) continue;
+            BuildEastBorder(layer, g, sx, sy);
+            BuildSouthBorder(layer, g, sx, sy);
+            affected |= SectorBit(sx, sy);
+            if (sx > 0) {
+                BuildEastBorder(layer, g, sx - 1, sy);
+                affected |= SectorBit(sx - 1, sy);
+            }
+            if (sy > 0) {
+                BuildSouthBorder(layer, g, sx, sy - 1);
+                affected |= SectorBit(sx, sy - 1);
+            }
+            if (sx + 1 < g_sectorsX) affected |= SectorBit(sx + 1, sy);
+            if (sy + 1 < g_sectorsY) affected |= SectorBit(sx, sy + 1);
+        }
+    }
+    for (int sy = 0; sy < g_sectorsY; sy++) {
+        for (int sx = 0; sx < g_sectorsX; sx++) {
+            if (affected & SectorBit(sx, sy)) BuildSector(layer, g, sx, sy);
+        }
+    }
+    g->dirty = 0;
+}
+
+// Fold the map's terrain change list into the layers' dirty sectors
+static void SyncWithMap(void) {
+    const uint16_t* changes = nullptr;
+    int count = Map_GetTerrainChanges(&changes);
+
+    if (count < 0 || Map_GetWidth() != g_width || Map_GetHeight() != g_height) {
+        g_width = Map_GetWidth();
+        g_height = Map_GetHeight();
+        g_sectorsX = (g_width + PATHGRAPH_SECTOR_SIZE - 1) / PATHGRAPH_SECTOR_SIZE;
+        g_sectorsY = (g_height + PATHGRAPH_SECTOR_SIZE - 1) / PATHGRAPH_SECTOR_SIZE;
+        for (int l = 0; l < PATHGRAPH_LAYER_COUNT; l++) {
+            g_layers[l].built = false;
+        }
+    } else {
+        for (int i = 0; i < count; i++) {
+            uint64_t bit = SectorBit(GridX(changes[i]) / PATHGRAPH_SECTOR_SIZE,
+                                     GridY(changes[i]) / PATHGRAPH_SECTOR_SIZE);
+            for (int l = 0; l < PATHGRAPH_LAYER_COUNT; l++) {
+                g_layers[l].dirty |= bit;
+            }
+        }
+    }
+    Map_ClearTerrainChanges();
+}
+
+void PathGraph_Invalidate(void) {
+    for (int l = 0; l < PATHGRAPH_LAYER_COUNT; l++) {
+        g_layers[l].built = false;
+    }
+}
+
+//===========================================================================
+// Abstract Search
+//===========================================================================
+
+struct GraphNode {
+    uint64_t key;               // (f, h, cell) as in the unit pathfinder
+    int32_t g;
+    uint16_t cell;
+};
+
+static const int GRAPH_HEAP_CAPACITY =
+    PATHGRAPH_SECTORS_X * PATHGRAPH_SECTORS_Y * PATHGRAPH_MAX_NODES * (PATHGRAPH_MAX_NODES + 2) + 2;
+
+struct GraphWorkspace {
+    uint32_t generation;
+    uint32_t visitGen[GRID_CELLS];
+    uint32_t closedGen[GRID_CELLS];
+    int32_t gScore[GRID_CELLS];
+    uint16_t parent[GRID_CELLS];
+    GraphNode heap[GRAPH_HEAP_CAPACITY];
+    int heapSize;
+    uint16_t startCost[SECTOR_CELLS];   // From the start, within its sector
+    uint16_t goalCost[SECTOR_CELLS];    // To the target, within its sector
+    uint16_t route[GRID_CELLS];         // Abstract path, target first
+};
+
+static GraphWorkspace g_graphWork;
+
+static void GraphHeapPush(uint64_t key, int g, int cell) {
+    GraphWorkspace* ws = &g_graphWork;
+    if (ws->heapSize >= GRAPH_HEAP_CAPACITY) return;
+
+    GraphNode* heap = ws->heap;
+    int i = ws->heapSize++;
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (heap[p].key <= key) break;
+        heap[i] = heap[p];
+        i = p;
+    }
+    heap[i].key = key;
+    heap[i].g = g;
+    heap[i].cell = (uint16_t)cell;
+}
+
+static GraphNode GraphHeapPop(void) {
+    GraphWorkspace* ws = &g_graphWork;
+    GraphNode* heap = ws->heap;
+    GraphNode top = heap[0];
+    GraphNode last = heap[--ws->heapSize];
+
+    int n = ws->heapSize;
+    if (n > 0) {
+        int i = 0;
+        for (;;) {
+            int c = 2 * i + 1;
+            if (c >= n) break;
+            if (c + 1 < n && heap[c + 1].key < heap[c].key) c++;
+            if (last.key <= heap[c].key) break;
+            heap[i] = heap[c];
+            i = c;
+        }
+        heap[i] = last;
+    }
+    return top;
+}
+
+static void Relax(int from, int g, int cell, int cost, int goal) {
+    GraphWorkspace* ws = &g_graphWork;
+    if (cost == NO_COST || ws->closedGen[cell] == ws->generation) return;
+
+    int newG = g + cost;
+    if (ws->visitGen[cell] == ws->generation && newG >= ws->gScore[cell]) return;
+    ws->visitGen[cell] = ws->generation;
+    ws->gScore[cell] = newG;
+    ws->parent[cell] = (uint16_t)from;
+
+    int h = Heuristic(GridX(cell), GridY(cell), GridX(goal), GridY(goal));
+    GraphHeapPush(((uint64_t)(newG + h) << 40) | ((uint64_t)h << 20) | (uint64_t)cell,
+                  newG, cell);
+}
+
+static inline int SectorOf(int cell) {
+    return (GridY(cell) / PATHGRAPH_SECTOR_SIZE) * PATHGRAPH_SECTORS_X +
+           GridX(cell) / PATHGRAPH_SECTOR_SIZE;
+}
+
+// A* from start to goal over entrance nodes. Returns the route length
+// (goal first in ws->route), or 0 if the graph has no route.
+static int SearchGraph(PathGraphLayer layer, int start, int goal) {
+    LayerGraph* g = &g_layers[layer];
+    GraphWorkspace* ws = &g_graphWork;
+    SectorSearch* s = &g_sectorSearch;
+
+    // Connect the endpoints to their sectors' entrances
+    SectorDijkstra(layer, start, -1, s);
+    memcpy(ws->startCost, s->dist, sizeof(ws->startCost));
+    int startX0 = s->x0, startY0 = s->y0;
+    SectorDijkstra(layer, goal, -1, s);
+    memcpy(ws->goalCost, s->dist, sizeof(ws->goalCost));
+    int goalX0 = s->x0, goalY0 = s->y0;
+
+    ws->generation++;
+    if (ws->generation == 0) {
+        memset(ws->visitGen, 0, sizeof(ws->visitGen));
+        memset(ws->closedGen, 0, sizeof(ws->closedGen));
+        ws->generation = 1;
+    }
+    ws->heapSize = 0;
+
+    int goalSector = SectorOf(goal);
+    ws->visitGen[start] = ws->generation;
+    ws->gScore[start] = 0;
+    GraphHeapPush(0, 0, start);
+
+    while (ws->heapSize > 0) {
+        GraphNode current = GraphHeapPop();
+        int cell = current.cell;
+        if (ws->closedGen[cell] == ws->generation) continue;
+        ws->closedGen[cell] = ws->generation;
+        g_stats.abstractExpanded++;
+
+        if (cell == goal) {
+            int length = 0;
+            for (int c = goal; c != start; c = ws->parent[c]) {
+                ws->route[length++] = (uint16_t)c;
+            }
+            return length;
+        }
+
+        int x = GridX(cell);
+        int y = GridY(cell);
+        int sector = SectorOf(cell);
+        const SectorNodes* nodes = &g->sectors[y / PATHGRAPH_SECTOR_SIZE]
+                                              [x / PATHGRAPH_SECTOR_SIZE];
+
+        if (cell == start) {
+            for (int j = 0; j < nodes->count; j++) {
+                int c = nodes->cell[j];
+                int local = (GridY(c) - startY0) * PATHGRAPH_SECTOR_SIZE + (GridX(c) - startX0);
+                Relax(cell, current.g, c, ws->startCost[local], goal);
+            }
+        }
+
+        int i = g->nodeIndex[cell];
+        if (i != NO_NODE) {
+            for (int j = 0; j < nodes->count; j++) {
+                if (j != i) Relax(cell, current.g, nodes->cell[j], nodes->cost[i][j], goal);
+            }
+            for (int p = 0; p < nodes->partnerCount[i]; p++) {
+                Relax(cell, current.g, nodes->partner[i][p], 10, goal);
+            }
+        }
+
+        if (sector == goalSector) {
+            int local = (y - goalY0) * PATHGRAPH_SECTOR_SIZE + (x - goalX0);
+            Relax(cell, current.g, goal, ws->goalCost[local], goal);
+        }
+    }
+    return 0;
+}
+
+// Append the in-sector cells from one route point to the next
+static bool RefineLeg(PathGraphLayer layer, int from, int to,
+                      int16_t* outCells, int maxCells, int* count) {
+    int dx = abs(GridX(to) - GridX(from));
+    int dy = abs(GridY(to) - GridY(from));
+    if (dx <= 1 && dy <= 1) {
+        outCells[(*count)++] = (int16_t)(GridY(to) * g_width + GridX(to));
+        return true;
+    }
+    if (SectorOf(from) != SectorOf(to)) return false;
+
+    SectorSearch* s = &g_sectorSearch;
+    SectorDijkstra(layer, from, to, s);
+    int src = LocalIndex(s, from);
+    int dst = LocalIndex(s, to);
+    if (s->dist[dst] == NO_COST) return false;
+
+    uint8_t leg[SECTOR_CELLS];
+    int legLength = 0;
+    for (int c = dst; c != src; c = s->parent[c]) leg[legLength++] = (uint8_t)c;
+
+    for (int i = legLength - 1; i >= 0 && *count < maxCells; i--) {
+        int x = s->x0 + leg[i] % PATHGRAPH_SECTOR_SIZE;
+        int y = s->y0 + leg[i] / PATHGRAPH_SECTOR_SIZE;
+        outCells[(*count)++] = (int16_t)(y * g_width + x);
+    }
+    return true;
+}
+
+//===========================================================================
+// Public API
+//===========================================================================
+
+BOOL PathGraph_IsLongPath(int startX, int startY, int targetX, int targetY) {
+    int dx = abs(targetX / PATHGRAPH_SECTOR_SIZE - startX / PATHGRAPH_SECTOR_SIZE);
+    int dy = abs(targetY / PATHGRAPH_SECTOR_SIZE - startY / PATHGRAPH_SECTOR_SIZE);
+    return (dx >= 2 || dy >= 2) ? TRUE : FALSE;
+}
+
+int PathGraph_ProbeBudget(int startX, int startY, int targetX, int targetY) {
+    int dx = abs(targetX - startX);
+    int dy = abs(targetY - startY);
+    int distance = (dx > dy) ? dx : dy;
+    if (distance >= PATHGRAPH_FAR_CELLS) return 0;
+    return distance * PATHGRAPH_PROBE_PER_CELL;
+}
+
+int PathGraph_FindPath(PathGraphLayer layer, int startX, int startY,
+                       int targetX, int targetY,
+                       int16_t* outCells, int maxCells, BOOL* partial) {
+    if (partial) *partial = FALSE;
+    if (layer < 0 || layer >= PATHGRAPH_LAYER_COUNT || maxCells <= 0) return -1;
+    g_stats.searches++;
+
+    SyncWithMap();
+    if (startX < 0 || startX >= g_width || startY < 0 || startY >= g_height ||
+        targetX < 0 || targetX >= g_width || targetY < 0 || targetY >= g_height) {
+        return -1;
+    }
+
+    LayerGraph* g = &g_layers[layer];
+    if (!g->built) {
+        BuildLayer(layer);
+    } else if (g->dirty) {
+        RepairLayer(layer);
+    }
+
+    int start = GridIndex(startX, startY);
+    int goal = GridIndex(targetX, targetY);
+    if (start == goal) return 0;
+
+    int routeLength = SearchGraph(layer, start, goal);
+    if (routeLength == 0) return -1;
+
+    // Refine legs in order until the caller's buffer is full
+    GraphWorkspace* ws = &g_graphWork;
+    int count = 0;
+    int from = start;
+    for (int r = routeLength - 1; r >= 0 && count < maxCells; r--) {
+        int to = ws->route[r];
+        if (!RefineLeg(layer, from, to, outCells, maxCells, &count)) return -1;
+        from = to;
+    }
+
+    int last = (count > 0) ? outCells[count - 1] : -1;
+    if (partial && last != targetY * g_width + targetX) *partial = TRUE;
+    return count;
+}
+
+const PathGraphStats* PathGraph_GetStats(void) {
+    return &g_stats;
+}
+
+void PathGraph_ResetStats(void) {
+    memset(&g_stats, 0, sizeof(g_stats));
+}
@@ -0,0 +1,94 @@
+/**
+ * Red Alert macOS Port - Hierarchical Path Graph
+ *
+ * HPA*-style abstraction of the map.cpp cell grid. The map is cut into
+ * 16x16 sectors; every passable run along a sector border gets one or two
+ * entrances, and each sector stores the in-sector travel cost between its
+ * entrance cells. Long searches run over this small graph and only the
+ * legs needed to fill the caller's waypoint buffer are refined back into
+ * cells.
+ *
+ * The graph follows passability through Map_SetTerrain()'s change list:
+ * sectors with edits (building placed or removed, ore cleared, walls) are
+ * rebuilt on the next search along with their neighbours' borders. A new
+ * map rebuilds everything.
+ *
+ * Only the realtime unit pathfinder in units.cpp plans over the graph.
+ * The OO PathFinder (pathfind.cpp) searches MapClass, a separate grid the
+ * graph doesn't track, and stays a flat A*.
+ */
+
+#ifndef GAME_PATHGRAPH_H
+#define GAME_PATHGRAPH_H
+
+#include "map.h"
+
+#define PATHGRAPH_SECTOR_SIZE       16
+#define PATHGRAPH_SECTORS_X         (MAP_MAX_WIDTH / PATHGRAPH_SECTOR_SIZE)
+#define PATHGRAPH_SECTORS_Y         (MAP_MAX_HEIGHT / PATHGRAPH_SECTOR_SIZE)
+
+// A border of 16 cells splits into at most 8 passable runs
+#define PATHGRAPH_MAX_ENTRANCES     8
+#define PATHGRAPH_MAX_NODES         (4 * PATHGRAPH_MAX_ENTRANCES)
+
+// Trips at least this many cells long plan over the graph outright;
+// shorter long trips only move to it once a flat search of
+// PATHGRAPH_PROBE_PER_CELL expansions per cell of distance runs out
+#define PATHGRAPH_FAR_CELLS         64
+#define PATHGRAPH_PROBE_PER_CELL    6
+
+// Passability layers (aircraft fly straight and don't need one)
+typedef enum {
+    PATHGRAPH_GROUND = 0,       // Map_IsPassable
+    PATHGRAPH_NAVAL,            // Map_IsWaterPassable
+    PATHGRAPH_LAYER_COUNT
+} PathGraphLayer;
+
+// Counters since the last PathGraph_ResetStats()
+typedef struct {
+    uint32_t searches;          // PathGraph_FindPath calls
+    uint32_t abstractExpanded;  // Sector graph nodes expanded
+    uint32_t cellsExpanded;     // Cells expanded connecting and refining
+    uint32_t sectorsRebuilt;    // Sector repairs (including full builds)
+    uint32_t fullRebuilds;      // Whole-layer builds
+} PathGraphStats;
+
+/**
+ * Check if a trip spans enough sectors to plan hierarchically (start and
+ * target at least two sectors apart on either axis)
+ */
+BOOL PathGraph_IsLongPath(int startX, int startY, int targetX, int targetY);
+
+/**
+ * Flat A* expansions a long trip should spend before it counts as blocked
+ * and is handed to the graph. On open ground the flat search finishes
+ * well inside this and beats the graph; behind walls or water it doesn't.
+ * @return 0 if the trip is far enough to go straight to the graph
+ */
+int PathGraph_ProbeBudget(int startX, int startY, int targetX, int targetY);
+
+/**
+ * Plan a path over the sector graph and refine its first cells.
+ * Moves are 8-way with the unit pathfinder's costs (10 straight, 14
+ * diagonal). The target must be passable.
+ * @param outCells  Receives cell indices (y * map width + x), start excluded
+ * @param maxCells  Cells to refine; the rest of the route is dropped
+ * @param partial   Set to TRUE if the cells stop short of the target
+ * @return Number of cells written, or -1 if the graph has no route
+ */
+int PathGraph_FindPath(PathGraphLayer layer, int startX, int startY,
+                       int targetX, int targetY,
+                       int16_t* outCells, int maxCells, BOOL* partial);
+
+/**
+ * Drop the graph so the next search rebuilds it from the map
+ */
+void PathGraph_Invalidate(void);
+
+/**
+ * Statistics
+ */
+const PathGraphStats* PathGraph_GetStats(void);
+void PathGraph_ResetStats(void);
+
+#endif // GAME_PATHGRAPH_H
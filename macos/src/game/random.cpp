@@ -0,0 +1,101 @@
+/**
+ * Red Alert macOS Port - Deterministic Random Numbers Implementation
+ *
+ * xoshiro128** (Blackman & Vigna), seeded through splitmix64.
+ */
+
+#include "random.h"
+
+static inline uint32_t Rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+static uint64_t SplitMix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+//===========================================================================
+// Generator
+//===========================================================================
+
+void Random_SeedState(RandomState* state, uint64_t seed) {
+    // splitmix64 never yields an all-zero xoshiro state
+    uint64_t a = SplitMix64(&seed);
+    uint64_t b = SplitMix64(&seed);
+    state->s[0] = static_cast<uint32_t>(a);
+    state->s[1] = static_cast<uint32_t>(a >> 32);
+    state->s[2] = static_cast<uint32_t>(b);
+    state->s[3] = static_cast<uint32_t>(b >> 32);
+}
+
+uint32_t Random_NextState(RandomState* state) {
+    uint32_t* s = state->s;
+    uint32_t result = Rotl(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = Rotl(s[3], 11);
+    return result;
+}
+
+int Random_RangeState(RandomState* state, int bound) {
+    if (bound <= 0) return 0;
+    // Multiply-shift reduction: no division, bias below 2^-32 * bound
+    uint64_t product = static_cast<uint64_t>(Random_NextState(state)) *
+                       static_cast<uint32_t>(bound);
+    return static_cast<int>(product >> 32);
+}
+
+//===========================================================================
+// Streams
+//===========================================================================
+
+// Cosmetic stream seed is offset so the two streams never coincide
+static constexpr uint64_t COSMETIC_SEED_SALT = 0xC05E71C5A17ULL;
+
+static uint64_t g_seed = 1;
+static RandomState g_simRandom;
+static RandomState g_cosmeticRandom;
+static bool g_seeded = false;
+
+static void EnsureSeeded() {
+    if (!g_seeded) Random_Seed(g_seed);
+}
+
+void Random_Seed(uint64_t seed) {
+    g_seed = seed;
+    Random_SeedState(&g_simRandom, seed);
+    Random_SeedState(&g_cosmeticRandom, seed ^ COSMETIC_SEED_SALT);
+    g_seeded = true;
+}
+
+uint64_t Random_GetSeed(void) {
+    return g_seed;
+}
+
+int Random_Sim(int bound) {
+    EnsureSeeded();
+    return Random_RangeState(&g_simRandom, bound);
+}
+
+int Random_Cosmetic(int bound) {
+    EnsureSeeded();
+    return Random_RangeState(&g_cosmeticRandom, bound);
+}
+
+void Random_GetSimState(RandomState* state) {
+    EnsureSeeded();
+    *state = g_simRandom;
+}
+
+void Random_SetSimState(const RandomState* state) {
+    EnsureSeeded();
+    g_simRandom = *state;
+}
@@ -0,0 +1,71 @@
+/**
+ * Red Alert macOS Port - Deterministic Random Numbers
+ *
+ * xoshiro128** generators with explicit state. The simulation stream
+ * drives everything that changes game state (AI choices, scatter, ore
+ * growth, idle timers) and is saved with the game, so a given seed and
+ * input sequence always plays out the same on every platform. The
+ * cosmetic stream covers sound, music and visual variety; drawing from
+ * it never perturbs the simulation.
+ */
+
+#ifndef GAME_RANDOM_H
+#define GAME_RANDOM_H
+
+#include <cstdint>
+
+//===========================================================================
+// Generator State
+//===========================================================================
+
+struct RandomState {
+    uint32_t s[4];
+};
+
+/**
+ * Seed a generator. Any seed (including 0) gives a valid state.
+ */
+void Random_SeedState(RandomState* state, uint64_t seed);
+
+/**
+ * Next 32 raw bits
+ */
+uint32_t Random_NextState(RandomState* state);
+
+/**
+ * Uniform value in [0, bound); 0 if bound <= 0
+ */
+int Random_RangeState(RandomState* state, int bound);
+
+//===========================================================================
+// Simulation and Cosmetic Streams
+//===========================================================================
+
+/**
+ * Seed both streams for a new game. The cosmetic stream is derived from
+ * the same seed but never shares values with the simulation stream.
+ */
+void Random_Seed(uint64_t seed);
+
+/**
+ * Seed the game was last started with
+ */
+uint64_t Random_GetSeed(void);
+
+/**
+ * Simulation stream: uniform value in [0, bound)
+ */
+int Random_Sim(int bound);
+
+/**
+ * Cosmetic stream: uniform value in [0, bound)
+ */
+int Random_Cosmetic(int bound);
+
+/**
+ * Simulation stream state, for save/load and desync checks
+ */
+void Random_GetSimState(RandomState* state);
+void Random_SetSimState(const RandomState* state);
+
+#endif // GAME_RANDOM_H
@@ -0,0 +1,115 @@
+/**
+ * Red Alert macOS Port - Remapped Sprite Cache Implementation
+ */
+
+#include "remapcache.h"
+#include <wwd/span_sprite.h>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+struct RemapKey {
+    ShpFileHandle shp;
+    int index;
+    const uint8_t* remap;
+
+    bool operator==(const RemapKey& other) const {
+        return shp == other.shp && index == other.index && remap == other.remap;
+    }
+};
+
+struct RemapKeyHash {
+    size_t operator()(const RemapKey& key) const {
+        size_t h = std::hash<const void*>()(key.shp);
+        h = h * 31 + std::hash<const void*>()(key.remap);
+        return h * 31 + (size_t)key.index;
+    }
+};
+
+struct RemapEntry {
+    RemapKey key;
+    std::vector<uint8_t> spans;
+};
+
+// Most recently drawn at the front
+static std::list<RemapEntry> g_lru;
+static std::unordered_map<RemapKey, std::list<RemapEntry>::iterator, RemapKeyHash> g_index;
+static RemapCacheStats g_stats = { 0, 0, 0, 0, 0, 0, REMAPCACHE_DEFAULT_BUDGET };
+
+static void EvictToBudget(uint32_t budget) {
+    while (g_stats.bytes > budget && !g_lru.empty()) {
+        RemapEntry& oldest = g_lru.back();
+        g_stats.bytes -= (uint32_t)oldest.spans.size();
+        g_stats.entries--;
+        g_stats.evictions++;
+        g_index.erase(oldest.key);
+        g_lru.pop_back();
+    }
+}
+
+const uint8_t* RemapCache_Get(ShpFileHandle shp, int index,
+                              const ShpFrame* frame, const uint8_t* remap) {
+    if (!frame || !frame->spans || !remap) return nullptr;
+    g_stats.lookups++;
+
+    RemapKey key = { shp, index, remap };
+    auto found = g_index.find(key);
+    if (found != g_index.end()) {
+        g_lru.splice(g_lru.begin(), g_lru, found->second);
+        g_stats.hits++;
+        return found->second->spans.data();
+    }
+
+    g_stats.misses++;
+    size_t size = Wwd_SpanSprite_Size(frame->spans, frame->height);
+    if (size == 0 || size > g_stats.budget) return nullptr;
+
+    // Make room first so the new copy is never the one evicted
+    EvictToBudget(g_stats.budget - (uint32_t)size);
+
+    g_lru.push_front(RemapEntry{ key, std::vector<uint8_t>(size) });
+    RemapEntry& entry = g_lru.front();
+    Wwd_SpanSprite_Remap(frame->spans, frame->height, remap, entry.spans.data());
+    g_index[key] = g_lru.begin();
+    g_stats.entries++;
+    g_stats.bytes += (uint32_t)size;
+    return entry.spans.data();
+}
+
+void RemapCache_SetBudget(uint32_t bytes) {
+    g_stats.budget = bytes;
+    EvictToBudget(bytes);
+}
+
+void RemapCache_Forget(ShpFileHandle shp) {
+    for (auto it = g_lru.begin(); it != g_lru.end();) {
+        if (it->key.shp != shp) {
+            ++it;
+            continue;
+        }
+        g_stats.bytes -= (uint32_t)it->spans.size();
+        g_stats.entries--;
+        g_index.erase(it->key);
+        it = g_lru.erase(it);
+    }
+}
+
+void RemapCache_Clear(void) {
+    g_index.clear();
+    g_lru.clear();
+    g_stats.entries = 0;
+    g_stats.bytes = 0;
+}
+
+const RemapCacheStats* RemapCache_GetStats(void) {
+    return &g_stats;
+}
+
+void RemapCache_ResetStats(void) {
+    g_stats.lookups = 0;
+    g_stats.hits = 0;
+    g_stats.misses = 0;
+    g_stats.evictions = 0;
+}
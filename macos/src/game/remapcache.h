@@ -0,0 +1,65 @@
+/**
+ * Red Alert macOS Port - Remapped Sprite Cache
+ *
+ * Keeps team-coloured copies of span-encoded SHP frames, keyed by SHP,
+ * frame and remap table, so a unit drawn every frame pays for its house
+ * colour once and then blits like an unremapped sprite. Copies are made
+ * on first use and the least recently drawn are dropped once the cache
+ * holds more than its byte budget.
+ *
+ * Entries are keyed by SHP handle: call RemapCache_Forget() before
+ * freeing an SHP so a later one at the same address can't match them.
+ */
+
+#ifndef GAME_REMAPCACHE_H
+#define GAME_REMAPCACHE_H
+
+#include "assets/shpfile.h"
+
+#define REMAPCACHE_DEFAULT_BUDGET   (2 * 1024 * 1024)   // Bytes of frame data
+
+// Counters since the last RemapCache_ResetStats(), plus current usage
+typedef struct {
+    uint32_t lookups;           // RemapCache_Get calls
+    uint32_t hits;              // Served an existing copy
+    uint32_t misses;            // Had to remap a new copy
+    uint32_t evictions;         // Copies dropped to stay in budget
+    uint32_t entries;           // Copies held now
+    uint32_t bytes;             // Frame data held now
+    uint32_t budget;            // Byte budget
+} RemapCacheStats;
+
+/**
+ * Team-coloured copy of a frame's spans, made on a miss.
+ * @param shp    SHP the frame belongs to
+ * @param index  Frame index within the SHP
+ * @param frame  The frame itself (Shp_GetFrame(shp, index))
+ * @param remap  256-byte remap table
+ * @return Encoded spans to blit without a remap table, or NULL if the
+ *         frame has no spans or is larger than the whole budget
+ */
+const uint8_t* RemapCache_Get(ShpFileHandle shp, int index,
+                              const ShpFrame* frame, const uint8_t* remap);
+
+/**
+ * Set the byte budget, evicting down to it straight away
+ */
+void RemapCache_SetBudget(uint32_t bytes);
+
+/**
+ * Drop every copy made from an SHP (call before freeing it)
+ */
+void RemapCache_Forget(ShpFileHandle shp);
+
+/**
+ * Drop every copy
+ */
+void RemapCache_Clear(void);
+
+/**
+ * Statistics
+ */
+const RemapCacheStats* RemapCache_GetStats(void);
+void RemapCache_ResetStats(void);
+
+#endif // GAME_REMAPCACHE_H
@@ -0,0 +1,521 @@
+/**
+ * Red Alert macOS Port - Input Replays Implementation
+ *
+ * File layout (little-endian):
+ *   "RARP", version u16, hash interval u16, seed u64, ticks u32,
+ *   commands u32, start credits i32, map width/height u16, tick 0 hash u32,
+ *   scenario name (length-prefixed)
+ *   commands: tick delta (varint), type u8, then the type's arguments
+ *             (zigzag varints)
+ *   hashes:   u32 per interval
+ */
+
+#include "replay.h"
+#include "units.h"
+#include "map.h"
+#include "random.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#define REPLAY_MAGIC    0x50524152  // "RARP"
+#define REPLAY_VERSION  1
+
+// Arguments stored per command type
+static const uint8_t COMMAND_ARGS[REPLAY_CMD_COUNT] = {
+    3,  // MOVE
+    2,  // ATTACK
+    3,  // ATTACK_MOVE
+    3,  // FORCE_ATTACK
+    1,  // STOP
+    1,  // GUARD
+    2,  // LOAD
+    1,  // UNLOAD
+    1,  // HUNT
+    1,  // CREDITS
+    3,  // PLACE_BUILDING
+    2,  // SELL
+    3,  // SPAWN_UNIT
+};
+
+typedef enum {
+    REPLAY_IDLE = 0,
+    REPLAY_RECORDING,
+    REPLAY_PLAYING
+} ReplayMode;
+
+static struct {
+    ReplayMode mode = REPLAY_IDLE;
+    uint32_t tick = 0;
+    uint64_t chain = 0;         // Running hash of every tick so far
+    int divergedTick = -1;
+
+    ReplayInfo info = {};
+    uint32_t startHash = 0;
+    std::vector<ReplayCommand> commands;
+    std::vector<uint32_t> hashes;
+    size_t nextCommand = 0;     // Playback cursor
+} g_replay{};
+
+//===========================================================================
+// State Hash
+//
+// One multiply-xorshift per 64-bit word over named fields, so padding and
+// UI-only members never reach the hash. Live units and buildings change
+// most ticks and are rehashed; cells keep a cached hash each, refreshed
+// from the map's state change list, and contribute their wrapping sum.
+//===========================================================================
+
+static inline uint64_t Mix(uint64_t hash, uint64_t word) {
+    hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+    return hash ^ (hash >> 29);
+}
+
+static inline uint64_t Pack16(int a, int b, int c, int d) {
+    return (uint64_t)(uint16_t)a | ((uint64_t)(uint16_t)b << 16) |
+           ((uint64_t)(uint16_t)c << 32) | ((uint64_t)(uint16_t)d << 48);
+}
+
+static inline uint64_t Pack32(int32_t a, int32_t b) {
+    return (uint64_t)(uint32_t)a | ((uint64_t)(uint32_t)b << 32);
+}
+
+// Selection is UI state; the replay never reproduces it. The path is
+// covered by its cursor and next waypoint: a different route shows up in
+// the position a few ticks later.
+static uint64_t HashUnit(uint64_t hash, const Unit* u) {
+    hash = Mix(hash, Pack16(u->type, u->team, u->state, u->facing));
+    hash = Mix(hash, Pack32(u->worldX, u->worldY));
+    hash = Mix(hash, Pack32(u->targetX, u->targetY));
+    hash = Mix(hash, Pack32(u->nextWaypointX, u->nextWaypointY));
+    hash = Mix(hash, Pack16(u->health, u->maxHealth, u->targetUnit, u->speed));
+    hash = Mix(hash, Pack16(u->attackRange, u->attackDamage, u->attackCooldown,
+                            u->attackRate));
+    hash = Mix(hash, Pack16(u->sightRange, u->pathLength, u->pathIndex, u->cargo));
+    hash = Mix(hash, Pack16(u->homeRefinery, u->harvestTimer, u->lastAttacker,
+                            u->scatterTimer));
+    hash = Mix(hash, Pack16(u->passengerCount, u->transportId, u->loadTarget,
+                            u->pathPartial | (u->repathDelay << 8)));
+    for (int i = 0; i < u->passengerCount && i < MAX_PASSENGERS; i++) {
+        hash = Mix(hash, (uint64_t)(uint16_t)u->passengers[i]);
+    }
+    return hash;
+}
+
+static uint64_t HashBuilding(uint64_t hash, const Building* b) {
+    hash = Mix(hash, Pack16(b->type, b->team, b->health, b->maxHealth));
+    hash = Mix(hash, Pack16(b->cellX, b->cellY, b->width, b->height));
+    return Mix(hash, Pack16(b->attackCooldown, b->sightRange, 0, 0));
+}
+
+static uint64_t HashEntities(void) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (int i = 0; i < MAX_UNITS; i++) {
+        const Unit* unit = Units_Get(i);
+        if (!unit) continue;
+        hash = HashUnit(Mix(hash, (uint64_t)i), unit);
+    }
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        const Building* bld = Buildings_Get(i);
+        if (!bld) continue;
+        hash = HashBuilding(Mix(hash, (uint64_t)i), bld);
+    }
+    return hash;
+}
+
+// Seeded with the cell index so equal cells in different places differ
+static uint64_t HashCell(int x, int y) {
+    const MapCell* c = Map_GetCell(x, y);
+    uint64_t hash = Mix(0x84222325CBF29CE4ULL, (uint64_t)(y * MAP_MAX_WIDTH + x));
+    hash = Mix(hash, (uint64_t)c->terrain | ((uint64_t)c->flags << 8) |
+                     ((uint64_t)c->height << 16) | ((uint64_t)c->oreAmount << 24) |
+                     ((uint64_t)(uint16_t)c->unitId << 32) |
+                     ((uint64_t)(uint16_t)c->buildingId << 48));
+    hash = Mix(hash, (uint64_t)c->occupantCount | ((uint64_t)c->occupantStored << 8) |
+                     ((uint64_t)c->occupants[0] << 16) |
+                     ((uint64_t)c->occupants[1] << 32) |
+                     ((uint64_t)c->occupants[2] << 48));
+    return Mix(hash, c->occupants[3]);
+}
+
+static uint64_t g_cellHash[MAP_MAX_WIDTH * MAP_MAX_HEIGHT];
+static uint64_t g_cellSum = 0;
+
+// Bring the cached cell hashes up to date with the map
+static void FoldCellChanges(void) {
+    const uint16_t* cells = nullptr;
+    int count = Map_GetStateChanges(&cells);
+    if (count < 0) {
+        g_cellSum = 0;
+        for (int y = 0; y < Map_GetHeight(); y++) {
+            for (int x = 0; x < Map_GetWidth(); x++) {
+                uint64_t h = HashCell(x, y);
+                g_cellHash[y * MAP_MAX_WIDTH + x] = h;
+                g_cellSum += h;
+            }
+        }
+    } else {
+        for (int i = 0; i < count; i++) {
+            uint64_t h = HashCell(cells[i] % MAP_MAX_WIDTH, cells[i] / MAP_MAX_WIDTH);
+            g_cellSum += h - g_cellHash[cells[i]];
+            g_cellHash[cells[i]] = h;
+        }
+    }
+    Map_ClearStateChanges();
+}
+
+static uint64_t CombineHash(uint64_t entities, uint64_t cellSum) {
+    uint64_t hash = Mix(entities, Pack16(Map_GetWidth(), Map_GetHeight(), 0, 0));
+    hash = Mix(hash, cellSum);
+    return Mix(hash, (uint64_t)(uint32_t)Units_GetPlayerCredits());
+}
+
+uint64_t Replay_HashState(void) {
+    FoldCellChanges();
+    return CombineHash(HashEntities(), g_cellSum);
+}
+
+uint64_t Replay_HashStateFull(void) {
+    uint64_t cellSum = 0;
+    for (int y = 0; y < Map_GetHeight(); y++) {
+        for (int x = 0; x < Map_GetWidth(); x++) {
+            cellSum += HashCell(x, y);
+        }
+    }
+    return CombineHash(HashEntities(), cellSum);
+}
+
+//===========================================================================
+// Commands
+//===========================================================================
+
+ReplayPhase Replay_GetPhase(ReplayCommandType type) {
+    return (type == REPLAY_CMD_SPAWN_UNIT) ? REPLAY_PHASE_PRODUCTION
+                                           : REPLAY_PHASE_INPUT;
+}
+
+static int ApplyCommand(const ReplayCommand& cmd) {
+    const int32_t* a = cmd.args;
+    switch (cmd.type) {
+        case REPLAY_CMD_MOVE:         Units_CommandMove(a[0], a[1], a[2]); return 0;
+        case REPLAY_CMD_ATTACK:       Units_CommandAttack(a[0], a[1]); return 0;
+        case REPLAY_CMD_ATTACK_MOVE:  Units_CommandAttackMove(a[0], a[1], a[2]); return 0;
+        case REPLAY_CMD_FORCE_ATTACK: Units_CommandForceAttack(a[0], a[1], a[2]); return 0;
+        case REPLAY_CMD_STOP:         Units_CommandStop(a[0]); return 0;
+        case REPLAY_CMD_GUARD:        Units_CommandGuard(a[0]); return 0;
+        case REPLAY_CMD_LOAD:         Units_CommandLoad(a[0], a[1]); return 0;
+        case REPLAY_CMD_UNLOAD:       return Units_UnloadTransport(a[0]);
+        case REPLAY_CMD_HUNT:         return Units_CommandAllHunt((Team)a[0]);
+        case REPLAY_CMD_CREDITS:      Units_AddPlayerCredits(a[0]); return 0;
+        case REPLAY_CMD_PLACE_BUILDING:
+            return Buildings_Spawn((BuildingType)a[0], TEAM_PLAYER, a[1], a[2]);
+        case REPLAY_CMD_SELL:
+            if (!Buildings_Get(a[0])) return -1;
+            Units_AddPlayerCredits(a[1]);
+            Buildings_Remove(a[0]);
+            return 0;
+        case REPLAY_CMD_SPAWN_UNIT: {
+            // No free spot by the factory: scatter near the map corner.
+            // Drawn here so playback consumes the same random numbers.
+            int x = a[1];
+            int y = a[2];
+            if (x < 0 || y < 0) {
+                x = 150 + Random_Sim(100);
+                y = 500 + Random_Sim(100);
+            }
+            return Units_Spawn((UnitType)a[0], TEAM_PLAYER, x, y);
+        }
+        default:
+            return -1;
+    }
+}
+
+int Replay_Issue(ReplayCommandType type, int arg0, int arg1, int arg2) {
+    if (type < 0 || type >= REPLAY_CMD_COUNT) return -1;
+
+    ReplayCommand cmd;
+    cmd.tick = g_replay.tick;
+    cmd.type = (uint8_t)type;
+    cmd.args[0] = arg0;
+    cmd.args[1] = arg1;
+    cmd.args[2] = arg2;
+    for (int i = COMMAND_ARGS[type]; i < 3; i++) {
+        cmd.args[i] = 0;
+    }
+
+    if (g_replay.mode == REPLAY_RECORDING) {
+        g_replay.commands.push_back(cmd);
+    }
+    return ApplyCommand(cmd);
+}
+
+//===========================================================================
+// Recording
+//===========================================================================
+
+static void Reset(ReplayMode mode) {
+    g_replay.mode = mode;
+    g_replay.tick = 0;
+    g_replay.divergedTick = -1;
+    g_replay.nextCommand = 0;
+    g_replay.chain = Replay_HashState();
+}
+
+void Replay_StartRecording(const char* scenarioName) {
+    memset(&g_replay.info, 0, sizeof(g_replay.info));
+    g_replay.info.seed = Random_GetSeed();
+    g_replay.info.hashInterval = REPLAY_HASH_INTERVAL;
+    g_replay.info.startCredits = Units_GetPlayerCredits();
+    g_replay.info.mapWidth = Map_GetWidth();
+    g_replay.info.mapHeight = Map_GetHeight();
+    if (scenarioName) {
+        strncpy(g_replay.info.scenario, scenarioName, REPLAY_NAME_LEN - 1);
+    }
+    g_replay.commands.clear();
+    g_replay.hashes.clear();
+
+    Reset(REPLAY_RECORDING);
+    g_replay.startHash = (uint32_t)g_replay.chain;
+}
+
+bool Replay_IsRecording(void) {
+    return g_replay.mode == REPLAY_RECORDING;
+}
+
+void Replay_Stop(void) {
+    g_replay.mode = REPLAY_IDLE;
+}
+
+static void PutU8(std::vector<uint8_t>& out, uint8_t v) {
+    out.push_back(v);
+}
+
+static void PutLE(std::vector<uint8_t>& out, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out.push_back((uint8_t)(v >> (i * 8)));
+    }
+}
+
+static void PutVarint(std::vector<uint8_t>& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+static void PutSigned(std::vector<uint8_t>& out, int32_t v) {
+    PutVarint(out, ((uint32_t)v << 1) ^ (uint32_t)(v >> 31));
+}
+
+bool Replay_StopRecording(const char* path) {
+    if (g_replay.mode != REPLAY_RECORDING) return false;
+    g_replay.mode = REPLAY_IDLE;
+    if (!path) return false;
+
+    const ReplayInfo& info = g_replay.info;
+    size_t nameLen = strlen(info.scenario);
+
+    std::vector<uint8_t> out;
+    out.reserve(64 + g_replay.commands.size() * 8 + g_replay.hashes.size() * 4);
+    PutLE(out, REPLAY_MAGIC, 4);
+    PutLE(out, REPLAY_VERSION, 2);
+    PutLE(out, info.hashInterval, 2);
+    PutLE(out, info.seed, 8);
+    PutLE(out, g_replay.tick, 4);
+    PutLE(out, g_replay.commands.size(), 4);
+    PutLE(out, (uint32_t)info.startCredits, 4);
+    PutLE(out, (uint32_t)info.mapWidth, 2);
+    PutLE(out, (uint32_t)info.mapHeight, 2);
+    PutLE(out, g_replay.startHash, 4);
+    PutU8(out, (uint8_t)nameLen);
+    out.insert(out.end(), info.scenario, info.scenario + nameLen);
+
+    uint32_t lastTick = 0;
+    for (const ReplayCommand& cmd : g_replay.commands) {
+        PutVarint(out, cmd.tick - lastTick);
+        PutU8(out, cmd.type);
+        for (int i = 0; i < COMMAND_ARGS[cmd.type]; i++) {
+            PutSigned(out, cmd.args[i]);
+        }
+        lastTick = cmd.tick;
+    }
+    for (uint32_t hash : g_replay.hashes) {
+        PutLE(out, hash, 4);
+    }
+
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    bool ok = fwrite(out.data(), 1, out.size(), file) == out.size();
+    ok = (fclose(file) == 0) && ok;
+    return ok;
+}
+
+//===========================================================================
+// Playback
+//===========================================================================
+
+// Bounds-checked reader over a loaded file
+struct ReplayReader {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool error;
+
+    uint64_t LE(int bytes) {
+        if (pos + bytes > size) { error = true; return 0; }
+        uint64_t v = 0;
+        for (int i = 0; i < bytes; i++) {
+            v |= (uint64_t)data[pos + i] << (i * 8);
+        }
+        pos += bytes;
+        return v;
+    }
+
+    uint32_t Varint() {
+        uint32_t v = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (pos >= size) break;
+            uint8_t b = data[pos++];
+            v |= (uint32_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        error = true;
+        return 0;
+    }
+
+    int32_t Signed() {
+        uint32_t v = Varint();
+        return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+    }
+};
+
+bool Replay_Load(const char* path, ReplayInfo* info) {
+    g_replay.mode = REPLAY_IDLE;
+
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    std::vector<uint8_t> data;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + n);
+    }
+    fclose(file);
+
+    ReplayReader in = { data.data(), data.size(), 0, false };
+    if (in.LE(4) != REPLAY_MAGIC || in.LE(2) != REPLAY_VERSION) {
+        return false;
+    }
+
+    ReplayInfo header;
+    memset(&header, 0, sizeof(header));
+    header.hashInterval = (uint32_t)in.LE(2);
+    header.seed = in.LE(8);
+    header.tickCount = (uint32_t)in.LE(4);
+    header.commandCount = (uint32_t)in.LE(4);
+    header.startCredits = (int32_t)(uint32_t)in.LE(4);
+    header.mapWidth = (int32_t)in.LE(2);
+    header.mapHeight = (int32_t)in.LE(2);
+    uint32_t startHash = (uint32_t)in.LE(4);
+    size_t nameLen = (size_t)in.LE(1);
+    if (in.error || header.hashInterval == 0 || nameLen >= REPLAY_NAME_LEN ||
+        in.pos + nameLen > in.size) {
+        return false;
+    }
+    memcpy(header.scenario, in.data + in.pos, nameLen);
+    in.pos += nameLen;
+
+    // Every command takes at least two bytes
+    if (header.commandCount > (in.size - in.pos) / 2) return false;
+
+    std::vector<ReplayCommand> commands(header.commandCount);
+    uint32_t tick = 0;
+    for (ReplayCommand& cmd : commands) {
+        tick += in.Varint();
+        cmd.tick = tick;
+        cmd.type = (uint8_t)in.LE(1);
+        if (in.error || cmd.type >= REPLAY_CMD_COUNT || tick > header.tickCount) {
+            return false;
+        }
+        for (int i = 0; i < 3; i++) {
+            cmd.args[i] = (i < COMMAND_ARGS[cmd.type]) ? in.Signed() : 0;
+        }
+    }
+
+    uint32_t hashCount = header.tickCount / header.hashInterval;
+    if (in.error || in.size - in.pos != (size_t)hashCount * 4) return false;
+    std::vector<uint32_t> hashes(hashCount);
+    for (uint32_t& hash : hashes) {
+        hash = (uint32_t)in.LE(4);
+    }
+
+    g_replay.info = header;
+    g_replay.startHash = startHash;
+    g_replay.commands.swap(commands);
+    g_replay.hashes.swap(hashes);
+    if (info) *info = header;
+    return true;
+}
+
+bool Replay_StartPlayback(void) {
+    Reset(REPLAY_PLAYING);
+    if ((uint32_t)g_replay.chain != g_replay.startHash) {
+        g_replay.divergedTick = 0;
+        return false;
+    }
+    return true;
+}
+
+void Replay_Inject(ReplayPhase phase) {
+    if (g_replay.mode != REPLAY_PLAYING) return;
+
+    // Within a tick every input command precedes the production ones
+    while (g_replay.nextCommand < g_replay.commands.size()) {
+        const ReplayCommand& cmd = g_replay.commands[g_replay.nextCommand];
+        if (cmd.tick != g_replay.tick ||
+            Replay_GetPhase((ReplayCommandType)cmd.type) != phase) {
+            break;
+        }
+        ApplyCommand(cmd);
+        g_replay.nextCommand++;
+    }
+}
+
+bool Replay_IsPlaybackDone(void) {
+    return g_replay.mode != REPLAY_PLAYING ||
+           g_replay.tick >= g_replay.info.tickCount;
+}
+
+int Replay_GetDivergedTick(void) {
+    return g_replay.divergedTick;
+}
+
+//===========================================================================
+// Tick
+//===========================================================================
+
+void Replay_EndTick(void) {
+    if (g_replay.mode == REPLAY_IDLE) return;
+
+    g_replay.tick++;
+    g_replay.chain = Mix(g_replay.chain, Replay_HashState());
+
+    uint32_t interval = g_replay.info.hashInterval;
+    if (g_replay.tick % interval != 0) return;
+    uint32_t hash = (uint32_t)g_replay.chain;
+
+    if (g_replay.mode == REPLAY_RECORDING) {
+        g_replay.hashes.push_back(hash);
+    } else {
+        size_t index = g_replay.tick / interval - 1;
+        if (g_replay.divergedTick < 0 && index < g_replay.hashes.size() &&
+            g_replay.hashes[index] != hash) {
+            g_replay.divergedTick = (int)g_replay.tick;
+        }
+    }
+}
+
+uint32_t Replay_GetTick(void) {
+    return g_replay.tick;
+}
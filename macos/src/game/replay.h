@@ -0,0 +1,164 @@
+/**
+ * Red Alert macOS Port - Input Replays
+ *
+ * Every player command goes through Replay_Issue(), which applies it and,
+ * while recording, logs it with the tick it was issued on. A replay file
+ * holds the game seed, the scenario name, the command log and a chained
+ * hash of unit, building and cell state taken after each tick. Feeding
+ * the log back into a fresh simulation (ra_headless --replay) must
+ * reproduce every hash; the first one that differs names the tick where
+ * the simulation diverged.
+ *
+ * Ticks count completed simulation steps. A step runs as in GameUpdate:
+ *
+ *   Replay_Inject(REPLAY_PHASE_INPUT)        (playback only)
+ *   Map_Update(); Units_Update();
+ *   Replay_Inject(REPLAY_PHASE_PRODUCTION)   (playback only)
+ *   AI_Update(); mission triggers
+ *   Replay_EndTick()
+ *
+ * Commands issued before a step are input-phase; production completing
+ * inside GameUI_Update is production-phase.
+ */
+
+#ifndef GAME_REPLAY_H
+#define GAME_REPLAY_H
+
+#include <cstdint>
+
+// Hashes stored every N ticks (1 pinpoints the exact divergent tick)
+#define REPLAY_HASH_INTERVAL    1
+
+// Scenario name length stored in the header
+#define REPLAY_NAME_LEN         32
+
+// Command types. Arguments are listed per type; unused ones are 0.
+typedef enum {
+    REPLAY_CMD_MOVE = 0,        // unit, worldX, worldY
+    REPLAY_CMD_ATTACK,          // unit, target unit
+    REPLAY_CMD_ATTACK_MOVE,     // unit, worldX, worldY
+    REPLAY_CMD_FORCE_ATTACK,    // unit, worldX, worldY
+    REPLAY_CMD_STOP,            // unit
+    REPLAY_CMD_GUARD,           // unit
+    REPLAY_CMD_LOAD,            // unit, transport
+    REPLAY_CMD_UNLOAD,          // transport
+    REPLAY_CMD_HUNT,            // team
+    REPLAY_CMD_CREDITS,         // delta (production spend, cancel refund)
+    REPLAY_CMD_PLACE_BUILDING,  // building type, cellX, cellY
+    REPLAY_CMD_SELL,            // building, refund
+    REPLAY_CMD_SPAWN_UNIT,      // unit type, worldX, worldY (-1 = fallback spot)
+    REPLAY_CMD_COUNT
+} ReplayCommandType;
+
+typedef enum {
+    REPLAY_PHASE_INPUT = 0,     // Before the step (mouse, hotkeys, sidebar)
+    REPLAY_PHASE_PRODUCTION     // After Units_Update (GameUI_Update)
+} ReplayPhase;
+
+typedef struct {
+    uint32_t tick;              // Completed steps when issued
+    uint8_t type;               // ReplayCommandType
+    int32_t args[3];
+} ReplayCommand;
+
+// Header of a loaded replay
+typedef struct {
+    uint64_t seed;              // Random_Seed() value for the game
+    uint32_t tickCount;         // Steps recorded
+    uint32_t commandCount;
+    uint32_t hashInterval;
+    int32_t startCredits;       // Player credits after Mission_Start
+    int32_t mapWidth;
+    int32_t mapHeight;
+    char scenario[REPLAY_NAME_LEN];
+} ReplayInfo;
+
+/**
+ * Apply a player command, logging it first if recording.
+ * @return New building/unit id for PLACE_BUILDING/SPAWN_UNIT, the
+ *         unload count for UNLOAD, otherwise 0 (-1 on failure)
+ */
+int Replay_Issue(ReplayCommandType type, int arg0, int arg1, int arg2);
+
+/**
+ * Phase a command type is applied in
+ */
+ReplayPhase Replay_GetPhase(ReplayCommandType type);
+
+/**
+ * Start recording. Call once the mission has started and the game seed
+ * is set; the current state becomes tick 0.
+ */
+void Replay_StartRecording(const char* scenarioName);
+
+/**
+ * Stop recording and write the replay to path (nullptr discards it)
+ * @return true if the file was written
+ */
+bool Replay_StopRecording(const char* path);
+
+/**
+ * Check if a game is being recorded
+ */
+bool Replay_IsRecording(void);
+
+/**
+ * Load a replay for playback. Seed the game with info->seed, start the
+ * scenario, set the player credits to info->startCredits, then call
+ * Replay_StartPlayback().
+ */
+bool Replay_Load(const char* path, ReplayInfo* info);
+
+/**
+ * Begin playing the loaded replay from tick 0
+ * @return false if the starting state doesn't match the recording
+ */
+bool Replay_StartPlayback(void);
+
+/**
+ * Apply the recorded commands for the current tick and phase
+ */
+void Replay_Inject(ReplayPhase phase);
+
+/**
+ * Check if playback has reached the end of the recording
+ */
+bool Replay_IsPlaybackDone(void);
+
+/**
+ * First tick whose hash differed from the recording (0 = starting
+ * state), or -1 while everything has matched
+ */
+int Replay_GetDivergedTick(void);
+
+/**
+ * Stop recording or playback without writing anything
+ */
+void Replay_Stop(void);
+
+/**
+ * Finish a simulation step: advances the tick and hashes the state
+ * while recording or playing back
+ */
+void Replay_EndTick(void);
+
+/**
+ * Completed steps since recording or playback started
+ */
+uint32_t Replay_GetTick(void);
+
+/**
+ * Hash of the simulation state: named fields of active unit and building
+ * slots (minus selection), the cell grid and the player credits. Cells
+ * are rehashed only where Map_GetStateChanges() reports a write, and the
+ * list is cleared.
+ */
+uint64_t Replay_HashState(void);
+
+/**
+ * Replay_HashState() recomputed over every cell, ignoring the change
+ * list; for checking that every cell write is reported
+ */
+uint64_t Replay_HashStateFull(void);
+
+#endif // GAME_REPLAY_H
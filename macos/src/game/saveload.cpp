@@ -18,10 +18,15 @@
 #include "trigger.h"
 #include "team.h"
 #include "factory.h"
+#include "random.h"
 #include <cstring>
 #include <cstdlib>
 #include <CommonCrypto/CommonDigest.h>
 
+// Forward declaration (mission.h brings in units.h, whose enums clash
+// with types.h)
+extern "C" void Mission_ResetTriggerCache(void);
+
 //===========================================================================
 // External References
 //===========================================================================
@@ -65,8 +70,14 @@ void Get_Save_Filename(int slot, char* buffer, int bufferSize) {
 // SaveStream Implementation
 //===========================================================================
 
+struct SaveDigest {
+    CC_MD5_CTX ctx;
+};
+
 SaveStream::SaveStream()
-    : file_(nullptr), bytesWritten_(0) {
+    : file_(nullptr), bytesWritten_(0), hasError_(false),
+      bufferUsed_(0), hashedUpTo_(0), md5_(new SaveDigest) {
+    CC_MD5_Init(&md5_->ctx);
 }
 
 SaveStream::~SaveStream() {
@@ -96,35 +107,72 @@ bool SaveStream::Open(const char* filename) {
         return false;
     }
 
+    // Allocated once, on first use
+    buffer_.resize(SAVE_BUFFER_SIZE);
     bytesWritten_ = 0;
-    buffer_.clear();
+    bufferUsed_ = 0;
+    hashedUpTo_ = 0;
+    hasError_ = false;
+    CC_MD5_Init(&md5_->ctx);
     return true;
 }
 
 void SaveStream::Close() {
     if (file_) {
+        Flush();
         fclose(file_);
         file_ = nullptr;
     }
     bytesWritten_ = 0;
 }
 
+// Fold buffered bytes not yet hashed into the running checksum
+void SaveStream::HashPending() {
+    if (bufferUsed_ > hashedUpTo_) {
+        CC_MD5_Update(&md5_->ctx, buffer_.data() + hashedUpTo_,
+                      static_cast<CC_LONG>(bufferUsed_ - hashedUpTo_));
+        hashedUpTo_ = bufferUsed_;
+    }
+}
+
+bool SaveStream::Flush() {
+    if (!file_) {
+        return false;
+    }
+
+    HashPending();
+    if (bufferUsed_ > 0) {
+        if (fwrite(buffer_.data(), 1, bufferUsed_, file_) != bufferUsed_) {
+            hasError_ = true;
+        }
+        bufferUsed_ = 0;
+        hashedUpTo_ = 0;
+    }
+    return !hasError_;
+}
+
 bool SaveStream::Write(const void* data, size_t size) {
     if (!file_ || !data || size == 0) {
         return false;
     }
 
-    size_t written = fwrite(data, 1, size, file_);
-    if (written != size) {
-        return false;
+    if (bufferUsed_ + size > buffer_.size()) {
+        Flush();
     }
 
-    // Also store in buffer for checksum calculation
-    const uint8_t* bytes = static_cast<const uint8_t*>(data);
-    buffer_.insert(buffer_.end(), bytes, bytes + size);
+    if (size > buffer_.size()) {
+        // Too big to buffer: hash and write it straight through
+        CC_MD5_Update(&md5_->ctx, data, static_cast<CC_LONG>(size));
+        if (fwrite(data, 1, size, file_) != size) {
+            hasError_ = true;
+        }
+    } else {
+        memcpy(buffer_.data() + bufferUsed_, data, size);
+        bufferUsed_ += size;
+    }
 
     bytesWritten_ += size;
-    return true;
+    return !hasError_;
 }
 
 bool SaveStream::WriteBool(bool value) {
@@ -146,8 +194,17 @@ bool SaveStream::WriteObjectID(RTTIType type, int id) {
     return WriteInt16(static_cast<int16_t>(id));
 }
 
+void SaveStream::BeginChecksum() {
+    hashedUpTo_ = bufferUsed_;
+    CC_MD5_Init(&md5_->ctx);
+}
+
 void SaveStream::CalculateChecksum(uint8_t* outChecksum) {
-    CC_MD5(buffer_.data(), static_cast<CC_LONG>(buffer_.size()), outChecksum);
+    HashPending();
+
+    // Finish a copy so hashing can continue if more data is written
+    CC_MD5_CTX done = md5_->ctx;
+    CC_MD5_Final(outChecksum, &done);
 }
 
 //===========================================================================
@@ -270,22 +327,47 @@ bool LoadStream::ReadObjectID(RTTIType& type, int& id) {
     return !hasError_;
 }
 
-void LoadStream::CalculateChecksum(size_t dataSize, uint8_t* outChecksum) {
+bool LoadStream::CalculateChecksum(size_t dataSize, uint8_t* outChecksum) {
+    memset(outChecksum, 0, 16);
     if (!file_) {
-        memset(outChecksum, 0, 16);
-        return;
+        return false;
     }
 
     // Save position
     long pos = ftell(file_);
 
-    // Read data and calculate checksum
-    std::vector<uint8_t> buffer(dataSize);
-    fread(buffer.data(), 1, dataSize, file_);
-    CC_MD5(buffer.data(), static_cast<CC_LONG>(dataSize), outChecksum);
+    // Hash the data a chunk at a time
+    CC_MD5_CTX md5;
+    CC_MD5_Init(&md5);
+    uint8_t chunk[16384];
+    size_t remaining = dataSize;
+    bool ok = true;
+    while (remaining > 0) {
+        size_t want = remaining < sizeof(chunk) ? remaining : sizeof(chunk);
+        if (fread(chunk, 1, want, file_) != want) {
+            ok = false;
+            break;
+        }
+        CC_MD5_Update(&md5, chunk, static_cast<CC_LONG>(want));
+        remaining -= want;
+    }
+    CC_MD5_Final(outChecksum, &md5);
 
     // Restore position
     fseek(file_, pos, SEEK_SET);
+    return ok;
+}
+
+size_t LoadStream::BytesRemaining() {
+    if (!file_) {
+        return 0;
+    }
+
+    long pos = ftell(file_);
+    fseek(file_, 0, SEEK_END);
+    long end = ftell(file_);
+    fseek(file_, pos, SEEK_SET);
+    return end > pos ? static_cast<size_t>(end - pos) : 0;
 }
 
 //===========================================================================
@@ -323,11 +405,14 @@ bool Save_Game(int slot, const char* description) {
         return false;
     }
 
+    // Checksum covers the data section only
+    stream.BeginChecksum();
+
     // Encode all object pointers to IDs
     Code_All_Pointers();
 
     // Write all game data
-    if (!Put_All(stream)) {
+    if (!Put_All(stream) || !stream.Flush()) {
         Decode_All_Pointers();  // Restore pointers
         stream.Close();
         return false;
@@ -344,13 +429,14 @@ bool Save_Game(int slot, const char* description) {
 
     // Reopen to update header
     FILE* f = fopen(filename, "r+b");
-    if (f) {
-        fseek(f, 0, SEEK_SET);
-        fwrite(&header, sizeof(header), 1, f);
-        fclose(f);
+    if (!f) {
+        return false;
     }
+    fseek(f, 0, SEEK_SET);
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    fclose(f);
 
-    return true;
+    return ok;
 }
 
 bool Load_Game(int slot) {
@@ -385,7 +471,13 @@ bool Load_Game(int slot) {
         return false;
     }
 
-    // TODO: Verify checksum (would need to read all data twice)
+    // Verify the checksum before touching any game state
+    uint8_t checksum[16];
+    if (!stream.CalculateChecksum(stream.BytesRemaining(), checksum) ||
+        memcmp(checksum, header.checksum, sizeof(checksum)) != 0) {
+        stream.Close();
+        return false;
+    }
 
     // Clear current game state
     // Note: In full implementation, this would call Clear_Scenario()
@@ -447,6 +539,87 @@ bool Delete_Save(int slot) {
     return remove(filename) == 0;
 }
 
+//===========================================================================
+// Pointer Encoding/Decoding
+//
+// Object pointers are written as (RTTI, pool slot) pairs. Loading records
+// where each one goes, and Decode_All_Pointers() patches them in once
+// every pool is back, so a section may refer to objects saved after it.
+//===========================================================================
+
+struct PointerFixup {
+    void* slot;
+    void (*assign)(void* slot, ObjectClass* object);
+    RTTIType type;
+    int16_t id;
+};
+
+static std::vector<PointerFixup> g_pointerFixups;
+
+template<typename T>
+static void AssignPointer(void* slot, ObjectClass* object) {
+    *static_cast<T**>(slot) = dynamic_cast<T*>(object);
+}
+
+static ObjectClass* ObjectFromID(RTTIType type, int id) {
+    switch (type) {
+        case RTTIType::INFANTRY: return Infantry.Get(id);
+        case RTTIType::UNIT:     return Units.Get(id);
+        case RTTIType::AIRCRAFT: return Aircraft.Get(id);
+        case RTTIType::BUILDING: return Buildings.Get(id);
+        case RTTIType::BULLET:   return Bullets.Get(id);
+        default:                 return nullptr;
+    }
+}
+
+static void PutPointer(SaveStream& stream, const ObjectClass* object) {
+    if (object) {
+        stream.WriteObjectID(object->WhatAmI(), object->ID());
+    } else {
+        stream.WriteObjectID(RTTIType::NONE, -1);
+    }
+}
+
+template<typename T>
+static void GetPointer(LoadStream& stream, T*& pointer) {
+    RTTIType type;
+    int id;
+    pointer = nullptr;
+    if (stream.ReadObjectID(type, id) && type != RTTIType::NONE) {
+        g_pointerFixups.push_back({&pointer, AssignPointer<T>, type,
+                                   static_cast<int16_t>(id)});
+    }
+}
+
+void Code_All_Pointers() {
+    // References are encoded as they are written (PutPointer), so the
+    // live objects never hold IDs in place of pointers
+}
+
+void Decode_All_Pointers() {
+    for (const PointerFixup& fixup : g_pointerFixups) {
+        fixup.assign(fixup.slot, ObjectFromID(fixup.type, fixup.id));
+    }
+    g_pointerFixups.clear();
+}
+
+//===========================================================================
+// Field Helpers
+//
+// Object state is written member by member at each member's declared
+// width (enums included), through the stream buffer.
+//===========================================================================
+
+template<typename T>
+static void PutField(SaveStream& stream, const T& value) {
+    stream.Write(&value, sizeof(T));
+}
+
+template<typename T>
+static void GetField(LoadStream& stream, T& value) {
+    stream.Read(&value, sizeof(T));
+}
+
 //===========================================================================
 // Put_All - Save all game state
 //===========================================================================
@@ -476,10 +649,14 @@ bool Put_All(SaveStream& stream) {
     if (!Save_Aircraft(stream)) return false;
     if (!Save_Bullets(stream)) return false;
 
-    // 7. Factories/Production
+    // 7. Realtime map grid, then the unit/building tables standing on it
+    if (!Save_MapCells(stream)) return false;
+    if (!Save_Entities(stream)) return false;
+
+    // 8. Factories/Production
     if (!Save_Factories(stream)) return false;
 
-    // 8. Misc values
+    // 9. Misc values
     if (!Save_Misc_Values(stream)) return false;
 
     return true;
@@ -491,6 +668,7 @@ bool Put_All(SaveStream& stream) {
 
 bool Get_All(LoadStream& stream) {
     // Load in same order as save
+    g_pointerFixups.clear();
 
     // 1. Scenario
     if (!Load_Scenario(stream)) return false;
@@ -514,36 +692,20 @@ bool Get_All(LoadStream& stream) {
     if (!Load_Aircraft(stream)) return false;
     if (!Load_Bullets(stream)) return false;
 
-    // 7. Factories
+    // 7. Realtime map grid and unit/building tables
+    if (!Load_MapCells(stream)) return false;
+    if (!Load_Entities(stream)) return false;
+
+    // 8. Factories
     if (!Load_Factories(stream)) return false;
 
-    // 8. Misc values
+    // 9. Misc values
     if (!Load_Misc_Values(stream)) return false;
 
-    return true;
-}
+    // Trigger subscriptions and cached results describe the old world
+    Mission_ResetTriggerCache();
 
-//===========================================================================
-// Pointer Encoding/Decoding
-//===========================================================================
-
-void Code_All_Pointers() {
-    // In full implementation, this would:
-    // 1. Convert object pointers to TARGET IDs
-    // 2. Convert house pointers to house type indices
-    // 3. Convert trigger/team pointers to indices
-
-    // For now, this is a placeholder
-    // Objects store their references as IDs already in most cases
-}
-
-void Decode_All_Pointers() {
-    // In full implementation, this would:
-    // 1. Convert TARGET IDs back to object pointers
-    // 2. Convert house type indices back to house pointers
-    // 3. Convert trigger/team indices back to pointers
-
-    // For now, this is a placeholder
+    return true;
 }
 
 //===========================================================================
@@ -869,6 +1031,32 @@ bool Load_Houses(LoadStream& stream) {
 // Map Save/Load
 //===========================================================================
 
+// Cell state bits stored in the flags block
+static constexpr uint8_t CELL_SAVE_MAPPED = 0x01;
+static constexpr uint8_t CELL_SAVE_VISIBLE = 0x02;
+static constexpr uint8_t CELL_SAVE_WAYPOINT = 0x04;
+static constexpr uint8_t CELL_SAVE_FLAGGED = 0x08;
+
+// Gather one field of every cell into a block and write it in one call
+template<typename T, typename Getter>
+static void PutCellBlock(SaveStream& stream, Getter get) {
+    static T block[MAP_CELL_TOTAL];
+    for (int i = 0; i < MAP_CELL_TOTAL; i++) {
+        block[i] = get(Map[static_cast<CELL>(i)]);
+    }
+    stream.Write(block, sizeof(block));
+}
+
+// Read one block and scatter it back into every cell
+template<typename T, typename Setter>
+static void GetCellBlock(LoadStream& stream, Setter set) {
+    static T block[MAP_CELL_TOTAL];
+    if (!stream.Read(block, sizeof(block))) return;
+    for (int i = 0; i < MAP_CELL_TOTAL; i++) {
+        set(Map[static_cast<CELL>(i)], block[i]);
+    }
+}
+
 bool Save_Map(SaveStream& stream) {
     // Map dimensions
     stream.WriteInt32(Map.MapCellX());
@@ -876,24 +1064,78 @@ bool Save_Map(SaveStream& stream) {
     stream.WriteInt32(Map.MapCellWidth());
     stream.WriteInt32(Map.MapCellHeight());
 
-    // Save each cell
-    for (int i = 0; i < MAP_CELL_TOTAL; i++) {
-        const CellClass& cell = Map[i];
-
-        // Basic cell data
-        stream.WriteInt8(static_cast<int8_t>(cell.GetLandType()));
-        stream.WriteInt8(static_cast<int8_t>(cell.overlay_));
-        stream.WriteUInt8(cell.overlayData_);
-
-        // Flags
+    // One block per cell field
+    PutCellBlock<int16_t>(stream, [](const CellClass& c) {
+        return static_cast<int16_t>(c.templateType_);
+    });
+    PutCellBlock<uint8_t>(stream, [](const CellClass& c) {
+        return c.templateIcon_;
+    });
+    PutCellBlock<OverlayType>(stream, [](const CellClass& c) {
+        return c.overlay_;
+    });
+    PutCellBlock<uint8_t>(stream, [](const CellClass& c) {
+        return c.overlayData_;
+    });
+    PutCellBlock<SmudgeType>(stream, [](const CellClass& c) {
+        return c.smudge_;
+    });
+    PutCellBlock<uint8_t>(stream, [](const CellClass& c) {
+        return c.smudgeData_;
+    });
+    PutCellBlock<HousesType>(stream, [](const CellClass& c) {
+        return c.owner_;
+    });
+    PutCellBlock<uint8_t>(stream, [](const CellClass& c) {
+        return c.flag_.composite;
+    });
+    PutCellBlock<LandType>(stream, [](const CellClass& c) {
+        return c.land_;
+    });
+    PutCellBlock<uint16_t>(stream, [](const CellClass& c) {
+        return c.jammed_;
+    });
+    PutCellBlock<uint8_t>(stream, [](const CellClass& c) {
         uint8_t flags = 0;
-        if (cell.IsVisible()) flags |= 0x01;
-        if (cell.IsMapped()) flags |= 0x02;
-        // Waypoint flag not tracked per-cell, skip
-        stream.WriteUInt8(flags);
+        if (c.isMapped_) flags |= CELL_SAVE_MAPPED;
+        if (c.isVisible_) flags |= CELL_SAVE_VISIBLE;
+        if (c.isWaypoint_) flags |= CELL_SAVE_WAYPOINT;
+        if (c.isFlagged_) flags |= CELL_SAVE_FLAGGED;
+        return flags;
+    });
+    for (int z = 0; z < static_cast<int>(MZoneType::COUNT); z++) {
+        PutCellBlock<uint8_t>(stream, [z](const CellClass& c) {
+            return c.zones_[z];
+        });
     }
 
-    return true;
+    // Occupants are sparse: (cell, slot, object), slot -1 = occupier
+    int32_t refCount = 0;
+    for (int i = 0; i < MAP_CELL_TOTAL; i++) {
+        const CellClass& cell = Map[static_cast<CELL>(i)];
+        if (cell.occupier_) refCount++;
+        for (int j = 0; j < MAX_OVERLAPPER; j++) {
+            if (cell.overlappers_[j]) refCount++;
+        }
+    }
+    stream.WriteInt32(refCount);
+    for (int i = 0; i < MAP_CELL_TOTAL; i++) {
+        const CellClass& cell = Map[static_cast<CELL>(i)];
+        if (cell.occupier_) {
+            stream.WriteUInt16(static_cast<uint16_t>(i));
+            stream.WriteInt8(-1);
+            PutPointer(stream, cell.occupier_);
+        }
+        for (int j = 0; j < MAX_OVERLAPPER; j++) {
+            if (cell.overlappers_[j]) {
+                stream.WriteUInt16(static_cast<uint16_t>(i));
+                stream.WriteInt8(static_cast<int8_t>(j));
+                PutPointer(stream, cell.overlappers_[j]);
+            }
+        }
+    }
+
+    return !stream.HasError();
 }
 
 bool Load_Map(LoadStream& stream) {
@@ -905,91 +1147,590 @@ bool Load_Map(LoadStream& stream) {
 
     Map.SetMapDimensions(mapX, mapY, mapW, mapH);
 
-    // Load each cell
-    for (int i = 0; i < MAP_CELL_TOTAL; i++) {
-        CellClass& cell = Map[i];
-
-        // Basic cell data
-        LandType land = static_cast<LandType>(stream.ReadInt8());
-        OverlayType overlay = static_cast<OverlayType>(stream.ReadInt8());
-        uint8_t overlayData = stream.ReadUInt8();
+    GetCellBlock<int16_t>(stream, [](CellClass& c, int16_t v) {
+        c.templateType_ = static_cast<TemplateType>(v);
+    });
+    GetCellBlock<uint8_t>(stream, [](CellClass& c, uint8_t v) {
+        c.templateIcon_ = v;
+    });
+    GetCellBlock<OverlayType>(stream, [](CellClass& c, OverlayType v) {
+        c.overlay_ = v;
+    });
+    GetCellBlock<uint8_t>(stream, [](CellClass& c, uint8_t v) {
+        c.overlayData_ = v;
+    });
+    GetCellBlock<SmudgeType>(stream, [](CellClass& c, SmudgeType v) {
+        c.smudge_ = v;
+    });
+    GetCellBlock<uint8_t>(stream, [](CellClass& c, uint8_t v) {
+        c.smudgeData_ = v;
+    });
+    GetCellBlock<HousesType>(stream, [](CellClass& c, HousesType v) {
+        c.owner_ = v;
+    });
+    GetCellBlock<uint8_t>(stream, [](CellClass& c, uint8_t v) {
+        c.flag_.composite = v;
+    });
+    GetCellBlock<LandType>(stream, [](CellClass& c, LandType v) {
+        c.land_ = v;
+    });
+    GetCellBlock<uint16_t>(stream, [](CellClass& c, uint16_t v) {
+        c.jammed_ = v;
+    });
+    GetCellBlock<uint8_t>(stream, [](CellClass& c, uint8_t v) {
+        c.isMapped_ = (v & CELL_SAVE_MAPPED) != 0;
+        c.isVisible_ = (v & CELL_SAVE_VISIBLE) != 0;
+        c.isWaypoint_ = (v & CELL_SAVE_WAYPOINT) != 0;
+        c.isFlagged_ = (v & CELL_SAVE_FLAGGED) != 0;
+    });
+    for (int z = 0; z < static_cast<int>(MZoneType::COUNT); z++) {
+        GetCellBlock<uint8_t>(stream, [z](CellClass& c, uint8_t v) {
+            c.zones_[z] = v;
+        });
+    }
 
-        cell.land_ = land;
-        cell.SetOverlay(overlay, overlayData);
+    // Zone labels are stored raw; relabel to rebuild their merge table
+    Map.ZoneReset();
 
-        // Flags
-        uint8_t flags = stream.ReadUInt8();
-        if (flags & 0x01) cell.SetVisible(true);
-        if (flags & 0x02) cell.SetMapped(true);
-        // Waypoint flag not tracked per-cell
+    // Occupants are patched in by Decode_All_Pointers()
+    for (int i = 0; i < MAP_CELL_TOTAL; i++) {
+        CellClass& cell = Map[static_cast<CELL>(i)];
+        cell.occupier_ = nullptr;
+        for (int j = 0; j < MAX_OVERLAPPER; j++) {
+            cell.overlappers_[j] = nullptr;
+        }
+    }
+    int refCount = stream.ReadInt32();
+    for (int r = 0; r < refCount && !stream.HasError(); r++) {
+        int index = stream.ReadUInt16();
+        if (index >= MAP_CELL_TOTAL) {
+            stream.SetError();
+            break;
+        }
+        CellClass& cell = Map[static_cast<CELL>(index)];
+        int slot = stream.ReadInt8();
+        if (slot >= 0 && slot < MAX_OVERLAPPER) {
+            GetPointer(stream, cell.overlappers_[slot]);
+        } else {
+            GetPointer(stream, cell.occupier_);
+        }
     }
 
     return !stream.HasError();
 }
 
 //===========================================================================
-// Game Object Save/Load - Stubs for now
+// Game Object Save/Load
+//
+// Each pool is written as a count followed by (slot, state) for every
+// live object, one helper per class level. Loading frees the pool and
+// re-allocates the same slots so saved references stay valid.
 //===========================================================================
 
+static void PutAbstract(SaveStream& stream, const AbstractClass& obj) {
+    PutField(stream, obj.rtti_);
+    PutField(stream, obj.coord_);
+    PutField(stream, obj.height_);
+    PutField(stream, obj.isActive_);
+}
+
+static void GetAbstract(LoadStream& stream, AbstractClass& obj) {
+    GetField(stream, obj.rtti_);
+    GetField(stream, obj.coord_);
+    GetField(stream, obj.height_);
+    GetField(stream, obj.isActive_);
+}
+
+static void PutObject(SaveStream& stream, const ObjectClass& obj) {
+    PutAbstract(stream, obj);
+    PutField(stream, obj.isDown_);
+    PutField(stream, obj.isToDamage_);
+    PutField(stream, obj.isToDisplay_);
+    PutField(stream, obj.isInLimbo_);
+    PutField(stream, obj.isSelected_);
+    PutField(stream, obj.isAnimAttached_);
+    PutField(stream, obj.isFalling_);
+    PutField(stream, obj.riser_);
+    PutPointer(stream, obj.next_);
+    PutField(stream, obj.strength_);
+}
+
+static void GetObject(LoadStream& stream, ObjectClass& obj) {
+    GetAbstract(stream, obj);
+    GetField(stream, obj.isDown_);
+    GetField(stream, obj.isToDamage_);
+    GetField(stream, obj.isToDisplay_);
+    GetField(stream, obj.isInLimbo_);
+    GetField(stream, obj.isSelected_);
+    GetField(stream, obj.isAnimAttached_);
+    GetField(stream, obj.isFalling_);
+    GetField(stream, obj.riser_);
+    GetPointer(stream, obj.next_);
+    GetField(stream, obj.strength_);
+}
+
+static void PutRadio(SaveStream& stream, const RadioClass& obj) {
+    PutObject(stream, obj);
+
+    // MissionClass
+    PutField(stream, obj.mission_);
+    PutField(stream, obj.suspendedMission_);
+    PutField(stream, obj.missionQueue_);
+    PutField(stream, obj.status_);
+    PutField(stream, obj.timer_);
+
+    // RadioClass
+    PutField(stream, obj.oldMessages_);
+    PutPointer(stream, obj.radio_);
+}
+
+static void GetRadio(LoadStream& stream, RadioClass& obj) {
+    GetObject(stream, obj);
+
+    // MissionClass
+    GetField(stream, obj.mission_);
+    GetField(stream, obj.suspendedMission_);
+    GetField(stream, obj.missionQueue_);
+    GetField(stream, obj.status_);
+    GetField(stream, obj.timer_);
+
+    // RadioClass
+    GetField(stream, obj.oldMessages_);
+    GetPointer(stream, obj.radio_);
+}
+
+static void PutTechno(SaveStream& stream, const TechnoClass& obj) {
+    PutRadio(stream, obj);
+    PutField(stream, obj.isUseless_);
+    PutField(stream, obj.isTickedOff_);
+    PutField(stream, obj.isCloakable_);
+    PutField(stream, obj.isLeader_);
+    PutField(stream, obj.isALoaner_);
+    PutField(stream, obj.isLocked_);
+    PutField(stream, obj.isInRecoilState_);
+    PutField(stream, obj.isTethered_);
+    PutField(stream, obj.isOwnedByPlayer_);
+    PutField(stream, obj.isDiscoveredByPlayer_);
+    PutField(stream, obj.isDiscoveredByComputer_);
+    PutField(stream, obj.isALemon_);
+    PutField(stream, obj.isSecondShot_);
+    PutField(stream, obj.armorBias_);
+    PutField(stream, obj.firepowerBias_);
+    PutField(stream, obj.idleTimer_);
+    PutField(stream, obj.ironCurtainTimer_);
+    PutField(stream, obj.spiedBy_);
+    PutField(stream, obj.archiveTarget_);
+    PutField(stream, obj.house_);
+    PutField(stream, obj.cloakState_);
+    PutField(stream, obj.cloakTimer_);
+    PutField(stream, obj.cloakStage_);
+    PutField(stream, obj.tarCom_);
+    PutField(stream, obj.suspendedTarCom_);
+    PutField(stream, obj.navCom_);
+    PutField(stream, obj.suspendedNavCom_);
+    PutField(stream, obj.arm_);
+    PutField(stream, obj.ammo_);
+    PutField(stream, obj.pricePaid_);
+    PutField(stream, obj.triggerName_);
+    PutField(stream, obj.turretFacing_);
+    PutField(stream, obj.turretFacingTarget_);
+}
+
+static void GetTechno(LoadStream& stream, TechnoClass& obj) {
+    GetRadio(stream, obj);
+    GetField(stream, obj.isUseless_);
+    GetField(stream, obj.isTickedOff_);
+    GetField(stream, obj.isCloakable_);
+    GetField(stream, obj.isLeader_);
+    GetField(stream, obj.isALoaner_);
+    GetField(stream, obj.isLocked_);
+    GetField(stream, obj.isInRecoilState_);
+    GetField(stream, obj.isTethered_);
+    GetField(stream, obj.isOwnedByPlayer_);
+    GetField(stream, obj.isDiscoveredByPlayer_);
+    GetField(stream, obj.isDiscoveredByComputer_);
+    GetField(stream, obj.isALemon_);
+    GetField(stream, obj.isSecondShot_);
+    GetField(stream, obj.armorBias_);
+    GetField(stream, obj.firepowerBias_);
+    GetField(stream, obj.idleTimer_);
+    GetField(stream, obj.ironCurtainTimer_);
+    GetField(stream, obj.spiedBy_);
+    GetField(stream, obj.archiveTarget_);
+    GetField(stream, obj.house_);
+    GetField(stream, obj.cloakState_);
+    GetField(stream, obj.cloakTimer_);
+    GetField(stream, obj.cloakStage_);
+    GetField(stream, obj.tarCom_);
+    GetField(stream, obj.suspendedTarCom_);
+    GetField(stream, obj.navCom_);
+    GetField(stream, obj.suspendedNavCom_);
+    GetField(stream, obj.arm_);
+    GetField(stream, obj.ammo_);
+    GetField(stream, obj.pricePaid_);
+    GetField(stream, obj.triggerName_);
+    GetField(stream, obj.turretFacing_);
+    GetField(stream, obj.turretFacingTarget_);
+    obj.triggerName_[sizeof(obj.triggerName_) - 1] = '\0';
+}
+
+static void PutFoot(SaveStream& stream, const FootClass& obj) {
+    PutTechno(stream, obj);
+    PutField(stream, obj.isInitiated_);
+    PutField(stream, obj.isMovingOntoBridge_);
+    PutField(stream, obj.isUnloading_);
+    PutField(stream, obj.isScattering_);
+    PutField(stream, obj.isPrimaryFacing_);
+    PutField(stream, obj.isRotating_);
+    PutField(stream, obj.isFiring_);
+    PutField(stream, obj.isDriving_);
+    PutField(stream, obj.isToLook_);
+    PutField(stream, obj.isDeploying_);
+    PutField(stream, obj.isNewNavCom_);
+    PutField(stream, obj.isPlanning_);
+    PutField(stream, obj.path_);
+    PutField(stream, obj.pathLength_);
+    PutField(stream, obj.pathIndex_);
+    PutField(stream, obj.headTo_);
+    PutField(stream, obj.member_);
+    PutField(stream, obj.speed_);
+    PutField(stream, obj.speedAccum_);
+    PutField(stream, obj.group_);
+    PutField(stream, obj.bodyFacing_);
+    PutField(stream, obj.bodyFacingTarget_);
+}
+
+static void GetFoot(LoadStream& stream, FootClass& obj) {
+    GetTechno(stream, obj);
+    GetField(stream, obj.isInitiated_);
+    GetField(stream, obj.isMovingOntoBridge_);
+    GetField(stream, obj.isUnloading_);
+    GetField(stream, obj.isScattering_);
+    GetField(stream, obj.isPrimaryFacing_);
+    GetField(stream, obj.isRotating_);
+    GetField(stream, obj.isFiring_);
+    GetField(stream, obj.isDriving_);
+    GetField(stream, obj.isToLook_);
+    GetField(stream, obj.isDeploying_);
+    GetField(stream, obj.isNewNavCom_);
+    GetField(stream, obj.isPlanning_);
+    GetField(stream, obj.path_);
+    GetField(stream, obj.pathLength_);
+    GetField(stream, obj.pathIndex_);
+    GetField(stream, obj.headTo_);
+    GetField(stream, obj.member_);
+    GetField(stream, obj.speed_);
+    GetField(stream, obj.speedAccum_);
+    GetField(stream, obj.group_);
+    GetField(stream, obj.bodyFacing_);
+    GetField(stream, obj.bodyFacingTarget_);
+}
+
+// Write every live object in a pool: count, then (slot, state) pairs
+template<typename T, int MaxCount>
+static bool SavePool(SaveStream& stream, ObjectPool<T, MaxCount>& pool,
+                     void (*put)(SaveStream&, const T&)) {
+    stream.WriteInt32(pool.Count());
+    for (int i = 0; i < pool.Capacity(); i++) {
+        const T* obj = pool.Get(i);
+        if (obj) {
+            stream.WriteInt16(static_cast<int16_t>(i));
+            put(stream, *obj);
+        }
+    }
+    return !stream.HasError();
+}
+
+// Replace a pool's contents with the saved objects, in their saved slots
+template<typename T, int MaxCount>
+static bool LoadPool(LoadStream& stream, ObjectPool<T, MaxCount>& pool,
+                     void (*get)(LoadStream&, T&)) {
+    pool.Clear();
+    int count = stream.ReadInt32();
+    if (count < 0 || count > pool.Capacity()) {
+        return false;
+    }
+    for (int n = 0; n < count && !stream.HasError(); n++) {
+        T* obj = pool.AllocateAt(stream.ReadInt16());
+        if (!obj) {
+            return false;
+        }
+        get(stream, *obj);
+    }
+    return !stream.HasError();
+}
+
 // Infantry
+static void PutInfantry(SaveStream& stream, const InfantryClass& obj) {
+    PutFoot(stream, obj);
+    PutField(stream, obj.type_);
+    PutField(stream, obj.doing_);
+    PutField(stream, obj.fear_);
+    PutField(stream, obj.spot_);
+    PutField(stream, obj.spotTarget_);
+    PutField(stream, obj.isProne_);
+    PutField(stream, obj.isTechnician_);
+    PutField(stream, obj.isStoked_);
+    PutField(stream, obj.isStopping_);
+    PutField(stream, obj.frame_);
+    PutField(stream, obj.stageCount_);
+    PutField(stream, obj.InfantryClass::idleTimer_);
+}
+
+static void GetInfantry(LoadStream& stream, InfantryClass& obj) {
+    GetFoot(stream, obj);
+    GetField(stream, obj.type_);
+    GetField(stream, obj.doing_);
+    GetField(stream, obj.fear_);
+    GetField(stream, obj.spot_);
+    GetField(stream, obj.spotTarget_);
+    GetField(stream, obj.isProne_);
+    GetField(stream, obj.isTechnician_);
+    GetField(stream, obj.isStoked_);
+    GetField(stream, obj.isStopping_);
+    GetField(stream, obj.frame_);
+    GetField(stream, obj.stageCount_);
+    GetField(stream, obj.InfantryClass::idleTimer_);
+}
+
 bool Save_Infantry(SaveStream& stream) {
-    // Placeholder: write count of 0
-    stream.WriteInt32(0);
-    return true;
+    return SavePool(stream, Infantry, PutInfantry);
 }
 
 bool Load_Infantry(LoadStream& stream) {
-    int count = stream.ReadInt32();
-    (void)count;  // TODO: Load infantry
-    return !stream.HasError();
+    return LoadPool(stream, Infantry, GetInfantry);
 }
 
 // Units
+static void PutUnit(SaveStream& stream, const UnitClass& obj) {
+    PutFoot(stream, obj);
+    PutField(stream, obj.type_);
+    PutField(stream, obj.trackStage_);
+    PutField(stream, obj.trackCounter_);
+    PutField(stream, obj.isTurretRotating_);
+    PutField(stream, obj.turretDesiredFacing_);
+    PutField(stream, obj.isHarvesting_);
+    PutField(stream, obj.UnitClass::isDeploying_);
+    PutField(stream, obj.isReturning_);
+    PutField(stream, obj.hasParachute_);
+    PutField(stream, obj.harvestState_);
+    PutField(stream, obj.oreLoad_);
+    PutField(stream, obj.gemsLoad_);
+    PutField(stream, obj.harvestTimer_);
+    PutField(stream, obj.tiltX_);
+    PutField(stream, obj.tiltY_);
+    PutField(stream, obj.passengerCount_);
+    for (int i = 0; i < MAX_PASSENGERS; i++) {
+        PutPointer(stream, obj.passengers_[i]);
+    }
+}
+
+static void GetUnit(LoadStream& stream, UnitClass& obj) {
+    GetFoot(stream, obj);
+    GetField(stream, obj.type_);
+    GetField(stream, obj.trackStage_);
+    GetField(stream, obj.trackCounter_);
+    GetField(stream, obj.isTurretRotating_);
+    GetField(stream, obj.turretDesiredFacing_);
+    GetField(stream, obj.isHarvesting_);
+    GetField(stream, obj.UnitClass::isDeploying_);
+    GetField(stream, obj.isReturning_);
+    GetField(stream, obj.hasParachute_);
+    GetField(stream, obj.harvestState_);
+    GetField(stream, obj.oreLoad_);
+    GetField(stream, obj.gemsLoad_);
+    GetField(stream, obj.harvestTimer_);
+    GetField(stream, obj.tiltX_);
+    GetField(stream, obj.tiltY_);
+    GetField(stream, obj.passengerCount_);
+    for (int i = 0; i < MAX_PASSENGERS; i++) {
+        GetPointer(stream, obj.passengers_[i]);
+    }
+}
+
 bool Save_Units(SaveStream& stream) {
-    stream.WriteInt32(0);
-    return true;
+    return SavePool(stream, Units, PutUnit);
 }
 
 bool Load_Units(LoadStream& stream) {
-    int count = stream.ReadInt32();
-    (void)count;
-    return !stream.HasError();
+    return LoadPool(stream, Units, GetUnit);
 }
 
 // Buildings
+static void PutBuilding(SaveStream& stream, const BuildingClass& obj) {
+    PutTechno(stream, obj);
+    PutField(stream, obj.type_);
+    PutField(stream, obj.bstate_);
+    PutField(stream, obj.bstateTarget_);
+    PutField(stream, obj.frame_);
+    PutField(stream, obj.stageCount_);
+    PutField(stream, obj.animStage_);
+    PutField(stream, obj.factoryState_);
+    PutField(stream, obj.productionProgress_);
+    PutField(stream, obj.producingType_);
+    PutField(stream, obj.producingIndex_);
+    PutField(stream, obj.isPowered_);
+    PutField(stream, obj.isRepairing_);
+    PutField(stream, obj.hasCharged_);
+    PutField(stream, obj.isCapturable_);
+    PutField(stream, obj.isGoingToBlow_);
+    PutField(stream, obj.isSurvivorless_);
+    PutField(stream, obj.countdownTimer_);
+    PutField(stream, obj.chargeTimer_);
+    PutField(stream, obj.lastTargetCoord_);
+}
+
+static void GetBuilding(LoadStream& stream, BuildingClass& obj) {
+    GetTechno(stream, obj);
+    GetField(stream, obj.type_);
+    GetField(stream, obj.bstate_);
+    GetField(stream, obj.bstateTarget_);
+    GetField(stream, obj.frame_);
+    GetField(stream, obj.stageCount_);
+    GetField(stream, obj.animStage_);
+    GetField(stream, obj.factoryState_);
+    GetField(stream, obj.productionProgress_);
+    GetField(stream, obj.producingType_);
+    GetField(stream, obj.producingIndex_);
+    GetField(stream, obj.isPowered_);
+    GetField(stream, obj.isRepairing_);
+    GetField(stream, obj.hasCharged_);
+    GetField(stream, obj.isCapturable_);
+    GetField(stream, obj.isGoingToBlow_);
+    GetField(stream, obj.isSurvivorless_);
+    GetField(stream, obj.countdownTimer_);
+    GetField(stream, obj.chargeTimer_);
+    GetField(stream, obj.lastTargetCoord_);
+}
+
 bool Save_Buildings(SaveStream& stream) {
-    stream.WriteInt32(0);
-    return true;
+    return SavePool(stream, Buildings, PutBuilding);
 }
 
 bool Load_Buildings(LoadStream& stream) {
-    int count = stream.ReadInt32();
-    (void)count;
-    return !stream.HasError();
+    return LoadPool(stream, Buildings, GetBuilding);
 }
 
 // Aircraft
+static void PutAircraft(SaveStream& stream, const AircraftClass& obj) {
+    PutFoot(stream, obj);
+    PutField(stream, obj.type_);
+    PutField(stream, obj.flightState_);
+    PutField(stream, obj.altitude_);
+    PutField(stream, obj.targetAltitude_);
+    PutField(stream, obj.descentRate_);
+    PutField(stream, obj.landingStage_);
+    PutField(stream, obj.landingTarget_);
+    PutField(stream, obj.isReturning_);
+    PutField(stream, obj.isLanding_);
+    PutField(stream, obj.isFlying_);
+    PutField(stream, obj.hasAmmo_);
+    PutField(stream, obj.rotorFrame_);
+    PutField(stream, obj.rotorCounter_);
+    PutField(stream, obj.passengerCount_);
+    for (int i = 0; i < AIRCRAFT_MAX_PASSENGERS; i++) {
+        PutPointer(stream, obj.passengers_[i]);
+    }
+}
+
+static void GetAircraft(LoadStream& stream, AircraftClass& obj) {
+    GetFoot(stream, obj);
+    GetField(stream, obj.type_);
+    GetField(stream, obj.flightState_);
+    GetField(stream, obj.altitude_);
+    GetField(stream, obj.targetAltitude_);
+    GetField(stream, obj.descentRate_);
+    GetField(stream, obj.landingStage_);
+    GetField(stream, obj.landingTarget_);
+    GetField(stream, obj.isReturning_);
+    GetField(stream, obj.isLanding_);
+    GetField(stream, obj.isFlying_);
+    GetField(stream, obj.hasAmmo_);
+    GetField(stream, obj.rotorFrame_);
+    GetField(stream, obj.rotorCounter_);
+    GetField(stream, obj.passengerCount_);
+    for (int i = 0; i < AIRCRAFT_MAX_PASSENGERS; i++) {
+        GetPointer(stream, obj.passengers_[i]);
+    }
+}
+
 bool Save_Aircraft(SaveStream& stream) {
-    stream.WriteInt32(0);
-    return true;
+    return SavePool(stream, Aircraft, PutAircraft);
 }
 
 bool Load_Aircraft(LoadStream& stream) {
-    int count = stream.ReadInt32();
-    (void)count;
-    return !stream.HasError();
+    return LoadPool(stream, Aircraft, GetAircraft);
 }
 
 // Bullets
+static constexpr uint8_t BULLET_SAVE_INACCURATE = 0x01;
+static constexpr uint8_t BULLET_SAVE_HOMING = 0x02;
+static constexpr uint8_t BULLET_SAVE_ARCING = 0x04;
+static constexpr uint8_t BULLET_SAVE_HIGH = 0x08;
+
+static void PutBullet(SaveStream& stream, const BulletClass& obj) {
+    PutObject(stream, obj);
+    PutField(stream, obj.type_);
+    PutPointer(stream, obj.payback_);
+    PutField(stream, obj.warhead_);
+    PutField(stream, obj.damage_);
+    PutField(stream, obj.tarCom_);
+    PutField(stream, obj.targetCoord_);
+    PutField(stream, obj.facing_);
+    PutField(stream, obj.speed_);
+    PutField(stream, obj.maxSpeed_);
+    PutField(stream, obj.sourceCoord_);
+    PutField(stream, obj.state_);
+    PutField(stream, obj.flightTime_);
+    PutField(stream, obj.armingDelay_);
+    PutField(stream, obj.fuelRemaining_);
+
+    uint8_t flags = 0;
+    if (obj.isInaccurate_) flags |= BULLET_SAVE_INACCURATE;
+    if (obj.isHoming_) flags |= BULLET_SAVE_HOMING;
+    if (obj.isArcing_) flags |= BULLET_SAVE_ARCING;
+    if (obj.isHighAltitude_) flags |= BULLET_SAVE_HIGH;
+    stream.WriteUInt8(flags);
+
+    PutField(stream, obj.arcPeak_);
+    PutField(stream, obj.arcProgress_);
+    PutField(stream, obj.frame_);
+}
+
+static void GetBullet(LoadStream& stream, BulletClass& obj) {
+    GetObject(stream, obj);
+    GetField(stream, obj.type_);
+    GetPointer(stream, obj.payback_);
+    GetField(stream, obj.warhead_);
+    GetField(stream, obj.damage_);
+    GetField(stream, obj.tarCom_);
+    GetField(stream, obj.targetCoord_);
+    GetField(stream, obj.facing_);
+    GetField(stream, obj.speed_);
+    GetField(stream, obj.maxSpeed_);
+    GetField(stream, obj.sourceCoord_);
+    GetField(stream, obj.state_);
+    GetField(stream, obj.flightTime_);
+    GetField(stream, obj.armingDelay_);
+    GetField(stream, obj.fuelRemaining_);
+
+    uint8_t flags = stream.ReadUInt8();
+    obj.isInaccurate_ = (flags & BULLET_SAVE_INACCURATE) != 0;
+    obj.isHoming_ = (flags & BULLET_SAVE_HOMING) != 0;
+    obj.isArcing_ = (flags & BULLET_SAVE_ARCING) != 0;
+    obj.isHighAltitude_ = (flags & BULLET_SAVE_HIGH) != 0;
+
+    GetField(stream, obj.arcPeak_);
+    GetField(stream, obj.arcProgress_);
+    GetField(stream, obj.frame_);
+}
+
 bool Save_Bullets(SaveStream& stream) {
-    stream.WriteInt32(0);
-    return true;
+    return SavePool(stream, Bullets, PutBullet);
 }
 
 bool Load_Bullets(LoadStream& stream) {
-    int count = stream.ReadInt32();
-    (void)count;
-    return !stream.HasError();
+    return LoadPool(stream, Bullets, GetBullet);
 }
 
 // Triggers
@@ -1037,10 +1778,29 @@ bool Load_Factories(LoadStream& stream) {
 // Misc values
 bool Save_Misc_Values(SaveStream& stream) {
     stream.WriteUInt32(Frame);
+
+    // Simulation RNG, so play continues exactly where it left off
+    RandomState random;
+    Random_GetSimState(&random);
+    stream.WriteUInt64(Random_GetSeed());
+    for (uint32_t word : random.s) {
+        stream.WriteUInt32(word);
+    }
     return true;
 }
 
 bool Load_Misc_Values(LoadStream& stream) {
     Frame = stream.ReadUInt32();
-    return !stream.HasError();
+
+    // Reseeding restores the cosmetic stream too; then resume the sim
+    // stream from its saved position
+    uint64_t seed = stream.ReadUInt64();
+    RandomState random;
+    for (uint32_t& word : random.s) {
+        word = stream.ReadUInt32();
+    }
+    if (stream.HasError()) return false;
+    Random_Seed(seed);
+    Random_SetSimState(&random);
+    return true;
 }
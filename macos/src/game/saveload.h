@@ -16,21 +16,34 @@
  *   Data Section (variable):
  *     - Scenario state
  *     - House states
- *     - Map/cell data
- *     - All game objects (buildings, units, infantry, aircraft)
+ *     - Map/cell data (one block per cell field)
+ *     - All game objects (buildings, units, infantry, aircraft, bullets)
+ *     - Realtime map grid and unit/building tables
  *     - Triggers and teams
  *     - Factory/production state
  *     - Misc values (frame count, selection, etc.)
+ *
+ * Saves are written through a fixed-size buffer and hashed as they are
+ * flushed, so a save never exists in memory twice. Object references are
+ * stored as (RTTI, pool slot) pairs and resolved once every pool has been
+ * loaded.
  */
 
 #ifndef GAME_SAVELOAD_H
 #define GAME_SAVELOAD_H
 
-#include "types.h"
 #include <cstdint>
 #include <cstdio>
+#include <memory>
 #include <vector>
 
+// Declared in types.h, which can't be included alongside units.h
+enum class RTTIType : int8_t;
+
+// Running MD5 state; defined in saveload.cpp so the platform digest
+// header stays out of this one
+struct SaveDigest;
+
 //===========================================================================
 // Constants
 //===========================================================================
@@ -40,7 +53,7 @@ constexpr uint32_t SAVE_MAGIC = 0x47535241;  // "RASG" in little-endian
 
 // Save game version - increment when format changes
 // Includes sum of key structure sizes for compatibility checking
-constexpr uint32_t SAVEGAME_VERSION = 0x00010001;
+constexpr uint32_t SAVEGAME_VERSION = 0x00010004;
 
 // Maximum description length
 constexpr int SAVE_DESCRIP_MAX = 128;
@@ -54,6 +67,9 @@ constexpr int SAVE_SLOT_MAX = 100;
 // Header size
 constexpr int SAVE_HEADER_SIZE = 160;
 
+// SaveStream write buffer (bytes)
+constexpr size_t SAVE_BUFFER_SIZE = 256 * 1024;
+
 //===========================================================================
 // Save File Header
 //===========================================================================
@@ -86,9 +102,12 @@ public:
     void Close();
     bool IsOpen() const { return file_ != nullptr; }
 
-    // Write raw data
+    // Write raw data (buffered; errors may surface at the next flush)
     bool Write(const void* data, size_t size);
 
+    // Push buffered data to the file
+    bool Flush();
+
     // Write typed data
     bool WriteInt8(int8_t value) { return Write(&value, sizeof(value)); }
     bool WriteInt16(int16_t value) { return Write(&value, sizeof(value)); }
@@ -108,13 +127,25 @@ public:
     // Get bytes written
     size_t BytesWritten() const { return bytesWritten_; }
 
-    // Calculate checksum of written data
+    // Check for write errors
+    bool HasError() const { return hasError_; }
+
+    // Restart the checksum; only data written from here on is hashed
+    void BeginChecksum();
+
+    // Checksum of data written since Open() or BeginChecksum()
     void CalculateChecksum(uint8_t* outChecksum);
 
 private:
+    void HashPending();
+
     FILE* file_;
     size_t bytesWritten_;
-    std::vector<uint8_t> buffer_;  // For checksum calculation
+    bool hasError_;
+    std::vector<uint8_t> buffer_;  // SAVE_BUFFER_SIZE bytes of pending output
+    size_t bufferUsed_;
+    size_t hashedUpTo_;            // Pending bytes already hashed or skipped
+    std::unique_ptr<SaveDigest> md5_;
 };
 
 //===========================================================================
@@ -156,8 +187,14 @@ public:
     // Check for read errors
     bool HasError() const { return hasError_; }
 
-    // Calculate checksum of data from current position
-    void CalculateChecksum(size_t dataSize, uint8_t* outChecksum);
+    // Flag data that read cleanly but failed validation
+    void SetError() { hasError_ = true; }
+
+    // Calculate checksum of data from current position (position is kept)
+    bool CalculateChecksum(size_t dataSize, uint8_t* outChecksum);
+
+    // Bytes from current position to end of file
+    size_t BytesRemaining();
 
 private:
     FILE* file_;
@@ -297,6 +334,13 @@ bool Load_Teams(LoadStream& stream);
 bool Save_Factories(SaveStream& stream);
 bool Load_Factories(LoadStream& stream);
 
+// Realtime map grid (map.cpp) and unit/building tables (units.cpp)
+bool Save_MapCells(SaveStream& stream);
+bool Load_MapCells(LoadStream& stream);
+
+bool Save_Entities(SaveStream& stream);
+bool Load_Entities(LoadStream& stream);
+
 // Misc (frame counter, selection, etc.)
 bool Save_Misc_Values(SaveStream& stream);
 bool Load_Misc_Values(LoadStream& stream);
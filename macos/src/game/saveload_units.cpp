@@ -0,0 +1,238 @@
+/**
+ * Red Alert macOS Port - Save/Load for the Realtime Unit System
+ *
+ * Serializes the map.cpp cell grid and the units.cpp unit/building
+ * tables. Lives apart from saveload.cpp because units.h's C enums share
+ * their names with the ones in types.h.
+ */
+
+#include "saveload.h"
+#include "units.h"
+#include "map.h"
+#include "pathcache.h"
+#include "flowfield.h"
+#include <cstring>
+
+// Fog bits rebuilt from the unit system's viewers rather than saved
+static constexpr uint8_t CELL_TRANSIENT_FLAGS =
+    CELL_FLAG_VISIBLE | CELL_FLAG_VIS_PULSE;
+
+// The route caches decide which path a unit is handed but aren't saved.
+// Both sides drop them, so the game that was saved and the one loaded
+// from it plan every later route the same way.
+static void FlushRouteCaches(void) {
+    PathCache_Invalidate();
+    FlowField_Invalidate();
+}
+
+//===========================================================================
+// Map Grid Save/Load
+//===========================================================================
+
+bool Save_MapCells(SaveStream& stream) {
+    int width = Map_GetWidth();
+    int height = Map_GetHeight();
+
+    stream.WriteInt32(width);
+    stream.WriteInt32(height);
+    stream.WriteUInt32(sizeof(MapCell));
+    stream.WriteBool(Map_IsFogEnabled());
+
+    const Viewport* view = Map_GetViewport();
+    stream.WriteInt32(view->x);
+    stream.WriteInt32(view->y);
+
+    // Rows are contiguous, so each goes out as one block (occupant lists
+    // included, keeping their order)
+    for (int y = 0; y < height; y++) {
+        stream.Write(Map_GetRow(y), width * sizeof(MapCell));
+    }
+
+    return !stream.HasError();
+}
+
+bool Load_MapCells(LoadStream& stream) {
+    int width = stream.ReadInt32();
+    int height = stream.ReadInt32();
+    uint32_t cellSize = stream.ReadUInt32();
+    bool fogEnabled = stream.ReadBool();
+    int viewX = stream.ReadInt32();
+    int viewY = stream.ReadInt32();
+
+    if (stream.HasError() || cellSize != sizeof(MapCell) ||
+        width < 0 || width > MAP_MAX_WIDTH ||
+        height < 0 || height > MAP_MAX_HEIGHT) {
+        return false;
+    }
+
+    // Unit sight and occupancy refer to the map being replaced
+    Units_Clear();
+
+    if (width == 0 || height == 0) {
+        Map_Init();
+        return true;
+    }
+
+    Map_Create(width, height);
+    for (int y = 0; y < height; y++) {
+        MapCell* row = Map_GetRow(y);
+        if (!stream.Read(row, width * sizeof(MapCell))) {
+            return false;
+        }
+        for (int x = 0; x < width; x++) {
+            row[x].flags &= (uint8_t)~CELL_TRANSIENT_FLAGS;
+        }
+    }
+
+    Map_SetFogEnabled(fogEnabled);
+    Map_SetViewport(viewX, viewY);
+    return true;
+}
+
+//===========================================================================
+// Unit/Building Table Save/Load
+//
+// Tables are plain structs, so each live slot is written as one record.
+// Record sizes are stored up front and a mismatch rejects the save.
+//===========================================================================
+
+bool Save_Entities(SaveStream& stream) {
+    FlushRouteCaches();
+
+    stream.WriteUInt32(sizeof(Unit));
+    stream.WriteUInt32(sizeof(Building));
+
+    int unitCount = 0;
+    for (int i = 0; i < MAX_UNITS; i++) {
+        if (Units_Get(i)) unitCount++;
+    }
+    stream.WriteInt32(unitCount);
+    for (int i = 0; i < MAX_UNITS; i++) {
+        const Unit* unit = Units_Get(i);
+        if (unit) {
+            stream.WriteInt16((int16_t)i);
+            stream.Write(unit, sizeof(Unit));
+        }
+    }
+
+    int buildingCount = 0;
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        if (Buildings_Get(i)) buildingCount++;
+    }
+    stream.WriteInt32(buildingCount);
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        const Building* bld = Buildings_Get(i);
+        if (bld) {
+            stream.WriteInt16((int16_t)i);
+            stream.Write(bld, sizeof(Building));
+        }
+    }
+
+    // Discovery flags for DISCOVERED/HOUSE_DISC triggers
+    uint8_t discovered[MAX_UNITS];
+    for (int i = 0; i < MAX_UNITS; i++) {
+        discovered[i] = (uint8_t)Units_WasDiscovered(i);
+    }
+    stream.Write(discovered, sizeof(discovered));
+
+    uint8_t houseDiscovered[HOUSE_COUNT];
+    for (int i = 0; i < HOUSE_COUNT; i++) {
+        houseDiscovered[i] = (uint8_t)Units_WasHouseDiscovered((HouseType)i);
+    }
+    stream.Write(houseDiscovered, sizeof(houseDiscovered));
+
+    // Group move tallies (which routes share a flow field)
+    GroupOrderState groups;
+    Units_GetGroupOrders(&groups);
+    stream.WriteUInt32(groups.tick);
+    for (int i = 0; i < GROUP_ORDER_SLOTS; i++) {
+        const GroupOrder* order = &groups.orders[i];
+        stream.WriteInt32(order->goal);
+        stream.WriteInt32(order->isNaval);
+        stream.WriteUInt32(order->tick);
+        stream.WriteInt32(order->count);
+    }
+
+    return !stream.HasError();
+}
+
+bool Load_Entities(LoadStream& stream) {
+    uint32_t unitSize = stream.ReadUInt32();
+    uint32_t buildingSize = stream.ReadUInt32();
+    if (unitSize != sizeof(Unit) || buildingSize != sizeof(Building)) {
+        return false;
+    }
+
+    // Slots are overwritten directly; Units_RestoreIndexes() below
+    // rebuilds everything derived from them
+    for (int i = 0; i < MAX_UNITS; i++) {
+        memset(Units_GetSlot(i), 0, sizeof(Unit));
+    }
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        memset(Buildings_GetSlot(i), 0, sizeof(Building));
+    }
+
+    int unitCount = stream.ReadInt32();
+    if (unitCount < 0 || unitCount > MAX_UNITS) {
+        return false;
+    }
+    for (int n = 0; n < unitCount; n++) {
+        Unit* unit = Units_GetSlot(stream.ReadInt16());
+        if (!unit || !stream.Read(unit, sizeof(Unit)) ||
+            unit->type >= UNIT_TYPE_COUNT || unit->team >= TEAM_COUNT) {
+            return false;
+        }
+    }
+
+    int buildingCount = stream.ReadInt32();
+    if (buildingCount < 0 || buildingCount > MAX_BUILDINGS) {
+        return false;
+    }
+    for (int n = 0; n < buildingCount; n++) {
+        Building* bld = Buildings_GetSlot(stream.ReadInt16());
+        if (!bld || !stream.Read(bld, sizeof(Building)) ||
+            bld->type >= BUILDING_TYPE_COUNT || bld->team >= TEAM_COUNT) {
+            return false;
+        }
+    }
+
+    uint8_t discovered[MAX_UNITS];
+    uint8_t houseDiscovered[HOUSE_COUNT];
+    if (!stream.Read(discovered, sizeof(discovered)) ||
+        !stream.Read(houseDiscovered, sizeof(houseDiscovered))) {
+        return false;
+    }
+    for (int i = 0; i < MAX_UNITS; i++) {
+        if (discovered[i]) {
+            Units_MarkDiscovered(i);
+        } else {
+            Units_ClearDiscovered(i);
+        }
+    }
+    Units_ClearHouseDiscoveredFlags();
+    for (int i = 0; i < HOUSE_COUNT; i++) {
+        if (houseDiscovered[i]) Units_MarkHouseDiscovered((HouseType)i);
+    }
+
+    GroupOrderState groups;
+    groups.tick = stream.ReadUInt32();
+    for (int i = 0; i < GROUP_ORDER_SLOTS; i++) {
+        GroupOrder* order = &groups.orders[i];
+        order->goal = stream.ReadInt32();
+        order->isNaval = stream.ReadInt32();
+        order->tick = stream.ReadUInt32();
+        order->count = stream.ReadInt32();
+        if (order->count < 0 || (order->count > 0 &&
+            (order->goal < 0 || order->goal >= Map_GetWidth() * Map_GetHeight()))) {
+            return false;
+        }
+    }
+    if (stream.HasError()) {
+        return false;
+    }
+    Units_SetGroupOrders(&groups);
+
+    Units_RestoreIndexes();
+    FlushRouteCaches();
+    return true;
+}
@@ -0,0 +1,242 @@
+/**
+ * Red Alert macOS Port - Spatial Hash Implementation
+ */
+
+#include "spatial.h"
+#include <algorithm>
+
+//===========================================================================
+// Construction
+//===========================================================================
+
+SpatialHash::SpatialHash(int capacity)
+    : capacity_(capacity)
+    , entries_(capacity)
+    , heads_(SPATIAL_TEAMS * SPATIAL_GRID_W * SPATIAL_GRID_H) {
+    for (int t = 0; t < SPATIAL_TEAMS; t++) {
+        members_[t].reserve(capacity);
+    }
+    Clear();
+}
+
+void SpatialHash::Clear() {
+    for (Entry& e : entries_) {
+        e.block = -1;
+    }
+    std::fill(heads_.begin(), heads_.end(), static_cast<int16_t>(-1));
+    for (int t = 0; t < SPATIAL_TEAMS; t++) {
+        members_[t].clear();
+    }
+}
+
+//===========================================================================
+// Maintenance
+//===========================================================================
+
+int SpatialHash::BlockOf(int worldX, int worldY) {
+    int bx = worldX / SPATIAL_BLOCK_SIZE;
+    int by = worldY / SPATIAL_BLOCK_SIZE;
+    bx = std::clamp(bx, 0, SPATIAL_GRID_W - 1);
+    by = std::clamp(by, 0, SPATIAL_GRID_H - 1);
+    return by * SPATIAL_GRID_W + bx;
+}
+
+void SpatialHash::Link(int id) {
+    Entry& e = entries_[id];
+    int16_t& head = heads_[e.team * SPATIAL_GRID_W * SPATIAL_GRID_H + e.block];
+    e.prev = -1;
+    e.next = head;
+    if (head >= 0) entries_[head].prev = static_cast<int16_t>(id);
+    head = static_cast<int16_t>(id);
+}
+
+void SpatialHash::Unlink(int id) {
+    Entry& e = entries_[id];
+    if (e.prev >= 0) {
+        entries_[e.prev].next = e.next;
+    } else {
+        heads_[e.team * SPATIAL_GRID_W * SPATIAL_GRID_H + e.block] = e.next;
+    }
+    if (e.next >= 0) entries_[e.next].prev = e.prev;
+}
+
+void SpatialHash::Insert(int id, int team, int worldX, int worldY) {
+    if (id < 0 || id >= capacity_) return;
+    if (team < 0 || team >= SPATIAL_TEAMS) return;
+    Remove(id);
+
+    Entry& e = entries_[id];
+    e.x = worldX;
+    e.y = worldY;
+    e.team = static_cast<uint8_t>(team);
+    e.block = static_cast<int16_t>(BlockOf(worldX, worldY));
+    Link(id);
+
+    e.member = static_cast<int16_t>(members_[team].size());
+    members_[team].push_back(static_cast<int16_t>(id));
+}
+
+void SpatialHash::Move(int id, int worldX, int worldY) {
+    if (!Contains(id)) return;
+    Entry& e = entries_[id];
+    e.x = worldX;
+    e.y = worldY;
+
+    int block = BlockOf(worldX, worldY);
+    if (block != e.block) {
+        Unlink(id);
+        e.block = static_cast<int16_t>(block);
+        Link(id);
+    }
+}
+
+void SpatialHash::Remove(int id) {
+    if (!Contains(id)) return;
+    Entry& e = entries_[id];
+    Unlink(id);
+    e.block = -1;
+
+    // Swap-remove from the team's dense member list
+    std::vector<int16_t>& members = members_[e.team];
+    int16_t last = members.back();
+    members[e.member] = last;
+    entries_[last].member = e.member;
+    members.pop_back();
+}
+
+const int16_t* SpatialHash::TeamMembers(int team, int* count) const {
+    if (team < 0 || team >= SPATIAL_TEAMS) {
+        *count = 0;
+        return nullptr;
+    }
+    *count = static_cast<int>(members_[team].size());
+    return members_[team].data();
+}
+
+//===========================================================================
+// Queries
+//===========================================================================
+
+int SpatialHash::QueryRadius(int worldX, int worldY, int radius,
+                             uint32_t teamMask, int* outIds,
+                             int maxIds) const {
+    int x0 = 0, y0 = 0;
+    int x1 = SPATIAL_GRID_W - 1, y1 = SPATIAL_GRID_H - 1;
+    int radiusSq = 0;
+    if (radius > 0) {
+        int b0 = BlockOf(worldX - radius, worldY - radius);
+        int b1 = BlockOf(worldX + radius, worldY + radius);
+        x0 = b0 % SPATIAL_GRID_W;
+        y0 = b0 / SPATIAL_GRID_W;
+        x1 = b1 % SPATIAL_GRID_W;
+        y1 = b1 / SPATIAL_GRID_W;
+        radiusSq = radius * radius;
+    }
+
+    int count = 0;
+    for (int t = 0; t < SPATIAL_TEAMS; t++) {
+        if (!(teamMask & SPATIAL_TEAM_BIT(t))) continue;
+        const int16_t* teamHeads = &heads_[t * SPATIAL_GRID_W * SPATIAL_GRID_H];
+
+        for (int by = y0; by <= y1; by++) {
+            for (int bx = x0; bx <= x1; bx++) {
+                for (int id = teamHeads[by * SPATIAL_GRID_W + bx]; id >= 0;
+                     id = entries_[id].next) {
+                    const Entry& e = entries_[id];
+                    if (radius > 0) {
+                        int dx = e.x - worldX;
+                        int dy = e.y - worldY;
+                        if (dx * dx + dy * dy >= radiusSq) continue;
+                    }
+                    if (count >= maxIds) return count;
+                    outIds[count++] = id;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+int SpatialHash::QueryNearest(int worldX, int worldY, int radius,
+                              uint32_t teamMask, int k, int* outIds) const {
+    if (k <= 0) return 0;
+    if (k > SPATIAL_MAX_K) k = SPATIAL_MAX_K;
+
+    // Best k so far, sorted by (distSq, id)
+    int bestDist[SPATIAL_MAX_K];
+    int bestId[SPATIAL_MAX_K];
+    int found = 0;
+
+    int center = BlockOf(worldX, worldY);
+    int cx = center % SPATIAL_GRID_W;
+    int cy = center / SPATIAL_GRID_W;
+    int radiusSq = (radius > 0) ? radius * radius : 0;
+    int maxRing = std::max(SPATIAL_GRID_W, SPATIAL_GRID_H);
+    if (radius > 0) {
+        maxRing = std::min(maxRing, radius / SPATIAL_BLOCK_SIZE + 1);
+    }
+
+    for (int ring = 0; ring <= maxRing; ring++) {
+        if (ring > 0) {
+            // Closest any point in this ring can be: the nearest inner edge
+            int gapL = worldX - (cx - ring + 1) * SPATIAL_BLOCK_SIZE;
+            int gapR = (cx + ring) * SPATIAL_BLOCK_SIZE - worldX;
+            int gapT = worldY - (cy - ring + 1) * SPATIAL_BLOCK_SIZE;
+            int gapB = (cy + ring) * SPATIAL_BLOCK_SIZE - worldY;
+            int gap = std::max(0, std::min(std::min(gapL, gapR),
+                                           std::min(gapT, gapB)));
+            int gapSq = gap * gap;
+            if (radius > 0 && gapSq >= radiusSq) break;
+            if (found == k && gapSq > bestDist[k - 1]) break;
+            if (cx - ring < 0 && cy - ring < 0 &&
+                cx + ring >= SPATIAL_GRID_W && cy + ring >= SPATIAL_GRID_H) {
+                break;  // Ring lies entirely off the grid
+            }
+        }
+
+        for (int by = cy - ring; by <= cy + ring; by++) {
+            if (by < 0 || by >= SPATIAL_GRID_H) continue;
+            bool edgeRow = (by == cy - ring || by == cy + ring);
+            int step = edgeRow ? 1 : 2 * ring;
+
+            for (int bx = cx - ring; bx <= cx + ring; bx += step) {
+                if (bx < 0 || bx >= SPATIAL_GRID_W) continue;
+                int block = by * SPATIAL_GRID_W + bx;
+
+                for (int t = 0; t < SPATIAL_TEAMS; t++) {
+                    if (!(teamMask & SPATIAL_TEAM_BIT(t))) continue;
+                    int id = heads_[t * SPATIAL_GRID_W * SPATIAL_GRID_H + block];
+                    for (; id >= 0; id = entries_[id].next) {
+                        const Entry& e = entries_[id];
+                        int dx = e.x - worldX;
+                        int dy = e.y - worldY;
+                        int distSq = dx * dx + dy * dy;
+                        if (radius > 0 && distSq >= radiusSq) continue;
+
+                        // Insert into the sorted best list
+                        int pos = found;
+                        while (pos > 0 && (distSq < bestDist[pos - 1] ||
+                               (distSq == bestDist[pos - 1] &&
+                                id < bestId[pos - 1]))) {
+                            pos--;
+                        }
+                        if (pos >= k) continue;
+                        int last = (found < k) ? found : k - 1;
+                        for (int i = last; i > pos; i--) {
+                            bestDist[i] = bestDist[i - 1];
+                            bestId[i] = bestId[i - 1];
+                        }
+                        bestDist[pos] = distSq;
+                        bestId[pos] = id;
+                        if (found < k) found++;
+                    }
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < found; i++) {
+        outIds[i] = bestId[i];
+    }
+    return found;
+}
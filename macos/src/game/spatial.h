@@ -0,0 +1,101 @@
+/**
+ * Red Alert macOS Port - Spatial Hash
+ *
+ * Uniform grid of 4x4-cell blocks holding per-team entity lists, used to
+ * answer "who is near this point" without scanning every unit. Entries
+ * are identified by a caller-chosen id (unit or building slot) and carry
+ * their own world position so queries never touch the owning table.
+ */
+
+#ifndef GAME_SPATIAL_H
+#define GAME_SPATIAL_H
+
+#include <cstdint>
+#include <vector>
+
+//===========================================================================
+// Spatial Hash Constants
+//===========================================================================
+
+constexpr int SPATIAL_BLOCK_CELLS = 4;                  // Cells per block side
+constexpr int SPATIAL_CELL_SIZE = 24;                   // Pixels per cell
+constexpr int SPATIAL_BLOCK_SIZE = SPATIAL_BLOCK_CELLS * SPATIAL_CELL_SIZE;
+constexpr int SPATIAL_GRID_W = 128 / SPATIAL_BLOCK_CELLS; // Blocks across
+constexpr int SPATIAL_GRID_H = 128 / SPATIAL_BLOCK_CELLS; // Blocks down
+constexpr int SPATIAL_TEAMS = 4;                        // Team lists per block
+constexpr int SPATIAL_MAX_K = 16;                       // k-nearest limit
+
+// Bit for a team in a query mask
+#define SPATIAL_TEAM_BIT(t)     (1u << (t))
+
+//===========================================================================
+// SpatialHash - bucketed per-team position index
+//===========================================================================
+class SpatialHash {
+public:
+    explicit SpatialHash(int capacity);
+
+    // Drop every entry
+    void Clear();
+
+    // Add an entry; replaces any previous entry with the same id
+    void Insert(int id, int team, int worldX, int worldY);
+
+    // Update an entry's position; relinks only when it changes block
+    void Move(int id, int worldX, int worldY);
+
+    // Remove an entry (no-op if not present)
+    void Remove(int id);
+
+    bool Contains(int id) const {
+        return id >= 0 && id < capacity_ && entries_[id].block >= 0;
+    }
+
+    //-----------------------------------------------------------------------
+    // Queries
+    //
+    // A radius of 0 or less means unlimited. Entries count as inside the
+    // radius when their squared distance is strictly less than radius^2.
+    //-----------------------------------------------------------------------
+
+    // Collect ids of entries in teamMask within radius (unordered)
+    int QueryRadius(int worldX, int worldY, int radius, uint32_t teamMask,
+                    int* outIds, int maxIds) const;
+
+    // Collect up to k nearest entries, closest first; ties go to lower id
+    int QueryNearest(int worldX, int worldY, int radius, uint32_t teamMask,
+                     int k, int* outIds) const;
+
+    // Nearest entry in teamMask within radius, or -1
+    int FindNearest(int worldX, int worldY, int radius,
+                    uint32_t teamMask) const {
+        int id = -1;
+        QueryNearest(worldX, worldY, radius, teamMask, 1, &id);
+        return id;
+    }
+
+    // Dense list of every id registered for a team (unordered)
+    const int16_t* TeamMembers(int team, int* count) const;
+
+private:
+    struct Entry {
+        int32_t x;
+        int32_t y;
+        int16_t next;       // Next entry in block/team list (-1 = end)
+        int16_t prev;       // Previous entry (-1 = list head)
+        int16_t block;      // Block index (-1 = not present)
+        int16_t member;     // Index in members_[team]
+        uint8_t team;
+    };
+
+    static int BlockOf(int worldX, int worldY);
+    void Link(int id);
+    void Unlink(int id);
+
+    int capacity_;
+    std::vector<Entry> entries_;
+    std::vector<int16_t> heads_;                    // [team][block]
+    std::vector<int16_t> members_[SPATIAL_TEAMS];
+};
+
+#endif // GAME_SPATIAL_H
@@ -4,11 +4,16 @@
 
 #include "sprites.h"
 #include "units.h"
+#include "remapcache.h"
 #include "assets/assetloader.h"
+#include "assets/assetcache.h"
 #include "assets/shpfile.h"
 #include "graphics/metal/renderer.h"
 #include <cstdio>
+#include <atomic>
 #include <cstring>
+#include <strings.h>
+#include <vector>
 
 //===========================================================================
 // Color Remapping for Team Colors
@@ -270,11 +275,14 @@ static const char* g_buildingSpriteNames[BUILDING_TYPE_COUNT] = {
     "V19.SHP",      // BUILDING_CIV_19 - Oil derrick
 };
 
-// Loaded sprites
-static ShpFileHandle g_unitSprites[UNIT_TYPE_COUNT] = {nullptr};
-static ShpFileHandle g_buildingSprites[BUILDING_TYPE_COUNT] = {nullptr};
+// Sprite handles in the asset cache, resolved on first draw
+static AssetHandle g_unitSprites[UNIT_TYPE_COUNT];
+static AssetHandle g_buildingSprites[BUILDING_TYPE_COUNT];
 static bool g_spritesInitialized = false;
-static int g_spritesLoaded = 0;
+static std::atomic<int> g_spritesLoaded{ 0 };     // Loads may run on asset workers
+
+// Sprites retained for the current scenario
+static std::vector<AssetHandle> g_prefetched;
 
 // Infantry have 8 facings with multiple frames per facing
 // Vehicles have 32 facings (8 base * animation)
@@ -294,62 +302,147 @@ static int GetUnitFrameForFacing(UnitType type, int facing, int animFrame) {
     }
 }
 
+//===========================================================================
+// Asset Cache Hooks
+//===========================================================================
+
+static void* LoadSpriteAsset(const char* name) {
+    ShpFileHandle shp = Assets_LoadSHP(name);
+    if (shp) {
+        g_spritesLoaded++;
+        fprintf(stderr, "Sprites: Loaded %s (%d frames)\n", name, Shp_GetFrameCount(shp));
+    } else {
+        fprintf(stderr, "Sprites: MISSING %s\n", name);
+    }
+    return shp;
+}
+
+static void UnloadSpriteAsset(void* data) {
+    ShpFileHandle shp = static_cast<ShpFileHandle>(data);
+    RemapCache_Forget(shp);
+    Shp_Free(shp);
+}
+
+static uint32_t SpriteAssetSize(const void* data) {
+    return Shp_GetDataSize(static_cast<ShpFileHandle>(const_cast<void*>(data)));
+}
+
+static ShpFileHandle UnitSprite(UnitType type) {
+    if (!g_spritesInitialized) return nullptr;
+    return static_cast<ShpFileHandle>(AssetCache_Get(g_unitSprites[type]));
+}
+
+static ShpFileHandle BuildingSprite(BuildingType type) {
+    if (!g_spritesInitialized) return nullptr;
+    return static_cast<ShpFileHandle>(AssetCache_Get(g_buildingSprites[type]));
+}
+
+static void ReleasePrefetched(void) {
+    for (AssetHandle handle : g_prefetched) {
+        AssetCache_Release(handle);
+    }
+    g_prefetched.clear();
+}
+
+//===========================================================================
+// Public API
+//===========================================================================
+
 BOOL Sprites_Init(void) {
     if (g_spritesInitialized) return TRUE;
 
-    fprintf(stderr, "Sprites: Loading unit sprites...\n");
+    // Register every sprite name; each SHP is decoded on first draw, or
+    // when a scenario that places it is loaded
+    AssetLoader loader = { LoadSpriteAsset, UnloadSpriteAsset, SpriteAssetSize };
+    AssetCache_SetLoader(ASSET_SHP, &loader);
 
-    // Load unit sprites
-    for (int i = 1; i < UNIT_TYPE_COUNT; i++) {
-        if (g_unitSpriteNames[i]) {
-            g_unitSprites[i] = Assets_LoadSHP(g_unitSpriteNames[i]);
-            if (g_unitSprites[i]) {
-                g_spritesLoaded++;
-                int frames = Shp_GetFrameCount(g_unitSprites[i]);
-                fprintf(stderr, "  Loaded %s (%d frames)\n",
-                       g_unitSpriteNames[i], frames);
-            } else {
-                fprintf(stderr, "  MISSING: %s\n", g_unitSpriteNames[i]);
-            }
-        }
+    for (int i = 0; i < UNIT_TYPE_COUNT; i++) {
+        g_unitSprites[i] = AssetCache_Find(ASSET_SHP, g_unitSpriteNames[i]);
     }
-
-    // Load building sprites
-    fprintf(stderr, "Sprites: Loading building sprites...\n");
-    for (int i = 1; i < BUILDING_TYPE_COUNT; i++) {
-        if (g_buildingSpriteNames[i]) {
-            g_buildingSprites[i] = Assets_LoadSHP(g_buildingSpriteNames[i]);
-            if (g_buildingSprites[i]) {
-                g_spritesLoaded++;
-                int frames = Shp_GetFrameCount(g_buildingSprites[i]);
-                fprintf(stderr, "  Loaded %s (%d frames)\n",
-                       g_buildingSpriteNames[i], frames);
-            } else {
-                fprintf(stderr, "  MISSING: %s\n", g_buildingSpriteNames[i]);
-            }
-        }
+    for (int i = 0; i < BUILDING_TYPE_COUNT; i++) {
+        g_buildingSprites[i] = AssetCache_Find(ASSET_SHP, g_buildingSpriteNames[i]);
     }
 
     g_spritesInitialized = true;
-    fprintf(stderr, "Sprites: Loaded %d sprites total\n", g_spritesLoaded);
+    fprintf(stderr, "Sprites: Registered %d unit and %d building sprites\n",
+            UNIT_TYPE_COUNT - 1, BUILDING_TYPE_COUNT - 1);
     return TRUE; // Return TRUE even with 0 sprites (fallback rendering works)
 }
 
-void Sprites_Shutdown(void) {
-    for (int i = 0; i < UNIT_TYPE_COUNT; i++) {
-        if (g_unitSprites[i]) {
-            Shp_Free(g_unitSprites[i]);
-            g_unitSprites[i] = nullptr;
-        }
+void Sprites_Prefetch(const UnitType* units, int unitCount,
+                      const BuildingType* buildings, int buildingCount) {
+    if (!g_spritesInitialized) return;
+
+    // Retain the new set before releasing the old, so sprites both
+    // scenarios use stay resident
+    std::vector<AssetHandle> previous;
+    previous.swap(g_prefetched);
+
+    bool unitSeen[UNIT_TYPE_COUNT] = {};
+    bool buildingSeen[BUILDING_TYPE_COUNT] = {};
+    for (int i = 0; i < unitCount; i++) {
+        UnitType type = units[i];
+        if (type <= UNIT_NONE || type >= UNIT_TYPE_COUNT || unitSeen[type]) continue;
+        unitSeen[type] = true;
+        if (g_unitSprites[type] == ASSET_NONE) continue;
+        AssetCache_Retain(g_unitSprites[type]);
+        g_prefetched.push_back(g_unitSprites[type]);
+    }
+    for (int i = 0; i < buildingCount; i++) {
+        BuildingType type = buildings[i];
+        if (type <= BUILDING_NONE || type >= BUILDING_TYPE_COUNT || buildingSeen[type]) continue;
+        buildingSeen[type] = true;
+        if (g_buildingSprites[type] == ASSET_NONE) continue;
+        AssetCache_Retain(g_buildingSprites[type]);
+        g_prefetched.push_back(g_buildingSprites[type]);
     }
 
-    for (int i = 0; i < BUILDING_TYPE_COUNT; i++) {
-        if (g_buildingSprites[i]) {
-            Shp_Free(g_buildingSprites[i]);
-            g_buildingSprites[i] = nullptr;
-        }
+    for (AssetHandle handle : previous) {
+        AssetCache_Release(handle);
+    }
+
+    const AssetCacheStats* stats = AssetCache_GetStats();
+    fprintf(stderr, "Sprites: Prefetching %d sprites (%u KB resident)\n",
+            (int)g_prefetched.size(), stats->bytes / 1024);
+}
+
+void Sprites_Hint(const char* iniName) {
+    if (!g_spritesInitialized || !iniName || !iniName[0]) return;
+
+    char shpName[16];
+    snprintf(shpName, sizeof(shpName), "%s.SHP", iniName);
+    for (int i = 1; i < UNIT_TYPE_COUNT; i++) {
+        if (strcasecmp(g_unitSpriteNames[i], shpName) == 0) AssetCache_Hint(g_unitSprites[i]);
+    }
+    for (int i = 1; i < BUILDING_TYPE_COUNT; i++) {
+        if (strcasecmp(g_buildingSpriteNames[i], shpName) == 0) AssetCache_Hint(g_buildingSprites[i]);
+    }
+}
+
+void Sprites_HintUnit(UnitType type) {
+    if (!g_spritesInitialized || type <= UNIT_NONE || type >= UNIT_TYPE_COUNT) return;
+    AssetCache_Hint(g_unitSprites[type]);
+}
+
+void Sprites_HintBuilding(BuildingType type) {
+    if (!g_spritesInitialized || type <= BUILDING_NONE || type >= BUILDING_TYPE_COUNT) return;
+    AssetCache_Hint(g_buildingSprites[type]);
+}
+
+void Sprites_Shutdown(void) {
+    if (!g_spritesInitialized) return;
+
+    const RemapCacheStats* stats = RemapCache_GetStats();
+    if (stats->lookups > 0) {
+        fprintf(stderr, "Sprites: remap cache %u/%u hits, %u evictions, %u KB in %u frames\n",
+                stats->hits, stats->lookups, stats->evictions,
+                stats->bytes / 1024, stats->entries);
     }
 
+    ReleasePrefetched();
+    AssetCache_Flush(ASSET_SHP);
+    RemapCache_Clear();
+
     g_spritesInitialized = false;
     g_spritesLoaded = 0;
 }
@@ -358,15 +451,34 @@ BOOL Sprites_Available(void) {
     return g_spritesInitialized && g_spritesLoaded > 0;
 }
 
+// Spans to draw a frame in a team colour. The gold table is the identity
+// and other colours come pre-remapped from the cache; either way *remap
+// is cleared so the blit copies pixels unchanged. NULL if the frame has
+// no spans.
+static const uint8_t* TeamSpans(ShpFileHandle shp, int index,
+                                const ShpFrame* frame, const uint8_t** remap) {
+    if (!frame->spans) return nullptr;
+    if (*remap == g_remapGold) {
+        *remap = nullptr;
+        return frame->spans;
+    }
+    const uint8_t* cached = RemapCache_Get(shp, index, frame, *remap);
+    if (cached) {
+        *remap = nullptr;
+        return cached;
+    }
+    return frame->spans;
+}
+
 BOOL Sprites_RenderUnit(UnitType type, int facing, int frame,
                         int screenX, int screenY, uint8_t teamColor) {
     if (type <= UNIT_NONE || type >= UNIT_TYPE_COUNT) return FALSE;
 
-    ShpFileHandle shp = g_unitSprites[type];
+    ShpFileHandle shp = UnitSprite(type);
 
     // Fallback: if civilian sprite missing, use C1 (UNIT_CIVILIAN_1)
     if (!shp && type >= UNIT_CIVILIAN_1 && type <= UNIT_CHAN) {
-        shp = g_unitSprites[UNIT_CIVILIAN_1];
+        shp = UnitSprite(UNIT_CIVILIAN_1);
     }
 
     if (!shp) return FALSE;
@@ -389,11 +501,20 @@ BOOL Sprites_RenderUnit(UnitType type, int facing, int frame,
     const uint8_t* remap = Sprites_GetRemapTable(teamColor);
 
     // Render centered on position with color remapping
-    Renderer_BlitSpriteRemapped(shpFrame->pixels,
-                                shpFrame->width, shpFrame->height,
-                                screenX, screenY,
-                                shpFrame->width / 2, shpFrame->height / 2,
-                                TRUE, remap);
+    const uint8_t* spans = TeamSpans(shp, frameIndex, shpFrame, &remap);
+    if (spans) {
+        Renderer_BlitSpriteSpans(spans,
+                                 shpFrame->width, shpFrame->height,
+                                 screenX, screenY,
+                                 shpFrame->width / 2, shpFrame->height / 2,
+                                 remap);
+    } else {
+        Renderer_BlitSpriteRemapped(shpFrame->pixels,
+                                    shpFrame->width, shpFrame->height,
+                                    screenX, screenY,
+                                    shpFrame->width / 2, shpFrame->height / 2,
+                                    TRUE, remap);
+    }
 
     return TRUE;
 }
@@ -402,7 +523,7 @@ BOOL Sprites_RenderBuilding(BuildingType type, int frame,
                             int screenX, int screenY, uint8_t teamColor) {
     if (type <= BUILDING_NONE || type >= BUILDING_TYPE_COUNT) return FALSE;
 
-    ShpFileHandle shp = g_buildingSprites[type];
+    ShpFileHandle shp = BuildingSprite(type);
     if (!shp) return FALSE;
 
     int frameCount = Shp_GetFrameCount(shp);
@@ -418,20 +539,24 @@ BOOL Sprites_RenderBuilding(BuildingType type, int frame,
     const uint8_t* remap = Sprites_GetRemapTable(teamColor);
 
     // Render at top-left position with color remapping
-    Renderer_BlitRemapped(shpFrame->pixels, shpFrame->width, shpFrame->height,
-                          screenX, screenY, TRUE, remap);
+    const uint8_t* spans = TeamSpans(shp, frameIndex, shpFrame, &remap);
+    if (spans) {
+        Renderer_BlitSpans(spans, shpFrame->width, shpFrame->height,
+                           screenX, screenY, remap);
+    } else {
+        Renderer_BlitRemapped(shpFrame->pixels, shpFrame->width, shpFrame->height,
+                              screenX, screenY, TRUE, remap);
+    }
 
     return TRUE;
 }
 
 int Sprites_GetUnitFrameCount(UnitType type) {
     if (type <= UNIT_NONE || type >= UNIT_TYPE_COUNT) return 0;
-    if (!g_unitSprites[type]) return 0;
-    return Shp_GetFrameCount(g_unitSprites[type]);
+    return Shp_GetFrameCount(UnitSprite(type));
 }
 
 int Sprites_GetBuildingFrameCount(BuildingType type) {
     if (type <= BUILDING_NONE || type >= BUILDING_TYPE_COUNT) return 0;
-    if (!g_buildingSprites[type]) return 0;
-    return Shp_GetFrameCount(g_buildingSprites[type]);
+    return Shp_GetFrameCount(BuildingSprite(type));
 }
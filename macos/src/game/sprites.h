@@ -16,7 +16,8 @@ extern "C" {
 #endif
 
 /**
- * Initialize sprite system and load sprites from MIX archives.
+ * Initialize sprite system. Sprites are registered with the asset cache
+ * and loaded from MIX archives on first use.
  * Call after Assets_Init().
  * @return TRUE on success
  */
@@ -27,6 +28,23 @@ BOOL Sprites_Init(void);
  */
 void Sprites_Shutdown(void);
 
+/**
+ * Load the sprites a scenario places and keep them resident until the
+ * next call; sprites of the previous scenario become evictable.
+ * Loads run in the background when asset workers are running.
+ */
+void Sprites_Prefetch(const UnitType* units, int unitCount,
+                      const BuildingType* buildings, int buildingCount);
+
+/**
+ * Start decoding a sprite that will be needed soon (queued production,
+ * the AI's next building) in the background.
+ * @param iniName INI type name, e.g. "1TNK"
+ */
+void Sprites_Hint(const char* iniName);
+void Sprites_HintUnit(UnitType type);
+void Sprites_HintBuilding(BuildingType type);
+
 /**
  * Check if sprite system has loaded any sprites.
  */
@@ -3,11 +3,14 @@
  */
 
 #include "terrain.h"
+#include "random.h"
 #include "assets/assetloader.h"
+#include "assets/assetcache.h"
 #include "assets/tmpfile.h"
 #include "graphics/metal/renderer.h"
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 // Terrain template names for SNOW tileset
 // These are the .sno files based on OpenRA's snow.yaml
@@ -124,7 +127,7 @@ BOOL Terrain_Init(void) {
         memset(g_clearTile, 141, g_tileSize * g_tileSize);
         // Add some subtle variation
         for (int i = 0; i < g_tileSize * g_tileSize; i++) {
-            g_clearTile[i] = 140 + (rand() % 4);  // Subtle noise
+            g_clearTile[i] = 140 + Random_Cosmetic(4);  // Subtle noise
         }
     }
 
@@ -134,7 +137,12 @@ BOOL Terrain_Init(void) {
     return TRUE;
 }
 
+static void ReleasePrefetchedTemplates(void);
+
 void Terrain_Shutdown(void) {
+    ReleasePrefetchedTemplates();
+    AssetCache_Flush(ASSET_TMP);
+
     for (int i = 0; i < g_terrainTemplateCount; i++) {
         if (g_terrainTmp[i]) {
             Tmp_Free(g_terrainTmp[i]);
@@ -307,35 +315,19 @@ static const char* GetTemplateFilename(int templateID, const char* ext) {
     return filename;
 }
 
-// Template cache - stores loaded templates indexed by ID
-#define MAX_CACHED_TEMPLATES 256
-static TmpFileHandle g_templateCache[MAX_CACHED_TEMPLATES] = {nullptr};
+// Template handles in the asset cache, per theater, indexed by ID.
+// Switching theater keeps the other theaters' templates until the cache
+// needs the room.
+#define MAX_TEMPLATE_IDS    256
+#define THEATER_COUNT       4
+static AssetHandle g_templateHandles[THEATER_COUNT][MAX_TEMPLATE_IDS];
+static bool g_templateLoaderReady = false;
 static int g_currentTheater = 1;  // Default to snow
 
-// Load a template by ID, caching for future use
-static TmpFileHandle LoadTemplateByID(int templateID) {
-    if (templateID < 0 || templateID >= MAX_CACHED_TEMPLATES) {
-        templateID = 255;  // Default to clear
-    }
-
-    // Return cached if available
-    if (g_templateCache[templateID]) {
-        return g_templateCache[templateID];
-    }
-
-    // Get theater extension
-    const char* ext = ".sno";  // Default to snow
-    switch (g_currentTheater) {
-        case 0: ext = ".tem"; break;  // Temperate
-        case 1: ext = ".sno"; break;  // Snow
-        case 2: ext = ".int"; break;  // Interior
-        case 3: ext = ".des"; break;  // Desert
-    }
-
-    // Get filename and try to load
-    const char* filename = GetTemplateFilename(templateID, ext);
-    if (!filename) return nullptr;
+// Templates retained for the current map
+static std::vector<AssetHandle> g_prefetchedTemplates;
 
+static void* LoadTemplateAsset(const char* filename) {
     uint32_t size = 0;
     void* data = Assets_LoadTemplate(filename, &size);
     if (!data) {
@@ -353,24 +345,59 @@ static TmpFileHandle LoadTemplateByID(int templateID) {
 
     TmpFileHandle tmp = Tmp_Load(data, size);
     free(data);
+    return tmp;
+}
 
-    if (tmp) {
-        g_templateCache[templateID] = tmp;
-    }
+static void UnloadTemplateAsset(void* data) {
+    Tmp_Free(static_cast<TmpFileHandle>(data));
+}
 
-    return tmp;
+static uint32_t TemplateAssetSize(const void* data) {
+    return Tmp_GetDataSize(static_cast<TmpFileHandle>(const_cast<void*>(data)));
 }
 
-void Terrain_SetTheater(int theater) {
-    if (theater == g_currentTheater) return;
+static void InstallTemplateLoader(void) {
+    if (g_templateLoaderReady) return;
+    AssetLoader loader = { LoadTemplateAsset, UnloadTemplateAsset, TemplateAssetSize };
+    AssetCache_SetLoader(ASSET_TMP, &loader);
+    for (int t = 0; t < THEATER_COUNT; t++) {
+        for (int i = 0; i < MAX_TEMPLATE_IDS; i++) {
+            g_templateHandles[t][i] = ASSET_NONE;
+        }
+    }
+    g_templateLoaderReady = true;
+}
 
-    // Clear template cache
-    for (int i = 0; i < MAX_CACHED_TEMPLATES; i++) {
-        if (g_templateCache[i]) {
-            Tmp_Free(g_templateCache[i]);
-            g_templateCache[i] = nullptr;
+// Asset handle of a template in the current theater
+static AssetHandle TemplateHandle(int templateID) {
+    InstallTemplateLoader();
+    if (templateID < 0 || templateID >= MAX_TEMPLATE_IDS) {
+        templateID = 255;  // Default to clear
+    }
+
+    AssetHandle* handle = &g_templateHandles[g_currentTheater][templateID];
+    if (*handle == ASSET_NONE) {
+        // Get theater extension
+        const char* ext = ".sno";  // Default to snow
+        switch (g_currentTheater) {
+            case 0: ext = ".tem"; break;  // Temperate
+            case 1: ext = ".sno"; break;  // Snow
+            case 2: ext = ".int"; break;  // Interior
+            case 3: ext = ".des"; break;  // Desert
         }
+        *handle = AssetCache_Find(ASSET_TMP, GetTemplateFilename(templateID, ext));
     }
+    return *handle;
+}
+
+// Load a template by ID (from the cache, or decoded on first use)
+static TmpFileHandle LoadTemplateByID(int templateID) {
+    return static_cast<TmpFileHandle>(AssetCache_Get(TemplateHandle(templateID)));
+}
+
+void Terrain_SetTheater(int theater) {
+    if (theater == g_currentTheater) return;
+    if (theater < 0 || theater >= THEATER_COUNT) return;
 
     g_currentTheater = theater;
 
@@ -378,6 +405,36 @@ void Terrain_SetTheater(int theater) {
     LoadTemplateByID(255);
 }
 
+static void ReleasePrefetchedTemplates(void) {
+    for (AssetHandle handle : g_prefetchedTemplates) {
+        AssetCache_Release(handle);
+    }
+    g_prefetchedTemplates.clear();
+}
+
+void Terrain_PrefetchTemplates(const uint8_t* templateIDs, int count) {
+    // Retain the new set before releasing the old, so templates both
+    // maps use stay resident
+    std::vector<AssetHandle> previous;
+    previous.swap(g_prefetchedTemplates);
+
+    bool seen[MAX_TEMPLATE_IDS] = {};
+    for (int i = 0; i < count; i++) {
+        int id = templateIDs[i];
+        if (id == 0) id = 255;      // Clear, as Terrain_RenderByID draws it
+        if (seen[id]) continue;
+        seen[id] = true;
+
+        AssetHandle handle = TemplateHandle(id);
+        AssetCache_Retain(handle);
+        g_prefetchedTemplates.push_back(handle);
+    }
+
+    for (AssetHandle handle : previous) {
+        AssetCache_Release(handle);
+    }
+}
+
 BOOL Terrain_RenderByID(int templateID, int tileIndex,
                         int screenX, int screenY) {
     if (!g_terrainInitialized) {
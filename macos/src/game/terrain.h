@@ -40,4 +40,8 @@ BOOL Terrain_RenderByID(int templateID, int tileIndex,
 // theater: 0=temperate, 1=snow, 2=interior, 3=desert
 void Terrain_SetTheater(int theater);
 
+// Load the templates a map uses (one ID per cell) and keep them resident
+// until the next call; the previous map's become evictable
+void Terrain_PrefetchTemplates(const uint8_t* templateIDs, int count);
+
 #endif // TERRAIN_H
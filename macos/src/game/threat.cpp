@@ -0,0 +1,106 @@
+/**
+ * Red Alert macOS Port - Threat Map Implementation
+ */
+
+#include "threat.h"
+#include <cstring>
+
+// Raw per-tile strength, kept current by Threat_Add/Threat_Move
+static int32_t g_raw[TEAM_COUNT][THREAT_TILES_Y][THREAT_TILES_X];
+
+// Blurred copies, and the hostile sum per team, valid while !g_dirty
+static int32_t g_blurred[TEAM_COUNT][THREAT_TILES_Y][THREAT_TILES_X];
+static int32_t g_hostile[TEAM_COUNT][THREAT_TILES_Y][THREAT_TILES_X];
+static bool g_dirty = true;
+
+// Binomial 5-tap kernel; two passes give x 256 overall
+static const int KERNEL[5] = { 1, 4, 6, 4, 1 };
+
+static bool TileOf(int cellX, int cellY, int* tileX, int* tileY) {
+    if (cellX < 0 || cellY < 0) return false;
+    *tileX = cellX / THREAT_TILE_SIZE;
+    *tileY = cellY / THREAT_TILE_SIZE;
+    return *tileX < THREAT_TILES_X && *tileY < THREAT_TILES_Y;
+}
+
+static void BlurTeam(int team) {
+    static int32_t rows[THREAT_TILES_Y][THREAT_TILES_X];
+
+    for (int y = 0; y < THREAT_TILES_Y; y++) {
+        for (int x = 0; x < THREAT_TILES_X; x++) {
+            int32_t sum = 0;
+            for (int k = -2; k <= 2; k++) {
+                int sx = x + k;
+                if (sx >= 0 && sx < THREAT_TILES_X) sum += g_raw[team][y][sx] * KERNEL[k + 2];
+            }
+            rows[y][x] = sum;
+        }
+    }
+    for (int y = 0; y < THREAT_TILES_Y; y++) {
+        for (int x = 0; x < THREAT_TILES_X; x++) {
+            int32_t sum = 0;
+            for (int k = -2; k <= 2; k++) {
+                int sy = y + k;
+                if (sy >= 0 && sy < THREAT_TILES_Y) sum += rows[sy][x] * KERNEL[k + 2];
+            }
+            g_blurred[team][y][x] = sum;
+        }
+    }
+}
+
+static void Refresh(void) {
+    if (!g_dirty) return;
+    for (int team = 0; team < TEAM_COUNT; team++) {
+        BlurTeam(team);
+    }
+    for (int team = 0; team < TEAM_COUNT; team++) {
+        memset(g_hostile[team], 0, sizeof(g_hostile[team]));
+        for (int other = TEAM_PLAYER; other < TEAM_COUNT; other++) {
+            if (other == team) continue;
+            for (int y = 0; y < THREAT_TILES_Y; y++) {
+                for (int x = 0; x < THREAT_TILES_X; x++) {
+                    g_hostile[team][y][x] += g_blurred[other][y][x];
+                }
+            }
+        }
+    }
+    g_dirty = false;
+}
+
+void Threat_Clear(void) {
+    memset(g_raw, 0, sizeof(g_raw));
+    g_dirty = true;
+}
+
+void Threat_Add(int team, int cellX, int cellY, int strength) {
+    int tx, ty;
+    if (team < 0 || team >= TEAM_COUNT || strength == 0) return;
+    if (!TileOf(cellX, cellY, &tx, &ty)) return;
+    g_raw[team][ty][tx] += strength;
+    g_dirty = true;
+}
+
+void Threat_Move(int team, int fromX, int fromY, int toX, int toY, int strength) {
+    int fx, fy, tx, ty;
+    bool fromOk = TileOf(fromX, fromY, &fx, &fy);
+    bool toOk = TileOf(toX, toY, &tx, &ty);
+    if (fromOk && toOk && fx == tx && fy == ty) return;
+    Threat_Add(team, fromX, fromY, -strength);
+    Threat_Add(team, toX, toY, strength);
+}
+
+int Threat_At(int team, int cellX, int cellY) {
+    int tx, ty;
+    if (team < 0 || team >= TEAM_COUNT) return 0;
+    if (!TileOf(cellX, cellY, &tx, &ty)) return 0;
+    Refresh();
+    return g_blurred[team][ty][tx];
+}
+
+int Threat_Against(int team, int cellX, int cellY) {
+    int tx, ty;
+    if (team < 0 || team >= TEAM_COUNT) return 0;
+    if (!TileOf(cellX, cellY, &tx, &ty)) return 0;
+    Refresh();
+    return g_hostile[team][ty][tx];
+}
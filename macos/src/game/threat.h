@@ -0,0 +1,52 @@
+/**
+ * Red Alert macOS Port - Threat Map
+ *
+ * Per-team influence grid at a coarse resolution (4x4 cell tiles). Armed
+ * units and defensive buildings add their attack damage to the tile they
+ * stand in as they are placed, move across tiles and die; queries read a
+ * blurred copy, so strength spreads a couple of tiles past its source.
+ * The blur is a separable 5-tap pass redone lazily on the first query
+ * after a change.
+ *
+ * Readings are attack damage scaled by the blur's total weight of 256: a
+ * lone source of damage D reads 36 * D on its own tile and nothing three
+ * or more tiles away.
+ */
+
+#ifndef GAME_THREAT_H
+#define GAME_THREAT_H
+
+#include "units.h"
+#include "map.h"
+
+#define THREAT_TILE_SIZE    4
+#define THREAT_TILES_X      (MAP_MAX_WIDTH / THREAT_TILE_SIZE)
+#define THREAT_TILES_Y      (MAP_MAX_HEIGHT / THREAT_TILE_SIZE)
+
+/**
+ * Zero every team's grid
+ */
+void Threat_Clear(void);
+
+/**
+ * Add (or with negative strength, remove) a source at a cell
+ */
+void Threat_Add(int team, int cellX, int cellY, int strength);
+
+/**
+ * Move a source between cells (no work unless it changes tile)
+ */
+void Threat_Move(int team, int fromX, int fromY, int toX, int toY, int strength);
+
+/**
+ * Blurred influence of one team at a cell
+ */
+int Threat_At(int team, int cellX, int cellY);
+
+/**
+ * Blurred influence at a cell of every team hostile to the given one
+ * (all other teams except neutral)
+ */
+int Threat_Against(int team, int cellX, int cellY);
+
+#endif // GAME_THREAT_H
@@ -8,6 +8,12 @@
 #include "sprites.h"
 #include "sounds.h"
 #include "voice_types.h"
+#include "spatial.h"
+#include "pathgraph.h"
+#include "flowfield.h"
+#include "pathcache.h"
+#include "threat.h"
+#include "random.h"
 #include "graphics/metal/renderer.h"
 
 // Unit type accessor - avoid header conflicts with types.h
@@ -191,6 +197,12 @@ static const BuildingTypeDef g_buildingTypes[BUILDING_TYPE_COUNT] = {
 static Unit g_units[MAX_UNITS];
 static Building g_buildings[MAX_BUILDINGS];
 
+// Live counts kept in step with spawn/remove, so trigger conditions don't
+// have to scan the tables
+static int g_teamUnitCount[TEAM_COUNT];
+static int g_teamBuildingCount[TEAM_COUNT];
+static int g_teamBuildingTypeCount[TEAM_COUNT][BUILDING_TYPE_COUNT];
+
 // Team colors
 static const uint8_t g_teamColors[TEAM_COUNT] = {
     7,  // TEAM_NEUTRAL - gray
@@ -206,9 +218,270 @@ void Units_Shutdown(void) {
     // Nothing to free
 }
 
+static void Occupancy_Clear(void);
+static void Sight_Clear(void);
+static void ThreatSource_Clear(void);
+
+// Spatial hashes for target acquisition (live units on the map, buildings)
+static SpatialHash g_unitHash(MAX_UNITS);
+static SpatialHash g_buildingHash(MAX_BUILDINGS);
+
+// Move orders tallied per goal cell (see Group Orders below)
+static GroupOrder g_groupOrders[GROUP_ORDER_SLOTS];
+static uint32_t g_unitTick = 0;     // Units_Update calls
+
 void Units_Clear(void) {
+    Sight_Clear();
+    ThreatSource_Clear();
     memset(g_units, 0, sizeof(g_units));
     memset(g_buildings, 0, sizeof(g_buildings));
+    memset(g_teamUnitCount, 0, sizeof(g_teamUnitCount));
+    memset(g_teamBuildingCount, 0, sizeof(g_teamBuildingCount));
+    memset(g_teamBuildingTypeCount, 0, sizeof(g_teamBuildingTypeCount));
+    Occupancy_Clear();
+    g_unitHash.Clear();
+    g_buildingHash.Clear();
+    memset(g_groupOrders, 0, sizeof(g_groupOrders));
+    g_unitTick = 0;
+}
+
+//===========================================================================
+// Cell Occupancy Index
+//
+// Every live unit standing on the map is registered in its cell's
+// MapCell::occupants list. Registration follows spawn, cell changes,
+// death, removal and transport load/unload; loaded passengers and dying
+// units are not registered. When more than MAP_CELL_OCCUPANTS units
+// share a cell the extras are only counted, and lookups on that cell
+// fall back to scanning the unit table.
+//===========================================================================
+
+// Cell index each unit is registered in (-1 = not registered)
+static int16_t g_unitOccCell[MAX_UNITS];
+
+static uint16_t PackOccupant(int unitId) {
+    const Unit* unit = &g_units[unitId];
+    uint16_t packed = (uint16_t)(unitId & OCCUPANT_ID_MASK);
+    packed |= (uint16_t)((unit->team & OCCUPANT_TEAM_MASK) << OCCUPANT_TEAM_SHIFT);
+    if (g_unitTypes[unit->type].isInfantry) packed |= OCCUPANT_INFANTRY;
+    return packed;
+}
+
+static MapCell* OccupancyCell(int cellIdx) {
+    int mapW = Map_GetWidth();
+    if (cellIdx < 0 || mapW <= 0) return nullptr;
+    Map_TouchCell(cellIdx % mapW, cellIdx / mapW);
+    return Map_GetCell(cellIdx % mapW, cellIdx / mapW);
+}
+
+static void SyncCellUnitId(MapCell* cell) {
+    cell->unitId = (cell->occupantStored > 0) ?
+        (int16_t)OCCUPANT_ID(cell->occupants[0]) : -1;
+}
+
+// Refill an overflowed cell's inline list from the unit table
+static void RebuildCellOccupants(MapCell* cell, int cellIdx) {
+    cell->occupantStored = 0;
+    for (int i = 0; i < MAX_UNITS; i++) {
+        if (g_unitOccCell[i] != cellIdx) continue;
+        if (cell->occupantStored >= MAP_CELL_OCCUPANTS) break;
+        cell->occupants[cell->occupantStored++] = PackOccupant(i);
+    }
+    SyncCellUnitId(cell);
+}
+
+static void Occupancy_Remove(int unitId) {
+    int cellIdx = g_unitOccCell[unitId];
+    if (cellIdx < 0) return;
+    g_unitOccCell[unitId] = -1;
+
+    MapCell* cell = OccupancyCell(cellIdx);
+    if (!cell || cell->occupantCount == 0) return;
+
+    bool overflowed = cell->occupantCount > cell->occupantStored;
+    for (int i = 0; i < cell->occupantStored; i++) {
+        if (OCCUPANT_ID(cell->occupants[i]) == unitId) {
+            cell->occupants[i] = cell->occupants[--cell->occupantStored];
+            break;
+        }
+    }
+    cell->occupantCount--;
+
+    if (overflowed) {
+        RebuildCellOccupants(cell, cellIdx);
+    } else {
+        SyncCellUnitId(cell);
+    }
+}
+
+static void Occupancy_Insert(int unitId, int cellX, int cellY) {
+    MapCell* cell = Map_GetCell(cellX, cellY);
+    if (!cell) return;
+
+    Map_TouchCell(cellX, cellY);
+    g_unitOccCell[unitId] = (int16_t)(cellY * Map_GetWidth() + cellX);
+    if (cell->occupantStored < MAP_CELL_OCCUPANTS &&
+        cell->occupantStored == cell->occupantCount) {
+        cell->occupants[cell->occupantStored++] = PackOccupant(unitId);
+    }
+    if (cell->occupantCount < 255) cell->occupantCount++;
+    SyncCellUnitId(cell);
+}
+
+// Update cell occupancy for a unit that moved to a new cell
+static void UpdateCellOccupancy(int unitId, int newCellX, int newCellY) {
+    if (g_units[unitId].transportId >= 0) return;  // Riding in a transport
+    Occupancy_Remove(unitId);
+    Occupancy_Insert(unitId, newCellX, newCellY);
+}
+
+static void Occupancy_Clear(void) {
+    for (int i = 0; i < MAX_UNITS; i++) {
+        g_unitOccCell[i] = -1;
+    }
+    int mapW = Map_GetWidth();
+    int mapH = Map_GetHeight();
+    for (int y = 0; y < mapH; y++) {
+        for (int x = 0; x < mapW; x++) {
+            MapCell* cell = Map_GetCell(x, y);
+            cell->occupantCount = 0;
+            cell->occupantStored = 0;
+            cell->unitId = -1;
+            Map_TouchCell(x, y);
+        }
+    }
+}
+
+//===========================================================================
+// Fog of War Viewers
+//
+// Player units and buildings keep their sight circle registered with the
+// map's visibility reference counts. A unit only updates it when it
+// crosses into another cell.
+//===========================================================================
+
+struct SightViewer {
+    int16_t cellX;
+    int16_t cellY;
+    int16_t range;
+    uint8_t active;
+};
+
+static SightViewer g_unitSight[MAX_UNITS];
+static SightViewer g_buildingSight[MAX_BUILDINGS];
+
+static void Sight_Remove(SightViewer* viewer) {
+    if (!viewer->active) return;
+    Map_RemoveViewer(viewer->cellX, viewer->cellY, viewer->range);
+    viewer->active = 0;
+}
+
+static void Sight_Add(SightViewer* viewer, int cellX, int cellY, int range) {
+    Sight_Remove(viewer);
+    viewer->cellX = (int16_t)cellX;
+    viewer->cellY = (int16_t)cellY;
+    viewer->range = (int16_t)range;
+    viewer->active = 1;
+    Map_AddViewer(cellX, cellY, range);
+}
+
+static void Sight_Move(SightViewer* viewer, int cellX, int cellY) {
+    if (!viewer->active) return;
+    if (viewer->cellX == cellX && viewer->cellY == cellY) return;
+    Map_MoveViewer(viewer->cellX, viewer->cellY, cellX, cellY, viewer->range);
+    viewer->cellX = (int16_t)cellX;
+    viewer->cellY = (int16_t)cellY;
+}
+
+static void Sight_Clear(void) {
+    for (int i = 0; i < MAX_UNITS; i++) {
+        Sight_Remove(&g_unitSight[i]);
+    }
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        Sight_Remove(&g_buildingSight[i]);
+    }
+}
+
+//===========================================================================
+// Threat Sources
+//
+// Armed units on the map and armed buildings add their attack damage to
+// their team's threat grid. Like sight, a unit only updates it when it
+// crosses into another cell.
+//===========================================================================
+
+struct ThreatSource {
+    int16_t cellX;
+    int16_t cellY;
+    int16_t strength;
+    uint8_t team;
+    uint8_t active;
+};
+
+static ThreatSource g_unitThreat[MAX_UNITS];
+static ThreatSource g_buildingThreat[MAX_BUILDINGS];
+
+static void ThreatSource_Remove(ThreatSource* source) {
+    if (!source->active) return;
+    Threat_Add(source->team, source->cellX, source->cellY, -source->strength);
+    source->active = 0;
+}
+
+static void ThreatSource_Add(ThreatSource* source, int team, int cellX, int cellY,
+                             int strength) {
+    ThreatSource_Remove(source);
+    if (strength <= 0) return;
+    source->cellX = (int16_t)cellX;
+    source->cellY = (int16_t)cellY;
+    source->strength = (int16_t)strength;
+    source->team = (uint8_t)team;
+    source->active = 1;
+    Threat_Add(team, cellX, cellY, strength);
+}
+
+static void ThreatSource_Move(ThreatSource* source, int cellX, int cellY) {
+    if (!source->active) return;
+    Threat_Move(source->team, source->cellX, source->cellY, cellX, cellY, source->strength);
+    source->cellX = (int16_t)cellX;
+    source->cellY = (int16_t)cellY;
+}
+
+static void ThreatSource_Clear(void) {
+    memset(g_unitThreat, 0, sizeof(g_unitThreat));
+    memset(g_buildingThreat, 0, sizeof(g_buildingThreat));
+    Threat_Clear();
+}
+
+// Put a unit standing on the map into the occupancy index, spatial hash
+// and threat grid
+static void RegisterUnit(int unitId, int cellX, int cellY) {
+    const Unit* unit = &g_units[unitId];
+    Occupancy_Insert(unitId, cellX, cellY);
+    g_unitHash.Insert(unitId, unit->team, unit->worldX, unit->worldY);
+    ThreatSource_Add(&g_unitThreat[unitId], unit->team, cellX, cellY, unit->attackDamage);
+}
+
+// Take a unit out of the occupancy index, spatial hash and threat grid
+static void UnregisterUnit(int unitId) {
+    Occupancy_Remove(unitId);
+    g_unitHash.Remove(unitId);
+    ThreatSource_Remove(&g_unitThreat[unitId]);
+}
+
+// Mark a unit as dying and stop it from being found by lookups
+static void MarkUnitDying(Unit* unit, int unitId) {
+    unit->state = STATE_DYING;
+    UnregisterUnit(unitId);
+    Mission_PostEvent(MISSION_EVENT_UNIT_DIED, unitId);
+}
+
+// Team mask of valid targets for a team (everyone else except neutral)
+static uint32_t EnemyTeamMask(int team) {
+    uint32_t mask = 0;
+    for (int t = TEAM_PLAYER; t < TEAM_COUNT; t++) {
+        if (t != team) mask |= SPATIAL_TEAM_BIT(t);
+    }
+    return mask;
 }
 
 // Check if a cell is occupied by another unit
@@ -216,25 +489,32 @@ void Units_Clear(void) {
 // canCrush: if true, don't block on enemy infantry (vehicle can crush them)
 static BOOL IsCellOccupiedForTeam(int cellX, int cellY, int excludeId,
                                   int moverTeam, BOOL canCrush) {
-    for (int i = 0; i < MAX_UNITS; i++) {
-        if (i == excludeId) continue;
-        if (!g_units[i].active) continue;
-        if (g_units[i].state == STATE_DYING) continue;
-
-        int unitCellX = g_units[i].worldX / CELL_SIZE;
-        int unitCellY = g_units[i].worldY / CELL_SIZE;
-
-        if (unitCellX == cellX && unitCellY == cellY) {
-            // Check if we can ignore this unit
-            if (canCrush && g_units[i].team != moverTeam) {
-                // Can crush enemy infantry - check if it's infantry
-                const UnitTypeDef* def = &g_unitTypes[g_units[i].type];
-                if (def->isInfantry) {
-                    continue;  // Don't block, we can crush them
-                }
+    MapCell* cell = Map_GetCell(cellX, cellY);
+    if (!cell || cell->occupantCount == 0) return FALSE;
+
+    if (cell->occupantCount > cell->occupantStored) {
+        // Overflowed cell - check the registered units directly
+        int cellIdx = cellY * Map_GetWidth() + cellX;
+        for (int i = 0; i < MAX_UNITS; i++) {
+            if (i == excludeId || g_unitOccCell[i] != cellIdx) continue;
+            if (canCrush && g_units[i].team != moverTeam &&
+                g_unitTypes[g_units[i].type].isInfantry) {
+                continue;  // Don't block, we can crush them
             }
             return TRUE;
         }
+        return FALSE;
+    }
+
+    for (int i = 0; i < cell->occupantStored; i++) {
+        uint16_t occ = cell->occupants[i];
+        if (OCCUPANT_ID(occ) == excludeId) continue;
+        // Can crush enemy infantry - don't block
+        if (canCrush && OCCUPANT_TEAM(occ) != moverTeam &&
+            (occ & OCCUPANT_INFANTRY)) {
+            continue;
+        }
+        return TRUE;
     }
     return FALSE;
 }
@@ -244,23 +524,33 @@ static BOOL IsCellOccupied(int cellX, int cellY, int excludeUnitId = -1) {
     return IsCellOccupiedForTeam(cellX, cellY, excludeUnitId, -1, FALSE);
 }
 
-// Update cell occupancy for a unit
-static void UpdateCellOccupancy(int unitId, int oldCellX, int oldCellY,
-                                int newCellX, int newCellY) {
-    // Clear old cell
-    if (oldCellX >= 0 && oldCellY >= 0) {
-        MapCell* oldCell = Map_GetCell(oldCellX, oldCellY);
-        if (oldCell && oldCell->unitId == unitId) {
-            oldCell->unitId = -1;
-        }
-    }
-    // Mark new cell
-    if (newCellX >= 0 && newCellY >= 0) {
-        MapCell* newCell = Map_GetCell(newCellX, newCellY);
-        if (newCell) {
-            newCell->unitId = unitId;
+// Collect registered units in the 3x3 cells around a world position.
+// Hit boxes and crush radii are all under one cell, so anything that can
+// touch the position is in this neighborhood.
+static int GatherUnitsNear(int worldX, int worldY, int* outIds, int maxIds) {
+    int centerX, centerY;
+    Map_WorldToCell(worldX, worldY, &centerX, &centerY);
+    int mapW = Map_GetWidth();
+
+    int count = 0;
+    for (int cy = centerY - 1; cy <= centerY + 1; cy++) {
+        for (int cx = centerX - 1; cx <= centerX + 1; cx++) {
+            MapCell* cell = Map_GetCell(cx, cy);
+            if (!cell || cell->occupantCount == 0) continue;
+
+            if (cell->occupantCount > cell->occupantStored) {
+                int cellIdx = cy * mapW + cx;
+                for (int i = 0; i < MAX_UNITS && count < maxIds; i++) {
+                    if (g_unitOccCell[i] == cellIdx) outIds[count++] = i;
+                }
+            } else {
+                for (int i = 0; i < cell->occupantStored && count < maxIds; i++) {
+                    outIds[count++] = OCCUPANT_ID(cell->occupants[i]);
+                }
+            }
         }
     }
+    return count;
 }
 
 // Find a valid spawn position near the requested location
@@ -298,6 +588,7 @@ static BOOL FindValidSpawnPosition(int* worldX, int* worldY,
 
 int Units_Spawn(UnitType type, Team team, int worldX, int worldY) {
     if (type <= UNIT_NONE || type >= UNIT_TYPE_COUNT) return -1;
+    if (team < 0 || team >= TEAM_COUNT) return -1;
 
     // Find free slot
     int id = -1;
@@ -357,19 +648,27 @@ int Units_Spawn(UnitType type, Team team, int worldX, int worldY) {
     // Mark the spawn cell as occupied
     int cellX, cellY;
     Map_WorldToCell(spawnX, spawnY, &cellX, &cellY);
-    UpdateCellOccupancy(id, -1, -1, cellX, cellY);
+    RegisterUnit(id, cellX, cellY);
 
+    // Player units see through the fog from their cell
+    if (team == TEAM_PLAYER) {
+        Sight_Add(&g_unitSight[id], cellX, cellY, unit->sightRange);
+    }
+
+    g_teamUnitCount[team]++;
+    Mission_PostEvent(MISSION_EVENT_UNIT_SPAWNED, id);
     return id;
 }
 
 void Units_Remove(int unitId) {
     if (unitId >= 0 && unitId < MAX_UNITS) {
         Unit* unit = &g_units[unitId];
+        // Clear cell occupancy and sight
+        UnregisterUnit(unitId);
+        Sight_Remove(&g_unitSight[unitId]);
         if (unit->active) {
-            // Clear cell occupancy
-            int cellX, cellY;
-            Map_WorldToCell(unit->worldX, unit->worldY, &cellX, &cellY);
-            UpdateCellOccupancy(unitId, cellX, cellY, -1, -1);
+            g_teamUnitCount[unit->team]--;
+            Mission_PostEvent(MISSION_EVENT_UNIT_DIED, unitId);
         }
         unit->active = 0;
     }
@@ -383,17 +682,30 @@ Unit* Units_Get(int unitId) {
 }
 
 int Units_CountByTeam(Team team) {
-    int count = 0;
-    for (int i = 0; i < MAX_UNITS; i++) {
-        if (g_units[i].active && g_units[i].team == team) {
-            count++;
-        }
-    }
-    return count;
+    if (team < 0 || team >= TEAM_COUNT) return 0;
+    return g_teamUnitCount[team];
+}
+
+int Buildings_CountByTeam(Team team) {
+    if (team < 0 || team >= TEAM_COUNT) return 0;
+    return g_teamBuildingCount[team];
+}
+
+int Buildings_CountByTeamType(Team team, BuildingType type) {
+    if (team < 0 || team >= TEAM_COUNT) return 0;
+    if (type < 0 || type >= BUILDING_TYPE_COUNT) return 0;
+    return g_teamBuildingTypeCount[team][type];
+}
+
+// Keep the live building counts in step (delta = +1 built, -1 destroyed)
+static void CountBuilding(const Building* bld, int delta) {
+    g_teamBuildingCount[bld->team] += delta;
+    g_teamBuildingTypeCount[bld->team][bld->type] += delta;
 }
 
 int Buildings_Spawn(BuildingType type, Team team, int cellX, int cellY) {
     if (type <= BUILDING_NONE || type >= BUILDING_TYPE_COUNT) return -1;
+    if (team < 0 || team >= TEAM_COUNT) return -1;
 
     const BuildingTypeDef* def = &g_buildingTypes[type];
 
@@ -425,12 +737,28 @@ int Buildings_Spawn(BuildingType type, Team team, int cellX, int cellY) {
         for (int dx = 0; dx < def->width; dx++) {
             MapCell* cell = Map_GetCell(cellX + dx, cellY + dy);
             if (cell) {
-                cell->terrain = TERRAIN_BUILDING;
+                Map_SetTerrain(cellX + dx, cellY + dy, TERRAIN_BUILDING);
                 cell->buildingId = (int16_t)id;
             }
         }
     }
 
+    int centerX = cellX * CELL_SIZE + (def->width * CELL_SIZE / 2);
+    int centerY = cellY * CELL_SIZE + (def->height * CELL_SIZE / 2);
+    g_buildingHash.Insert(id, team, centerX, centerY);
+
+    // Player buildings see from their center cell
+    if (team == TEAM_PLAYER) {
+        Sight_Add(&g_buildingSight[id], cellX + def->width / 2,
+                  cellY + def->height / 2, bld->sightRange);
+    }
+    if (def->canAttack) {
+        ThreatSource_Add(&g_buildingThreat[id], team, cellX + def->width / 2,
+                         cellY + def->height / 2, def->attackDamage);
+    }
+
+    CountBuilding(bld, +1);
+    Mission_PostEvent(MISSION_EVENT_BUILDING_BUILT, id);
     return id;
 }
 
@@ -444,12 +772,17 @@ void Buildings_Remove(int buildingId) {
                     int cx = bld->cellX + dx, cy = bld->cellY + dy;
                     MapCell* cell = Map_GetCell(cx, cy);
                     if (cell) {
-                        cell->terrain = TERRAIN_CLEAR;
+                        Map_SetTerrain(cx, cy, TERRAIN_CLEAR);
                         cell->buildingId = -1;
                     }
                 }
             }
             bld->active = 0;
+            g_buildingHash.Remove(buildingId);
+            Sight_Remove(&g_buildingSight[buildingId]);
+            ThreatSource_Remove(&g_buildingThreat[buildingId]);
+            CountBuilding(bld, -1);
+            Mission_PostEvent(MISSION_EVENT_BUILDING_DESTROYED, buildingId);
         }
     }
 }
@@ -460,6 +793,143 @@ Building* Buildings_Get(int buildingId) {
     return &g_buildings[buildingId];
 }
 
+Unit* Units_GetSlot(int unitId) {
+    if (unitId < 0 || unitId >= MAX_UNITS) return nullptr;
+    return &g_units[unitId];
+}
+
+Building* Buildings_GetSlot(int buildingId) {
+    if (buildingId < 0 || buildingId >= MAX_BUILDINGS) return nullptr;
+    return &g_buildings[buildingId];
+}
+
+void Units_RestoreIndexes(void) {
+    // Viewers were stamped on whatever map was loaded before
+    for (int i = 0; i < MAX_UNITS; i++) {
+        g_unitSight[i].active = 0;
+        g_unitOccCell[i] = -1;
+    }
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        g_buildingSight[i].active = 0;
+    }
+    ThreatSource_Clear();
+    memset(g_teamUnitCount, 0, sizeof(g_teamUnitCount));
+    memset(g_teamBuildingCount, 0, sizeof(g_teamBuildingCount));
+    memset(g_teamBuildingTypeCount, 0, sizeof(g_teamBuildingTypeCount));
+    g_unitHash.Clear();
+    g_buildingHash.Clear();
+
+    int mapW = Map_GetWidth();
+    for (int i = 0; i < MAX_UNITS; i++) {
+        Unit* unit = &g_units[i];
+        if (!unit->active) continue;
+        g_teamUnitCount[unit->team]++;
+
+        int cellX, cellY;
+        Map_WorldToCell(unit->worldX, unit->worldY, &cellX, &cellY);
+
+        // Same rule as RegisterUnit/UnregisterUnit: dying units and loaded
+        // passengers are off the map. Cell lists come from the save.
+        if (unit->state != STATE_DYING && unit->transportId < 0) {
+            if (Map_GetCell(cellX, cellY)) {
+                g_unitOccCell[i] = (int16_t)(cellY * mapW + cellX);
+            }
+            g_unitHash.Insert(i, unit->team, unit->worldX, unit->worldY);
+            ThreatSource_Add(&g_unitThreat[i], unit->team, cellX, cellY, unit->attackDamage);
+        }
+
+        // Sight stays with a unit until it is removed
+        if (unit->team == TEAM_PLAYER) {
+            Sight_Add(&g_unitSight[i], cellX, cellY, unit->sightRange);
+        }
+    }
+
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        Building* bld = &g_buildings[i];
+        if (!bld->active) continue;
+        CountBuilding(bld, +1);
+
+        int centerX = bld->cellX * CELL_SIZE + (bld->width * CELL_SIZE / 2);
+        int centerY = bld->cellY * CELL_SIZE + (bld->height * CELL_SIZE / 2);
+        g_buildingHash.Insert(i, bld->team, centerX, centerY);
+
+        if (bld->team == TEAM_PLAYER) {
+            Sight_Add(&g_buildingSight[i], bld->cellX + bld->width / 2,
+                      bld->cellY + bld->height / 2, bld->sightRange);
+        }
+        const BuildingTypeDef* def = &g_buildingTypes[bld->type];
+        if (def->canAttack) {
+            ThreatSource_Add(&g_buildingThreat[i], bld->team, bld->cellX + bld->width / 2,
+                             bld->cellY + bld->height / 2, def->attackDamage);
+        }
+    }
+}
+
+//===========================================================================
+// Group Orders
+//
+// Move and attack-move orders are tallied per goal cell as they are
+// issued; orders to one goal in the same tick form a group. FindPath
+// reads the tally to decide whether a shared flow field is worth
+// building, rather than counting the units bound there on every request.
+//===========================================================================
+
+void Units_GetGroupOrders(GroupOrderState* state) {
+    memcpy(state->orders, g_groupOrders, sizeof(g_groupOrders));
+    state->tick = g_unitTick;
+}
+
+void Units_SetGroupOrders(const GroupOrderState* state) {
+    memcpy(g_groupOrders, state->orders, sizeof(g_groupOrders));
+    g_unitTick = state->tick;
+}
+
+static GroupOrder* FindGroupOrder(int goal, int isNaval) {
+    for (int i = 0; i < GROUP_ORDER_SLOTS; i++) {
+        GroupOrder* order = &g_groupOrders[i];
+        if (order->count > 0 && order->goal == goal && order->isNaval == isNaval) {
+            return order;
+        }
+    }
+    return NULL;
+}
+
+// Count a ground or naval unit ordered toward a world position
+static void NoteGroupOrder(const Unit* unit, int worldX, int worldY) {
+    const UnitTypeDef* def = &g_unitTypes[unit->type];
+    if (def->isAircraft) return;
+
+    int cellX, cellY;
+    Map_WorldToCell(worldX, worldY, &cellX, &cellY);
+    int goal = cellY * Map_GetWidth() + cellX;
+    int isNaval = def->isNaval ? 1 : 0;
+
+    GroupOrder* order = FindGroupOrder(goal, isNaval);
+    if (!order) {
+        // Reuse the slot of the oldest group
+        order = &g_groupOrders[0];
+        for (int i = 1; i < GROUP_ORDER_SLOTS && order->count > 0; i++) {
+            if (g_groupOrders[i].count == 0 || g_groupOrders[i].tick < order->tick) {
+                order = &g_groupOrders[i];
+            }
+        }
+        order->goal = goal;
+        order->isNaval = isNaval;
+        order->count = 0;
+    } else if (order->tick != g_unitTick) {
+        order->count = 0;       // A new order to the goal starts a new group
+    }
+    order->tick = g_unitTick;
+    order->count++;
+}
+
+// Units in the latest group ordered to a cell
+static int GroupOrderSize(int cellX, int cellY, BOOL isNaval) {
+    const GroupOrder* order = FindGroupOrder(cellY * Map_GetWidth() + cellX,
+                                             isNaval ? 1 : 0);
+    return order ? order->count : 0;
+}
+
 void Units_CommandMove(int unitId, int worldX, int worldY) {
     Unit* unit = Units_Get(unitId);
     if (!unit) return;
@@ -468,9 +938,11 @@ void Units_CommandMove(int unitId, int worldX, int worldY) {
     unit->targetY = worldY;
     unit->targetUnit = -1;
     unit->state = STATE_MOVING;
+    NoteGroupOrder(unit, worldX, worldY);
 
     // Clear existing path - will be calculated on next update
     unit->pathLength = 0;
+    unit->repathDelay = 0;
     unit->pathIndex = 0;
 
     // Calculate facing direction (initial)
@@ -518,6 +990,7 @@ void Units_CommandStop(int unitId) {
     unit->loadTarget = -1;
     unit->state = STATE_IDLE;
     unit->pathLength = 0;
+    unit->repathDelay = 0;
 }
 
 void Units_CommandAttackMove(int unitId, int worldX, int worldY) {
@@ -528,9 +1001,11 @@ void Units_CommandAttackMove(int unitId, int worldX, int worldY) {
     unit->targetY = worldY;
     unit->targetUnit = -1;
     unit->state = STATE_ATTACK_MOVE;
+    NoteGroupOrder(unit, worldX, worldY);
 
     // Clear existing path - will be calculated on next update
     unit->pathLength = 0;
+    unit->repathDelay = 0;
     unit->pathIndex = 0;
 
     // Calculate facing direction
@@ -561,6 +1036,7 @@ void Units_CommandGuard(int unitId) {
     unit->targetUnit = -1;
     unit->state = STATE_GUARDING;
     unit->pathLength = 0;
+    unit->repathDelay = 0;
 }
 
 void Units_CommandForceAttack(int unitId, int worldX, int worldY) {
@@ -568,10 +1044,15 @@ void Units_CommandForceAttack(int unitId, int worldX, int worldY) {
     if (!unit) return;
 
     // Check if there's a unit at the target position (any team)
+    int nearIds[MAX_UNITS];
+    int nearCount = GatherUnitsNear(worldX, worldY, nearIds, MAX_UNITS);
+
     int targetId = -1;
-    for (int i = 0; i < MAX_UNITS; i++) {
+    for (int n = 0; n < nearCount; n++) {
+        int i = nearIds[n];
+        if (i == unitId) continue;
+        if (targetId >= 0 && i > targetId) continue;  // Lowest id wins
         Unit* target = &g_units[i];
-        if (!target->active || i == unitId) continue;
 
         const UnitTypeDef* tdef = &g_unitTypes[target->type];
         int halfSize = tdef->size / 2;
@@ -580,7 +1061,6 @@ void Units_CommandForceAttack(int unitId, int worldX, int worldY) {
         if (worldX >= tx - halfSize && worldX <= tx + halfSize &&
             worldY >= ty - halfSize && worldY <= ty + halfSize) {
             targetId = i;
-            break;
         }
     }
 
@@ -595,6 +1075,7 @@ void Units_CommandForceAttack(int unitId, int worldX, int worldY) {
         unit->targetUnit = -1;
         unit->state = STATE_MOVING;
         unit->pathLength = 0;
+        unit->repathDelay = 0;
     }
 
     // Play attack response voice for force attack
@@ -620,6 +1101,7 @@ void Units_ScatterInfantryNear(int worldX, int worldY, int radius) {
     for (int i = 0; i < MAX_UNITS; i++) {
         Unit* unit = &g_units[i];
         if (!unit->active) continue;
+        if (unit->state == STATE_DYING) continue;  // Already killed
 
         const UnitTypeDef* def = &g_unitTypes[unit->type];
         if (!def->isInfantry) continue;  // Only infantry scatter
@@ -637,7 +1119,7 @@ void Units_ScatterInfantryNear(int worldX, int worldY, int radius) {
 
         // Calculate scatter direction (away from explosion)
         int dist = (int)sqrt((double)distSq);
-        int scatterDist = CELL_SIZE + (rand() % CELL_SIZE);  // 1-2 cells away
+        int scatterDist = CELL_SIZE + Random_Sim(CELL_SIZE);  // 1-2 cells away
 
         int newX = unit->worldX + (dx * scatterDist) / dist;
         int newY = unit->worldY + (dy * scatterDist) / dist;
@@ -664,10 +1146,10 @@ int Units_CommandAllHunt(Team team) {
     int teamUnitCount = 0;
 
     // Calculate center of our units
-    for (int i = 0; i < MAX_UNITS; i++) {
-        Unit* unit = &g_units[i];
-        if (!unit->active || unit->team != team) continue;
-        if (unit->state == STATE_DYING) continue;
+    int memberCount = 0;
+    const int16_t* members = g_unitHash.TeamMembers(team, &memberCount);
+    for (int m = 0; m < memberCount; m++) {
+        const Unit* unit = &g_units[members[m]];
         centerX += unit->worldX;
         centerY += unit->worldY;
         teamUnitCount++;
@@ -679,26 +1161,19 @@ int Units_CommandAllHunt(Team team) {
     }
 
     // Find nearest enemy to our center
-    for (int i = 0; i < MAX_UNITS; i++) {
-        Unit* unit = &g_units[i];
-        if (!unit->active || unit->team != enemyTeam) continue;
-        if (unit->state == STATE_DYING) continue;
-
-        int dx = unit->worldX - centerX;
-        int dy = unit->worldY - centerY;
-        int dist = dx * dx + dy * dy;
-
-        if (dist < nearestDist) {
-            nearestDist = dist;
-            nearestEnemy = i;
-        }
+    nearestEnemy = g_unitHash.FindNearest(centerX, centerY, 0,
+                                          SPATIAL_TEAM_BIT(enemyTeam));
+    if (nearestEnemy >= 0) {
+        int dx = g_units[nearestEnemy].worldX - centerX;
+        int dy = g_units[nearestEnemy].worldY - centerY;
+        nearestDist = dx * dx + dy * dy;
     }
 
     // Also check buildings for nearest enemy
-    for (int i = 0; i < MAX_BUILDINGS; i++) {
-        Building* bld = &g_buildings[i];
-        if (!bld->active || bld->team != enemyTeam) continue;
-
+    int nearestBld = g_buildingHash.FindNearest(centerX, centerY, 0,
+                                                SPATIAL_TEAM_BIT(enemyTeam));
+    if (nearestBld >= 0) {
+        Building* bld = &g_buildings[nearestBld];
         int bx = bld->cellX * CELL_SIZE + (bld->width * CELL_SIZE / 2);
         int by = bld->cellY * CELL_SIZE + (bld->height * CELL_SIZE / 2);
         int dx = bx - centerX;
@@ -818,9 +1293,14 @@ int Units_GetAtScreen(int screenX, int screenY) {
 
     // Check units - use reasonable hit box sizes
     // Infantry sprites are ~24 pixels, vehicles ~32-48 pixels
-    for (int i = 0; i < MAX_UNITS; i++) {
+    int nearIds[MAX_UNITS];
+    int nearCount = GatherUnitsNear(worldX, worldY, nearIds, MAX_UNITS);
+
+    int hitId = -1;
+    for (int n = 0; n < nearCount; n++) {
+        int i = nearIds[n];
+        if (hitId >= 0 && i > hitId) continue;  // Lowest id wins
         Unit* unit = &g_units[i];
-        if (!unit->active) continue;
 
         const UnitTypeDef* def = &g_unitTypes[unit->type];
         // Use minimum hit box of 12 for infantry, 16 for vehicles
@@ -831,11 +1311,33 @@ int Units_GetAtScreen(int screenX, int screenY) {
         int ux = unit->worldX, uy = unit->worldY;
         if (worldX >= ux - halfSize && worldX <= ux + halfSize &&
             worldY >= uy - halfSize && worldY <= uy + halfSize) {
-            return i;
+            hitId = i;
         }
     }
 
-    return -1;
+    return hitId;
+}
+
+int Units_QueryRadius(int worldX, int worldY, int radius, uint32_t teamMask,
+                      int* outIds, int maxIds) {
+    return g_unitHash.QueryRadius(worldX, worldY, radius, teamMask,
+                                  outIds, maxIds);
+}
+
+int Units_QueryNearest(int worldX, int worldY, int radius, uint32_t teamMask,
+                       int k, int* outIds) {
+    return g_unitHash.QueryNearest(worldX, worldY, radius, teamMask,
+                                   k, outIds);
+}
+
+int Units_GetTeamUnits(Team team, int* outIds, int maxIds) {
+    int memberCount = 0;
+    const int16_t* members = g_unitHash.TeamMembers(team, &memberCount);
+    int count = 0;
+    for (int m = 0; m < memberCount && count < maxIds; m++) {
+        outIds[count++] = members[m];
+    }
+    return count;
 }
 
 //===========================================================================
@@ -873,24 +1375,221 @@ static const int DIR_DX[8] = { 0,  1, 1, 1, 0, -1, -1, -1 };
 static const int DIR_DY[8] = { -1, -1, 0, 1, 1,  1,  0, -1 };
 static const int DIR_COST[8] = { 10, 14, 10, 14, 10, 14, 10, 14 };
 
-// A* node for pathfinding
+// Result of a unit path search
+enum PathResult {
+    PATH_FAILED = 0,        // No progress possible toward the target
+    PATH_FOUND,             // pathCells reaches the target
+    PATH_PARTIAL            // pathCells gets closer; re-plan at its end
+};
+
+// Ticks a unit waits before re-planning around an occupied waypoint
+static const int REPATH_BLOCKED_TICKS = 4;
+
+// Units ordered to the same cell in one tick before they share a flow
+// field toward it rather than each running its own search
+static const int FLOW_GROUP_MIN = 4;
+
+// Hostile threat reading (see threat.h) worth one extra step cost unit
+// for units that avoid threat
+static const int THREAT_COST_DIVISOR = 64;
+
+// Node expansions allowed per search. Searches that run out return the
+// best partial path instead of failing outright.
+static const int MAX_ITERATIONS = 2000;
+
+// Whole routes as planned, before trimming to the unit's waypoint buffer
+static int16_t g_routeCells[PATHCACHE_MAX_CELLS];
+
+// Each expansion pushes at most 8 neighbors
+static const int PATH_HEAP_CAPACITY = MAX_ITERATIONS * 8 + 1;
+static const int PATH_CELL_COUNT = MAP_MAX_WIDTH * MAP_MAX_HEIGHT;
+
+// A* open-list entry. The key packs (f, h, cell) so ties on f prefer the
+// node nearer the goal, then the lower cell index - identical inputs
+// always expand in the same order on every platform.
 struct PathNode {
-    int16_t cellX, cellY;
-    int g, h, f;
-    int16_t parentX, parentY;
+    uint64_t key;
+    int32_t g;
+    uint16_t cell;
+};
 
-    bool operator>(const PathNode& other) const { return f > other.f; }
+// Persistent A* workspace. Per-cell entries are only valid when their
+// stamp matches the current generation, so nothing is cleared or
+// allocated between searches.
+struct PathWorkspace {
+    uint32_t generation;
+    uint32_t visitGen[PATH_CELL_COUNT];     // gScore/parent valid
+    uint32_t closedGen[PATH_CELL_COUNT];    // Cell expanded
+    int32_t gScore[PATH_CELL_COUNT];
+    uint16_t parent[PATH_CELL_COUNT];
+    PathNode heap[PATH_HEAP_CAPACITY];
+    int heapSize;
 };
 
-// Calculate heuristic (Manhattan distance * 10)
+static PathWorkspace g_pathWork;
+
+// Octile distance * 10 (straight 10, diagonal 14)
 static int Heuristic(int x1, int y1, int x2, int y2) {
-    return (abs(x2 - x1) + abs(y2 - y1)) * 10;
+    int dx = abs(x2 - x1);
+    int dy = abs(y2 - y1);
+    return (dx > dy) ? dx * 10 + dy * 4 : dy * 10 + dx * 4;
+}
+
+static inline uint64_t PathKey(int f, int h, int cell) {
+    return ((uint64_t)f << 40) | ((uint64_t)h << 20) | (uint64_t)cell;
+}
+
+static void PathWork_Begin(void) {
+    PathWorkspace* ws = &g_pathWork;
+    ws->generation++;
+    if (ws->generation == 0) {
+        // Stamp wrapped - clear once so stale stamps can't alias
+        memset(ws->visitGen, 0, sizeof(ws->visitGen));
+        memset(ws->closedGen, 0, sizeof(ws->closedGen));
+        ws->generation = 1;
+    }
+    ws->heapSize = 0;
+}
+
+static void PathHeap_Push(uint64_t key, int g, int cell) {
+    PathWorkspace* ws = &g_pathWork;
+    if (ws->heapSize >= PATH_HEAP_CAPACITY) return;
+
+    PathNode* heap = ws->heap;
+    int i = ws->heapSize++;
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (heap[p].key <= key) break;
+        heap[i] = heap[p];
+        i = p;
+    }
+    heap[i].key = key;
+    heap[i].g = g;
+    heap[i].cell = (uint16_t)cell;
+}
+
+static PathNode PathHeap_Pop(void) {
+    PathWorkspace* ws = &g_pathWork;
+    PathNode* heap = ws->heap;
+    PathNode top = heap[0];
+    PathNode last = heap[--ws->heapSize];
+
+    int n = ws->heapSize;
+    if (n > 0) {
+        int i = 0;
+        for (;;) {
+            int c = 2 * i + 1;
+            if (c >= n) break;
+            if (c + 1 < n && heap[c + 1].key < heap[c].key) c++;
+            if (last.key <= heap[c].key) break;
+            heap[i] = heap[c];
+            i = c;
+        }
+        heap[i] = last;
+    }
+    return top;
+}
+
+// Copy the parent chain ending at endIdx into a cell buffer. Long chains
+// keep only the first maxCells steps from the start. Returns the full
+// chain length.
+static int CopyPathCells(int startIdx, int endIdx, int16_t* out, int maxCells) {
+    PathWorkspace* ws = &g_pathWork;
+
+    int steps = 0;
+    for (int c = endIdx; c != startIdx; c = ws->parent[c]) steps++;
+
+    int skip = steps - maxCells;
+    int c = endIdx;
+    for (; skip > 0; skip--) c = ws->parent[c];
+
+    int len = (steps > maxCells) ? maxCells : steps;
+    for (int i = len - 1; i >= 0; i--) {
+        out[i] = (int16_t)c;
+        c = ws->parent[c];
+    }
+    return steps;
+}
+
+// Copy the parent chain ending at endIdx into the unit's waypoint buffer.
+// Returns TRUE if the chain had to be truncated.
+static BOOL CopyPathToUnit(Unit* unit, int startIdx, int endIdx) {
+    int steps = CopyPathCells(startIdx, endIdx, unit->pathCells, MAX_PATH_WAYPOINTS);
+    unit->pathLength = (int8_t)((steps > MAX_PATH_WAYPOINTS) ? MAX_PATH_WAYPOINTS : steps);
+    return steps > MAX_PATH_WAYPOINTS;
+}
+
+// Give the unit the first MAX_PATH_WAYPOINTS cells of a planned route
+static PathResult UseRoute(Unit* unit, const int16_t* cells, int count, BOOL partial) {
+    if (count > MAX_PATH_WAYPOINTS) {
+        count = MAX_PATH_WAYPOINTS;
+        partial = TRUE;
+    }
+    memcpy(unit->pathCells, cells, (size_t)count * sizeof(int16_t));
+    unit->pathLength = (int8_t)count;
+    unit->pathPartial = partial ? 1 : 0;
+    return partial ? PATH_PARTIAL : PATH_FOUND;
+}
+
+// Closest cell to the target (by ring) inside the given zone
+static BOOL FindNearestInZone(int zone, BOOL isNaval, int* cellX, int* cellY) {
+    int mapW = Map_GetWidth();
+    int mapH = Map_GetHeight();
+    int maxRadius = (mapW > mapH) ? mapW : mapH;
+    int cx = *cellX;
+    int cy = *cellY;
+
+    for (int r = 1; r < maxRadius; r++) {
+        int bestDist = INT_MAX;
+        for (int dy = -r; dy <= r; dy++) {
+            for (int dx = -r; dx <= r; dx++) {
+                if (abs(dx) != r && abs(dy) != r) continue;
+                int x = cx + dx;
+                int y = cy + dy;
+                if (Map_GetZone(x, y, isNaval) != zone) continue;
+                int dist = dx * dx + dy * dy;
+                if (dist < bestDist) {
+                    bestDist = dist;
+                    *cellX = x;
+                    *cellY = y;
+                }
+            }
+        }
+        if (bestDist != INT_MAX) return TRUE;
+    }
+    return FALSE;
+}
+
+// AI units and harvesters on plain moves would rather not drive through
+// enemy fire; attack orders are meant to find it
+static BOOL AvoidsThreat(const Unit* unit) {
+    if (unit->state != STATE_MOVING) return FALSE;
+    return unit->team == TEAM_ENEMY || unit->type == UNIT_HARVESTER;
+}
+
+// Hostile threat summed over the tiles on the straight line between cells
+static int CorridorThreat(int team, int fromX, int fromY, int toX, int toY) {
+    int dx = toX - fromX;
+    int dy = toY - fromY;
+    int span = abs(dx) > abs(dy) ? abs(dx) : abs(dy);
+    int steps = span / THREAT_TILE_SIZE + 1;
+    int total = 0;
+    for (int i = 0; i <= steps; i++) {
+        total += Threat_Against(team, fromX + dx * i / steps, fromY + dy * i / steps);
+    }
+    return total;
 }
 
 // Find path from start cell to target cell using A*
-// Returns true if path found, fills unit->pathCells and unit->pathLength
-static BOOL FindPath(Unit* unit, int startCellX, int startCellY,
-                     int targetCellX, int targetCellY) {
+// Fills unit->pathCells/pathLength and sets unit->pathPartial when the
+// path stops short of the target (search budget hit, or more steps than
+// the waypoint buffer holds). Targets in another zone are swapped for the
+// closest cell the unit can reach. Groups headed for one cell follow a
+// shared flow field instead, and routes already planned to the target are
+// served from the path cache. Units that avoid threat pay extra for cells
+// under enemy fire.
+static PathResult FindPath(Unit* unit, int startCellX, int startCellY,
+                           int targetCellX, int targetCellY) {
     const UnitTypeDef* def = &g_unitTypes[unit->type];
     BOOL isNaval = def->isNaval;
     BOOL isAircraft = def->isAircraft;
@@ -898,10 +1597,11 @@ static BOOL FindPath(Unit* unit, int startCellX, int startCellY,
     // Clear path
     unit->pathLength = 0;
     unit->pathIndex = 0;
+    unit->pathPartial = 0;
 
     // Already at target?
     if (startCellX == targetCellX && startCellY == targetCellY) {
-        return TRUE;
+        return PATH_FOUND;
     }
 
     int mapW = Map_GetWidth();
@@ -921,88 +1621,154 @@ static BOOL FindPath(Unit* unit, int startCellX, int startCellY,
         // Single waypoint - direct flight to target
         unit->pathCells[0] = clampedY * mapW + clampedX;
         unit->pathLength = 1;
-        return TRUE;
+        return PATH_FOUND;
     }
 
     // Check if target is reachable (ground/naval units only)
     if (!IsCellPassable(targetCellX, targetCellY, isNaval, isAircraft)) {
-        return FALSE;
+        return PATH_FAILED;
+    }
+    if (startCellX < 0 || startCellX >= mapW ||
+        startCellY < 0 || startCellY >= mapH) {
+        return PATH_FAILED;
+    }
+
+    // A target in another zone can never be reached; rather than spend the
+    // whole search budget finding that out, head for the closest cell the
+    // unit can reach
+    int orderedX = targetCellX;
+    int orderedY = targetCellY;
+    int startZone = Map_GetZone(startCellX, startCellY, isNaval);
+    if (startZone != 0 && startZone != Map_GetZone(targetCellX, targetCellY, isNaval)) {
+        if (!FindNearestInZone(startZone, isNaval, &targetCellX, &targetCellY)) {
+            return PATH_FAILED;
+        }
+        if (startCellX == targetCellX && startCellY == targetCellY) {
+            return PATH_FAILED;
+        }
     }
 
-    // Open set (priority queue)
-    std::priority_queue<PathNode, std::vector<PathNode>,
-                        std::greater<PathNode>> openSet;
+    PathCacheMover mover = isNaval ? PATHCACHE_NAVAL : PATHCACHE_GROUND;
+    int startIdx = startCellY * mapW + startCellX;
+    int targetIdx = targetCellY * mapW + targetCellX;
 
-    // Closed set and g-scores (simple 2D array for small maps)
-    std::vector<bool> closed(mapW * mapH, false);
-    std::vector<int> gScore(mapW * mapH, 0x7FFF);
-    std::vector<int16_t> parentX(mapW * mapH, -1);
-    std::vector<int16_t> parentY(mapW * mapH, -1);
+    // AI units and harvesters on plain moves steer around enemy fire when
+    // the way to the target crosses it. Such routes depend on where the
+    // enemy stands right now, so they bypass the shared fields and cache.
+    int threatTeam = -1;
+    if (AvoidsThreat(unit) &&
+        CorridorThreat(unit->team, startCellX, startCellY, targetCellX, targetCellY) > 0) {
+        threatTeam = unit->team;
+    }
 
-    // Start node
-    PathNode start;
-    start.cellX = startCellX;
-    start.cellY = startCellY;
-    start.g = 0;
-    start.h = Heuristic(startCellX, startCellY, targetCellX, targetCellY);
-    start.f = start.h;
-    start.parentX = -1;
-    start.parentY = -1;
+    if (threatTeam < 0) {
+        // Group orders build one field toward the goal; once it's cached any
+        // unit bound there just reads its steps from it
+        FlowFieldLayer flowLayer = isNaval ? FLOWFIELD_NAVAL : FLOWFIELD_GROUND;
+        const FlowField* field = FlowField_Find(flowLayer, targetCellX, targetCellY);
+        if (!field && GroupOrderSize(orderedX, orderedY, isNaval) >= FLOW_GROUP_MIN) {
+            field = FlowField_Get(flowLayer, targetCellX, targetCellY);
+        }
+        if (field) {
+            BOOL partial = FALSE;
+            int length = FlowField_Walk(field, startCellX, startCellY,
+                                        unit->pathCells, MAX_PATH_WAYPOINTS, &partial);
+            if (length > 0) {
+                unit->pathLength = length;
+                unit->pathPartial = partial ? 1 : 0;
+                return partial ? PATH_PARTIAL : PATH_FOUND;
+            }
+        }
 
-    openSet.push(start);
-    gScore[startCellY * mapW + startCellX] = 0;
+        // Repeat trips (harvester runs, attack waves down one lane) reuse a
+        // route planned earlier, from its start or any cell along it
+        BOOL cachedPartial = FALSE;
+        int cachedLength = PathCache_Lookup(mover, startIdx, targetIdx, unit->pathCells,
+                                            MAX_PATH_WAYPOINTS, &cachedPartial);
+        if (cachedLength > 0) {
+            unit->pathLength = cachedLength;
+            unit->pathPartial = cachedPartial ? 1 : 0;
+            return cachedPartial ? PATH_PARTIAL : PATH_FOUND;
+        }
 
-    int iterations = 0;
-    const int MAX_ITERATIONS = 2000;  // Prevent infinite loops
+    }
 
-    while (!openSet.empty() && iterations < MAX_ITERATIONS) {
-        iterations++;
+    PathWorkspace* ws = &g_pathWork;
+    PathWork_Begin();
+    const uint32_t gen = ws->generation;
 
-        PathNode current = openSet.top();
-        openSet.pop();
+    int startH = Heuristic(startCellX, startCellY, targetCellX, targetCellY);
+    ws->visitGen[startIdx] = gen;
+    ws->gScore[startIdx] = 0;
+    PathHeap_Push(PathKey(startH, startH, startIdx), 0, startIdx);
 
-        int idx = current.cellY * mapW + current.cellX;
+    // Closest expanded cell to the target, for partial results
+    int bestIdx = startIdx;
+    int bestH = startH;
+    int bestG = 0;
 
-        // Skip if already processed
-        if (closed[idx]) continue;
-        closed[idx] = true;
+    // Long trips plan over the sector graph, but only where it beats the
+    // flat search: far trips go to it at once, nearer ones only after a
+    // short flat probe runs out (walls or water in the way). If the graph
+    // finds no route (its entrances don't cover every gap) the flat
+    // search carries on from where the probe stopped. Only what the
+    // waypoint buffer holds is refined; the unit plans the next leg from
+    // there when it arrives.
+    BOOL tryGraph = (threatTeam < 0 &&
+                     PathGraph_IsLongPath(startCellX, startCellY, targetCellX, targetCellY));
+    int budget = tryGraph
+        ? PathGraph_ProbeBudget(startCellX, startCellY, targetCellX, targetCellY)
+        : MAX_ITERATIONS;
 
-        // Found target?
-        if (current.cellX == targetCellX && current.cellY == targetCellY) {
-            // Reconstruct path (backwards)
-            std::vector<int16_t> pathReverse;
-            int cx = targetCellX, cy = targetCellY;
-
-            while (cx != startCellX || cy != startCellY) {
-                int cidx = cy * mapW + cx;
-                pathReverse.push_back(cy * mapW + cx);
-
-                int px = parentX[cidx];
-                int py = parentY[cidx];
-                if (px < 0 || py < 0) break;  // Safety
-                cx = px;
-                cy = py;
-
-                // Safety limit
-                if ((int)pathReverse.size() > MAX_PATH_WAYPOINTS * 2)
-                    break;
+    int iterations = 0;
+    while (ws->heapSize > 0) {
+        if (iterations >= budget) {
+            if (!tryGraph) break;
+            tryGraph = FALSE;
+            budget = MAX_ITERATIONS;
+            BOOL partial = FALSE;
+            int length = PathGraph_FindPath(isNaval ? PATHGRAPH_NAVAL : PATHGRAPH_GROUND,
+                                            startCellX, startCellY, targetCellX, targetCellY,
+                                            g_routeCells, MAX_PATH_WAYPOINTS, &partial);
+            if (length > 0) {
+                PathCache_Store(mover, startIdx, targetIdx, g_routeCells, length, !partial);
+                return UseRoute(unit, g_routeCells, length, partial);
             }
+            continue;
+        }
+
+        PathNode current = PathHeap_Pop();
+        int idx = current.cell;
 
-            // Copy path (reversed) to unit
-            int pathLen = (int)pathReverse.size();
-            if (pathLen > MAX_PATH_WAYPOINTS) pathLen = MAX_PATH_WAYPOINTS;
-            unit->pathLength = pathLen;
-            for (int i = 0; i < pathLen; i++) {
-                unit->pathCells[i] = pathReverse[pathLen - 1 - i];
+        // Skip stale duplicates
+        if (ws->closedGen[idx] == gen) continue;
+        ws->closedGen[idx] = gen;
+        iterations++;
+
+        // Found target?
+        if (idx == targetIdx) {
+            int steps = CopyPathCells(startIdx, targetIdx, g_routeCells, PATHCACHE_MAX_CELLS);
+            int length = (steps > PATHCACHE_MAX_CELLS) ? PATHCACHE_MAX_CELLS : steps;
+            if (threatTeam < 0) {
+                PathCache_Store(mover, startIdx, targetIdx, g_routeCells, length,
+                                steps <= PATHCACHE_MAX_CELLS);
             }
+            return UseRoute(unit, g_routeCells, length, steps > PATHCACHE_MAX_CELLS);
+        }
 
-            return TRUE;
+        int cx = idx % mapW;
+        int cy = idx / mapW;
+        int h = (int)((current.key >> 20) & 0xFFFFF);
+        if (h < bestH || (h == bestH && current.g < bestG)) {
+            bestIdx = idx;
+            bestH = h;
+            bestG = current.g;
         }
 
         // Explore neighbors
         for (int dir = 0; dir < 8; dir++) {
-            int nx = current.cellX + DIR_DX[dir];
-            int ny = current.cellY + DIR_DY[dir];
+            int nx = cx + DIR_DX[dir];
+            int ny = cy + DIR_DY[dir];
 
             // Bounds check
             if (nx < 0 || nx >= mapW || ny < 0 || ny >= mapH) continue;
@@ -1010,35 +1776,35 @@ static BOOL FindPath(Unit* unit, int startCellX, int startCellY,
             int nidx = ny * mapW + nx;
 
             // Already closed?
-            if (closed[nidx]) continue;
+            if (ws->closedGen[nidx] == gen) continue;
 
             // Passable?
             if (!IsCellPassable(nx, ny, isNaval, isAircraft)) continue;
 
-            // Calculate cost
-            int newG = current.g + DIR_COST[dir];
-
             // Better path?
-            if (newG < gScore[nidx]) {
-                gScore[nidx] = newG;
-                parentX[nidx] = current.cellX;
-                parentY[nidx] = current.cellY;
-
-                PathNode neighbor;
-                neighbor.cellX = nx;
-                neighbor.cellY = ny;
-                neighbor.g = newG;
-                neighbor.h = Heuristic(nx, ny, targetCellX, targetCellY);
-                neighbor.f = neighbor.g + neighbor.h;
-                neighbor.parentX = current.cellX;
-                neighbor.parentY = current.cellY;
-
-                openSet.push(neighbor);
+            int newG = current.g + DIR_COST[dir];
+            if (threatTeam >= 0) {
+                newG += Threat_Against(threatTeam, nx, ny) / THREAT_COST_DIVISOR;
             }
+            if (ws->visitGen[nidx] == gen && newG >= ws->gScore[nidx]) continue;
+
+            ws->visitGen[nidx] = gen;
+            ws->gScore[nidx] = newG;
+            ws->parent[nidx] = (uint16_t)idx;
+
+            int nh = Heuristic(nx, ny, targetCellX, targetCellY);
+            PathHeap_Push(PathKey(newG + nh, nh, nidx), newG, nidx);
         }
     }
 
-    return FALSE;  // No path found
+    // Target not reached - head for the closest cell we found so the unit
+    // makes progress instead of re-running the same failing search
+    if (bestIdx == startIdx) {
+        return PATH_FAILED;
+    }
+    CopyPathToUnit(unit, startIdx, bestIdx);
+    unit->pathPartial = 1;
+    return PATH_PARTIAL;
 }
 
 // Set up the next waypoint from the path
@@ -1080,10 +1846,13 @@ static void TryCrushInfantry(Unit* crusher, int unitId,
     const UnitTypeDef* crusherDef = &g_unitTypes[crusher->type];
     int crushRadius = crusherDef->size / 2;
 
-    for (int i = 0; i < MAX_UNITS; i++) {
+    int nearIds[MAX_UNITS];
+    int nearCount = GatherUnitsNear(worldX, worldY, nearIds, MAX_UNITS);
+
+    for (int n = 0; n < nearCount; n++) {
+        int i = nearIds[n];
         if (i == unitId) continue;
         Unit* target = &g_units[i];
-        if (!target->active) continue;
         if (target->state == STATE_DYING) continue;
 
         // ONLY crush ENEMY infantry - not friendlies!
@@ -1100,7 +1869,7 @@ static void TryCrushInfantry(Unit* crusher, int unitId,
         if (dist < crushRadius + targetDef->size / 2) {
             // Crush! Enemy infantry dies instantly
             target->health = 0;
-            target->state = STATE_DYING;
+            MarkUnitDying(target, i);
 
             // Fire DESTROYED trigger if target has one attached
             if (target->triggerName[0] != '\0') {
@@ -1124,12 +1893,19 @@ static void UpdateUnitMovement(Unit* unit, int unitId) {
 
     // If no path, try to find one
     if (unit->pathLength == 0) {
+        // Blocked units wait a few ticks before re-planning
+        if (unit->repathDelay > 0) {
+            unit->repathDelay--;
+            return;
+        }
+
         int startCellX, startCellY, targetCellX, targetCellY;
         Map_WorldToCell(unit->worldX, unit->worldY, &startCellX, &startCellY);
         Map_WorldToCell(unit->targetX, unit->targetY,
                         &targetCellX, &targetCellY);
 
-        if (!FindPath(unit, startCellX, startCellY, targetCellX, targetCellY)) {
+        if (FindPath(unit, startCellX, startCellY,
+                     targetCellX, targetCellY) == PATH_FAILED) {
             // No path available
             unit->state = STATE_IDLE;
             return;
@@ -1152,9 +1928,10 @@ static void UpdateUnitMovement(Unit* unit, int unitId) {
         BOOL canCrush = CanCrushInfantry(unit);
         int wcx = waypointCellX, wcy = waypointCellY;
         if (IsCellOccupiedForTeam(wcx, wcy, unitId, unit->team, canCrush)) {
-            // Cell occupied - clear path to trigger re-pathfinding next frame
+            // Cell occupied - clear path to trigger re-pathfinding shortly
             // Keep moving state so unit continues to try reaching destination
             unit->pathLength = 0;
+            unit->repathDelay = REPATH_BLOCKED_TICKS;
             return;
         }
     }
@@ -1173,15 +1950,22 @@ static void UpdateUnitMovement(Unit* unit, int unitId) {
         TryCrushInfantry(unit, unitId, unit->worldX, unit->worldY);
 
         // Update cell occupancy if we changed cells
+        g_unitHash.Move(unitId, unit->worldX, unit->worldY);
+        Mission_PostEvent(MISSION_EVENT_UNIT_MOVED, unitId);
         int newCellX, newCellY;
         Map_WorldToCell(unit->worldX, unit->worldY, &newCellX, &newCellY);
         if (newCellX != oldCellX || newCellY != oldCellY) {
-            UpdateCellOccupancy(unitId, oldCellX, oldCellY, newCellX, newCellY);
+            UpdateCellOccupancy(unitId, newCellX, newCellY);
+            Sight_Move(&g_unitSight[unitId], newCellX, newCellY);
+            ThreatSource_Move(&g_unitThreat[unitId], newCellX, newCellY);
         }
 
         // Move to next waypoint
         if (unit->pathIndex < unit->pathLength) {
             SetNextWaypoint(unit);
+        } else if (unit->pathPartial) {
+            // End of a partial path - plan the next leg from here
+            unit->pathLength = 0;
         } else {
             // Final destination reached
             unit->state = STATE_IDLE;
@@ -1231,10 +2015,14 @@ static void UpdateUnitMovement(Unit* unit, int unitId) {
         TryCrushInfantry(unit, unitId, unit->worldX, unit->worldY);
 
         // Update cell occupancy if we changed cells
+        g_unitHash.Move(unitId, unit->worldX, unit->worldY);
+        Mission_PostEvent(MISSION_EVENT_UNIT_MOVED, unitId);
         int newCellX, newCellY;
         Map_WorldToCell(unit->worldX, unit->worldY, &newCellX, &newCellY);
         if (newCellX != oldCellX || newCellY != oldCellY) {
-            UpdateCellOccupancy(unitId, oldCellX, oldCellY, newCellX, newCellY);
+            UpdateCellOccupancy(unitId, newCellX, newCellY);
+            Sight_Move(&g_unitSight[unitId], newCellX, newCellY);
+            ThreatSource_Move(&g_unitThreat[unitId], newCellX, newCellY);
         }
 
         // Update facing based on movement direction
@@ -1245,27 +2033,9 @@ static void UpdateUnitMovement(Unit* unit, int unitId) {
 }
 
 static int FindNearestEnemy(Unit* unit, int maxRange) {
-    int closestDist = maxRange + 1;
-    int closestEnemy = -1;
-
-    for (int i = 0; i < MAX_UNITS; i++) {
-        Unit* target = &g_units[i];
-        if (!target->active) continue;
-        if (target->team == unit->team) continue;
-        if (target->team == TEAM_NEUTRAL) continue;
-        if (target->health <= 0) continue;
-
-        int dx = target->worldX - unit->worldX;
-        int dy = target->worldY - unit->worldY;
-        int dist = (int)sqrt((double)(dx * dx + dy * dy));
-
-        if (dist < closestDist) {
-            closestDist = dist;
-            closestEnemy = i;
-        }
-    }
-
-    return closestEnemy;
+    // Only live units on the map are in the hash
+    return g_unitHash.FindNearest(unit->worldX, unit->worldY, maxRange + 1,
+                                  EnemyTeamMask(unit->team));
 }
 
 static void UpdateUnitCombat(Unit* unit, int unitId) {
@@ -1417,7 +2187,7 @@ static void UpdateUnitCombat(Unit* unit, int unitId) {
 
             // Check if target dies
             if (target->health <= 0) {
-                target->state = STATE_DYING;
+                MarkUnitDying(target, unit->targetUnit);
 
                 // Fire DESTROYED trigger if target has one attached
                 if (target->triggerName[0] != '\0') {
@@ -1447,12 +2217,19 @@ static uint8_t g_houseDiscovered[HOUSE_COUNT] = {0};
 
 void Units_SetCreditsPtr(int* creditsPtr) {
     g_pPlayerCredits = creditsPtr;
+    Mission_PostEvent(MISSION_EVENT_CREDITS_CHANGED, 0);
 }
 
 int Units_GetPlayerCredits(void) {
     return g_pPlayerCredits ? *g_pPlayerCredits : 0;
 }
 
+void Units_AddPlayerCredits(int amount) {
+    if (!g_pPlayerCredits) return;
+    *g_pPlayerCredits += amount;
+    Mission_PostEvent(MISSION_EVENT_CREDITS_CHANGED, 0);
+}
+
 void Units_MarkDiscovered(int unitId) {
     if (unitId >= 0 && unitId < MAX_UNITS) {
         g_unitDiscovered[unitId] = 1;
@@ -1676,10 +2453,11 @@ static void UpdateHarvester(Unit* unit, int unitId) {
 
                 unit->cargo += toHarvest;
                 currentCell->oreAmount -= toHarvest;
+                Map_TouchCell(cellX, cellY);
 
                 // If cell depleted, change terrain back to clear
                 if (currentCell->oreAmount == 0) {
-                    currentCell->terrain = TERRAIN_CLEAR;
+                    Map_SetTerrain(cellX, cellY, TERRAIN_CLEAR);
                 }
 
                 // Check if full
@@ -1724,6 +2502,7 @@ static void UpdateHarvester(Unit* unit, int unitId) {
                     int oreValue = Rules_GetGoldValue();
                     int credits = (unit->cargo * oreValue) / 10;  // Scale down
                     *g_pPlayerCredits += credits;
+                    Mission_PostEvent(MISSION_EVENT_CREDITS_CHANGED, 0);
                     unit->cargo = 0;
                 }
                 // Go back to harvesting
@@ -1742,31 +2521,10 @@ static void UpdateHarvester(Unit* unit, int unitId) {
 }
 
 void Units_Update(void) {
-    // === Fog of War: Clear and reveal around player units/buildings ===
-    Map_ClearVisibility();
-
-    // Reveal around player units
-    for (int i = 0; i < MAX_UNITS; i++) {
-        Unit* unit = &g_units[i];
-        if (!unit->active) continue;
-        if (unit->team != TEAM_PLAYER) continue;
-
-        int cellX, cellY;
-        Map_WorldToCell(unit->worldX, unit->worldY, &cellX, &cellY);
-        Map_RevealAround(cellX, cellY, unit->sightRange, TEAM_PLAYER);
-    }
-
-    // Reveal around player buildings
-    for (int i = 0; i < MAX_BUILDINGS; i++) {
-        Building* bld = &g_buildings[i];
-        if (!bld->active) continue;
-        if (bld->team != TEAM_PLAYER) continue;
-
-        // Reveal from center of building
-        int centerX = bld->cellX + bld->width / 2;
-        int centerY = bld->cellY + bld->height / 2;
-        Map_RevealAround(centerX, centerY, bld->sightRange, TEAM_PLAYER);
-    }
+    // === Fog of War ===
+    // Player sight is tracked incrementally as units change cells; only
+    // last tick's one-shot trigger reveals need expiring here.
+    Map_UpdateVisibility();
 
     // === Update units ===
     for (int i = 0; i < MAX_UNITS; i++) {
@@ -1804,23 +2562,9 @@ void Units_Update(void) {
         int cy = bld->cellY + bld->height / 2;
         Map_CellToWorld(cx, cy, &bldWorldX, &bldWorldY);
 
-        int closestDist = def->attackRange + 1;
-        int closestEnemy = -1;
-
-        for (int j = 0; j < MAX_UNITS; j++) {
-            Unit* target = &g_units[j];
-            bool skip = !target->active || target->team == bld->team;
-            if (skip || target->team == TEAM_NEUTRAL) continue;
-
-            int dx = target->worldX - bldWorldX;
-            int dy = target->worldY - bldWorldY;
-            int dist = (int)sqrt((double)(dx * dx + dy * dy));
-
-            if (dist < closestDist) {
-                closestDist = dist;
-                closestEnemy = j;
-            }
-        }
+        int closestEnemy = g_unitHash.FindNearest(bldWorldX, bldWorldY,
+                                                  def->attackRange + 1,
+                                                  EnemyTeamMask(bld->team));
 
         // Attack closest enemy
         if (closestEnemy >= 0) {
@@ -1845,7 +2589,7 @@ void Units_Update(void) {
             Sounds_PlayAt(sfx, bldWorldX, bldWorldY, 200);
 
             if (target->health <= 0) {
-                target->state = STATE_DYING;
+                MarkUnitDying(target, closestEnemy);
 
                 // Fire DESTROYED trigger if target has one attached
                 if (target->triggerName[0] != '\0') {
@@ -1857,6 +2601,8 @@ void Units_Update(void) {
             }
         }
     }
+
+    g_unitTick++;
 }
 
 void Units_Render(void) {
@@ -2026,7 +2772,7 @@ void Units_DestroyByTrigger(const char* triggerName) {
         // Check if this unit has the matching trigger
         if (strcasecmp(unit->triggerName, triggerName) == 0) {
             // Mark unit as dying (will be removed next frame)
-            unit->state = STATE_DYING;
+            MarkUnitDying(unit, i);
             unit->health = 0;
             destroyed++;
             fprintf(stderr, "Units_DestroyByTrigger: Unit %d destroyed\n", i);
@@ -2051,6 +2797,11 @@ void Buildings_DestroyByTrigger(const char* triggerName) {
         if (strcasecmp(bld->triggerName, triggerName) == 0) {
             // Remove building immediately
             bld->active = 0;
+            g_buildingHash.Remove(i);
+            Sight_Remove(&g_buildingSight[i]);
+            ThreatSource_Remove(&g_buildingThreat[i]);
+            CountBuilding(bld, -1);
+            Mission_PostEvent(MISSION_EVENT_BUILDING_DESTROYED, i);
             bld->health = 0;
             destroyed++;
             fprintf(stderr, "Buildings_DestroyByTrigger: Bld %d destroyed\n",
@@ -2112,6 +2863,7 @@ int Units_LoadIntoTransport(int unitId, int transportId) {
             transport->passengers[i] = unitId;
             transport->passengerCount++;
             unit->transportId = transportId;
+            UnregisterUnit(unitId);
 
             // Hide unit (make inactive visually but keep in memory)
             unit->state = STATE_IDLE;
@@ -2185,6 +2937,9 @@ int Units_UnloadTransport(int transportId) {
         passenger->transportId = -1;
         passenger->state = STATE_IDLE;
         passenger->active = 1;
+        RegisterUnit(passengerId, spawnX, spawnY);
+        Sight_Move(&g_unitSight[passengerId], spawnX, spawnY);
+        Mission_PostEvent(MISSION_EVENT_UNIT_MOVED, passengerId);
 
         // Clear from transport
         transport->passengers[i] = -1;
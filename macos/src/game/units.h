@@ -228,6 +228,9 @@ typedef struct {
     int16_t loadTarget;     // Transport ID we're trying to load into (-1 = none)
     // Trigger attachment
     char triggerName[24];   // Attached trigger name (for ATTACKED/DESTROYED events)
+    // Path planning
+    uint8_t pathPartial;    // Path stops short of target - re-plan at its end
+    uint8_t repathDelay;    // Ticks to wait before re-planning a blocked path
 } Unit;
 
 // Building structure
@@ -284,6 +287,16 @@ Unit* Units_Get(int unitId);
  */
 int Units_CountByTeam(Team team);
 
+/**
+ * Get live building count for a team
+ */
+int Buildings_CountByTeam(Team team);
+
+/**
+ * Get live building count for a team and building type
+ */
+int Buildings_CountByTeamType(Team team, BuildingType type);
+
 /**
  * Spawn a building
  * @return Building ID, or -1 on failure
@@ -300,6 +313,43 @@ void Buildings_Remove(int buildingId);
  */
 Building* Buildings_Get(int buildingId);
 
+/**
+ * Raw table slot, live or not, for save games
+ * @return Pointer to the slot, or NULL if the ID is out of range
+ */
+Unit* Units_GetSlot(int unitId);
+Building* Buildings_GetSlot(int buildingId);
+
+/**
+ * Rebuild team counts, spatial hashes, occupancy slots and player sight
+ * after the unit and building tables were written directly (save game
+ * load). The map must already hold its saved cells, occupant lists
+ * included; those are kept as-is so cell order matches the saved game.
+ */
+void Units_RestoreIndexes(void);
+
+/**
+ * Move and attack-move orders tallied per goal cell; a group ordered to
+ * one cell in the same tick shares a flow field toward it. Saved with
+ * the unit table, since it decides which route a unit is handed.
+ */
+#define GROUP_ORDER_SLOTS 16
+
+typedef struct {
+    int32_t goal;       // Cell index (y * map width + x)
+    int32_t isNaval;
+    uint32_t tick;      // Units_Update count when the group was ordered
+    int32_t count;      // 0 = slot unused
+} GroupOrder;
+
+typedef struct {
+    GroupOrder orders[GROUP_ORDER_SLOTS];
+    uint32_t tick;      // Current Units_Update count
+} GroupOrderState;
+
+void Units_GetGroupOrders(GroupOrderState* state);
+void Units_SetGroupOrders(const GroupOrderState* state);
+
 /**
  * Command unit to move to position
  */
@@ -376,6 +426,33 @@ void Units_SelectInRect(int x1, int y1, int x2, int y2, Team team);
  */
 int Units_GetAtScreen(int screenX, int screenY);
 
+// Bit for a team in a unit query mask
+#define UNITS_TEAM_BIT(t)   (1u << (t))
+
+/**
+ * Find live units within radius of a world position
+ * Uses the spatial hash; dying units and transport passengers are excluded.
+ * A unit is inside when its squared distance is less than radius^2.
+ * @param teamMask UNITS_TEAM_BIT() of each team to include
+ * @return Number of unit IDs written to outIds (unordered)
+ */
+int Units_QueryRadius(int worldX, int worldY, int radius, uint32_t teamMask,
+                      int* outIds, int maxIds);
+
+/**
+ * Find the k nearest live units to a world position
+ * @param radius Search limit in pixels (0 = whole map)
+ * @return Number of unit IDs written to outIds, closest first
+ */
+int Units_QueryNearest(int worldX, int worldY, int radius, uint32_t teamMask,
+                       int k, int* outIds);
+
+/**
+ * Get every live unit on the map for a team
+ * @return Number of unit IDs written to outIds (unordered)
+ */
+int Units_GetTeamUnits(Team team, int* outIds, int maxIds);
+
 /**
  * Update all units
  */
@@ -398,6 +475,11 @@ void Units_SetCreditsPtr(int* creditsPtr);
  */
 int Units_GetPlayerCredits(void);
 
+/**
+ * Add to (or, with a negative amount, spend) player credits
+ */
+void Units_AddPlayerCredits(int amount);
+
 /**
  * Discovery tracking for triggers
  */
@@ -6,6 +6,7 @@
  */
 
 #include "voice_types.h"
+#include "random.h"
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -542,7 +543,7 @@ VocType Voice_GetResponse(int unitType, bool isInfantry,
     if (!responses || count <= 0) return VocType::NONE;
 
     // Random selection for variety
-    int idx = rand() % count;
+    int idx = Random_Cosmetic(count);
     return responses[idx];
 }
 
@@ -559,7 +560,7 @@ void Voice_BuildFilename(VocType voc, VoiceVariant variant,
     if (hasVariants) {
         // Build variant filename (e.g., AWAIT1.V00 or AWAIT1.R00)
         const char* ext = (variant == VoiceVariant::ALLIED) ? ".V" : ".R";
-        int variantNum = rand() % 4;  // 00-03
+        int variantNum = Random_Cosmetic(4);  // 00-03
         snprintf(outBuffer, bufSize, "%s%s%02d", baseName, ext, variantNum);
     } else {
         // Standard AUD file
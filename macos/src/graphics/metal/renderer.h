@@ -32,6 +32,10 @@ static inline uint8_t* Renderer_GetFramebuffer(void) {
     return Wwd_Renderer_GetFramebuffer();
 }
 
+static inline void Renderer_MarkDirty(int x, int y, int width, int height) {
+    Wwd_Renderer_MarkDirty(x, y, width, height);
+}
+
 static inline int Renderer_GetWidth(void) {
     return Wwd_Renderer_GetWidth();
 }
@@ -175,6 +179,21 @@ static inline void Renderer_BlitSpriteRemapped(const uint8_t* pixels,
                                    offsetX, offsetY, trans, remap);
 }
 
+static inline void Renderer_BlitSpans(const uint8_t* spans, int width,
+                                      int height, int destX, int destY,
+                                      const uint8_t* remap) {
+    Wwd_Renderer_BlitSpans(spans, width, height, destX, destY, remap);
+}
+
+static inline void Renderer_BlitSpriteSpans(const uint8_t* spans,
+                                            int width, int height,
+                                            int destX, int destY,
+                                            int offsetX, int offsetY,
+                                            const uint8_t* remap) {
+    Wwd_Renderer_BlitSpriteSpans(spans, width, height, destX, destY,
+                                offsetX, offsetY, remap);
+}
+
 /**
  * Load a game palette from AssetLoader and set it as current
  * Note: This is game-specific and remains in the game layer.
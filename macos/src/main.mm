@@ -18,6 +18,8 @@
 #include "game/terrain.h"
 #include "game/ai.h"
 #include "game/mission.h"
+#include "game/random.h"
+#include "game/replay.h"
 #include "audio/audio.h"
 
 // Forward declarations for campaign system (avoid header conflicts)
@@ -51,6 +53,7 @@ extern "C" {
 #include "ui/cursor.h"
 #include "compat/assets.h"
 #include "assets/assetloader.h"
+#include "assets/assetcache.h"
 #include "assets/shpfile.h"
 #include <cmath>
 
@@ -107,6 +110,10 @@ static void StartMission(const MissionData* mission) {
     g_resultDisplayTimer = 0;
     g_gameFrameCount = 0;
 
+    // Fresh game seed; logged so a session can be reproduced
+    Random_Seed((uint64_t)time(nullptr));
+    NSLog(@"Game seed: %llu", (unsigned long long)Random_GetSeed());
+
     // Initialize game UI
     GameUI_Init();
 
@@ -117,9 +124,30 @@ static void StartMission(const MissionData* mission) {
     // Mission_Start centers viewport on first player unit
     Mission_Start(mission);
 
+    // Record player commands from the starting state, if enabled
+    if (Menu_GetRecordReplays()) {
+        Replay_StartRecording(mission->name);
+    }
+
     NSLog(@"Mission started: %s", mission->name);
 }
 
+// Write the replay of the mission that just ended next to the save games
+static void SaveLastReplay(void) {
+    if (!Replay_IsRecording()) return;
+
+    NSString* dir = [NSHomeDirectory()
+        stringByAppendingPathComponent:@"Library/Application Support/RedAlert/saves"];
+    [[NSFileManager defaultManager] createDirectoryAtPath:dir
+                              withIntermediateDirectories:YES
+                                               attributes:nil
+                                                    error:nil];
+    NSString* path = [dir stringByAppendingPathComponent:@"LASTGAME.RPL"];
+    if (Replay_StopRecording(path.fileSystemRepresentation)) {
+        NSLog(@"Replay saved: %@ (%u ticks)", path, Replay_GetTick());
+    }
+}
+
 // Start a demo mission (skirmish mode)
 static void StartDemoMission(void) {
     // Load demo mission data
@@ -285,6 +313,7 @@ static void OnVariantSelected(int variant) {
 // Called after win/lose video completes - show score screen
 static void OnMissionOutroComplete(void) {
     NSLog(@"Outro video complete, showing score");
+    SaveLastReplay();
     g_inGameplay = false;
     g_missionResult = MISSION_ONGOING;
     AI_Shutdown();
@@ -460,6 +489,7 @@ static bool UpdateMenuScreen(float /*deltaTime*/) {
 
 // Shutdown gameplay and return to menu
 static void ExitToMenu(void) {
+    SaveLastReplay();
     g_inGameplay = false;
     g_missionResult = MISSION_ONGOING;
     AI_Shutdown();
@@ -546,18 +576,18 @@ static void UpdateRightClickCommands(int mx, int my) {
             if (!unit || !unit->selected) continue;
 
             if (ctrlDown) {
-                Units_CommandForceAttack(i, worldX, worldY);
+                Replay_Issue(REPLAY_CMD_FORCE_ATTACK, i, worldX, worldY);
             } else if (g_attackMoveMode) {
-                Units_CommandAttackMove(i, worldX, worldY);
+                Replay_Issue(REPLAY_CMD_ATTACK_MOVE, i, worldX, worldY);
             } else if (target && target->team == TEAM_ENEMY) {
-                Units_CommandAttack(i, targetId);
+                Replay_Issue(REPLAY_CMD_ATTACK, i, targetId, 0);
             } else if (target && target->team == unit->team &&
                        Units_IsTransport((UnitType)target->type) &&
                        Units_IsLoadable((UnitType)unit->type)) {
                 // Friendly transport - command load (tracks target, retries)
-                Units_CommandLoad(i, targetId);
+                Replay_Issue(REPLAY_CMD_LOAD, i, targetId, 0);
             } else {
-                Units_CommandMove(i, worldX, worldY);
+                Replay_Issue(REPLAY_CMD_MOVE, i, worldX, worldY);
             }
         }
         g_attackMoveMode = false;
@@ -571,7 +601,7 @@ static void UpdateHotkeyCommands(void) {
     if (Input_WasKeyPressed('S') && !Input_IsKeyDown('W')) {
         for (int i = 0; i < MAX_UNITS; i++) {
             Unit* unit = Units_Get(i);
-            if (unit && unit->selected) Units_CommandStop(i);
+            if (unit && unit->selected) Replay_Issue(REPLAY_CMD_STOP, i, 0, 0);
         }
     }
 
@@ -585,7 +615,7 @@ static void UpdateHotkeyCommands(void) {
     if (Input_WasKeyPressed('G')) {
         for (int i = 0; i < MAX_UNITS; i++) {
             Unit* unit = Units_Get(i);
-            if (unit && unit->selected) Units_CommandGuard(i);
+            if (unit && unit->selected) Replay_Issue(REPLAY_CMD_GUARD, i, 0, 0);
         }
     }
 
@@ -595,7 +625,7 @@ static void UpdateHotkeyCommands(void) {
             Unit* unit = Units_Get(i);
             if (!unit || !unit->selected) continue;
             if (Units_IsTransport((UnitType)unit->type)) {
-                Units_UnloadTransport(i);
+                Replay_Issue(REPLAY_CMD_UNLOAD, i, 0, 0);
             }
         }
     }
@@ -680,6 +710,7 @@ static bool UpdateResultScreen(void) {
 // Called at game logic rate (15 FPS default)
 void GameUpdate(uint32_t frame, float deltaTime) {
     Music_Update((int)(deltaTime * 1000));
+    AssetCache_Update();
 
     // Menu mode
     if (UpdateMenuScreen(deltaTime)) return;
@@ -715,6 +746,7 @@ void GameUpdate(uint32_t frame, float deltaTime) {
             AI_Update();
             g_gameFrameCount++;
             UpdateMissionState();
+            Replay_EndTick();
         }
         UpdateResultScreen();  // Handles video playback on completion
         return;
@@ -1259,11 +1291,13 @@ void GameRender(void) {
     // Initialize asset loader and load game assets
     if (Assets_Init()) {
         NSLog(@"AssetLoader initialized");
+        // Decode hinted sprites and templates off the game thread
+        AssetCache_StartWorkers(ASSETCACHE_DEFAULT_WORKERS);
         // Load game palette
         if (Renderer_LoadPalette("SNOW.PAL")) {
             NSLog(@"Loaded SNOW.PAL palette");
         }
-        // Initialize sprite system (loads all unit/building sprites)
+        // Initialize sprite system (sprites load on first use)
         if (Sprites_Init()) {
             NSLog(@"Sprite system initialized");
             g_assetsLoaded = true;
@@ -1362,6 +1396,7 @@ void GameRender(void) {
     Sounds_Shutdown();
     Cursor_Shutdown();
     Sprites_Shutdown();
+    AssetCache_Shutdown();
     g_assetsLoaded = false;
 
     Menu_Shutdown();
@@ -0,0 +1,219 @@
+/**
+ * Red Alert macOS Port - Sprite Asset Cache Benchmark
+ *
+ * Compares the old eager start-up (every unit and building SHP decoded in
+ * Sprites_Init) with a small mission that only prefetches the types its
+ * INI places. Game data isn't available here, so Assets_LoadSHP is faked:
+ * each SHP gets 32-96 frames of 36-72 pixel, mostly transparent art
+ * (picked from its name so runs are repeatable) and is decoded and
+ * span-encoded like a real one. Reports decode time, sprites loaded and
+ * resident bytes for both, then checks a sprite the mission didn't
+ * prefetch still loads on first draw. Last, runs the mission prefetch
+ * again with background workers and checks every sprite decodes once.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <vector>
+
+#include <wwd/span_sprite.h>
+
+#include "game/sprites.h"
+#include "game/units.h"
+#include "assets/assetloader.h"
+#include "assets/assetcache.h"
+#include "assets/shpfile.h"
+#include "graphics/metal/renderer.h"
+
+//===========================================================================
+// Fake SHP Loader
+//===========================================================================
+
+struct ShpFile {
+    std::vector<ShpFrame> frames;
+    std::vector<uint8_t> pixels;
+    std::vector<uint8_t> spans;
+};
+
+static uint32_t NameHash(const char* name) {
+    uint32_t h = 2166136261u;
+    for (; *name; name++) h = (h ^ (uint8_t)*name) * 16777619u;
+    return h;
+}
+
+ShpFileHandle Assets_LoadSHP(const char* name) {
+    uint32_t h = NameHash(name);
+    int frameCount = 32 + (int)(h % 65);
+    int width = 36 + (int)((h >> 8) % 37);
+    int height = 36 + (int)((h >> 16) % 37);
+    int frameSize = width * height;
+
+    ShpFile* shp = new ShpFile;
+    shp->pixels.resize((size_t)frameCount * frameSize);
+
+    // Decode: an opaque ellipse per frame, a little smaller each facing
+    for (int f = 0; f < frameCount; f++) {
+        uint8_t* frame = &shp->pixels[(size_t)f * frameSize];
+        int rx = width / 2 - (f % 4), ry = height / 2 - (f % 3);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                int dx = x - width / 2, dy = y - height / 2;
+                bool inside = dx * dx * ry * ry + dy * dy * rx * rx <= rx * rx * ry * ry;
+                frame[y * width + x] = inside ? (uint8_t)(80 + ((x + y + f) & 15)) : 0;
+            }
+        }
+    }
+
+    std::vector<size_t> offsets(frameCount);
+    size_t total = 0;
+    for (int f = 0; f < frameCount; f++) {
+        offsets[f] = total;
+        total += Wwd_SpanSprite_EncodedSize(&shp->pixels[(size_t)f * frameSize], width, height);
+    }
+    shp->spans.resize(total);
+    shp->frames.resize(frameCount);
+    for (int f = 0; f < frameCount; f++) {
+        Wwd_SpanSprite_Encode(&shp->pixels[(size_t)f * frameSize], width, height,
+                              &shp->spans[offsets[f]]);
+        ShpFrame& frame = shp->frames[f];
+        memset(&frame, 0, sizeof(frame));
+        frame.width = (uint16_t)width;
+        frame.height = (uint16_t)height;
+        frame.pixels = &shp->pixels[(size_t)f * frameSize];
+        frame.spans = &shp->spans[offsets[f]];
+    }
+    return shp;
+}
+
+void Shp_Free(ShpFileHandle shp) {
+    delete shp;
+}
+
+int Shp_GetFrameCount(ShpFileHandle shp) {
+    return shp ? (int)shp->frames.size() : 0;
+}
+
+uint32_t Shp_GetDataSize(ShpFileHandle shp) {
+    if (!shp) return 0;
+    return (uint32_t)(shp->pixels.size() + shp->spans.size() +
+                      shp->frames.size() * sizeof(ShpFrame));
+}
+
+const ShpFrame* Shp_GetFrame(ShpFileHandle shp, int index) {
+    if (!shp || index < 0 || index >= (int)shp->frames.size()) return nullptr;
+    return &shp->frames[index];
+}
+
+//===========================================================================
+// Renderer Stubs (nothing is drawn)
+//===========================================================================
+
+void Wwd_Renderer_BlitRemapped(const uint8_t*, int, int, int, int, WwdBool, const uint8_t*) {}
+void Wwd_Renderer_BlitSpriteRemapped(const uint8_t*, int, int, int, int, int, int, WwdBool,
+                                     const uint8_t*) {}
+void Wwd_Renderer_BlitSpans(const uint8_t*, int, int, int, int, const uint8_t*) {}
+void Wwd_Renderer_BlitSpriteSpans(const uint8_t*, int, int, int, int, int, int,
+                                  const uint8_t*) {}
+
+//===========================================================================
+// Benchmark
+//===========================================================================
+
+// Roughly the first Allied mission: a small base, a few infantry and tanks,
+// a village
+static const UnitType g_missionUnits[] = {
+    UNIT_RIFLE, UNIT_ROCKET, UNIT_TANYA, UNIT_DOG, UNIT_CIVILIAN_1,
+    UNIT_CIVILIAN_2, UNIT_CIVILIAN_8, UNIT_TANK_LIGHT, UNIT_JEEP, UNIT_TRUCK,
+};
+static const BuildingType g_missionBuildings[] = {
+    BUILDING_POWER, BUILDING_BARRACKS, BUILDING_TURRET, BUILDING_PILLBOX,
+    BUILDING_CIV_01, BUILDING_CIV_02, BUILDING_CIV_03, BUILDING_BARREL,
+};
+
+struct Result {
+    double startupMs;
+    uint32_t loads;
+    uint32_t bytes;
+};
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start) {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+static Result Measure(const UnitType* units, int unitCount,
+                      const BuildingType* buildings, int buildingCount) {
+    AssetCache_ResetStats();
+    auto start = std::chrono::steady_clock::now();
+    Sprites_Init();
+    Sprites_Prefetch(units, unitCount, buildings, buildingCount);
+    Result result;
+    result.startupMs = ElapsedMs(start);
+    result.loads = AssetCache_GetStats()->loads;
+    result.bytes = AssetCache_GetStats()->bytes;
+    return result;
+}
+
+int main() {
+    printf("Sprite Asset Cache Benchmark\n");
+    printf("============================\n\n");
+
+    // Sprite loading is chatty on stderr
+    if (!freopen("/dev/null", "w", stderr)) return 1;
+
+    // Eager: what Sprites_Init used to do
+    std::vector<UnitType> allUnits;
+    std::vector<BuildingType> allBuildings;
+    for (int i = 1; i < UNIT_TYPE_COUNT; i++) allUnits.push_back((UnitType)i);
+    for (int i = 1; i < BUILDING_TYPE_COUNT; i++) allBuildings.push_back((BuildingType)i);
+    Result eager = Measure(allUnits.data(), (int)allUnits.size(),
+                           allBuildings.data(), (int)allBuildings.size());
+    Sprites_Shutdown();
+
+    int unitCount = (int)(sizeof(g_missionUnits) / sizeof(g_missionUnits[0]));
+    int buildingCount = (int)(sizeof(g_missionBuildings) / sizeof(g_missionBuildings[0]));
+    Result lazy = Measure(g_missionUnits, unitCount, g_missionBuildings, buildingCount);
+
+    printf("  %-22s %10s %8s %12s\n", "", "startup", "sprites", "resident");
+    printf("  %-22s %8.2f ms %8u %9u KB\n", "eager (all types)",
+           eager.startupMs, eager.loads, eager.bytes / 1024);
+    printf("  %-22s %8.2f ms %8u %9u KB\n", "small mission prefetch",
+           lazy.startupMs, lazy.loads, lazy.bytes / 1024);
+    printf("\n  Startup %.1fx faster, %.1fx less resident\n",
+           eager.startupMs / (lazy.startupMs > 0 ? lazy.startupMs : 1e-3),
+           (double)eager.bytes / (lazy.bytes ? lazy.bytes : 1));
+
+    bool ok = lazy.loads == (uint32_t)(unitCount + buildingCount) && lazy.loads < eager.loads;
+
+    // A type the mission didn't place still draws, loading on first use
+    uint32_t loadsBefore = AssetCache_GetStats()->loads;
+    int frames = Sprites_GetUnitFrameCount(UNIT_TANK_MAMMOTH);
+    ok = ok && frames > 0 && AssetCache_GetStats()->loads == loadsBefore + 1;
+    printf("  On-demand load of an unprefetched sprite: %s\n", frames > 0 ? "yes" : "no");
+
+    Sprites_Shutdown();
+    ok = ok && AssetCache_GetStats()->bytes == 0;
+
+    // The same mission with background workers: the game thread only
+    // queues the decodes, then draws every sprite straight away, decoding
+    // alongside the workers whatever they haven't reached yet
+    AssetCache_StartWorkers(ASSETCACHE_DEFAULT_WORKERS);
+    Result queued = Measure(g_missionUnits, unitCount, g_missionBuildings, buildingCount);
+    auto drawStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < unitCount; i++) Sprites_GetUnitFrameCount(g_missionUnits[i]);
+    for (int i = 0; i < buildingCount; i++) Sprites_GetBuildingFrameCount(g_missionBuildings[i]);
+    double drawMs = ElapsedMs(drawStart);
+    const AssetCacheStats* stats = AssetCache_GetStats();
+    printf("\n  With %d workers: %.2f ms to queue, %.2f ms until every sprite drew\n",
+           ASSETCACHE_DEFAULT_WORKERS, queued.startupMs, drawMs);
+    printf("  (%u of %u decoded on workers, %u draws waited for one)\n",
+           stats->backgroundLoads, stats->loads, stats->stalls);
+    ok = ok && stats->loads == (uint32_t)(unitCount + buildingCount);
+    AssetCache_Shutdown();
+    ok = ok && AssetCache_GetStats()->bytes == 0;
+
+    printf("\n%s\n", ok ? "PASSED" : "FAILED");
+    return ok ? 0 : 1;
+}
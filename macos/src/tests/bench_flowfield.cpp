@@ -0,0 +1,289 @@
+/**
+ * Red Alert macOS Port - Flow Field Benchmark
+ *
+ * Times a 100-unit group move both ways: one flat A* search per unit
+ * (the unit pathfinder without its iteration cap) against a single flow
+ * field integrated from the goal and walked once per unit. Checks every
+ * walked route is legal and exactly as cheap as the unit's A* route, that
+ * repeat orders to the same goal hit the cache, and that a terrain change
+ * flushes it.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <vector>
+
+#include "game/map.h"
+#include "game/flowfield.h"
+#include "game/random.h"
+#include "game/terrain.h"
+#include "graphics/metal/renderer.h"
+
+//===========================================================================
+// Stubs for rendering used by map.cpp
+//===========================================================================
+
+extern "C" {
+void Wwd_Renderer_FillRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_PutPixel(int, int, uint8_t) {}
+void Wwd_Renderer_DrawLine(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_DrawRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_SetAlpha(int, int, int, int, uint8_t) {}
+}
+
+BOOL Terrain_Available(void) { return FALSE; }
+BOOL Terrain_RenderTile(int, int, int, int) { return FALSE; }
+BOOL Terrain_RenderByID(int, int, int, int) { return FALSE; }
+
+//===========================================================================
+// Reference Implementation (flat A*, no iteration cap)
+//===========================================================================
+
+namespace flat {
+
+static const int DIR_DX[8] = { 0,  1, 1, 1, 0, -1, -1, -1 };
+static const int DIR_DY[8] = { -1, -1, 0, 1, 1,  1,  0, -1 };
+static const int DIR_COST[8] = { 10, 14, 10, 14, 10, 14, 10, 14 };
+
+static std::vector<int> gScore;
+static std::vector<bool> closed;
+static std::vector<uint64_t> heap;
+
+static int Heuristic(int x1, int y1, int x2, int y2) {
+    int dx = abs(x2 - x1);
+    int dy = abs(y2 - y1);
+    return (dx > dy) ? dx * 10 + dy * 4 : dy * 10 + dx * 4;
+}
+
+static void Push(uint64_t key) {
+    heap.push_back(key);
+    size_t i = heap.size() - 1;
+    while (i > 0 && heap[(i - 1) / 2] > key) {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap[i] = key;
+}
+
+static uint64_t Pop() {
+    uint64_t top = heap[0];
+    uint64_t last = heap.back();
+    heap.pop_back();
+    size_t n = heap.size(), i = 0;
+    if (n == 0) return top;
+    for (;;) {
+        size_t c = 2 * i + 1;
+        if (c >= n) break;
+        if (c + 1 < n && heap[c + 1] < heap[c]) c++;
+        if (last <= heap[c]) break;
+        heap[i] = heap[c];
+        i = c;
+    }
+    heap[i] = last;
+    return top;
+}
+
+// Returns optimal path cost, or -1 if unreachable
+static int FindPath(int sx, int sy, int tx, int ty) {
+    int w = Map_GetWidth(), h = Map_GetHeight();
+    gScore.assign(w * h, INT32_MAX);
+    closed.assign(w * h, false);
+    heap.clear();
+
+    int start = sy * w + sx, target = ty * w + tx;
+    gScore[start] = 0;
+    Push((uint64_t)Heuristic(sx, sy, tx, ty) << 32 | (uint32_t)start);
+
+    while (!heap.empty()) {
+        int cell = (int)(Pop() & 0xFFFFFFFF);
+        if (closed[cell]) continue;
+        closed[cell] = true;
+        if (cell == target) return gScore[cell];
+
+        int x = cell % w, y = cell / w;
+        for (int d = 0; d < 8; d++) {
+            int nx = x + DIR_DX[d], ny = y + DIR_DY[d];
+            if (!Map_IsPassable(nx, ny)) continue;
+            int n = ny * w + nx;
+            int g = gScore[cell] + DIR_COST[d];
+            if (closed[n] || g >= gScore[n]) continue;
+            gScore[n] = g;
+            Push((uint64_t)(g + Heuristic(nx, ny, tx, ty)) << 32 | (uint32_t)n);
+        }
+    }
+    return -1;
+}
+
+} // namespace flat
+
+//===========================================================================
+// Benchmark Harness
+//===========================================================================
+
+using BenchClock = std::chrono::steady_clock;
+
+static const int GROUP_SIZE = 100;
+static const int REPEATS = 10;
+static const int FULL_PATH_CELLS = 4096;
+
+struct Mover {
+    int x, y;
+    int flatCost;
+};
+
+static std::vector<Mover> g_group;
+static int16_t g_path[FULL_PATH_CELLS];
+
+// Keeps the optimizer from discarding the timed calls
+static volatile int g_benchSink = 0;
+
+// Long rock walls with a few gaps, plus light scatter, so routes weave
+static void BuildWallMap() {
+    Map_Create(MAP_MAX_WIDTH, MAP_MAX_HEIGHT);
+    for (int wall = 1; wall < 10; wall++) {
+        int x = wall * 12 + Random_Sim(4);
+        int gapA = Random_Sim(MAP_MAX_HEIGHT - 4);
+        int gapB = Random_Sim(MAP_MAX_HEIGHT - 4);
+        for (int y = 0; y < MAP_MAX_HEIGHT; y++) {
+            if ((y >= gapA && y < gapA + 3) || (y >= gapB && y < gapB + 3)) continue;
+            Map_SetTerrain(x, y, TERRAIN_ROCK);
+        }
+    }
+    for (int i = 0; i < MAP_MAX_WIDTH * MAP_MAX_HEIGHT / 10; i++) {
+        Map_SetTerrain(Random_Sim(MAP_MAX_WIDTH), Random_Sim(MAP_MAX_HEIGHT), TERRAIN_ROCK);
+    }
+}
+
+// A selection box of units near the west edge, all reachable from the goal
+static void PickGroup(int gx, int gy) {
+    g_group.clear();
+    while ((int)g_group.size() < GROUP_SIZE) {
+        Mover m;
+        m.x = 2 + Random_Sim(12);
+        m.y = 40 + Random_Sim(48);
+        if (!Map_IsPassable(m.x, m.y)) continue;
+        m.flatCost = flat::FindPath(m.x, m.y, gx, gy);
+        if (m.flatCost > 0) g_group.push_back(m);
+    }
+}
+
+// Cost of a returned path; -1 if it takes an illegal step
+static int PathCost(int sx, int sy, const int16_t* cells, int count) {
+    int w = Map_GetWidth();
+    int x = sx, y = sy, cost = 0;
+    for (int i = 0; i < count; i++) {
+        int nx = cells[i] % w, ny = cells[i] / w;
+        int dx = abs(nx - x), dy = abs(ny - y);
+        if (dx > 1 || dy > 1 || (dx == 0 && dy == 0)) return -1;
+        if (!Map_IsPassable(nx, ny)) return -1;
+        cost += (dx && dy) ? 14 : 10;
+        x = nx;
+        y = ny;
+    }
+    return cost;
+}
+
+// Every unit's walked route must be legal, reach the goal and match A*
+static bool CheckRoutes(const FlowField* field, int gx, int gy) {
+    int w = Map_GetWidth();
+    for (const Mover& m : g_group) {
+        BOOL partial = FALSE;
+        int count = FlowField_Walk(field, m.x, m.y, g_path, FULL_PATH_CELLS, &partial);
+        int cost = (count > 0) ? PathCost(m.x, m.y, g_path, count) : -1;
+        if (cost < 0 || partial || g_path[count - 1] != gy * w + gx) {
+            printf("  INVALID route from (%d,%d)\n", m.x, m.y);
+            return false;
+        }
+        if (cost != m.flatCost) {
+            printf("  route from (%d,%d) costs %d, A* %d\n", m.x, m.y, cost, m.flatCost);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool RunGroupMove() {
+    int gx, gy;
+    do {
+        gx = MAP_MAX_WIDTH - 2 - Random_Sim(12);
+        gy = 40 + Random_Sim(48);
+    } while (!Map_IsPassable(gx, gy));
+    PickGroup(gx, gy);
+
+    // One search per unit
+    auto t0 = BenchClock::now();
+    for (int r = 0; r < REPEATS; r++) {
+        for (const Mover& m : g_group) {
+            g_benchSink = flat::FindPath(m.x, m.y, gx, gy);
+        }
+    }
+    auto t1 = BenchClock::now();
+
+    // One field per order, walked by every unit
+    FlowField_ResetStats();
+    auto t2 = BenchClock::now();
+    for (int r = 0; r < REPEATS; r++) {
+        FlowField_Invalidate();
+        const FlowField* field = FlowField_Get(FLOWFIELD_GROUND, gx, gy);
+        for (const Mover& m : g_group) {
+            g_benchSink = FlowField_Walk(field, m.x, m.y, g_path, FULL_PATH_CELLS, nullptr);
+        }
+    }
+    auto t3 = BenchClock::now();
+    long walked = FlowField_GetStats()->cellsWalked;
+
+    // Repeat orders reuse the cached field
+    FlowField_ResetStats();
+    auto t4 = BenchClock::now();
+    for (int r = 0; r < REPEATS; r++) {
+        const FlowField* field = FlowField_Get(FLOWFIELD_GROUND, gx, gy);
+        for (const Mover& m : g_group) {
+            g_benchSink = FlowField_Walk(field, m.x, m.y, g_path, FULL_PATH_CELLS, nullptr);
+        }
+    }
+    auto t5 = BenchClock::now();
+    FlowFieldStats cached = *FlowField_GetStats();
+
+    auto us = [](BenchClock::time_point a, BenchClock::time_point b) {
+        return std::chrono::duration<double, std::micro>(b - a).count() / REPEATS;
+    };
+    double astar = us(t0, t1), fresh = us(t2, t3), reuse = us(t4, t5);
+    printf("  per-unit A*      %9.1f us per order\n", astar);
+    printf("  flow field       %9.1f us per order  x%.1f  (%.1f cells walked per unit)\n",
+           fresh, fresh > 0 ? astar / fresh : 0.0, (double)walked / (REPEATS * GROUP_SIZE));
+    printf("  cached field     %9.1f us per order  x%.1f  (%u/%u hits, %u builds)\n",
+           reuse, reuse > 0 ? astar / reuse : 0.0, cached.hits, cached.lookups, cached.builds);
+
+    bool ok = cached.builds == 0 && cached.hits == (uint32_t)REPEATS;
+    ok &= CheckRoutes(FlowField_Get(FLOWFIELD_GROUND, gx, gy), gx, gy);
+
+    // Wall off a rock in the middle of the map: the cache must flush and
+    // the rebuilt field still agree with A*
+    FlowField_ResetStats();
+    for (int y = 0; y < MAP_MAX_HEIGHT; y++) {
+        if (Map_IsPassable(64, y) && Random_Sim(2) == 0) Map_SetTerrain(64, y, TERRAIN_ROCK);
+    }
+    PickGroup(gx, gy);
+    const FlowField* field = FlowField_Get(FLOWFIELD_GROUND, gx, gy);
+    const FlowFieldStats* stats = FlowField_GetStats();
+    printf("  terrain change   %u invalidation, %u build\n", stats->invalidations, stats->builds);
+    ok &= stats->invalidations == 1 && stats->builds == 1;
+    ok &= CheckRoutes(field, gx, gy);
+    return ok;
+}
+
+int main() {
+    printf("Red Alert Flow Field Benchmark\n");
+    printf("==============================\n\n");
+
+    Map_Init();
+    Random_Seed(1234);
+
+    BuildWallMap();
+    bool ok = RunGroupMove();
+
+    printf("\n%s\n", ok ? "All routes valid" : "Route check failed");
+    return ok ? 0 : 1;
+}
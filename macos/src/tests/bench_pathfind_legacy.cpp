@@ -0,0 +1,101 @@
+/**
+ * Red Alert macOS Port - PathFinder Benchmark Reference
+ *
+ * The FindPath that predates the generation-stamped scratch: every
+ * per-cell array is refilled and a std::priority_queue rebuilt on each
+ * call. Lives in its own translation unit so it is compiled the same
+ * way pathfind.cpp is, rather than inlined into the benchmark loop.
+ */
+
+#include <cstdlib>
+#include <queue>
+#include <vector>
+#include <algorithm>
+
+#include "game/types.h"
+#include "game/cell.h"
+#include "game/mapclass.h"
+#include "game/pathfind.h"
+
+//===========================================================================
+// Reference Implementation (pre-generation-stamp FindPath)
+//===========================================================================
+
+namespace legacy {
+
+struct Node {
+    CELL cell;
+    int g;
+    int f;
+};
+
+static std::vector<int> gScore(MAP_CELL_TOTAL);
+static std::vector<CELL> cameFrom(MAP_CELL_TOTAL);
+static std::vector<bool> closed(MAP_CELL_TOTAL);
+
+static int Heuristic(CELL from, CELL to) {
+    int dx = std::abs(Cell_X(to) - Cell_X(from));
+    int dy = std::abs(Cell_Y(to) - Cell_Y(from));
+    return std::max(dx, dy) * 10 + std::min(dx, dy) * 4;
+}
+
+static int MoveCost(CELL to, int dir, SpeedType speed) {
+    static const int MOVE_COST[8] = {10, 14, 10, 14, 10, 14, 10, 14};
+    if (!Map.IsValidCell(to)) return MAX_PATH_COST;
+    const CellClass& cell = Map[to];
+    if (!cell.IsPassable(speed)) return MAX_PATH_COST;
+
+    int cost = MOVE_COST[dir];
+    switch (cell.GetLandType()) {
+        case LandType::ROAD:  cost = cost * 8 / 10; break;
+        case LandType::ROUGH: cost = cost * 12 / 10; break;
+        case LandType::BEACH:
+            if (speed != SpeedType::FLOAT) cost = cost * 15 / 10;
+            break;
+        default: break;
+    }
+    if (cell.CellOccupier() != nullptr) cost += 50;
+    return cost;
+}
+
+// Returns path cost, or -1 if no path
+int FindPath(CELL start, CELL target, SpeedType speed) {
+    std::fill(gScore.begin(), gScore.end(), MAX_PATH_COST);
+    std::fill(cameFrom.begin(), cameFrom.end(), static_cast<CELL>(-1));
+    std::fill(closed.begin(), closed.end(), false);
+
+    auto cmp = [](const Node& a, const Node& b) { return a.f > b.f; };
+    std::priority_queue<Node, std::vector<Node>, decltype(cmp)> openSet(cmp);
+
+    gScore[start] = 0;
+    openSet.push({start, 0, Heuristic(start, target)});
+
+    int iterations = 0;
+    while (!openSet.empty() && iterations < MAP_CELL_TOTAL) {
+        iterations++;
+        Node current = openSet.top();
+        openSet.pop();
+
+        if (closed[current.cell]) continue;
+        closed[current.cell] = true;
+        if (current.cell == target) return current.g;
+
+        for (int d = 0; d < 8; d++) {
+            CELL neighbor = Adjacent_Cell(current.cell, static_cast<FacingType>(d));
+            if (neighbor == current.cell || closed[neighbor]) continue;
+
+            int moveCost = MoveCost(neighbor, d, speed);
+            if (moveCost >= MAX_PATH_COST) continue;
+
+            int tentativeG = current.g + moveCost;
+            if (tentativeG >= gScore[neighbor]) continue;
+            gScore[neighbor] = tentativeG;
+            cameFrom[neighbor] = current.cell;
+            openSet.push({neighbor, tentativeG,
+                          tentativeG + Heuristic(neighbor, target)});
+        }
+    }
+    return -1;
+}
+
+} // namespace legacy
@@ -0,0 +1,368 @@
+/**
+ * Red Alert macOS Port - Hierarchical Pathfinding Benchmark
+ *
+ * Compares PathGraph_FindPath against a flat, unbounded A* over the same
+ * map.cpp grid and move costs (the unit pathfinder without its iteration
+ * cap). Reports nodes expanded, time per query and path cost relative to
+ * the optimal flat path, for full routes and for the 32-waypoint prefix
+ * units actually request, and times the units' mix of the two: a short
+ * flat probe, then the graph if the probe runs out. Also times a full graph build against the
+ * incremental repair after a building is placed, and checks the repaired
+ * graph plans the same paths as one rebuilt from scratch.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <vector>
+
+#include "game/map.h"
+#include "game/pathgraph.h"
+#include "game/random.h"
+#include "game/terrain.h"
+#include "graphics/metal/renderer.h"
+
+//===========================================================================
+// Stubs for rendering used by map.cpp
+//===========================================================================
+
+extern "C" {
+void Wwd_Renderer_FillRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_PutPixel(int, int, uint8_t) {}
+void Wwd_Renderer_DrawLine(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_DrawRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_SetAlpha(int, int, int, int, uint8_t) {}
+}
+
+BOOL Terrain_Available(void) { return FALSE; }
+BOOL Terrain_RenderTile(int, int, int, int) { return FALSE; }
+BOOL Terrain_RenderByID(int, int, int, int) { return FALSE; }
+
+//===========================================================================
+// Reference Implementation (flat A*, no iteration cap)
+//===========================================================================
+
+namespace flat {
+
+static const int DIR_DX[8] = { 0,  1, 1, 1, 0, -1, -1, -1 };
+static const int DIR_DY[8] = { -1, -1, 0, 1, 1,  1,  0, -1 };
+static const int DIR_COST[8] = { 10, 14, 10, 14, 10, 14, 10, 14 };
+
+static std::vector<int> gScore;
+static std::vector<bool> closed;
+static std::vector<uint64_t> heap;
+
+static int Heuristic(int x1, int y1, int x2, int y2) {
+    int dx = abs(x2 - x1);
+    int dy = abs(y2 - y1);
+    return (dx > dy) ? dx * 10 + dy * 4 : dy * 10 + dx * 4;
+}
+
+static void Push(uint64_t key) {
+    heap.push_back(key);
+    size_t i = heap.size() - 1;
+    while (i > 0 && heap[(i - 1) / 2] > key) {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap[i] = key;
+}
+
+static uint64_t Pop() {
+    uint64_t top = heap[0];
+    uint64_t last = heap.back();
+    heap.pop_back();
+    size_t n = heap.size(), i = 0;
+    if (n == 0) return top;
+    for (;;) {
+        size_t c = 2 * i + 1;
+        if (c >= n) break;
+        if (c + 1 < n && heap[c + 1] < heap[c]) c++;
+        if (last <= heap[c]) break;
+        heap[i] = heap[c];
+        i = c;
+    }
+    heap[i] = last;
+    return top;
+}
+
+// Returns optimal path cost, -1 if unreachable, or -2 if it expanded
+// more than maxExpanded cells first
+static int FindPath(int sx, int sy, int tx, int ty, int* expanded,
+                    int maxExpanded = INT32_MAX) {
+    int w = Map_GetWidth(), h = Map_GetHeight();
+    gScore.assign(w * h, INT32_MAX);
+    closed.assign(w * h, false);
+    heap.clear();
+
+    int start = sy * w + sx, target = ty * w + tx;
+    gScore[start] = 0;
+    Push((uint64_t)Heuristic(sx, sy, tx, ty) << 32 | (uint32_t)start);
+
+    while (!heap.empty()) {
+        int cell = (int)(Pop() & 0xFFFFFFFF);
+        if (closed[cell]) continue;
+        closed[cell] = true;
+        if ((*expanded)++ >= maxExpanded) return -2;
+        if (cell == target) return gScore[cell];
+
+        int x = cell % w, y = cell / w;
+        for (int d = 0; d < 8; d++) {
+            int nx = x + DIR_DX[d], ny = y + DIR_DY[d];
+            if (!Map_IsPassable(nx, ny)) continue;
+            int n = ny * w + nx;
+            int g = gScore[cell] + DIR_COST[d];
+            if (closed[n] || g >= gScore[n]) continue;
+            gScore[n] = g;
+            Push((uint64_t)(g + Heuristic(nx, ny, tx, ty)) << 32 | (uint32_t)n);
+        }
+    }
+    return -1;
+}
+
+} // namespace flat
+
+//===========================================================================
+// Benchmark Harness
+//===========================================================================
+
+using BenchClock = std::chrono::steady_clock;
+
+static const int QUERY_COUNT = 200;
+static const int FULL_PATH_CELLS = 4096;
+static const int UNIT_PATH_CELLS = 32;
+
+struct Query {
+    int sx, sy, tx, ty;
+    int flatCost;
+};
+
+static std::vector<Query> g_queries;
+static int16_t g_path[FULL_PATH_CELLS];
+
+// Keeps the optimizer from discarding the timed calls
+static volatile int g_benchSink = 0;
+
+static void SetRock(int x, int y) {
+    Map_SetTerrain(x, y, TERRAIN_ROCK);
+}
+
+// Scattered rock over open ground
+static void BuildScatterMap() {
+    Map_Create(MAP_MAX_WIDTH, MAP_MAX_HEIGHT);
+    for (int y = 0; y < MAP_MAX_HEIGHT; y++) {
+        for (int x = 0; x < MAP_MAX_WIDTH; x++) {
+            if (Random_Sim(100) < 25) SetRock(x, y);
+        }
+    }
+}
+
+// Long rock walls with a few gaps, plus light scatter, so routes weave
+static void BuildWallMap() {
+    Map_Create(MAP_MAX_WIDTH, MAP_MAX_HEIGHT);
+    for (int wall = 1; wall < 10; wall++) {
+        int x = wall * 12 + Random_Sim(4);
+        int gapA = Random_Sim(MAP_MAX_HEIGHT - 4);
+        int gapB = Random_Sim(MAP_MAX_HEIGHT - 4);
+        for (int y = 0; y < MAP_MAX_HEIGHT; y++) {
+            if ((y >= gapA && y < gapA + 3) || (y >= gapB && y < gapB + 3)) continue;
+            SetRock(x, y);
+        }
+    }
+    for (int i = 0; i < MAP_MAX_WIDTH * MAP_MAX_HEIGHT / 10; i++) {
+        SetRock(Random_Sim(MAP_MAX_WIDTH), Random_Sim(MAP_MAX_HEIGHT));
+    }
+}
+
+// Reachable long-path pairs, with their optimal cost
+static void PickQueries() {
+    g_queries.clear();
+    while ((int)g_queries.size() < QUERY_COUNT) {
+        Query q;
+        q.sx = Random_Sim(MAP_MAX_WIDTH);
+        q.sy = Random_Sim(MAP_MAX_HEIGHT);
+        q.tx = Random_Sim(MAP_MAX_WIDTH);
+        q.ty = Random_Sim(MAP_MAX_HEIGHT);
+        if (!Map_IsPassable(q.sx, q.sy) || !Map_IsPassable(q.tx, q.ty)) continue;
+        if (!PathGraph_IsLongPath(q.sx, q.sy, q.tx, q.ty)) continue;
+        int expanded = 0;
+        q.flatCost = flat::FindPath(q.sx, q.sy, q.tx, q.ty, &expanded);
+        if (q.flatCost > 0) g_queries.push_back(q);
+    }
+}
+
+// Cost of a returned path; -1 if it takes an illegal step
+static int PathCost(int sx, int sy, const int16_t* cells, int count) {
+    int w = Map_GetWidth();
+    int x = sx, y = sy, cost = 0;
+    for (int i = 0; i < count; i++) {
+        int nx = cells[i] % w, ny = cells[i] / w;
+        int dx = abs(nx - x), dy = abs(ny - y);
+        if (dx > 1 || dy > 1 || (dx == 0 && dy == 0)) return -1;
+        if (!Map_IsPassable(nx, ny)) return -1;
+        cost += (dx && dy) ? 14 : 10;
+        x = nx;
+        y = ny;
+    }
+    return cost;
+}
+
+static bool RunMap(const char* name) {
+    PickQueries();
+    bool ok = true;
+
+    // Flat search: expansions and time
+    long flatExpanded = 0;
+    auto t0 = BenchClock::now();
+    for (const Query& q : g_queries) {
+        int expanded = 0;
+        g_benchSink = flat::FindPath(q.sx, q.sy, q.tx, q.ty, &expanded);
+        flatExpanded += expanded;
+    }
+    auto t1 = BenchClock::now();
+
+    // Build the graph outside the timed loops
+    PathGraph_Invalidate();
+    PathGraph_FindPath(PATHGRAPH_GROUND, g_queries[0].sx, g_queries[0].sy,
+                       g_queries[0].tx, g_queries[0].ty, g_path, 1, nullptr);
+
+    // Full hierarchical routes: validity and cost
+    PathGraph_ResetStats();
+    long hierCost = 0, optimalCost = 0;
+    int fallbacks = 0;
+    auto t2 = BenchClock::now();
+    for (const Query& q : g_queries) {
+        BOOL partial = FALSE;
+        int count = PathGraph_FindPath(PATHGRAPH_GROUND, q.sx, q.sy, q.tx, q.ty,
+                                       g_path, FULL_PATH_CELLS, &partial);
+        if (count < 0) {
+            fallbacks++;        // Units fall back to the flat search
+            continue;
+        }
+        int cost = PathCost(q.sx, q.sy, g_path, count);
+        if (cost < 0 || partial) {
+            printf("  %-8s INVALID path (%d,%d)->(%d,%d)\n",
+                   name, q.sx, q.sy, q.tx, q.ty);
+            ok = false;
+            continue;
+        }
+        hierCost += cost;
+        optimalCost += q.flatCost;
+    }
+    auto t3 = BenchClock::now();
+    PathGraphStats full = *PathGraph_GetStats();
+
+    // 32-waypoint prefix, as units request it
+    PathGraph_ResetStats();
+    auto t4 = BenchClock::now();
+    for (const Query& q : g_queries) {
+        BOOL partial = FALSE;
+        g_benchSink = PathGraph_FindPath(PATHGRAPH_GROUND, q.sx, q.sy, q.tx, q.ty,
+                                         g_path, UNIT_PATH_CELLS, &partial);
+    }
+    auto t5 = BenchClock::now();
+    PathGraphStats prefix = *PathGraph_GetStats();
+
+    // What units do: a flat probe first unless the trip is far, the graph
+    // once the probe runs out
+    int toGraph = 0;
+    auto t6 = BenchClock::now();
+    for (const Query& q : g_queries) {
+        int budget = PathGraph_ProbeBudget(q.sx, q.sy, q.tx, q.ty);
+        int expanded = 0;
+        int cost = (budget > 0) ? flat::FindPath(q.sx, q.sy, q.tx, q.ty, &expanded, budget) : -2;
+        if (cost == -2) {
+            BOOL partial = FALSE;
+            cost = PathGraph_FindPath(PATHGRAPH_GROUND, q.sx, q.sy, q.tx, q.ty,
+                                      g_path, UNIT_PATH_CELLS, &partial);
+            toGraph++;
+        }
+        g_benchSink = cost;
+    }
+    auto t7 = BenchClock::now();
+
+    int n = (int)g_queries.size();
+    auto us = [n](BenchClock::time_point a, BenchClock::time_point b) {
+        return std::chrono::duration<double, std::micro>(b - a).count() / n;
+    };
+    printf("  %-8s flat      %8.1f nodes  %8.2f us\n",
+           name, (double)flatExpanded / n, us(t0, t1));
+    printf("  %-8s graph     %8.1f nodes  %8.2f us  cost x%.3f  (%d fallbacks)\n",
+           name, (double)(full.abstractExpanded + full.cellsExpanded) / n, us(t2, t3),
+           optimalCost > 0 ? (double)hierCost / optimalCost : 0.0, fallbacks);
+    printf("  %-8s graph/32  %8.1f nodes  %8.2f us\n",
+           name, (double)(prefix.abstractExpanded + prefix.cellsExpanded) / n, us(t4, t5));
+    printf("  %-8s gated                   %8.2f us  (%d of %d to graph)\n",
+           name, us(t6, t7), toGraph, n);
+    return ok;
+}
+
+// Place a 3x3 building, then check the repaired graph plans exactly the
+// paths a freshly built one does
+static bool RunRepair() {
+    const int REPEATS = 20;
+    double rebuildUs = 0.0, repairUs = 0.0;
+    bool ok = true;
+
+    for (int r = 0; r < REPEATS && ok; r++) {
+        int bx = 8 + Random_Sim(MAP_MAX_WIDTH - 16);
+        int by = 8 + Random_Sim(MAP_MAX_HEIGHT - 16);
+        const Query& q = g_queries[r % g_queries.size()];
+
+        PathGraph_Invalidate();
+        auto t0 = BenchClock::now();
+        PathGraph_FindPath(PATHGRAPH_GROUND, q.sx, q.sy, q.tx, q.ty, g_path, 1, nullptr);
+        auto t1 = BenchClock::now();
+        rebuildUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+
+        for (int y = by; y < by + 3; y++) {
+            for (int x = bx; x < bx + 3; x++) {
+                if (Map_IsPassable(x, y)) Map_SetTerrain(x, y, TERRAIN_BUILDING);
+            }
+        }
+        t0 = BenchClock::now();
+        PathGraph_FindPath(PATHGRAPH_GROUND, q.sx, q.sy, q.tx, q.ty, g_path, 1, nullptr);
+        t1 = BenchClock::now();
+        repairUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+
+        static int16_t repaired[FULL_PATH_CELLS];
+        for (int i = 0; i < 8; i++) {
+            const Query& check = g_queries[(r * 8 + i) % g_queries.size()];
+            if (!Map_IsPassable(check.sx, check.sy) || !Map_IsPassable(check.tx, check.ty)) continue;
+            int a = PathGraph_FindPath(PATHGRAPH_GROUND, check.sx, check.sy, check.tx, check.ty,
+                                       repaired, FULL_PATH_CELLS, nullptr);
+            PathGraph_Invalidate();
+            int b = PathGraph_FindPath(PATHGRAPH_GROUND, check.sx, check.sy, check.tx, check.ty,
+                                       g_path, FULL_PATH_CELLS, nullptr);
+            if (a != b || (a > 0 && memcmp(repaired, g_path, a * sizeof(int16_t)) != 0)) {
+                printf("  repair MISMATCH after building at (%d,%d)\n", bx, by);
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    const PathGraphStats* stats = PathGraph_GetStats();
+    printf("  repair   full build %8.2f us  repair %8.2f us  (%u sectors rebuilt total)\n",
+           rebuildUs / REPEATS, repairUs / REPEATS, stats->sectorsRebuilt);
+    return ok;
+}
+
+int main() {
+    printf("Red Alert Hierarchical Pathfinding Benchmark\n");
+    printf("============================================\n\n");
+
+    Map_Init();
+    Random_Seed(1234);
+
+    bool ok = true;
+    BuildScatterMap();
+    ok &= RunMap("scatter");
+    BuildWallMap();
+    ok &= RunMap("walls");
+    ok &= RunRepair();
+
+    printf("\n%s\n", ok ? "All paths valid" : "Path check failed");
+    return ok ? 0 : 1;
+}
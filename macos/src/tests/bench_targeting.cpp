@@ -0,0 +1,221 @@
+/**
+ * Red Alert macOS Port - Target Acquisition Benchmark
+ *
+ * Simulates the per-tick targeting pass (every unit looks for the nearest
+ * enemy in weapon range while the armies drift around the map) at unit
+ * counts well past the game's 256-unit cap. The brute-force scan is
+ * O(N^2) per tick; the spatial hash only visits nearby blocks, so its
+ * per-tick cost should grow close to linearly. Both must pick the same
+ * targets.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+
+#include "game/spatial.h"
+
+//===========================================================================
+// Simulated Units
+//===========================================================================
+
+struct BenchUnit {
+    int x;
+    int y;
+    int vx;
+    int vy;
+    int team;
+};
+
+constexpr int WORLD_SIZE = 128 * SPATIAL_CELL_SIZE;
+constexpr int TARGET_RANGE = 192;       // 8 cells, typical attackRange * 2
+constexpr int TICKS = 20;
+
+// Keeps the optimizer from discarding the timed calls
+static volatile int g_benchSink = 0;
+
+static uint32_t g_rngState = 12345;
+static int BenchRand(int range) {
+    g_rngState = g_rngState * 1103515245u + 12345u;
+    return (int)((g_rngState >> 8) % (uint32_t)range);
+}
+
+static void SpawnUnits(std::vector<BenchUnit>& units, int count) {
+    units.resize(count);
+    for (int i = 0; i < count; i++) {
+        BenchUnit& u = units[i];
+        u.x = BenchRand(WORLD_SIZE);
+        u.y = BenchRand(WORLD_SIZE);
+        u.vx = BenchRand(7) - 3;
+        u.vy = BenchRand(7) - 3;
+        u.team = 1 + (i & 1);
+    }
+}
+
+static void StepUnits(std::vector<BenchUnit>& units, SpatialHash* hash) {
+    for (int i = 0; i < (int)units.size(); i++) {
+        BenchUnit& u = units[i];
+        u.x += u.vx;
+        u.y += u.vy;
+        if (u.x < 0 || u.x >= WORLD_SIZE) { u.vx = -u.vx; u.x += 2 * u.vx; }
+        if (u.y < 0 || u.y >= WORLD_SIZE) { u.vy = -u.vy; u.y += 2 * u.vy; }
+        if (hash) hash->Move(i, u.x, u.y);
+    }
+}
+
+// Reference: full scan, squared distances, ties to the lowest id
+static int BruteNearestEnemy(const std::vector<BenchUnit>& units, int self) {
+    const BenchUnit& me = units[self];
+    int limitSq = TARGET_RANGE * TARGET_RANGE;
+    int best = -1;
+    int bestDist = limitSq;
+    for (int i = 0; i < (int)units.size(); i++) {
+        const BenchUnit& t = units[i];
+        if (t.team == me.team) continue;
+        int dx = t.x - me.x;
+        int dy = t.y - me.y;
+        int d = dx * dx + dy * dy;
+        if (d < bestDist) {
+            bestDist = d;
+            best = i;
+        }
+    }
+    return best;
+}
+
+static int BruteCountInRange(const std::vector<BenchUnit>& units, int self,
+                             const std::vector<bool>& present) {
+    const BenchUnit& me = units[self];
+    int count = 0;
+    for (int i = 0; i < (int)units.size(); i++) {
+        if (!present[i]) continue;
+        int dx = units[i].x - me.x;
+        int dy = units[i].y - me.y;
+        if (dx * dx + dy * dy < TARGET_RANGE * TARGET_RANGE) count++;
+    }
+    return count;
+}
+
+static int HashNearestEnemy(const SpatialHash& hash,
+                            const std::vector<BenchUnit>& units, int self) {
+    const BenchUnit& me = units[self];
+    uint32_t enemyMask = SPATIAL_TEAM_BIT(me.team == 1 ? 2 : 1);
+    return hash.FindNearest(me.x, me.y, TARGET_RANGE, enemyMask);
+}
+
+//===========================================================================
+// Benchmark Harness
+//===========================================================================
+
+using BenchClock = std::chrono::steady_clock;
+
+static bool RunCount(int count, double* bruteUs, double* hashUs) {
+    std::vector<BenchUnit> units;
+
+    // Correctness pass: both searches must agree on every tick
+    g_rngState = 12345;
+    SpawnUnits(units, count);
+    SpatialHash hash(count);
+    for (int i = 0; i < count; i++) {
+        hash.Insert(i, units[i].team, units[i].x, units[i].y);
+    }
+    for (int tick = 0; tick < 3; tick++) {
+        StepUnits(units, &hash);
+        for (int i = 0; i < count; i++) {
+            int expect = BruteNearestEnemy(units, i);
+            int got = HashNearestEnemy(hash, units, i);
+            if (expect != got) {
+                printf("  %5d units: MISMATCH unit %d tick %d (%d vs %d)\n",
+                       count, i, tick, got, expect);
+                return false;
+            }
+        }
+    }
+
+    // Radius queries must see exactly the units still registered
+    std::vector<bool> present(count, true);
+    for (int i = 0; i < count; i += 3) {
+        hash.Remove(i);
+        present[i] = false;
+    }
+    std::vector<int> ids(count);
+    for (int i = 0; i < count; i++) {
+        int got = hash.QueryRadius(units[i].x, units[i].y, TARGET_RANGE,
+                                   SPATIAL_TEAM_BIT(1) | SPATIAL_TEAM_BIT(2),
+                                   ids.data(), count);
+        if (got != BruteCountInRange(units, i, present)) {
+            printf("  %5d units: RADIUS MISMATCH unit %d\n", count, i);
+            return false;
+        }
+    }
+
+    // Brute-force timing
+    g_rngState = 12345;
+    SpawnUnits(units, count);
+    int sink = 0;
+    auto t0 = BenchClock::now();
+    for (int tick = 0; tick < TICKS; tick++) {
+        StepUnits(units, nullptr);
+        for (int i = 0; i < count; i++) {
+            sink += BruteNearestEnemy(units, i);
+        }
+    }
+    auto t1 = BenchClock::now();
+
+    // Spatial hash timing (includes incremental position updates)
+    g_rngState = 12345;
+    SpawnUnits(units, count);
+    hash.Clear();
+    for (int i = 0; i < count; i++) {
+        hash.Insert(i, units[i].team, units[i].x, units[i].y);
+    }
+    auto t2 = BenchClock::now();
+    for (int tick = 0; tick < TICKS; tick++) {
+        StepUnits(units, &hash);
+        for (int i = 0; i < count; i++) {
+            sink += HashNearestEnemy(hash, units, i);
+        }
+    }
+    auto t3 = BenchClock::now();
+    g_benchSink = sink;
+
+    *bruteUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / TICKS;
+    *hashUs = std::chrono::duration<double, std::micro>(t3 - t2).count() / TICKS;
+    return true;
+}
+
+int main() {
+    printf("Red Alert Target Acquisition Benchmark\n");
+    printf("======================================\n\n");
+    printf("  per-tick nearest-enemy pass, range %d px, %d ticks\n\n",
+           TARGET_RANGE, TICKS);
+    printf("  %6s  %12s  %12s  %8s  %8s\n",
+           "units", "brute us", "hash us", "brute x", "hash x");
+
+    static const int kCounts[] = {64, 128, 256, 512, 1024, 2048, 4096};
+    double prevBrute = 0.0, prevHash = 0.0;
+    bool ok = true;
+
+    for (int count : kCounts) {
+        double bruteUs = 0.0, hashUs = 0.0;
+        if (!RunCount(count, &bruteUs, &hashUs)) {
+            ok = false;
+            continue;
+        }
+
+        // Growth factor per doubling of the unit count (4.0 = quadratic)
+        if (prevBrute > 0.0 && prevHash > 0.0) {
+            printf("  %6d  %12.1f  %12.1f  %8.2f  %8.2f\n", count,
+                   bruteUs, hashUs, bruteUs / prevBrute, hashUs / prevHash);
+        } else {
+            printf("  %6d  %12.1f  %12.1f  %8s  %8s\n", count,
+                   bruteUs, hashUs, "-", "-");
+        }
+        prevBrute = bruteUs;
+        prevHash = hashUs;
+    }
+
+    printf("\n%s\n", ok ? "All targets match reference" : "Reference mismatch");
+    return ok ? 0 : 1;
+}
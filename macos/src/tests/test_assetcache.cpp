@@ -0,0 +1,348 @@
+/**
+ * Red Alert macOS Port - Asset Cache Tests
+ *
+ * Drives the cache with a counting fake loader: assets load once on first
+ * use, missing ones aren't retried, retained ones survive eviction, and
+ * unreferenced ones are dropped least recently used first to stay in
+ * budget. With background workers, hints publish on update and racing
+ * requests for an asset a worker is decoding still decode it once.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "assets/assetcache.h"
+
+// Simple test framework
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    int failedBefore = g_testsFailed; \
+    printf("  %s... ", #name); \
+    test_##name(); \
+    if (g_testsFailed == failedBefore) { \
+        printf("OK\n"); \
+        g_testsPassed++; \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) do { \
+    if ((a) != (b)) { \
+        printf("FAILED at line %d: %s != %s (%d vs %d)\n", \
+               __LINE__, #a, #b, (int)(a), (int)(b)); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+//===========================================================================
+// Fake Loader
+//===========================================================================
+
+static const uint32_t ASSET_BYTES = 1000;
+
+struct FakeAsset {
+    std::string name;
+};
+
+// Loads may run on worker threads
+static std::atomic<int> g_loadCalls{ 0 };
+static std::atomic<int> g_loadDelayMicros{ 0 };
+static int g_unloadCalls = 0;
+static std::vector<std::string> g_unloaded;
+
+// Names starting with "NO" don't exist
+static void* FakeLoad(const char* name) {
+    g_loadCalls++;
+    if (g_loadDelayMicros > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(g_loadDelayMicros.load()));
+    }
+    if (strncmp(name, "NO", 2) == 0) return nullptr;
+    return new FakeAsset{ name };
+}
+
+static void FakeUnload(void* data) {
+    FakeAsset* asset = static_cast<FakeAsset*>(data);
+    g_unloadCalls++;
+    g_unloaded.push_back(asset->name);
+    delete asset;
+}
+
+static uint32_t FakeSize(const void*) {
+    return ASSET_BYTES;
+}
+
+static void Reset(uint32_t budget) {
+    AssetCache_Shutdown();
+    AssetLoader loader = { FakeLoad, FakeUnload, FakeSize };
+    AssetCache_SetLoader(ASSET_SHP, &loader);
+    AssetCache_SetBudget(budget);
+    AssetCache_ResetStats();
+    g_loadCalls = 0;
+    g_loadDelayMicros = 0;
+    g_unloadCalls = 0;
+    g_unloaded.clear();
+}
+
+static const char* NameOf(void* data) {
+    return data ? static_cast<FakeAsset*>(data)->name.c_str() : "";
+}
+
+//===========================================================================
+// Tests
+//===========================================================================
+
+TEST(find_registers_without_loading) {
+    Reset(ASSETCACHE_DEFAULT_BUDGET);
+    AssetHandle a = AssetCache_Find(ASSET_SHP, "1TNK.SHP");
+    AssetHandle b = AssetCache_Find(ASSET_SHP, "E1.SHP");
+    ASSERT(a != ASSET_NONE && b != ASSET_NONE && a != b);
+    ASSERT_EQ(AssetCache_Find(ASSET_SHP, "1TNK.SHP"), a);
+    ASSERT(AssetCache_Find(ASSET_TMP, "1TNK.SHP") != a);    // Kinds don't share names
+    ASSERT_EQ(AssetCache_Find(ASSET_SHP, ""), ASSET_NONE);
+    ASSERT_EQ(g_loadCalls, 0);
+}
+
+TEST(loads_once_on_first_use) {
+    Reset(ASSETCACHE_DEFAULT_BUDGET);
+    AssetHandle tank = AssetCache_Find(ASSET_SHP, "1TNK.SHP");
+    void* first = AssetCache_Get(tank);
+    ASSERT(strcmp(NameOf(first), "1TNK.SHP") == 0);
+    for (int i = 0; i < 5; i++) {
+        ASSERT(AssetCache_Get(tank) == first);
+    }
+    ASSERT_EQ(g_loadCalls, 1);
+
+    const AssetCacheStats* stats = AssetCache_GetStats();
+    ASSERT_EQ(stats->lookups, 6);
+    ASSERT_EQ(stats->hits, 5);
+    ASSERT_EQ(stats->loads, 1);
+    ASSERT_EQ(stats->resident, 1);
+    ASSERT_EQ(stats->bytes, ASSET_BYTES);
+}
+
+TEST(missing_assets_are_not_retried) {
+    Reset(ASSETCACHE_DEFAULT_BUDGET);
+    AssetHandle gone = AssetCache_Find(ASSET_SHP, "NOPE.SHP");
+    ASSERT(AssetCache_Get(gone) == nullptr);
+    ASSERT(AssetCache_Get(gone) == nullptr);
+    ASSERT_EQ(g_loadCalls, 1);
+    ASSERT_EQ(AssetCache_GetStats()->failures, 1);
+
+    // A new loader gets another chance at it
+    AssetLoader loader = { FakeLoad, FakeUnload, FakeSize };
+    AssetCache_SetLoader(ASSET_SHP, &loader);
+    AssetCache_Get(gone);
+    ASSERT_EQ(g_loadCalls, 2);
+}
+
+TEST(evicts_least_recently_used) {
+    Reset(ASSET_BYTES * 3);
+    AssetHandle h[4];
+    const char* names[4] = { "A.SHP", "B.SHP", "C.SHP", "D.SHP" };
+    for (int i = 0; i < 4; i++) h[i] = AssetCache_Find(ASSET_SHP, names[i]);
+
+    AssetCache_Get(h[0]);
+    AssetCache_Get(h[1]);
+    AssetCache_Get(h[2]);
+    AssetCache_Get(h[0]);           // B is now the oldest
+    AssetCache_Get(h[3]);
+
+    ASSERT_EQ(g_unloadCalls, 1);
+    ASSERT(g_unloaded[0] == "B.SHP");
+    ASSERT_EQ(AssetCache_GetStats()->bytes, ASSET_BYTES * 3);
+    ASSERT_EQ(AssetCache_GetStats()->evictions, 1);
+
+    // B comes back on demand, pushing out C
+    ASSERT(strcmp(NameOf(AssetCache_Get(h[1])), "B.SHP") == 0);
+    ASSERT(g_unloaded[1] == "C.SHP");
+    ASSERT_EQ(g_loadCalls, 5);
+}
+
+TEST(retained_assets_stay_resident) {
+    Reset(ASSET_BYTES * 2);
+    AssetHandle keep = AssetCache_Find(ASSET_SHP, "FACT.SHP");
+    AssetCache_Retain(keep);
+    AssetCache_Retain(keep);
+    void* pinned = AssetCache_Get(keep);
+
+    // Cycle many others through the one free slot
+    char name[16];
+    for (int i = 0; i < 10; i++) {
+        snprintf(name, sizeof(name), "T%d.SHP", i);
+        AssetCache_Get(AssetCache_Find(ASSET_SHP, name));
+    }
+    ASSERT(AssetCache_Get(keep) == pinned);
+    ASSERT_EQ(AssetCache_GetStats()->bytes, ASSET_BYTES * 2);
+
+    // Over budget only while everything is retained
+    AssetHandle other = AssetCache_Find(ASSET_SHP, "WEAP.SHP");
+    AssetCache_Retain(other);
+    AssetCache_SetBudget(ASSET_BYTES);
+    ASSERT_EQ(AssetCache_GetStats()->resident, 2);
+
+    // References count: one release still leaves it pinned
+    AssetCache_Release(keep);
+    ASSERT_EQ(AssetCache_GetStats()->resident, 2);
+    AssetCache_Release(keep);
+    ASSERT_EQ(AssetCache_GetStats()->resident, 1);
+    ASSERT(g_unloaded.back() == "FACT.SHP");
+    AssetCache_Release(other);
+}
+
+TEST(flush_spares_retained_and_other_kinds) {
+    Reset(ASSETCACHE_DEFAULT_BUDGET);
+    AssetLoader loader = { FakeLoad, FakeUnload, FakeSize };
+    AssetCache_SetLoader(ASSET_TMP, &loader);
+
+    AssetHandle held = AssetCache_Find(ASSET_SHP, "HELD.SHP");
+    AssetHandle loose = AssetCache_Find(ASSET_SHP, "LOOSE.SHP");
+    AssetHandle tile = AssetCache_Find(ASSET_TMP, "clear1.sno");
+    AssetCache_Retain(held);
+    AssetCache_Get(loose);
+    AssetCache_Get(tile);
+
+    AssetCache_Flush(ASSET_SHP);
+    ASSERT_EQ(g_unloadCalls, 1);
+    ASSERT(g_unloaded[0] == "LOOSE.SHP");
+    ASSERT_EQ(AssetCache_GetStats()->resident, 2);
+
+    AssetCache_Shutdown();
+    ASSERT_EQ(g_unloadCalls, 3);
+    ASSERT_EQ(AssetCache_GetStats()->resident, 0);
+    ASSERT_EQ(AssetCache_GetStats()->bytes, 0);
+}
+
+TEST(hints_publish_on_update) {
+    Reset(ASSETCACHE_DEFAULT_BUDGET);
+    ASSERT(AssetCache_StartWorkers(ASSETCACHE_DEFAULT_WORKERS));
+    ASSERT(!AssetCache_StartWorkers(1));
+
+    AssetHandle h[8];
+    char name[16];
+    for (int i = 0; i < 8; i++) {
+        snprintf(name, sizeof(name), "H%d.SHP", i);
+        h[i] = AssetCache_Find(ASSET_SHP, name);
+        AssetCache_Hint(h[i]);
+        AssetCache_Hint(h[i]);          // Already queued: ignored
+    }
+    ASSERT_EQ(AssetCache_GetStats()->hints, 8);
+
+    for (int spins = 0; spins < 2000 && AssetCache_GetStats()->resident < 8; spins++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        AssetCache_Update();
+    }
+    ASSERT_EQ(AssetCache_GetStats()->resident, 8);
+    ASSERT_EQ(AssetCache_GetStats()->backgroundLoads, 8);
+
+    // Resident now: plain hits, no more decodes
+    for (int i = 0; i < 8; i++) {
+        AssetCache_Hint(h[i]);
+        ASSERT(AssetCache_Get(h[i]) != nullptr);
+    }
+    ASSERT_EQ(AssetCache_GetStats()->hits, 8);
+    ASSERT_EQ(g_loadCalls, 8);
+    AssetCache_StopWorkers();
+}
+
+TEST(racing_requests_decode_once) {
+    Reset(ASSETCACHE_DEFAULT_BUDGET);
+    AssetCache_StartWorkers(4);
+    g_loadDelayMicros = 300;
+
+    // Hints from several sources, a scenario retain and a draw, with the
+    // draw landing before, during or after the worker's decode
+    const int rounds = 60;
+    char name[16];
+    for (int i = 0; i < rounds; i++) {
+        snprintf(name, sizeof(name), "R%d.SHP", i);
+        AssetHandle handle = AssetCache_Find(ASSET_SHP, name);
+        for (int k = 0; k < 4; k++) AssetCache_Hint(handle);
+        AssetCache_Retain(handle);
+        std::this_thread::sleep_for(std::chrono::microseconds((i % 4) * 150));
+        void* data = AssetCache_Get(handle);
+        ASSERT(strcmp(NameOf(data), name) == 0);
+        AssetCache_Hint(handle);
+        ASSERT(AssetCache_Get(handle) == data);
+        AssetCache_Release(handle);
+    }
+
+    // Missing assets too: one failed decode each, never retried
+    AssetHandle gone = AssetCache_Find(ASSET_SHP, "NONE.SHP");
+    AssetCache_Hint(gone);
+    ASSERT(AssetCache_Get(gone) == nullptr);
+    AssetCache_Hint(gone);
+    ASSERT(AssetCache_Get(gone) == nullptr);
+
+    AssetCache_Settle();
+    ASSERT_EQ(g_loadCalls, rounds + 1);
+    ASSERT_EQ(AssetCache_GetStats()->loads, rounds);
+    ASSERT_EQ(AssetCache_GetStats()->failures, 1);
+    ASSERT_EQ(AssetCache_GetStats()->resident, rounds);
+    AssetCache_StopWorkers();
+}
+
+TEST(stopping_workers_drops_queued_hints) {
+    Reset(ASSETCACHE_DEFAULT_BUDGET);
+    AssetCache_StartWorkers(1);
+    g_loadDelayMicros = 2000;
+
+    AssetHandle h[6];
+    char name[16];
+    for (int i = 0; i < 6; i++) {
+        snprintf(name, sizeof(name), "Q%d.SHP", i);
+        h[i] = AssetCache_Find(ASSET_SHP, name);
+        AssetCache_Hint(h[i]);
+    }
+    AssetCache_StopWorkers();
+    uint32_t decoded = (uint32_t)g_loadCalls;
+    ASSERT(decoded < 6u);
+    ASSERT_EQ(AssetCache_GetStats()->resident, decoded);
+
+    // Dropped hints still load on demand, once
+    g_loadDelayMicros = 0;
+    for (int i = 0; i < 6; i++) {
+        ASSERT(AssetCache_Get(h[i]) != nullptr);
+    }
+    ASSERT_EQ(g_loadCalls, 6);
+}
+
+//===========================================================================
+// Main
+//===========================================================================
+
+int main() {
+    printf("Red Alert Asset Cache Tests\n");
+    printf("===========================\n\n");
+
+    RUN_TEST(find_registers_without_loading);
+    RUN_TEST(loads_once_on_first_use);
+    RUN_TEST(missing_assets_are_not_retried);
+    RUN_TEST(evicts_least_recently_used);
+    RUN_TEST(retained_assets_stay_resident);
+    RUN_TEST(flush_spares_retained_and_other_kinds);
+    RUN_TEST(hints_publish_on_update);
+    RUN_TEST(racing_requests_decode_once);
+    RUN_TEST(stopping_workers_drops_queued_hints);
+
+    AssetCache_Shutdown();
+
+    printf("\nResults: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
+    return g_testsFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,266 @@
+/**
+ * Red Alert macOS Port - Asset Index Tests
+ *
+ * Mounts fake archives (just lists of CRCs) and checks the merged index
+ * finds files with the same precedence as the per-archive search it
+ * replaces: the first archive in the caller's order wins, unopened
+ * archives are skipped, and a search can continue past an earlier hit.
+ * Also checks filename CRCs are computed once and that loose override
+ * directories are scanned at mount, the first directory winning, and
+ * that loose names match regardless of case.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "assets/assetindex.h"
+
+// Simple test framework
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    int failedBefore = g_testsFailed; \
+    printf("  %s... ", #name); \
+    test_##name(); \
+    if (g_testsFailed == failedBefore) { \
+        printf("OK\n"); \
+        g_testsPassed++; \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) do { \
+    if ((a) != (b)) { \
+        printf("FAILED at line %d: %s != %s (%d vs %d)\n", \
+               __LINE__, #a, #b, (int)(a), (int)(b)); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+//===========================================================================
+// Fake Archives
+//===========================================================================
+
+struct MixFile {
+    std::vector<uint32_t> crcs;
+};
+
+static int g_crcCalls = 0;
+
+// Stand-in for the real filename hash; only needs to be stable
+uint32_t Mix_CalculateCRC(const char* name) {
+    g_crcCalls++;
+    uint32_t h = 2166136261u;
+    for (; *name; name++) h = (h ^ (uint8_t)*name) * 16777619u;
+    return h;
+}
+
+int Mix_GetFileCount(MixFileHandle mix) {
+    return mix ? (int)mix->crcs.size() : 0;
+}
+
+BOOL Mix_GetEntryByIndex(MixFileHandle mix, int index,
+                         uint32_t* outCRC, uint32_t* outSize) {
+    if (!mix || index < 0 || index >= (int)mix->crcs.size()) return FALSE;
+    if (outCRC) *outCRC = mix->crcs[index];
+    if (outSize) *outSize = 0;
+    return TRUE;
+}
+
+static MixFile MakeArchive(std::initializer_list<const char*> names) {
+    MixFile mix;
+    for (const char* name : names) mix.crcs.push_back(Mix_CalculateCRC(name));
+    return mix;
+}
+
+//===========================================================================
+// Tests
+//===========================================================================
+
+TEST(first_archive_in_order_wins) {
+    MixFile conquer = MakeArchive({ "E1.SHP", "1TNK.SHP" });
+    MixFile hires = MakeArchive({ "PIPS.SHP", "E1.SHP" });
+    AssetIndex_Reset();
+    AssetIndex_AddArchive(&hires);
+    AssetIndex_AddArchive(&conquer);
+
+    // Mount order doesn't matter, the caller's order does
+    MixFileHandle order[] = { &conquer, &hires };
+    AssetLocation where;
+    ASSERT(AssetIndex_Locate("E1.SHP", order, 2, 0, &where));
+    ASSERT(where.mix == &conquer);
+    ASSERT_EQ(where.entry, 0);
+    ASSERT_EQ(where.position, 0);
+
+    ASSERT(AssetIndex_Locate("PIPS.SHP", order, 2, 0, &where));
+    ASSERT(where.mix == &hires);
+    ASSERT_EQ(where.entry, 0);
+    ASSERT_EQ(where.position, 1);
+
+    MixFileHandle reversed[] = { &hires, &conquer };
+    ASSERT(AssetIndex_Locate("E1.SHP", reversed, 2, 0, &where));
+    ASSERT(where.mix == &hires);
+    ASSERT_EQ(where.entry, 1);
+
+    ASSERT(!AssetIndex_Locate("MISSING.SHP", order, 2, 0, &where));
+}
+
+TEST(only_searches_the_given_archives) {
+    MixFile sounds = MakeArchive({ "CHRONO2.AUD" });
+    MixFile local = MakeArchive({ "TEMPERAT.PAL" });
+    AssetIndex_Reset();
+    AssetIndex_AddArchive(&sounds);
+    AssetIndex_AddArchive(&local);
+
+    MixFileHandle order[] = { &local };
+    ASSERT(!AssetIndex_Locate("CHRONO2.AUD", order, 1, 0, nullptr));
+    ASSERT(AssetIndex_Locate("TEMPERAT.PAL", order, 1, 0, nullptr));
+}
+
+TEST(unopened_archives_are_skipped) {
+    MixFile main = MakeArchive({ "SCG01EA.INI" });
+    AssetIndex_Reset();
+    AssetIndex_AddArchive(nullptr);
+    AssetIndex_AddArchive(&main);
+
+    // A missing archive early in the order doesn't end the search
+    MixFileHandle order[] = { nullptr, nullptr, &main };
+    AssetLocation where;
+    ASSERT(AssetIndex_Locate("SCG01EA.INI", order, 3, 0, &where));
+    ASSERT(where.mix == &main);
+    ASSERT_EQ(where.position, 2);
+}
+
+TEST(search_continues_past_earlier_hit) {
+    MixFile local = MakeArchive({ "SNOW.PAL" });
+    MixFile main = MakeArchive({ "OTHER.PAL", "SNOW.PAL" });
+    MixFile redalert = MakeArchive({ "SNOW.PAL" });
+    AssetIndex_Reset();
+    AssetIndex_AddArchive(&local);
+    AssetIndex_AddArchive(&main);
+    AssetIndex_AddArchive(&redalert);
+    AssetIndex_AddArchive(&main);       // Mounting twice is harmless
+
+    MixFileHandle order[] = { &local, &main, &redalert };
+    std::vector<MixFileHandle> found;
+    AssetLocation where;
+    int from = 0;
+    while (AssetIndex_Locate("SNOW.PAL", order, 3, from, &where)) {
+        found.push_back(where.mix);
+        from = where.position + 1;
+    }
+    ASSERT_EQ((int)found.size(), 3);
+    ASSERT(found[0] == &local);
+    ASSERT(found[1] == &main);
+    ASSERT(found[2] == &redalert);
+}
+
+TEST(names_are_hashed_once) {
+    MixFile conquer = MakeArchive({ "JEEP.SHP" });
+    AssetIndex_Reset();
+    AssetIndex_AddArchive(&conquer);
+
+    MixFileHandle order[] = { &conquer };
+    g_crcCalls = 0;
+    for (int i = 0; i < 100; i++) {
+        ASSERT(AssetIndex_Locate("JEEP.SHP", order, 1, 0, nullptr));
+        ASSERT(!AssetIndex_Locate("NOPE.SHP", order, 1, 0, nullptr));
+    }
+    ASSERT_EQ(g_crcCalls, 2);
+    ASSERT_EQ(AssetIndex_GetCRC("JEEP.SHP"), conquer.crcs[0]);
+    ASSERT_EQ(g_crcCalls, 2);
+
+    // Reset forgets them along with the archives
+    AssetIndex_Reset();
+    AssetIndex_GetCRC("JEEP.SHP");
+    ASSERT_EQ(g_crcCalls, 3);
+}
+
+static void WriteFile(const std::string& path) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (f) {
+        fputs("x", f);
+        fclose(f);
+    }
+}
+
+TEST(loose_directories_scanned_at_mount) {
+    char base[] = "/tmp/assetindexXXXXXX";
+    ASSERT(mkdtemp(base) != nullptr);
+    std::string first = std::string(base) + "/first/";
+    std::string second = std::string(base) + "/second/";
+    mkdir(first.c_str(), 0755);
+    mkdir(second.c_str(), 0755);
+    mkdir((first + "subdir").c_str(), 0755);
+    WriteFile(first + "mcv.shp");
+    WriteFile(second + "mcv.shp");
+    WriteFile(second + "harv.shp");
+    WriteFile(second + "1Tnk.shp");
+
+    AssetIndex_Reset();
+    ASSERT_EQ(AssetIndex_AddLooseDirectory(first.c_str()), 1);
+    ASSERT_EQ(AssetIndex_AddLooseDirectory(second.c_str()), 3);
+    ASSERT_EQ(AssetIndex_AddLooseDirectory("/nonexistent/assetindex/"), 0);
+
+    const char* mcv = AssetIndex_FindLoose("mcv.shp");
+    const char* harv = AssetIndex_FindLoose("harv.shp");
+    ASSERT(mcv && first + "mcv.shp" == mcv);
+    ASSERT(harv && second + "harv.shp" == harv);
+    ASSERT(AssetIndex_FindLoose("subdir") == nullptr);
+
+    // Any case finds the file, whatever case it has on disk
+    const char* upper = AssetIndex_FindLoose("MCV.SHP");
+    const char* tank = AssetIndex_FindLoose("1TNK.SHP");
+    ASSERT(upper && first + "mcv.shp" == upper);
+    ASSERT(tank && second + "1Tnk.shp" == tank);
+    ASSERT(AssetIndex_FindLoose("1tnk.shp") == tank);
+
+    // Files added after the scan aren't picked up until the next mount
+    WriteFile(first + "late.shp");
+    ASSERT(AssetIndex_FindLoose("late.shp") == nullptr);
+
+    unlink((first + "mcv.shp").c_str());
+    unlink((first + "late.shp").c_str());
+    unlink((second + "mcv.shp").c_str());
+    unlink((second + "harv.shp").c_str());
+    unlink((second + "1Tnk.shp").c_str());
+    rmdir((first + "subdir").c_str());
+    rmdir(first.c_str());
+    rmdir(second.c_str());
+    rmdir(base);
+    AssetIndex_Reset();
+}
+
+//===========================================================================
+// Main
+//===========================================================================
+
+int main() {
+    printf("Red Alert Asset Index Tests\n");
+    printf("===========================\n\n");
+
+    RUN_TEST(first_archive_in_order_wins);
+    RUN_TEST(only_searches_the_given_archives);
+    RUN_TEST(unopened_archives_are_skipped);
+    RUN_TEST(search_continues_past_earlier_hit);
+    RUN_TEST(names_are_hashed_once);
+    RUN_TEST(loose_directories_scanned_at_mount);
+
+    printf("\nResults: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
+    return g_testsFailed > 0 ? 1 : 0;
+}
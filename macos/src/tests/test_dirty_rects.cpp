@@ -0,0 +1,300 @@
+/**
+ * Red Alert macOS Port - Dirty Rectangle Tracking Tests
+ *
+ * Checks the wwd-media dirty-rect accumulator (coverage, merging, the
+ * count limit), the per-frame clear tracking, and the change-limited
+ * present conversion, without Metal.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+
+#include <wwd/dirty_rects.h>
+#include <wwd/palette_lut.h>
+
+#define FBW WWD_FRAMEBUFFER_WIDTH
+#define FBH WWD_FRAMEBUFFER_HEIGHT
+
+// Simple test framework
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    int failedBefore = g_testsFailed; \
+    printf("  %s... ", #name); \
+    test_##name(); \
+    if (g_testsFailed == failedBefore) { \
+        printf("OK\n"); \
+        g_testsPassed++; \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) do { \
+    if ((a) != (b)) { \
+        printf("FAILED at line %d: %s != %s (%d vs %d)\n", \
+               __LINE__, #a, #b, (int)(a), (int)(b)); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+static uint32_t g_rng = 99;
+static int TestRand(int range) {
+    g_rng = g_rng * 1103515245u + 12345u;
+    return (int)((g_rng >> 8) % (uint32_t)range);
+}
+
+//===========================================================================
+// Coverage helpers
+//===========================================================================
+
+static std::vector<uint8_t> g_expected(FBW * FBH);
+static std::vector<uint8_t> g_covered(FBW * FBH);
+
+static void Paint(std::vector<uint8_t>& mask, int x, int y, int w, int h) {
+    for (int py = y; py < y + h; py++) {
+        for (int px = x; px < x + w; px++) {
+            if (px >= 0 && px < FBW && py >= 0 && py < FBH) {
+                mask[py * FBW + px]++;
+            }
+        }
+    }
+}
+
+// Every painted pixel is covered, and no pixel is covered twice
+static bool CoversExactlyOnce(const WwdDirtyRects* dirty) {
+    std::fill(g_covered.begin(), g_covered.end(), 0);
+    for (int i = 0; i < dirty->count; i++) {
+        const WwdRect& r = dirty->rects[i];
+        if (r.x < 0 || r.y < 0 || r.x + r.width > FBW || r.y + r.height > FBH) {
+            return false;
+        }
+        Paint(g_covered, r.x, r.y, r.width, r.height);
+    }
+    for (int i = 0; i < FBW * FBH; i++) {
+        if (g_covered[i] > 1) return false;
+        if (g_expected[i] && !g_covered[i]) return false;
+    }
+    return true;
+}
+
+//===========================================================================
+// Tests
+//===========================================================================
+
+TEST(clip_and_ignore_empty) {
+    WwdDirtyRects dirty;
+    Wwd_DirtyRects_Reset(&dirty);
+
+    Wwd_DirtyRects_Add(&dirty, -10, -10, 5, 5);        // Entirely off-screen
+    Wwd_DirtyRects_Add(&dirty, 100, 100, 0, 20);       // Empty
+    ASSERT_EQ(dirty.count, 0);
+
+    Wwd_DirtyRects_Add(&dirty, FBW - 4, FBH - 4, 10, 10);
+    ASSERT_EQ(dirty.count, 1);
+    ASSERT_EQ(dirty.rects[0].width, 4);
+    ASSERT_EQ(dirty.rects[0].height, 4);
+    ASSERT_EQ(Wwd_DirtyRects_Area(&dirty), 16);
+}
+
+TEST(overlaps_merge_disjoint_stay) {
+    WwdDirtyRects dirty;
+    Wwd_DirtyRects_Reset(&dirty);
+
+    Wwd_DirtyRects_Add(&dirty, 10, 10, 20, 20);
+    Wwd_DirtyRects_Add(&dirty, 100, 10, 20, 20);
+    ASSERT_EQ(dirty.count, 2);
+
+    // Contained: no change
+    Wwd_DirtyRects_Add(&dirty, 12, 12, 4, 4);
+    ASSERT_EQ(dirty.count, 2);
+
+    // Bridges both: everything collapses into one box
+    Wwd_DirtyRects_Add(&dirty, 25, 15, 80, 5);
+    ASSERT_EQ(dirty.count, 1);
+    ASSERT_EQ(dirty.rects[0].x, 10);
+    ASSERT_EQ(dirty.rects[0].width, 110);
+
+    // A full-screen mark swallows the rest
+    Wwd_DirtyRects_AddAll(&dirty);
+    Wwd_DirtyRects_Add(&dirty, 300, 200, 24, 24);
+    ASSERT_EQ(dirty.count, 1);
+    ASSERT_EQ(Wwd_DirtyRects_Area(&dirty), FBW * FBH);
+}
+
+TEST(random_adds_keep_coverage) {
+    for (int round = 0; round < 20; round++) {
+        WwdDirtyRects dirty;
+        Wwd_DirtyRects_Reset(&dirty);
+        std::fill(g_expected.begin(), g_expected.end(), 0);
+
+        int adds = 1 + TestRand(200);
+        for (int i = 0; i < adds; i++) {
+            int x = TestRand(FBW + 40) - 20;
+            int y = TestRand(FBH + 40) - 20;
+            int w = 1 + TestRand(48);
+            int h = 1 + TestRand(48);
+            Wwd_DirtyRects_Add(&dirty, x, y, w, h);
+            Paint(g_expected, x, y, w, h);
+            ASSERT(dirty.count <= WWD_DIRTY_MAX_RECTS);
+        }
+        ASSERT(CoversExactlyOnce(&dirty));
+    }
+}
+
+TEST(unchanged_frame_converts_nothing) {
+    static WwdPaletteLut lut;
+    WwdPalette palette;
+    for (int i = 0; i < 256; i++) {
+        palette.colors[i][0] = (uint8_t)i;
+        palette.colors[i][1] = (uint8_t)(255 - i);
+        palette.colors[i][2] = (uint8_t)(i * 7);
+    }
+    lut.valid = false;
+    Wwd_PaletteLut_Update(&lut, &palette);
+
+    std::vector<uint8_t> pixels(FBW * FBH), alpha(FBW * FBH, 255);
+    std::vector<uint8_t> prevPixels(FBW * FBH), prevAlpha(FBW * FBH);
+    std::vector<uint32_t> rgba(FBW * FBH), expect(FBW * FBH);
+    for (int i = 0; i < FBW * FBH; i++) pixels[i] = (uint8_t)TestRand(256);
+
+    WwdRect full = {0, 0, FBW, FBH};
+    WwdRect changed = Wwd_PaletteLut_ConvertChanged(
+        &lut, &full, FBW, pixels.data(), alpha.data(),
+        prevPixels.data(), prevAlpha.data(), rgba.data(), true);
+    ASSERT_EQ(changed.height, FBH);
+
+    // Redrawn with identical contents: nothing to convert
+    changed = Wwd_PaletteLut_ConvertChanged(
+        &lut, &full, FBW, pixels.data(), alpha.data(),
+        prevPixels.data(), prevAlpha.data(), rgba.data(), false);
+    ASSERT_EQ(changed.height, 0);
+
+    // One pixel and one alpha byte change: only their rows are converted
+    pixels[37 * FBW + 5] ^= 0x55;
+    alpha[120 * FBW + 600] = 128;
+    changed = Wwd_PaletteLut_ConvertChanged(
+        &lut, &full, FBW, pixels.data(), alpha.data(),
+        prevPixels.data(), prevAlpha.data(), rgba.data(), false);
+    ASSERT_EQ(changed.y, 37);
+    ASSERT_EQ(changed.height, 120 - 37 + 1);
+
+    Wwd_PaletteLut_Convert(&lut, pixels.data(), alpha.data(), expect.data(),
+                           FBW * FBH);
+    ASSERT(memcmp(rgba.data(), expect.data(), rgba.size() * sizeof(uint32_t)) == 0);
+}
+
+TEST(clear_dirties_only_what_was_drawn) {
+    static WwdFrameDirty frame;
+    Wwd_FrameDirty_Reset(&frame);
+    ASSERT_EQ(Wwd_DirtyRects_Area(&frame.dirty), FBW * FBH);
+
+    // First clear of a colour can't know what was under it
+    Wwd_FrameDirty_Clear(&frame, 0);
+    Wwd_FrameDirty_Draw(&frame, 100, 100, 24, 24);
+    ASSERT_EQ(Wwd_DirtyRects_Area(&frame.dirty), FBW * FBH);
+    Wwd_FrameDirty_Presented(&frame);
+
+    // Same colour again: the old sprite and the new one, nothing else
+    Wwd_FrameDirty_Clear(&frame, 0);
+    Wwd_FrameDirty_Draw(&frame, 300, 200, 24, 24);
+    Wwd_FrameDirty_SetAlpha(&frame, 0, 0, 16, 16);
+    ASSERT_EQ(Wwd_DirtyRects_Area(&frame.dirty), 24 * 24 * 2 + 16 * 16);
+    Wwd_FrameDirty_Presented(&frame);
+
+    // Dimmed cells come back on an alpha reset
+    Wwd_FrameDirty_ClearAlpha(&frame);
+    ASSERT_EQ(Wwd_DirtyRects_Area(&frame.dirty), 16 * 16);
+    Wwd_FrameDirty_Presented(&frame);
+
+    // A different colour changes everything
+    Wwd_FrameDirty_Clear(&frame, 8);
+    ASSERT_EQ(Wwd_DirtyRects_Area(&frame.dirty), FBW * FBH);
+}
+
+// Random frames against shadow buffers: every pixel or alpha byte that
+// differs from the last present must lie in a dirty rectangle
+TEST(frame_tracking_covers_every_change) {
+    static WwdFrameDirty frame;
+    std::vector<uint8_t> pixels(FBW * FBH, 0), alpha(FBW * FBH, 255);
+    std::vector<uint8_t> shownPixels(FBW * FBH, 1), shownAlpha(FBW * FBH, 0);
+    Wwd_FrameDirty_Reset(&frame);
+
+    auto fill = [](std::vector<uint8_t>& buf, int x, int y, int w, int h, uint8_t v) {
+        for (int py = y; py < y + h; py++) {
+            for (int px = x; px < x + w; px++) {
+                if (px >= 0 && px < FBW && py >= 0 && py < FBH) buf[py * FBW + px] = v;
+            }
+        }
+    };
+
+    int partialFrames = 0;
+    for (int f = 0; f < 60; f++) {
+        int op = TestRand(10);
+        if (op < 7) {
+            uint8_t color = (uint8_t)(TestRand(4) == 0 ? 8 : 0);
+            std::fill(pixels.begin(), pixels.end(), color);
+            std::fill(alpha.begin(), alpha.end(), 255);
+            Wwd_FrameDirty_Clear(&frame, color);
+        } else if (op < 8) {
+            std::fill(alpha.begin(), alpha.end(), 255);
+            Wwd_FrameDirty_ClearAlpha(&frame);
+        }
+        int draws = TestRand(12);
+        for (int i = 0; i < draws; i++) {
+            int x = TestRand(FBW + 40) - 20;
+            int y = TestRand(FBH + 40) - 20;
+            int w = 1 + TestRand(64);
+            int h = 1 + TestRand(64);
+            if (TestRand(3) == 0) {
+                fill(alpha, x, y, w, h, (uint8_t)TestRand(256));
+                Wwd_FrameDirty_SetAlpha(&frame, x, y, w, h);
+            } else {
+                fill(pixels, x, y, w, h, (uint8_t)TestRand(256));
+                Wwd_FrameDirty_Draw(&frame, x, y, w, h);
+            }
+        }
+
+        std::fill(g_covered.begin(), g_covered.end(), 0);
+        for (int i = 0; i < frame.dirty.count; i++) {
+            const WwdRect& r = frame.dirty.rects[i];
+            Paint(g_covered, r.x, r.y, r.width, r.height);
+        }
+        for (int i = 0; i < FBW * FBH; i++) {
+            bool changed = pixels[i] != shownPixels[i] || alpha[i] != shownAlpha[i];
+            ASSERT(!changed || g_covered[i]);
+        }
+        if (Wwd_DirtyRects_Area(&frame.dirty) < FBW * FBH) partialFrames++;
+
+        shownPixels = pixels;
+        shownAlpha = alpha;
+        Wwd_FrameDirty_Presented(&frame);
+    }
+    ASSERT(partialFrames > 0);
+}
+
+int main() {
+    printf("Red Alert Dirty Rectangle Tests\n");
+    printf("===============================\n\n");
+
+    RUN_TEST(clip_and_ignore_empty);
+    RUN_TEST(overlaps_merge_disjoint_stay);
+    RUN_TEST(random_adds_keep_coverage);
+    RUN_TEST(unchanged_frame_converts_nothing);
+    RUN_TEST(clear_dirties_only_what_was_drawn);
+    RUN_TEST(frame_tracking_covers_every_change);
+
+    printf("\nResults: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
+    return g_testsFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,352 @@
+/**
+ * Red Alert macOS Port - Incremental Fog of War Tests
+ *
+ * Runs random unit walks and checks after every tick that the reference
+ * counted fog matches a full clear-and-reveal recompute bit for bit.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+#include "game/units.h"
+#include "game/map.h"
+#include "game/mission.h"
+#include "game/sprites.h"
+#include "game/sounds.h"
+#include "game/terrain.h"
+#include "graphics/metal/renderer.h"
+
+//===========================================================================
+// Stubs for rendering, audio and mission hooks used by units.cpp
+//===========================================================================
+
+extern "C" {
+void Mission_TriggerAttacked(const char*) {}
+void Mission_TriggerDestroyed(const char*) {}
+void Mission_PostEvent(MissionEvent, int) {}
+void Sounds_PlayAt(SoundEffect, int, int, uint8_t) {}
+void Voice_PlayResponseAt(int, BOOL, ResponseType, VoiceVariant,
+                          int, int, uint8_t) {}
+BOOL Sprites_RenderUnit(UnitType, int, int, int, int, uint8_t) { return FALSE; }
+BOOL Sprites_RenderBuilding(BuildingType, int, int, int, uint8_t) { return FALSE; }
+void Wwd_Renderer_FillRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_PutPixel(int, int, uint8_t) {}
+void Wwd_Renderer_DrawLine(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_DrawRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_DrawCircle(int, int, int, uint8_t) {}
+void Wwd_Renderer_FillCircle(int, int, int, uint8_t) {}
+void Wwd_Renderer_SetAlpha(int, int, int, int, uint8_t) {}
+int Unit_GetPassengerCapacity(int unitType) {
+    return (unitType == UNIT_APC) ? 5 : 0;
+}
+}
+
+BOOL Terrain_Available(void) { return FALSE; }
+BOOL Terrain_RenderTile(int, int, int, int) { return FALSE; }
+BOOL Terrain_RenderByID(int, int, int, int) { return FALSE; }
+int Rules_GetGoldValue() { return 25; }
+int Rules_GetGemValue() { return 50; }
+
+// Simple test framework
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    int failedBefore = g_testsFailed; \
+    printf("  %s... ", #name); \
+    test_##name(); \
+    if (g_testsFailed == failedBefore) { \
+        printf("OK\n"); \
+        g_testsPassed++; \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) do { \
+    if ((a) != (b)) { \
+        printf("FAILED at line %d: %s != %s (%d vs %d)\n", \
+               __LINE__, #a, #b, (int)(a), (int)(b)); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+//===========================================================================
+// Full-recompute reference
+//===========================================================================
+
+static uint8_t g_refFlags[MAP_MAX_HEIGHT][MAP_MAX_WIDTH];
+static uint8_t g_prevFlags[MAP_MAX_HEIGHT][MAP_MAX_WIDTH];
+
+static void RefReset(void) {
+    memset(g_refFlags, 0, sizeof(g_refFlags));
+}
+
+static void RefReveal(int cellX, int cellY, int sightRange) {
+    int rangeSquared = sightRange * sightRange;
+    for (int dy = -sightRange; dy <= sightRange; dy++) {
+        for (int dx = -sightRange; dx <= sightRange; dx++) {
+            int cx = cellX + dx;
+            int cy = cellY + dy;
+            if (cx < 0 || cx >= Map_GetWidth() ||
+                cy < 0 || cy >= Map_GetHeight()) continue;
+            if (dx * dx + dy * dy > rangeSquared) continue;
+            g_refFlags[cy][cx] |= CELL_FLAG_REVEALED | CELL_FLAG_VISIBLE;
+        }
+    }
+}
+
+// What the old per-tick Map_ClearVisibility + Map_RevealAround pass produced
+static void RefRecompute(void) {
+    for (int y = 0; y < MAP_MAX_HEIGHT; y++) {
+        for (int x = 0; x < MAP_MAX_WIDTH; x++) {
+            g_refFlags[y][x] &= ~CELL_FLAG_VISIBLE;
+        }
+    }
+    for (int i = 0; i < MAX_UNITS; i++) {
+        Unit* unit = Units_Get(i);
+        if (!unit || unit->team != TEAM_PLAYER) continue;
+        int cellX, cellY;
+        Map_WorldToCell(unit->worldX, unit->worldY, &cellX, &cellY);
+        RefReveal(cellX, cellY, unit->sightRange);
+    }
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        Building* bld = Buildings_Get(i);
+        if (!bld || bld->team != TEAM_PLAYER) continue;
+        RefReveal(bld->cellX + bld->width / 2, bld->cellY + bld->height / 2,
+                  bld->sightRange);
+    }
+}
+
+static const uint8_t FOG_BITS = CELL_FLAG_REVEALED | CELL_FLAG_VISIBLE;
+
+// Returns the first mismatching cell index, or -1 if identical
+static int CompareWithReference(void) {
+    for (int y = 0; y < Map_GetHeight(); y++) {
+        for (int x = 0; x < Map_GetWidth(); x++) {
+            uint8_t got = Map_GetCell(x, y)->flags & FOG_BITS;
+            if (got != g_refFlags[y][x]) return y * MAP_MAX_WIDTH + x;
+        }
+    }
+    return -1;
+}
+
+static void SnapshotFlags(void) {
+    for (int y = 0; y < Map_GetHeight(); y++) {
+        for (int x = 0; x < Map_GetWidth(); x++) {
+            g_prevFlags[y][x] = Map_GetCell(x, y)->flags & FOG_BITS;
+        }
+    }
+}
+
+// Every cell whose fog bits changed since the snapshot must be listed once
+static bool ChangeListCoversDiff(void) {
+    static uint8_t listed[MAP_MAX_HEIGHT * MAP_MAX_WIDTH];
+    memset(listed, 0, sizeof(listed));
+
+    const uint16_t* cells = nullptr;
+    int count = Map_GetFogChanges(&cells);
+    for (int i = 0; i < count; i++) {
+        if (listed[cells[i]]) return false;  // Duplicate entry
+        listed[cells[i]] = 1;
+    }
+    for (int y = 0; y < Map_GetHeight(); y++) {
+        for (int x = 0; x < Map_GetWidth(); x++) {
+            uint8_t now = Map_GetCell(x, y)->flags & FOG_BITS;
+            if (now != g_prevFlags[y][x] && !listed[y * MAP_MAX_WIDTH + x]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static uint32_t g_rng = 1;
+static int TestRand(int range) {
+    g_rng = g_rng * 1103515245u + 12345u;
+    return (int)((g_rng >> 8) % (uint32_t)range);
+}
+
+static void ResetWorld(int width, int height) {
+    Map_Init();
+    Map_Create(width, height);
+    Units_Init();
+    Map_SetFogEnabled(TRUE);
+    RefReset();
+}
+
+//===========================================================================
+// Tests
+//===========================================================================
+
+TEST(viewer_step_tables) {
+    // Drive viewers directly with single steps and long jumps
+    ResetWorld(48, 40);
+
+    struct { int x, y, range; } viewers[12];
+    for (int v = 0; v < 12; v++) {
+        viewers[v].x = TestRand(48);
+        viewers[v].y = TestRand(40);
+        viewers[v].range = v + (v > 9 ? 4 : 0);  // Include range 0 and > 10
+        Map_AddViewer(viewers[v].x, viewers[v].y, viewers[v].range);
+        RefReveal(viewers[v].x, viewers[v].y, viewers[v].range);
+    }
+    ASSERT_EQ(CompareWithReference(), -1);
+
+    for (int step = 0; step < 400; step++) {
+        int v = TestRand(12);
+        int nx, ny;
+        if (TestRand(8) == 0) {
+            nx = TestRand(56) - 4;   // Jump, sometimes off the map edge
+            ny = TestRand(48) - 4;
+        } else {
+            nx = viewers[v].x + TestRand(3) - 1;
+            ny = viewers[v].y + TestRand(3) - 1;
+        }
+        Map_MoveViewer(viewers[v].x, viewers[v].y, nx, ny, viewers[v].range);
+        viewers[v].x = nx;
+        viewers[v].y = ny;
+
+        for (int y = 0; y < MAP_MAX_HEIGHT; y++) {
+            for (int x = 0; x < MAP_MAX_WIDTH; x++) {
+                g_refFlags[y][x] &= ~CELL_FLAG_VISIBLE;
+            }
+        }
+        for (int i = 0; i < 12; i++) {
+            RefReveal(viewers[i].x, viewers[i].y, viewers[i].range);
+        }
+        ASSERT_EQ(CompareWithReference(), -1);
+    }
+
+    // Releasing every viewer leaves only the revealed history
+    for (int v = 0; v < 12; v++) {
+        Map_RemoveViewer(viewers[v].x, viewers[v].y, viewers[v].range);
+    }
+    for (int y = 0; y < 40; y++) {
+        for (int x = 0; x < 48; x++) {
+            ASSERT(!(Map_GetCell(x, y)->flags & CELL_FLAG_VISIBLE));
+        }
+    }
+}
+
+TEST(random_unit_walks) {
+    ResetWorld(64, 64);
+
+    static const UnitType kTypes[] = {
+        UNIT_RIFLE, UNIT_TANK_LIGHT, UNIT_ROCKET, UNIT_TANK_HEAVY, UNIT_DOG
+    };
+    for (int i = 0; i < 48; i++) {
+        Team team = (i % 3 == 0) ? TEAM_ENEMY : TEAM_PLAYER;
+        Units_Spawn(kTypes[i % 5], team,
+                    TestRand(64) * CELL_SIZE + 12, TestRand(64) * CELL_SIZE + 12);
+    }
+    int bldA = Buildings_Spawn(BUILDING_POWER, TEAM_PLAYER, 10, 10);
+    Buildings_Spawn(BUILDING_BARRACKS, TEAM_PLAYER, 40, 30);
+    Buildings_Spawn(BUILDING_POWER, TEAM_ENEMY, 50, 50);
+    ASSERT(bldA >= 0);
+
+    RefRecompute();
+    ASSERT_EQ(CompareWithReference(), -1);
+    Map_ClearFogChanges();
+
+    for (int tick = 0; tick < 800; tick++) {
+        // Wander: hand out fresh random destinations
+        for (int n = 0; n < 4; n++) {
+            int id = TestRand(MAX_UNITS);
+            if (Units_Get(id)) {
+                Units_CommandMove(id, TestRand(64) * CELL_SIZE + 12,
+                                  TestRand(64) * CELL_SIZE + 12);
+            }
+        }
+        // Churn: remove and spawn units, drop a building once
+        if (tick % 50 == 25) {
+            int id = TestRand(MAX_UNITS);
+            if (Units_Get(id)) Units_Remove(id);
+            Units_Spawn(UNIT_TANK_LIGHT, TEAM_PLAYER,
+                        TestRand(64) * CELL_SIZE + 12, TestRand(64) * CELL_SIZE + 12);
+        }
+        if (tick == 400) Buildings_Remove(bldA);
+
+        SnapshotFlags();
+        Units_Update();
+
+        RefRecompute();
+        int bad = CompareWithReference();
+        if (bad >= 0) printf("tick %d cell %d ", tick, bad);
+        ASSERT_EQ(bad, -1);
+        ASSERT(ChangeListCoversDiff());
+        Map_ClearFogChanges();
+    }
+}
+
+TEST(trigger_reveal_expires) {
+    ResetWorld(32, 32);
+
+    Map_RevealArea(16 * CELL_SIZE, 16 * CELL_SIZE, 2 * CELL_SIZE);
+    ASSERT(Map_IsCellVisible(16, 16));
+    ASSERT(Map_IsCellRevealed(17, 17));
+
+    // Visible until the next tick, revealed forever
+    Units_Update();
+    ASSERT(!Map_IsCellVisible(16, 16));
+    ASSERT(Map_IsCellRevealed(16, 16));
+
+    // A unit standing in the pulsed area keeps its cells visible
+    int id = Units_Spawn(UNIT_RIFLE, TEAM_PLAYER, 5 * CELL_SIZE + 12, 5 * CELL_SIZE + 12);
+    ASSERT(id >= 0);
+    Map_RevealAll();
+    Units_Update();
+    ASSERT(Map_IsCellVisible(5, 5));
+    ASSERT(!Map_IsCellVisible(30, 30));
+    ASSERT(Map_IsCellRevealed(30, 30));
+}
+
+TEST(change_list_stays_out_of_cell_flags) {
+    ResetWorld(32, 32);
+
+    // Cell flags are game state (saved and hashed); queueing a change and
+    // consuming it must leave them as the fog left them
+    Map_AddViewer(10, 10, 3);
+    const uint16_t* cells = nullptr;
+    ASSERT(Map_GetFogChanges(&cells) > 0);
+    uint8_t before[32][32];
+    for (int y = 0; y < 32; y++) {
+        for (int x = 0; x < 32; x++) {
+            before[y][x] = Map_GetCell(x, y)->flags;
+            ASSERT_EQ(before[y][x] & ~FOG_BITS, 0);
+        }
+    }
+    Map_ClearFogChanges();
+    ASSERT_EQ(Map_GetFogChanges(&cells), 0);
+    for (int y = 0; y < 32; y++) {
+        for (int x = 0; x < 32; x++) {
+            ASSERT_EQ(Map_GetCell(x, y)->flags, before[y][x]);
+        }
+    }
+
+    // A cleared cell is queued again on its next change
+    Map_RemoveViewer(10, 10, 3);
+    ASSERT(Map_GetFogChanges(&cells) > 0);
+}
+
+int main() {
+    printf("Red Alert Fog of War Tests\n");
+    printf("==========================\n\n");
+
+    RUN_TEST(viewer_step_tables);
+    RUN_TEST(random_unit_walks);
+    RUN_TEST(trigger_reveal_expires);
+    RUN_TEST(change_list_stays_out_of_cell_flags);
+
+    printf("\nResults: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
+    return g_testsFailed > 0 ? 1 : 0;
+}
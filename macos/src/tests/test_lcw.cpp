@@ -0,0 +1,131 @@
+/**
+ * Red Alert macOS Port - LCW Decoder Tests
+ *
+ * Feeds hand-built Format80 streams through the built-in LCW_Decompress
+ * (the LCW_NO_LIBWESTWOOD build ra_headless uses): each command on its
+ * own, overlapping back-references, and streams that run past their
+ * input or output or stop before the end marker. Also decodes a Base64 + LCW chunk the way
+ * scenario [MapPack] sections are stored.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "assets/lcw.h"
+
+// Simple test framework
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    int failedBefore = g_testsFailed; \
+    printf("  %s... ", #name); \
+    test_##name(); \
+    if (g_testsFailed == failedBefore) { \
+        printf("OK\n"); \
+        g_testsPassed++; \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) do { \
+    if ((a) != (b)) { \
+        printf("FAILED at line %d: %s != %s (%d vs %d)\n", \
+               __LINE__, #a, #b, (int)(a), (int)(b)); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+static int Decode(const std::vector<uint8_t>& src, uint8_t* dst, int dstSize) {
+    return LCW_Decompress(src.data(), dst, (int)src.size(), dstSize);
+}
+
+//===========================================================================
+// Tests
+//===========================================================================
+
+TEST(literal_and_end_marker) {
+    uint8_t out[16] = {};
+    ASSERT_EQ(Decode({0x83, 'a', 'b', 'c', 0x80}, out, 16), 3);
+    ASSERT(memcmp(out, "abc", 3) == 0);
+
+    // Anything after the end marker is ignored
+    ASSERT_EQ(Decode({0x81, 'x', 0x80, 0x81, 'y'}, out, 16), 1);
+    ASSERT_EQ(out[0], 'x');
+}
+
+TEST(fill) {
+    uint8_t out[300] = {};
+    ASSERT_EQ(Decode({0xFE, 0x2C, 0x01, 0x7A, 0x80}, out, 300), 300);
+    for (int i = 0; i < 300; i++) ASSERT_EQ(out[i], 0x7A);
+}
+
+TEST(relative_copy_overlaps) {
+    // "ab", then 7 bytes from 2 back: the copy reads its own output
+    uint8_t out[16] = {};
+    ASSERT_EQ(Decode({0x82, 'a', 'b', 0x40, 0x02, 0x80}, out, 16), 9);
+    ASSERT(memcmp(out, "ababababa", 9) == 0);
+}
+
+TEST(absolute_copies) {
+    uint8_t out[32] = {};
+    // "wxyz", 4 bytes from position 1 (short form), then 5 from 0 (long)
+    int n = Decode({0x84, 'w', 'x', 'y', 'z',
+                    0xC1, 0x01, 0x00,
+                    0xFF, 0x05, 0x00, 0x00, 0x00,
+                    0x80}, out, 32);
+    ASSERT_EQ(n, 13);
+    ASSERT(memcmp(out, "wxyzxyzxwxyzx", 13) == 0);
+}
+
+TEST(malformed_streams_fail) {
+    uint8_t out[8] = {};
+    ASSERT_EQ(Decode({0x85, 'a', 'b'}, out, 8), -1);              // Literal past input
+    ASSERT_EQ(Decode({0x89, 1, 2, 3, 4, 5, 6, 7, 8, 9}, out, 8), -1); // Past output
+    ASSERT_EQ(Decode({0x30, 0x05}, out, 8), -1);                  // Back before start
+    ASSERT_EQ(Decode({0x81, 'a', 0xC0, 0x04, 0x00}, out, 8), -1); // Position not yet written
+    ASSERT_EQ(Decode({0xFE, 0x09, 0x00, 0x00}, out, 8), -1);      // Fill past output
+    ASSERT_EQ(Decode({0x82, 'a', 'b'}, out, 8), -1);              // No end marker
+    ASSERT_EQ(LCW_Decompress(nullptr, out, 4, 8), -1);
+}
+
+TEST(base64_mappack_chunk) {
+    // Base64 of {0xFE, 0x10, 0x00, 0x03, 0x80}: sixteen cells of template 3
+    const char* text = "/hAAA4A=";
+    uint8_t packed[16];
+    int packedSize = Base64_Decode(text, (int)strlen(text), packed, sizeof(packed));
+    ASSERT_EQ(packedSize, 5);
+
+    uint8_t cells[16] = {};
+    ASSERT_EQ(LCW_Decompress(packed, cells, packedSize, sizeof(cells)), 16);
+    for (int i = 0; i < 16; i++) ASSERT_EQ(cells[i], 3);
+}
+
+//===========================================================================
+// Main
+//===========================================================================
+
+int main() {
+    printf("Red Alert LCW Tests\n");
+    printf("===================\n\n");
+
+    RUN_TEST(literal_and_end_marker);
+    RUN_TEST(fill);
+    RUN_TEST(relative_copy_overlaps);
+    RUN_TEST(absolute_copies);
+    RUN_TEST(malformed_streams_fail);
+    RUN_TEST(base64_mappack_chunk);
+
+    printf("\nResults: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
+    return g_testsFailed > 0 ? 1 : 0;
+}
@@ -511,6 +511,181 @@ TEST(path_line_of_sight) {
     ASSERT(!PathFinder::LineOfSight(from, to, SpeedType::TRACK));
 }
 
+//===========================================================================
+// Movement Zone Tests
+//===========================================================================
+
+static void SetWater(int x, int y) {
+    Map[XY_Cell(x, y)].templateType_ = TemplateType::WATER;
+    Map[XY_Cell(x, y)].RecalcLandType();
+}
+
+// Lake from (40,40) to (80,80) with an island in the middle
+static void BuildIslandMap() {
+    Map.InitClear();
+    Map.SetMapDimensions(0, 0, 128, 128);
+    for (int y = 40; y <= 80; y++) {
+        for (int x = 40; x <= 80; x++) {
+            bool island = x >= 55 && x <= 65 && y >= 55 && y <= 65;
+            if (!island) SetWater(x, y);
+        }
+    }
+    Map.ZoneReset();
+}
+
+// Square of concrete wall from (20,20) to (30,30) around a base
+static void BuildWalledBase() {
+    Map.InitClear();
+    Map.SetMapDimensions(0, 0, 128, 128);
+    for (int i = 20; i <= 30; i++) {
+        Map[XY_Cell(i, 20)].SetOverlay(OverlayType::BRICK_WALL, 100);
+        Map[XY_Cell(i, 30)].SetOverlay(OverlayType::BRICK_WALL, 100);
+        Map[XY_Cell(20, i)].SetOverlay(OverlayType::BRICK_WALL, 100);
+        Map[XY_Cell(30, i)].SetOverlay(OverlayType::BRICK_WALL, 100);
+    }
+    Map.ZoneReset();
+}
+
+TEST(zone_islands) {
+    BuildIslandMap();
+
+    CELL mainland = XY_Cell(10, 10);
+    CELL island = XY_Cell(60, 60);
+    CELL lake = XY_Cell(45, 45);
+
+    ASSERT(Map.CellZone(mainland, MZoneType::NORMAL) != 0);
+    ASSERT(Map.CellZone(island, MZoneType::NORMAL) != 0);
+    ASSERT(Map.CellZone(mainland, MZoneType::NORMAL) != Map.CellZone(island, MZoneType::NORMAL));
+    ASSERT_EQ(Map.CellZone(lake, MZoneType::NORMAL), 0);
+    ASSERT(!Map.ZonesConnected(mainland, island, MZoneType::NORMAL));
+
+    // The lake is one water zone wrapped around the island
+    ASSERT(Map.CellZone(lake, MZoneType::WATER) != 0);
+    ASSERT(Map.ZonesConnected(lake, XY_Cell(75, 75), MZoneType::WATER));
+    ASSERT_EQ(Map.CellZone(island, MZoneType::WATER), 0);
+
+    // Pathfinding rejects the crossing outright but boats still sail
+    ASSERT(!Find_Path(mainland, island, SpeedType::TRACK).IsValid());
+    ASSERT(!Find_Path(mainland, island, SpeedType::FOOT).IsValid());
+    ASSERT(Find_Path(lake, XY_Cell(75, 75), SpeedType::FLOAT).IsValid());
+    ASSERT(Find_Path(mainland, XY_Cell(100, 100), SpeedType::TRACK).IsValid());
+}
+
+TEST(zone_walled_base) {
+    BuildWalledBase();
+
+    CELL inside = XY_Cell(25, 25);
+    CELL outside = XY_Cell(50, 50);
+
+    // Concrete stops vehicles and crushers; destroyers and infantry pass
+    ASSERT(!Map.ZonesConnected(inside, outside, MZoneType::NORMAL));
+    ASSERT(!Map.ZonesConnected(inside, outside, MZoneType::CRUSHER));
+    ASSERT(Map.ZonesConnected(inside, outside, MZoneType::DESTROYER));
+    ASSERT(!Find_Path(outside, inside, SpeedType::TRACK).IsValid());
+    ASSERT(Find_Path(outside, inside, SpeedType::FOOT).IsValid());
+
+    // A sandbag section lets crushers in but not other vehicles
+    CELL gate = XY_Cell(25, 30);
+    Map[gate].SetOverlay(OverlayType::SANDBAG_WALL, 10);
+    ASSERT(Map.ZoneCell(gate));
+    ASSERT(Map.ZonesConnected(inside, outside, MZoneType::CRUSHER));
+    ASSERT(!Map.ZonesConnected(inside, outside, MZoneType::NORMAL));
+
+    // Destroying it opens the base to everyone
+    Map[gate].ReduceWall(100);
+    ASSERT(Map.ZoneCell(gate));
+    ASSERT(Map.ZonesConnected(inside, outside, MZoneType::NORMAL));
+    ASSERT(Find_Path(outside, inside, SpeedType::TRACK).IsValid());
+
+    // Rebuilding it seals the base again
+    Map[gate].SetOverlay(OverlayType::BRICK_WALL, 100);
+    ASSERT(Map.ZoneCell(gate));
+    ASSERT(!Map.ZonesConnected(inside, outside, MZoneType::NORMAL));
+    ASSERT(!Map.ZoneCell(gate));
+}
+
+TEST(zone_building_blocks_gap) {
+    BuildWalledBase();
+
+    // Open a gap, then plug it with a building
+    CELL gate = XY_Cell(25, 30);
+    Map[gate].ClearOverlay();
+    Map.ZoneCell(gate);
+    ASSERT(Map.ZonesConnected(XY_Cell(25, 25), XY_Cell(50, 50), MZoneType::NORMAL));
+
+    Map[gate].flag_.occupy.building = 1;
+    Map.ZoneCell(gate);
+    ASSERT(!Map.ZonesConnected(XY_Cell(25, 25), XY_Cell(50, 50), MZoneType::NORMAL));
+    ASSERT(!Find_Path(XY_Cell(50, 50), XY_Cell(25, 25), SpeedType::TRACK).IsValid());
+
+    Map[gate].flag_.occupy.building = 0;
+    Map.ZoneCell(gate);
+    ASSERT(Find_Path(XY_Cell(50, 50), XY_Cell(25, 25), SpeedType::TRACK).IsValid());
+}
+
+// Incremental labels must partition the map exactly as a full relabel
+static bool ZonesMatchReset() {
+    static int incremental[static_cast<int>(MZoneType::COUNT)][MAP_CELL_TOTAL];
+    for (int z = 0; z < static_cast<int>(MZoneType::COUNT); z++) {
+        for (int i = 0; i < MAP_CELL_TOTAL; i++) {
+            incremental[z][i] = Map.CellZone(static_cast<CELL>(i), static_cast<MZoneType>(z));
+        }
+    }
+    Map.ZoneReset();
+
+    for (int z = 0; z < static_cast<int>(MZoneType::COUNT); z++) {
+        int toReset[256];
+        int toIncremental[256];
+        for (int i = 0; i < 256; i++) toReset[i] = toIncremental[i] = -1;
+
+        for (int i = 0; i < MAP_CELL_TOTAL; i++) {
+            int a = incremental[z][i];
+            int b = Map.CellZone(static_cast<CELL>(i), static_cast<MZoneType>(z));
+            if ((a == 0) != (b == 0)) return false;
+            if (toReset[a] < 0) toReset[a] = b;
+            if (toIncremental[b] < 0) toIncremental[b] = a;
+            if (toReset[a] != b || toIncremental[b] != a) return false;
+        }
+    }
+    return true;
+}
+
+TEST(zone_incremental_matches_reset) {
+    static const OverlayType WALLS[] = {
+        OverlayType::BRICK_WALL, OverlayType::SANDBAG_WALL, OverlayType::WOOD_WALL
+    };
+    uint32_t seed = 12345;
+    auto next = [&seed](int bound) {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<int>((seed >> 16) % bound);
+    };
+
+    BuildIslandMap();
+    for (int round = 0; round < 20; round++) {
+        // Toggle walls and building cells in a band crossing land and lake
+        for (int edit = 0; edit < 150; edit++) {
+            CELL cell = XY_Cell(30 + next(40), 30 + next(40));
+            CellClass& c = Map[cell];
+            switch (next(3)) {
+                case 0:
+                    if (c.IsWall()) c.ClearOverlay();
+                    else if (!c.IsWater()) c.SetOverlay(WALLS[next(3)], 50);
+                    break;
+                case 1:
+                    c.flag_.occupy.building = !c.flag_.occupy.building;
+                    break;
+                default:
+                    if (c.IsWater()) c.templateType_ = TemplateType::CLEAR1;
+                    else SetWater(Cell_X(cell), Cell_Y(cell));
+                    c.RecalcLandType();
+                    break;
+            }
+            Map.ZoneCell(cell);
+        }
+        ASSERT(ZonesMatchReset());
+    }
+}
+
 //===========================================================================
 // Main
 //===========================================================================
@@ -568,6 +743,12 @@ int main() {
     RUN_TEST(path_water_unit);
     RUN_TEST(path_line_of_sight);
 
+    printf("\nMovement Zone Tests:\n");
+    RUN_TEST(zone_islands);
+    RUN_TEST(zone_walled_base);
+    RUN_TEST(zone_building_blocks_gap);
+    RUN_TEST(zone_incremental_matches_reset);
+
     printf("\n====================================\n");
     printf("Results: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
 
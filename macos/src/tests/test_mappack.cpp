@@ -31,6 +31,8 @@ void Units_CommandGuard(int) {}
 void Units_CommandAttackMove(int, int, int) {}
 int Units_CommandAllHunt(Team) { return 0; }
 void Terrain_SetTheater(int) {}
+void Terrain_PrefetchTemplates(const uint8_t*, int) {}
+extern "C" void Sprites_Prefetch(const UnitType*, int, const BuildingType*, int) {}
 void EnableAIProduction(int) {}
 void EnableAIAutocreate(int) {}
 void Units_DestroyByTrigger(const char*) {}
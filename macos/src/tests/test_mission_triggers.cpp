@@ -0,0 +1,398 @@
+/**
+ * Red Alert macOS Port - Mission Trigger Regression Test
+ *
+ * Plays the same scripted scenario twice: once with every trigger
+ * condition polled each frame (the old behaviour) and once event-driven,
+ * where a trigger is only re-evaluated after an event it subscribes to.
+ * Every trigger must fire on exactly the same frames both times.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+
+#include "game/units.h"
+#include "game/map.h"
+#include "game/mission.h"
+#include "game/random.h"
+#include "game/sprites.h"
+#include "game/sounds.h"
+#include "game/terrain.h"
+#include "assets/assetloader.h"
+#include "graphics/metal/renderer.h"
+
+//===========================================================================
+// Stubs for rendering, audio, AI and asset hooks used by units/mission
+//===========================================================================
+
+extern "C" {
+void Sounds_PlayAt(SoundEffect, int, int, uint8_t) {}
+void Voice_PlayResponseAt(int, BOOL, ResponseType, VoiceVariant,
+                          int, int, uint8_t) {}
+BOOL Sprites_RenderUnit(UnitType, int, int, int, int, uint8_t) { return FALSE; }
+BOOL Sprites_RenderBuilding(BuildingType, int, int, int, uint8_t) { return FALSE; }
+void Sprites_Prefetch(const UnitType*, int, const BuildingType*, int) {}
+void Wwd_Renderer_FillRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_PutPixel(int, int, uint8_t) {}
+void Wwd_Renderer_DrawLine(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_DrawRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_DrawCircle(int, int, int, uint8_t) {}
+void Wwd_Renderer_FillCircle(int, int, int, uint8_t) {}
+void Wwd_Renderer_SetAlpha(int, int, int, int, uint8_t) {}
+int Unit_GetPassengerCapacity(int unitType) {
+    return (unitType == UNIT_APC) ? 5 : 0;
+}
+void AI_Init(void) {}
+BOOL Assets_SetTheater(TheaterType) { return TRUE; }
+int LCW_Decompress(const uint8_t*, uint8_t*, int, int) { return 0; }
+int Base64_Decode(const char*, int, uint8_t*, int) { return 0; }
+}
+
+BOOL Terrain_Available(void) { return FALSE; }
+BOOL Terrain_RenderTile(int, int, int, int) { return FALSE; }
+BOOL Terrain_RenderByID(int, int, int, int) { return FALSE; }
+void Terrain_SetTheater(int) {}
+void Terrain_PrefetchTemplates(const uint8_t*, int) {}
+int Rules_GetGoldValue() { return 25; }
+int Rules_GetGemValue() { return 50; }
+bool VQA_Play(const char*) { return false; }
+void EnableAIProduction(int) {}
+void EnableAIAutocreate(int) {}
+
+// Simple test framework
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    int failedBefore = g_testsFailed; \
+    printf("  %s... ", #name); \
+    test_##name(); \
+    if (g_testsFailed == failedBefore) { \
+        printf("OK\n"); \
+        g_testsPassed++; \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) do { \
+    if ((a) != (b)) { \
+        printf("FAILED at line %d: %s != %s (%d vs %d)\n", \
+               __LINE__, #a, #b, (int)(a), (int)(b)); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+//===========================================================================
+// Scenario
+//===========================================================================
+
+// Cell number on the 128-wide mission grid (map origin is 0,0)
+#define CELL(x, y) ((y) * 128 + (x))
+
+// World pixel at the center of a cell
+static int CellCenter(int c) { return c * CELL_SIZE + CELL_SIZE / 2; }
+
+static const char* const TRIGGER_NAMES[] = {
+    "wp0", "zone1", "cellt", "sovunits", "glob", "timer", "cash",
+    "lowpwr", "radar", "sovbldgs", "attacked", "any", "sovall"
+};
+static const int TRIGGER_COUNT =
+    (int)(sizeof(TRIGGER_NAMES) / sizeof(TRIGGER_NAMES[0]));
+
+// persist,house,eventCtrl,actionCtrl,e1,p1,p2,e2,p1,p2,a1,p1,p2,p3,a2,...
+// House 1 = Greece (player), 2 = USSR (enemy). Action 11 = text.
+static void BuildScenarioINI(char* buf, size_t size) {
+    snprintf(buf, size,
+        "[Basic]\n"
+        "Name=Trigger Regression\n"
+        "Player=Greece\n"
+        "[Map]\n"
+        "Theater=SNOW\n"
+        "X=0\nY=0\nWidth=64\nHeight=64\n"
+        "[Waypoints]\n"
+        "0=%d\n"
+        "1=%d\n"
+        "[CellTriggers]\n"
+        "%d=cellt\n"
+        "[Trigs]\n"
+        "wp0=0,1,0,0,1,0,0,0,0,0,11,0,0,1,0,0,0,0\n"
+        "zone1=2,1,0,0,19,1,0,0,0,0,11,0,0,2,0,0,0,0\n"
+        "cellt=0,1,0,0,1,-1,0,0,0,0,11,0,0,3,0,0,0,0\n"
+        "sovunits=0,1,0,0,9,0,2,0,0,0,28,0,0,3,0,0,0,0\n"
+        "glob=0,1,0,0,22,0,3,0,0,0,23,0,0,1,0,0,0,0\n"
+        "timer=0,1,0,0,14,0,0,0,0,0,11,0,0,4,0,0,0,0\n"
+        "cash=2,1,0,0,12,0,7000,0,0,0,11,0,0,5,0,0,0,0\n"
+        "lowpwr=2,1,0,0,25,0,1,0,0,0,11,0,0,6,0,0,0,0\n"
+        "radar=0,1,1,0,27,%d,0,13,0,40,11,0,0,7,0,0,0,0\n"
+        "sovbldgs=0,1,0,0,10,0,2,0,0,0,11,0,0,8,0,0,0,0\n"
+        "attacked=0,1,0,0,6,0,0,0,0,0,11,0,0,9,0,0,0,0\n"
+        "any=0,1,0,0,8,0,0,0,0,0,11,0,0,10,0,0,0,0\n"
+        "sovall=2,1,2,0,11,0,2,23,0,3,11,0,0,11,0,0,0,0\n",
+        CELL(20, 1), CELL(14, 30), CELL(20, 30), (int)BUILDING_RADAR);
+}
+
+struct FireEvent {
+    int frame;
+    int trigger;
+};
+
+struct RunResult {
+    std::vector<FireEvent> fires;
+    int evaluations;
+};
+
+static MissionData g_mission;
+static int g_credits = 5000;
+
+static int SpawnAt(UnitType type, Team team, int cx, int cy) {
+    return Units_Spawn(type, team, CellCenter(cx), CellCenter(cy));
+}
+
+static void SetCredits(int credits) {
+    g_credits = credits;
+    Mission_PostEvent(MISSION_EVENT_CREDITS_CHANGED, 0);
+}
+
+// Play the scripted scenario and log every trigger firing by frame
+static RunResult RunScenario(bool polling, int frames) {
+    static char ini[4096];
+    BuildScenarioINI(ini, sizeof(ini));
+
+    Mission_ResetTimer();
+    Mission_LoadFromBuffer(&g_mission, ini, (int)strlen(ini));
+    Mission_Start(&g_mission);
+    Mission_SetTriggerPolling(polling ? 1 : 0);
+    Random_Seed(4242);
+
+    g_credits = 5000;
+    Units_SetCreditsPtr(&g_credits);
+
+    // The demo map has open ground along the top edge (scout and the
+    // Soviet outpost) and in the south-west corner (base, tank, rifleman)
+
+    // Player base: one power plant can't carry refinery, factory and radar
+    Buildings_Spawn(BUILDING_POWER, TEAM_PLAYER, 10, 23);
+    Buildings_Spawn(BUILDING_REFINERY, TEAM_PLAYER, 13, 23);
+    Buildings_Spawn(BUILDING_FACTORY, TEAM_PLAYER, 17, 23);
+
+    int scout = SpawnAt(UNIT_JEEP, TEAM_PLAYER, 10, 1);
+    int rifle = SpawnAt(UNIT_RIFLE, TEAM_PLAYER, 3, 30);
+    int tank = SpawnAt(UNIT_TANK_LIGHT, TEAM_PLAYER, 5, 25);
+
+    // Soviet outpost, one unit carrying the 'attacked' trigger
+    int sovBld1 = Buildings_Spawn(BUILDING_POWER, TEAM_ENEMY, 50, 2);
+    int sovBld2 = Buildings_Spawn(BUILDING_BARRACKS, TEAM_ENEMY, 54, 2);
+    int sov[4];
+    sov[0] = SpawnAt(UNIT_RIFLE, TEAM_ENEMY, 36, 1);
+    sov[1] = SpawnAt(UNIT_RIFLE, TEAM_ENEMY, 37, 2);
+    sov[2] = SpawnAt(UNIT_RIFLE, TEAM_ENEMY, 38, 1);
+    sov[3] = SpawnAt(UNIT_RIFLE, TEAM_ENEMY, 38, 3);
+    Unit* marked = Units_Get(sov[0]);
+    if (marked) strcpy(marked->triggerName, "attacked");
+
+    RunResult run;
+    std::vector<int> lastCounts(TRIGGER_COUNT, 0);
+    int baseEvaluations = Mission_GetTriggerEvaluations();
+    int secondPower = -1;
+
+    for (int frame = 0; frame < frames; frame++) {
+        switch (frame) {
+            case 5:    // Scout drives through waypoint 0's zone
+                Units_CommandMove(scout, CellCenter(20), CellCenter(1));
+                break;
+            case 20:   // Rifleman walks onto the cell trigger
+                Units_CommandMove(rifle, CellCenter(20), CellCenter(30));
+                break;
+            case 40:   // Tank parks in zone 1, leaves later
+                Units_CommandMove(tank, CellCenter(14), CellCenter(29));
+                break;
+            case 90:
+                SetCredits(g_credits + 2500);
+                break;
+            case 120:  // Second power plant ends low power
+                secondPower = Buildings_Spawn(BUILDING_POWER, TEAM_PLAYER, 20, 23);
+                break;
+            case 150:
+                SetCredits(g_credits - 1000);
+                Units_CommandMove(tank, CellCenter(5), CellCenter(24));
+                break;
+            case 170:  // Radar on its own isn't enough before frame 240
+                Buildings_Spawn(BUILDING_RADAR, TEAM_PLAYER, 22, 27);
+                break;
+            case 200:  // Scout attacks into the outpost
+                Units_CommandMove(scout, CellCenter(35), CellCenter(1));
+                break;
+            case 260:
+                for (int i = 1; i < 4; i++) Units_Remove(sov[i]);
+                break;
+            case 300:
+                Units_Remove(sov[0]);
+                break;
+            case 330:
+                Buildings_Remove(sovBld1);
+                break;
+            case 360:
+                Buildings_Remove(sovBld2);
+                break;
+            case 380:  // Back under power
+                Buildings_Remove(secondPower);
+                break;
+        }
+
+        Units_Update();
+        Mission_UpdateTimer();
+        Mission_ProcessTriggers(&g_mission, frame);
+
+        for (int t = 0; t < TRIGGER_COUNT; t++) {
+            int count = Mission_GetTriggerFireCount(TRIGGER_NAMES[t]);
+            for (int n = lastCounts[t]; n < count; n++) {
+                run.fires.push_back({frame, t});
+            }
+            lastCounts[t] = count;
+        }
+    }
+
+    run.evaluations = Mission_GetTriggerEvaluations() - baseEvaluations;
+    Mission_SetTriggerPolling(0);
+    return run;
+}
+
+//===========================================================================
+// Tests
+//===========================================================================
+
+static const int SCENARIO_FRAMES = 480;
+
+TEST(fires_on_same_frames_as_polling) {
+    RunResult polled = RunScenario(true, SCENARIO_FRAMES);
+    RunResult evented = RunScenario(false, SCENARIO_FRAMES);
+
+    size_t n = polled.fires.size() < evented.fires.size() ?
+               polled.fires.size() : evented.fires.size();
+    for (size_t i = 0; i < n; i++) {
+        const FireEvent& a = polled.fires[i];
+        const FireEvent& b = evented.fires[i];
+        if (a.frame != b.frame || a.trigger != b.trigger) {
+            printf("\n    polled '%s' @%d vs evented '%s' @%d\n    ",
+                   TRIGGER_NAMES[a.trigger], a.frame,
+                   TRIGGER_NAMES[b.trigger], b.frame);
+        }
+        ASSERT_EQ(a.frame, b.frame);
+        ASSERT_EQ(a.trigger, b.trigger);
+    }
+    ASSERT_EQ(polled.fires.size(), evented.fires.size());
+
+    // Every trigger in the scenario has to fire, or the comparison
+    // doesn't cover it
+    std::vector<int> firstFrame(TRIGGER_COUNT, -1);
+    for (const FireEvent& f : evented.fires) {
+        if (firstFrame[f.trigger] < 0) firstFrame[f.trigger] = f.frame;
+    }
+    for (int t = 0; t < TRIGGER_COUNT; t++) {
+        if (firstFrame[t] < 0) printf("\n    '%s' never fired\n    ",
+                                      TRIGGER_NAMES[t]);
+        ASSERT(firstFrame[t] >= 0);
+    }
+
+    printf("\n    %zu firings; %d condition checks polled, %d event-driven\n    ",
+           evented.fires.size(), polled.evaluations, evented.evaluations);
+    ASSERT(evented.evaluations * 4 < polled.evaluations);
+}
+
+TEST(trigger_name_lookup_is_case_insensitive) {
+    RunScenario(false, 10);
+    ASSERT_EQ(Mission_GetTriggerFireCount("any"), 1);
+    ASSERT_EQ(Mission_GetTriggerFireCount("ANY"), 1);
+    ASSERT_EQ(Mission_GetTriggerFireCount("Any"), 1);
+    ASSERT_EQ(Mission_GetTriggerFireCount("anyx"), 0);
+    ASSERT_EQ(Mission_GetTriggerFireCount(""), 0);
+
+    // Object notifications go through the same index
+    ASSERT_EQ(Mission_GetTriggerFireCount("attacked"), 0);
+    Mission_TriggerAttacked("ATTACKED");
+    Mission_ProcessTriggers(&g_mission, 10);
+    ASSERT_EQ(Mission_GetTriggerFireCount("attacked"), 1);
+}
+
+TEST(team_counts_track_spawn_and_removal) {
+    RunScenario(false, 1);
+    Units_Clear();
+    ASSERT_EQ(Units_CountByTeam(TEAM_PLAYER), 0);
+    ASSERT_EQ(Buildings_CountByTeam(TEAM_ENEMY), 0);
+
+    int ids[20];
+    for (int i = 0; i < 20; i++) {
+        ids[i] = SpawnAt(UNIT_RIFLE, (i & 1) ? TEAM_ENEMY : TEAM_PLAYER,
+                         4 + i, 30);
+    }
+    ASSERT_EQ(Units_CountByTeam(TEAM_PLAYER), 10);
+    ASSERT_EQ(Units_CountByTeam(TEAM_ENEMY), 10);
+
+    // Removing twice must not count twice
+    Units_Remove(ids[1]);
+    Units_Remove(ids[1]);
+    Units_Remove(ids[2]);
+    ASSERT_EQ(Units_CountByTeam(TEAM_PLAYER), 9);
+    ASSERT_EQ(Units_CountByTeam(TEAM_ENEMY), 9);
+
+    int a = Buildings_Spawn(BUILDING_POWER, TEAM_ENEMY, 4, 40);
+    Buildings_Spawn(BUILDING_RADAR, TEAM_ENEMY, 8, 40);
+    ASSERT_EQ(Buildings_CountByTeam(TEAM_ENEMY), 2);
+    ASSERT_EQ(Buildings_CountByTeamType(TEAM_ENEMY, BUILDING_RADAR), 1);
+    Buildings_Remove(a);
+    Buildings_Remove(a);
+    ASSERT_EQ(Buildings_CountByTeam(TEAM_ENEMY), 1);
+    ASSERT_EQ(Buildings_CountByTeamType(TEAM_ENEMY, BUILDING_POWER), 0);
+}
+
+TEST(reset_cache_reevaluates_every_trigger) {
+    RunScenario(false, 60);
+
+    // A quiet frame only looks at triggers that poll or are armed
+    int before = Mission_GetTriggerEvaluations();
+    Mission_ProcessTriggers(&g_mission, 60);
+    int quiet = Mission_GetTriggerEvaluations() - before;
+
+    // After a reset (as on loading a game) every condition is checked
+    // again, as many as a polled frame
+    Mission_ResetTriggerCache();
+    before = Mission_GetTriggerEvaluations();
+    Mission_ProcessTriggers(&g_mission, 61);
+    int reset = Mission_GetTriggerEvaluations() - before;
+
+    Mission_SetTriggerPolling(1);
+    before = Mission_GetTriggerEvaluations();
+    Mission_ProcessTriggers(&g_mission, 62);
+    int polled = Mission_GetTriggerEvaluations() - before;
+    Mission_SetTriggerPolling(0);
+
+    ASSERT(reset > quiet);
+    ASSERT_EQ(reset, polled);
+}
+
+//===========================================================================
+// Main
+//===========================================================================
+
+int main() {
+    printf("Red Alert Mission Trigger Tests\n");
+    printf("===============================\n\n");
+
+    RUN_TEST(fires_on_same_frames_as_polling);
+    RUN_TEST(trigger_name_lookup_is_case_insensitive);
+    RUN_TEST(team_counts_track_spawn_and_removal);
+    RUN_TEST(reset_cache_reevaluates_every_trigger);
+
+    printf("\nResults: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
+    return g_testsFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,466 @@
+/**
+ * Red Alert macOS Port - Memory-Mapped MIX Tests
+ *
+ * Builds synthetic MIX archives (a parent holding nested MIXes, in both
+ * the C&C and Red Alert header layouts) and checks that MixView returns
+ * the right bytes as spans into the mapping, that nested archives share
+ * the parent's mapping and outlive it, and that malformed headers are
+ * rejected. Then compares startup cost against the old copy-out path,
+ * which pulled every nested archive into the heap before use: each mode
+ * runs in a forked child so peak RSS is measured independently.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "assets/mixview.h"
+
+// Simple test framework
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    int failedBefore = g_testsFailed; \
+    printf("  %s... ", #name); \
+    test_##name(); \
+    if (g_testsFailed == failedBefore) { \
+        printf("OK\n"); \
+        g_testsPassed++; \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) do { \
+    if ((a) != (b)) { \
+        printf("FAILED at line %d: %s != %s (%d vs %d)\n", \
+               __LINE__, #a, #b, (int)(a), (int)(b)); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+//===========================================================================
+// Fixture Builder
+//===========================================================================
+
+// CRCs are arbitrary here; MixView never hashes names itself
+static uint32_t NestedCrc(int n) { return 0x10000000u + (uint32_t)n * 0x01010101u; }
+static uint32_t FileCrc(int n, int f) { return 0x80000000u + (uint32_t)n * 0x1000u + (uint32_t)f * 7u; }
+
+// Recognisable contents so any misplaced span shows up
+static uint8_t FileByte(int n, int f, size_t i) {
+    return (uint8_t)(i * 31u + (uint32_t)n * 17u + (uint32_t)f * 5u);
+}
+
+static void PutLE16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back((uint8_t)v);
+    out.push_back((uint8_t)(v >> 8));
+}
+
+static void PutLE32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; i++) out.push_back((uint8_t)(v >> (i * 8)));
+}
+
+struct FixtureFile {
+    uint32_t crc;
+    std::vector<uint8_t> data;
+};
+
+// Pack files into a MIX; entries are written in reverse CRC order so
+// lookups can't rely on the header already being sorted
+static std::vector<uint8_t> BuildMix(const std::vector<FixtureFile>& files,
+                                     bool redAlertHeader) {
+    std::vector<uint8_t> out;
+    if (redAlertHeader) PutLE32(out, 0);    // No flags
+
+    uint32_t bodySize = 0;
+    for (const FixtureFile& f : files) bodySize += (uint32_t)f.data.size();
+    PutLE16(out, (uint16_t)files.size());
+    PutLE32(out, bodySize);
+
+    std::vector<uint32_t> offsets(files.size());
+    uint32_t offset = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        offsets[i] = offset;
+        offset += (uint32_t)files[i].data.size();
+    }
+    for (size_t i = files.size(); i-- > 0;) {
+        PutLE32(out, files[i].crc);
+        PutLE32(out, offsets[i]);
+        PutLE32(out, (uint32_t)files[i].data.size());
+    }
+    for (const FixtureFile& f : files) {
+        out.insert(out.end(), f.data.begin(), f.data.end());
+    }
+    return out;
+}
+
+static std::vector<uint8_t> BuildNested(int n, int fileCount, size_t fileSize,
+                                        bool redAlertHeader) {
+    std::vector<FixtureFile> files(fileCount);
+    for (int f = 0; f < fileCount; f++) {
+        files[f].crc = FileCrc(n, f);
+        files[f].data.resize(fileSize + (size_t)f);    // Uneven sizes
+        for (size_t i = 0; i < files[f].data.size(); i++) {
+            files[f].data[i] = FileByte(n, f, i);
+        }
+    }
+    return BuildMix(files, redAlertHeader);
+}
+
+static std::vector<uint8_t> BuildParent(int nestedCount, int fileCount,
+                                        size_t fileSize) {
+    std::vector<FixtureFile> nested(nestedCount);
+    for (int n = 0; n < nestedCount; n++) {
+        nested[n].crc = NestedCrc(n);
+        nested[n].data = BuildNested(n, fileCount, fileSize, (n & 1) != 0);
+    }
+    return BuildMix(nested, true);
+}
+
+static bool WriteFixture(const char* path, const std::vector<uint8_t>& bytes) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    fclose(f);
+    return ok;
+}
+
+static bool SpanMatches(std::span<const uint8_t> span, int n, int f,
+                        size_t expectSize) {
+    if (span.size() != expectSize) return false;
+    for (size_t i = 0; i < span.size(); i++) {
+        if (span[i] != FileByte(n, f, i)) return false;
+    }
+    return true;
+}
+
+static char g_fixturePath[64];
+
+//===========================================================================
+// Correctness Tests
+//===========================================================================
+
+TEST(open_file_parses_index) {
+    auto mix = MixView::OpenFile(g_fixturePath);
+    ASSERT(mix != nullptr);
+    ASSERT(mix->IsMapped());
+    ASSERT(!mix->IsEncrypted());
+    ASSERT_EQ(mix->Entries().size(), 4);
+
+    // Header order is preserved (reverse of the body layout)
+    ASSERT(mix->Entries()[0].crc == NestedCrc(3));
+    ASSERT(mix->FindEntry(NestedCrc(2)) != nullptr);
+    ASSERT(mix->FindEntry(0xDEADBEEF) == nullptr);
+    ASSERT(mix->Find(0xDEADBEEF).empty());
+}
+
+TEST(nested_views_share_mapping) {
+    auto mix = MixView::OpenFile(g_fixturePath);
+    ASSERT(mix != nullptr);
+
+    std::span<const uint8_t> whole = mix->Bytes();
+    for (int n = 0; n < 4; n++) {
+        auto nested = mix->OpenNested(NestedCrc(n));
+        ASSERT(nested != nullptr);
+        ASSERT(nested->IsMapped());
+
+        // The nested archive is a window into the parent, not a copy
+        std::span<const uint8_t> bytes = nested->Bytes();
+        ASSERT(bytes.data() >= whole.data());
+        ASSERT(bytes.data() + bytes.size() <= whole.data() + whole.size());
+        ASSERT(bytes.data() == mix->Find(NestedCrc(n)).data());
+
+        for (int f = 0; f < 6; f++) {
+            std::span<const uint8_t> span = nested->Find(FileCrc(n, f));
+            ASSERT(span.data() >= bytes.data());
+            ASSERT(SpanMatches(span, n, f, 1000 + (size_t)f));
+        }
+    }
+}
+
+TEST(nested_outlives_parent) {
+    std::unique_ptr<MixView> nested;
+    {
+        auto mix = MixView::OpenFile(g_fixturePath);
+        ASSERT(mix != nullptr);
+        nested = mix->OpenNested(NestedCrc(1));
+        ASSERT(nested != nullptr);
+    }
+
+    // Mapping is reference counted, so the view still reads valid bytes
+    ASSERT(SpanMatches(nested->Find(FileCrc(1, 5)), 1, 5, 1005));
+}
+
+TEST(open_memory_ownership) {
+    std::vector<uint8_t> bytes = BuildNested(7, 3, 64, false);
+
+    // A failed parse must leave the caller's buffer alone
+    uint8_t* junk = (uint8_t*)malloc(16);
+    memset(junk, 0xFF, 16);
+    ASSERT(MixView::OpenMemory(junk, 16, true) == nullptr);
+    junk[0] = 0;    // Still ours to write and free
+    free(junk);
+
+    uint8_t* owned = (uint8_t*)malloc(bytes.size());
+    memcpy(owned, bytes.data(), bytes.size());
+    auto mix = MixView::OpenMemory(owned, bytes.size(), true);
+    ASSERT(mix != nullptr);
+    ASSERT(!mix->IsMapped());
+    ASSERT(mix->Find(FileCrc(7, 2)).data() >= owned);
+    ASSERT(SpanMatches(mix->Find(FileCrc(7, 2)), 7, 2, 66));
+}
+
+TEST(rejects_malformed_headers) {
+    std::vector<uint8_t> good = BuildNested(2, 4, 32, true);
+    ASSERT(MixView::OpenMemory(good.data(), good.size(), false) != nullptr);
+
+    // Truncated body
+    ASSERT(MixView::OpenMemory(good.data(), good.size() - 1, false) == nullptr);
+
+    // Truncated index
+    ASSERT(MixView::OpenMemory(good.data(), 12, false) == nullptr);
+
+    // Entry running past the body (first entry's size field)
+    std::vector<uint8_t> bad = good;
+    bad[4 + 6 + 8] = 0xFF;
+    bad[4 + 6 + 9] = 0xFF;
+    ASSERT(MixView::OpenMemory(bad.data(), bad.size(), false) == nullptr);
+
+    // Unknown flag bits
+    bad = good;
+    bad[3] = 0x80;
+    ASSERT(MixView::OpenMemory(bad.data(), bad.size(), false) == nullptr);
+
+    // Encrypted flag over a garbage key block must fail cleanly
+    bad = good;
+    bad[2] = 0x02;
+    bad.resize(bad.size() + 128, 0x5A);
+    ASSERT(MixView::OpenMemory(bad.data(), bad.size(), false) == nullptr);
+}
+
+//===========================================================================
+// Startup Cost: Copy-Out vs Mapped Views
+//===========================================================================
+
+// Sized like the CD layout: a few large nested archives, of which
+// startup only reads headers and a handful of files
+constexpr int BENCH_NESTED = 6;
+constexpr int BENCH_FILES = 48;
+constexpr size_t BENCH_FILE_SIZE = 256 * 1024;
+constexpr int BENCH_READS = 4;      // Files looked at per nested archive
+
+struct StartupResult {
+    double ms;
+    long peakKb;
+    long privateKb;     // Heap still held once startup is done; -1 if unknown
+    uint32_t checksum;
+};
+
+static long PeakRssKb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;     // Bytes on macOS
+#else
+    return usage.ru_maxrss;            // Kilobytes on Linux
+#endif
+}
+
+// Mapped file pages count toward RSS (the kernel may map whole large
+// folios on a fault) but are clean page cache it can drop at will; what
+// the copy-out path really costs is private memory
+static long PrivateRssKb() {
+#ifdef __linux__
+    FILE* f = fopen("/proc/self/status", "r");
+    if (!f) return -1;
+    char line[256];
+    long kb = -1;
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "RssAnon: %ld", &kb) == 1) break;
+    }
+    fclose(f);
+    return kb;
+#else
+    return -1;
+#endif
+}
+
+// Previous behaviour: each nested archive is read into a heap buffer in
+// full, and every file read is another copy out of that buffer
+static uint32_t StartupCopyOut(std::vector<std::unique_ptr<MixView>>& keep) {
+    FILE* f = fopen(g_fixturePath, "rb");
+    if (!f) return 0;
+
+    // Parent index only (Red Alert layout, no flags); the body stays on disk
+    uint8_t head[10];
+    if (fread(head, 1, sizeof(head), f) != sizeof(head)) {
+        fclose(f);
+        return 0;
+    }
+    uint16_t count = (uint16_t)(head[4] | (head[5] << 8));
+    std::vector<uint8_t> index((size_t)count * 12);
+    if (fread(index.data(), 1, index.size(), f) != index.size()) {
+        fclose(f);
+        return 0;
+    }
+    size_t bodyStart = sizeof(head) + index.size();
+    std::vector<MixView::Entry> entries(count);
+    for (uint16_t i = 0; i < count; i++) {
+        memcpy(&entries[i], &index[(size_t)i * 12], 12);     // Host is little-endian
+    }
+
+    uint32_t sum = 0;
+    for (int n = 0; n < BENCH_NESTED; n++) {
+        const MixView::Entry* e = nullptr;
+        for (const MixView::Entry& entry : entries) {
+            if (entry.crc == NestedCrc(n)) e = &entry;
+        }
+        if (!e) continue;
+
+        uint8_t* data = (uint8_t*)malloc(e->size);
+        fseek(f, (long)(bodyStart + e->offset), SEEK_SET);
+        if (fread(data, 1, e->size, f) != e->size) {
+            free(data);
+            continue;
+        }
+        auto nested = MixView::OpenMemory(data, e->size, true);
+        if (!nested) {
+            free(data);
+            continue;
+        }
+        for (int r = 0; r < BENCH_READS; r++) {
+            std::span<const uint8_t> span = nested->Find(FileCrc(n, r * 11));
+            std::vector<uint8_t> copy(span.begin(), span.end());
+            for (uint8_t b : copy) sum += b;
+        }
+        keep.push_back(std::move(nested));
+    }
+    fclose(f);
+    return sum;
+}
+
+// New behaviour: one mapping, nested archives are views, reads are spans
+static uint32_t StartupMapped(std::vector<std::unique_ptr<MixView>>& keep) {
+    auto parent = MixView::OpenFile(g_fixturePath);
+    if (!parent) return 0;
+
+    uint32_t sum = 0;
+    for (int n = 0; n < BENCH_NESTED; n++) {
+        auto nested = parent->OpenNested(NestedCrc(n));
+        if (!nested) continue;
+        for (int r = 0; r < BENCH_READS; r++) {
+            for (uint8_t b : nested->Find(FileCrc(n, r * 11))) sum += b;
+        }
+        keep.push_back(std::move(nested));
+    }
+    return sum;
+}
+
+// Run one mode in a fresh child so its peak RSS isn't polluted by the other
+static bool MeasureStartup(bool mapped, StartupResult* result) {
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+
+    pid_t pid = fork();
+    if (pid < 0) return false;
+    if (pid == 0) {
+        close(fds[0]);
+        StartupResult r;
+        long before = PeakRssKb();
+        long privateBefore = PrivateRssKb();
+        std::vector<std::unique_ptr<MixView>> keep;
+        auto t0 = std::chrono::steady_clock::now();
+        r.checksum = mapped ? StartupMapped(keep) : StartupCopyOut(keep);
+        auto t1 = std::chrono::steady_clock::now();
+        r.ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        r.peakKb = PeakRssKb() - before;
+        r.privateKb = privateBefore < 0 ? -1 : PrivateRssKb() - privateBefore;
+        bool ok = write(fds[1], &r, sizeof(r)) == (ssize_t)sizeof(r);
+        _exit(ok ? 0 : 1);
+    }
+
+    close(fds[1]);
+    bool ok = read(fds[0], result, sizeof(*result)) == (ssize_t)sizeof(*result);
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+TEST(startup_cost) {
+    char path[64];
+    snprintf(path, sizeof(path), "%s", g_fixturePath);
+    snprintf(g_fixturePath, sizeof(g_fixturePath), "/tmp/test_mix_mmap_big_%d.mix",
+             (int)getpid());
+    std::vector<uint8_t> bytes = BuildParent(BENCH_NESTED, BENCH_FILES, BENCH_FILE_SIZE);
+    bool written = WriteFixture(g_fixturePath, bytes);
+    size_t totalSize = bytes.size();
+    bytes.clear();
+    bytes.shrink_to_fit();
+
+    StartupResult copyOut = {}, mapped = {};
+    bool ok = written && MeasureStartup(false, &copyOut) &&
+              MeasureStartup(true, &mapped);
+    remove(g_fixturePath);
+    snprintf(g_fixturePath, sizeof(g_fixturePath), "%s", path);
+    ASSERT(ok);
+
+    printf("\n    archive %.1f MB, %d nested, %d reads each\n",
+           totalSize / (1024.0 * 1024.0), BENCH_NESTED, BENCH_READS);
+    printf("    %-10s %10s %14s %14s\n", "mode", "startup ms", "peak RSS +KB",
+           "private +KB");
+    printf("    %-10s %10.2f %14ld %14ld\n", "copy-out", copyOut.ms,
+           copyOut.peakKb, copyOut.privateKb);
+    printf("    %-10s %10.2f %14ld %14ld\n    ", "mapped", mapped.ms,
+           mapped.peakKb, mapped.privateKb);
+
+    // Same bytes read either way, for less memory
+    ASSERT(copyOut.checksum != 0);
+    ASSERT(mapped.checksum == copyOut.checksum);
+    ASSERT(mapped.peakKb < copyOut.peakKb);
+    if (mapped.privateKb >= 0) ASSERT(mapped.privateKb < copyOut.privateKb / 8);
+}
+
+//===========================================================================
+// Main
+//===========================================================================
+
+int main() {
+    printf("Red Alert MIX Memory-Map Tests\n");
+    printf("==============================\n\n");
+
+    snprintf(g_fixturePath, sizeof(g_fixturePath), "/tmp/test_mix_mmap_%d.mix",
+             (int)getpid());
+    if (!WriteFixture(g_fixturePath, BuildParent(4, 6, 1000))) {
+        printf("Could not write fixture %s\n", g_fixturePath);
+        return 1;
+    }
+
+    RUN_TEST(open_file_parses_index);
+    RUN_TEST(nested_views_share_mapping);
+    RUN_TEST(nested_outlives_parent);
+    RUN_TEST(open_memory_ownership);
+    RUN_TEST(rejects_malformed_headers);
+    RUN_TEST(startup_cost);
+
+    remove(g_fixturePath);
+
+    printf("\nResults: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
+    return g_testsFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,448 @@
+/**
+ * Red Alert macOS Port - Realtime Mixer Tests
+ *
+ * Exercises the wwd-media mixing core without CoreAudio: command
+ * application at buffer boundaries, channel exhaustion, a full queue,
+ * and a stress run where the game thread hammers commands while an
+ * output thread renders flat out. On Linux the pthread lock entry points
+ * are interposed so any lock taken inside Wwd_Mixer_Render is counted.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include <wwd/mixer.h>
+
+#ifdef __linux__
+#include <dlfcn.h>
+#include <pthread.h>
+#define MIXER_LOCK_PROBE 1
+#endif
+
+// Simple test framework
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    int failedBefore = g_testsFailed; \
+    printf("  %s... ", #name); \
+    test_##name(); \
+    if (g_testsFailed == failedBefore) { \
+        printf("OK\n"); \
+        g_testsPassed++; \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) do { \
+    if ((a) != (b)) { \
+        printf("FAILED at line %d: %s != %s (%d vs %d)\n", \
+               __LINE__, #a, #b, (int)(a), (int)(b)); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+static uint32_t g_rng = 31337;
+static int TestRand(int range) {
+    g_rng = g_rng * 1103515245u + 12345u;
+    return (int)((g_rng >> 8) % (uint32_t)range);
+}
+
+//===========================================================================
+// Lock Probe
+//===========================================================================
+
+// Set while the current thread is inside Wwd_Mixer_Render
+static thread_local bool t_inMixPath = false;
+static std::atomic<int> g_locksInMixPath{0};
+
+#if MIXER_LOCK_PROBE
+
+typedef int (*MutexFn)(pthread_mutex_t*);
+typedef int (*RwlockFn)(pthread_rwlock_t*);
+typedef int (*SpinFn)(pthread_spinlock_t*);
+static MutexFn g_realMutexLock;
+static MutexFn g_realMutexTrylock;
+static RwlockFn g_realRdlock;
+static RwlockFn g_realWrlock;
+static SpinFn g_realSpinLock;
+
+// Resolved before any thread starts so the wrappers never call dlsym
+static void InstallLockProbe() {
+    g_realMutexLock = (MutexFn)dlsym(RTLD_NEXT, "pthread_mutex_lock");
+    g_realMutexTrylock = (MutexFn)dlsym(RTLD_NEXT, "pthread_mutex_trylock");
+    g_realRdlock = (RwlockFn)dlsym(RTLD_NEXT, "pthread_rwlock_rdlock");
+    g_realWrlock = (RwlockFn)dlsym(RTLD_NEXT, "pthread_rwlock_wrlock");
+    g_realSpinLock = (SpinFn)dlsym(RTLD_NEXT, "pthread_spin_lock");
+}
+
+static inline void NoteLock() {
+    if (t_inMixPath) g_locksInMixPath.fetch_add(1, std::memory_order_relaxed);
+}
+
+extern "C" int pthread_mutex_lock(pthread_mutex_t* m) {
+    NoteLock();
+    return g_realMutexLock(m);
+}
+
+extern "C" int pthread_mutex_trylock(pthread_mutex_t* m) {
+    NoteLock();
+    return g_realMutexTrylock(m);
+}
+
+extern "C" int pthread_rwlock_rdlock(pthread_rwlock_t* l) {
+    NoteLock();
+    return g_realRdlock(l);
+}
+
+extern "C" int pthread_rwlock_wrlock(pthread_rwlock_t* l) {
+    NoteLock();
+    return g_realWrlock(l);
+}
+
+extern "C" int pthread_spin_lock(pthread_spinlock_t* l) {
+    NoteLock();
+    return g_realSpinLock(l);
+}
+
+#else
+
+static void InstallLockProbe() {}
+
+#endif
+
+static void ProbedRender(WwdMixer* mixer, float* left, float* right,
+                         uint32_t frames) {
+    t_inMixPath = true;
+    Wwd_Mixer_Render(mixer, left, right, frames);
+    t_inMixPath = false;
+}
+
+//===========================================================================
+// Test Samples
+//===========================================================================
+
+struct TestSample {
+    std::vector<int16_t> pcm;
+    WwdAudioSample sample;
+};
+
+// Constant-level mono sample at the output rate, so frame N of the
+// source lands exactly on output frame N
+static void MakeDcSample(TestSample* ts, int16_t level, uint32_t frames) {
+    ts->pcm.assign(frames, level);
+    ts->sample.data = (uint8_t*)ts->pcm.data();
+    ts->sample.dataSize = frames * sizeof(int16_t);
+    ts->sample.sampleRate = WWD_MIXER_SAMPLE_RATE;
+    ts->sample.channels = 1;
+    ts->sample.bitsPerSample = 16;
+}
+
+static bool Near(float a, float b) {
+    return fabsf(a - b) < 1e-4f;
+}
+
+// Expected output for one DC channel at the given volume and pan
+static void ExpectedLevels(float level, uint8_t volume, int8_t pan,
+                           float* left, float* right) {
+    float vol = level * (float)volume / 255.0f;
+    float panNorm = (float)(pan + 128) / 255.0f;
+    *left = vol * (1.0f - panNorm * 0.5f);
+    *right = vol * (0.5f + panNorm * 0.5f);
+}
+
+constexpr uint32_t BUFFER = 256;
+
+//===========================================================================
+// Tests
+//===========================================================================
+
+TEST(commands_apply_at_buffer_start) {
+    static WwdMixer mixer;
+    Wwd_Mixer_Init(&mixer);
+    TestSample dc;
+    MakeDcSample(&dc, 16384, 44100);
+    float left[BUFFER], right[BUFFER];
+
+    WwdSoundHandle h = Wwd_Mixer_Play(&mixer, &dc.sample, 255, 0, false);
+    ASSERT(h != 0);
+
+    // Queued but not yet rendered still counts as playing
+    ASSERT(Wwd_Mixer_IsPlaying(&mixer, h));
+    ASSERT_EQ(Wwd_Mixer_GetPlayingCount(&mixer), 0);
+
+    float el, er;
+    ProbedRender(&mixer, left, right, BUFFER);
+    ExpectedLevels(0.5f, 255, 0, &el, &er);
+    ASSERT(Near(left[0], el) && Near(right[BUFFER - 1], er));
+    ASSERT_EQ(Wwd_Mixer_GetPlayingCount(&mixer), 1);
+
+    // Volume and pan land together on the next buffer, for every frame
+    Wwd_Mixer_SetVolume(&mixer, h, 128);
+    Wwd_Mixer_SetPan(&mixer, h, -128);
+    ProbedRender(&mixer, left, right, BUFFER);
+    ExpectedLevels(0.5f, 128, -128, &el, &er);
+    ASSERT(Near(left[0], el) && Near(right[0], er));
+    ASSERT(Near(left[BUFFER - 1], el) && Near(right[BUFFER - 1], er));
+
+    // Master and sound volume scale every channel
+    mixer.soundVolume.store(0);
+    ProbedRender(&mixer, left, right, BUFFER);
+    ASSERT(left[0] == 0.0f && right[0] == 0.0f);
+    mixer.soundVolume.store(255);
+
+    Wwd_Mixer_Stop(&mixer, h);
+    ProbedRender(&mixer, left, right, BUFFER);
+    ASSERT(left[0] == 0.0f && right[BUFFER - 1] == 0.0f);
+    ASSERT(!Wwd_Mixer_IsPlaying(&mixer, h));
+    ASSERT_EQ(Wwd_Mixer_GetPlayingCount(&mixer), 0);
+}
+
+TEST(sound_finishes_mid_buffer) {
+    static WwdMixer mixer;
+    Wwd_Mixer_Init(&mixer);
+    TestSample dc;
+    MakeDcSample(&dc, 16384, 100);
+    float left[BUFFER], right[BUFFER];
+
+    WwdSoundHandle h = Wwd_Mixer_Play(&mixer, &dc.sample, 255, 0, false);
+    ProbedRender(&mixer, left, right, BUFFER);
+    ASSERT(left[99] != 0.0f);
+    ASSERT(left[100] == 0.0f);
+    ASSERT(!Wwd_Mixer_IsPlaying(&mixer, h));
+
+    // A looping sound wraps instead
+    WwdSoundHandle loop = Wwd_Mixer_Play(&mixer, &dc.sample, 255, 0, true);
+    ProbedRender(&mixer, left, right, BUFFER);
+    ASSERT(left[150] != 0.0f);
+    ASSERT(Wwd_Mixer_IsPlaying(&mixer, loop));
+}
+
+TEST(all_channels_busy_drops_sound) {
+    static WwdMixer mixer;
+    Wwd_Mixer_Init(&mixer);
+    TestSample dc;
+    MakeDcSample(&dc, 1000, 44100);
+    float left[BUFFER], right[BUFFER];
+
+    WwdSoundHandle handles[WWD_AUDIO_MAX_CHANNELS + 1];
+    for (int i = 0; i <= WWD_AUDIO_MAX_CHANNELS; i++) {
+        handles[i] = Wwd_Mixer_Play(&mixer, &dc.sample, 255, 0, false);
+        ASSERT(handles[i] != 0);
+    }
+    ProbedRender(&mixer, left, right, BUFFER);
+
+    ASSERT_EQ(Wwd_Mixer_GetPlayingCount(&mixer), WWD_AUDIO_MAX_CHANNELS);
+    ASSERT(Wwd_Mixer_IsPlaying(&mixer, handles[0]));
+    ASSERT(!Wwd_Mixer_IsPlaying(&mixer, handles[WWD_AUDIO_MAX_CHANNELS]));
+}
+
+TEST(full_queue_refuses_commands) {
+    static WwdMixer mixer;
+    Wwd_Mixer_Init(&mixer);
+    TestSample dc;
+    MakeDcSample(&dc, 1000, 100);
+
+    // Nothing renders, so the ring fills and the poster gives up
+    for (uint32_t i = 0; i < WWD_MIXER_QUEUE_SIZE; i++) {
+        ASSERT(Wwd_Mixer_Play(&mixer, &dc.sample, 255, 0, false) != 0);
+    }
+    ASSERT(Wwd_Mixer_Play(&mixer, &dc.sample, 255, 0, false) == 0);
+    ASSERT(!Wwd_Mixer_Sync(&mixer, 1));
+
+    float left[BUFFER], right[BUFFER];
+    ProbedRender(&mixer, left, right, BUFFER);
+    ASSERT(Wwd_Mixer_Sync(&mixer, 1));
+    ASSERT(Wwd_Mixer_Play(&mixer, &dc.sample, 255, 0, false) != 0);
+}
+
+TEST(lock_probe_sees_locks) {
+#if MIXER_LOCK_PROBE
+    // The probe has to catch a real lock or a zero count proves nothing
+    std::mutex m;
+    int before = g_locksInMixPath.load();
+    t_inMixPath = true;
+    m.lock();
+    m.unlock();
+    t_inMixPath = false;
+    ASSERT(g_locksInMixPath.load() > before);
+    g_locksInMixPath.store(0);
+#else
+    printf("(lock probe unavailable on this platform) ");
+#endif
+}
+
+// Music source that records whether it's called after being replaced
+static std::atomic<int> g_musicCalls{0};
+static std::atomic<bool> g_musicRetired{false};
+static std::atomic<int> g_musicCallsAfterRetire{0};
+
+static int TestMusicCallback(int16_t* buffer, int sampleCount, void*) {
+    g_musicCalls.fetch_add(1, std::memory_order_relaxed);
+    if (g_musicRetired.load(std::memory_order_relaxed)) {
+        g_musicCallsAfterRetire.fetch_add(1, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < sampleCount; i++) buffer[i] = (int16_t)(i * 64);
+    return sampleCount;
+}
+
+struct OutputThreadState {
+    WwdMixer* mixer;
+    std::atomic<bool> running;
+    std::atomic<uint64_t> buffers;
+    double worstUs;
+};
+
+static void StressOutputThread(OutputThreadState* state) {
+    float left[BUFFER], right[BUFFER];
+    while (state->running.load(std::memory_order_acquire)) {
+        auto t0 = std::chrono::steady_clock::now();
+        ProbedRender(state->mixer, left, right, BUFFER);
+        auto t1 = std::chrono::steady_clock::now();
+        double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        if (us > state->worstUs) state->worstUs = us;
+        state->buffers.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+TEST(hammer_commands_from_game_thread) {
+    static WwdMixer mixer;
+    Wwd_Mixer_Init(&mixer);
+    g_locksInMixPath.store(0);
+
+    TestSample samples[4];
+    for (int i = 0; i < 4; i++) {
+        MakeDcSample(&samples[i], (int16_t)(2000 * (i + 1)), 200 + i * 700);
+    }
+    samples[3].sample.sampleRate = 22050;     // Exercise resampling
+
+    OutputThreadState state;
+    state.mixer = &mixer;
+    state.running.store(true);
+    state.buffers.store(0);
+    state.worstUs = 0.0;
+    std::thread output(StressOutputThread, &state);
+
+    std::vector<WwdSoundHandle> live;
+    int commands = 0;
+    Wwd_Mixer_SetMusic(&mixer, TestMusicCallback, nullptr);
+
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(400);
+    while (std::chrono::steady_clock::now() < end) {
+        int op = TestRand(100);
+        if (op < 40 || live.empty()) {
+            WwdSoundHandle h = Wwd_Mixer_Play(&mixer, &samples[TestRand(4)].sample,
+                                              (uint8_t)TestRand(256),
+                                              (int8_t)(TestRand(256) - 128),
+                                              TestRand(4) == 0);
+            if (h) live.push_back(h);
+        } else if (op < 60) {
+            size_t i = (size_t)TestRand((int)live.size());
+            Wwd_Mixer_Stop(&mixer, live[i]);
+            live[i] = live.back();
+            live.pop_back();
+        } else if (op < 75) {
+            Wwd_Mixer_SetVolume(&mixer, live[TestRand((int)live.size())],
+                                (uint8_t)TestRand(256));
+        } else if (op < 90) {
+            Wwd_Mixer_SetPan(&mixer, live[TestRand((int)live.size())],
+                             (int8_t)(TestRand(256) - 128));
+        } else if (op < 92) {
+            Wwd_Mixer_StopAll(&mixer);
+            live.clear();
+        } else {
+            // Queries are the other half of the game thread's traffic
+            for (WwdSoundHandle h : live) (void)Wwd_Mixer_IsPlaying(&mixer, h);
+            (void)Wwd_Mixer_GetPlayingCount(&mixer);
+        }
+        commands++;
+        if (live.size() > 64) live.erase(live.begin(), live.begin() + 32);
+    }
+
+    // Once Sync returns, the old music callback must never run again
+    Wwd_Mixer_SetMusic(&mixer, nullptr, nullptr);
+    ASSERT(Wwd_Mixer_Sync(&mixer, 1000));
+    g_musicRetired.store(true);
+
+    Wwd_Mixer_StopAll(&mixer);
+    ASSERT(Wwd_Mixer_Sync(&mixer, 1000));
+    uint64_t settled = state.buffers.load();
+    while (state.buffers.load() < settled + 2) std::this_thread::yield();
+
+    state.running.store(false);
+    output.join();
+
+    printf("\n    %d commands over %llu buffers, worst render %.1f us\n    ",
+           commands, (unsigned long long)state.buffers.load(), state.worstUs);
+
+    ASSERT(commands > 1000);
+    ASSERT(state.buffers.load() > 100);
+    ASSERT(g_musicCalls.load() > 0);
+    ASSERT_EQ(g_musicCallsAfterRetire.load(), 0);
+    ASSERT_EQ(Wwd_Mixer_GetPlayingCount(&mixer), 0);
+    for (WwdSoundHandle h : live) ASSERT(!Wwd_Mixer_IsPlaying(&mixer, h));
+    ASSERT_EQ(g_locksInMixPath.load(), 0);
+}
+
+TEST(null_output_renders) {
+    static WwdMixer mixer;
+    Wwd_Mixer_Init(&mixer);
+    TestSample dc;
+    MakeDcSample(&dc, 3000, 44100);
+    for (int i = 0; i < WWD_AUDIO_MAX_CHANNELS; i++) {
+        Wwd_Mixer_Play(&mixer, &dc.sample, 200, (int8_t)(i * 8 - 64), true);
+    }
+
+    // Flat out, to measure the cost of a full 16-channel buffer
+    static WwdNullOutput output;
+    ASSERT(Wwd_NullOutput_Start(&output, &mixer, 512, false));
+    auto t0 = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    Wwd_NullOutput_Stop(&output);
+    auto t1 = std::chrono::steady_clock::now();
+
+    uint64_t buffers = output.buffersRendered.load();
+    double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    printf("\n    16 channels, 512 frames: %.1f us per buffer "
+           "(device budget %.0f us)\n    ",
+           us / (double)buffers, 512.0 * 1e6 / WWD_MIXER_SAMPLE_RATE);
+
+    ASSERT(buffers > 0);
+    ASSERT_EQ(Wwd_Mixer_GetPlayingCount(&mixer), WWD_AUDIO_MAX_CHANNELS);
+}
+
+//===========================================================================
+// Main
+//===========================================================================
+
+int main() {
+    printf("Red Alert Realtime Mixer Tests\n");
+    printf("==============================\n\n");
+
+    InstallLockProbe();
+
+    RUN_TEST(commands_apply_at_buffer_start);
+    RUN_TEST(sound_finishes_mid_buffer);
+    RUN_TEST(all_channels_busy_drops_sound);
+    RUN_TEST(full_queue_refuses_commands);
+    RUN_TEST(lock_probe_sees_locks);
+    RUN_TEST(hammer_commands_from_game_thread);
+    RUN_TEST(null_output_renders);
+
+    printf("\nResults: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
+    return g_testsFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,489 @@
+/**
+ * Red Alert macOS Port - Cell Occupancy Index Tests
+ *
+ * Drives the unit simulation and checks after every tick that each
+ * cell's occupant list matches a brute-force scan of the unit table.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+
+#include "game/units.h"
+#include "game/map.h"
+#include "game/flowfield.h"
+#include "game/pathcache.h"
+#include "game/mission.h"
+#include "game/sprites.h"
+#include "game/sounds.h"
+#include "game/terrain.h"
+#include "graphics/metal/renderer.h"
+
+//===========================================================================
+// Stubs for rendering, audio and mission hooks used by units.cpp
+//===========================================================================
+
+extern "C" {
+void Mission_TriggerAttacked(const char*) {}
+void Mission_TriggerDestroyed(const char*) {}
+void Mission_PostEvent(MissionEvent, int) {}
+void Sounds_PlayAt(SoundEffect, int, int, uint8_t) {}
+void Voice_PlayResponseAt(int, BOOL, ResponseType, VoiceVariant,
+                          int, int, uint8_t) {}
+BOOL Sprites_RenderUnit(UnitType, int, int, int, int, uint8_t) { return FALSE; }
+BOOL Sprites_RenderBuilding(BuildingType, int, int, int, uint8_t) { return FALSE; }
+void Wwd_Renderer_FillRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_PutPixel(int, int, uint8_t) {}
+void Wwd_Renderer_DrawLine(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_DrawRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_DrawCircle(int, int, int, uint8_t) {}
+void Wwd_Renderer_FillCircle(int, int, int, uint8_t) {}
+void Wwd_Renderer_SetAlpha(int, int, int, int, uint8_t) {}
+int Unit_GetPassengerCapacity(int unitType) {
+    return (unitType == UNIT_APC) ? 5 : 0;
+}
+}
+
+BOOL Terrain_Available(void) { return FALSE; }
+BOOL Terrain_RenderTile(int, int, int, int) { return FALSE; }
+BOOL Terrain_RenderByID(int, int, int, int) { return FALSE; }
+int Rules_GetGoldValue() { return 25; }
+int Rules_GetGemValue() { return 50; }
+
+// Simple test framework
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    int failedBefore = g_testsFailed; \
+    printf("  %s... ", #name); \
+    test_##name(); \
+    if (g_testsFailed == failedBefore) { \
+        printf("OK\n"); \
+        g_testsPassed++; \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) do { \
+    if ((a) != (b)) { \
+        printf("FAILED at line %d: %s != %s (%d vs %d)\n", \
+               __LINE__, #a, #b, (int)(a), (int)(b)); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+//===========================================================================
+// Brute-force reference
+//===========================================================================
+
+static bool IsInfantryType(int type) {
+    return type > UNIT_NONE && type < UNIT_HARVESTER;
+}
+
+// A unit belongs in the index when it is alive and standing on the map
+static bool ExpectRegistered(const Unit* unit) {
+    return unit->state != STATE_DYING && unit->transportId < 0;
+}
+
+// Returns the first mismatching cell index, or -1 if the index is exact
+static int VerifyOccupancy(void) {
+    static int expectedCount[MAP_MAX_WIDTH * MAP_MAX_HEIGHT];
+    int mapW = Map_GetWidth();
+    int mapH = Map_GetHeight();
+    memset(expectedCount, 0, sizeof(int) * mapW * mapH);
+
+    for (int i = 0; i < MAX_UNITS; i++) {
+        Unit* unit = Units_Get(i);
+        if (!unit || !ExpectRegistered(unit)) continue;
+
+        int cellX, cellY;
+        Map_WorldToCell(unit->worldX, unit->worldY, &cellX, &cellY);
+        MapCell* cell = Map_GetCell(cellX, cellY);
+        if (!cell) return cellY * mapW + cellX;
+        expectedCount[cellY * mapW + cellX]++;
+
+        // Every unit that fits inline must be listed with correct bits
+        if (cell->occupantCount > cell->occupantStored) continue;
+        bool found = false;
+        for (int k = 0; k < cell->occupantStored; k++) {
+            uint16_t occ = cell->occupants[k];
+            if (OCCUPANT_ID(occ) != i) continue;
+            if (OCCUPANT_TEAM(occ) != unit->team) return cellY * mapW + cellX;
+            if (((occ & OCCUPANT_INFANTRY) != 0) != IsInfantryType(unit->type)) {
+                return cellY * mapW + cellX;
+            }
+            found = true;
+        }
+        if (!found) return cellY * mapW + cellX;
+    }
+
+    for (int y = 0; y < mapH; y++) {
+        for (int x = 0; x < mapW; x++) {
+            MapCell* cell = Map_GetCell(x, y);
+            int expected = expectedCount[y * mapW + x];
+            int stored = expected < MAP_CELL_OCCUPANTS ? expected : MAP_CELL_OCCUPANTS;
+            if (cell->occupantCount != expected) return y * mapW + x;
+            if (cell->occupantStored != stored) return y * mapW + x;
+            int firstId = stored ? OCCUPANT_ID(cell->occupants[0]) : -1;
+            if (cell->unitId != firstId) return y * mapW + x;
+        }
+    }
+    return -1;
+}
+
+static void ResetWorld(int width, int height) {
+    Map_Init();
+    Map_Create(width, height);
+    Units_Init();
+}
+
+//===========================================================================
+// Tests
+//===========================================================================
+
+TEST(spawn_and_remove) {
+    ResetWorld(32, 32);
+
+    int a = Units_Spawn(UNIT_RIFLE, TEAM_PLAYER, 5 * CELL_SIZE + 12, 5 * CELL_SIZE + 12);
+    int b = Units_Spawn(UNIT_TANK_LIGHT, TEAM_ENEMY, 9 * CELL_SIZE + 12, 9 * CELL_SIZE + 12);
+    ASSERT(a >= 0 && b >= 0);
+    ASSERT_EQ(VerifyOccupancy(), -1);
+
+    MapCell* cell = Map_GetCell(5, 5);
+    ASSERT_EQ(cell->occupantCount, 1);
+    ASSERT_EQ(cell->unitId, a);
+    ASSERT(cell->occupants[0] & OCCUPANT_INFANTRY);
+    ASSERT_EQ(OCCUPANT_TEAM(cell->occupants[0]), TEAM_PLAYER);
+
+    Units_Remove(a);
+    ASSERT_EQ(cell->occupantCount, 0);
+    ASSERT_EQ(cell->unitId, -1);
+    ASSERT_EQ(VerifyOccupancy(), -1);
+}
+
+TEST(screen_pick_uses_lowest_id) {
+    ResetWorld(32, 32);
+
+    int wx = 10 * CELL_SIZE + 12;
+    int wy = 10 * CELL_SIZE + 12;
+    int a = Units_Spawn(UNIT_TANK_LIGHT, TEAM_PLAYER, wx, wy);
+    ASSERT(a >= 0);
+    int b = Units_Spawn(UNIT_TANK_LIGHT, TEAM_PLAYER, wx, wy);
+    ASSERT(b >= 0);
+
+    int sx, sy;
+    Map_WorldToScreen(wx, wy, &sx, &sy);
+    ASSERT_EQ(Units_GetAtScreen(sx, sy), a < b ? a : b);
+
+    Map_WorldToScreen(wx + 5 * CELL_SIZE, wy, &sx, &sy);
+    ASSERT_EQ(Units_GetAtScreen(sx, sy), -1);
+}
+
+TEST(transport_load_unload) {
+    ResetWorld(32, 32);
+
+    int apc = Units_Spawn(UNIT_APC, TEAM_PLAYER, 8 * CELL_SIZE + 12, 8 * CELL_SIZE + 12);
+    int inf = Units_Spawn(UNIT_RIFLE, TEAM_PLAYER, 9 * CELL_SIZE + 12, 8 * CELL_SIZE + 12);
+    ASSERT(apc >= 0 && inf >= 0);
+
+    ASSERT(Units_LoadIntoTransport(inf, apc));
+    ASSERT_EQ(Map_GetCell(9, 8)->occupantCount, 0);
+    ASSERT_EQ(VerifyOccupancy(), -1);
+
+    ASSERT_EQ(Units_UnloadTransport(apc), 1);
+    ASSERT_EQ(VerifyOccupancy(), -1);
+}
+
+TEST(overflow_cell) {
+    // A one-cell map leaves spawn nowhere else to put units, so they stack
+    ResetWorld(1, 1);
+
+    int ids[MAP_CELL_OCCUPANTS + 3];
+    int n = MAP_CELL_OCCUPANTS + 3;
+    for (int i = 0; i < n; i++) {
+        ids[i] = Units_Spawn((i & 1) ? UNIT_TANK_LIGHT : UNIT_RIFLE,
+                             (i & 1) ? TEAM_ENEMY : TEAM_PLAYER, 12, 12);
+        ASSERT(ids[i] >= 0);
+    }
+
+    MapCell* cell = Map_GetCell(0, 0);
+    ASSERT_EQ(cell->occupantCount, n);
+    ASSERT_EQ(cell->occupantStored, MAP_CELL_OCCUPANTS);
+    ASSERT_EQ(VerifyOccupancy(), -1);
+
+    // Draining the cell refills the inline list from the unit table
+    for (int i = 0; i < n; i++) {
+        Units_Remove(ids[i]);
+        ASSERT_EQ(VerifyOccupancy(), -1);
+    }
+    ASSERT_EQ(cell->occupantCount, 0);
+}
+
+TEST(convergence_stress) {
+    ResetWorld(64, 64);
+
+    // Fill the unit table with a mix of infantry and vehicles on both sides
+    static const UnitType kTypes[] = {
+        UNIT_RIFLE, UNIT_GRENADIER, UNIT_TANK_LIGHT, UNIT_ROCKET,
+        UNIT_TANK_MEDIUM, UNIT_RIFLE, UNIT_TANK_HEAVY, UNIT_DOG
+    };
+    int spawned = 0;
+    for (int i = 0; i < MAX_UNITS; i++) {
+        Team team = (i & 1) ? TEAM_ENEMY : TEAM_PLAYER;
+        int cx = (team == TEAM_PLAYER) ? 2 + (i % 16) : 46 + (i % 16);
+        int cy = 2 + (i / 16) * 3 % 60;
+        int id = Units_Spawn(kTypes[i % 8], team,
+                             cx * CELL_SIZE + 12, cy * CELL_SIZE + 12);
+        if (id >= 0) spawned++;
+    }
+    ASSERT(spawned > MAX_UNITS / 2);
+    ASSERT_EQ(VerifyOccupancy(), -1);
+
+    // Everyone converges on the middle of the map and fights it out
+    for (int i = 0; i < MAX_UNITS; i++) {
+        if (Units_Get(i)) {
+            Units_CommandAttackMove(i, 32 * CELL_SIZE, 32 * CELL_SIZE);
+        }
+    }
+
+    for (int tick = 0; tick < 600; tick++) {
+        Units_Update();
+        int bad = VerifyOccupancy();
+        if (bad >= 0) {
+            printf("tick %d cell %d ", tick, bad);
+        }
+        ASSERT_EQ(bad, -1);
+    }
+
+    // Combat should have killed at least some units along the way
+    int alive = 0;
+    for (int i = 0; i < MAX_UNITS; i++) {
+        if (Units_Get(i)) alive++;
+    }
+    ASSERT(alive < spawned);
+}
+
+TEST(unreachable_target_stops_at_shore) {
+    ResetWorld(32, 32);
+
+    // A river down column 16 splits the map in two
+    for (int y = 0; y < 32; y++) {
+        Map_SetTerrain(16, y, TERRAIN_WATER);
+    }
+    ASSERT(Map_GetZone(4, 10, FALSE) != 0);
+    ASSERT(Map_GetZone(4, 10, FALSE) != Map_GetZone(25, 10, FALSE));
+    ASSERT(Map_GetZone(16, 0, TRUE) == Map_GetZone(16, 31, TRUE));
+
+    int tank = Units_Spawn(UNIT_TANK_LIGHT, TEAM_PLAYER, 4 * CELL_SIZE + 12, 10 * CELL_SIZE + 12);
+    ASSERT(tank >= 0);
+
+    // Ordered across, the tank drives to the bank nearest the target
+    Units_CommandMove(tank, 25 * CELL_SIZE + 12, 10 * CELL_SIZE + 12);
+    for (int tick = 0; tick < 300; tick++) Units_Update();
+    Unit* unit = Units_Get(tank);
+    ASSERT(unit);
+    int cellX, cellY;
+    Map_WorldToCell(unit->worldX, unit->worldY, &cellX, &cellY);
+    ASSERT_EQ(cellX, 15);
+    ASSERT_EQ(cellY, 10);
+    ASSERT_EQ(unit->state, STATE_IDLE);
+
+    // A bridge joins the zones and the same order goes through
+    Map_SetTerrain(16, 10, TERRAIN_BRIDGE);
+    ASSERT(Map_GetZone(4, 10, FALSE) == Map_GetZone(25, 10, FALSE));
+    Units_CommandMove(tank, 25 * CELL_SIZE + 12, 10 * CELL_SIZE + 12);
+    for (int tick = 0; tick < 300; tick++) Units_Update();
+    Map_WorldToCell(unit->worldX, unit->worldY, &cellX, &cellY);
+    ASSERT_EQ(cellX, 25);
+    ASSERT_EQ(cellY, 10);
+    ASSERT_EQ(VerifyOccupancy(), -1);
+}
+
+// Map_GetZone must partition the map exactly as 8-way flood fills do
+static bool ZonesMatchFloodFill(BOOL naval) {
+    static int component[MAP_MAX_WIDTH * MAP_MAX_HEIGHT];
+    static int toFill[65536];   // Zone labels are 16-bit
+    static int toZone[MAP_MAX_WIDTH * MAP_MAX_HEIGHT + 1];
+    int mapW = Map_GetWidth();
+    int mapH = Map_GetHeight();
+    auto open = [naval](int x, int y) {
+        return naval ? Map_IsWaterPassable(x, y) : Map_IsPassable(x, y);
+    };
+
+    std::vector<int> stack;
+    int components = 0;
+    for (int i = 0; i < mapW * mapH; i++) component[i] = 0;
+    for (int i = 0; i < mapW * mapH; i++) {
+        if (component[i] || !open(i % mapW, i / mapW)) continue;
+        component[i] = ++components;
+        stack.push_back(i);
+        while (!stack.empty()) {
+            int c = stack.back();
+            stack.pop_back();
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    int x = c % mapW + dx, y = c / mapW + dy;
+                    if (x < 0 || x >= mapW || y < 0 || y >= mapH) continue;
+                    if (component[y * mapW + x] || !open(x, y)) continue;
+                    component[y * mapW + x] = components;
+                    stack.push_back(y * mapW + x);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < 65536; i++) toFill[i] = -1;
+    for (int i = 0; i <= components; i++) toZone[i] = -1;
+    for (int i = 0; i < mapW * mapH; i++) {
+        int zone = Map_GetZone(i % mapW, i / mapW, naval);
+        int fill = component[i];
+        if ((zone == 0) != (fill == 0)) return false;
+        if (toFill[zone] < 0) toFill[zone] = fill;
+        if (toZone[fill] < 0) toZone[fill] = zone;
+        if (toFill[zone] != fill || toZone[fill] != zone) return false;
+    }
+    return true;
+}
+
+TEST(zones_track_terrain_edits) {
+    ResetWorld(48, 40);
+    uint32_t seed = 777;
+    auto next = [&seed](int bound) {
+        seed = seed * 1103515245u + 12345u;
+        return (int)((seed >> 16) % (uint32_t)bound);
+    };
+
+    // Lay down rivers and rock bands, then open and close single cells
+    // (walls, bridges, fords) and check the labels after every round
+    static const TerrainType kEdits[] = {
+        TERRAIN_CLEAR, TERRAIN_WATER, TERRAIN_ROCK, TERRAIN_BRIDGE, TERRAIN_ROAD
+    };
+    for (int y = 0; y < 40; y++) Map_SetTerrain(20, y, TERRAIN_WATER);
+    for (int x = 0; x < 48; x++) Map_SetTerrain(x, 15, TERRAIN_ROCK);
+    ASSERT(ZonesMatchFloodFill(FALSE));
+    ASSERT(ZonesMatchFloodFill(TRUE));
+
+    for (int round = 0; round < 40; round++) {
+        for (int edit = 0; edit < 60; edit++) {
+            Map_SetTerrain(next(48), next(40), kEdits[next(5)]);
+        }
+        ASSERT(ZonesMatchFloodFill(FALSE));
+        ASSERT(ZonesMatchFloodFill(TRUE));
+    }
+}
+
+TEST(group_move_shares_flow_field) {
+    ResetWorld(32, 32);
+
+    // A wall down column 16 with a gap at the bottom
+    for (int y = 0; y < 28; y++) {
+        Map_SetTerrain(16, y, TERRAIN_ROCK);
+    }
+
+    int tanks[6];
+    for (int i = 0; i < 6; i++) {
+        tanks[i] = Units_Spawn(UNIT_TANK_LIGHT, TEAM_PLAYER,
+                               (3 + i % 3) * CELL_SIZE + 12, (4 + i / 3) * CELL_SIZE + 12);
+        ASSERT(tanks[i] >= 0);
+    }
+
+    // The whole selection is ordered to one cell: one field, read by all
+    FlowField_ResetStats();
+    for (int i = 0; i < 6; i++) {
+        Units_CommandMove(tanks[i], 26 * CELL_SIZE + 12, 6 * CELL_SIZE + 12);
+    }
+    for (int tick = 0; tick < 600; tick++) Units_Update();
+
+    const FlowFieldStats* stats = FlowField_GetStats();
+        ASSERT_EQ(stats->builds, 1u);
+        ASSERT(stats->hits >= 5);
+
+    // Everyone came round the wall and queued up near the goal
+    for (int i = 0; i < 6; i++) {
+        Unit* unit = Units_Get(tanks[i]);
+        ASSERT(unit);
+        int cellX, cellY;
+        Map_WorldToCell(unit->worldX, unit->worldY, &cellX, &cellY);
+        ASSERT(cellX > 16);
+        ASSERT(abs(cellX - 26) <= 6 && abs(cellY - 6) <= 6);
+    }
+    ASSERT_EQ(VerifyOccupancy(), -1);
+}
+
+TEST(repeat_route_hits_path_cache) {
+    ResetWorld(32, 32);
+
+    // A wall with one gap, so the route has to bend through it
+    for (int y = 0; y < 32; y++) {
+        if (y != 20) Map_SetTerrain(12, y, TERRAIN_ROCK);
+    }
+
+    int first = Units_Spawn(UNIT_TANK_LIGHT, TEAM_PLAYER, 4 * CELL_SIZE + 12, 4 * CELL_SIZE + 12);
+    ASSERT(first >= 0);
+    PathCache_ResetStats();
+    Units_CommandMove(first, 24 * CELL_SIZE + 12, 4 * CELL_SIZE + 12);
+    Units_Update();
+    ASSERT_EQ(PathCache_GetStats()->misses, 1u);
+    ASSERT_EQ(PathCache_GetStats()->stores, 1u);
+
+    // A second tank ordered from the first one's starting cell, and a third
+    // from a cell on its route, reuse the stored route
+    Unit* unit = Units_Get(first);
+    ASSERT(unit);
+    int midCell = unit->pathCells[unit->pathLength / 2];
+    int mapW = Map_GetWidth();
+    for (int tick = 0; tick < 60; tick++) Units_Update();
+
+    int second = Units_Spawn(UNIT_TANK_LIGHT, TEAM_PLAYER, 4 * CELL_SIZE + 12, 4 * CELL_SIZE + 12);
+    int third = Units_Spawn(UNIT_TANK_LIGHT, TEAM_PLAYER,
+                            (midCell % mapW) * CELL_SIZE + 12, (midCell / mapW) * CELL_SIZE + 12);
+    ASSERT(second >= 0 && third >= 0);
+    Units_CommandMove(second, 24 * CELL_SIZE + 12, 4 * CELL_SIZE + 12);
+    Units_CommandMove(third, 24 * CELL_SIZE + 12, 4 * CELL_SIZE + 12);
+    Units_Update();
+    ASSERT_EQ(PathCache_GetStats()->hits, 2u);
+    ASSERT_EQ(PathCache_GetStats()->suffixHits, 1u);
+
+    // Closing the gap changes passability and flushes the cache
+    uint32_t flushes = PathCache_GetStats()->flushes;
+    Map_SetTerrain(12, 20, TERRAIN_ROCK);
+    Map_SetTerrain(12, 20, TERRAIN_CLEAR);
+    int fourth = Units_Spawn(UNIT_TANK_LIGHT, TEAM_PLAYER, 4 * CELL_SIZE + 12, 6 * CELL_SIZE + 12);
+    ASSERT(fourth >= 0);
+    Units_CommandMove(fourth, 24 * CELL_SIZE + 12, 6 * CELL_SIZE + 12);
+    Units_Update();
+    ASSERT_EQ(PathCache_GetStats()->flushes, flushes + 1);
+    ASSERT_EQ(PathCache_GetStats()->hits, 2u);
+
+    for (int tick = 0; tick < 600; tick++) Units_Update();
+    ASSERT_EQ(VerifyOccupancy(), -1);
+}
+
+int main() {
+    printf("Red Alert Cell Occupancy Tests\n");
+    printf("==============================\n\n");
+
+    RUN_TEST(spawn_and_remove);
+    RUN_TEST(screen_pick_uses_lowest_id);
+    RUN_TEST(transport_load_unload);
+    RUN_TEST(overflow_cell);
+    RUN_TEST(convergence_stress);
+    RUN_TEST(unreachable_target_stops_at_shore);
+    RUN_TEST(zones_track_terrain_edits);
+    RUN_TEST(group_move_shares_flow_field);
+    RUN_TEST(repeat_route_hits_path_cache);
+
+    printf("\nResults: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
+    return g_testsFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,203 @@
+/**
+ * Red Alert macOS Port - Palette Conversion Kernel Tests
+ *
+ * Checks the wwd-media present kernel against the original per-pixel
+ * conversion loop, including odd lengths and mixed dim levels.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+
+#include <wwd/palette_lut.h>
+
+// Simple test framework
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    int failedBefore = g_testsFailed; \
+    printf("  %s... ", #name); \
+    test_##name(); \
+    if (g_testsFailed == failedBefore) { \
+        printf("OK\n"); \
+        g_testsPassed++; \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) do { \
+    if ((a) != (b)) { \
+        printf("FAILED at line %d: %s != %s (%d vs %d)\n", \
+               __LINE__, #a, #b, (int)(a), (int)(b)); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+//===========================================================================
+// Reference (the original Wwd_Renderer_Present loop)
+//===========================================================================
+
+static void ReferenceConvert(const WwdPalette* palette, const uint8_t* pixels,
+                             const uint8_t* alphaBuf, uint32_t* out,
+                             size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint8_t idx = pixels[i];
+        uint8_t alpha = alphaBuf[i];
+
+        uint8_t r = palette->colors[idx][0];
+        uint8_t g = palette->colors[idx][1];
+        uint8_t b = palette->colors[idx][2];
+
+        if (alpha < 255) {
+            r = (r * alpha) >> 8;
+            g = (g * alpha) >> 8;
+            b = (b * alpha) >> 8;
+        }
+        out[i] = 0xFF000000 | (b << 16) | (g << 8) | r;
+    }
+}
+
+static uint32_t g_rng = 7;
+static int TestRand(int range) {
+    g_rng = g_rng * 1103515245u + 12345u;
+    return (int)((g_rng >> 8) % (uint32_t)range);
+}
+
+static void RandomPalette(WwdPalette* palette) {
+    for (int i = 0; i < 256; i++) {
+        for (int c = 0; c < 3; c++) {
+            palette->colors[i][c] = (uint8_t)TestRand(256);
+        }
+    }
+}
+
+// Fog-like alpha: runs of 24 pixels at 255 or 128, with occasional noise
+static void FogAlpha(uint8_t* alpha, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        alpha[i] = ((i / 24) % 3 == 1) ? 128 : 255;
+        if (TestRand(50) == 0) alpha[i] = (uint8_t)TestRand(256);
+    }
+}
+
+static WwdPaletteLut g_lut;
+
+//===========================================================================
+// Tests
+//===========================================================================
+
+TEST(every_index_and_level) {
+    WwdPalette palette;
+    RandomPalette(&palette);
+    g_lut.valid = false;
+    ASSERT(Wwd_PaletteLut_Update(&g_lut, &palette));
+
+    // All 256 x 256 (index, alpha) pairs
+    std::vector<uint8_t> pixels(65536), alpha(65536);
+    for (int i = 0; i < 65536; i++) {
+        pixels[i] = (uint8_t)(i & 0xFF);
+        alpha[i] = (uint8_t)(i >> 8);
+    }
+    std::vector<uint32_t> expect(65536), got(65536);
+    ReferenceConvert(&palette, pixels.data(), alpha.data(), expect.data(), 65536);
+
+    Wwd_PaletteLut_Convert(&g_lut, pixels.data(), alpha.data(), got.data(), 65536);
+    ASSERT(memcmp(expect.data(), got.data(), 65536 * sizeof(uint32_t)) == 0);
+
+    Wwd_PaletteLut_ConvertScalar(&g_lut, pixels.data(), alpha.data(), got.data(), 65536);
+    ASSERT(memcmp(expect.data(), got.data(), 65536 * sizeof(uint32_t)) == 0);
+}
+
+TEST(unaligned_lengths) {
+    WwdPalette palette;
+    RandomPalette(&palette);
+    Wwd_PaletteLut_Update(&g_lut, &palette);
+
+    // Odd offsets and lengths exercise the block tail
+    std::vector<uint8_t> pixels(1100), alpha(1100);
+    for (size_t i = 0; i < pixels.size(); i++) pixels[i] = (uint8_t)TestRand(256);
+    FogAlpha(alpha.data(), alpha.size());
+
+    for (size_t offset = 0; offset < 5; offset++) {
+        for (size_t count = 0; count < 70; count += 3) {
+            uint32_t expect[80], got[80];
+            memset(got, 0xAB, sizeof(got));
+            ReferenceConvert(&palette, &pixels[offset], &alpha[offset], expect, count);
+            Wwd_PaletteLut_Convert(&g_lut, &pixels[offset], &alpha[offset], got, count);
+            ASSERT(memcmp(expect, got, count * sizeof(uint32_t)) == 0);
+            ASSERT_EQ(got[count], 0xABABABABu);  // No overrun
+        }
+    }
+}
+
+TEST(rebuild_only_on_palette_change) {
+    WwdPalette palette;
+    RandomPalette(&palette);
+    g_lut.valid = false;
+    ASSERT(Wwd_PaletteLut_Update(&g_lut, &palette));
+    ASSERT(!Wwd_PaletteLut_Update(&g_lut, &palette));
+
+    // A single changed entry forces a rebuild and shows up in the output
+    palette.colors[42][1] ^= 0x10;
+    ASSERT(Wwd_PaletteLut_Update(&g_lut, &palette));
+    ASSERT(!Wwd_PaletteLut_Update(&g_lut, &palette));
+
+    uint8_t pixel = 42, alpha = 255;
+    uint32_t got = 0, expect = 0;
+    Wwd_PaletteLut_Convert(&g_lut, &pixel, &alpha, &got, 1);
+    ReferenceConvert(&palette, &pixel, &alpha, &expect, 1);
+    ASSERT_EQ(got, expect);
+}
+
+TEST(full_frame_timing) {
+    const size_t count = WWD_FRAMEBUFFER_WIDTH * WWD_FRAMEBUFFER_HEIGHT;
+    const int frames = 50;
+
+    WwdPalette palette;
+    RandomPalette(&palette);
+    Wwd_PaletteLut_Update(&g_lut, &palette);
+
+    std::vector<uint8_t> pixels(count), alpha(count);
+    for (size_t i = 0; i < count; i++) pixels[i] = (uint8_t)TestRand(256);
+    FogAlpha(alpha.data(), count);
+    std::vector<uint32_t> expect(count), got(count);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; f++) {
+        ReferenceConvert(&palette, pixels.data(), alpha.data(), expect.data(), count);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; f++) {
+        Wwd_PaletteLut_Convert(&g_lut, pixels.data(), alpha.data(), got.data(), count);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    ASSERT(memcmp(expect.data(), got.data(), count * sizeof(uint32_t)) == 0);
+
+    double refUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / frames;
+    double lutUs = std::chrono::duration<double, std::micro>(t2 - t1).count() / frames;
+    printf("(per-pixel %.0f us, lut %.0f us) ", refUs, lutUs);
+}
+
+int main() {
+    printf("Red Alert Palette Conversion Tests\n");
+    printf("==================================\n\n");
+
+    RUN_TEST(every_index_and_level);
+    RUN_TEST(unaligned_lengths);
+    RUN_TEST(rebuild_only_on_palette_change);
+    RUN_TEST(full_frame_timing);
+
+    printf("\nResults: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
+    return g_testsFailed > 0 ? 1 : 0;
+}
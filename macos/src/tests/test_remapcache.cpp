@@ -0,0 +1,244 @@
+/**
+ * Red Alert macOS Port - Remapped Sprite Cache Tests
+ *
+ * Cached copies must draw exactly like a remapped blit of the original,
+ * repeat draws must hit, and the cache must stay inside its byte budget
+ * by dropping the least recently drawn frames.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+
+#include "game/remapcache.h"
+#include <wwd/span_sprite.h>
+
+// Simple test framework
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    int failedBefore = g_testsFailed; \
+    printf("  %s... ", #name); \
+    test_##name(); \
+    if (g_testsFailed == failedBefore) { \
+        printf("OK\n"); \
+        g_testsPassed++; \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) do { \
+    if ((a) != (b)) { \
+        printf("FAILED at line %d: %s != %s (%d vs %d)\n", \
+               __LINE__, #a, #b, (int)(a), (int)(b)); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+//===========================================================================
+// Fixtures
+//===========================================================================
+
+static const int FRAME_W = 24;
+static const int FRAME_H = 24;
+static const int FRAME_COUNT = 8;
+
+// Stand-in SHP: the cache only uses the handle as a key
+struct FakeShp {
+    std::vector<std::vector<uint8_t>> pixels;
+    std::vector<std::vector<uint8_t>> spans;
+    std::vector<ShpFrame> frames;
+};
+
+static FakeShp g_shpA, g_shpB;
+static uint8_t g_remapBlue[256], g_remapRed[256];
+
+static uint32_t g_rng = 5;
+static int TestRand(int range) {
+    g_rng = g_rng * 1103515245u + 12345u;
+    return (int)((g_rng >> 8) % (uint32_t)range);
+}
+
+static void BuildShp(FakeShp* shp) {
+    shp->pixels.resize(FRAME_COUNT);
+    shp->spans.resize(FRAME_COUNT);
+    shp->frames.resize(FRAME_COUNT);
+    for (int f = 0; f < FRAME_COUNT; f++) {
+        std::vector<uint8_t>& px = shp->pixels[f];
+        px.assign(FRAME_W * FRAME_H, 0);
+        for (int i = 0; i < FRAME_W * FRAME_H; i++) {
+            // Half transparent, a quarter in the 80-95 remap range
+            int r = TestRand(4);
+            if (r == 0) px[i] = (uint8_t)(80 + TestRand(16));
+            else if (r == 1) px[i] = (uint8_t)(1 + TestRand(255));
+        }
+        std::vector<uint8_t>& spans = shp->spans[f];
+        spans.resize(Wwd_SpanSprite_EncodedSize(px.data(), FRAME_W, FRAME_H));
+        Wwd_SpanSprite_Encode(px.data(), FRAME_W, FRAME_H, spans.data());
+
+        ShpFrame& frame = shp->frames[f];
+        frame.pixels = px.data();
+        frame.width = FRAME_W;
+        frame.height = FRAME_H;
+        frame.offsetX = 0;
+        frame.offsetY = 0;
+        frame.spans = spans.data();
+    }
+}
+
+static ShpFileHandle Handle(FakeShp* shp) {
+    return reinterpret_cast<ShpFileHandle>(shp);
+}
+
+static uint32_t FrameBytes(const FakeShp* shp, int index) {
+    return (uint32_t)shp->spans[index].size();
+}
+
+static void Reset(uint32_t budget) {
+    RemapCache_Clear();
+    RemapCache_SetBudget(budget);
+    RemapCache_ResetStats();
+}
+
+//===========================================================================
+// Tests
+//===========================================================================
+
+TEST(copy_draws_like_remapped_blit) {
+    Reset(REMAPCACHE_DEFAULT_BUDGET);
+    WwdRect clip = { 0, 0, 64, 64 };
+    for (int f = 0; f < FRAME_COUNT; f++) {
+        const ShpFrame* frame = &g_shpA.frames[f];
+        const uint8_t* cached = RemapCache_Get(Handle(&g_shpA), f, frame, g_remapRed);
+        ASSERT(cached != nullptr);
+        ASSERT(cached != frame->spans);
+
+        uint8_t expect[64 * 64], actual[64 * 64];
+        memset(expect, 3, sizeof(expect));
+        memset(actual, 3, sizeof(actual));
+        Wwd_SpanSprite_Blit(frame->spans, FRAME_W, FRAME_H, expect, 64, &clip,
+                            f * 5, 40 - f * 3, g_remapRed);
+        Wwd_SpanSprite_Blit(cached, FRAME_W, FRAME_H, actual, 64, &clip,
+                            f * 5, 40 - f * 3, nullptr);
+        ASSERT(memcmp(expect, actual, sizeof(expect)) == 0);
+    }
+}
+
+TEST(repeat_draws_hit) {
+    Reset(REMAPCACHE_DEFAULT_BUDGET);
+    const ShpFrame* frame = &g_shpA.frames[2];
+    const uint8_t* first = RemapCache_Get(Handle(&g_shpA), 2, frame, g_remapBlue);
+    for (int i = 0; i < 10; i++) {
+        ASSERT(RemapCache_Get(Handle(&g_shpA), 2, frame, g_remapBlue) == first);
+    }
+
+    const RemapCacheStats* stats = RemapCache_GetStats();
+    ASSERT_EQ(stats->lookups, 11);
+    ASSERT_EQ(stats->hits, 10);
+    ASSERT_EQ(stats->misses, 1);
+    ASSERT_EQ(stats->entries, 1);
+    ASSERT_EQ(stats->bytes, FrameBytes(&g_shpA, 2));
+}
+
+TEST(colour_frame_and_shp_are_separate_keys) {
+    Reset(REMAPCACHE_DEFAULT_BUDGET);
+    const uint8_t* blue = RemapCache_Get(Handle(&g_shpA), 0, &g_shpA.frames[0], g_remapBlue);
+    const uint8_t* red = RemapCache_Get(Handle(&g_shpA), 0, &g_shpA.frames[0], g_remapRed);
+    const uint8_t* next = RemapCache_Get(Handle(&g_shpA), 1, &g_shpA.frames[1], g_remapBlue);
+    const uint8_t* other = RemapCache_Get(Handle(&g_shpB), 0, &g_shpB.frames[0], g_remapBlue);
+    ASSERT(blue && red && next && other);
+    ASSERT(blue != red && blue != next && blue != other);
+    ASSERT_EQ(RemapCache_GetStats()->misses, 4);
+    ASSERT_EQ(RemapCache_GetStats()->entries, 4);
+}
+
+TEST(evicts_least_recently_drawn) {
+    // Room for frames 0-2 but not 3 as well
+    uint32_t budget = FrameBytes(&g_shpA, 0) + FrameBytes(&g_shpA, 1) + FrameBytes(&g_shpA, 2);
+    Reset(budget);
+    for (int f = 0; f < 3; f++) {
+        RemapCache_Get(Handle(&g_shpA), f, &g_shpA.frames[f], g_remapRed);
+    }
+
+    // Frame 0 drawn again, so frame 1 is now the oldest
+    RemapCache_Get(Handle(&g_shpA), 0, &g_shpA.frames[0], g_remapRed);
+    RemapCache_Get(Handle(&g_shpA), 3, &g_shpA.frames[3], g_remapRed);
+
+    const RemapCacheStats* stats = RemapCache_GetStats();
+    ASSERT(stats->bytes <= budget);
+    ASSERT(stats->evictions >= 1);
+
+    RemapCache_ResetStats();
+    RemapCache_Get(Handle(&g_shpA), 0, &g_shpA.frames[0], g_remapRed);
+    RemapCache_Get(Handle(&g_shpA), 3, &g_shpA.frames[3], g_remapRed);
+    ASSERT_EQ(stats->hits, 2);
+    RemapCache_Get(Handle(&g_shpA), 1, &g_shpA.frames[1], g_remapRed);
+    ASSERT_EQ(stats->misses, 1);
+}
+
+TEST(budget_shrink_and_oversize_frames) {
+    Reset(REMAPCACHE_DEFAULT_BUDGET);
+    for (int f = 0; f < FRAME_COUNT; f++) {
+        RemapCache_Get(Handle(&g_shpA), f, &g_shpA.frames[f], g_remapBlue);
+    }
+    ASSERT_EQ(RemapCache_GetStats()->entries, FRAME_COUNT);
+
+    // Shrinking evicts at once; a frame bigger than the budget isn't kept
+    RemapCache_SetBudget(FrameBytes(&g_shpA, 0) - 1);
+    ASSERT(RemapCache_GetStats()->entries < FRAME_COUNT);
+    ASSERT(RemapCache_GetStats()->bytes < FrameBytes(&g_shpA, 0));
+    RemapCache_Clear();
+    ASSERT(RemapCache_Get(Handle(&g_shpA), 0, &g_shpA.frames[0], g_remapBlue) == nullptr);
+    ASSERT_EQ(RemapCache_GetStats()->entries, 0);
+
+    // Frames without spans are never cached
+    ShpFrame bare = g_shpA.frames[0];
+    bare.spans = nullptr;
+    RemapCache_SetBudget(REMAPCACHE_DEFAULT_BUDGET);
+    ASSERT(RemapCache_Get(Handle(&g_shpA), 0, &bare, g_remapBlue) == nullptr);
+
+    RemapCache_Get(Handle(&g_shpA), 0, &g_shpA.frames[0], g_remapBlue);
+    RemapCache_Clear();
+    ASSERT_EQ(RemapCache_GetStats()->entries, 0);
+    ASSERT_EQ(RemapCache_GetStats()->bytes, 0);
+}
+
+//===========================================================================
+// Main
+//===========================================================================
+
+int main() {
+    printf("Red Alert Remapped Sprite Cache Tests\n");
+    printf("=====================================\n\n");
+
+    for (int i = 0; i < 256; i++) {
+        g_remapBlue[i] = (uint8_t)i;
+        g_remapRed[i] = (uint8_t)i;
+    }
+    for (int i = 0; i < 16; i++) {
+        g_remapBlue[80 + i] = (uint8_t)(161 + i);
+        g_remapRed[80 + i] = (uint8_t)(229 + i);
+    }
+    BuildShp(&g_shpA);
+    BuildShp(&g_shpB);
+
+    RUN_TEST(copy_draws_like_remapped_blit);
+    RUN_TEST(repeat_draws_hit);
+    RUN_TEST(colour_frame_and_shp_are_separate_keys);
+    RUN_TEST(evicts_least_recently_drawn);
+    RUN_TEST(budget_shrink_and_oversize_frames);
+
+    printf("\nResults: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
+    return g_testsFailed > 0 ? 1 : 0;
+}
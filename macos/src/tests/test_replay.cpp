@@ -0,0 +1,333 @@
+/**
+ * Red Alert macOS Port - Replay Tests
+ *
+ * Records a scripted skirmish, plays it back into a fresh simulation and
+ * checks the per-tick hashes match; then perturbs playback and checks the
+ * divergence is reported on the tick it happened.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "game/replay.h"
+#include "game/units.h"
+#include "game/map.h"
+#include "game/random.h"
+#include "game/mission.h"
+#include "game/sprites.h"
+#include "game/sounds.h"
+#include "game/terrain.h"
+#include "graphics/metal/renderer.h"
+
+//===========================================================================
+// Stubs for rendering, audio and mission hooks used by units.cpp
+//===========================================================================
+
+extern "C" {
+void Mission_TriggerAttacked(const char*) {}
+void Mission_TriggerDestroyed(const char*) {}
+void Mission_PostEvent(MissionEvent, int) {}
+void Sounds_PlayAt(SoundEffect, int, int, uint8_t) {}
+void Voice_PlayResponseAt(int, BOOL, ResponseType, VoiceVariant,
+                          int, int, uint8_t) {}
+BOOL Sprites_RenderUnit(UnitType, int, int, int, int, uint8_t) { return FALSE; }
+BOOL Sprites_RenderBuilding(BuildingType, int, int, int, uint8_t) { return FALSE; }
+void Wwd_Renderer_FillRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_PutPixel(int, int, uint8_t) {}
+void Wwd_Renderer_DrawLine(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_DrawRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_DrawCircle(int, int, int, uint8_t) {}
+void Wwd_Renderer_FillCircle(int, int, int, uint8_t) {}
+void Wwd_Renderer_SetAlpha(int, int, int, int, uint8_t) {}
+int Unit_GetPassengerCapacity(int unitType) {
+    return (unitType == UNIT_APC) ? 5 : 0;
+}
+}
+
+BOOL Terrain_Available(void) { return FALSE; }
+BOOL Terrain_RenderTile(int, int, int, int) { return FALSE; }
+BOOL Terrain_RenderByID(int, int, int, int) { return FALSE; }
+int Rules_GetGoldValue() { return 25; }
+int Rules_GetGemValue() { return 50; }
+
+// Simple test framework
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    int failedBefore = g_testsFailed; \
+    printf("  %s... ", #name); \
+    test_##name(); \
+    if (g_testsFailed == failedBefore) { \
+        printf("OK\n"); \
+        g_testsPassed++; \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) do { \
+    if ((a) != (b)) { \
+        printf("FAILED at line %d: %s != %s (%d vs %d)\n", \
+               __LINE__, #a, #b, (int)(a), (int)(b)); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+//===========================================================================
+// Scripted Session
+//===========================================================================
+
+static const char* REPLAY_PATH = "test_replay.rpl";
+static const int SESSION_TICKS = 240;
+
+static int g_credits;
+static int g_playerUnits[4];
+
+static int CellCenter(int cell) {
+    return cell * CELL_SIZE + CELL_SIZE / 2;
+}
+
+// Two small forces on the demo map's open south-west corner
+static void SetupSkirmish(uint64_t seed) {
+    Random_Seed(seed);
+    Map_Init();
+    Units_Init();
+    Map_GenerateDemo();
+    g_credits = 3000;
+    Units_SetCreditsPtr(&g_credits);
+
+    Buildings_Spawn(BUILDING_FACTORY, TEAM_PLAYER, 1, 29);
+    Buildings_Spawn(BUILDING_PILLBOX, TEAM_ENEMY, 20, 23);
+    for (int i = 0; i < 4; i++) {
+        g_playerUnits[i] = Units_Spawn(i & 1 ? UNIT_TANK_LIGHT : UNIT_RIFLE, TEAM_PLAYER,
+                                       CellCenter(2 + i), CellCenter(26));
+        Units_Spawn(UNIT_RIFLE, TEAM_ENEMY, CellCenter(18 + i), CellCenter(25));
+        Units_Spawn(UNIT_TANK_HEAVY, TEAM_ENEMY, CellCenter(18 + i), CellCenter(27));
+    }
+}
+
+// One step in GameUpdate order, with the player's commands issued before
+// it the way the input handlers in main.mm issue them
+static void Step(bool scripted) {
+    uint32_t tick = Replay_GetTick();
+    if (scripted) {
+        if (tick == 5) {
+            for (int i = 0; i < 4; i++) {
+                Replay_Issue(REPLAY_CMD_MOVE, g_playerUnits[i],
+                             CellCenter(8), CellCenter(24 + i));
+            }
+            Replay_Issue(REPLAY_CMD_CREDITS, -800, 0, 0);
+        }
+        if (tick == 60) {
+            Replay_Issue(REPLAY_CMD_ATTACK_MOVE, g_playerUnits[0], CellCenter(19), CellCenter(26));
+            Replay_Issue(REPLAY_CMD_ATTACK_MOVE, g_playerUnits[1], CellCenter(19), CellCenter(26));
+            Replay_Issue(REPLAY_CMD_GUARD, g_playerUnits[2], 0, 0);
+        }
+        if (tick == 90) {
+            Replay_Issue(REPLAY_CMD_PLACE_BUILDING, BUILDING_POWER, 4, 30);
+        }
+        if (tick == 120) {
+            Replay_Issue(REPLAY_CMD_STOP, g_playerUnits[1], 0, 0);
+            Replay_Issue(REPLAY_CMD_HUNT, TEAM_ENEMY, 0, 0);
+        }
+    } else {
+        Replay_Inject(REPLAY_PHASE_INPUT);
+    }
+
+    Map_Update();
+    Units_Update();
+
+    if (scripted) {
+        // Production finishing inside GameUI_Update; the second one has no
+        // room by the factory and takes the random fallback spot
+        if (tick == 30) {
+            Replay_Issue(REPLAY_CMD_SPAWN_UNIT, UNIT_TANK_LIGHT, CellCenter(5), CellCenter(28));
+        }
+        if (tick == 150) {
+            Replay_Issue(REPLAY_CMD_SPAWN_UNIT, UNIT_RIFLE, -1, -1);
+        }
+    } else {
+        Replay_Inject(REPLAY_PHASE_PRODUCTION);
+    }
+
+    Map_ClearFogChanges();
+    Replay_EndTick();
+}
+
+static bool RecordSession(void) {
+    SetupSkirmish(77);
+    Replay_StartRecording("Test Skirmish");
+    for (int i = 0; i < SESSION_TICKS; i++) {
+        Step(true);
+    }
+    return Replay_StopRecording(REPLAY_PATH);
+}
+
+// Fresh world from the recorded seed, ready to play back
+static bool StartPlayback(ReplayInfo* info) {
+    if (!Replay_Load(REPLAY_PATH, info)) return false;
+    SetupSkirmish(info->seed);
+    g_credits = info->startCredits;
+    return Replay_StartPlayback();
+}
+
+//===========================================================================
+// Tests
+//===========================================================================
+
+TEST(replay_file_round_trip) {
+    ASSERT(RecordSession());
+
+    ReplayInfo info;
+    ASSERT(Replay_Load(REPLAY_PATH, &info));
+    ASSERT(info.seed == 77);
+    ASSERT_EQ(info.tickCount, SESSION_TICKS);
+    ASSERT_EQ(info.commandCount, 13);
+    ASSERT(info.startCredits == 3000);
+    ASSERT(strcmp(info.scenario, "Test Skirmish") == 0);
+
+    // Header, varint commands and one 4-byte hash per tick
+    FILE* file = fopen(REPLAY_PATH, "rb");
+    ASSERT(file);
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    ASSERT(size < 64 + 13 * 8 + SESSION_TICKS * 4);
+}
+
+TEST(playback_matches_recording) {
+    ASSERT(RecordSession());
+    uint64_t recordedHash = Replay_HashState();
+    int recordedUnits = Units_CountByTeam(TEAM_PLAYER);
+    int recordedCredits = g_credits;
+
+    // Scramble the world and RNG so nothing leaks into the playback
+    SetupSkirmish(5);
+    for (int i = 0; i < 17; i++) Units_Update();
+
+    ReplayInfo info;
+    ASSERT(StartPlayback(&info));
+    while (!Replay_IsPlaybackDone()) {
+        Step(false);
+    }
+
+    ASSERT_EQ(Replay_GetDivergedTick(), -1);
+    ASSERT(Replay_GetTick() == SESSION_TICKS);
+    ASSERT(Replay_HashState() == recordedHash);
+    ASSERT(Units_CountByTeam(TEAM_PLAYER) == recordedUnits);
+    ASSERT(g_credits == recordedCredits);
+    Replay_Stop();
+}
+
+TEST(divergence_reports_first_bad_tick) {
+    ASSERT(RecordSession());
+
+    ReplayInfo info;
+    ASSERT(StartPlayback(&info));
+    while (!Replay_IsPlaybackDone()) {
+        // Simulate a bug: one unit loses a hit point during tick 101
+        if (Replay_GetTick() == 100) {
+            Unit* unit = Units_Get(g_playerUnits[3]);
+            ASSERT(unit);
+            unit->health--;
+        }
+        Step(false);
+        if (Replay_GetTick() <= 100) {
+            ASSERT(Replay_GetDivergedTick() == -1);
+        }
+    }
+
+    ASSERT_EQ(Replay_GetDivergedTick(), 101);
+    Replay_Stop();
+}
+
+TEST(incremental_hash_matches_full) {
+    // The scripted fight and build, plus a harvester working the
+    // south-west ore field, so occupancy, building and ore writes all land
+    SetupSkirmish(77);
+    Buildings_Spawn(BUILDING_REFINERY, TEAM_PLAYER, 4, 44);
+    Units_Spawn(UNIT_HARVESTER, TEAM_PLAYER, CellCenter(8), CellCenter(47));
+    int startOre = 0;
+    for (int y = 47; y <= 53; y++) {
+        for (int x = 5; x <= 11; x++) {
+            startOre += Map_GetCell(x, y)->oreAmount;
+        }
+    }
+
+    Replay_StartRecording("Hash Check");
+    for (int i = 0; i < SESSION_TICKS * 2; i++) {
+        Step(true);
+        ASSERT(Replay_HashState() == Replay_HashStateFull());
+    }
+    Replay_Stop();
+
+    int endOre = 0;
+    for (int y = 47; y <= 53; y++) {
+        for (int x = 5; x <= 11; x++) {
+            endOre += Map_GetCell(x, y)->oreAmount;
+        }
+    }
+    ASSERT(endOre < startOre);
+}
+
+TEST(different_start_rejected) {
+    ASSERT(RecordSession());
+
+    ReplayInfo info;
+    ASSERT(Replay_Load(REPLAY_PATH, &info));
+    SetupSkirmish(info.seed);
+    g_credits = info.startCredits + 1;
+    ASSERT(!Replay_StartPlayback());
+    ASSERT(Replay_GetDivergedTick() == 0);
+    Replay_Stop();
+}
+
+TEST(corrupt_file_rejected) {
+    ASSERT(RecordSession());
+
+    FILE* file = fopen(REPLAY_PATH, "r+b");
+    ASSERT(file);
+    fseek(file, -3, SEEK_END);
+    long size = ftell(file) + 3;
+    fclose(file);
+    ASSERT(truncate(REPLAY_PATH, size - 3) == 0);
+
+    ReplayInfo info;
+    ASSERT(!Replay_Load(REPLAY_PATH, &info));
+    ASSERT(!Replay_Load("no_such_replay.rpl", &info));
+}
+
+//===========================================================================
+// Main
+//===========================================================================
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    printf("Red Alert Replay Tests\n");
+    printf("======================\n\n");
+
+    RUN_TEST(replay_file_round_trip);
+    RUN_TEST(playback_matches_recording);
+    RUN_TEST(divergence_reports_first_bad_tick);
+    RUN_TEST(incremental_hash_matches_full);
+    RUN_TEST(different_start_rejected);
+    RUN_TEST(corrupt_file_rejected);
+
+    remove(REPLAY_PATH);
+
+    printf("\nResults: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
+    return g_testsFailed > 0 ? 1 : 0;
+}
@@ -10,9 +10,15 @@
 #include "../game/house.h"
 #include "../game/mapclass.h"
 #include "../game/cell.h"
+#include "../game/infantry.h"
+#include "../game/unit.h"
+#include "../game/building.h"
+#include "../game/bullet.h"
+#include "../game/random.h"
 #include <cstdio>
 #include <cstring>
 #include <cstdlib>
+#include <chrono>
 
 //===========================================================================
 // External Global References (defined in linked object files)
@@ -27,6 +33,12 @@ extern MapClass Map;
 // Frame - defined locally for this test (saveload.cpp uses extern)
 uint32_t Frame = 0;
 
+// Realtime unit system tests (test_saveload_units.cpp)
+bool SaveLoadTest_SimRoundTrip(int slot, int warmupFrames, int frames);
+bool SaveLoadTest_SimIndexesRestored(int slot);
+bool SaveLoadTest_SimRouteCachesDropped(int slot);
+void SaveLoadTest_ResetSim(int width, int height);
+
 //===========================================================================
 // Test Framework
 //===========================================================================
@@ -482,6 +494,45 @@ TEST(map_save_load) {
     remove(filename);
 }
 
+TEST(map_cell_reference_out_of_range_rejected) {
+    Map.OneTime();
+    Map.SetMapDimensions(10, 10, 40, 40);
+
+    char filename[256];
+    snprintf(filename, sizeof(filename), "/tmp/ra_test_mapref_%d.sav", rand());
+
+    SaveStream saver;
+    ASSERT(saver.Open(filename));
+    ASSERT(Save_Map(saver));
+    saver.Close();
+
+    // The map section ends with an empty occupant list; replace it with
+    // one reference to a cell past the end of the map
+    FILE* f = fopen(filename, "r+b");
+    ASSERT(f != nullptr);
+    fseek(f, -4, SEEK_END);
+    int32_t refCount = 1;
+    uint16_t cell = 0xFFFF;
+    int8_t slot = -1;
+    int8_t type = 1;
+    int16_t id = 0;
+    fwrite(&refCount, sizeof(refCount), 1, f);
+    fwrite(&cell, sizeof(cell), 1, f);
+    fwrite(&slot, sizeof(slot), 1, f);
+    fwrite(&type, sizeof(type), 1, f);
+    fwrite(&id, sizeof(id), 1, f);
+    fclose(f);
+
+    LoadStream loader;
+    ASSERT(loader.Open(filename));
+    ASSERT(!Load_Map(loader));
+    ASSERT(loader.HasError());
+    loader.Close();
+
+    Map.FreeCells();
+    remove(filename);
+}
+
 //===========================================================================
 // Full Save/Load Cycle Tests
 //===========================================================================
@@ -563,6 +614,191 @@ TEST(load_nonexistent_fails) {
     ASSERT(!Load_Game(97));
 }
 
+TEST(corrupted_save_rejected) {
+    Map.OneTime();
+    Map.InitCells();
+    SaveLoadTest_ResetSim(32, 32);
+
+    ASSERT(Save_Game(96, "Corrupt Me"));
+
+    // Flip one byte well past the header
+    char filename[256];
+    Get_Save_Filename(96, filename, sizeof(filename));
+    FILE* file = fopen(filename, "r+b");
+    ASSERT(file != nullptr);
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    ASSERT(size > static_cast<long>(sizeof(SaveGameHeader)) + 64);
+    long offset = sizeof(SaveGameHeader) + (size - sizeof(SaveGameHeader)) / 2;
+    fseek(file, offset, SEEK_SET);
+    int byte = fgetc(file);
+    fseek(file, offset, SEEK_SET);
+    fputc(byte ^ 0x5A, file);
+    fclose(file);
+
+    ASSERT(!Load_Game(96));
+
+    Delete_Save(96);
+    Map.FreeCells();
+}
+
+//===========================================================================
+// Object Pool Tests
+//===========================================================================
+
+TEST(object_pools_round_trip) {
+    Map.OneTime();
+    Map.InitCells();
+    SaveLoadTest_ResetSim(0, 0);
+    Infantry.Clear();
+    Units.Clear();
+    Buildings.Clear();
+    Bullets.Clear();
+
+    // Leave a gap so slot numbers aren't simply 0..n
+    InfantryClass* spare = Infantry.Allocate();
+    InfantryClass* rifle = Infantry.Allocate();
+    ASSERT(spare && rifle);
+    rifle->Init(InfantryType::E1, HousesType::GREECE);
+    rifle->coord_ = XY_Coord(1000, 2000);
+    rifle->strength_ = 37;
+    Infantry.Free(spare);
+
+    UnitClass* apc = Units.Allocate();
+    ASSERT(apc);
+    apc->Init(UnitType::APC, HousesType::GREECE);
+    apc->coord_ = XY_Coord(3000, 4000);
+    apc->passengers_[0] = rifle;
+    apc->passengerCount_ = 1;
+    apc->radio_ = rifle;
+    rifle->radio_ = apc;
+
+    BuildingClass* weap = Buildings.Allocate();
+    ASSERT(weap);
+    weap->Init(BuildingType::WEAP, HousesType::USSR);
+    weap->strength_ = 512;
+
+    BulletClass* shell = Bullets.Allocate();
+    ASSERT(shell);
+    shell->Init(BulletType::CANNON, apc, XY_Coord(5000, 5000), 40,
+                WarheadType::AP);
+
+    CELL cell = static_cast<CELL>(10 * MAP_CELL_W + 12);
+    Map[cell].occupier_ = weap;
+
+    int rifleId = rifle->id_;
+    int apcId = apc->id_;
+    int weapId = weap->id_;
+    int shellId = shell->id_;
+
+    ASSERT(Save_Game(95, "Pools"));
+
+    Infantry.Clear();
+    Units.Clear();
+    Buildings.Clear();
+    Bullets.Clear();
+    Map.InitCells();
+
+    ASSERT(Load_Game(95));
+
+    ASSERT_EQ(Infantry.Count(), 1);
+    ASSERT_EQ(Units.Count(), 1);
+    ASSERT_EQ(Buildings.Count(), 1);
+    ASSERT_EQ(Bullets.Count(), 1);
+
+    InfantryClass* rifle2 = Infantry.Get(rifleId);
+    UnitClass* apc2 = Units.Get(apcId);
+    BuildingClass* weap2 = Buildings.Get(weapId);
+    BulletClass* shell2 = Bullets.Get(shellId);
+    ASSERT(rifle2 && apc2 && weap2 && shell2);
+
+    ASSERT_EQ(rifle2->coord_, XY_Coord(1000, 2000));
+    ASSERT_EQ(rifle2->strength_, 37);
+    ASSERT_EQ(weap2->strength_, 512);
+    ASSERT_EQ(weap2->type_, BuildingType::WEAP);
+    ASSERT_EQ(apc2->passengerCount_, 1);
+
+    // References resolve to the reloaded objects
+    ASSERT(apc2->passengers_[0] == rifle2);
+    ASSERT(apc2->radio_ == rifle2);
+    ASSERT(rifle2->radio_ == apc2);
+    ASSERT(shell2->payback_ == apc2);
+    ASSERT(Map[cell].occupier_ == weap2);
+
+    Infantry.Clear();
+    Units.Clear();
+    Buildings.Clear();
+    Bullets.Clear();
+    Delete_Save(95);
+    Map.FreeCells();
+}
+
+//===========================================================================
+// Realtime Simulation Tests
+//===========================================================================
+
+TEST(sim_round_trip_matches) {
+    Map.OneTime();
+    Map.InitCells();
+
+    // State after load, ticked N frames, must equal the uninterrupted run
+    ASSERT(SaveLoadTest_SimRoundTrip(94, 40, 120));
+
+    Delete_Save(94);
+    Map.FreeCells();
+}
+
+TEST(sim_indexes_restored) {
+    Map.OneTime();
+    Map.InitCells();
+
+    ASSERT(SaveLoadTest_SimIndexesRestored(94));
+
+    Delete_Save(94);
+    Map.FreeCells();
+}
+
+TEST(sim_route_caches_dropped) {
+    Map.OneTime();
+    Map.InitCells();
+
+    ASSERT(SaveLoadTest_SimRouteCachesDropped(94));
+
+    Delete_Save(94);
+    Map.FreeCells();
+}
+
+TEST(full_map_save_time) {
+    Map.OneTime();
+    Map.InitCells();
+    Map.SetMapDimensions(0, 0, MAP_CELL_W, MAP_CELL_H);
+    SaveLoadTest_ResetSim(128, 128);
+
+    const int runs = 20;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        ASSERT(Save_Game(93, "Full Map"));
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count() / runs;
+
+    char filename[256];
+    Get_Save_Filename(93, filename, sizeof(filename));
+    FILE* file = fopen(filename, "rb");
+    ASSERT(file != nullptr);
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+
+    printf(" [128x128 save: %.2f ms, %ld bytes]", ms, size);
+
+    ASSERT(Load_Game(93));
+
+    Delete_Save(93);
+    SaveLoadTest_ResetSim(0, 0);
+    Map.FreeCells();
+}
+
 //===========================================================================
 // Checksum Tests
 //===========================================================================
@@ -607,13 +843,20 @@ TEST(misc_values_save_load) {
     snprintf(filename, sizeof(filename), "/tmp/ra_test_misc_%d.sav", rand());
 
     Frame = 54321;
+    Random_Seed(777);
+    Random_Sim(100);
 
     SaveStream saver;
     ASSERT(saver.Open(filename));
     ASSERT(Save_Misc_Values(saver));
     saver.Close();
 
+    // The draws that follow the save must repeat after loading
+    int expected[8];
+    for (int i = 0; i < 8; i++) expected[i] = Random_Sim(1000);
+
     Frame = 0;
+    Random_Seed(1);
 
     LoadStream loader;
     ASSERT(loader.Open(filename));
@@ -621,6 +864,10 @@ TEST(misc_values_save_load) {
     loader.Close();
 
     ASSERT_EQ(Frame, 54321);
+    ASSERT_EQ(Random_GetSeed(), 777u);
+    for (int i = 0; i < 8; i++) {
+        ASSERT_EQ(Random_Sim(1000), expected[i]);
+    }
 
     remove(filename);
 }
@@ -657,11 +904,23 @@ int main() {
 
     printf("\nMap Tests:\n");
     run_test("map_save_load", test_map_save_load);
+    run_test("map_cell_reference_out_of_range_rejected",
+             test_map_cell_reference_out_of_range_rejected);
 
     printf("\nFull Cycle Tests:\n");
     run_test("full_save_load_cycle", test_full_save_load_cycle);
     run_test("save_not_exists", test_save_not_exists);
     run_test("load_nonexistent_fails", test_load_nonexistent_fails);
+    run_test("corrupted_save_rejected", test_corrupted_save_rejected);
+
+    printf("\nObject Pool Tests:\n");
+    run_test("object_pools_round_trip", test_object_pools_round_trip);
+
+    printf("\nRealtime Simulation Tests:\n");
+    run_test("sim_round_trip_matches", test_sim_round_trip_matches);
+    run_test("sim_indexes_restored", test_sim_indexes_restored);
+    run_test("sim_route_caches_dropped", test_sim_route_caches_dropped);
+    run_test("full_map_save_time", test_full_map_save_time);
 
     printf("\nChecksum Tests:\n");
     run_test("checksum_calculation", test_checksum_calculation);
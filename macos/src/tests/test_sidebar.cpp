@@ -14,6 +14,9 @@
 #include <cstdio>
 #include <cstring>
 
+// Production hints go to the sprite system, which isn't linked here
+extern "C" void Sprites_Hint(const char*) {}
+
 //===========================================================================
 // Test Framework
 //===========================================================================
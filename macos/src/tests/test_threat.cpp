@@ -0,0 +1,261 @@
+/**
+ * Red Alert macOS Port - Threat Map Tests
+ *
+ * Checks the incrementally maintained threat grid against a recompute
+ * from the unit table while units wander, fight and die, and that units
+ * which avoid threat plan around a defended spot.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+#include "game/units.h"
+#include "game/map.h"
+#include "game/threat.h"
+#include "game/mission.h"
+#include "game/sprites.h"
+#include "game/sounds.h"
+#include "game/terrain.h"
+#include "graphics/metal/renderer.h"
+
+//===========================================================================
+// Stubs for rendering, audio and mission hooks used by units.cpp
+//===========================================================================
+
+extern "C" {
+void Mission_TriggerAttacked(const char*) {}
+void Mission_TriggerDestroyed(const char*) {}
+void Mission_PostEvent(MissionEvent, int) {}
+void Sounds_PlayAt(SoundEffect, int, int, uint8_t) {}
+void Voice_PlayResponseAt(int, BOOL, ResponseType, VoiceVariant,
+                          int, int, uint8_t) {}
+BOOL Sprites_RenderUnit(UnitType, int, int, int, int, uint8_t) { return FALSE; }
+BOOL Sprites_RenderBuilding(BuildingType, int, int, int, uint8_t) { return FALSE; }
+void Wwd_Renderer_FillRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_PutPixel(int, int, uint8_t) {}
+void Wwd_Renderer_DrawLine(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_DrawRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_DrawCircle(int, int, int, uint8_t) {}
+void Wwd_Renderer_FillCircle(int, int, int, uint8_t) {}
+void Wwd_Renderer_SetAlpha(int, int, int, int, uint8_t) {}
+int Unit_GetPassengerCapacity(int unitType) {
+    return (unitType == UNIT_APC) ? 5 : 0;
+}
+}
+
+BOOL Terrain_Available(void) { return FALSE; }
+BOOL Terrain_RenderTile(int, int, int, int) { return FALSE; }
+BOOL Terrain_RenderByID(int, int, int, int) { return FALSE; }
+int Rules_GetGoldValue() { return 25; }
+int Rules_GetGemValue() { return 50; }
+
+// Simple test framework
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    int failedBefore = g_testsFailed; \
+    printf("  %s... ", #name); \
+    test_##name(); \
+    if (g_testsFailed == failedBefore) { \
+        printf("OK\n"); \
+        g_testsPassed++; \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) do { \
+    if ((a) != (b)) { \
+        printf("FAILED at line %d: %s != %s (%d vs %d)\n", \
+               __LINE__, #a, #b, (int)(a), (int)(b)); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+//===========================================================================
+// Full-recompute reference
+//===========================================================================
+
+static int32_t g_refRaw[TEAM_COUNT][THREAT_TILES_Y][THREAT_TILES_X];
+
+// Raw grid from every armed unit standing on the map
+static void RefRecompute(void) {
+    memset(g_refRaw, 0, sizeof(g_refRaw));
+    for (int i = 0; i < MAX_UNITS; i++) {
+        Unit* unit = Units_Get(i);
+        if (!unit || unit->state == STATE_DYING || unit->transportId >= 0) continue;
+        if (unit->attackDamage <= 0) continue;
+        int cellX, cellY;
+        Map_WorldToCell(unit->worldX, unit->worldY, &cellX, &cellY);
+        g_refRaw[unit->team][cellY / THREAT_TILE_SIZE][cellX / THREAT_TILE_SIZE] +=
+            unit->attackDamage;
+    }
+}
+
+// Blurred reference reading, straight from the 5x5 kernel
+static int RefAt(int team, int tileX, int tileY) {
+    static const int kernel[5] = { 1, 4, 6, 4, 1 };
+    int sum = 0;
+    for (int dy = -2; dy <= 2; dy++) {
+        for (int dx = -2; dx <= 2; dx++) {
+            int x = tileX + dx, y = tileY + dy;
+            if (x < 0 || x >= THREAT_TILES_X || y < 0 || y >= THREAT_TILES_Y) continue;
+            sum += g_refRaw[team][y][x] * kernel[dx + 2] * kernel[dy + 2];
+        }
+    }
+    return sum;
+}
+
+// Returns the first mismatching tile index, or -1 if identical
+static int CompareWithReference(void) {
+    for (int ty = 0; ty < THREAT_TILES_Y; ty++) {
+        for (int tx = 0; tx < THREAT_TILES_X; tx++) {
+            int cellX = tx * THREAT_TILE_SIZE, cellY = ty * THREAT_TILE_SIZE;
+            for (int team = 0; team < TEAM_COUNT; team++) {
+                if (Threat_At(team, cellX, cellY) != RefAt(team, tx, ty)) {
+                    return ty * THREAT_TILES_X + tx;
+                }
+            }
+            int hostileToPlayer = RefAt(TEAM_ENEMY, tx, ty);
+            if (Threat_Against(TEAM_PLAYER, cellX, cellY) != hostileToPlayer) {
+                return ty * THREAT_TILES_X + tx;
+            }
+        }
+    }
+    return -1;
+}
+
+static uint32_t g_rng = 1;
+static int TestRand(int range) {
+    g_rng = g_rng * 1103515245u + 12345u;
+    return (int)((g_rng >> 8) % (uint32_t)range);
+}
+
+static void ResetWorld(int width, int height) {
+    Map_Init();
+    Map_Create(width, height);
+    Units_Init();
+}
+
+// Closest approach (in cells, Chebyshev) of a unit's planned path to a cell
+static int PathClearance(const Unit* unit, int cellX, int cellY) {
+    int mapW = Map_GetWidth();
+    int closest = 1000;
+    for (int i = 0; i < unit->pathLength; i++) {
+        int dx = abs(unit->pathCells[i] % mapW - cellX);
+        int dy = abs(unit->pathCells[i] / mapW - cellY);
+        int d = dx > dy ? dx : dy;
+        if (d < closest) closest = d;
+    }
+    return closest;
+}
+
+//===========================================================================
+// Tests
+//===========================================================================
+
+TEST(random_unit_walks) {
+    ResetWorld(64, 64);
+
+    static const UnitType kTypes[] = {
+        UNIT_RIFLE, UNIT_TANK_LIGHT, UNIT_HARVESTER, UNIT_TANK_HEAVY, UNIT_DOG
+    };
+    for (int i = 0; i < 48; i++) {
+        Team team = (i % 3 == 0) ? TEAM_ENEMY : TEAM_PLAYER;
+        Units_Spawn(kTypes[i % 5], team,
+                    TestRand(64) * CELL_SIZE + 12, TestRand(64) * CELL_SIZE + 12);
+    }
+    RefRecompute();
+    ASSERT_EQ(CompareWithReference(), -1);
+
+    for (int tick = 0; tick < 800; tick++) {
+        for (int n = 0; n < 4; n++) {
+            int id = TestRand(MAX_UNITS);
+            if (Units_Get(id)) {
+                Units_CommandAttackMove(id, TestRand(64) * CELL_SIZE + 12,
+                                        TestRand(64) * CELL_SIZE + 12);
+            }
+        }
+        if (tick % 50 == 25) {
+            int id = TestRand(MAX_UNITS);
+            if (Units_Get(id)) Units_Remove(id);
+            Units_Spawn(UNIT_TANK_LIGHT, TEAM_ENEMY,
+                        TestRand(64) * CELL_SIZE + 12, TestRand(64) * CELL_SIZE + 12);
+        }
+
+        Units_Update();
+
+        RefRecompute();
+        int bad = CompareWithReference();
+        if (bad >= 0) printf("tick %d tile %d ", tick, bad);
+        ASSERT_EQ(bad, -1);
+    }
+}
+
+TEST(threat_follows_spawn_and_removal) {
+    ResetWorld(32, 32);
+    ASSERT_EQ(Threat_Against(TEAM_PLAYER, 16, 16), 0);
+
+    int tank = Units_Spawn(UNIT_TANK_HEAVY, TEAM_ENEMY, 16 * CELL_SIZE + 12, 16 * CELL_SIZE + 12);
+    ASSERT(tank >= 0);
+    int near = Threat_Against(TEAM_PLAYER, 16, 16);
+    ASSERT(near > 0);
+    ASSERT(Threat_Against(TEAM_PLAYER, 20, 16) < near);
+    ASSERT_EQ(Threat_Against(TEAM_PLAYER, 4, 16), 0);
+    ASSERT_EQ(Threat_Against(TEAM_ENEMY, 16, 16), 0);
+
+    // Unarmed units add nothing
+    Units_Spawn(UNIT_HARVESTER, TEAM_ENEMY, 2 * CELL_SIZE + 12, 2 * CELL_SIZE + 12);
+    ASSERT_EQ(Threat_Against(TEAM_PLAYER, 2, 2), 0);
+
+    Units_Remove(tank);
+    ASSERT_EQ(Threat_Against(TEAM_PLAYER, 16, 16), 0);
+}
+
+TEST(harvester_routes_around_threat) {
+    ResetWorld(48, 32);
+    for (int i = 0; i < 3; i++) {
+        int guard = Units_Spawn(UNIT_TANK_HEAVY, TEAM_ENEMY,
+                                24 * CELL_SIZE + 12, (15 + i) * CELL_SIZE + 12);
+        ASSERT(guard >= 0);
+    }
+
+    // A tank drives straight past; a harvester on the same trip keeps away
+    int tank = Units_Spawn(UNIT_TANK_LIGHT, TEAM_PLAYER, 4 * CELL_SIZE + 12, 16 * CELL_SIZE + 12);
+    int harv = Units_Spawn(UNIT_HARVESTER, TEAM_PLAYER, 4 * CELL_SIZE + 12, 17 * CELL_SIZE + 12);
+    ASSERT(tank >= 0 && harv >= 0);
+    Units_CommandMove(tank, 44 * CELL_SIZE + 12, 16 * CELL_SIZE + 12);
+    Units_CommandMove(harv, 44 * CELL_SIZE + 12, 17 * CELL_SIZE + 12);
+    Units_Update();
+
+    Unit* tankUnit = Units_Get(tank);
+    Unit* harvUnit = Units_Get(harv);
+    ASSERT(tankUnit && harvUnit);
+    ASSERT(tankUnit->pathLength > 0 && harvUnit->pathLength > 0);
+    int tankClearance = PathClearance(tankUnit, 24, 16);
+    int harvClearance = PathClearance(harvUnit, 24, 16);
+    ASSERT(tankClearance <= 1);
+    ASSERT(harvClearance >= 6);
+}
+
+int main() {
+    printf("Red Alert Threat Map Tests\n");
+    printf("==========================\n\n");
+
+    RUN_TEST(random_unit_walks);
+    RUN_TEST(threat_follows_spawn_and_removal);
+    RUN_TEST(harvester_routes_around_threat);
+
+    printf("\nResults: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
+    return g_testsFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,360 @@
+/**
+ * Red Alert macOS Port - VQA Frame Index and Seek Tests
+ *
+ * Builds a small synthetic VQA (full codebooks every few frames, partial
+ * codebook updates in between, occasional palette changes, audio chunks
+ * ahead of frames) and checks that seeking to any frame, from any
+ * position, gives byte-identical frame and palette output to decoding
+ * linearly from frame 0. Covers FINF-indexed files, files without FINF,
+ * and files whose FINF is garbage.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+
+#include <wwd/vqa.h>
+
+// Simple test framework
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    int failedBefore = g_testsFailed; \
+    printf("  %s... ", #name); \
+    test_##name(); \
+    if (g_testsFailed == failedBefore) { \
+        printf("OK\n"); \
+        g_testsPassed++; \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) do { \
+    if ((a) != (b)) { \
+        printf("FAILED at line %d: %s != %s (%d vs %d)\n", \
+               __LINE__, #a, #b, (int)(a), (int)(b)); \
+        g_testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+static uint32_t g_rng = 4242;
+static int TestRand(int range) {
+    g_rng = g_rng * 1103515245u + 12345u;
+    return (int)((g_rng >> 8) % (uint32_t)range);
+}
+
+//===========================================================================
+// Synthetic VQA Builder
+//===========================================================================
+
+constexpr int CLIP_WIDTH = 16;
+constexpr int CLIP_HEIGHT = 8;
+constexpr int CLIP_BLOCKS = (CLIP_WIDTH / 4) * (CLIP_HEIGHT / 2);
+constexpr int CLIP_CB_ENTRIES = 64;
+constexpr int CLIP_CB_SIZE = CLIP_CB_ENTRIES * 8;
+constexpr int CLIP_GROUP = 2;          // CBP parts per codebook
+constexpr int CLIP_KEY_INTERVAL = 8;
+
+enum FinfMode {
+    FINF_VALID,
+    FINF_MISSING,
+    FINF_GARBAGE
+};
+
+static void PutBE32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 3; i >= 0; i--) out.push_back((uint8_t)(v >> (i * 8)));
+}
+
+static void PutLE16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back((uint8_t)v);
+    out.push_back((uint8_t)(v >> 8));
+}
+
+static void PutChunk(std::vector<uint8_t>& out, uint32_t id,
+                     const std::vector<uint8_t>& data) {
+    PutBE32(out, id);
+    PutBE32(out, (uint32_t)data.size());
+    out.insert(out.end(), data.begin(), data.end());
+    if (data.size() & 1) out.push_back(0);
+}
+
+static bool HasPalette(int frame) {
+    return frame == 0 || frame % 7 == 5;
+}
+
+static std::vector<uint8_t> BuildFrame(int frame) {
+    std::vector<uint8_t> body;
+
+    if (frame % CLIP_KEY_INTERVAL == 0) {
+        std::vector<uint8_t> cb(CLIP_CB_SIZE);
+        for (uint8_t& b : cb) b = (uint8_t)TestRand(256);
+        PutChunk(body, VQA_ID_CBF0, cb);
+    } else {
+        // One half of the next codebook per frame
+        std::vector<uint8_t> part(CLIP_CB_SIZE / CLIP_GROUP);
+        for (uint8_t& b : part) b = (uint8_t)TestRand(256);
+        PutChunk(body, VQA_ID_CBP0, part);
+    }
+
+    if (HasPalette(frame)) {
+        std::vector<uint8_t> pal(768);
+        for (uint8_t& b : pal) b = (uint8_t)TestRand(64);
+        PutChunk(body, VQA_ID_CPL0, pal);
+    }
+
+    // Low bytes then high bytes; hi 0x0F is a literal colour block
+    std::vector<uint8_t> vpt(CLIP_BLOCKS * 2);
+    for (int i = 0; i < CLIP_BLOCKS; i++) {
+        bool literal = TestRand(5) == 0;
+        vpt[i] = (uint8_t)(literal ? TestRand(256) : TestRand(CLIP_CB_ENTRIES));
+        vpt[CLIP_BLOCKS + i] = literal ? 0x0F : 0x00;
+    }
+    PutChunk(body, VQA_ID_VPT0, vpt);
+    return body;
+}
+
+static std::vector<uint8_t> BuildClip(int frames, FinfMode finfMode) {
+    g_rng = 4242;
+
+    std::vector<uint8_t> header;
+    PutLE16(header, 2);                     // Version
+    PutLE16(header, 0);                     // Flags (no audio)
+    PutLE16(header, (uint16_t)frames);
+    PutLE16(header, CLIP_WIDTH);
+    PutLE16(header, CLIP_HEIGHT);
+    header.push_back(4);                    // Block width
+    header.push_back(2);                    // Block height
+    header.push_back(15);                   // FPS
+    header.push_back(CLIP_GROUP);
+    PutLE16(header, 0);                     // Colors1
+    PutLE16(header, CLIP_CB_ENTRIES);
+    header.resize(sizeof(WwdVqaHeader), 0);
+
+    std::vector<uint8_t> out;
+    PutBE32(out, VQA_ID_FORM);
+    PutBE32(out, 0);                        // Patched below
+    PutBE32(out, VQA_ID_WVQA);
+    PutChunk(out, VQA_ID_VQHD, header);
+
+    size_t finfPos = 0;
+    if (finfMode != FINF_MISSING) {
+        finfPos = out.size() + 8;
+        PutChunk(out, VQA_ID_FINF, std::vector<uint8_t>((size_t)frames * 4));
+    }
+
+    for (int f = 0; f < frames; f++) {
+        uint32_t start = (uint32_t)out.size();
+
+        // Audio ahead of some frames, odd-sized to exercise padding
+        if (f % 3 == 1) {
+            PutChunk(out, VQA_ID_SND0, std::vector<uint8_t>(33, (uint8_t)f));
+        }
+        PutChunk(out, VQA_ID_VQFR, BuildFrame(f));
+
+        if (finfMode != FINF_MISSING) {
+            uint32_t value = finfMode == FINF_VALID
+                ? (start >> 1) | (f % CLIP_KEY_INTERVAL == 0 ? 0x80000000u : 0)
+                : 0x12345678u * (uint32_t)(f + 1);
+            for (int i = 0; i < 4; i++) {
+                out[finfPos + f * 4 + i] = (uint8_t)(value >> (i * 8));
+            }
+        }
+    }
+
+    uint32_t formSize = (uint32_t)out.size() - 8;
+    for (int i = 0; i < 4; i++) out[4 + i] = (uint8_t)(formSize >> ((3 - i) * 8));
+    return out;
+}
+
+//===========================================================================
+// Reference Decode
+//===========================================================================
+
+struct FrameOutput {
+    std::vector<uint8_t> pixels;
+    std::vector<uint8_t> palette;
+};
+
+static FrameOutput Capture(const WwdVqaPlayer& player) {
+    FrameOutput out;
+    const uint8_t* fb = player.GetFrameBuffer();
+    out.pixels.assign(fb, fb + CLIP_WIDTH * CLIP_HEIGHT);
+    out.palette.assign(player.GetPalette(), player.GetPalette() + 768);
+    return out;
+}
+
+static bool SameOutput(const FrameOutput& a, const FrameOutput& b) {
+    return a.pixels == b.pixels && a.palette == b.palette;
+}
+
+static bool DecodeLinear(const std::vector<uint8_t>& clip,
+                         std::vector<FrameOutput>* frames) {
+    WwdVqaPlayer player;
+    if (!player.Load(clip.data(), (uint32_t)clip.size())) return false;
+    frames->clear();
+    while (player.NextFrame()) {
+        frames->push_back(Capture(player));
+    }
+    return (int)frames->size() == player.GetFrameCount();
+}
+
+// Every frame from a fresh player, then a shuffled walk on one player
+// so backward, short forward and long forward seeks all get exercised
+static bool SeeksMatch(const std::vector<uint8_t>& clip,
+                       const std::vector<FrameOutput>& reference) {
+    int count = (int)reference.size();
+    for (int f = 0; f < count; f++) {
+        WwdVqaPlayer player;
+        if (!player.Load(clip.data(), (uint32_t)clip.size())) return false;
+        if (!player.SeekFrame(f)) return false;
+        if (!SameOutput(Capture(player), reference[f])) {
+            printf("fresh seek to %d differs ", f);
+            return false;
+        }
+    }
+
+    WwdVqaPlayer player;
+    if (!player.Load(clip.data(), (uint32_t)clip.size())) return false;
+    for (int i = 0; i < count * 4; i++) {
+        int f = TestRand(count);
+        if (!player.SeekFrame(f) || player.GetCurrentFrame() != f) return false;
+        if (!SameOutput(Capture(player), reference[f])) {
+            printf("walk seek to %d differs ", f);
+            return false;
+        }
+
+        // Playback continuing after a seek must stay in step too
+        if (f + 1 < count && TestRand(2) == 0) {
+            if (!player.NextFrame()) return false;
+            if (!SameOutput(Capture(player), reference[f + 1])) {
+                printf("next after seek to %d differs ", f);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//===========================================================================
+// Tests
+//===========================================================================
+
+TEST(finf_index_keyframes) {
+    std::vector<uint8_t> clip = BuildClip(24, FINF_VALID);
+    WwdVqaPlayer player;
+    ASSERT(player.Load(clip.data(), (uint32_t)clip.size()));
+    ASSERT_EQ(player.GetFrameCount(), 24);
+
+    for (int f = 0; f < 24; f++) {
+        ASSERT_EQ(player.IsKeyFrame(f), f % CLIP_KEY_INTERVAL == 0);
+    }
+    ASSERT(!player.IsKeyFrame(-1));
+    ASSERT(!player.IsKeyFrame(24));
+    ASSERT(!player.SeekFrame(24));
+}
+
+TEST(seek_matches_linear_finf) {
+    std::vector<uint8_t> clip = BuildClip(24, FINF_VALID);
+    std::vector<FrameOutput> reference;
+    ASSERT(DecodeLinear(clip, &reference));
+
+    // The clip has to actually vary or the comparison proves nothing
+    ASSERT(!SameOutput(reference[3], reference[4]));
+    ASSERT(reference[4].palette != reference[5].palette);
+
+    g_rng = 777;
+    ASSERT(SeeksMatch(clip, reference));
+}
+
+TEST(seek_matches_linear_without_finf) {
+    std::vector<uint8_t> clip = BuildClip(24, FINF_MISSING);
+    std::vector<FrameOutput> reference;
+    ASSERT(DecodeLinear(clip, &reference));
+
+    WwdVqaPlayer player;
+    ASSERT(player.Load(clip.data(), (uint32_t)clip.size()));
+    ASSERT(player.IsKeyFrame(16));
+    ASSERT(!player.IsKeyFrame(17));
+
+    g_rng = 778;
+    ASSERT(SeeksMatch(clip, reference));
+}
+
+TEST(garbage_finf_falls_back_to_scan) {
+    std::vector<uint8_t> good = BuildClip(24, FINF_VALID);
+    std::vector<uint8_t> clip = BuildClip(24, FINF_GARBAGE);
+    std::vector<FrameOutput> reference, expect;
+    ASSERT(DecodeLinear(good, &expect));
+    ASSERT(DecodeLinear(clip, &reference));
+
+    // Same frames as the well-indexed file
+    for (int f = 0; f < 24; f++) {
+        ASSERT(SameOutput(reference[f], expect[f]));
+    }
+
+    g_rng = 779;
+    ASSERT(SeeksMatch(clip, reference));
+}
+
+TEST(playback_is_linear) {
+    // Full playback used to rescan from the start of the file per frame
+    const int kFrames[] = {1000, 4000};
+    double perFrameUs[2] = {};
+
+    for (int i = 0; i < 2; i++) {
+        std::vector<uint8_t> clip = BuildClip(kFrames[i], FINF_VALID);
+        WwdVqaPlayer player;
+        ASSERT(player.Load(clip.data(), (uint32_t)clip.size()));
+
+        auto t0 = std::chrono::steady_clock::now();
+        int decoded = 0;
+        while (player.NextFrame()) decoded++;
+        auto t1 = std::chrono::steady_clock::now();
+        ASSERT_EQ(decoded, kFrames[i]);
+
+        perFrameUs[i] = std::chrono::duration<double, std::micro>(t1 - t0).count() /
+                        kFrames[i];
+
+        // Seeking to the last frame replays at most one keyframe interval
+        auto t2 = std::chrono::steady_clock::now();
+        ASSERT(player.SeekFrame(kFrames[i] / 2 + 3));
+        auto t3 = std::chrono::steady_clock::now();
+        printf("\n    %5d frames: %.2f us/frame playback, %.1f us mid seek",
+               kFrames[i], perFrameUs[i],
+               std::chrono::duration<double, std::micro>(t3 - t2).count());
+    }
+    printf("\n    ");
+
+    // 4x the frames must not mean anywhere near 4x the per-frame cost
+    ASSERT(perFrameUs[1] < perFrameUs[0] * 2.5 + 1.0);
+}
+
+//===========================================================================
+// Main
+//===========================================================================
+
+int main() {
+    printf("Red Alert VQA Seek Tests\n");
+    printf("========================\n\n");
+
+    RUN_TEST(finf_index_keyframes);
+    RUN_TEST(seek_matches_linear_finf);
+    RUN_TEST(seek_matches_linear_without_finf);
+    RUN_TEST(garbage_finf_falls_back_to_scan);
+    RUN_TEST(playback_is_linear);
+
+    printf("\nResults: %d passed, %d failed\n", g_testsPassed, g_testsFailed);
+    return g_testsFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,301 @@
+/**
+ * Red Alert macOS Port - Headless Simulation Runner
+ *
+ * Runs the game simulation without the app shell: loads a scenario INI
+ * (or the built-in demo skirmish), then steps the same subsystems as
+ * GameUpdate in main.mm for a fixed number of ticks with rendering and
+ * audio stubbed out. Prints a state hash per tick and per-subsystem
+ * timings, so runs can be compared across builds and machines.
+ *
+ * With --replay, the seed, tick count and player commands come from a
+ * replay file instead, and the run stops at the first tick whose state
+ * hash differs from the recording.
+ *
+ * Usage: ra_headless [options] [scenario.ini]
+ *   --ticks N        Ticks to run (default 1000)
+ *   --seed N         Game RNG seed (default 1)
+ *   --hash-every N   Print the state hash every N ticks (default 1, 0 = off)
+ *   --hunt           Order both sides to hunt so the run exercises combat
+ *   --record FILE    Write the run as a replay
+ *   --replay FILE    Play back a replay and check it against its hashes
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+
+#include "game/units.h"
+#include "game/map.h"
+#include "game/mission.h"
+#include "game/ai.h"
+#include "game/random.h"
+#include "game/replay.h"
+#include "game/pathcache.h"
+#include "game/sprites.h"
+#include "game/sounds.h"
+#include "game/terrain.h"
+#include "assets/assetloader.h"
+#include "graphics/metal/renderer.h"
+
+//===========================================================================
+// Stubs for rendering, audio, video and asset hooks
+//===========================================================================
+
+extern "C" {
+void Sounds_PlayAt(SoundEffect, int, int, uint8_t) {}
+void Voice_PlayResponseAt(int, BOOL, ResponseType, VoiceVariant,
+                          int, int, uint8_t) {}
+BOOL Sprites_RenderUnit(UnitType, int, int, int, int, uint8_t) { return FALSE; }
+BOOL Sprites_RenderBuilding(BuildingType, int, int, int, uint8_t) { return FALSE; }
+void Sprites_Prefetch(const UnitType*, int, const BuildingType*, int) {}
+void Sprites_HintBuilding(BuildingType) {}
+void Wwd_Renderer_FillRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_PutPixel(int, int, uint8_t) {}
+void Wwd_Renderer_DrawLine(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_DrawRect(int, int, int, int, uint8_t) {}
+void Wwd_Renderer_DrawCircle(int, int, int, uint8_t) {}
+void Wwd_Renderer_FillCircle(int, int, int, uint8_t) {}
+void Wwd_Renderer_SetAlpha(int, int, int, int, uint8_t) {}
+int Unit_GetPassengerCapacity(int unitType) {
+    return (unitType == UNIT_APC) ? 5 : 0;
+}
+BOOL Assets_SetTheater(TheaterType) { return TRUE; }
+}
+
+BOOL Terrain_Available(void) { return FALSE; }
+BOOL Terrain_RenderTile(int, int, int, int) { return FALSE; }
+BOOL Terrain_RenderByID(int, int, int, int) { return FALSE; }
+void Terrain_SetTheater(int) {}
+void Terrain_PrefetchTemplates(const uint8_t*, int) {}
+bool VQA_Play(const char*) { return false; }
+void EnableAIProduction(int) {}
+void EnableAIAutocreate(int) {}
+
+//===========================================================================
+// Subsystem Timing
+//===========================================================================
+
+enum HeadlessSystem {
+    SYS_MAP,
+    SYS_UNITS,
+    SYS_AI,
+    SYS_MISSION,
+    SYS_COUNT
+};
+
+static const char* const SYSTEM_NAMES[SYS_COUNT] = {
+    "map", "units", "ai", "mission"
+};
+
+struct SystemTiming {
+    double totalUs;
+    double maxUs;
+};
+
+static SystemTiming g_timing[SYS_COUNT];
+
+typedef std::chrono::steady_clock Clock;
+
+static void Record(HeadlessSystem system, Clock::time_point start) {
+    double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    g_timing[system].totalUs += us;
+    if (us > g_timing[system].maxUs) g_timing[system].maxUs = us;
+}
+
+//===========================================================================
+// Main
+//===========================================================================
+
+static void PrintUsage(void) {
+    fprintf(stderr,
+            "Usage: ra_headless [--ticks N] [--seed N] [--hash-every N] "
+            "[--hunt] [--record FILE | --replay FILE] [scenario.ini]\n");
+}
+
+int main(int argc, char** argv) {
+    int ticks = 1000;
+    uint64_t seed = 1;
+    int hashEvery = 1;
+    bool hunt = false;
+    const char* scenarioPath = nullptr;
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (strcmp(arg, "--ticks") == 0 && hasValue) {
+            ticks = atoi(argv[++i]);
+        } else if (strcmp(arg, "--seed") == 0 && hasValue) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(arg, "--hash-every") == 0 && hasValue) {
+            hashEvery = atoi(argv[++i]);
+        } else if (strcmp(arg, "--hunt") == 0) {
+            hunt = true;
+        } else if (strcmp(arg, "--record") == 0 && hasValue) {
+            recordPath = argv[++i];
+        } else if (strcmp(arg, "--replay") == 0 && hasValue) {
+            replayPath = argv[++i];
+        } else if (arg[0] != '-' && !scenarioPath) {
+            scenarioPath = arg;
+        } else {
+            PrintUsage();
+            return 2;
+        }
+    }
+    if (ticks < 0) ticks = 0;
+    if (recordPath && replayPath) {
+        PrintUsage();
+        return 2;
+    }
+
+    // The replay decides the seed and length; its commands replace --hunt
+    ReplayInfo replay;
+    if (replayPath) {
+        if (!Replay_Load(replayPath, &replay)) {
+            fprintf(stderr, "ra_headless: can't load replay %s\n", replayPath);
+            return 1;
+        }
+        seed = replay.seed;
+        ticks = (int)replay.tickCount;
+        hunt = false;
+    }
+
+    // Load the scenario, or fall back to the synthetic demo skirmish
+    static MissionData mission;
+    if (scenarioPath) {
+        if (!Mission_LoadFromINI(&mission, scenarioPath)) {
+            fprintf(stderr, "ra_headless: can't load %s\n", scenarioPath);
+            return 1;
+        }
+    } else {
+        Mission_GetDemo(&mission);
+    }
+
+    int credits = mission.startCredits;
+    Units_SetCreditsPtr(&credits);
+    Random_Seed(seed);
+    Mission_Start(&mission);
+
+    if (replayPath) {
+        if (strcmp(replay.scenario, mission.name) != 0) {
+            fprintf(stderr, "ra_headless: replay was recorded on \"%s\", running \"%s\"\n",
+                    replay.scenario, mission.name);
+        }
+        credits = replay.startCredits;
+        if (!Replay_StartPlayback()) {
+            printf("replay: starting state differs from the recording\n");
+            Mission_Free(&mission);
+            return 1;
+        }
+    } else if (recordPath) {
+        Replay_StartRecording(mission.name);
+    }
+
+    if (hunt) {
+        Replay_Issue(REPLAY_CMD_HUNT, TEAM_PLAYER, 0, 0);
+        Replay_Issue(REPLAY_CMD_HUNT, TEAM_ENEMY, 0, 0);
+    }
+
+    printf("ra_headless: %s, %dx%d map, %d ticks, seed %llu\n",
+           mission.name, Map_GetWidth(), Map_GetHeight(), ticks,
+           (unsigned long long)seed);
+
+    // Same order as GameUpdate in main.mm
+    int result = 0;
+    int resultTick = -1;
+    uint64_t hash = Replay_HashState();
+    Clock::time_point runStart = Clock::now();
+
+    for (int tick = 0; tick < ticks; tick++) {
+        Replay_Inject(REPLAY_PHASE_INPUT);
+
+        Clock::time_point start = Clock::now();
+        Map_Update();
+        Record(SYS_MAP, start);
+
+        start = Clock::now();
+        Units_Update();
+        Record(SYS_UNITS, start);
+
+        // Production completes in GameUI_Update, between units and AI
+        Replay_Inject(REPLAY_PHASE_PRODUCTION);
+
+        start = Clock::now();
+        AI_Update();
+        Record(SYS_AI, start);
+
+        start = Clock::now();
+        if (result == 0) {
+            result = Mission_ProcessTriggers(&mission, tick + 1);
+            if (result == 0) result = Mission_CheckVictory(&mission, tick + 1);
+            if (result != 0) resultTick = tick + 1;
+        }
+        Record(SYS_MISSION, start);
+
+        // Nothing reads the fog change list here; clear it so it stays bounded
+        Map_ClearFogChanges();
+
+        Replay_EndTick();
+        if (Replay_GetDivergedTick() >= 0) {
+            ticks = tick + 1;
+            break;
+        }
+
+        if (hashEvery > 0 && ((tick + 1) % hashEvery == 0 || tick + 1 == ticks)) {
+            hash = Replay_HashState();
+            printf("tick %6d  %016llx\n", tick + 1, (unsigned long long)hash);
+        }
+    }
+
+    double wallMs = std::chrono::duration<double, std::milli>(Clock::now() - runStart).count();
+    if (hashEvery <= 0) hash = Replay_HashState();
+
+    printf("\n%-10s %12s %12s %12s\n", "subsystem", "total ms", "avg us", "max us");
+    double simUs = 0.0;
+    for (int i = 0; i < SYS_COUNT; i++) {
+        const SystemTiming& t = g_timing[i];
+        simUs += t.totalUs;
+        printf("%-10s %12.2f %12.2f %12.2f\n", SYSTEM_NAMES[i], t.totalUs / 1000.0,
+               ticks ? t.totalUs / ticks : 0.0, t.maxUs);
+    }
+    printf("%-10s %12.2f %12.2f\n", "sim", simUs / 1000.0, ticks ? simUs / ticks : 0.0);
+    printf("%-10s %12.2f\n", "wall", wallMs);
+
+    const PathCacheStats* paths = PathCache_GetStats();
+    printf("\npath cache: %u lookups, %u hits (%u mid-route), %u misses, %u flushes\n",
+           paths->lookups, paths->hits, paths->suffixHits, paths->misses, paths->flushes);
+
+    printf("\nunits: %d player, %d enemy  buildings: %d player, %d enemy\n",
+           Units_CountByTeam(TEAM_PLAYER), Units_CountByTeam(TEAM_ENEMY),
+           Buildings_CountByTeam(TEAM_PLAYER), Buildings_CountByTeam(TEAM_ENEMY));
+    if (result != 0) {
+        printf("result: %s at tick %d\n", result > 0 ? "victory" : "defeat", resultTick);
+    } else {
+        printf("result: ongoing\n");
+    }
+    printf("final hash: %016llx\n", (unsigned long long)hash);
+
+    int status = 0;
+    if (replayPath) {
+        int diverged = Replay_GetDivergedTick();
+        if (diverged >= 0) {
+            printf("replay: diverged at tick %d\n", diverged);
+            status = 1;
+        } else {
+            printf("replay: %d ticks match the recording\n", ticks);
+        }
+        Replay_Stop();
+    } else if (recordPath) {
+        if (Replay_StopRecording(recordPath)) {
+            printf("replay: recorded %d ticks to %s\n", ticks, recordPath);
+        } else {
+            fprintf(stderr, "ra_headless: can't write replay %s\n", recordPath);
+            status = 1;
+        }
+    }
+
+    Mission_Free(&mission);
+    return status;
+}
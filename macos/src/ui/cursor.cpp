@@ -130,8 +130,13 @@ void Cursor_Render(void) {
         if (frame && frame->pixels) {
             int drawX = mx - def.hotspotX;
             int drawY = my - def.hotspotY;
-            Renderer_Blit(frame->pixels, frame->width, frame->height,
-                          drawX, drawY, TRUE);
+            if (frame->spans) {
+                Renderer_BlitSpans(frame->spans, frame->width, frame->height,
+                                   drawX, drawY, NULL);
+            } else {
+                Renderer_Blit(frame->pixels, frame->width, frame->height,
+                              drawX, drawY, TRUE);
+            }
             return;
         }
     }
@@ -11,6 +11,9 @@
 #include "../graphics/metal/renderer.h"
 #include "../game/map.h"
 #include "../game/units.h"
+#include "../game/mission.h"
+#include "../game/replay.h"
+#include "../game/sprites.h"
 #include "../assets/assetloader.h"
 #include "../assets/shpfile.h"
 #include <cstdio>
@@ -135,10 +138,9 @@ static bool SellBuilding(int buildingId) {
 
     // Calculate refund
     int refund = GetBuildingRefund(buildingId);
-    g_playerCredits += refund;
 
-    // Remove the building
-    Buildings_Remove(buildingId);
+    // Refund and remove the building
+    Replay_Issue(REPLAY_CMD_SELL, buildingId, refund, 0);
 
     fprintf(stderr, "Sold building %d for %d credits\n", buildingId, refund);
     return true;
@@ -586,23 +588,11 @@ static bool TryPlaceBuilding(void) {
 
     const BuildItemDef* item = &g_structureDefs[g_placementType];
 
-    // Spawn the building
-    int id = Buildings_Spawn((BuildingType)item->spawnType, TEAM_PLAYER,
-                             g_placementCellX, g_placementCellY);
+    // Spawn the building (marks its cells as occupied)
+    int id = Replay_Issue(REPLAY_CMD_PLACE_BUILDING, item->spawnType,
+                          g_placementCellX, g_placementCellY);
     if (id < 0) return false;
 
-    // Mark cells as occupied
-    int px = g_placementCellX, py = g_placementCellY;
-    for (int dy = 0; dy < item->height; dy++) {
-        for (int dx = 0; dx < item->width; dx++) {
-            MapCell* cell = Map_GetCell(px + dx, py + dy);
-            if (cell) {
-                cell->terrain = TERRAIN_BUILDING;
-                cell->buildingId = id;
-            }
-        }
-    }
-
     // Update player building flags to unlock new items
     UpdatePlayerBuildings();
 
@@ -623,7 +613,7 @@ static void CancelPlacement(void) {
 
     // Refund the cost
     if (g_placementType >= 0) {
-        g_playerCredits += g_structureDefs[g_placementType].cost;
+        Replay_Issue(REPLAY_CMD_CREDITS, g_structureDefs[g_placementType].cost, 0, 0);
     }
 
     g_placementMode = false;
@@ -690,8 +680,9 @@ void GameUI_Update(void) {
 
         if (g_unitProgress >= 10000) {  // 100.00%
             // Unit complete - find spawn location near production building
-            int spawnX = 150 + (rand() % 100);  // Fallback
-            int spawnY = 500 + (rand() % 100);
+            // (-1 = no room there; the spawn picks a fallback spot)
+            int spawnX = -1;
+            int spawnY = -1;
 
             UnitType ut = (UnitType)item->spawnType;
             Building* prodBldg = FindProductionBuilding(ut);
@@ -704,7 +695,7 @@ void GameUI_Update(void) {
                 }
             }
 
-            Units_Spawn((UnitType)item->spawnType, TEAM_PLAYER, spawnX, spawnY);
+            Replay_Issue(REPLAY_CMD_SPAWN_UNIT, item->spawnType, spawnX, spawnY);
 
             g_unitProducing = -1;
             g_unitProgress = 0;
@@ -1588,9 +1579,12 @@ BOOL GameUI_SidebarClick(int mouseX, int mouseY, BOOL leftClick) {
                     }
 
                     // Start production
-                    g_playerCredits -= item->cost;
+                    Replay_Issue(REPLAY_CMD_CREDITS, -item->cost, 0, 0);
                     g_structureProducing = idx;
                     g_structureProgress = 0;
+
+                    // Decode its sprite while it builds
+                    Sprites_HintBuilding((BuildingType)item->spawnType);
                     return TRUE;
                 }
             }
@@ -1617,9 +1611,12 @@ BOOL GameUI_SidebarClick(int mouseX, int mouseY, BOOL leftClick) {
                     }
 
                     // Start production
-                    g_playerCredits -= item->cost;
+                    Replay_Issue(REPLAY_CMD_CREDITS, -item->cost, 0, 0);
                     g_unitProducing = idx;
                     g_unitProgress = 0;
+
+                    // Decode its sprite while it builds
+                    Sprites_HintUnit((UnitType)item->spawnType);
                     return TRUE;
                 }
             }
@@ -1787,9 +1784,11 @@ int GameUI_GetCredits(void) {
 void GameUI_SetCredits(int credits) {
     g_playerCredits = credits;
     if (g_playerCredits < 0) g_playerCredits = 0;
+    Mission_PostEvent(MISSION_EVENT_CREDITS_CHANGED, 0);
 }
 
 void GameUI_AddCredits(int amount) {
     g_playerCredits += amount;
     if (g_playerCredits < 0) g_playerCredits = 0;
+    Mission_PostEvent(MISSION_EVENT_CREDITS_CHANGED, 0);
 }
@@ -55,6 +55,7 @@ static NewGameCallback g_newGameCallback = nullptr;
 static StartCampaignCallback g_startCampaignCallback = nullptr;
 static MenuCampaignChoice g_selectedCampaign = CAMPAIGN_NONE;
 static MenuDifficultyChoice g_selectedDifficulty = DIFFICULTY_NORMAL;
+static BOOL g_recordReplays = FALSE;
 
 // Briefing state
 static char g_briefingName[128] = "";
@@ -93,6 +94,7 @@ enum {
     SLD_SOUND_VOL,
     SLD_MUSIC_VOL,
     TGL_FULLSCREEN,
+    TGL_RECORD_REPLAYS,
     BTN_ALLIED_CAMPAIGN,
     BTN_SOVIET_CAMPAIGN,
     BTN_SKIRMISH,
@@ -250,7 +252,9 @@ void Menu_Init(void) {
     Menu_AddSlider(g_optionsMenu, SLD_MUSIC_VOL, "MUSIC VOLUME",
                    220, 200, 200, 0, 255, 200, OnOptionsButton);
     Menu_AddToggle(g_optionsMenu, TGL_FULLSCREEN, "FULLSCREEN",
-                   240, 260, FALSE, OnOptionsButton);
+                   240, 250, FALSE, OnOptionsButton);
+    Menu_AddToggle(g_optionsMenu, TGL_RECORD_REPLAYS, "RECORD REPLAYS",
+                   240, 282, g_recordReplays, OnOptionsButton);
 
     Menu_AddButton(g_optionsMenu, BTN_BACK, "BACK",
                    btnX, 320, btnW, btnH, OnOptionsButton);
@@ -932,6 +936,11 @@ static void OnOptionsButton(int itemId, int value) {
             // TODO: Toggle fullscreen
             break;
 
+        case TGL_RECORD_REPLAYS:
+            // Takes effect from the next mission start
+            g_recordReplays = value ? TRUE : FALSE;
+            break;
+
         case BTN_BACK:
             Menu_SetCurrentScreen(MENU_SCREEN_MAIN);
             break;
@@ -962,6 +971,10 @@ MenuDifficultyChoice Menu_GetSelectedDifficulty(void) {
     return g_selectedDifficulty;
 }
 
+BOOL Menu_GetRecordReplays(void) {
+    return g_recordReplays;
+}
+
 //===========================================================================
 // Briefing Screen
 //===========================================================================
@@ -235,6 +235,11 @@ MenuCampaignChoice Menu_GetSelectedCampaign(void);
  */
 MenuDifficultyChoice Menu_GetSelectedDifficulty(void);
 
+/**
+ * Whether missions should record a replay (options menu, off by default)
+ */
+BOOL Menu_GetRecordReplays(void);
+
 /**
  * Set callback for starting a new game
  * Callback receives campaign (1=allied, 2=soviet) and difficulty (0-2)
@@ -7,6 +7,7 @@
 #include "music.h"
 #include "assets/assetloader.h"
 #include "audio/audio.h"
+#include "game/random.h"
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -296,7 +297,7 @@ void Music_ClearQueue() {
 void Music_ShuffleQueue() {
     // Simple shuffle
     for (size_t i = g_musicQueue.size() - 1; i > 0; i--) {
-        size_t j = rand() % (i + 1);
+        size_t j = Random_Cosmetic(static_cast<int>(i + 1));
         std::swap(g_musicQueue[i], g_musicQueue[j]);
     }
 }
@@ -340,7 +341,7 @@ void Music_PlayRandom() {
 
     if (count == 0) return;
 
-    int pick = rand() % count;
+    int pick = Random_Cosmetic(count);
     int idx = 0;
     for (int i = 0; i < g_musicTrackCount; i++) {
         if (g_musicTracks[i].isAction) {